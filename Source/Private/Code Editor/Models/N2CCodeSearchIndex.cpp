@@ -0,0 +1,218 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Models/N2CCodeSearchIndex.h"
+
+#include "Algo/BinarySearch.h"
+#include "String/Find.h"
+
+void FN2CCodeSearchIndex::SetDocuments(const TSharedRef<const TArray<FString>>& InDocuments)
+{
+    Documents = InDocuments;
+    State.Reset();
+    LastQuery.Reset();
+    LastLines.Reset();
+    LastColumns.Reset();
+
+    // Splitting into lines is a single pass, so the lines can be scanned while the trigrams are indexed
+    Lines = Build(*InDocuments, false);
+    BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [InDocuments]()
+    {
+        return Build(*InDocuments, true);
+    });
+}
+
+bool FN2CCodeSearchIndex::IsBuilt()
+{
+    CollectBuild();
+    return State.IsValid();
+}
+
+void FN2CCodeSearchIndex::CollectBuild()
+{
+    if (!State.IsValid() && BuildTask.IsValid() && BuildTask.IsCompleted())
+    {
+        State = BuildTask.GetResult();
+        BuildTask = {};
+        Lines.Reset();
+    }
+}
+
+FStringView FN2CCodeSearchIndex::GetLine(int32 Document, int32 Line) const
+{
+    const FIndexState* Current = State.IsValid() ? State.Get() : Lines.Get();
+    if (!Current || !Documents.IsValid() || !Current->FirstLines.IsValidIndex(Document))
+    {
+        return FStringView();
+    }
+
+    const int32 End = Current->FirstLines.IsValidIndex(Document + 1) ? Current->FirstLines[Document + 1] : Current->Lines.Num();
+    const int32 Index = Current->FirstLines[Document] + Line;
+    if (Line < 0 || Index >= End)
+    {
+        return FStringView();
+    }
+
+    const FLine& Found = Current->Lines[Index];
+    return FStringView((*Documents)[Document]).Mid(Found.Start, Found.Len);
+}
+
+void FN2CCodeSearchIndex::Find(const FString& Query, int32 MaxHits, TArray<FHit>& OutHits)
+{
+    OutHits.Reset();
+    if (Query.IsEmpty() || !Documents.IsValid())
+    {
+        return;
+    }
+
+    // The index finishing changes nothing the previous query matched, so its lines stay valid
+    CollectBuild();
+    const FIndexState* Current = State.IsValid() ? State.Get() : Lines.Get();
+
+    const FString LowerQuery = Query.ToLower();
+    TArray<int32> MatchedLines;
+    TArray<int32> MatchedColumns;
+    if (!LastQuery.IsEmpty() && LowerQuery.Contains(LastQuery, ESearchCase::CaseSensitive))
+    {
+        if (LowerQuery != LastQuery)
+        {
+            FilterLines(LowerQuery, &LastLines, MatchedLines, MatchedColumns);
+        }
+        else
+        {
+            MatchedLines = LastLines;
+            MatchedColumns = LastColumns;
+        }
+    }
+    else if (State.IsValid() && LowerQuery.Len() >= 3)
+    {
+        // Only lines holding every trigram of the query can hold the query
+        TArray<const TArray<int32>*> Lists;
+        for (int32 Index = 0; Index + 2 < LowerQuery.Len(); ++Index)
+        {
+            const TArray<int32>* Postings = State->Postings.Find(MakeTrigram(LowerQuery[Index], LowerQuery[Index + 1], LowerQuery[Index + 2]));
+            if (!Postings)
+            {
+                Lists.Reset();
+                break;
+            }
+            Lists.AddUnique(Postings);
+        }
+
+        if (Lists.Num() > 0)
+        {
+            Lists.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+
+            TArray<int32> Candidates;
+            Candidates.Reserve(Lists[0]->Num());
+            for (const int32 LineIndex : *Lists[0])
+            {
+                bool bInAll = true;
+                for (int32 List = 1; List < Lists.Num() && bInAll; ++List)
+                {
+                    bInAll = Algo::BinarySearch(*Lists[List], LineIndex) != INDEX_NONE;
+                }
+                if (bInAll)
+                {
+                    Candidates.Add(LineIndex);
+                }
+            }
+            FilterLines(LowerQuery, &Candidates, MatchedLines, MatchedColumns);
+        }
+    }
+    else
+    {
+        FilterLines(LowerQuery, nullptr, MatchedLines, MatchedColumns);
+    }
+
+    const int32 NumHits = MaxHits > 0 ? FMath::Min(MaxHits, MatchedLines.Num()) : MatchedLines.Num();
+    OutHits.Reserve(NumHits);
+    for (int32 Index = 0; Index < NumHits; ++Index)
+    {
+        const FLine& Line = Current->Lines[MatchedLines[Index]];
+        OutHits.Add({ Line.Document, Line.Line, MatchedColumns[Index] });
+    }
+
+    LastQuery = LowerQuery;
+    LastLines = MoveTemp(MatchedLines);
+    LastColumns = MoveTemp(MatchedColumns);
+}
+
+void FN2CCodeSearchIndex::FilterLines(const FString& Query, const TArray<int32>* Candidates, TArray<int32>& OutLines, TArray<int32>& OutColumns) const
+{
+    const FIndexState* Current = State.IsValid() ? State.Get() : Lines.Get();
+    const int32 NumCandidates = Candidates ? Candidates->Num() : Current->Lines.Num();
+    for (int32 Candidate = 0; Candidate < NumCandidates; ++Candidate)
+    {
+        const int32 LineIndex = Candidates ? (*Candidates)[Candidate] : Candidate;
+        const FLine& Line = Current->Lines[LineIndex];
+        if (Line.Len < Query.Len())
+        {
+            continue;
+        }
+
+        const FStringView Text = FStringView((*Documents)[Line.Document]).Mid(Line.Start, Line.Len);
+        const int32 Column = UE::String::FindFirst(Text, Query, ESearchCase::IgnoreCase);
+        if (Column != INDEX_NONE)
+        {
+            OutLines.Add(LineIndex);
+            OutColumns.Add(Column);
+        }
+    }
+}
+
+uint64 FN2CCodeSearchIndex::MakeTrigram(TCHAR A, TCHAR B, TCHAR C)
+{
+    // 21 bits hold any code point, whatever the width of TCHAR
+    constexpr uint64 Mask = (1ull << 21) - 1;
+    return ((static_cast<uint64>(FChar::ToLower(A)) & Mask) << 42)
+        | ((static_cast<uint64>(FChar::ToLower(B)) & Mask) << 21)
+        | (static_cast<uint64>(FChar::ToLower(C)) & Mask);
+}
+
+TSharedPtr<const FN2CCodeSearchIndex::FIndexState> FN2CCodeSearchIndex::Build(const TArray<FString>& Documents, bool bIndex)
+{
+    TSharedRef<FIndexState> NewState = MakeShared<FIndexState>();
+    NewState->FirstLines.Reserve(Documents.Num());
+
+    for (int32 Document = 0; Document < Documents.Num(); ++Document)
+    {
+        const FString& Text = Documents[Document];
+        NewState->FirstLines.Add(NewState->Lines.Num());
+
+        int32 LineStart = 0;
+        int32 LineNumber = 0;
+        for (int32 Index = 0; Index <= Text.Len(); ++Index)
+        {
+            if (Index < Text.Len() && Text[Index] != TEXT('\n'))
+            {
+                continue;
+            }
+
+            // A trailing carriage return is not part of the line
+            const int32 LineEnd = Index > LineStart && Text[Index - 1] == TEXT('\r') ? Index - 1 : Index;
+            NewState->Lines.Add({ Document, LineNumber++, LineStart, LineEnd - LineStart });
+            LineStart = Index + 1;
+        }
+    }
+
+    if (!bIndex)
+    {
+        return NewState;
+    }
+
+    // Lines are visited in order, so each list stays sorted and a line is added only once in a row
+    for (int32 LineIndex = 0; LineIndex < NewState->Lines.Num(); ++LineIndex)
+    {
+        const FLine& Line = NewState->Lines[LineIndex];
+        const TCHAR* Text = *Documents[Line.Document] + Line.Start;
+        for (int32 Index = 0; Index + 2 < Line.Len; ++Index)
+        {
+            TArray<int32>& Postings = NewState->Postings.FindOrAdd(MakeTrigram(Text[Index], Text[Index + 1], Text[Index + 2]));
+            if (Postings.Num() == 0 || Postings.Last() != LineIndex)
+            {
+                Postings.Add(LineIndex);
+            }
+        }
+    }
+    return NewState;
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Models/N2CLineDiff.h"
+#include "Framework/Text/TextRange.h"
+
+namespace
+{
+    /** Case-sensitive line keys that are views into the diffed texts */
+    struct FLineKeyFuncs : TDefaultMapKeyFuncs<FStringView, int32, false>
+    {
+        static bool Matches(FStringView A, FStringView B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static uint32 GetKeyHash(FStringView Key) { return FCrc::MemCrc32(Key.GetData(), Key.Len() * sizeof(TCHAR)); }
+    };
+
+    using FLineIds = TMap<FStringView, int32, FDefaultSetAllocator, FLineKeyFuncs>;
+
+    /** Map each line of Text to an id shared by all equal lines of both texts */
+    TArray<int32> InternLines(const FString& Text, FLineIds& Ids)
+    {
+        TArray<FTextRange> LineRanges;
+        FTextRange::CalculateLineRangesFromString(Text, LineRanges);
+
+        TArray<int32> Lines;
+        Lines.Reserve(LineRanges.Num());
+        for (const FTextRange& Range : LineRanges)
+        {
+            const FStringView Line(*Text + Range.BeginIndex, Range.Len());
+            Lines.Add(Ids.FindOrAdd(Line, Ids.Num()));
+        }
+        return Lines;
+    }
+}
+
+TArray<FN2CDiffRun> FN2CLineDiff::Diff(const FString& OldText, const FString& NewText)
+{
+    FLineIds Ids;
+    const TArray<int32> Old = InternLines(OldText, Ids);
+    const TArray<int32> New = InternLines(NewText, Ids);
+
+    TArray<FN2CDiffRun> Runs;
+    DiffRange(Old, 0, Old.Num(), New, 0, New.Num(), Runs);
+    return Runs;
+}
+
+void FN2CLineDiff::DiffRange(const TArray<int32>& Old, int32 OldBegin, int32 OldEnd,
+    const TArray<int32>& New, int32 NewBegin, int32 NewEnd, TArray<FN2CDiffRun>& OutRuns)
+{
+    int32 Prefix = 0;
+    while (OldBegin + Prefix < OldEnd && NewBegin + Prefix < NewEnd && Old[OldBegin + Prefix] == New[NewBegin + Prefix])
+    {
+        ++Prefix;
+    }
+    AddRun(OutRuns, EN2CDiffOp::Equal, OldBegin, NewBegin, Prefix);
+    OldBegin += Prefix;
+    NewBegin += Prefix;
+
+    int32 Suffix = 0;
+    while (OldEnd - Suffix > OldBegin && NewEnd - Suffix > NewBegin && Old[OldEnd - 1 - Suffix] == New[NewEnd - 1 - Suffix])
+    {
+        ++Suffix;
+    }
+    OldEnd -= Suffix;
+    NewEnd -= Suffix;
+
+    const int32 N = OldEnd - OldBegin;
+    const int32 M = NewEnd - NewBegin;
+    if (N == 0 || M == 0)
+    {
+        AddRun(OutRuns, EN2CDiffOp::Delete, OldBegin, NewBegin, N);
+        AddRun(OutRuns, EN2CDiffOp::Insert, OldEnd, NewBegin, M);
+    }
+    else
+    {
+        // Search for the middle snake from both ends at once; the furthest x reached on each diagonal
+        // k = x - y is kept per direction, the backward one measured from the ends of the ranges
+        const int32 Delta = N - M;
+        const bool bOddDelta = (Delta & 1) != 0;
+        const int32 MaxD = (N + M + 1) / 2;
+        const int32 Offset = MaxD + 1;
+
+        TArray<int32> Forward;
+        TArray<int32> Backward;
+        Forward.Init(0, 2 * Offset + 1);
+        Backward.Init(0, 2 * Offset + 1);
+
+        int32 SplitX = INDEX_NONE;
+        int32 SplitY = INDEX_NONE;
+        for (int32 D = 0; D <= MaxD && SplitX == INDEX_NONE; ++D)
+        {
+            for (int32 K = -D; K <= D; K += 2)
+            {
+                int32 X = (K == -D || (K != D && Forward[Offset + K - 1] < Forward[Offset + K + 1]))
+                    ? Forward[Offset + K + 1]
+                    : Forward[Offset + K - 1] + 1;
+                int32 Y = X - K;
+                while (X < N && Y < M && Old[OldBegin + X] == New[NewBegin + Y])
+                {
+                    ++X;
+                    ++Y;
+                }
+                Forward[Offset + K] = X;
+
+                const int32 BackwardK = Delta - K;
+                if (bOddDelta && BackwardK >= -(D - 1) && BackwardK <= D - 1 && X + Backward[Offset + BackwardK] >= N)
+                {
+                    SplitX = X;
+                    SplitY = Y;
+                    break;
+                }
+            }
+            if (SplitX != INDEX_NONE)
+            {
+                break;
+            }
+
+            for (int32 K = -D; K <= D; K += 2)
+            {
+                int32 X = (K == -D || (K != D && Backward[Offset + K - 1] < Backward[Offset + K + 1]))
+                    ? Backward[Offset + K + 1]
+                    : Backward[Offset + K - 1] + 1;
+                int32 Y = X - K;
+                while (X < N && Y < M && Old[OldEnd - 1 - X] == New[NewEnd - 1 - Y])
+                {
+                    ++X;
+                    ++Y;
+                }
+                Backward[Offset + K] = X;
+
+                const int32 ForwardK = Delta - K;
+                if (!bOddDelta && ForwardK >= -D && ForwardK <= D && Forward[Offset + ForwardK] + X >= N)
+                {
+                    SplitX = N - X;
+                    SplitY = M - Y;
+                    break;
+                }
+            }
+        }
+
+        if (SplitX == INDEX_NONE)
+        {
+            // Unreachable for valid input; keep the output correct regardless
+            AddRun(OutRuns, EN2CDiffOp::Delete, OldBegin, NewBegin, N);
+            AddRun(OutRuns, EN2CDiffOp::Insert, OldEnd, NewBegin, M);
+        }
+        else
+        {
+            DiffRange(Old, OldBegin, OldBegin + SplitX, New, NewBegin, NewBegin + SplitY, OutRuns);
+            DiffRange(Old, OldBegin + SplitX, OldEnd, New, NewBegin + SplitY, NewEnd, OutRuns);
+        }
+    }
+
+    AddRun(OutRuns, EN2CDiffOp::Equal, OldEnd, NewEnd, Suffix);
+}
+
+void FN2CLineDiff::AddRun(TArray<FN2CDiffRun>& OutRuns, EN2CDiffOp Op, int32 OldStart, int32 NewStart, int32 Count)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    if (OutRuns.Num() > 0 && OutRuns.Last().Op == Op)
+    {
+        FN2CDiffRun& Last = OutRuns.Last();
+        const bool bContinues = Op == EN2CDiffOp::Insert
+            ? Last.NewStart + Last.Count == NewStart
+            : Last.OldStart + Last.Count == OldStart;
+        if (bContinues)
+        {
+            Last.Count += Count;
+            return;
+        }
+    }
+
+    OutRuns.Add({ Op, OldStart, NewStart, Count });
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Models/N2CTranslationBrowser.h"
+#include "Code Editor/Widgets/N2CCodeEditorWidget.h"
+#include "LLM/N2CLLMModule.h"
+
+void UN2CTranslationBrowser::SetResponse(const FN2CTranslationResponse& Response)
+{
+    ++ResponseId;
+    Graphs.Reset(Response.Graphs.Num());
+    Code.Reset(Response.Graphs.Num());
+
+    for (const FN2CGraphTranslation& Graph : Response.Graphs)
+    {
+        FN2CTranslationGraphInfo& Info = Graphs.AddDefaulted_GetRef();
+        Info.GraphName = Graph.GraphName;
+        Info.GraphType = Graph.GraphType;
+        Info.GraphClass = Graph.GraphClass;
+        Info.DeclarationLength = Graph.Code.GraphDeclaration.Len();
+        Info.ImplementationLength = Graph.Code.GraphImplementation.Len();
+
+        int32 NumLines = Graph.Code.GraphImplementation.IsEmpty() ? 0 : 1;
+        for (const TCHAR Char : Graph.Code.GraphImplementation)
+        {
+            NumLines += Char == TEXT('\n') ? 1 : 0;
+        }
+        Info.ImplementationLines = NumLines;
+
+        Code.Add(Graph.Code);
+    }
+
+    // Two documents per graph, so a search hit's document gives its graph and part
+    TSharedRef<TArray<FString>> Documents = MakeShared<TArray<FString>>();
+    Documents->Reserve(Code.Num() * 2);
+    for (const FN2CGeneratedCode& GraphCode : Code)
+    {
+        Documents->Add(GraphCode.GraphDeclaration);
+        Documents->Add(GraphCode.GraphImplementation);
+    }
+    SearchIndex.SetDocuments(Documents);
+}
+
+bool UN2CTranslationBrowser::GetGraphCode(int32 GraphIndex, FN2CGeneratedCode& OutCode) const
+{
+    if (!Code.IsValidIndex(GraphIndex))
+    {
+        return false;
+    }
+    OutCode = Code[GraphIndex];
+    return true;
+}
+
+bool UN2CTranslationBrowser::ShowGraph(int32 GraphIndex, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor)
+{
+    if (!Code.IsValidIndex(GraphIndex))
+    {
+        return false;
+    }
+
+    const FN2CGeneratedCode& GraphCode = Code[GraphIndex];
+    if (DeclarationEditor)
+    {
+        DeclarationEditor->SetDocumentCode(*FString::Printf(TEXT("N2C.%d.%d.Declaration"), ResponseId, GraphIndex),
+            GraphCode.GraphDeclaration);
+    }
+    if (ImplementationEditor)
+    {
+        ImplementationEditor->SetDocumentCode(*FString::Printf(TEXT("N2C.%d.%d.Implementation"), ResponseId, GraphIndex),
+            GraphCode.GraphImplementation);
+    }
+    return true;
+}
+
+bool UN2CTranslationBrowser::ShowGraphDiff(int32 GraphIndex, const FString& BlueprintName, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor)
+{
+    if (!Code.IsValidIndex(GraphIndex))
+    {
+        return false;
+    }
+
+    FN2CGraphTranslation Graph;
+    Graph.GraphName = Graphs[GraphIndex].GraphName;
+    Graph.GraphType = Graphs[GraphIndex].GraphType;
+    Graph.GraphClass = Graphs[GraphIndex].GraphClass;
+
+    FN2CGeneratedCode PreviousCode;
+    if (!UN2CLLMModule::Get()->LoadPreviousGraphCode(BlueprintName, Graph, PreviousCode))
+    {
+        return false;
+    }
+
+    const FN2CGeneratedCode& GraphCode = Code[GraphIndex];
+    if (DeclarationEditor)
+    {
+        DeclarationEditor->ShowCodeDiff(PreviousCode.GraphDeclaration, GraphCode.GraphDeclaration);
+    }
+    if (ImplementationEditor)
+    {
+        ImplementationEditor->ShowCodeDiff(PreviousCode.GraphImplementation, GraphCode.GraphImplementation);
+    }
+    return true;
+}
+
+TArray<FN2CCodeSearchMatch> UN2CTranslationBrowser::FindInGraphs(const FString& Query, int32 MaxMatches)
+{
+    TArray<FN2CCodeSearchMatch> Matches;
+
+    TArray<FN2CCodeSearchIndex::FHit> Hits;
+    SearchIndex.Find(Query, MaxMatches, Hits);
+    Matches.Reserve(Hits.Num());
+
+    constexpr int32 MaxLineText = 200;
+    for (const FN2CCodeSearchIndex::FHit& Hit : Hits)
+    {
+        FN2CCodeSearchMatch& Match = Matches.AddDefaulted_GetRef();
+        Match.GraphIndex = Hit.Document / 2;
+        Match.bImplementation = Hit.Document % 2 == 1;
+        Match.Line = Hit.Line;
+        Match.Column = Hit.Column;
+        Match.Length = Query.Len();
+
+        FStringView LineText = SearchIndex.GetLine(Hit.Document, Hit.Line).TrimStartAndEnd();
+        Match.LineText = FString(LineText.Left(MaxLineText));
+    }
+    return Matches;
+}
+
+bool UN2CTranslationBrowser::ShowMatch(const FN2CCodeSearchMatch& Match, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor)
+{
+    if (!ShowGraph(Match.GraphIndex, DeclarationEditor, ImplementationEditor))
+    {
+        return false;
+    }
+
+    UN2CCodeEditorWidget* Editor = Match.bImplementation ? ImplementationEditor : DeclarationEditor;
+    if (Editor)
+    {
+        // Scrolls the viewer too, which large texts are shown in and which has no selection
+        Editor->SetCursorPosition(Match.Line, Match.Column);
+        Editor->SelectText(Match.Line, Match.Column, Match.Line, Match.Column + Match.Length);
+    }
+    return true;
+}
@@ -52,6 +52,8 @@ FN2CCPPSyntaxDefinition::FN2CCPPSyntaxDefinition()
     LineCommentDelimiter = TEXT("//");
     BlockCommentStart = TEXT("/*");
     BlockCommentEnd = TEXT("*/");
+
+    BuildTokenLookup();
 }
 
 void FN2CCPPSyntaxDefinition::GetCommentDelimiters(FString& OutLineComment, FString& OutBlockCommentStart, FString& OutBlockCommentEnd) const
@@ -47,6 +47,8 @@ FN2CCSharpSyntaxDefinition::FN2CCSharpSyntaxDefinition()
     LineCommentDelimiter = TEXT("//");
     BlockCommentStart = TEXT("/*");
     BlockCommentEnd = TEXT("*/");
+
+    BuildTokenLookup();
 }
 
 void FN2CCSharpSyntaxDefinition::GetCommentDelimiters(
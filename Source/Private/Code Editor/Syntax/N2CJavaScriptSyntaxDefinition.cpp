@@ -41,6 +41,8 @@ FN2CJavaScriptSyntaxDefinition::FN2CJavaScriptSyntaxDefinition()
     LineCommentDelimiter = TEXT("//");
     BlockCommentStart = TEXT("/*");
     BlockCommentEnd = TEXT("*/");
+
+    BuildTokenLookup();
 }
 
 void FN2CJavaScriptSyntaxDefinition::GetCommentDelimiters(FString& OutLineComment, FString& OutBlockCommentStart, FString& OutBlockCommentEnd) const
@@ -22,6 +22,8 @@ FN2CPseudocodeSyntaxDefinition::FN2CPseudocodeSyntaxDefinition()
     LineCommentDelimiter = TEXT("//");
     BlockCommentStart = TEXT("/*");
     BlockCommentEnd = TEXT("*/");
+
+    BuildTokenLookup();
 }
 
 void FN2CPseudocodeSyntaxDefinition::GetCommentDelimiters(FString& OutLineComment, FString& OutBlockCommentStart, FString& OutBlockCommentEnd) const
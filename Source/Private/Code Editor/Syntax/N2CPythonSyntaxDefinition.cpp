@@ -40,6 +40,8 @@ FN2CPythonSyntaxDefinition::FN2CPythonSyntaxDefinition()
     LineCommentDelimiter = TEXT("#");
     BlockCommentStart = TEXT("\"\"\"");
     BlockCommentEnd = TEXT("\"\"\"");
+
+    BuildTokenLookup();
 }
 
 void FN2CPythonSyntaxDefinition::GetCommentDelimiters(FString& OutLineComment, FString& OutBlockCommentStart, FString& OutBlockCommentEnd) const
@@ -2,269 +2,661 @@
 
 #include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
 #include "Code Editor/Syntax/N2CSyntaxDefinitionFactory.h"
+#include "Code Editor/Syntax/N2CSyntaxTokenizer.h"
 #include "Code Editor/Syntax/N2CWhiteSpaceRun.h"
+#include "Utils/N2CStats.h"
+#include "Algo/AllOf.h"
+#include "Async/Async.h"
+
+namespace
+{
+    /** Language name for style lookup */
+    FName GetLanguageId(EN2CCodeLanguage Language)
+    {
+        switch (Language)
+        {
+            case EN2CCodeLanguage::Cpp:
+                return TEXT("CPP");
+            case EN2CCodeLanguage::Python:
+                return TEXT("Python");
+            case EN2CCodeLanguage::JavaScript:
+                return TEXT("JavaScript");
+            case EN2CCodeLanguage::CSharp:
+                return TEXT("CSharp");
+            case EN2CCodeLanguage::Swift:
+                return TEXT("Swift");
+            case EN2CCodeLanguage::Pseudocode:
+                return TEXT("Pseudocode");
+            default:
+                checkf(false, TEXT("Unsupported language type"));
+                return NAME_None;
+        }
+    }
+}
 
 TSharedRef<FN2CRichTextSyntaxHighlighter> FN2CRichTextSyntaxHighlighter::Create(EN2CCodeLanguage Language, const FName& ThemeName, const FTextBlockStyle& BaseStyle)
 {
-    // Get the syntax definition for this language
-    TSharedPtr<FN2CSyntaxDefinition> SyntaxDef = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(Language);
+    // The definition and tokenizer for this language are shared by all highlighters
+    TSharedPtr<const FN2CSyntaxDefinition> SyntaxDef = FN2CSyntaxDefinitionFactory::Get().GetDefinition(Language);
     check(SyntaxDef.IsValid());
 
-    // Get the language name for style lookup
-    FName LanguageId;
-    switch (Language)
+    // Create the highlighter
+    return MakeShareable(new FN2CRichTextSyntaxHighlighter(
+        FN2CSyntaxDefinitionFactory::Get().GetTokenizer(Language).ToSharedRef(),
+        GetSharedStyle(GetLanguageId(Language), ThemeName, BaseStyle.Font),
+        SyntaxDef
+    ));
+}
+
+void FN2CRichTextSyntaxHighlighter::SetLanguage(EN2CCodeLanguage Language, const FName& ThemeName, const FTextBlockStyle& BaseStyle)
+{
+    const TSharedRef<const FSyntaxTextStyle> NewStyle = GetSharedStyle(GetLanguageId(Language), ThemeName, BaseStyle.Font);
+    const bool bLanguageChanged = SyntaxDefinition->GetLanguage() != Language;
+    if (!bLanguageChanged && NewStyle == SyntaxTextStyle)
     {
-        case EN2CCodeLanguage::Cpp:
-            LanguageId = TEXT("CPP");
-            break;
-        case EN2CCodeLanguage::Python:
-            LanguageId = TEXT("Python");
-            break;
-        case EN2CCodeLanguage::JavaScript:
-            LanguageId = TEXT("JavaScript");
-            break;
-        case EN2CCodeLanguage::CSharp:
-            LanguageId = TEXT("CSharp");
-            break;
-        case EN2CCodeLanguage::Swift:
-            LanguageId = TEXT("Swift");
-            break;
-        case EN2CCodeLanguage::Pseudocode:
-            LanguageId = TEXT("Pseudocode");
-            break;
-        default:
-            checkf(false, TEXT("Unsupported language type"));
-            break;
+        return;
+    }
+
+    // A running worker lexes with the current definition and its results no longer apply
+    if (AsyncLexTask.IsValid())
+    {
+        AsyncLexTask.Wait();
+    }
+    ++AsyncLexState->Generation;
+
+    if (bLanguageChanged)
+    {
+        SyntaxDefinition = FN2CSyntaxDefinitionFactory::Get().GetDefinition(Language);
+        check(SyntaxDefinition.IsValid());
+        SyntaxTokenizer = FN2CSyntaxDefinitionFactory::Get().GetTokenizer(Language).ToSharedRef();
+        Tokenizer = SyntaxTokenizer;
+
+        // Lexed lines only hold for the language they were lexed in
+        Lines.Reset();
+    }
+    SyntaxTextStyle = NewStyle;
+
+    MakeDirty();
+}
+
+FN2CRichTextSyntaxHighlighter::~FN2CRichTextSyntaxHighlighter()
+{
+    // The worker lexes through this highlighter's definition and tokenizer
+    if (AsyncLexTask.IsValid())
+    {
+        AsyncLexTask.Wait();
     }
+}
 
-    // Create tokenizer rules from syntax definition
-    TArray<FSyntaxTokenizer::FRule> TokenizerRules;
+namespace
+{
+    using FSharedStyleKey = TTuple<FName, FName, FSlateFontInfo>;
 
-    // Add operator rules
-    for (const FString& Operator : SyntaxDef->GetOperators())
+    TMap<FSharedStyleKey, TSharedRef<const FN2CRichTextSyntaxHighlighter::FSyntaxTextStyle>>& GetSharedStyles()
     {
-        TokenizerRules.Emplace(FSyntaxTokenizer::FRule(Operator));
+        static TMap<FSharedStyleKey, TSharedRef<const FN2CRichTextSyntaxHighlighter::FSyntaxTextStyle>> SharedStyles;
+        return SharedStyles;
     }
+}
+
+TSharedRef<const FN2CRichTextSyntaxHighlighter::FSyntaxTextStyle> FN2CRichTextSyntaxHighlighter::GetSharedStyle(const FName& LanguageId, const FName& ThemeName, const FSlateFontInfo& Font)
+{
+    check(IsInGameThread());
 
-    // Add keyword rules with word boundary markers to prevent partial matches
-    for (const FString& Keyword : SyntaxDef->GetKeywords())
+    const FSharedStyleKey Key(LanguageId, ThemeName, Font);
+    if (const TSharedRef<const FSyntaxTextStyle>* Existing = GetSharedStyles().Find(Key))
     {
-        TokenizerRules.Emplace(FSyntaxTokenizer::FRule(TEXT("\\b") + Keyword + TEXT("\\b")));
+        return *Existing;
     }
 
-    // Create the syntax text styles
-    FSyntaxTextStyle SyntaxStyles(LanguageId, ThemeName);
+    TSharedRef<FSyntaxTextStyle> SyntaxStyles = MakeShared<FSyntaxTextStyle>(LanguageId, ThemeName);
 
     // Apply the base font to all styles
-    SyntaxStyles.NormalTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.OperatorTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.KeywordTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.StringTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.NumberTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.CommentTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.PreprocessorTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.ParenthesesTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.CurlyBracesTextStyle.SetFont(BaseStyle.Font);
-    SyntaxStyles.SquareBracketsTextStyle.SetFont(BaseStyle.Font);
+    SyntaxStyles->NormalTextStyle.SetFont(Font);
+    SyntaxStyles->OperatorTextStyle.SetFont(Font);
+    SyntaxStyles->KeywordTextStyle.SetFont(Font);
+    SyntaxStyles->StringTextStyle.SetFont(Font);
+    SyntaxStyles->NumberTextStyle.SetFont(Font);
+    SyntaxStyles->CommentTextStyle.SetFont(Font);
+    SyntaxStyles->PreprocessorTextStyle.SetFont(Font);
+    SyntaxStyles->ParenthesesTextStyle.SetFont(Font);
+    SyntaxStyles->CurlyBracesTextStyle.SetFont(Font);
+    SyntaxStyles->SquareBracketsTextStyle.SetFont(Font);
 
-    // Create the highlighter
-    return MakeShareable(new FN2CRichTextSyntaxHighlighter(
-        FSyntaxTokenizer::Create(TokenizerRules),
-        SyntaxStyles,
-        SyntaxDef
-    ));
+    GetSharedStyles().Add(Key, SyntaxStyles);
+    return SyntaxStyles;
 }
 
-FN2CRichTextSyntaxHighlighter::~FN2CRichTextSyntaxHighlighter()
+void FN2CRichTextSyntaxHighlighter::ResetSharedStyles()
 {
+    GetSharedStyles().Reset();
 }
 
-void FN2CRichTextSyntaxHighlighter::ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines)
+void FN2CRichTextSyntaxHighlighter::SetText(const FString& SourceString, FTextLayout& TargetTextLayout)
 {
-    enum class EParseState : uint8
-    {
-        None,
-        LookingForString,
-        LookingForChar,
-        LookingForLineComment,
-        LookingForBlockComment,
-        LookingForPreprocessor
+    LLM_SCOPE_BYTAG(NodeToCode_CodeEditor);
+
+    if (!bSyntaxHighlightingEnabled)
+    {
+        Lines.Reset();
+        FSyntaxHighlighterTextLayoutMarshaller::SetText(SourceString, TargetTextLayout);
+        return;
+    }
+
+    TArray<FTextRange> LineRanges;
+    FTextRange::CalculateLineRangesFromString(SourceString, LineRanges);
+
+    auto LineEquals = [&SourceString](const FTextRange& Range, const FLine& Line)
+    {
+        return Line.Text.Len() == Range.Len()
+            && FCString::Strncmp(*SourceString + Range.BeginIndex, *Line.Text, Range.Len()) == 0;
     };
 
-    FString LineComment, BlockCommentStart, BlockCommentEnd;
-    SyntaxDefinition->GetCommentDelimiters(LineComment, BlockCommentStart, BlockCommentEnd);
+    // Lines outside the edit are the ones unchanged at the start and end of the text
+    const int32 OldNum = Lines.Num();
+    const int32 NewNum = LineRanges.Num();
+    int32 Prefix = 0;
+    while (Prefix < OldNum && Prefix < NewNum && LineEquals(LineRanges[Prefix], Lines[Prefix]))
+    {
+        ++Prefix;
+    }
+    int32 Suffix = 0;
+    while (Suffix < OldNum - Prefix && Suffix < NewNum - Prefix
+        && LineEquals(LineRanges[NewNum - 1 - Suffix], Lines[OldNum - 1 - Suffix]))
+    {
+        ++Suffix;
+    }
 
-    TArray<FTextLayout::FNewLineData> LinesToAdd;
-    LinesToAdd.Reserve(TokenizedLines.Num());
+    // Too much to lex without blocking input: show plain text and lex on a worker
+    if (NewNum - Prefix - Suffix >= AsyncLexLineThreshold)
+    {
+        StartAsyncLex(SourceString, LineRanges, TargetTextLayout);
+        return;
+    }
+    ++AsyncLexState->Generation;
 
-    EParseState ParseState = EParseState::None;
-    for (const ISyntaxTokenizer::FTokenizedLine& TokenizedLine : TokenizedLines)
+    TArray<FLine> OldLines = MoveTemp(Lines);
+    Lines.Reset(NewNum);
+    for (int32 Index = 0; Index < Prefix; ++Index)
     {
-        TSharedRef<FString> ModelString = MakeShareable(new FString());
-        TArray<TSharedRef<IRun>> Runs;
+        Lines.Add(MoveTemp(OldLines[Index]));
+    }
+
+    // Re-lex the edited lines, then the lines after them until one starts in the state it did before
+    for (int32 Index = Prefix; Index < NewNum; ++Index)
+    {
+        const EParseState StartState = Index > 0 ? Lines[Index - 1].EndState : EParseState::None;
+        const int32 OldIndex = Index - NewNum + OldNum;
 
-        for (const ISyntaxTokenizer::FToken& Token : TokenizedLine.Tokens)
+        if (Index >= NewNum - Suffix && OldLines[OldIndex].StartState == StartState)
         {
-            const FString TokenText = SourceString.Mid(Token.Range.BeginIndex, Token.Range.Len());
-            const FTextRange ModelRange(ModelString->Len(), ModelString->Len() + TokenText.Len());
-            ModelString->Append(TokenText);
+            for (int32 Unchanged = OldIndex; Unchanged < OldNum; ++Unchanged)
+            {
+                Lines.Add(MoveTemp(OldLines[Unchanged]));
+            }
+            break;
+        }
+
+        ISyntaxTokenizer::FTokenizedLine TokenizedLine;
+        SyntaxTokenizer->TokenizeLine(SourceString, LineRanges[Index], TokenizedLine);
+        LexLine(SourceString, TokenizedLine, StartState, Lines.AddDefaulted_GetRef());
+    }
+
+    AddLinesToLayout(TargetTextLayout);
+}
+
+void FN2CRichTextSyntaxHighlighter::StartAsyncLex(const FString& SourceString, const TArray<FTextRange>& LineRanges, FTextLayout& TargetTextLayout)
+{
+    // Results of an older text are dropped when they arrive
+    const uint32 Generation = ++AsyncLexState->Generation;
 
-            FRunInfo RunInfo(TEXT("N2CCodeEditor.Normal"));
-            FTextBlockStyle TextBlockStyle = SyntaxTextStyle.NormalTextStyle;
+    // Any cached line may have changed; until the worker is done the text is shown plain
+    Lines.Reset();
+    TArray<FTextLayout::FNewLineData> PlainLines;
+    PlainLines.Reserve(LineRanges.Num());
+    for (const FTextRange& LineRange : LineRanges)
+    {
+        FLine PlainLine;
+        PlainLine.Text = FString(LineRange.Len(), *SourceString + LineRange.BeginIndex);
+        PlainLine.Spans.Add({ FTextRange(0, LineRange.Len()), ERunStyle::Normal });
+        PlainLines.Add(MakeLineData(PlainLine));
+    }
+    TargetTextLayout.AddLines(PlainLines);
 
-            const bool bIsWhitespace = FString(TokenText).TrimEnd().IsEmpty();
-            if (!bIsWhitespace)
+    if (AsyncLexTask.IsValid())
+    {
+        AsyncLexTask.Wait();
+    }
+
+    TWeakPtr<FAsyncLexState, ESPMode::ThreadSafe> WeakState = AsyncLexState;
+    AsyncLexTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, WeakState, Generation, Source = SourceString, LineRanges]()
+    {
+        TArray<FLine> LexedLines;
+        LexedLines.Reserve(LineRanges.Num());
+        for (const FTextRange& LineRange : LineRanges)
+        {
+            const EParseState StartState = LexedLines.Num() > 0 ? LexedLines.Last().EndState : EParseState::None;
+
+            ISyntaxTokenizer::FTokenizedLine TokenizedLine;
+            SyntaxTokenizer->TokenizeLine(Source, LineRange, TokenizedLine);
+            LexLine(Source, TokenizedLine, StartState, LexedLines.AddDefaulted_GetRef());
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakState, Generation, LexedLines = MoveTemp(LexedLines)]() mutable
+        {
+            // The state only lives as long as its highlighter, which is destroyed on this thread
+            const TSharedPtr<FAsyncLexState, ESPMode::ThreadSafe> State = WeakState.Pin();
+            if (State.IsValid() && State->Generation == Generation)
             {
-                bool bHasMatchedSyntax = false;
+                State->Owner->Lines = MoveTemp(LexedLines);
+
+                // The layout refreshes from the cache, which now holds every line
+                State->Owner->MakeDirty();
+            }
+        });
+    });
+}
+
+void FN2CRichTextSyntaxHighlighter::ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines)
+{
+    // Only reached if the base marshaller lexes the whole text, so nothing cached can be trusted
+    Lines.Reset(TokenizedLines.Num());
+    for (const ISyntaxTokenizer::FTokenizedLine& TokenizedLine : TokenizedLines)
+    {
+        const EParseState StartState = Lines.Num() > 0 ? Lines.Last().EndState : EParseState::None;
+        LexLine(SourceString, TokenizedLine, StartState, Lines.AddDefaulted_GetRef());
+    }
+
+    AddLinesToLayout(TargetTextLayout);
+}
+
+void FN2CRichTextSyntaxHighlighter::LexLine(const FString& SourceString, const ISyntaxTokenizer::FTokenizedLine& TokenizedLine, EParseState StartState, FLine& OutLine) const
+{
+    FString LineComment, BlockCommentStart, BlockCommentEnd;
+    SyntaxDefinition->GetCommentDelimiters(LineComment, BlockCommentStart, BlockCommentEnd);
 
-                // Handle strings first
-                if (ParseState == EParseState::None && 
-                    TokenText.Len() == 1 && 
-                    SyntaxDefinition->GetStringDelimiters().Contains(TokenText[0]))
+    OutLine.Text = FString(TokenizedLine.Range.Len(), *SourceString + TokenizedLine.Range.BeginIndex);
+    OutLine.StartState = StartState;
+    OutLine.Spans.Reset(TokenizedLine.Tokens.Num());
+
+    EParseState ParseState = StartState;
+    for (const ISyntaxTokenizer::FToken& Token : TokenizedLine.Tokens)
+    {
+        const FStringView TokenText(*SourceString + Token.Range.BeginIndex, Token.Range.Len());
+        const FTextRange LineRange(Token.Range.BeginIndex - TokenizedLine.Range.BeginIndex, Token.Range.EndIndex - TokenizedLine.Range.BeginIndex);
+
+        ERunStyle Style = ERunStyle::Normal;
+
+        const bool bIsWhitespace = Algo::AllOf(TokenText, [](TCHAR Char) { return FChar::IsWhitespace(Char); });
+        if (!bIsWhitespace)
+        {
+            bool bHasMatchedSyntax = false;
+
+            // Handle strings first
+            if (ParseState == EParseState::None && 
+                TokenText.Len() == 1 && 
+                SyntaxDefinition->GetStringDelimiters().Contains(TokenText[0]))
+            {
+                Style = ERunStyle::String;
+                ParseState = EParseState::LookingForString;
+                bHasMatchedSyntax = true;
+            }
+            else if (ParseState == EParseState::LookingForString)
+            {
+                Style = ERunStyle::String;
+                
+                if (TokenText.Len() == 1 && SyntaxDefinition->GetStringDelimiters().Contains(TokenText[0]))
                 {
-                    RunInfo.Name = TEXT("String");
-                    TextBlockStyle = SyntaxTextStyle.StringTextStyle;
-                    ParseState = EParseState::LookingForString;
+                    ParseState = EParseState::None;
+                }
+                bHasMatchedSyntax = true;
+            }
+            // Handle comments
+            else if (ParseState == EParseState::None && TokenText.Equals(LineComment))
+            {
+                Style = ERunStyle::Comment;
+                ParseState = EParseState::LookingForLineComment;
+                bHasMatchedSyntax = true;
+            }
+            else if (ParseState == EParseState::None && TokenText.Equals(BlockCommentStart))
+            {
+                Style = ERunStyle::Comment;
+                ParseState = EParseState::LookingForBlockComment;
+                bHasMatchedSyntax = true;
+            }
+            else if (ParseState == EParseState::LookingForBlockComment && TokenText.Equals(BlockCommentEnd))
+            {
+                Style = ERunStyle::Comment;
+                ParseState = EParseState::None;
+                bHasMatchedSyntax = true;
+            }
+            // Handle brackets, keywords and operators
+            else if (ParseState == EParseState::None)
+            {
+                const EN2CSyntaxTokenKind Kind = SyntaxDefinition->Classify(TokenText);
+                if (Kind == EN2CSyntaxTokenKind::Parenthesis)
+                {
+                    Style = ERunStyle::Parentheses;
                     bHasMatchedSyntax = true;
                 }
-                else if (ParseState == EParseState::LookingForString)
+                else if (Kind == EN2CSyntaxTokenKind::CurlyBrace)
                 {
-                    RunInfo.Name = TEXT("String");
-                    TextBlockStyle = SyntaxTextStyle.StringTextStyle;
-                    
-                    if (TokenText.Len() == 1 && SyntaxDefinition->GetStringDelimiters().Contains(TokenText[0]))
-                    {
-                        ParseState = EParseState::None;
-                    }
+                    Style = ERunStyle::CurlyBraces;
                     bHasMatchedSyntax = true;
                 }
-                // Handle comments
-                else if (ParseState == EParseState::None && TokenText == LineComment)
+                else if (Kind == EN2CSyntaxTokenKind::SquareBracket)
                 {
-                    RunInfo.Name = TEXT("Comment");
-                    TextBlockStyle = SyntaxTextStyle.CommentTextStyle;
-                    ParseState = EParseState::LookingForLineComment;
+                    Style = ERunStyle::SquareBrackets;
                     bHasMatchedSyntax = true;
                 }
-                else if (ParseState == EParseState::None && TokenText == BlockCommentStart)
+                else if (Kind == EN2CSyntaxTokenKind::Keyword)
                 {
-                    RunInfo.Name = TEXT("Comment");
-                    TextBlockStyle = SyntaxTextStyle.CommentTextStyle;
-                    ParseState = EParseState::LookingForBlockComment;
+                    Style = ERunStyle::Keyword;
                     bHasMatchedSyntax = true;
                 }
-                else if (ParseState == EParseState::LookingForBlockComment && TokenText == BlockCommentEnd)
+                else if (Kind == EN2CSyntaxTokenKind::Operator)
                 {
-                    RunInfo.Name = TEXT("Comment");
-                    TextBlockStyle = SyntaxTextStyle.CommentTextStyle;
-                    ParseState = EParseState::None;
+                    Style = ERunStyle::Operator;
                     bHasMatchedSyntax = true;
                 }
-                // Handle brackets, keywords and operators
-                else if (ParseState == EParseState::None)
+                // Handle numbers
+                else if (IsNumeric(TokenText))
                 {
-                    if (SyntaxDefinition->GetParentheses().Contains(TokenText))
-                    {
-                        RunInfo.Name = TEXT("Parentheses");
-                        TextBlockStyle = SyntaxTextStyle.ParenthesesTextStyle;
-                        bHasMatchedSyntax = true;
-                    }
-                    else if (SyntaxDefinition->GetCurlyBraces().Contains(TokenText))
-                    {
-                        RunInfo.Name = TEXT("CurlyBraces");
-                        TextBlockStyle = SyntaxTextStyle.CurlyBracesTextStyle;
-                        bHasMatchedSyntax = true;
-                    }
-                    else if (SyntaxDefinition->GetSquareBrackets().Contains(TokenText))
-                    {
-                        RunInfo.Name = TEXT("SquareBrackets");
-                        TextBlockStyle = SyntaxTextStyle.SquareBracketsTextStyle;
-                        bHasMatchedSyntax = true;
-                    }
-                    else if (SyntaxDefinition->GetKeywords().Contains(TokenText))
-                    {
-                        RunInfo.Name = TEXT("Keyword");
-                        TextBlockStyle = SyntaxTextStyle.KeywordTextStyle;
-                        bHasMatchedSyntax = true;
-                    }
-                    else if (SyntaxDefinition->GetOperators().Contains(TokenText))
-                    {
-                        RunInfo.Name = TEXT("Operator");
-                        TextBlockStyle = SyntaxTextStyle.OperatorTextStyle;
-                        bHasMatchedSyntax = true;
-                    }
-                    // Handle numbers
-                    else if (IsNumeric(TokenText))
+                    Style = ERunStyle::Number;
+                    bHasMatchedSyntax = true;
+                }
+                // Handle preprocessor directives (only for C++)
+                else if (SyntaxDefinition->GetLanguage() == EN2CCodeLanguage::Cpp)
+                {
+                    // Check if this token starts with # or is part of the preprocessor directive
+                    if (TokenText.StartsWith(TEXT("#")) || 
+                        (OutLine.Text.Len() > 0 && OutLine.Text[0] == TEXT('#')))
                     {
-                        RunInfo.Name = TEXT("Number");
-                        TextBlockStyle = SyntaxTextStyle.NumberTextStyle;
+                        Style = ERunStyle::Preprocessor;
                         bHasMatchedSyntax = true;
                     }
-                    // Handle preprocessor directives (only for C++)
-                    else if (ParseState == EParseState::None && 
-                            SyntaxDefinition->GetLanguage() == EN2CCodeLanguage::Cpp)
-                    {
-                        // Check if this token starts with # or is part of the preprocessor directive
-                        if (TokenText.StartsWith(TEXT("#")) || 
-                            (TokenText.Len() > 0 && ModelString->Len() > 0 && (*ModelString)[0] == TEXT('#') && 
-                             !FChar::IsWhitespace(TokenText[0])))
-                        {
-                            RunInfo.Name = TEXT("Preprocessor");
-                            TextBlockStyle = SyntaxTextStyle.PreprocessorTextStyle;
-                            bHasMatchedSyntax = true;
-                        }
-                    }
                 }
+            }
 
-                // Handle literals and continuing states
-                if (!bHasMatchedSyntax)
+            // Handle literals and continuing states
+            if (!bHasMatchedSyntax)
+            {
+                switch (ParseState)
                 {
-                    switch (ParseState)
-                    {
-                        case EParseState::LookingForString:
-                            RunInfo.Name = TEXT("String");
-                            TextBlockStyle = SyntaxTextStyle.StringTextStyle;
-                            break;
-                        case EParseState::LookingForLineComment:
-                        case EParseState::LookingForBlockComment:
-                            RunInfo.Name = TEXT("Comment");
-                            TextBlockStyle = SyntaxTextStyle.CommentTextStyle;
-                            break;
-                        default:
-                            break;
-                    }
+                    case EParseState::LookingForString:
+                        Style = ERunStyle::String;
+                        break;
+                    case EParseState::LookingForLineComment:
+                    case EParseState::LookingForBlockComment:
+                        Style = ERunStyle::Comment;
+                        break;
+                    default:
+                        break;
                 }
             }
-            else
+        }
+        else
+        {
+            Style = ERunStyle::WhiteSpace;
+        }
+
+        OutLine.Spans.Add({ LineRange, Style });
+    }
+
+    // Reset line comment state at end of line
+    if (ParseState == EParseState::LookingForLineComment)
+    {
+        ParseState = EParseState::None;
+    }
+    OutLine.EndState = ParseState;
+}
+
+void FN2CRichTextSyntaxHighlighter::AddLinesToLayout(FTextLayout& TargetTextLayout) const
+{
+    TArray<FTextLayout::FNewLineData> LinesToAdd;
+    LinesToAdd.Reserve(Lines.Num());
+
+    // The layout edits its model strings and runs in place, so each refresh gets fresh ones
+    for (const FLine& Line : Lines)
+    {
+        LinesToAdd.Add(MakeLineData(Line));
+    }
+
+    TargetTextLayout.AddLines(LinesToAdd);
+}
+
+FTextLayout::FNewLineData FN2CRichTextSyntaxHighlighter::MakeLineData(const FLine& Line) const
+{
+    TSharedRef<FString> ModelString = MakeShared<FString>(Line.Text);
+    TArray<TSharedRef<IRun>> Runs;
+    Runs.Reserve(Line.Spans.Num());
+
+    for (const FRunSpan& Span : Line.Spans)
+    {
+        switch (Span.Style)
+        {
+            case ERunStyle::WhiteSpace:
+                Runs.Add(FN2CWhiteSpaceRun::Create(FRunInfo(TEXT("WhiteSpace")), ModelString, SyntaxTextStyle->NormalTextStyle, Span.Range, 4));
+                break;
+            case ERunStyle::String:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("String")), ModelString, SyntaxTextStyle->StringTextStyle, Span.Range));
+                break;
+            case ERunStyle::Comment:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Comment")), ModelString, SyntaxTextStyle->CommentTextStyle, Span.Range));
+                break;
+            case ERunStyle::Parentheses:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Parentheses")), ModelString, SyntaxTextStyle->ParenthesesTextStyle, Span.Range));
+                break;
+            case ERunStyle::CurlyBraces:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("CurlyBraces")), ModelString, SyntaxTextStyle->CurlyBracesTextStyle, Span.Range));
+                break;
+            case ERunStyle::SquareBrackets:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("SquareBrackets")), ModelString, SyntaxTextStyle->SquareBracketsTextStyle, Span.Range));
+                break;
+            case ERunStyle::Keyword:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Keyword")), ModelString, SyntaxTextStyle->KeywordTextStyle, Span.Range));
+                break;
+            case ERunStyle::Operator:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Operator")), ModelString, SyntaxTextStyle->OperatorTextStyle, Span.Range));
+                break;
+            case ERunStyle::Number:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Number")), ModelString, SyntaxTextStyle->NumberTextStyle, Span.Range));
+                break;
+            case ERunStyle::Preprocessor:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("Preprocessor")), ModelString, SyntaxTextStyle->PreprocessorTextStyle, Span.Range));
+                break;
+            default:
+                Runs.Add(FSlateTextRun::Create(FRunInfo(TEXT("N2CCodeEditor.Normal")), ModelString, SyntaxTextStyle->NormalTextStyle, Span.Range));
+                break;
+        }
+    }
+
+    return FTextLayout::FNewLineData(MoveTemp(ModelString), MoveTemp(Runs));
+}
+
+void FN2CRichTextSyntaxHighlighter::SetViewerText(const FString& SourceString)
+{
+    ViewerSource = SourceString;
+    ViewerLineRanges.Reset();
+    FTextRange::CalculateLineRangesFromString(ViewerSource, ViewerLineRanges);
+    Lines.Reset(ViewerLineRanges.Num());
+}
+
+FString FN2CRichTextSyntaxHighlighter::GetViewerLineText(int32 LineIndex) const
+{
+    return ViewerLineRanges.IsValidIndex(LineIndex) ? ViewerSource.Mid(ViewerLineRanges[LineIndex].BeginIndex, ViewerLineRanges[LineIndex].Len()) : FString();
+}
+
+void FN2CRichTextSyntaxHighlighter::LexViewerLines(int32 LastLineIndex)
+{
+    LastLineIndex = FMath::Min(LastLineIndex, ViewerLineRanges.Num() - 1);
+    for (int32 Index = Lines.Num(); Index <= LastLineIndex; ++Index)
+    {
+        LexViewerLine(Index, Lines.AddDefaulted_GetRef());
+    }
+}
+
+void FN2CRichTextSyntaxHighlighter::LexViewerLine(int32 LineIndex, FLine& OutLine) const
+{
+    const FLine* Previous = LineIndex > 0 ? &Lines[LineIndex - 1] : nullptr;
+
+    ISyntaxTokenizer::FTokenizedLine TokenizedLine;
+    SyntaxTokenizer->TokenizeLine(ViewerSource, ViewerLineRanges[LineIndex], TokenizedLine);
+    LexLine(ViewerSource, TokenizedLine, Previous ? Previous->EndState : EParseState::None, OutLine);
+
+    // Braces in strings and comments were styled as such, so only real ones count
+    int32 Depth = Previous ? Previous->EndBraceDepth : 0;
+    OutLine.BraceDepth = Depth;
+    OutLine.MinBraceDepth = Depth;
+    for (const FRunSpan& Span : OutLine.Spans)
+    {
+        if (Span.Style == ERunStyle::CurlyBraces && Span.Range.Len() == 1)
+        {
+            Depth += OutLine.Text[Span.Range.BeginIndex] == TEXT('{') ? 1 : -1;
+            OutLine.MinBraceDepth = FMath::Min(OutLine.MinBraceDepth, Depth);
+        }
+    }
+    OutLine.EndBraceDepth = Depth;
+    OutLine.bReleased = false;
+}
+
+void FN2CRichTextSyntaxHighlighter::AddViewerLineToLayout(int32 LineIndex, FTextLayout& TargetTextLayout)
+{
+    if (!ViewerLineRanges.IsValidIndex(LineIndex))
+    {
+        return;
+    }
+
+    // A line's state depends on every line above it, so lex up to it in order
+    LexViewerLines(LineIndex);
+    if (Lines[LineIndex].bReleased)
+    {
+        LexViewerLine(LineIndex, Lines[LineIndex]);
+    }
+    TargetTextLayout.AddLine(MakeLineData(Lines[LineIndex]));
+}
+
+bool FN2CRichTextSyntaxHighlighter::FoldsByIndentation() const
+{
+    const EN2CCodeLanguage Language = SyntaxDefinition->GetLanguage();
+    return Language == EN2CCodeLanguage::Python || Language == EN2CCodeLanguage::Pseudocode;
+}
+
+int32 FN2CRichTextSyntaxHighlighter::GetViewerLineIndent(int32 LineIndex) const
+{
+    const FTextRange& Range = ViewerLineRanges[LineIndex];
+    int32 Indent = 0;
+    for (int32 Index = Range.BeginIndex; Index < Range.EndIndex; ++Index)
+    {
+        const TCHAR Char = ViewerSource[Index];
+        if (Char == TEXT('\t'))
+        {
+            Indent += 4;
+        }
+        else if (FChar::IsWhitespace(Char))
+        {
+            ++Indent;
+        }
+        else
+        {
+            return Indent;
+        }
+    }
+    return INDEX_NONE;
+}
+
+bool FN2CRichTextSyntaxHighlighter::CanFoldViewerLine(int32 LineIndex) const
+{
+    if (!ViewerLineRanges.IsValidIndex(LineIndex + 1))
+    {
+        return false;
+    }
+
+    if (FoldsByIndentation())
+    {
+        const int32 Indent = GetViewerLineIndent(LineIndex);
+        if (Indent == INDEX_NONE)
+        {
+            return false;
+        }
+        for (int32 Next = LineIndex + 1; Next < ViewerLineRanges.Num(); ++Next)
+        {
+            const int32 NextIndent = GetViewerLineIndent(Next);
+            if (NextIndent != INDEX_NONE)
             {
-                RunInfo.Name = TEXT("WhiteSpace");
-                TSharedRef<ISlateRun> Run = FN2CWhiteSpaceRun::Create(RunInfo, ModelString, TextBlockStyle, ModelRange, 4);
-                Runs.Add(Run);
-                continue;
+                return NextIndent > Indent;
             }
-
-            TSharedRef<ISlateRun> Run = FSlateTextRun::Create(RunInfo, ModelString, TextBlockStyle, ModelRange);
-            Runs.Add(Run);
         }
+        return false;
+    }
+
+    // A line that closes and reopens, like "} else {", starts the region of the brace it leaves open
+    return Lines.IsValidIndex(LineIndex) && Lines[LineIndex].EndBraceDepth > Lines[LineIndex].MinBraceDepth;
+}
 
-        // Reset line comment state at end of line
-        if (ParseState == EParseState::LookingForLineComment)
+int32 FN2CRichTextSyntaxHighlighter::FindViewerFoldEnd(int32 LineIndex)
+{
+    LexViewerLines(LineIndex);
+    if (!CanFoldViewerLine(LineIndex))
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 LastLine = ViewerLineRanges.Num() - 1;
+    if (FoldsByIndentation())
+    {
+        // Trailing blank lines stay outside the region
+        const int32 Indent = GetViewerLineIndent(LineIndex);
+        int32 End = LineIndex;
+        for (int32 Next = LineIndex + 1; Next <= LastLine; ++Next)
         {
-            ParseState = EParseState::None;
+            const int32 NextIndent = GetViewerLineIndent(Next);
+            if (NextIndent != INDEX_NONE)
+            {
+                if (NextIndent <= Indent)
+                {
+                    break;
+                }
+                End = Next;
+            }
         }
+        return End;
+    }
 
-        LinesToAdd.Emplace(MoveTemp(ModelString), MoveTemp(Runs));
+    // The line closing the region stays shown, like the line opening it
+    const int32 OpenDepth = Lines[LineIndex].EndBraceDepth;
+    for (int32 Next = LineIndex + 1; Next <= LastLine; ++Next)
+    {
+        LexViewerLines(Next);
+        if (Lines[Next].MinBraceDepth < OpenDepth)
+        {
+            return Next - 1 > LineIndex ? Next - 1 : INDEX_NONE;
+        }
     }
+    return LastLine;
+}
 
-    TargetTextLayout.AddLines(LinesToAdd);
+void FN2CRichTextSyntaxHighlighter::ReleaseViewerLines(int32 FirstLineIndex, int32 LastLineIndex)
+{
+    LastLineIndex = FMath::Min(LastLineIndex, Lines.Num() - 1);
+    for (int32 Index = FMath::Max(FirstLineIndex, 0); Index <= LastLineIndex; ++Index)
+    {
+        FLine& Line = Lines[Index];
+        Line.Text.Empty();
+        Line.Spans.Empty();
+        Line.bReleased = true;
+    }
 }
 
 FN2CRichTextSyntaxHighlighter::FN2CRichTextSyntaxHighlighter(
-    TSharedPtr<ISyntaxTokenizer> InTokenizer,
-    const FSyntaxTextStyle& InSyntaxTextStyle,
-    TSharedPtr<FN2CSyntaxDefinition> InSyntaxDef)
-    : FSyntaxHighlighterTextLayoutMarshaller(MoveTemp(InTokenizer))
+    TSharedRef<FN2CSyntaxTokenizer> InTokenizer,
+    TSharedRef<const FSyntaxTextStyle> InSyntaxTextStyle,
+    TSharedPtr<const FN2CSyntaxDefinition> InSyntaxDef)
+    : FSyntaxHighlighterTextLayoutMarshaller(InTokenizer)
+    , SyntaxTokenizer(InTokenizer)
     , SyntaxTextStyle(InSyntaxTextStyle)
     , SyntaxDefinition(InSyntaxDef)
+    , AsyncLexState(MakeShared<FAsyncLexState, ESPMode::ThreadSafe>())
 {
+    AsyncLexState->Owner = this;
 }
@@ -43,6 +43,8 @@ FN2CSwiftSyntaxDefinition::FN2CSwiftSyntaxDefinition()
     LineCommentDelimiter = TEXT("//");
     BlockCommentStart = TEXT("/*");
     BlockCommentEnd = TEXT("*/");
+
+    BuildTokenLookup();
 }
 
 void FN2CSwiftSyntaxDefinition::GetCommentDelimiters(FString& OutLineComment, FString& OutBlockCommentStart, FString& OutBlockCommentEnd) const
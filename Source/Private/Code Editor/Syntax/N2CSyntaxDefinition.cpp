@@ -0,0 +1,25 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Syntax/N2CSyntaxDefinition.h"
+
+void FN2CSyntaxDefinition::BuildTokenLookup()
+{
+    TokenKinds.Reset();
+
+    // A token in several lists keeps the kind the highlighter checked first
+    auto AddTokens = [this](const TArray<FString>& Tokens, EN2CSyntaxTokenKind Kind)
+    {
+        for (const FString& Token : Tokens)
+        {
+            if (!TokenKinds.Contains(Token))
+            {
+                TokenKinds.Add(Token, Kind);
+            }
+        }
+    };
+    AddTokens(Parentheses, EN2CSyntaxTokenKind::Parenthesis);
+    AddTokens(CurlyBraces, EN2CSyntaxTokenKind::CurlyBrace);
+    AddTokens(SquareBrackets, EN2CSyntaxTokenKind::SquareBracket);
+    AddTokens(Keywords, EN2CSyntaxTokenKind::Keyword);
+    AddTokens(Operators, EN2CSyntaxTokenKind::Operator);
+}
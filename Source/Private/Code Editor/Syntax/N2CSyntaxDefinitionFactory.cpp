@@ -7,6 +7,7 @@
 #include "Code Editor/Syntax/N2CCSharpSyntaxDefinition.h"
 #include "Code Editor/Syntax/N2CSwiftSyntaxDefinition.h"
 #include "Code Editor/Syntax/N2CPseudocodeSyntaxDefinition.h"
+#include "Code Editor/Syntax/N2CSyntaxTokenizer.h"
 
 FN2CSyntaxDefinitionFactory& FN2CSyntaxDefinitionFactory::Get()
 {
@@ -14,6 +15,38 @@ FN2CSyntaxDefinitionFactory& FN2CSyntaxDefinitionFactory::Get()
     return Instance;
 }
 
+TSharedPtr<const FN2CSyntaxDefinition> FN2CSyntaxDefinitionFactory::GetDefinition(EN2CCodeLanguage Language)
+{
+    if (const TSharedPtr<const FN2CSyntaxDefinition>* Definition = Definitions.Find(Language))
+    {
+        return *Definition;
+    }
+
+    TSharedPtr<const FN2CSyntaxDefinition> Definition = CreateDefinition(Language);
+    if (Definition.IsValid())
+    {
+        Definitions.Add(Language, Definition);
+    }
+    return Definition;
+}
+
+TSharedPtr<FN2CSyntaxTokenizer> FN2CSyntaxDefinitionFactory::GetTokenizer(EN2CCodeLanguage Language)
+{
+    if (const TSharedPtr<FN2CSyntaxTokenizer>* Tokenizer = Tokenizers.Find(Language))
+    {
+        return *Tokenizer;
+    }
+
+    const TSharedPtr<const FN2CSyntaxDefinition> Definition = GetDefinition(Language);
+    if (!Definition.IsValid())
+    {
+        return nullptr;
+    }
+    TSharedPtr<FN2CSyntaxTokenizer> Tokenizer = FN2CSyntaxTokenizer::Create(*Definition);
+    Tokenizers.Add(Language, Tokenizer);
+    return Tokenizer;
+}
+
 TSharedPtr<FN2CSyntaxDefinition> FN2CSyntaxDefinitionFactory::CreateDefinition(EN2CCodeLanguage Language)
 {
     switch (Language)
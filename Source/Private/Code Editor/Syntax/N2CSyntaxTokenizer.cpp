@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Syntax/N2CSyntaxTokenizer.h"
+#include "Code Editor/Syntax/N2CSyntaxDefinition.h"
+
+namespace
+{
+    bool IsWordChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+}
+
+TSharedRef<FN2CSyntaxTokenizer> FN2CSyntaxTokenizer::Create(const FN2CSyntaxDefinition& SyntaxDefinition)
+{
+    return MakeShareable(new FN2CSyntaxTokenizer(SyntaxDefinition));
+}
+
+FN2CSyntaxTokenizer::FN2CSyntaxTokenizer(const FN2CSyntaxDefinition& SyntaxDefinition)
+{
+    // Root
+    Nodes.AddDefaulted();
+
+    for (const TArray<FString>* Symbols : { &SyntaxDefinition.GetOperators(), &SyntaxDefinition.GetParentheses(),
+        &SyntaxDefinition.GetCurlyBraces(), &SyntaxDefinition.GetSquareBrackets() })
+    {
+        for (const FString& Symbol : *Symbols)
+        {
+            AddSymbol(Symbol);
+        }
+    }
+
+    FString LineComment, BlockCommentStart, BlockCommentEnd;
+    SyntaxDefinition.GetCommentDelimiters(LineComment, BlockCommentStart, BlockCommentEnd);
+    AddSymbol(LineComment);
+    AddSymbol(BlockCommentStart);
+    AddSymbol(BlockCommentEnd);
+
+    // The highlighter opens and closes strings on single delimiter tokens
+    for (TCHAR Delimiter : SyntaxDefinition.GetStringDelimiters())
+    {
+        AddSymbol(FString::Chr(Delimiter));
+    }
+}
+
+void FN2CSyntaxTokenizer::AddSymbol(const FString& Symbol)
+{
+    if (Symbol.IsEmpty())
+    {
+        return;
+    }
+
+    int32 NodeIndex = 0;
+    for (TCHAR Char : Symbol)
+    {
+        if (static_cast<uint32>(Char) >= NumSymbolChars)
+        {
+            return;
+        }
+
+        int32 ChildIndex = Nodes[NodeIndex].Children[Char];
+        if (ChildIndex == INDEX_NONE)
+        {
+            ChildIndex = Nodes.AddDefaulted();
+            Nodes[NodeIndex].Children[Char] = ChildIndex;
+        }
+        NodeIndex = ChildIndex;
+    }
+    Nodes[NodeIndex].bIsSymbol = true;
+}
+
+int32 FN2CSyntaxTokenizer::MatchSymbol(const TCHAR* Text, int32 MaxLen) const
+{
+    int32 MatchLen = 0;
+    int32 NodeIndex = 0;
+    for (int32 Index = 0; Index < MaxLen && static_cast<uint32>(Text[Index]) < NumSymbolChars; ++Index)
+    {
+        NodeIndex = Nodes[NodeIndex].Children[Text[Index]];
+        if (NodeIndex == INDEX_NONE)
+        {
+            break;
+        }
+        if (Nodes[NodeIndex].bIsSymbol)
+        {
+            MatchLen = Index + 1;
+        }
+    }
+    return MatchLen;
+}
+
+void FN2CSyntaxTokenizer::Process(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input)
+{
+    TArray<FTextRange> LineRanges;
+    FTextRange::CalculateLineRangesFromString(Input, LineRanges);
+
+    OutTokenizedLines.Reset(LineRanges.Num());
+    for (const FTextRange& LineRange : LineRanges)
+    {
+        FTokenizedLine& TokenizedLine = OutTokenizedLines.AddDefaulted_GetRef();
+        TokenizeLine(Input, LineRange, TokenizedLine);
+    }
+}
+
+void FN2CSyntaxTokenizer::TokenizeLine(const FString& Input, const FTextRange& LineRange, FTokenizedLine& OutLine) const
+{
+    OutLine.Range = LineRange;
+
+    if (LineRange.IsEmpty())
+    {
+        OutLine.Tokens.Emplace(ETokenType::Literal, LineRange);
+        return;
+    }
+
+    const TCHAR* Text = *Input;
+    const int32 End = LineRange.EndIndex;
+    int32 Offset = LineRange.BeginIndex;
+
+    while (Offset < End)
+    {
+        const TCHAR Char = Text[Offset];
+        int32 TokenEnd = Offset + 1;
+        ETokenType TokenType = ETokenType::Literal;
+
+        if (FChar::IsWhitespace(Char))
+        {
+            while (TokenEnd < End && FChar::IsWhitespace(Text[TokenEnd]))
+            {
+                ++TokenEnd;
+            }
+        }
+        else if (FChar::IsDigit(Char))
+        {
+            // Keep decimal points and suffixes so "1.5f" and "0xFF" reach the highlighter whole
+            while (TokenEnd < End && (IsWordChar(Text[TokenEnd]) || Text[TokenEnd] == TEXT('.')))
+            {
+                ++TokenEnd;
+            }
+        }
+        else if (IsWordChar(Char))
+        {
+            while (TokenEnd < End && IsWordChar(Text[TokenEnd]))
+            {
+                ++TokenEnd;
+            }
+        }
+        else if (Char == TEXT('\\'))
+        {
+            TokenEnd = FMath::Min(Offset + 2, End);
+        }
+        else if (const int32 SymbolLen = MatchSymbol(Text + Offset, End - Offset))
+        {
+            TokenEnd = Offset + SymbolLen;
+            TokenType = ETokenType::Syntax;
+        }
+
+        OutLine.Tokens.Emplace(TokenType, FTextRange(Offset, TokenEnd));
+        Offset = TokenEnd;
+    }
+}
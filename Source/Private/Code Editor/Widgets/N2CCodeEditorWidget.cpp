@@ -9,6 +9,8 @@
 UN2CCodeEditorWidget::UN2CCodeEditorWidget()
     : Language(EN2CCodeLanguage::Cpp)
     , FontSize(9)
+    , ViewerLineThreshold(5000)
+    , MaxCachedDocuments(8)
     , bWordWrap(false)
     , TabSize(4)
 {
@@ -19,14 +21,17 @@ TSharedRef<SWidget> UN2CCodeEditorWidget::RebuildWidget()
     CodeEditorWidget = SNew(SN2CCodeEditor)
         .Text(Text)
         .Language(Language)
-        .ThemeName(ThemeName);
+        .ThemeName(ThemeName)
+        .ViewerLineThreshold(ViewerLineThreshold);
         
     // Apply initial properties
     if (CodeEditorWidget.IsValid())
     {
         CodeEditorWidget->SetFontSize(FontSize);
+        CodeEditorWidget->SetMaxCachedDocuments(MaxCachedDocuments);
         CodeEditorWidget->SetWordWrap(bWordWrap);
         CodeEditorWidget->SetTabSize(TabSize);
+        CodeEditorWidget->SetOnTextChanged(FSimpleDelegate::CreateUObject(this, &UN2CCodeEditorWidget::HandleTextChanged));
     }
 
     return CodeEditorWidget.ToSharedRef();
@@ -38,6 +43,8 @@ void UN2CCodeEditorWidget::SynchronizeProperties()
 
     if (CodeEditorWidget.IsValid())
     {
+        CodeEditorWidget->SetViewerLineThreshold(ViewerLineThreshold);
+        CodeEditorWidget->SetMaxCachedDocuments(MaxCachedDocuments);
         CodeEditorWidget->SetText(Text);
         CodeEditorWidget->SetLanguage(Language);
     }
@@ -61,6 +68,70 @@ void UN2CCodeEditorWidget::SetText(const FText& NewText)
     }
 }
 
+void UN2CCodeEditorWidget::SetDocument(FName DocumentKey, const FText& NewText)
+{
+    Text = NewText;
+    if (CodeEditorWidget.IsValid())
+    {
+        CodeEditorWidget->SetDocument(DocumentKey, NewText);
+    }
+}
+
+const FString& UN2CCodeEditorWidget::GetCodeRef() const
+{
+    if (CodeEditorWidget.IsValid())
+    {
+        return CodeEditorWidget->GetString();
+    }
+    return Text.ToString();
+}
+
+void UN2CCodeEditorWidget::SetCode(const FString& NewCode)
+{
+    if (GetCodeRef().Equals(NewCode, ESearchCase::CaseSensitive))
+    {
+        return;
+    }
+    SetText(FText::FromString(NewCode));
+}
+
+void UN2CCodeEditorWidget::SetDocumentCode(FName DocumentKey, const FString& NewCode)
+{
+    SetDocument(DocumentKey, FText::FromString(NewCode));
+}
+
+void UN2CCodeEditorWidget::ShowCodeDiff(const FString& OldCode, const FString& NewCode)
+{
+    Text = FText::FromString(NewCode);
+    if (CodeEditorWidget.IsValid())
+    {
+        CodeEditorWidget->SetDiff(OldCode, NewCode);
+    }
+}
+
+void UN2CCodeEditorWidget::ShowDiff(const FText& OldText, const FText& NewText)
+{
+    Text = NewText;
+    if (CodeEditorWidget.IsValid())
+    {
+        CodeEditorWidget->SetDiff(OldText, NewText);
+    }
+}
+
+void UN2CCodeEditorWidget::ClearDiff()
+{
+    if (CodeEditorWidget.IsValid())
+    {
+        CodeEditorWidget->ClearDiff();
+        Text = CodeEditorWidget->GetText();
+    }
+}
+
+bool UN2CCodeEditorWidget::ScrollToNextChange()
+{
+    return CodeEditorWidget.IsValid() && CodeEditorWidget->ScrollToNextChange();
+}
+
 void UN2CCodeEditorWidget::SetLanguage(EN2CCodeLanguage NewLanguage)
 {
     Language = NewLanguage;
@@ -70,10 +141,11 @@ void UN2CCodeEditorWidget::SetLanguage(EN2CCodeLanguage NewLanguage)
     }
 }
 
-void UN2CCodeEditorWidget::HandleTextChanged(const FText& NewText)
+void UN2CCodeEditorWidget::HandleTextChanged()
 {
-    Text = NewText;
-    OnTextChanged.Broadcast(NewText);
+    // Shares the editor's text, so only listeners that keep it copy it
+    Text = CodeEditorWidget->GetText();
+    OnTextChanged.Broadcast(Text);
 }
 
 void UN2CCodeEditorWidget::InsertTextAtCursor(const FString& InText)
@@ -1,17 +1,24 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "Code Editor/Widgets/SN2CCodeEditor.h"
+#include "Code Editor/Widgets/SN2CCodeViewer.h"
+#include "Code Editor/Widgets/SN2CDiffViewer.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
 #include "Widgets/Text/SMultiLineEditableText.h"
 #include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
 #include "Code Editor/Models/N2CCodeEditorStyle.h"
+#include "Utils/N2CStats.h"
 
 void SN2CCodeEditor::Construct(const FArguments& InArgs)
 {
+    LLM_SCOPE_BYTAG(NodeToCode_CodeEditor);
+
     CurrentLanguage = InArgs._Language;
     CurrentTheme = InArgs._ThemeName.IsNone() ? FName(TEXT("Midnight Code")) : InArgs._ThemeName;
     TabSize = 4; // Default tab size
     FontSize = 9; // Default font size
-    CreateSyntaxHighlighter(CurrentLanguage);
+    ViewerLineThreshold = InArgs._ViewerLineThreshold;
 
     // Create scrollbars
     HorizontalScrollBar = SNew(SScrollBar)
@@ -24,13 +31,30 @@ void SN2CCodeEditor::Construct(const FArguments& InArgs)
         .Padding(2)
         .Thickness(FVector2D(6.0f, 6.0f));
 
+    SAssignNew(Viewer, SN2CCodeViewer)
+        .VScrollBar(VerticalScrollBar)
+        .HScrollBar(HorizontalScrollBar);
+    SAssignNew(DiffViewer, SN2CDiffViewer)
+        .VScrollBar(VerticalScrollBar)
+        .HScrollBar(HorizontalScrollBar);
+    CreateSyntaxHighlighter(CurrentLanguage);
+
+    // Very large texts skip the editable text's full layout
+    const FText InitialText = InArgs._Text.Get();
+    bViewerMode = ShouldUseViewer(InitialText.ToString());
+    if (bViewerMode)
+    {
+        Viewer->SetText(InitialText.ToString());
+    }
+    ShownText = bViewerMode ? FText::GetEmpty() : InitialText;
+
     // Initialize the text style
     TextStyle = FN2CCodeEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText");
     TextStyle.SetFont(FCoreStyle::GetDefaultFontStyle("Mono", FontSize));
     
     // Create the main text widget first so we can reference its font size
     TSharedRef<SMultiLineEditableText> TextWidget = SAssignNew(EditableText, SMultiLineEditableText)
-        .Text(InArgs._Text)
+        .Text(ShownText)
         .TextStyle(&TextStyle)
         .Marshaller(SyntaxHighlighter)
         .AutoWrapText(false)
@@ -39,13 +63,12 @@ void SN2CCodeEditor::Construct(const FArguments& InArgs)
         .HScrollBar(HorizontalScrollBar)
         .VScrollBar(VerticalScrollBar);
 
+    BackgroundBrush = FindBackgroundBrush();
+
     ChildSlot
     [
         SNew(SBorder)
-        .BorderImage(FN2CCodeEditorStyle::Get().GetBrush(
-            *FString::Printf(TEXT("N2CCodeEditor.%s.%s.Background"), 
-                *FN2CCodeEditorStyle::GetLanguageString(CurrentLanguage),
-                *CurrentTheme.ToString())))
+        .BorderImage_Lambda([this]() { return BackgroundBrush; })
         [
             SNew(SHorizontalBox)
 
@@ -53,7 +76,7 @@ void SN2CCodeEditor::Construct(const FArguments& InArgs)
             + SHorizontalBox::Slot()
             .FillWidth(1.0f)
             [
-                TextWidget
+                MakeTextArea(TextWidget)
             ]
 
             // Vertical scrollbar
@@ -87,71 +110,161 @@ void SN2CCodeEditor::Construct(const FArguments& InArgs)
 
 FText SN2CCodeEditor::GetText() const
 {
-    return EditableText.IsValid() ? EditableText->GetText() : FText::GetEmpty();
+    if (bDiffMode)
+    {
+        return FText::FromString(DiffViewer->GetNewText());
+    }
+    if (bViewerMode)
+    {
+        return FText::FromString(Viewer->GetText());
+    }
+    return ShownText;
+}
+
+const FString& SN2CCodeEditor::GetString() const
+{
+    if (bDiffMode)
+    {
+        return DiffViewer->GetNewText();
+    }
+    if (bViewerMode)
+    {
+        return Viewer->GetText();
+    }
+    return ShownText.ToString();
 }
 
 void SN2CCodeEditor::SetText(const FText& NewText)
 {
-    if (EditableText.IsValid())
+    ShowText(NewText);
+}
+
+void SN2CCodeEditor::SetString(FString NewText)
+{
+    // Already shown, so the text is not copied into an FText only to be dropped
+    if (GetString().Equals(NewText, ESearchCase::CaseSensitive))
     {
-        EditableText->SetText(NewText);
+        return;
     }
+    ShowText(FText::FromString(MoveTemp(NewText)));
 }
 
-void SN2CCodeEditor::SetLanguage(EN2CCodeLanguage NewLanguage)
+void SN2CCodeEditor::ShowText(const FText& NewText)
 {
-    // Store current text
-    FText CurrentText;
+    // Setting the shown text again would lay it all out again
+    const FString& NewString = NewText.ToString();
+    if (GetString().Equals(NewString, ESearchCase::CaseSensitive))
+    {
+        return;
+    }
+    LLM_SCOPE_BYTAG(NodeToCode_CodeEditor);
+    ClearDiff();
+
+    bViewerMode = ShouldUseViewer(NewString);
+    Viewer->SetText(bViewerMode ? NewString : FString());
+
+    ShownText = bViewerMode ? FText::GetEmpty() : NewText;
     if (EditableText.IsValid())
     {
-        CurrentText = EditableText->GetText();
+        EditableText->SetText(ShownText);
     }
+}
 
-    // Create new syntax highlighter
-    CreateSyntaxHighlighter(NewLanguage);
+void SN2CCodeEditor::SetDiff(const FText& OldText, const FText& NewText)
+{
+    SetDiff(OldText.ToString(), NewText.ToString());
+}
 
-    // Recreate the editable text widget with the new highlighter
-    ChildSlot
-    [
-        SNew(SBorder)
-        .BorderImage(FN2CCodeEditorStyle::Get().GetBrush(
-            *FString::Printf(TEXT("N2CCodeEditor.%s.%s.Background"), 
-                *FN2CCodeEditorStyle::GetLanguageString(NewLanguage),
-                *CurrentTheme.ToString())))
-        [
-            SNew(SGridPanel)
-            .FillColumn(0, 1.0f)
-            .FillRow(0, 1.0f)
+void SN2CCodeEditor::SetDiff(const FString& OldText, const FString& NewText)
+{
+    bDiffMode = true;
+    DiffViewer->SetTexts(OldText, NewText);
+}
 
-            // Main text area
-            +SGridPanel::Slot(0, 0)
-            [
-                SAssignNew(EditableText, SMultiLineEditableText)
-                .Text(CurrentText)
-                .TextStyle(&FN2CCodeEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText"))
-                .Marshaller(SyntaxHighlighter)
-                .AutoWrapText(false)
-                .OnTextChanged(this, &SN2CCodeEditor::OnTextChanged)
-                .AllowMultiLine(true)
-                .HScrollBar(HorizontalScrollBar)
-                .VScrollBar(VerticalScrollBar)
-            ]
+void SN2CCodeEditor::ClearDiff()
+{
+    if (bDiffMode)
+    {
+        bDiffMode = false;
+        DiffViewer->SetTexts(FString(), FString());
+    }
+}
 
-            // Vertical scrollbar
-            +SGridPanel::Slot(1, 0)
-            .Padding(0)
-            [
-                VerticalScrollBar.ToSharedRef()
-            ]
+bool SN2CCodeEditor::ScrollToNextChange()
+{
+    return bDiffMode && DiffViewer->ScrollToNextChange();
+}
 
-            // Horizontal scrollbar
-            +SGridPanel::Slot(0, 1)
-            .Padding(0)
+void SN2CCodeEditor::SetViewerLineThreshold(int32 NewThreshold)
+{
+    if (ViewerLineThreshold != NewThreshold)
+    {
+        // The text moves between the viewer and the editor, so the shown one is emptied first
+        FString CurrentText = GetString();
+        ViewerLineThreshold = NewThreshold;
+        ClearDiff();
+        bViewerMode = ShouldUseViewer(CurrentText);
+        ShownText = bViewerMode ? FText::GetEmpty() : FText::FromString(CurrentText);
+        Viewer->SetText(bViewerMode ? CurrentText : FString());
+        if (EditableText.IsValid())
+        {
+            EditableText->SetText(ShownText);
+        }
+    }
+}
+
+bool SN2CCodeEditor::ShouldUseViewer(const FString& InText) const
+{
+    if (ViewerLineThreshold <= 0)
+    {
+        return false;
+    }
+
+    int32 NumLines = 1;
+    for (const TCHAR Char : InText)
+    {
+        if (Char == TEXT('\n') && ++NumLines > ViewerLineThreshold)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TSharedRef<SWidget> SN2CCodeEditor::MakeTextArea(const TSharedRef<SWidget>& EditorWidget)
+{
+    // Cached documents were laid out with the style the new text area replaces
+    Documents.Reset();
+
+    return SNew(SWidgetSwitcher)
+        .WidgetIndex_Lambda([this]() { return bDiffMode ? 2 : (bViewerMode ? 1 : 0); })
+        + SWidgetSwitcher::Slot()
+        [
+            SAssignNew(EditorBox, SBox)
             [
-                HorizontalScrollBar.ToSharedRef()
+                EditorWidget
             ]
         ]
-    ];
+        + SWidgetSwitcher::Slot()
+        [
+            Viewer.ToSharedRef()
+        ]
+        + SWidgetSwitcher::Slot()
+        [
+            DiffViewer.ToSharedRef()
+        ];
+}
+
+void SN2CCodeEditor::SetLanguage(EN2CCodeLanguage NewLanguage)
+{
+    if (CurrentLanguage == NewLanguage)
+    {
+        return;
+    }
+    CurrentLanguage = NewLanguage;
+
+    // Swap the highlighting in place; the text widget keeps its text and only refreshes its runs
+    UpdateSyntaxHighlighter();
 }
 
 void SN2CCodeEditor::CreateSyntaxHighlighter(EN2CCodeLanguage Language)
@@ -161,6 +274,7 @@ void SN2CCodeEditor::CreateSyntaxHighlighter(EN2CCodeLanguage Language)
     BaseStyle.SetFont(FCoreStyle::GetDefaultFontStyle("Mono", FontSize));
     
     SyntaxHighlighter = FN2CRichTextSyntaxHighlighter::Create(Language, CurrentTheme, BaseStyle);
+    UpdateViewerHighlighters(BaseStyle);
 }
 
 void SN2CCodeEditor::SetTheme(const FName& NewTheme)
@@ -170,22 +284,146 @@ void SN2CCodeEditor::SetTheme(const FName& NewTheme)
         CurrentTheme = NewTheme;
         
         // Update the syntax highlighter with new theme
-        CreateSyntaxHighlighter(CurrentLanguage);
-        
-        // Force a redraw
-        if (EditableText.IsValid())
+        UpdateSyntaxHighlighter();
+    }
+}
+
+void SN2CCodeEditor::SetDocument(FName DocumentKey, const FText& NewText)
+{
+    ShowDocument(DocumentKey, NewText);
+}
+
+void SN2CCodeEditor::SetDocumentString(FName DocumentKey, FString NewText)
+{
+    ShowDocument(DocumentKey, FText::FromString(MoveTemp(NewText)));
+}
+
+void SN2CCodeEditor::ShowDocument(FName DocumentKey, const FText& NewText)
+{
+    ClearDiff();
+
+    if (DocumentKey.IsNone() || !EditorBox.IsValid())
+    {
+        ShowText(NewText);
+        return;
+    }
+
+    // Edits to the document shown so far stay with it
+    if (Documents.Num() > 0 && Documents.Last().EditableText == EditableText)
+    {
+        Documents.Last().Text = ShownText;
+    }
+
+    // Very large texts go to the viewer, which lays out only visible lines anyway
+    const FString& NewString = NewText.ToString();
+    if (ShouldUseViewer(NewString))
+    {
+        bViewerMode = true;
+        Viewer->SetText(NewString);
+        return;
+    }
+    bViewerMode = false;
+    Viewer->SetText(FString());
+
+    const int32 Index = Documents.IndexOfByPredicate([DocumentKey](const FDocument& Document) { return Document.Key == DocumentKey; });
+    if (Index != INDEX_NONE)
+    {
+        // Most recently shown goes last
+        FDocument Document = Documents[Index];
+        Documents.RemoveAt(Index);
+
+        Document.Highlighter->SetLanguage(CurrentLanguage, CurrentTheme, MakeBaseStyle());
+        if (!Document.Text.ToString().Equals(NewString, ESearchCase::CaseSensitive))
+        {
+            Document.Text = NewText;
+            Document.EditableText->SetText(NewText);
+        }
+        Documents.Add(MoveTemp(Document));
+    }
+    else
+    {
+        const TSharedRef<FN2CRichTextSyntaxHighlighter> Highlighter = FN2CRichTextSyntaxHighlighter::Create(CurrentLanguage, CurrentTheme, MakeBaseStyle());
+        Documents.Add({ DocumentKey, MakeEditableText(NewText, Highlighter), Highlighter, NewText });
+        if (Documents.Num() > MaxCachedDocuments)
         {
-            EditableText->Invalidate(EInvalidateWidget::Layout);
+            Documents.RemoveAt(0, Documents.Num() - MaxCachedDocuments);
         }
     }
+
+    const FDocument& Shown = Documents.Last();
+    EditableText = Shown.EditableText;
+    SyntaxHighlighter = Shown.Highlighter;
+    ShownText = Shown.Text;
+    EditorBox->SetContent(Shown.EditableText);
+}
+
+void SN2CCodeEditor::SetMaxCachedDocuments(int32 NewMax)
+{
+    MaxCachedDocuments = FMath::Max(NewMax, 1);
+    if (Documents.Num() > MaxCachedDocuments)
+    {
+        Documents.RemoveAt(0, Documents.Num() - MaxCachedDocuments);
+    }
 }
 
-void SN2CCodeEditor::OnTextChanged(const FText& NewText)
+FTextBlockStyle SN2CCodeEditor::MakeBaseStyle() const
+{
+    FTextBlockStyle BaseStyle = FN2CCodeEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText");
+    BaseStyle.SetFont(FCoreStyle::GetDefaultFontStyle("Mono", FontSize));
+    return BaseStyle;
+}
+
+TSharedRef<SMultiLineEditableText> SN2CCodeEditor::MakeEditableText(const FText& InText, const TSharedRef<FN2CRichTextSyntaxHighlighter>& Highlighter)
+{
+    return SNew(SMultiLineEditableText)
+        .Text(InText)
+        .TextStyle(&TextStyle)
+        .Marshaller(Highlighter)
+        .AutoWrapText(false)
+        .OnTextChanged(this, &SN2CCodeEditor::OnTextChanged)
+        .AllowMultiLine(true)
+        .HScrollBar(HorizontalScrollBar)
+        .VScrollBar(VerticalScrollBar);
+}
+
+void SN2CCodeEditor::UpdateSyntaxHighlighter()
+{
+    const FTextBlockStyle BaseStyle = MakeBaseStyle();
+
+    if (SyntaxHighlighter.IsValid())
+    {
+        SyntaxHighlighter->SetLanguage(CurrentLanguage, CurrentTheme, BaseStyle);
+    }
+    UpdateViewerHighlighters(BaseStyle);
+
+    BackgroundBrush = FindBackgroundBrush();
+}
+
+void SN2CCodeEditor::UpdateViewerHighlighters(const FTextBlockStyle& BaseStyle)
 {
-    if (OnTextChangedHandler.IsBound())
+    if (Viewer.IsValid())
     {
-        OnTextChangedHandler.Execute(NewText);
+        Viewer->SetHighlighter(FN2CRichTextSyntaxHighlighter::Create(CurrentLanguage, CurrentTheme, BaseStyle));
     }
+    if (DiffViewer.IsValid())
+    {
+        DiffViewer->SetHighlighters(
+            FN2CRichTextSyntaxHighlighter::Create(CurrentLanguage, CurrentTheme, BaseStyle),
+            FN2CRichTextSyntaxHighlighter::Create(CurrentLanguage, CurrentTheme, BaseStyle));
+    }
+}
+
+const FSlateBrush* SN2CCodeEditor::FindBackgroundBrush() const
+{
+    return FN2CCodeEditorStyle::GetLanguageBackground(
+        *FN2CCodeEditorStyle::GetLanguageString(CurrentLanguage), CurrentTheme);
+}
+
+void SN2CCodeEditor::OnTextChanged(const FText& NewText)
+{
+    // Cached documents are hidden, so only the shown one is edited
+    ShownText = NewText;
+    OnTextChangedHandler.ExecuteIfBound();
 }
 
 void SN2CCodeEditor::InsertTextAtCursor(const FString& InText)
@@ -223,7 +461,11 @@ FText SN2CCodeEditor::GetSelectedText() const
 
 void SN2CCodeEditor::SetCursorPosition(int32 Line, int32 Column)
 {
-    if (EditableText.IsValid())
+    if (bViewerMode)
+    {
+        Viewer->ScrollToLine(Line);
+    }
+    else if (EditableText.IsValid())
     {
         EditableText->GoTo(FTextLocation(Line, Column));
         EditableText->ScrollTo(FTextLocation(Line, Column));
@@ -282,7 +524,7 @@ void SN2CCodeEditor::SetFontSize(int32 NewSize)
     if (EditableText.IsValid())
     {
         // Store current text and cursor position
-        FText CurrentText = EditableText->GetText();
+        const FText CurrentText = ShownText;
         FTextLocation CursorLocation = EditableText->GetCursorLocation();
         
         // Update the text style with new font size
@@ -290,6 +532,7 @@ void SN2CCodeEditor::SetFontSize(int32 NewSize)
         
         // Recreate syntax highlighter with updated style
         SyntaxHighlighter = FN2CRichTextSyntaxHighlighter::Create(CurrentLanguage, CurrentTheme, TextStyle);
+        UpdateViewerHighlighters(TextStyle);
         
         // Create new text widget with updated style
         TSharedRef<SMultiLineEditableText> NewTextWidget = SNew(SMultiLineEditableText)
@@ -313,10 +556,7 @@ void SN2CCodeEditor::SetFontSize(int32 NewSize)
         ChildSlot
         [
             SNew(SBorder)
-            .BorderImage(FN2CCodeEditorStyle::Get().GetBrush(
-                *FString::Printf(TEXT("N2CCodeEditor.%s.%s.Background"), 
-                    *FN2CCodeEditorStyle::GetLanguageString(CurrentLanguage),
-                    *CurrentTheme.ToString())))
+            .BorderImage_Lambda([this]() { return BackgroundBrush; })
             [
                 SNew(SGridPanel)
                 .FillColumn(0, 1.0f)
@@ -325,7 +565,7 @@ void SN2CCodeEditor::SetFontSize(int32 NewSize)
                 // Main text area
                 +SGridPanel::Slot(0, 0)
                 [
-                    NewTextWidget
+                    MakeTextArea(NewTextWidget)
                 ]
 
                 // Vertical scrollbar
@@ -360,11 +600,7 @@ void SN2CCodeEditor::SetTabSize(int32 NewSize)
     TabSize = NewSize;
 
     // Store current text
-    FText CurrentText;
-    if (EditableText.IsValid())
-    {
-        CurrentText = EditableText->GetText();
-    }
+    const FText CurrentText = ShownText;
 
     // Create new syntax highlighter
     CreateSyntaxHighlighter(CurrentLanguage);
@@ -373,10 +609,7 @@ void SN2CCodeEditor::SetTabSize(int32 NewSize)
     ChildSlot
     [
         SNew(SBorder)
-        .BorderImage(FN2CCodeEditorStyle::Get().GetBrush(
-            *FString::Printf(TEXT("N2CCodeEditor.%s.%s.Background"), 
-                *FN2CCodeEditorStyle::GetLanguageString(CurrentLanguage),
-                *CurrentTheme.ToString())))
+        .BorderImage_Lambda([this]() { return BackgroundBrush; })
         [
             SNew(SGridPanel)
             .FillColumn(0, 1.0f)
@@ -385,15 +618,15 @@ void SN2CCodeEditor::SetTabSize(int32 NewSize)
             // Main text area
             +SGridPanel::Slot(0, 0)
             [
-                SAssignNew(EditableText, SMultiLineEditableText)
-                .Text(CurrentText)
-                .TextStyle(&FN2CCodeEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText"))
-                .Marshaller(SyntaxHighlighter)
-                .AutoWrapText(false)
-                .OnTextChanged(this, &SN2CCodeEditor::OnTextChanged)
-                .AllowMultiLine(true)
-                .HScrollBar(HorizontalScrollBar)
-                .VScrollBar(VerticalScrollBar)
+                MakeTextArea(SAssignNew(EditableText, SMultiLineEditableText)
+                    .Text(CurrentText)
+                    .TextStyle(&FN2CCodeEditorStyle::Get().GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText"))
+                    .Marshaller(SyntaxHighlighter)
+                    .AutoWrapText(false)
+                    .OnTextChanged(this, &SN2CCodeEditor::OnTextChanged)
+                    .AllowMultiLine(true)
+                    .HScrollBar(HorizontalScrollBar)
+                    .VScrollBar(VerticalScrollBar))
             ]
 
             // Vertical scrollbar
@@ -0,0 +1,217 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Widgets/SN2CCodeViewer.h"
+#include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
+#include "Framework/Text/SlateTextLayout.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+namespace
+{
+    /** Width of the fold markers left of the lines */
+    constexpr float FoldGutterWidth = 14.0f;
+}
+
+void SN2CCodeViewerLine::Construct(const FArguments& InArgs, const TSharedRef<FN2CRichTextSyntaxHighlighter>& Highlighter)
+{
+    TextLayout = FSlateTextLayout::Create(this, Highlighter->GetSyntaxTextStyle().NormalTextStyle);
+    Highlighter->AddViewerLineToLayout(InArgs._LineIndex, *TextLayout);
+}
+
+int32 SN2CCodeViewerLine::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    TextLayout->SetScale(AllottedGeometry.Scale);
+    TextLayout->SetVisibleRegion(AllottedGeometry.GetLocalSize(), FVector2D::ZeroVector);
+    TextLayout->UpdateIfNeeded();
+    return TextLayout->OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, ShouldBeEnabled(bParentEnabled));
+}
+
+FVector2D SN2CCodeViewerLine::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    TextLayout->SetScale(LayoutScaleMultiplier);
+    TextLayout->UpdateIfNeeded();
+    return TextLayout->GetSize();
+}
+
+void SN2CCodeViewer::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+    [
+        SNew(SScrollBox)
+        .Orientation(Orient_Horizontal)
+        .ExternalScrollbar(InArgs._HScrollBar)
+        + SScrollBox::Slot()
+        [
+            SAssignNew(ListView, SListView<TSharedPtr<int32>>)
+            .ListItemsSource(&LineItems)
+            .OnGenerateRow(this, &SN2CCodeViewer::GenerateLineRow)
+            .SelectionMode(ESelectionMode::None)
+            .ExternalScrollbar(InArgs._VScrollBar)
+        ]
+    ];
+}
+
+void SN2CCodeViewer::SetText(const FString& NewText)
+{
+    Text = NewText;
+    RefreshLines();
+}
+
+void SN2CCodeViewer::SetHighlighter(const TSharedRef<FN2CRichTextSyntaxHighlighter>& InHighlighter)
+{
+    Highlighter = InHighlighter;
+    RefreshLines();
+}
+
+void SN2CCodeViewer::ScrollToLine(int32 LineIndex)
+{
+    if (!ListView.IsValid() || !AllLineItems.IsValidIndex(LineIndex))
+    {
+        return;
+    }
+
+    const int32 NumFolded = FoldedRegions.Num();
+    for (auto It = FoldedRegions.CreateIterator(); It; ++It)
+    {
+        if (It.Key() < LineIndex && LineIndex <= It.Value())
+        {
+            It.RemoveCurrent();
+        }
+    }
+    if (FoldedRegions.Num() != NumFolded)
+    {
+        RefreshVisibleLines();
+    }
+    ListView->RequestScrollIntoView(AllLineItems[LineIndex]);
+}
+
+bool SN2CCodeViewer::ToggleFold(int32 LineIndex)
+{
+    if (!Highlighter.IsValid())
+    {
+        return false;
+    }
+
+    if (FoldedRegions.Remove(LineIndex) == 0)
+    {
+        const int32 FoldEnd = Highlighter->FindViewerFoldEnd(LineIndex);
+        if (FoldEnd == INDEX_NONE)
+        {
+            return false;
+        }
+        FoldedRegions.Add(LineIndex, FoldEnd);
+        Highlighter->ReleaseViewerLines(LineIndex + 1, FoldEnd);
+    }
+    RefreshVisibleLines();
+    return true;
+}
+
+void SN2CCodeViewer::UnfoldAll()
+{
+    if (FoldedRegions.Num() > 0)
+    {
+        FoldedRegions.Reset();
+        RefreshVisibleLines();
+    }
+}
+
+void SN2CCodeViewer::RefreshLines()
+{
+    AllLineItems.Reset();
+    FoldedRegions.Reset();
+
+    if (Highlighter.IsValid())
+    {
+        Highlighter->SetViewerText(Text);
+
+        const int32 NumLines = Text.IsEmpty() ? 0 : Highlighter->GetNumViewerLines();
+        AllLineItems.Reserve(NumLines);
+        for (int32 LineIndex = 0; LineIndex < NumLines; ++LineIndex)
+        {
+            AllLineItems.Add(MakeShared<int32>(LineIndex));
+        }
+    }
+
+    RefreshVisibleLines();
+}
+
+void SN2CCodeViewer::RefreshVisibleLines()
+{
+    if (FoldedRegions.Num() == 0)
+    {
+        LineItems = AllLineItems;
+    }
+    else
+    {
+        // Folds inside a folded region are skipped along with it
+        LineItems.Reset(AllLineItems.Num());
+        for (int32 LineIndex = 0; LineIndex < AllLineItems.Num(); ++LineIndex)
+        {
+            LineItems.Add(AllLineItems[LineIndex]);
+            if (const int32* FoldEnd = FoldedRegions.Find(LineIndex))
+            {
+                LineIndex = *FoldEnd;
+            }
+        }
+    }
+
+    if (ListView.IsValid())
+    {
+        ListView->RebuildList();
+    }
+}
+
+TSharedRef<ITableRow> SN2CCodeViewer::GenerateLineRow(TSharedPtr<int32> LineIndex, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    check(Highlighter.IsValid());
+
+    // Lex a little past the shown line so the next rows to scroll in are ready
+    Highlighter->LexViewerLines(*LineIndex + OverscanLines);
+
+    const int32 Line = *LineIndex;
+    const bool bCanFold = FoldedRegions.Contains(Line) || Highlighter->CanFoldViewerLine(Line);
+    TSharedRef<SWidget> FoldMarker = SNullWidget::NullWidget;
+    if (bCanFold)
+    {
+        FoldMarker = SNew(SButton)
+            .ButtonStyle(FCoreStyle::Get(), "NoBorder")
+            .ContentPadding(0.0f)
+            .OnClicked_Lambda([this, Line]()
+            {
+                ToggleFold(Line);
+                return FReply::Handled();
+            })
+            [
+                SNew(STextBlock)
+                .Font(Highlighter->GetSyntaxTextStyle().NormalTextStyle.Font)
+                .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+                .Text_Lambda([this, Line]() { return FText::FromString(FoldedRegions.Contains(Line) ? TEXT("+") : TEXT("-")); })
+            ];
+    }
+
+    return SNew(STableRow<TSharedPtr<int32>>, OwnerTable)
+        .ShowSelection(false)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SBox)
+                .WidthOverride(FoldGutterWidth)
+                [
+                    FoldMarker
+                ]
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SN2CCodeViewerLine, Highlighter.ToSharedRef())
+                .LineIndex(Line)
+            ]
+        ];
+}
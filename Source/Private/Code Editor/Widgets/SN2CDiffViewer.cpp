@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Code Editor/Widgets/SN2CDiffViewer.h"
+#include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
+#include "Code Editor/Widgets/SN2CCodeViewer.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/Layout/SSpacer.h"
+#include "Widgets/SBoxPanel.h"
+
+namespace
+{
+    const FLinearColor RemovedLineColor(0.45f, 0.08f, 0.08f, 0.45f);
+    const FLinearColor AddedLineColor(0.08f, 0.4f, 0.12f, 0.45f);
+    const FLinearColor MissingLineColor(0.0f, 0.0f, 0.0f, 0.25f);
+}
+
+void SN2CDiffViewer::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+    [
+        SNew(SScrollBox)
+        .Orientation(Orient_Horizontal)
+        .ExternalScrollbar(InArgs._HScrollBar)
+        + SScrollBox::Slot()
+        [
+            SAssignNew(ListView, SListView<TSharedPtr<FDiffRow>>)
+            .ListItemsSource(&Rows)
+            .OnGenerateRow(this, &SN2CDiffViewer::GenerateRow)
+            .SelectionMode(ESelectionMode::None)
+            .ExternalScrollbar(InArgs._VScrollBar)
+        ]
+    ];
+}
+
+void SN2CDiffViewer::SetTexts(const FString& InOldText, const FString& InNewText)
+{
+    OldText = InOldText;
+    NewText = InNewText;
+    RefreshRows();
+}
+
+void SN2CDiffViewer::SetHighlighters(const TSharedRef<FN2CRichTextSyntaxHighlighter>& InOldHighlighter, const TSharedRef<FN2CRichTextSyntaxHighlighter>& InNewHighlighter)
+{
+    OldHighlighter = InOldHighlighter;
+    NewHighlighter = InNewHighlighter;
+    RefreshRows();
+}
+
+bool SN2CDiffViewer::ScrollToNextChange()
+{
+    if (!ListView.IsValid() || Rows.Num() == 0)
+    {
+        return false;
+    }
+
+    // Skip the rest of a change already at the top of the view
+    const int32 NumRows = Rows.Num();
+    int32 Start = FMath::Clamp(FMath::FloorToInt(ListView->GetScrollOffset()), 0, NumRows - 1);
+    while (Start < NumRows && Rows[Start]->bChanged)
+    {
+        ++Start;
+    }
+
+    for (int32 Step = 0; Step < NumRows; ++Step)
+    {
+        const int32 RowIndex = (Start + Step) % NumRows;
+        if (Rows[RowIndex]->bChanged)
+        {
+            ListView->SetScrollOffset(RowIndex);
+            return true;
+        }
+    }
+    return false;
+}
+
+void SN2CDiffViewer::RefreshRows()
+{
+    Rows.Reset();
+
+    if (OldHighlighter.IsValid() && NewHighlighter.IsValid())
+    {
+        OldHighlighter->SetViewerText(OldText);
+        NewHighlighter->SetViewerText(NewText);
+
+        const TArray<FN2CDiffRun> Runs = FN2CLineDiff::Diff(OldText, NewText);
+        for (int32 RunIndex = 0; RunIndex < Runs.Num(); ++RunIndex)
+        {
+            const FN2CDiffRun& Run = Runs[RunIndex];
+            if (Run.Op == EN2CDiffOp::Equal)
+            {
+                for (int32 Offset = 0; Offset < Run.Count; ++Offset)
+                {
+                    TSharedPtr<FDiffRow> Row = MakeShared<FDiffRow>();
+                    Row->OldLine = Run.OldStart + Offset;
+                    Row->NewLine = Run.NewStart + Offset;
+                    Rows.Add(Row);
+                }
+                continue;
+            }
+
+            // Pair lines removed right before others were added, so a changed line sits next to its new version
+            int32 NumRemoved = 0;
+            int32 NumAdded = 0;
+            int32 OldStart = Run.OldStart;
+            int32 NewStart = Run.NewStart;
+            if (Run.Op == EN2CDiffOp::Delete)
+            {
+                NumRemoved = Run.Count;
+                if (Runs.IsValidIndex(RunIndex + 1) && Runs[RunIndex + 1].Op == EN2CDiffOp::Insert)
+                {
+                    ++RunIndex;
+                    NumAdded = Runs[RunIndex].Count;
+                    NewStart = Runs[RunIndex].NewStart;
+                }
+            }
+            else
+            {
+                NumAdded = Run.Count;
+            }
+
+            for (int32 Offset = 0; Offset < FMath::Max(NumRemoved, NumAdded); ++Offset)
+            {
+                TSharedPtr<FDiffRow> Row = MakeShared<FDiffRow>();
+                Row->OldLine = Offset < NumRemoved ? OldStart + Offset : INDEX_NONE;
+                Row->NewLine = Offset < NumAdded ? NewStart + Offset : INDEX_NONE;
+                Row->bChanged = true;
+                Rows.Add(Row);
+            }
+        }
+    }
+
+    if (ListView.IsValid())
+    {
+        ListView->RebuildList();
+    }
+}
+
+TSharedRef<ITableRow> SN2CDiffViewer::GenerateRow(TSharedPtr<FDiffRow> Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    check(OldHighlighter.IsValid() && NewHighlighter.IsValid());
+
+    // Lex a little past the shown lines so the next rows to scroll in are ready
+    if (Row->OldLine != INDEX_NONE)
+    {
+        OldHighlighter->LexViewerLines(Row->OldLine + SN2CCodeViewer::OverscanLines);
+    }
+    if (Row->NewLine != INDEX_NONE)
+    {
+        NewHighlighter->LexViewerLines(Row->NewLine + SN2CCodeViewer::OverscanLines);
+    }
+
+    return SNew(STableRow<TSharedPtr<FDiffRow>>, OwnerTable)
+        .ShowSelection(false)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(0.5f)
+            [
+                MakeSide(Row->OldLine, Row->bChanged, RemovedLineColor, OldHighlighter)
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(0.5f)
+            [
+                MakeSide(Row->NewLine, Row->bChanged, AddedLineColor, NewHighlighter)
+            ]
+        ];
+}
+
+TSharedRef<SWidget> SN2CDiffViewer::MakeSide(int32 LineIndex, bool bChanged, const FLinearColor& ChangedColor, const TSharedPtr<FN2CRichTextSyntaxHighlighter>& Highlighter) const
+{
+    const FLinearColor Color = LineIndex == INDEX_NONE ? MissingLineColor : (bChanged ? ChangedColor : FLinearColor::Transparent);
+
+    return SNew(SBorder)
+        .BorderImage(&RowBrush)
+        .BorderBackgroundColor(Color)
+        .Padding(FMargin(4.0f, 0.0f))
+        [
+            LineIndex == INDEX_NONE
+                ? StaticCastSharedRef<SWidget>(SNew(SSpacer))
+                : StaticCastSharedRef<SWidget>(SNew(SN2CCodeViewerLine, Highlighter.ToSharedRef()).LineIndex(LineIndex))
+        ];
+}
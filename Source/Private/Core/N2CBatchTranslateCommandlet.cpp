@@ -0,0 +1,909 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CBatchTranslateCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Core/N2CNodeTranslator.h"
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSettings.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "LLM/N2CLLMModule.h"
+#include "LLM/N2CTokenEstimator.h"
+#include "LLM/N2CTranslationOutputWriter.h"
+#include "Models/N2CCompactGraph.h"
+#include "Utils/N2CLogger.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
+
+/** Blueprints loaded between garbage collections */
+static constexpr int32 BlueprintsPerGarbageCollection = 50;
+
+/** Share of the usual price that provider batch APIs charge */
+static constexpr double BatchApiCostFactor = 0.5;
+
+void UN2CBatchTranslateCommandlet::FPlanStats::Add(const FPlanStats& Other)
+{
+    Graphs += Other.Graphs;
+    Requests += Other.Requests;
+    CachedGraphs += Other.CachedGraphs;
+    DuplicateGraphs += Other.DuplicateGraphs;
+    InputTokens += Other.InputTokens;
+    OutputTokens += Other.OutputTokens;
+    Cost += Other.Cost;
+    WallSeconds += Other.WallSeconds;
+}
+
+TSharedRef<FJsonObject> UN2CBatchTranslateCommandlet::FPlanStats::ToJson() const
+{
+    TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+    Object->SetNumberField(TEXT("graphs"), Graphs);
+    Object->SetNumberField(TEXT("requests"), Requests);
+    Object->SetNumberField(TEXT("cached_graphs"), CachedGraphs);
+    Object->SetNumberField(TEXT("duplicate_graphs"), DuplicateGraphs);
+    Object->SetNumberField(TEXT("input_tokens"), InputTokens);
+    Object->SetNumberField(TEXT("output_tokens"), OutputTokens);
+    Object->SetNumberField(TEXT("cost_usd"), Cost);
+    Object->SetNumberField(TEXT("wall_s"), WallSeconds);
+    return Object;
+}
+
+UN2CBatchTranslateCommandlet::UN2CBatchTranslateCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UN2CBatchTranslateCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    TArray<FString> Paths;
+    if (const FString* PathsParam = ParamVals.Find(TEXT("Paths")))
+    {
+        PathsParam->ParseIntoArray(Paths, TEXT("+"));
+    }
+    if (Paths.Num() == 0)
+    {
+        Paths.Add(TEXT("/Game"));
+    }
+
+    if (const FString* ClassParam = ParamVals.Find(TEXT("ParentClass")))
+    {
+        TArray<FString> ClassNames;
+        ClassParam->ParseIntoArray(ClassNames, TEXT("+"));
+        for (const FString& ClassName : ClassNames)
+        {
+            UClass* ParentClass = ClassName.StartsWith(TEXT("/"))
+                ? LoadObject<UClass>(nullptr, *ClassName)
+                : FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+            if (!ParentClass)
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Unknown parent class filter: %s"), *ClassName), TEXT("BatchTranslate"));
+                return 1;
+            }
+            ParentClasses.Add(ParentClass);
+        }
+    }
+
+    bDryRun = Switches.Contains(TEXT("DryRun"));
+    if (bDryRun)
+    {
+        // Nothing waits on requests, so extraction is all a dry run does
+        MaxLoads = 16;
+        MaxPrepared = 8;
+    }
+    bBatchApi = Switches.Contains(TEXT("BatchApi"));
+    bDedupeShapes = !Switches.Contains(TEXT("NoDedupe")) && !bBatchApi;
+    bShareMacros = !Switches.Contains(TEXT("InlineMacros"));
+    if (const FString* TimeoutParam = ParamVals.Find(TEXT("Timeout")))
+    {
+        TimeoutSeconds = FCString::Atod(**TimeoutParam);
+    }
+    if (const FString* MaxLoadsParam = ParamVals.Find(TEXT("MaxLoads")))
+    {
+        MaxLoads = FMath::Max(1, FCString::Atoi(**MaxLoadsParam));
+    }
+    if (const FString* MaxPreparedParam = ParamVals.Find(TEXT("MaxPrepared")))
+    {
+        MaxPrepared = FMath::Max(1, FCString::Atoi(**MaxPreparedParam));
+    }
+
+    if (Switches.Contains(TEXT("Export")) || ParamVals.Contains(TEXT("Export")))
+    {
+        const FString* ExportParam = ParamVals.Find(TEXT("Export"));
+        const FString ExportPath = ExportParam && !ExportParam->IsEmpty() ? *ExportParam
+            : FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Export") / FString::Printf(TEXT("Blueprints-%s.ndjson"), *FDateTime::Now().ToString());
+
+        ExportArchive.Reset(IFileManager::Get().CreateFileWriter(*ExportPath));
+        if (!ExportArchive.IsValid())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to open export file: %s"), *ExportPath), TEXT("BatchTranslate"));
+            return 1;
+        }
+
+        bCompactExport = Switches.Contains(TEXT("Compact"));
+
+        // Export lines stand alone, so each Blueprint keeps the macro graphs it uses
+        bShareMacros = false;
+        FN2CLogger::Get().Log(FString::Printf(TEXT("Exporting N2C JSON to %s"), *ExportPath), EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+    }
+
+    if (!bDryRun && !ExportArchive.IsValid())
+    {
+        UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+        if (!LLMModule || !LLMModule->Initialize())
+        {
+            FN2CLogger::Get().LogError(TEXT("Failed to initialize LLM Module"), TEXT("BatchTranslate"));
+            return 1;
+        }
+    }
+    else if (bDryRun && !ExportArchive.IsValid())
+    {
+        const FString* ReportParam = ParamVals.Find(TEXT("Report"));
+        PlanReportPath = ReportParam && !ReportParam->IsEmpty() ? *ReportParam
+            : FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Plans") / FString::Printf(TEXT("Plan-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+
+        // The plan needs the system prompt and the cache keys, but connects to nothing
+        UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        if (LLMModule && LLMModule->Initialize(false))
+        {
+            PlanSystemPromptTokens = LLMModule->EstimateSystemPromptTokens(Settings && Settings->bUseCompactJson);
+        }
+        else
+        {
+            FN2CLogger::Get().LogWarning(TEXT("Failed to initialize LLM Module, planning without system prompt tokens or cache hits"), TEXT("BatchTranslate"));
+        }
+    }
+
+    FindBlueprints(Paths, PendingAssets);
+    for (const FAssetData& Asset : PendingAssets)
+    {
+        ScheduledPackages.Add(Asset.PackageName);
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Found %d Blueprints under %s"), PendingAssets.Num(), *FString::Join(Paths, TEXT(", "))),
+        EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+
+    FN2CNodeTranslator::Get().SetShareMacroGraphs(bShareMacros);
+
+    // Every stage advances on each pass, so loading, extraction, serialization and requests overlap
+    double LastTime = FPlatformTime::Seconds();
+    PeakMemory.Reset();
+    while (NextAsset < PendingAssets.Num() || LoadsInFlight > 0 || LoadedBlueprints.Num() > 0
+        || PreparesInFlight > 0 || PreparedBlueprints.Num() > 0 || ActiveBatch.Blueprint.IsValid()
+        || BatchItems.Num() > 0 || bBatchJobInFlight)
+    {
+        StartLoads();
+        ExtractLoaded();
+        SendPrepared();
+        SubmitBatchItems();
+        Tick(LastTime);
+        PeakMemory.Sample();
+    }
+
+    FN2CNodeTranslator::Get().SetShareMacroGraphs(false);
+
+    if (ExportArchive.IsValid())
+    {
+        const bool bWriteFailed = !ExportArchive->Close();
+        ExportArchive.Reset();
+
+        const FString Summary = FString::Printf(TEXT("Export complete: %d of %d Blueprints written (%d failed)"),
+            ExportedBlueprints, Stats.Blueprints, Stats.FailedBlueprints);
+        if (Stats.FailedBlueprints > 0 || bWriteFailed)
+        {
+            FN2CLogger::Get().LogWarning(Summary, TEXT("BatchTranslate"));
+            return 1;
+        }
+
+        FN2CLogger::Get().Log(Summary, EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+        return 0;
+    }
+
+    // Batches flush when they end; this catches anything a single translation left queued
+    FN2CTranslationOutputWriter::Get().Flush();
+
+    const bool bReportFailed = bDryRun && !WritePlanReport();
+
+    const FString Summary = FString::Printf(
+        TEXT("Batch translation complete: %d Blueprints (%d failed, %d macro libraries added), %d graphs (%d failed, %d reused from identical graphs)%s. %s"),
+        Stats.Blueprints, Stats.FailedBlueprints, Stats.MacroLibraries, Stats.Graphs, Stats.FailedGraphs, Stats.ReusedGraphs, bDryRun ? TEXT(" [dry run]") : TEXT(""),
+        *PeakMemory.ToString());
+
+    if (Stats.FailedBlueprints > 0 || Stats.FailedGraphs > 0 || bReportFailed)
+    {
+        FN2CLogger::Get().LogWarning(Summary, TEXT("BatchTranslate"));
+        return 1;
+    }
+
+    FN2CLogger::Get().Log(Summary, EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+    return 0;
+}
+
+void UN2CBatchTranslateCommandlet::FindBlueprints(const TArray<FString>& Paths, TArray<FAssetData>& OutAssets)
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    Filter.bRecursivePaths = true;
+    for (const FString& Path : Paths)
+    {
+        Filter.PackagePaths.Add(FName(*Path));
+    }
+
+    AssetRegistry.GetAssets(Filter, OutAssets);
+
+    // Stable order so repeated runs produce the same logs
+    OutAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+}
+
+void UN2CBatchTranslateCommandlet::PrepareBlueprint(const FN2CBlueprint& Blueprint, const TSet<FString>& SharedMacroNames, EN2CJsonDialect Dialect,
+    EN2CTokenizerFamily TokenizerFamily, FPreparedBlueprint& OutPrepared)
+{
+    OutPrepared.BlueprintName = Blueprint.Metadata.Name;
+
+    if (!Blueprint.IsValid())
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Validation failed for: %s"), *OutPrepared.BlueprintName), TEXT("BatchTranslate"));
+        return;
+    }
+
+    FN2CBatchJsonContext BatchContext;
+    if (!FN2CSerializer::BuildBatchContext(Blueprint, BatchContext, Dialect))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to serialize shared context for: %s"), *OutPrepared.BlueprintName), TEXT("BatchTranslate"));
+        return;
+    }
+    const FString ContextJson = FN2CSerializer::SharedContextToJson(Blueprint, Dialect);
+
+    // One request per graph, serialized from the compact form
+    OutPrepared.Requests.Reserve(Blueprint.Graphs.Num());
+
+    FN2CStringArena Strings;
+    FN2CCompactGraph CompactGraph;
+    TArray<FString> GraphMacros;
+    for (const FN2CGraph& Graph : Blueprint.Graphs)
+    {
+        if (Graph.Name.IsEmpty())
+        {
+            continue;
+        }
+
+        GraphMacros.Reset();
+        if (SharedMacroNames.Num() > 0)
+        {
+            for (const FN2CNodeDefinition& Node : Graph.Nodes)
+            {
+                if (Node.NodeType == EN2CNodeType::MacroInstance && SharedMacroNames.Contains(Node.MemberName))
+                {
+                    GraphMacros.AddUnique(Node.MemberName);
+                }
+            }
+        }
+
+        CompactGraph.Build(Graph, Strings);
+        const FString GraphJson = FN2CSerializer::CompactGraphToJson(CompactGraph, Strings, Dialect);
+
+        FGraphRequest& Request = OutPrepared.Requests.AddDefaulted_GetRef();
+        Request.GraphName = Graph.Name;
+        Request.Json = FN2CSerializer::WithSharedMacros(FN2CSerializer::ToJsonForGraphs(BatchContext, { GraphJson }), GraphMacros);
+        Request.Fingerprint = FN2CNodeTranslator::ComputeGraphFingerprint(ContextJson, GraphJson);
+        Request.StructuralHash = FN2CNodeTranslator::ComputeStructuralHash(Graph);
+        Request.JsonTokens = FN2CTokenEstimator::EstimateTokens(Request.Json, TokenizerFamily);
+        Request.ComplexityScore = Graph.Complexity.GetScore();
+    }
+
+    OutPrepared.bValid = true;
+}
+
+bool UN2CBatchTranslateCommandlet::ExportBlueprint(const FN2CBlueprint& Blueprint, EN2CJsonDialect Dialect)
+{
+    if (!Blueprint.IsValid())
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Validation failed for: %s"), *Blueprint.Metadata.Name), TEXT("BatchTranslate"));
+        return false;
+    }
+
+    // Condensed JSON escapes line breaks inside strings, so each Blueprint is exactly one line
+    FString Line = FN2CSerializer::ToCondensedJson(Blueprint, Dialect);
+    Line += TEXT('\n');
+    const FTCHARToUTF8 Utf8(*Line, Line.Len());
+    Line.Empty();
+
+    FScopeLock ScopeLock(&ExportLock);
+    ExportArchive->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+
+    // Flushed per line so a reader on a pipe sees each Blueprint as soon as it is written
+    ExportArchive->Flush();
+    if (ExportArchive->IsError())
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to write export line for: %s"), *Blueprint.Metadata.Name), TEXT("BatchTranslate"));
+        return false;
+    }
+
+    ExportedBlueprints++;
+    return true;
+}
+
+void UN2CBatchTranslateCommandlet::StartLoads()
+{
+    // Loaded but unextracted Blueprints count against the limit so loading can't run ahead of extraction
+    while (NextAsset < PendingAssets.Num() && LoadsInFlight + LoadedBlueprints.Num() < MaxLoads)
+    {
+        const FAssetData& Asset = PendingAssets[NextAsset++];
+        LoadsInFlight++;
+
+        LoadPackageAsync(Asset.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+            [this, ObjectPath = Asset.GetSoftObjectPath()](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+            {
+                LoadsInFlight--;
+
+                UBlueprint* Blueprint = Result == EAsyncLoadingResult::Succeeded ? Cast<UBlueprint>(ObjectPath.ResolveObject()) : nullptr;
+                if (!Blueprint)
+                {
+                    FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to load Blueprint: %s"), *ObjectPath.ToString()), TEXT("BatchTranslate"));
+                    Stats.FailedBlueprints++;
+                    return;
+                }
+
+                const bool bMatchesClass = ParentClasses.Num() == 0 || MacroLibraryPackages.Contains(PackageName) || (Blueprint->GeneratedClass &&
+                    ParentClasses.ContainsByPredicate([Blueprint](const UClass* ParentClass) { return Blueprint->GeneratedClass->IsChildOf(ParentClass); }));
+                if (bMatchesClass)
+                {
+                    Stats.Blueprints++;
+                    LoadedBlueprints.Emplace(Blueprint);
+                }
+                else
+                {
+                    // A macro library found later is added back by ScheduleMacroLibraries
+                    ScheduledPackages.Remove(PackageName);
+                }
+            }));
+    }
+}
+
+void UN2CBatchTranslateCommandlet::ExtractLoaded()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bIncludeVariables = Settings ? Settings->bIncludeVariables : true;
+    const EN2CJsonDialect Dialect = Settings && Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+    const EN2CTokenizerFamily TokenizerFamily = FN2CTokenEstimator::GetFamily(Settings ? Settings->Provider : EN2CLLMProvider::Anthropic);
+
+    while (LoadedBlueprints.Num() > 0 && PreparesInFlight + PreparedBlueprints.Num() < MaxPrepared)
+    {
+        TStrongObjectPtr<UBlueprint> Blueprint = MoveTemp(LoadedBlueprints[0]);
+        LoadedBlueprints.RemoveAt(0);
+
+        // Extraction reads UObjects, so it stays on the game thread
+        FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+        if (!Translator.GenerateFromBlueprint(Blueprint.Get(), bIncludeVariables))
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to extract Blueprint: %s"), *Blueprint->GetName()), TEXT("BatchTranslate"));
+            Stats.FailedBlueprints++;
+            continue;
+        }
+
+        // Validation and serialization only read the Blueprint taken from the translator, so they run on a worker
+        TSet<FString> SharedMacroNames = Translator.GetSharedMacroNames();
+        ScheduleMacroLibraries(Translator.GetSharedMacroLibraries());
+        TSharedRef<FN2CBlueprint> Extracted = MakeShared<FN2CBlueprint>(Translator.TakeN2CBlueprint());
+        PreparesInFlight++;
+
+        if (ExportArchive.IsValid())
+        {
+            const EN2CJsonDialect ExportDialect = bCompactExport ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Extracted, ExportDialect]()
+            {
+                const bool bExported = ExportBlueprint(*Extracted, ExportDialect);
+                AsyncTask(ENamedThreads::GameThread, [this, bExported]()
+                {
+                    PreparesInFlight--;
+                    if (!bExported)
+                    {
+                        Stats.FailedBlueprints++;
+                    }
+                });
+            });
+        }
+        else
+        {
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Extracted, SharedMacroNames = MoveTemp(SharedMacroNames), Dialect, TokenizerFamily]()
+            {
+                TSharedPtr<FPreparedBlueprint> Prepared = MakeShared<FPreparedBlueprint>();
+                PrepareBlueprint(*Extracted, SharedMacroNames, Dialect, TokenizerFamily, *Prepared);
+                Prepared->Blueprint = Extracted;
+
+                AsyncTask(ENamedThreads::GameThread, [this, Prepared]()
+                {
+                    PreparesInFlight--;
+                    PreparedBlueprints.Add(Prepared);
+                });
+            });
+        }
+
+        // Collect only between loads so nothing half-loaded is swept
+        if (++ExtractedSinceCollection >= BlueprintsPerGarbageCollection && LoadsInFlight == 0)
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            ExtractedSinceCollection = 0;
+        }
+    }
+}
+
+void UN2CBatchTranslateCommandlet::PlanBlueprint(const FPreparedBlueprint& Prepared)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    const EN2CLLMProvider Provider = Settings ? Settings->Provider : EN2CLLMProvider::Anthropic;
+    const bool bUseCache = Settings && Settings->bUseTranslationCache && LLMModule;
+    const FN2CLatencyModel LatencyModel = LLMModule ? LLMModule->GetLatencyModel() : FN2CLatencyModel();
+
+    FPlanStats Plan;
+    Plan.Graphs = Prepared.Requests.Num();
+    TArray<double> Durations;
+    for (const FGraphRequest& Request : Prepared.Requests)
+    {
+        // Taken out in the order a real run takes them out: copies of a shape, then cache hits
+        if (bDedupeShapes && !Request.StructuralHash.IsEmpty())
+        {
+            bool bAlreadyPlanned = false;
+            PlannedShapes.Add(Request.StructuralHash, &bAlreadyPlanned);
+            if (bAlreadyPlanned)
+            {
+                Plan.DuplicateGraphs++;
+                continue;
+            }
+        }
+        if (bUseCache && LLMModule->HasCachedTranslation(Request.Json))
+        {
+            Plan.CachedGraphs++;
+            continue;
+        }
+
+        Plan.Requests++;
+        Plan.InputTokens += PlanSystemPromptTokens + Request.JsonTokens;
+        Plan.OutputTokens += FMath::CeilToInt(Request.ComplexityScore * FN2CLatencyModel::OutputTokensPerComplexity);
+        Durations.Add(LatencyModel.EstimateSeconds(Request.JsonTokens, Request.ComplexityScore));
+    }
+
+    // Prices are per million tokens
+    if (Settings)
+    {
+        Plan.Cost = (Plan.InputTokens * Settings->GetInputCost(Provider) + Plan.OutputTokens * Settings->GetOutputCost(Provider)) / 1000000.0;
+    }
+    if (bBatchApi)
+    {
+        Plan.Cost *= BatchApiCostFactor;
+    }
+
+    // A Blueprint's requests are queued together, and the scheduler starts the longest in whichever slot frees up first
+    if (!bBatchApi && Durations.Num() > 0)
+    {
+        Durations.Sort(TGreater<>());
+        const int32 Slots = FMath::Clamp(FN2CLLMRequestScheduler::Get().GetConcurrencyLimit(Provider), 1, Durations.Num());
+        TArray<double> SlotsFreeAt;
+        SlotsFreeAt.Init(0.0, Slots);
+        for (const double Duration : Durations)
+        {
+            int32 Soonest = 0;
+            FMath::Min(SlotsFreeAt, &Soonest);
+            SlotsFreeAt[Soonest] += Duration;
+        }
+        Plan.WallSeconds = FMath::Max(SlotsFreeAt);
+
+        // The rate limit spaces out whatever the burst does not cover
+        const FN2CProviderRequestLimits Limits = Settings ? Settings->GetProviderRequestLimits(Provider) : FN2CProviderRequestLimits();
+        if (Limits.RequestsPerMinute > 0.0f && Durations.Num() > Limits.BurstSize)
+        {
+            const double Spacing = (Durations.Num() - FMath::Max(1, Limits.BurstSize)) * 60.0 / Limits.RequestsPerMinute;
+            Plan.WallSeconds = FMath::Max(Plan.WallSeconds, Spacing + Durations.Last());
+        }
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%s: %d graphs, %d requests (%d cached, %d repeated shapes), ~%lld input and ~%lld output tokens, ~$%.4f, ~%.0fs"),
+            *Prepared.BlueprintName, Plan.Graphs, Plan.Requests, Plan.CachedGraphs, Plan.DuplicateGraphs,
+            Plan.InputTokens, Plan.OutputTokens, Plan.Cost, Plan.WallSeconds),
+        EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+
+    TSharedRef<FJsonObject> Entry = Plan.ToJson();
+    Entry->SetStringField(TEXT("blueprint"), Prepared.BlueprintName);
+    PlannedBlueprints.Add(MakeShared<FJsonValueObject>(Entry));
+    PlanTotals.Add(Plan);
+}
+
+bool UN2CBatchTranslateCommandlet::WritePlanReport() const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const EN2CLLMProvider Provider = Settings ? Settings->Provider : EN2CLLMProvider::Anthropic;
+
+    TSharedRef<FJsonObject> RootObject = PlanTotals.ToJson();
+    RootObject->SetStringField(TEXT("provider"), UEnum::GetValueAsString(Provider));
+    RootObject->SetStringField(TEXT("model"), Settings ? Settings->GetActiveModel() : FString());
+    RootObject->SetNumberField(TEXT("concurrency"), FN2CLLMRequestScheduler::Get().GetConcurrencyLimit(Provider));
+    RootObject->SetBoolField(TEXT("batch_api"), bBatchApi);
+    RootObject->SetArrayField(TEXT("blueprints"), PlannedBlueprints);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Plan: %d graphs in %d requests (%d cached, %d repeated shapes), ~%lld input and ~%lld output tokens, ~$%.2f at the configured prices, %s"),
+            PlanTotals.Graphs, PlanTotals.Requests, PlanTotals.CachedGraphs, PlanTotals.DuplicateGraphs,
+            PlanTotals.InputTokens, PlanTotals.OutputTokens, PlanTotals.Cost,
+            bBatchApi ? TEXT("in batch jobs taking up to 24 hours") : *FString::Printf(TEXT("~%.1f minutes of requests"), PlanTotals.WallSeconds / 60.0)),
+        EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+
+    FString Out;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+    FJsonSerializer::Serialize(RootObject, Writer);
+    if (!FFileHelper::SaveStringToFile(Out, *PlanReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to write plan report: %s"), *PlanReportPath), TEXT("BatchTranslate"));
+        return false;
+    }
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Plan written to %s"), *PlanReportPath), EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+    return true;
+}
+
+void UN2CBatchTranslateCommandlet::ScheduleMacroLibraries(const TArray<TWeakObjectPtr<UBlueprint>>& MacroLibraries)
+{
+    for (const TWeakObjectPtr<UBlueprint>& WeakLibrary : MacroLibraries)
+    {
+        UBlueprint* MacroLibrary = WeakLibrary.Get();
+        if (!MacroLibrary)
+        {
+            continue;
+        }
+
+        // A library still to load passes the class filter when it does
+        const FName PackageName = MacroLibrary->GetPackage()->GetFName();
+        MacroLibraryPackages.Add(PackageName);
+
+        bool bAlreadyScheduled = false;
+        ScheduledPackages.Add(PackageName, &bAlreadyScheduled);
+        if (bAlreadyScheduled)
+        {
+            continue;
+        }
+
+        // Instantiating its macros loaded it already, so it goes straight to extraction
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Adding macro library %s, whose macros are instantiated by %s"), *MacroLibrary->GetName(), *FN2CNodeTranslator::Get().GetN2CBlueprint().Metadata.Name),
+            EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+        Stats.Blueprints++;
+        Stats.MacroLibraries++;
+        LoadedBlueprints.Emplace(MacroLibrary);
+    }
+}
+
+void UN2CBatchTranslateCommandlet::SendPrepared()
+{
+    if (ActiveBatch.Blueprint.IsValid())
+    {
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        if (*ActiveBatch.Remaining <= 0)
+        {
+            FinishActiveBatch(false);
+        }
+        else if (Settings && FN2CLLMRequestScheduler::Get().GetSecondsUntilBackgroundWindow(Settings->Provider) > 0.0)
+        {
+            // Waiting for the provider's time window is not the provider being slow
+            ActiveBatch.StartTime = FPlatformTime::Seconds();
+        }
+        else if (TimeoutSeconds > 0.0 && FPlatformTime::Seconds() - ActiveBatch.StartTime > TimeoutSeconds)
+        {
+            FinishActiveBatch(true);
+        }
+        return;
+    }
+
+    while (PreparedBlueprints.Num() > 0)
+    {
+        TSharedPtr<FPreparedBlueprint> Prepared = PreparedBlueprints[0];
+        PreparedBlueprints.RemoveAt(0);
+
+        if (!Prepared->bValid)
+        {
+            Stats.FailedBlueprints++;
+            continue;
+        }
+
+        Stats.Graphs += Prepared->Requests.Num();
+
+        if (bDryRun)
+        {
+            Prepared->Blueprint.Reset();
+            PlanBlueprint(*Prepared);
+            continue;
+        }
+
+        if (Prepared->Requests.Num() == 0)
+        {
+            Prepared->Blueprint.Reset();
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("%s: %d graphs serialized"), *Prepared->BlueprintName, Prepared->Requests.Num()),
+                EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+            continue;
+        }
+
+        if (bBatchApi)
+        {
+            // Holding every Blueprint until the job ends would grow with the project, so batch jobs
+            // save the graph files only
+            Prepared->Blueprint.Reset();
+            QueueBatchItems(*Prepared);
+            continue;
+        }
+
+        UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+        LLMModule->BeginBatchTranslation(Prepared->BlueprintName, Prepared->Blueprint.Get());
+        Prepared->Blueprint.Reset();
+
+        // A run interrupted part way through this Blueprint already saved some graphs; carry those
+        // forward and send only the rest
+        TMap<FString, FString> CompletedFingerprints;
+        FString InterruptedRootPath;
+        if (LLMModule->FindInterruptedBatch(Prepared->BlueprintName, CompletedFingerprints, InterruptedRootPath))
+        {
+            TMap<FString, FString> ResumedGraphs;
+            Prepared->Requests.RemoveAll([&CompletedFingerprints, &ResumedGraphs](const FGraphRequest& Request)
+            {
+                const FString* Completed = CompletedFingerprints.Find(Request.GraphName);
+                if (Completed && *Completed == Request.Fingerprint)
+                {
+                    ResumedGraphs.Add(Request.GraphName, Request.Fingerprint);
+                    return true;
+                }
+                return false;
+            });
+            LLMModule->CarryForwardUnchangedGraphs(InterruptedRootPath, ResumedGraphs);
+
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("%s: resuming interrupted run, %d graphs already translated"), *Prepared->BlueprintName, ResumedGraphs.Num()),
+                EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+
+            if (Prepared->Requests.Num() == 0)
+            {
+                LLMModule->EndBatchTranslation();
+                continue;
+            }
+        }
+
+        // The batch wrote the Blueprint files already, so its requests need only its folder
+        const TSharedRef<FN2CTranslationSession> Session = LLMModule->CreateSession(nullptr);
+        Session->Priority = EN2CRequestPriority::Batch;
+
+        TMap<FString, TArray<FGraphRequest>> WaitingCopies;
+        if (bDedupeShapes)
+        {
+            TakeDuplicateShapes(*Prepared, *Session, WaitingCopies);
+            if (Prepared->Requests.Num() == 0)
+            {
+                LLMModule->EndBatchTranslation();
+                continue;
+            }
+        }
+
+        ActiveBatch.Blueprint = Prepared;
+        ActiveBatch.Remaining = MakeShared<int32>(Prepared->Requests.Num());
+        ActiveBatch.Failed = MakeShared<int32>(0);
+        ActiveBatch.StartTime = FPlatformTime::Seconds();
+
+        for (const FGraphRequest& Request : Prepared->Requests)
+        {
+            TArray<FGraphRequest> Copies;
+            WaitingCopies.RemoveAndCopyValue(Request.StructuralHash, Copies);
+
+            LLMModule->RecordGraphQueued(Request.GraphName, Request.Fingerprint);
+            LLMModule->ProcessN2CJson(Request.Json, FOnLLMTranslationComplete::CreateLambda(
+                [this, Request, Copies = MoveTemp(Copies), Session, Remaining = ActiveBatch.Remaining, Failed = ActiveBatch.Failed]
+                (const FN2CTranslationResponse& Response, bool bSuccess)
+                {
+                    // The module has already parsed the response and written it with SaveTranslationToDisk
+                    const FN2CGraphTranslation* Translation = nullptr;
+                    if (bSuccess)
+                    {
+                        UN2CLLMModule::Get()->RecordGraphFingerprint(Request.GraphName, Request.Fingerprint);
+
+                        Translation = Response.Graphs.FindByPredicate(
+                            [&Request](const FN2CGraphTranslation& Graph) { return Graph.GraphName == Request.GraphName; });
+                        if (!Translation && Response.Graphs.Num() == 1)
+                        {
+                            Translation = &Response.Graphs[0];
+                        }
+                        if (Translation && bDedupeShapes)
+                        {
+                            ShapeTranslations.Add(Request.StructuralHash, *Translation);
+                        }
+                    }
+                    else
+                    {
+                        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to translate graph: %s"), *Request.GraphName), TEXT("BatchTranslate"));
+                        UN2CLLMModule::Get()->RecordGraphFailed(Request.GraphName);
+                        ++(*Failed);
+                    }
+
+                    // Copies waiting on this graph share its outcome
+                    for (const FGraphRequest& Copy : Copies)
+                    {
+                        if (!Translation || !SaveShapeCopy(*Translation, Copy, *Session))
+                        {
+                            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to translate graph: %s"), *Copy.GraphName), TEXT("BatchTranslate"));
+                            UN2CLLMModule::Get()->RecordGraphFailed(Copy.GraphName);
+                            Stats.FailedGraphs++;
+                        }
+                    }
+                    --(*Remaining);
+                }), INDEX_NONE, Session);
+        }
+        return;
+    }
+}
+
+void UN2CBatchTranslateCommandlet::FinishActiveBatch(bool bTimedOut)
+{
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    const FPreparedBlueprint& Prepared = *ActiveBatch.Blueprint;
+
+    if (bTimedOut)
+    {
+        FN2CLogger::Get().LogError(
+            FString::Printf(TEXT("Timed out waiting for %d responses for: %s"), *ActiveBatch.Remaining, *Prepared.BlueprintName), TEXT("BatchTranslate"));
+
+        // Cancelled requests report failure straight away, so the connections and rate limit budget
+        // are free for the next Blueprint
+        LLMModule->CancelTranslations();
+        *ActiveBatch.Failed += FMath::Max(0, *ActiveBatch.Remaining);
+    }
+
+    LLMModule->EndBatchTranslation();
+
+    const int32 Failed = *ActiveBatch.Failed;
+    Stats.FailedGraphs += Failed;
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%s: %d of %d graphs translated"), *Prepared.BlueprintName, Prepared.Requests.Num() - Failed, Prepared.Requests.Num()),
+        EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+
+    ActiveBatch = FActiveBatch();
+}
+
+void UN2CBatchTranslateCommandlet::TakeDuplicateShapes(
+    FPreparedBlueprint& Prepared, const FN2CTranslationSession& Session, TMap<FString, TArray<FGraphRequest>>& OutWaitingCopies)
+{
+    const int32 NumRequests = Prepared.Requests.Num();
+    int32 NumSaved = 0;
+    int32 NumFailed = 0;
+
+    TSet<FString> SentShapes;
+    Prepared.Requests.RemoveAll([this, &Session, &OutWaitingCopies, &SentShapes, &NumSaved, &NumFailed](const FGraphRequest& Request)
+    {
+        if (const FN2CGraphTranslation* Translation = ShapeTranslations.Find(Request.StructuralHash))
+        {
+            if (!SaveShapeCopy(*Translation, Request, Session))
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to save graph: %s"), *Request.GraphName), TEXT("BatchTranslate"));
+                UN2CLLMModule::Get()->RecordGraphFailed(Request.GraphName);
+                Stats.FailedGraphs++;
+                NumFailed++;
+            }
+            NumSaved++;
+            return true;
+        }
+
+        bool bAlreadySent = false;
+        SentShapes.Add(Request.StructuralHash, &bAlreadySent);
+        if (bAlreadySent)
+        {
+            OutWaitingCopies.FindOrAdd(Request.StructuralHash).Add(Request);
+            return true;
+        }
+        return false;
+    });
+
+    if (Prepared.Requests.Num() < NumRequests)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("%s: %d graphs saved from identical graphs translated earlier (%d failed), %d waiting on an identical graph"),
+                *Prepared.BlueprintName, NumSaved, NumFailed, NumRequests - Prepared.Requests.Num() - NumSaved),
+            EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+    }
+}
+
+bool UN2CBatchTranslateCommandlet::SaveShapeCopy(
+    const FN2CGraphTranslation& Translation, const FGraphRequest& Request, const FN2CTranslationSession& Session)
+{
+    FN2CTranslationResponse Response;
+    FN2CGraphTranslation& Copy = Response.Graphs.Add_GetRef(Translation);
+    Copy.GraphName = Request.GraphName;
+
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (!LLMModule->SaveTranslationToDisk(Response, Session))
+    {
+        return false;
+    }
+
+    LLMModule->RecordGraphFingerprint(Request.GraphName, Request.Fingerprint);
+    Stats.ReusedGraphs++;
+    return true;
+}
+
+void UN2CBatchTranslateCommandlet::QueueBatchItems(const FPreparedBlueprint& Prepared)
+{
+    for (const FGraphRequest& Request : Prepared.Requests)
+    {
+        FN2CBatchJobItem& Item = BatchItems.AddDefaulted_GetRef();
+        Item.JsonInput = Request.Json;
+        Item.BatchName = Prepared.BlueprintName;
+
+        // Results arrive grouped by Blueprint, inside the batch output folder the module opens for it
+        Item.OnComplete = FOnLLMTranslationComplete::CreateLambda(
+            [this, GraphName = Request.GraphName, Fingerprint = Request.Fingerprint](const FN2CTranslationResponse& Response, bool bSuccess)
+            {
+                if (bSuccess)
+                {
+                    UN2CLLMModule::Get()->RecordGraphFingerprint(GraphName, Fingerprint);
+                }
+                else
+                {
+                    FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to translate graph: %s"), *GraphName), TEXT("BatchTranslate"));
+                    UN2CLLMModule::Get()->RecordGraphFailed(GraphName);
+                    Stats.FailedGraphs++;
+                }
+            });
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%s: %d graphs queued for the batch job"), *Prepared.BlueprintName, Prepared.Requests.Num()),
+        EN2CLogSeverity::Info, TEXT("BatchTranslate"));
+}
+
+void UN2CBatchTranslateCommandlet::SubmitBatchItems()
+{
+    // One submission for the whole run, once every Blueprint has been prepared
+    if (bBatchJobInFlight || BatchItems.Num() == 0 || NextAsset < PendingAssets.Num() || LoadsInFlight > 0
+        || LoadedBlueprints.Num() > 0 || PreparesInFlight > 0 || PreparedBlueprints.Num() > 0)
+    {
+        return;
+    }
+
+    const int32 NumItems = BatchItems.Num();
+    bBatchJobInFlight = true;
+    if (!UN2CLLMModule::Get()->SubmitBatchJob(MoveTemp(BatchItems), FSimpleDelegate::CreateLambda([this]() { bBatchJobInFlight = false; })))
+    {
+        Stats.FailedGraphs += NumItems;
+        bBatchJobInFlight = false;
+    }
+    BatchItems.Reset();
+}
+
+void UN2CBatchTranslateCommandlet::Tick(double& LastTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    const float DeltaTime = static_cast<float>(Now - LastTime);
+    LastTime = Now;
+
+    FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+    FTSTicker::GetCoreTicker().Tick(DeltaTime);
+    ProcessAsyncLoading(true, false, 0.005);
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    FPlatformProcess::Sleep(0.005f);
+}
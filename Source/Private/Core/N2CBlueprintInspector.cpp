@@ -0,0 +1,771 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CBlueprintInspector.h"
+
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSettings.h"
+#include "Core/N2CSnapshot.h"
+#include "Models/N2CBlueprint.h"
+#include "Utils/N2CLogger.h"
+#include "Async/Async.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "IDesktopPlatform.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Styling/AppStyle.h"
+#include "Styling/CoreStyle.h"
+#include "Tasks/Task.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+namespace
+{
+    /** Matches listed for a search; enough to narrow it down from */
+    constexpr int32 MaxSearchResults = 1000;
+
+    /** Characters of an execution chain shown on its row */
+    constexpr int32 MaxChainTextLength = 1000;
+
+    FString GetMemberTypeText(EN2CStructMemberType Type, const FString& TypeName, bool bIsArray, bool bIsSet, bool bIsMap)
+    {
+        FString Text = TypeName.IsEmpty() ? StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Type)) : TypeName;
+        if (bIsArray)
+        {
+            Text = FString::Printf(TEXT("TArray<%s>"), *Text);
+        }
+        else if (bIsSet)
+        {
+            Text = FString::Printf(TEXT("TSet<%s>"), *Text);
+        }
+        else if (bIsMap)
+        {
+            Text = FString::Printf(TEXT("TMap<..., %s>"), *Text);
+        }
+        return Text;
+    }
+
+    FString GetVariableText(const FN2CVariable& Variable)
+    {
+        FString Text = GetMemberTypeText(Variable.Type, Variable.TypeName, Variable.bIsArray, Variable.bIsSet, Variable.bIsMap);
+        if (!Variable.DefaultValue.IsEmpty())
+        {
+            Text += TEXT(" = ") + Variable.DefaultValue;
+        }
+        return Text;
+    }
+
+    bool Matches(const FString& Value, const FString& SearchText)
+    {
+        return !Value.IsEmpty() && Value.Contains(SearchText, ESearchCase::IgnoreCase);
+    }
+}
+
+const FName SN2CBlueprintInspector::TabId(TEXT("NodeToCodeBlueprintInspector"));
+TWeakPtr<SN2CBlueprintInspector> SN2CBlueprintInspector::ActiveInspector;
+
+void SN2CBlueprintInspector::RegisterTabSpawner()
+{
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
+        TabId,
+        FOnSpawnTab::CreateStatic(&SN2CBlueprintInspector::SpawnTab))
+        .SetDisplayName(NSLOCTEXT("NodeToCode", "InspectorTabTitle", "Node to Code Blueprint Inspector"))
+        .SetMenuType(ETabSpawnerMenuType::Hidden)
+        .SetIcon(FSlateIcon("NodeToCodeStyle", "NodeToCode.ToolbarButton"));
+}
+
+void SN2CBlueprintInspector::UnregisterTabSpawner()
+{
+    FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(TabId);
+}
+
+TSharedRef<SDockTab> SN2CBlueprintInspector::SpawnTab(const FSpawnTabArgs& Args)
+{
+    TSharedRef<SN2CBlueprintInspector> Inspector = SNew(SN2CBlueprintInspector);
+    ActiveInspector = Inspector;
+
+    return SNew(SDockTab)
+        .TabRole(ETabRole::NomadTab)
+        [
+            Inspector
+        ];
+}
+
+void SN2CBlueprintInspector::Inspect(const TSharedRef<const FN2CBlueprint>& Blueprint, const FString& Title)
+{
+    FGlobalTabmanager::Get()->TryInvokeTab(TabId);
+    if (const TSharedPtr<SN2CBlueprintInspector> Inspector = ActiveInspector.Pin())
+    {
+        Inspector->SetBlueprint(Blueprint, Title);
+    }
+}
+
+void SN2CBlueprintInspector::Construct(const FArguments& InArgs)
+{
+    PlaceholderItem = MakeItem(EItemKind::Placeholder);
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(0.0f, 0.0f, 4.0f, 0.0f)
+            [
+                SNew(SButton)
+                .Text(NSLOCTEXT("NodeToCode", "InspectorOpen", "Open..."))
+                .ToolTipText(NSLOCTEXT("NodeToCode", "InspectorOpenTooltip", "Inspect a Blueprint JSON dump or binary snapshot"))
+                .OnClicked(this, &SN2CBlueprintInspector::OnOpenClicked)
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SAssignNew(SearchBox, SSearchBox)
+                .DelayChangeNotificationsWhileTyping(true)
+                .OnTextChanged(this, &SN2CBlueprintInspector::OnSearchTextChanged)
+            ]
+        ]
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(4.0f, 0.0f, 4.0f, 4.0f)
+        [
+            SNew(STextBlock)
+            .Text_Lambda([this]()
+            {
+                if (!Blueprint.IsValid())
+                {
+                    return NSLOCTEXT("NodeToCode", "InspectorEmpty", "Nothing to inspect. Open a dump, or inspect a graph from the Node to Code menu");
+                }
+                FString Status = Title;
+                if (!SearchText.IsEmpty())
+                {
+                    Status += FString::Printf(TEXT("   %d%s matches"), Roots.Num(), bSearchTruncated ? TEXT("+") : TEXT(""));
+                }
+                return FText::FromString(Status);
+            })
+        ]
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            SAssignNew(TreeView, STreeView<FItemPtr>)
+            .TreeItemsSource(&Roots)
+            .SelectionMode(ESelectionMode::Single)
+            .OnGenerateRow(this, &SN2CBlueprintInspector::GenerateRow)
+            .OnGetChildren(this, &SN2CBlueprintInspector::GetChildren)
+        ]
+    ];
+}
+
+void SN2CBlueprintInspector::SetBlueprint(const TSharedPtr<const FN2CBlueprint>& InBlueprint, const FString& InTitle)
+{
+    Blueprint = InBlueprint;
+    Title = InTitle;
+    SearchText.Reset();
+    if (SearchBox.IsValid())
+    {
+        SearchBox->SetText(FText::GetEmpty());
+    }
+    if (TreeView.IsValid())
+    {
+        TreeView->ClearExpandedItems();
+    }
+    RefreshRoots();
+}
+
+SN2CBlueprintInspector::FItemPtr SN2CBlueprintInspector::MakeItem(EItemKind Kind, int32 GraphIndex, int32 Index, int32 SubIndex)
+{
+    FItemPtr Item = MakeShared<FItem>();
+    Item->Kind = Kind;
+    Item->GraphIndex = GraphIndex;
+    Item->Index = Index;
+    Item->SubIndex = SubIndex;
+    return Item;
+}
+
+TSharedRef<ITableRow> SN2CBlueprintInspector::GenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(STableRow<FItemPtr>, OwnerTable)
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(0.45f)
+            [
+                SNew(STextBlock)
+                .Text(FText::FromString(GetItemLabel(*Item)))
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(0.55f)
+            [
+                SNew(STextBlock)
+                .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+                .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+                .Text(FText::FromString(GetItemValue(*Item)))
+            ]
+        ];
+}
+
+void SN2CBlueprintInspector::GetChildren(FItemPtr Item, TArray<FItemPtr>& OutChildren)
+{
+    if (!Blueprint.IsValid() || !Item.IsValid() || Item->Kind == EItemKind::Placeholder)
+    {
+        return;
+    }
+
+    // The tree asks every listed item for children to draw its expander; only expanded ones need them built
+    if (!TreeView.IsValid() || !TreeView->IsItemExpanded(Item))
+    {
+        if (GetNumChildren(*Item) > 0)
+        {
+            OutChildren.Add(PlaceholderItem);
+        }
+        return;
+    }
+
+    if (!Item->bChildrenBuilt)
+    {
+        BuildChildren(*Item);
+        Item->bChildrenBuilt = true;
+    }
+    OutChildren = Item->Children;
+}
+
+int32 SN2CBlueprintInspector::GetNumChildren(const FItem& Item) const
+{
+    const FN2CGraph* Graph = Blueprint->Graphs.IsValidIndex(Item.GraphIndex) ? &Blueprint->Graphs[Item.GraphIndex] : nullptr;
+    switch (Item.Kind)
+    {
+        case EItemKind::Graphs:
+            return Blueprint->Graphs.Num();
+        case EItemKind::Graph:
+            return Graph ? 2 + (Graph->LocalVariables.Num() > 0 ? 1 : 0) : 0;
+        case EItemKind::Nodes:
+            return Graph ? Graph->Nodes.Num() : 0;
+        case EItemKind::Node:
+            return Graph && Graph->Nodes.IsValidIndex(Item.Index) ? Graph->Nodes[Item.Index].NumPins() : 0;
+        case EItemKind::Flows:
+            return Graph ? Graph->Flows.NumExecutionChains() + Graph->Flows.Data.Num() : 0;
+        case EItemKind::LocalVariables:
+            return Graph ? Graph->LocalVariables.Num() : 0;
+        case EItemKind::Structs:
+            return Blueprint->Structs.Num();
+        case EItemKind::Struct:
+            return Blueprint->Structs.IsValidIndex(Item.Index) ? Blueprint->Structs[Item.Index].Members.Num() : 0;
+        case EItemKind::Enums:
+            return Blueprint->Enums.Num();
+        case EItemKind::Enum:
+            return Blueprint->Enums.IsValidIndex(Item.Index) ? Blueprint->Enums[Item.Index].Values.Num() : 0;
+        case EItemKind::Variables:
+            return Blueprint->Variables.Num();
+        case EItemKind::Components:
+            return Blueprint->Components.Num();
+        case EItemKind::Component:
+            return Blueprint->Components.IsValidIndex(Item.Index) ? Blueprint->Components[Item.Index].OverriddenProperties.Num() : 0;
+        default:
+            return 0;
+    }
+}
+
+void SN2CBlueprintInspector::BuildChildren(FItem& Item) const
+{
+    const int32 NumChildren = GetNumChildren(Item);
+    Item.Children.Reserve(NumChildren);
+    const auto AddChildren = [&Item, NumChildren](EItemKind Kind, int32 GraphIndex, int32 Index, bool bChildIsIndex)
+    {
+        for (int32 Child = 0; Child < NumChildren; ++Child)
+        {
+            Item.Children.Add(bChildIsIndex ? MakeItem(Kind, GraphIndex, Child) : MakeItem(Kind, GraphIndex, Index, Child));
+        }
+    };
+
+    switch (Item.Kind)
+    {
+        case EItemKind::Graphs:
+            for (int32 GraphIndex = 0; GraphIndex < NumChildren; ++GraphIndex)
+            {
+                Item.Children.Add(MakeItem(EItemKind::Graph, GraphIndex));
+            }
+            break;
+        case EItemKind::Graph:
+            Item.Children.Add(MakeItem(EItemKind::Nodes, Item.GraphIndex));
+            Item.Children.Add(MakeItem(EItemKind::Flows, Item.GraphIndex));
+            if (NumChildren > 2)
+            {
+                Item.Children.Add(MakeItem(EItemKind::LocalVariables, Item.GraphIndex));
+            }
+            break;
+        case EItemKind::Nodes:
+            AddChildren(EItemKind::Node, Item.GraphIndex, INDEX_NONE, true);
+            break;
+        case EItemKind::Node:
+            AddChildren(EItemKind::Pin, Item.GraphIndex, Item.Index, false);
+            break;
+        case EItemKind::Flows:
+        {
+            // Execution chains first, then data connections
+            const int32 NumChains = Blueprint->Graphs[Item.GraphIndex].Flows.NumExecutionChains();
+            for (int32 Child = 0; Child < NumChildren; ++Child)
+            {
+                Item.Children.Add(Child < NumChains
+                    ? MakeItem(EItemKind::ExecutionChain, Item.GraphIndex, Child)
+                    : MakeItem(EItemKind::DataFlow, Item.GraphIndex, Child - NumChains));
+            }
+            break;
+        }
+        case EItemKind::LocalVariables:
+            AddChildren(EItemKind::Variable, Item.GraphIndex, INDEX_NONE, true);
+            break;
+        case EItemKind::Structs:
+            AddChildren(EItemKind::Struct, INDEX_NONE, INDEX_NONE, true);
+            break;
+        case EItemKind::Struct:
+            AddChildren(EItemKind::StructMember, INDEX_NONE, Item.Index, false);
+            break;
+        case EItemKind::Enums:
+            AddChildren(EItemKind::Enum, INDEX_NONE, INDEX_NONE, true);
+            break;
+        case EItemKind::Enum:
+            AddChildren(EItemKind::EnumValue, INDEX_NONE, Item.Index, false);
+            break;
+        case EItemKind::Variables:
+            AddChildren(EItemKind::Variable, INDEX_NONE, INDEX_NONE, true);
+            break;
+        case EItemKind::Components:
+            AddChildren(EItemKind::Component, INDEX_NONE, INDEX_NONE, true);
+            break;
+        case EItemKind::Component:
+            AddChildren(EItemKind::ComponentProperty, INDEX_NONE, Item.Index, false);
+            break;
+        default:
+            break;
+    }
+}
+
+FString SN2CBlueprintInspector::GetItemLabel(const FItem& Item) const
+{
+    if (!Blueprint.IsValid())
+    {
+        return FString();
+    }
+
+    const FN2CGraph* Graph = Blueprint->Graphs.IsValidIndex(Item.GraphIndex) ? &Blueprint->Graphs[Item.GraphIndex] : nullptr;
+    const FN2CNodeDefinition* Node = Graph && Graph->Nodes.IsValidIndex(Item.Index) ? &Graph->Nodes[Item.Index] : nullptr;
+    const FString GraphPath = Item.bShowPath && Graph ? Graph->Name + TEXT(" / ") : FString();
+
+    switch (Item.Kind)
+    {
+        case EItemKind::Graphs:
+            return TEXT("Graphs");
+        case EItemKind::Graph:
+            return Graph ? Graph->Name : FString();
+        case EItemKind::Nodes:
+            return TEXT("Nodes");
+        case EItemKind::Node:
+            return Node ? FString::Printf(TEXT("%s%s  %s"), *GraphPath, *Node->ID, *Node->Name) : FString();
+        case EItemKind::Pin:
+        {
+            const FN2CPinDefinition* Pin = Node ? Node->GetPin(Item.SubIndex) : nullptr;
+            return Pin ? FString::Printf(TEXT("%s%s%s  %s"), *GraphPath, Item.bShowPath ? *(Node->ID + TEXT(".")) : TEXT(""), *Pin->ID, *Pin->Name) : FString();
+        }
+        case EItemKind::Flows:
+            return TEXT("Flows");
+        case EItemKind::ExecutionChain:
+            return FString::Printf(TEXT("Execution %d"), Item.Index + 1);
+        case EItemKind::DataFlow:
+        {
+            FString Label;
+            const FN2CDataFlow* Flow = Graph && Graph->Flows.Data.IsValidIndex(Item.Index) ? &Graph->Flows.Data[Item.Index] : nullptr;
+            if (Flow && Graph->AppendPinReference(Label, Flow->SourceNode, Flow->SourcePin))
+            {
+                Label += TEXT(" -> ");
+                Graph->AppendPinReference(Label, Flow->TargetNode, Flow->TargetPin);
+            }
+            return Label;
+        }
+        case EItemKind::LocalVariables:
+            return TEXT("Local Variables");
+        case EItemKind::Structs:
+            return TEXT("Structs");
+        case EItemKind::Struct:
+            return Blueprint->Structs.IsValidIndex(Item.Index) ? Blueprint->Structs[Item.Index].Name : FString();
+        case EItemKind::StructMember:
+        {
+            if (!Blueprint->Structs.IsValidIndex(Item.Index) || !Blueprint->Structs[Item.Index].Members.IsValidIndex(Item.SubIndex))
+            {
+                return FString();
+            }
+            const FN2CStruct& Struct = Blueprint->Structs[Item.Index];
+            return (Item.bShowPath ? Struct.Name + TEXT(" / ") : FString()) + Struct.Members[Item.SubIndex].Name;
+        }
+        case EItemKind::Enums:
+            return TEXT("Enums");
+        case EItemKind::Enum:
+            return Blueprint->Enums.IsValidIndex(Item.Index) ? Blueprint->Enums[Item.Index].Name : FString();
+        case EItemKind::EnumValue:
+        {
+            if (!Blueprint->Enums.IsValidIndex(Item.Index) || !Blueprint->Enums[Item.Index].Values.IsValidIndex(Item.SubIndex))
+            {
+                return FString();
+            }
+            const FN2CEnum& Enum = Blueprint->Enums[Item.Index];
+            return (Item.bShowPath ? Enum.Name + TEXT(" / ") : FString()) + Enum.Values[Item.SubIndex].Name;
+        }
+        case EItemKind::Variables:
+            return TEXT("Variables");
+        case EItemKind::Variable:
+        {
+            const TArray<FN2CVariable>& Variables = Graph ? Graph->LocalVariables : Blueprint->Variables;
+            return Variables.IsValidIndex(Item.Index) ? GraphPath + Variables[Item.Index].Name : FString();
+        }
+        case EItemKind::Components:
+            return TEXT("Components");
+        case EItemKind::Component:
+            return Blueprint->Components.IsValidIndex(Item.Index) ? Blueprint->Components[Item.Index].ComponentName : FString();
+        case EItemKind::ComponentProperty:
+        {
+            if (!Blueprint->Components.IsValidIndex(Item.Index) || !Blueprint->Components[Item.Index].OverriddenProperties.IsValidIndex(Item.SubIndex))
+            {
+                return FString();
+            }
+            const FN2CComponentOverride& Component = Blueprint->Components[Item.Index];
+            return (Item.bShowPath ? Component.ComponentName + TEXT(" / ") : FString()) + Component.OverriddenProperties[Item.SubIndex].Name;
+        }
+        default:
+            return FString();
+    }
+}
+
+FString SN2CBlueprintInspector::GetItemValue(const FItem& Item) const
+{
+    if (!Blueprint.IsValid())
+    {
+        return FString();
+    }
+
+    const FN2CGraph* Graph = Blueprint->Graphs.IsValidIndex(Item.GraphIndex) ? &Blueprint->Graphs[Item.GraphIndex] : nullptr;
+    const FN2CNodeDefinition* Node = Graph && Graph->Nodes.IsValidIndex(Item.Index) ? &Graph->Nodes[Item.Index] : nullptr;
+    const int32 NumChildren = GetNumChildren(Item);
+
+    switch (Item.Kind)
+    {
+        case EItemKind::Graph:
+            return Graph
+                ? FString::Printf(TEXT("%s, %d nodes"), *StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(Graph->GraphType)), Graph->Nodes.Num())
+                : FString();
+        case EItemKind::Node:
+        {
+            if (!Node)
+            {
+                return FString();
+            }
+            FString Value = StaticEnum<EN2CNodeType>()->GetNameStringByValue(static_cast<int64>(Node->NodeType));
+            if (!Node->MemberName.IsEmpty())
+            {
+                Value += FString::Printf(TEXT("  %s::%s"), *Node->GetCleanMemberParent(), *Node->MemberName);
+            }
+            if (Node->bPure)
+            {
+                Value += TEXT("  pure");
+            }
+            if (Node->bLatent)
+            {
+                Value += TEXT("  latent");
+            }
+            return Value;
+        }
+        case EItemKind::Pin:
+        {
+            const FN2CPinDefinition* Pin = Node ? Node->GetPin(Item.SubIndex) : nullptr;
+            if (!Pin)
+            {
+                return FString();
+            }
+            FString Value = FString::Printf(TEXT("%s %s"), Item.SubIndex < Node->InputPins.Num() ? TEXT("in") : TEXT("out"),
+                *StaticEnum<EN2CPinType>()->GetNameStringByValue(static_cast<int64>(Pin->Type)));
+            if (!Pin->SubType.IsEmpty())
+            {
+                Value += FString::Printf(TEXT("<%s>"), *Pin->SubType);
+            }
+            if (Pin->bIsArray || Pin->bIsSet || Pin->bIsMap)
+            {
+                Value += Pin->bIsArray ? TEXT("[]") : Pin->bIsSet ? TEXT(" set") : TEXT(" map");
+            }
+            if (Pin->bIsReference)
+            {
+                Value += Pin->bIsConst ? TEXT(" const&") : TEXT("&");
+            }
+            if (!Pin->DefaultValue.IsEmpty())
+            {
+                Value += TEXT(" = ") + Pin->DefaultValue;
+            }
+            if (Pin->bConnected)
+            {
+                Value += TEXT("  connected");
+            }
+            return Value;
+        }
+        case EItemKind::Flows:
+            return Graph ? FString::Printf(TEXT("%d execution, %d data"), Graph->Flows.NumExecutionChains(), Graph->Flows.Data.Num()) : FString();
+        case EItemKind::ExecutionChain:
+        {
+            FString Chain;
+            if (Graph && Item.Index < Graph->Flows.NumExecutionChains())
+            {
+                Graph->AppendExecutionChain(Chain, Item.Index);
+            }
+            return Chain.Len() > MaxChainTextLength ? Chain.Left(MaxChainTextLength) + TEXT("...") : Chain;
+        }
+        case EItemKind::DataFlow:
+        {
+            const FN2CDataFlow* Flow = Graph && Graph->Flows.Data.IsValidIndex(Item.Index) ? &Graph->Flows.Data[Item.Index] : nullptr;
+            const FN2CPinDefinition* SourcePin = Flow && Graph->Nodes.IsValidIndex(Flow->SourceNode) ? Graph->Nodes[Flow->SourceNode].GetPin(Flow->SourcePin) : nullptr;
+            const FN2CPinDefinition* TargetPin = Flow && Graph->Nodes.IsValidIndex(Flow->TargetNode) ? Graph->Nodes[Flow->TargetNode].GetPin(Flow->TargetPin) : nullptr;
+            return SourcePin && TargetPin ? FString::Printf(TEXT("%s -> %s"), *SourcePin->Name, *TargetPin->Name) : FString();
+        }
+        case EItemKind::StructMember:
+        {
+            if (!Blueprint->Structs.IsValidIndex(Item.Index) || !Blueprint->Structs[Item.Index].Members.IsValidIndex(Item.SubIndex))
+            {
+                return FString();
+            }
+            const FN2CStructMember& Member = Blueprint->Structs[Item.Index].Members[Item.SubIndex];
+            FString Value = GetMemberTypeText(Member.Type, Member.TypeName, Member.bIsArray, Member.bIsSet, Member.bIsMap);
+            if (!Member.DefaultValue.IsEmpty())
+            {
+                Value += TEXT(" = ") + Member.DefaultValue;
+            }
+            return Value;
+        }
+        case EItemKind::EnumValue:
+        {
+            const bool bValid = Blueprint->Enums.IsValidIndex(Item.Index) && Blueprint->Enums[Item.Index].Values.IsValidIndex(Item.SubIndex);
+            return bValid ? Blueprint->Enums[Item.Index].Values[Item.SubIndex].Comment : FString();
+        }
+        case EItemKind::Variable:
+        {
+            const TArray<FN2CVariable>& Variables = Graph ? Graph->LocalVariables : Blueprint->Variables;
+            return Variables.IsValidIndex(Item.Index) ? GetVariableText(Variables[Item.Index]) : FString();
+        }
+        case EItemKind::Component:
+        {
+            if (!Blueprint->Components.IsValidIndex(Item.Index))
+            {
+                return FString();
+            }
+            const FN2CComponentOverride& Component = Blueprint->Components[Item.Index];
+            return Component.AttachParentName.IsEmpty()
+                ? Component.ComponentClassName
+                : FString::Printf(TEXT("%s, attached to %s"), *Component.ComponentClassName, *Component.AttachParentName);
+        }
+        case EItemKind::ComponentProperty:
+        {
+            const bool bValid = Blueprint->Components.IsValidIndex(Item.Index)
+                && Blueprint->Components[Item.Index].OverriddenProperties.IsValidIndex(Item.SubIndex);
+            return bValid ? GetVariableText(Blueprint->Components[Item.Index].OverriddenProperties[Item.SubIndex]) : FString();
+        }
+        case EItemKind::Placeholder:
+            return FString();
+        default:
+            return FString::FromInt(NumChildren);
+    }
+}
+
+void SN2CBlueprintInspector::RefreshRoots()
+{
+    Roots.Reset();
+    bSearchTruncated = false;
+
+    if (Blueprint.IsValid() && SearchText.IsEmpty())
+    {
+        Roots.Add(MakeItem(EItemKind::Graphs));
+        const TPair<EItemKind, int32> Sections[] = {
+            { EItemKind::Structs, Blueprint->Structs.Num() },
+            { EItemKind::Enums, Blueprint->Enums.Num() },
+            { EItemKind::Variables, Blueprint->Variables.Num() },
+            { EItemKind::Components, Blueprint->Components.Num() }
+        };
+        for (const TPair<EItemKind, int32>& Section : Sections)
+        {
+            if (Section.Value > 0)
+            {
+                Roots.Add(MakeItem(Section.Key));
+            }
+        }
+
+        // A single graph is what a graph inspected from the editor holds; open it straight away
+        if (Blueprint->Graphs.Num() == 1 && TreeView.IsValid())
+        {
+            TreeView->SetItemExpansion(Roots[0], true);
+        }
+    }
+    else if (Blueprint.IsValid())
+    {
+        const auto AddMatch = [this](EItemKind Kind, int32 GraphIndex, int32 Index = INDEX_NONE, int32 SubIndex = INDEX_NONE)
+        {
+            if (Roots.Num() >= MaxSearchResults)
+            {
+                bSearchTruncated = true;
+                return false;
+            }
+            FItemPtr Item = MakeItem(Kind, GraphIndex, Index, SubIndex);
+            Item->bShowPath = true;
+            Roots.Add(MoveTemp(Item));
+            return true;
+        };
+
+        // Walks the data rather than items, so nothing is created for what does not match
+        for (int32 GraphIndex = 0; GraphIndex < Blueprint->Graphs.Num() && !bSearchTruncated; ++GraphIndex)
+        {
+            const FN2CGraph& Graph = Blueprint->Graphs[GraphIndex];
+            if (Matches(Graph.Name, SearchText))
+            {
+                AddMatch(EItemKind::Graph, GraphIndex);
+            }
+            for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num() && !bSearchTruncated; ++NodeIndex)
+            {
+                const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+                if (Matches(Node.ID, SearchText) || Matches(Node.Name, SearchText) || Matches(Node.MemberName, SearchText)
+                    || Matches(Node.MemberParent, SearchText) || Matches(Node.Comment, SearchText))
+                {
+                    AddMatch(EItemKind::Node, GraphIndex, NodeIndex);
+                }
+                for (int32 PinIndex = 0; PinIndex < Node.NumPins() && !bSearchTruncated; ++PinIndex)
+                {
+                    const FN2CPinDefinition& Pin = *Node.GetPin(PinIndex);
+                    if (Matches(Pin.Name, SearchText) || Matches(Pin.SubType, SearchText) || Matches(Pin.DefaultValue, SearchText))
+                    {
+                        AddMatch(EItemKind::Pin, GraphIndex, NodeIndex, PinIndex);
+                    }
+                }
+            }
+            for (int32 VariableIndex = 0; VariableIndex < Graph.LocalVariables.Num() && !bSearchTruncated; ++VariableIndex)
+            {
+                if (Matches(Graph.LocalVariables[VariableIndex].Name, SearchText))
+                {
+                    AddMatch(EItemKind::Variable, GraphIndex, VariableIndex);
+                }
+            }
+        }
+
+        for (int32 StructIndex = 0; StructIndex < Blueprint->Structs.Num() && !bSearchTruncated; ++StructIndex)
+        {
+            const FN2CStruct& Struct = Blueprint->Structs[StructIndex];
+            if (Matches(Struct.Name, SearchText))
+            {
+                AddMatch(EItemKind::Struct, INDEX_NONE, StructIndex);
+            }
+            for (int32 MemberIndex = 0; MemberIndex < Struct.Members.Num() && !bSearchTruncated; ++MemberIndex)
+            {
+                if (Matches(Struct.Members[MemberIndex].Name, SearchText))
+                {
+                    AddMatch(EItemKind::StructMember, INDEX_NONE, StructIndex, MemberIndex);
+                }
+            }
+        }
+        for (int32 EnumIndex = 0; EnumIndex < Blueprint->Enums.Num() && !bSearchTruncated; ++EnumIndex)
+        {
+            const FN2CEnum& Enum = Blueprint->Enums[EnumIndex];
+            if (Matches(Enum.Name, SearchText))
+            {
+                AddMatch(EItemKind::Enum, INDEX_NONE, EnumIndex);
+            }
+            for (int32 ValueIndex = 0; ValueIndex < Enum.Values.Num() && !bSearchTruncated; ++ValueIndex)
+            {
+                if (Matches(Enum.Values[ValueIndex].Name, SearchText))
+                {
+                    AddMatch(EItemKind::EnumValue, INDEX_NONE, EnumIndex, ValueIndex);
+                }
+            }
+        }
+        for (int32 VariableIndex = 0; VariableIndex < Blueprint->Variables.Num() && !bSearchTruncated; ++VariableIndex)
+        {
+            if (Matches(Blueprint->Variables[VariableIndex].Name, SearchText))
+            {
+                AddMatch(EItemKind::Variable, INDEX_NONE, VariableIndex);
+            }
+        }
+        for (int32 ComponentIndex = 0; ComponentIndex < Blueprint->Components.Num() && !bSearchTruncated; ++ComponentIndex)
+        {
+            const FN2CComponentOverride& Component = Blueprint->Components[ComponentIndex];
+            if (Matches(Component.ComponentName, SearchText) || Matches(Component.ComponentClassName, SearchText))
+            {
+                AddMatch(EItemKind::Component, INDEX_NONE, ComponentIndex);
+            }
+        }
+    }
+
+    if (TreeView.IsValid())
+    {
+        TreeView->RequestTreeRefresh();
+    }
+}
+
+void SN2CBlueprintInspector::OnSearchTextChanged(const FText& InText)
+{
+    const FString NewSearchText = InText.ToString().TrimStartAndEnd();
+    if (NewSearchText != SearchText)
+    {
+        SearchText = NewSearchText;
+        RefreshRoots();
+    }
+}
+
+FReply SN2CBlueprintInspector::OnOpenClicked()
+{
+    IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+    if (!DesktopPlatform)
+    {
+        return FReply::Handled();
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FString DefaultPath = Settings && !Settings->CustomTranslationOutputDirectory.Path.IsEmpty()
+        ? Settings->CustomTranslationOutputDirectory.Path
+        : FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Translations");
+    const FString FileTypes = FString::Printf(TEXT("Blueprint Data (*.json;*%s)|*.json;*%s"),
+        FN2CSnapshot::GetFileExtension(), FN2CSnapshot::GetFileExtension());
+
+    TArray<FString> FilePaths;
+    if (!DesktopPlatform->OpenFileDialog(FSlateApplication::Get().FindBestParentWindowHandleForDialogs(AsShared()),
+        TEXT("Inspect Blueprint Data"), DefaultPath, FString(), FileTypes, EFileDialogFlags::None, FilePaths) || FilePaths.Num() == 0)
+    {
+        return FReply::Handled();
+    }
+
+    // Parsing a dump of tens of megabytes would hitch the editor, so it is loaded on a worker
+    const FString FilePath = FilePaths[0];
+    TWeakPtr<SN2CBlueprintInspector> WeakThis = SharedThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, FilePath]()
+    {
+        TSharedRef<FN2CBlueprint> Loaded = MakeShared<FN2CBlueprint>();
+        bool bLoaded = false;
+        if (FilePath.EndsWith(FN2CSnapshot::GetFileExtension()))
+        {
+            bLoaded = FN2CSnapshot::LoadFromFile(FilePath, *Loaded);
+        }
+        else
+        {
+            FString Json;
+            bLoaded = FFileHelper::LoadFileToString(Json, *FilePath) && FN2CSerializer::FromJson(Json, *Loaded);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, FilePath, Loaded, bLoaded]()
+        {
+            if (!bLoaded)
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to load Blueprint data to inspect: %s"), *FilePath), TEXT("BlueprintInspector"));
+                return;
+            }
+            if (const TSharedPtr<SN2CBlueprintInspector> Inspector = WeakThis.Pin())
+            {
+                Inspector->SetBlueprint(Loaded, FPaths::GetCleanFilename(FilePath));
+            }
+        });
+    });
+    return FReply::Handled();
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CDependencyPreloader.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Same test the translator applies before following a reference */
+    bool IsUserPackage(const FName PackageName)
+    {
+        const FString Name = PackageName.ToString();
+        return Name.StartsWith(TEXT("/Game/")) || Name.Contains(TEXT("/Content/"));
+    }
+}
+
+void FN2CDependencyPreloader::FindUnloadedDependencies(const UBlueprint* Blueprint, int32 Depth, TArray<FName>& OutPackages)
+{
+    OutPackages.Reset();
+    if (!Blueprint || Depth <= 0)
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+    // Breadth first, one level per translation depth; loaded packages are walked too, since what they call may not be
+    TSet<FName> Visited;
+    TArray<FName> Level;
+    Level.Add(Blueprint->GetOutermost()->GetFName());
+    Visited.Add(Level[0]);
+
+    TArray<FName> Dependencies;
+    TArray<FAssetData> Assets;
+    for (int32 LevelIndex = 0; LevelIndex < Depth && Level.Num() > 0; ++LevelIndex)
+    {
+        TArray<FName> NextLevel;
+        for (const FName PackageName : Level)
+        {
+            Dependencies.Reset();
+            AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+            for (const FName Dependency : Dependencies)
+            {
+                bool bAlreadyVisited = false;
+                Visited.Add(Dependency, &bAlreadyVisited);
+                if (bAlreadyVisited || !IsUserPackage(Dependency))
+                {
+                    continue;
+                }
+
+                // Only Blueprints hold graphs the translation can follow
+                Assets.Reset();
+                AssetRegistry.GetAssetsByPackageName(Dependency, Assets);
+                const bool bHasBlueprint = Assets.ContainsByPredicate([](const FAssetData& Asset)
+                {
+                    const UClass* AssetClass = Asset.GetClass();
+                    return AssetClass && AssetClass->IsChildOf<UBlueprint>();
+                });
+                if (!bHasBlueprint)
+                {
+                    continue;
+                }
+
+                NextLevel.Add(Dependency);
+                if (!FindPackage(nullptr, *Dependency.ToString()))
+                {
+                    OutPackages.Add(Dependency);
+                }
+            }
+        }
+        Level = MoveTemp(NextLevel);
+    }
+}
+
+void FN2CDependencyPreloader::Preload(const UBlueprint* Blueprint, int32 Depth, TFunction<void()> OnLoaded)
+{
+    TArray<FName> Packages;
+    FindUnloadedDependencies(Blueprint, Depth, Packages);
+    if (Packages.Num() == 0)
+    {
+        OnLoaded();
+        return;
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Preloading %d Blueprint packages %s depends on"), Packages.Num(), *Blueprint->GetName()),
+        EN2CLogSeverity::Info, TEXT("DependencyPreloader"));
+
+    // Shared by the load callbacks, the last of which continues
+    struct FPreloadState
+    {
+        int32 Remaining = 0;
+        TFunction<void()> OnLoaded;
+    };
+    TSharedRef<FPreloadState> State = MakeShared<FPreloadState>();
+    State->Remaining = Packages.Num();
+    State->OnLoaded = MoveTemp(OnLoaded);
+
+    for (const FName PackageName : Packages)
+    {
+        LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+            [State](const FName& LoadedName, UPackage* Package, EAsyncLoadingResult::Type Result)
+            {
+                if (Result != EAsyncLoadingResult::Succeeded)
+                {
+                    FN2CLogger::Get().LogWarning(
+                        FString::Printf(TEXT("Failed to preload %s, extraction will load it if it needs it"), *LoadedName.ToString()),
+                        TEXT("DependencyPreloader"));
+                }
+
+                if (--State->Remaining == 0)
+                {
+                    State->OnLoaded();
+                }
+            }));
+    }
+}
@@ -2,18 +2,33 @@
 
 #include "Core/N2CEditorIntegration.h"
 
+#include "Algo/Accumulate.h"
+#include "Algo/StableSort.h"
+#include "Async/Async.h"
 #include "BlueprintEditorModes.h"
 #include "Core/N2CNodeCollector.h"
+#include "BlueprintEditorContext.h"
 #include "BlueprintEditorModule.h"
 #include "Code Editor/Models/N2CCodeLanguage.h"
+#include "Core/N2CBlueprintInspector.h"
 #include "Core/N2CEditorWindow.h"
+#include "Core/N2CDependencyPreloader.h"
+#include "Core/N2CLiveGraphModel.h"
+#include "Core/N2CLocalTranslator.h"
 #include "Core/N2CNodeTranslator.h"
 #include "Core/N2CSerializer.h"
 #include "Core/N2CSettings.h"
+#include "Core/N2CSnapshot.h"
 #include "Core/N2CToolbarCommand.h"
 #include "LLM/N2CLLMModule.h"
 #include "LLM/N2CLLMTypes.h"
+#include "LLM/N2CTokenEstimator.h"
+#include "LLM/N2CTranslationOutputWriter.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Misc/SecureHash.h"
+#include "Tasks/Task.h"
+#include "ToolMenus.h"
+#include "Utils/N2CStats.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 #if PLATFORM_WINDOWS
@@ -24,6 +39,156 @@
 #include "Mac/MacPlatformApplicationMisc.h"
 #endif
 
+/** Requests and bookkeeping for one Translate Entire Blueprint run, built on a worker and dispatched on the game thread */
+struct FN2CEditorIntegration::FBatchTranslationOptions
+{
+    /** Estimated input tokens small graphs are packed up to (0 = one request per graph) */
+    int32 PackTokenBudget = 0;
+
+    EN2CJsonDialect Dialect = EN2CJsonDialect::Standard;
+
+    /** Provider whose tokenizer the estimates are made for */
+    EN2CLLMProvider Provider = EN2CLLMProvider::Anthropic;
+
+    /** Input tokens the JSON of a single request may use under the model's context window (0 = unknown) */
+    int32 InputBudget = 0;
+
+    /** Give each request only the shared context its graphs reference (see FN2CGraph::ReferencedNames) */
+    bool bPruneContext = false;
+
+    /** Send graphs that changed a little since the previous batch as deltas (see FN2CGraphDelta) */
+    bool bDeltaTranslation = false;
+
+    /** Largest FN2CGraphDelta::GetChangedFraction sent as a delta */
+    float MaxDeltaFraction = 0.0f;
+
+    /** Send requests after the ones translating the graphs they call, with those graphs' declarations */
+    bool bOrderByCalls = false;
+
+    /** Most nodes a function graph may have to be translated without a request (0 = always send it; see FN2CLocalTranslator) */
+    int32 MaxLocalTranslationNodes = 0;
+
+    /** Language the batch is translated to */
+    EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+
+    /** Send each request as soon as it is serialized, when nothing needs the whole plan first */
+    bool bStreamRequests = false;
+};
+
+struct FN2CEditorIntegration::FBatchTranslationPlan
+{
+    /** One request to send, with the graphs packed into it */
+    struct FPendingRequest
+    {
+        FString Json;
+        TArray<FString> GraphNames;
+
+        /** FN2CTokenEstimator count for Json */
+        int32 EstimatedTokens = 0;
+
+        /** FN2CGraphComplexity score of its graphs together, which with EstimatedTokens predicts its duration */
+        float ComplexityScore = 0.0f;
+
+        /** Requests for the parts of a graph too large for one request, stitched back together on response */
+        TArray<FString> PartJsons;
+        TArray<int32> PartEstimatedTokens;
+
+        /** Function and macro graphs of the Blueprint these graphs call, whose declarations are sent with them */
+        TArray<FString> CalleeGraphs;
+
+        /** Requests translating some of CalleeGraphs, which complete before this one is sent */
+        TArray<int32> Dependencies;
+    };
+
+    FString BlueprintName;
+
+    /** Translation session of the batch, shared by all of its requests */
+    TSharedPtr<const FN2CTranslationSession> Session;
+
+    /** Root of the previous batch that unchanged graphs are carried forward from */
+    FString PreviousRootPath;
+
+    /** Number of graphs in the Blueprint, including ones that failed serialization */
+    int32 TotalGraphs = 0;
+
+    TArray<FPendingRequest> PendingRequests;
+
+    /** Fingerprint of every serialized graph, keyed by graph name */
+    TMap<FString, FString> GraphFingerprints;
+
+    /** Graphs whose fingerprint matches the previous batch */
+    TMap<FString, FString> UnchangedGraphs;
+
+    TArray<FString> SerializationFailedGraphs;
+
+    /** Graphs translated without a request, delivered when the batch is dispatched */
+    TArray<FN2CGraphTranslation> LocalTranslations;
+
+    /** Declarations of unchanged callee graphs, read from the code the previous batch saved for them */
+    TMap<FString, FString> CarriedCalleeDeclarations;
+
+    /** False if validation or shared context serialization failed */
+    bool bValid = false;
+
+    /** If set, each request is handed to it on the worker as soon as it is built, instead of kept in PendingRequests */
+    TFunction<void(FPendingRequest&&)> OnRequestReady;
+};
+
+/** Progress of a dispatched batch, shared by the callbacks of its requests */
+struct FN2CEditorIntegration::FBatchDispatch
+{
+    /** Set once the plan is complete, which for a streamed batch is after its first requests went out */
+    TSharedPtr<const FBatchTranslationPlan> Plan;
+
+    TSharedPtr<const FN2CTranslationSession> Session;
+
+    /** Requests dispatched so far; their JSON is released once handed to the LLM module */
+    TArray<FBatchTranslationPlan::FPendingRequest> Requests;
+
+    /** Fingerprint of each graph of Requests, keyed by graph name */
+    TMap<FString, FString> GraphFingerprints;
+
+    /** Set while a streamed plan is still being built, so the batch does not end between its requests */
+    bool bPlanning = false;
+
+    /** Dependencies each request still waits on, and the requests that wait on each */
+    TArray<int32> WaitingOn;
+    TArray<TArray<int32>> Dependents;
+
+    /** Generated declaration of every callee translated so far, by graph name */
+    TMap<FString, FString> CalleeDeclarations;
+
+    /** Predicts how long each request takes, so the longest are sent first */
+    FN2CLatencyModel LatencyModel;
+
+    /** Requests expected to take at least this long are routed to the fastest provider (0 = none are) */
+    double LargeRequestSeconds = 0.0;
+
+    int32 RemainingResponses = 0;
+    TArray<FString> SuccessfulGraphs;
+    TArray<FString> FailedGraphs;
+
+    /** Set by CancelTranslation, so requests still waiting fail instead of being sent */
+    bool bCancelled = false;
+
+    /** Memory used over the batch, sampled at each response */
+    FN2CPeakMemory PeakMemory;
+};
+
+namespace
+{
+    /** Hash of a Blueprint's binary snapshot, which is far cheaper to produce than its JSON */
+    FString ComputeBlueprintFingerprint(const FN2CBlueprint& Blueprint)
+    {
+        TArray<uint8> Bytes;
+        FN2CSnapshot::SaveToMemory(Blueprint, Bytes);
+
+        uint8 Digest[FSHA1::DigestSize];
+        FSHA1::HashBuffer(Bytes.GetData(), Bytes.Num(), Digest);
+        return BytesToHex(Digest, FSHA1::DigestSize);
+    }
+}
+
 FN2CEditorIntegration& FN2CEditorIntegration::Get()
 {
     static FN2CEditorIntegration Instance;
@@ -34,7 +199,7 @@ void FN2CEditorIntegration::ExecuteTranslateEntireBlueprintForEditor(TWeakPtr<FB
 {
     // Check if translation is already in progress
     UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
-    if (LLMModule && LLMModule->GetSystemStatus() == EN2CSystemStatus::Processing)
+    if (bPreparingTranslation || (LLMModule && LLMModule->GetSystemStatus() == EN2CSystemStatus::Processing))
     {
         FN2CLogger::Get().LogWarning(TEXT("Translation already in progress, please wait"));
         return;
@@ -82,43 +247,466 @@ void FN2CEditorIntegration::ExecuteTranslateEntireBlueprintForEditor(TWeakPtr<FB
         return;
     }
 
-    // Begin batch translation - all graphs in this Blueprint will share the same root directory
-    LLMModule->BeginBatchTranslation(BlueprintName);
+    // Deep translations follow calls into other Blueprints, so those are streamed in first rather than loaded
+    // one at a time in the middle of extraction
+    const int32 TranslationDepth = Settings ? Settings->TranslationDepth : 0;
+    if (TranslationDepth > 0)
+    {
+        bPreparingTranslation = true;
+        bCancelPreparedTranslation = false;
+        FN2CDependencyPreloader::Preload(OwnerBP, TranslationDepth, [this, WeakBlueprint = TWeakObjectPtr<UBlueprint>(OwnerBP), bIncludeVariables]()
+        {
+            bPreparingTranslation = false;
+            UBlueprint* Blueprint = WeakBlueprint.Get();
+            if (bCancelPreparedTranslation || !Blueprint)
+            {
+                FN2CLogger::Get().Log(TEXT("Translate Entire Blueprint cancelled while loading its dependencies"), EN2CLogSeverity::Info);
+                return;
+            }
+            ExtractAndTranslateBlueprint(Blueprint, bIncludeVariables);
+        });
+        return;
+    }
+
+    ExtractAndTranslateBlueprint(OwnerBP, bIncludeVariables);
+}
+
+void FN2CEditorIntegration::ExtractAndTranslateBlueprint(UBlueprint* OwnerBP, bool bIncludeVariables)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FString BlueprintName = OwnerBP->GetName();
 
     // Use a single Blueprint-wide translation to build the full FN2CBlueprint,
     // which already contains all graphs (including the synthetic ClassItSelf),
     // then emit one JSON per graph by slicing the Graphs array.
     FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
 
+    // Extracting a huge Blueprint at once would freeze the editor for seconds, so it is spread over frames
+    TArray<UEdGraph*> AllGraphs;
+    OwnerBP->GetAllGraphs(AllGraphs);
+    int32 NodeCount = 0;
+    for (const UEdGraph* Graph : AllGraphs)
+    {
+        NodeCount += Graph ? Graph->Nodes.Num() : 0;
+    }
+
+    if (Settings && Settings->SlicedExtractionNodeThreshold > 0 && NodeCount >= Settings->SlicedExtractionNodeThreshold
+        && Translator.BeginSlicedExtraction(OwnerBP, bIncludeVariables))
+    {
+        FNotificationInfo Info(FText::Format(NSLOCTEXT("NodeToCode", "BlueprintExtracting", "Extracting {0}..."), FText::FromString(BlueprintName)));
+        Info.bFireAndForget = false;
+        Info.FadeInDuration = 0.2f;
+        Info.FadeOutDuration = 0.5f;
+        Info.ExpireDuration = 2.0f;
+        Info.bUseThrobber = true;
+        Info.bUseSuccessFailIcons = true;
+        SlicedExtractionNotification = FSlateNotificationManager::Get().AddNotification(Info);
+        if (SlicedExtractionNotification.IsValid())
+        {
+            SlicedExtractionNotification->SetCompletionState(SNotificationItem::CS_Pending);
+        }
+
+        SlicedBlueprintName = BlueprintName;
+        bPreparingTranslation = true;
+        bCancelPreparedTranslation = false;
+        SlicedExtractionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FN2CEditorIntegration::TickSlicedExtraction));
+        return;
+    }
+
     if (!Translator.GenerateFromBlueprint(OwnerBP, bIncludeVariables))
     {
         FN2CLogger::Get().LogError(TEXT("Failed to generate Blueprint-wide translation for Translate Entire Blueprint"));
-        // End batch translation on error
-        if (LLMModule)
+        return;
+    }
+
+    // Take the extracted Blueprint so the worker never reads translator state the game thread may reuse,
+    // and the batch holds the only copy
+    TranslateExtractedBlueprint(BlueprintName, MakeShared<FN2CBlueprint>(Translator.TakeN2CBlueprint()));
+}
+
+bool FN2CEditorIntegration::TickSlicedExtraction(float DeltaTime)
+{
+    FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+
+    bool bFinished = bCancelPreparedTranslation;
+    bool bSucceeded = false;
+    if (!bFinished)
+    {
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        const double BudgetSeconds = (Settings ? Settings->SlicedExtractionBudgetMs : 8.0f) / 1000.0;
+        bFinished = Translator.StepSlicedExtraction(BudgetSeconds, bSucceeded);
+    }
+
+    if (!bFinished)
+    {
+        if (SlicedExtractionNotification.IsValid())
         {
-            LLMModule->EndBatchTranslation();
+            SlicedExtractionNotification->SetText(FText::Format(
+                NSLOCTEXT("NodeToCode", "BlueprintExtractingProgress", "Extracting {0}... {1}"),
+                FText::FromString(SlicedBlueprintName), FText::AsPercent(Translator.GetSlicedExtractionProgress())));
         }
-        return;
+        return true;
+    }
+
+    SlicedExtractionTickerHandle.Reset();
+    bPreparingTranslation = false;
+
+    const bool bCancelled = bCancelPreparedTranslation;
+    if (bCancelled)
+    {
+        Translator.CancelSlicedExtraction();
+        FN2CLogger::Get().Log(TEXT("Translate Entire Blueprint cancelled during extraction"), EN2CLogSeverity::Info);
+    }
+    else if (!bSucceeded)
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to generate Blueprint-wide translation for Translate Entire Blueprint"));
+    }
+
+    if (SlicedExtractionNotification.IsValid())
+    {
+        SlicedExtractionNotification->SetText(FText::Format(bSucceeded && !bCancelled
+            ? NSLOCTEXT("NodeToCode", "BlueprintExtracted", "Extracted {0}")
+            : NSLOCTEXT("NodeToCode", "BlueprintExtractFailed", "Extraction of {0} stopped"), FText::FromString(SlicedBlueprintName)));
+        SlicedExtractionNotification->SetCompletionState(bSucceeded && !bCancelled ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+        SlicedExtractionNotification->ExpireAndFadeout();
+        SlicedExtractionNotification.Reset();
+    }
+
+    if (bSucceeded && !bCancelled)
+    {
+        TranslateExtractedBlueprint(SlicedBlueprintName, MakeShared<FN2CBlueprint>(Translator.TakeN2CBlueprint()));
+    }
+    return false;
+}
+
+void FN2CEditorIntegration::TranslateExtractedBlueprint(const FString& BlueprintName, const TSharedRef<FN2CBlueprint>& FullBlueprint)
+{
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+
+    // Begin batch translation - all graphs in this Blueprint will share the same root directory,
+    // which gets the Blueprint JSON once rather than with every response
+    LLMModule->BeginBatchTranslation(BlueprintName, &FullBlueprint.Get());
+    const TSharedRef<FN2CTranslationSession> Session = LLMModule->CreateSession(nullptr);
+    Session->Priority = EN2CRequestPriority::Batch;
+
+    // Resume an interrupted run, or compare graph fingerprints with the last successful one, so graphs
+    // that already have up-to-date output are skipped
+    TMap<FString, FString> PreviousFingerprints;
+    FString PreviousRootPath;
+    const bool bResuming = LLMModule->FindInterruptedBatch(BlueprintName, PreviousFingerprints, PreviousRootPath);
+    if (bResuming)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Resuming interrupted translation of %s: %d graphs were already completed in %s"),
+                *BlueprintName, PreviousFingerprints.Num(), *PreviousRootPath),
+            EN2CLogSeverity::Info);
+    }
+    const bool bIncremental = bResuming || (Settings && Settings->bOnlyTranslateChangedGraphs
+        && LLMModule->FindPreviousBatchFingerprints(BlueprintName, PreviousFingerprints, PreviousRootPath));
+
+    // Small graphs are packed together so they share one copy of the system prompt and context
+    FBatchTranslationOptions Options;
+    if (Settings)
+    {
+        Options.PackTokenBudget = Settings->MaxPackedRequestTokens;
+        Options.Dialect = Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+        Options.Provider = Settings->Provider;
+        Options.bPruneContext = Settings->bPruneGraphContext;
+
+        // An interrupted batch has no code yet for the graphs it did not finish
+        Options.bDeltaTranslation = Settings->bUseDeltaTranslation && !bResuming;
+        Options.MaxDeltaFraction = Settings->MaxDeltaTranslationFraction;
+        Options.bOrderByCalls = Settings->bOrderGraphsByCalls;
+
+        // Requests go out in the main target language only
+        Options.Language = Settings->TargetLanguage;
+        Options.MaxLocalTranslationNodes = Settings->bTranslateTrivialGraphsLocally && FN2CLocalTranslator::SupportsLanguage(Options.Language)
+            ? Settings->MaxLocalTranslationNodes : 0;
+
+        // The system prompt and reference files share the window with the graph JSON
+        const int32 ContextWindow = FN2CTokenEstimator::GetContextWindow(*Settings);
+        Options.InputBudget = ContextWindow > 0
+            ? FMath::Max(0, FN2CTokenEstimator::GetInputBudget(ContextWindow) - Settings->EstimatedReferenceTokens
+                - LLMModule->EstimateSystemPromptTokens(Options.Dialect == EN2CJsonDialect::Compact))
+            : 0;
     }
 
-    const FN2CBlueprint& FullBlueprint = Translator.GetN2CBlueprint();
+    // Only call ordering and routing by relative size need every request before the first is sent. Otherwise
+    // each goes out as soon as it is serialized, and the scheduler's queue still puts the longest first
+    Options.bStreamRequests = Settings && !Options.bOrderByCalls && !(Settings->bRouteAcrossProviders && Settings->bRouteLargestToFastestProvider);
+    TSharedPtr<FBatchDispatch> StreamedDispatch;
+    if (Options.bStreamRequests)
+    {
+        StreamedDispatch = MakeShared<FBatchDispatch>();
+        StreamedDispatch->Session = Session;
+        StreamedDispatch->LatencyModel = LLMModule->GetLatencyModel();
+        StreamedDispatch->bPlanning = true;
+        StreamedDispatch->PeakMemory.Reset();
+        ActiveBatchDispatch = StreamedDispatch;
+    }
+
+    // Validation, fingerprinting and serialization only read the copied FN2CBlueprint, so they run
+    // on a worker and the editor stays responsive on large Blueprints
+    bPreparingTranslation = true;
+    bCancelPreparedTranslation = false;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [this, FullBlueprint, BlueprintName, Session, PreviousRootPath, PreviousFingerprints = MoveTemp(PreviousFingerprints), bIncremental, Options, StreamedDispatch]()
+        {
+            TSharedRef<FBatchTranslationPlan> Plan = MakeShared<FBatchTranslationPlan>();
+            Plan->BlueprintName = BlueprintName;
+            Plan->Session = Session;
+            Plan->PreviousRootPath = PreviousRootPath;
+            Plan->TotalGraphs = FullBlueprint->Graphs.Num();
+
+            if (StreamedDispatch.IsValid())
+            {
+                const FBatchTranslationPlan* PlanPtr = &Plan.Get();
+                Plan->OnRequestReady = [this, StreamedDispatch, PlanPtr](FBatchTranslationPlan::FPendingRequest&& Request)
+                {
+                    // A request's graphs are fingerprinted before it is built
+                    TMap<FString, FString> Fingerprints;
+                    for (const FString& GraphName : Request.GraphNames)
+                    {
+                        Fingerprints.Add(GraphName, PlanPtr->GraphFingerprints.FindRef(GraphName));
+                    }
+
+                    AsyncTask(ENamedThreads::GameThread, [this, StreamedDispatch, Request = MoveTemp(Request), Fingerprints = MoveTemp(Fingerprints)]() mutable
+                    {
+                        if (UN2CLLMModule* StreamLLMModule = UN2CLLMModule::Get())
+                        {
+                            for (const TPair<FString, FString>& Fingerprint : Fingerprints)
+                            {
+                                StreamLLMModule->RecordGraphQueued(Fingerprint.Key, Fingerprint.Value);
+                            }
+                        }
+                        StreamedDispatch->GraphFingerprints.Append(MoveTemp(Fingerprints));
+                        const int32 RequestIndex = StreamedDispatch->Requests.Add(MoveTemp(Request));
+                        StreamedDispatch->WaitingOn.Add(0);
+                        StreamedDispatch->Dependents.AddDefaulted();
+                        StreamedDispatch->RemainingResponses++;
+                        SendBatchRequest(StreamedDispatch.ToSharedRef(), RequestIndex);
+                    });
+                };
+            }
+
+            // Changed graphs are diffed against the Blueprint the previous batch was started with
+            TUniquePtr<FN2CBlueprint> PreviousBlueprint;
+            if (bIncremental && Options.bDeltaTranslation)
+            {
+                PreviousBlueprint = MakeUnique<FN2CBlueprint>();
+                if (!UN2CLLMModule::LoadBatchSnapshot(PreviousRootPath, *PreviousBlueprint))
+                {
+                    PreviousBlueprint.Reset();
+                }
+            }
+
+            Plan->bValid = BuildBatchTranslationPlan(
+                *FullBlueprint, bIncremental ? &PreviousFingerprints : nullptr, PreviousBlueprint.Get(), Options, *Plan);
+
+            // The callback holds the dispatch, which will hold the plan
+            Plan->OnRequestReady = nullptr;
+
+            // Queued after every streamed request, so it runs once they are all dispatched
+            AsyncTask(ENamedThreads::GameThread, [this, Plan, StreamedDispatch]()
+            {
+                bPreparingTranslation = false;
+                if (bCancelPreparedTranslation)
+                {
+                    // Streamed requests fail as they are cancelled, and the last of them ends the batch
+                    if (StreamedDispatch.IsValid() && StreamedDispatch->Requests.Num() > 0)
+                    {
+                        FN2CLogger::Get().Log(TEXT("Translate Entire Blueprint cancelled before all requests were sent"), EN2CLogSeverity::Info);
+                        StreamedDispatch->Plan = Plan;
+                        StreamedDispatch->bPlanning = false;
+                        if (StreamedDispatch->RemainingResponses <= 0)
+                        {
+                            FinishBatchDispatch(StreamedDispatch.ToSharedRef());
+                        }
+                        return;
+                    }
+
+                    FN2CLogger::Get().Log(TEXT("Translate Entire Blueprint cancelled before any request was sent"), EN2CLogSeverity::Info);
+                    if (UN2CLLMModule* CancelledLLMModule = UN2CLLMModule::Get())
+                    {
+                        CancelledLLMModule->EndBatchTranslation();
+                    }
+                    return;
+                }
+                DispatchBatchTranslation(Plan, StreamedDispatch);
+            });
+        });
+}
+
+bool FN2CEditorIntegration::BuildBatchTranslationPlan(
+    const FN2CBlueprint& FullBlueprint,
+    const TMap<FString, FString>* PreviousFingerprints,
+    const FN2CBlueprint* PreviousBlueprint,
+    const FBatchTranslationOptions& Options,
+    FBatchTranslationPlan& OutPlan)
+{
     if (!FullBlueprint.IsValid())
     {
         FN2CLogger::Get().LogError(TEXT("Blueprint-wide node translation validation failed for Translate Entire Blueprint"));
-        // End batch translation on error
-        if (LLMModule)
+        return false;
+    }
+
+    FN2CLogger::Get().Log(TEXT("Blueprint-wide translation successful for Translate Entire Blueprint"), EN2CLogSeverity::Info);
+
+    // Build the request payloads, keeping them for the plan or handing each over as soon as it is complete
+    TArray<FBatchTranslationPlan::FPendingRequest>& PendingRequests = OutPlan.PendingRequests;
+    const EN2CJsonDialect Dialect = Options.Dialect;
+    const int32 PackTokenBudget = Options.PackTokenBudget;
+
+    TMap<FString, float> GraphScores;
+    for (const FN2CGraph& Graph : FullBlueprint.Graphs)
+    {
+        GraphScores.Add(Graph.Name, Graph.Complexity.GetScore());
+    }
+
+    // Score the last request added, and pass it on if requests are streamed
+    auto CompleteRequest = [&PendingRequests, &GraphScores, &OutPlan]()
+    {
+        FBatchTranslationPlan::FPendingRequest& Request = PendingRequests.Last();
+        for (const FString& GraphName : Request.GraphNames)
         {
-            LLMModule->EndBatchTranslation();
+            Request.ComplexityScore += GraphScores.FindRef(GraphName);
         }
-        return;
+        if (OutPlan.OnRequestReady)
+        {
+            OutPlan.OnRequestReady(PendingRequests.Pop());
+        }
+    };
+
+    // Annotate each request with its estimate and warn about any the model cannot take
+    auto AddRequest = [&PendingRequests, &Options, &CompleteRequest](FString&& Json, TArray<FString>&& GraphNames)
+    {
+        FBatchTranslationPlan::FPendingRequest& Request = PendingRequests.AddDefaulted_GetRef();
+        Request.EstimatedTokens = FN2CTokenEstimator::EstimateTokens(Json, Options.Provider);
+        Request.Json = MoveTemp(Json);
+        Request.GraphNames = MoveTemp(GraphNames);
+
+        if (Options.InputBudget > 0 && Request.EstimatedTokens > Options.InputBudget)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(
+                TEXT("Request for graphs %s is ~%d tokens, over the model's ~%d token input budget"),
+                *FString::Join(Request.GraphNames, TEXT(", ")), Request.EstimatedTokens, Options.InputBudget));
+        }
+        CompleteRequest();
+    };
+
+    // Variables, components, structs and enums are identical for every graph, so render them once,
+    // unless each request gets only the ones its graphs reference
+    FN2CBatchJsonContext BatchContext;
+    if (!FN2CSerializer::BuildBatchContext(FullBlueprint, BatchContext, Dialect))
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to serialize shared Blueprint context for Translate Entire Blueprint"));
+        return false;
     }
 
-    FN2CLogger::Get().Log(TEXT("Blueprint-wide translation successful for Translate Entire Blueprint"), EN2CLogSeverity::Info);
+    // Every graph is fingerprinted together with the shared context it is translated with
+    const FString ContextJson = Options.bPruneContext ? FString() : FN2CSerializer::SharedContextToJson(FullBlueprint, Dialect);
+
+    // Context for a request: the shared one, or just what its graphs reference
+    auto GetRequestContext = [&FullBlueprint, &BatchContext, &Options, Dialect](const TSet<FString>& ReferencedNames)
+    {
+        FN2CBatchJsonContext RequestContext;
+        if (!Options.bPruneContext || !FN2CSerializer::BuildBatchContext(FullBlueprint, RequestContext, Dialect, &ReferencedNames))
+        {
+            return BatchContext;
+        }
+        return RequestContext;
+    };
+
+    // Send a graph that overflows the context window as parts along its exec flow; false if it cannot be split
+    auto AddSplitRequest = [&PendingRequests, &Options, &GetRequestContext, &CompleteRequest, Dialect](const FN2CGraph& Graph)
+    {
+        const FN2CBatchJsonContext GraphContext = GetRequestContext(Graph.ReferencedNames);
+        auto MeasureTokens = [&Options, &GraphContext, Dialect](const FN2CGraph& Part)
+        {
+            return FN2CTokenEstimator::EstimateTokens(
+                FN2CSerializer::ToJsonForGraphs(GraphContext, { FN2CSerializer::GraphToJson(Part, Dialect) }), Options.Provider);
+        };
+
+        TArray<FN2CGraph> Parts;
+        FN2CNodeTranslator::PartitionGraph(Graph, Options.InputBudget, MeasureTokens, Parts);
+        if (Parts.Num() < 2)
+        {
+            return false;
+        }
+
+        FBatchTranslationPlan::FPendingRequest& Request = PendingRequests.AddDefaulted_GetRef();
+        Request.GraphNames = { Graph.Name };
+        for (const FN2CGraph& Part : Parts)
+        {
+            FString PartJson = FN2CSerializer::ToJsonForGraphs(GraphContext, { FN2CSerializer::GraphToJson(Part, Dialect) });
+            const int32 PartTokens = FN2CTokenEstimator::EstimateTokens(PartJson, Options.Provider);
+            Request.EstimatedTokens += PartTokens;
+            Request.PartEstimatedTokens.Add(PartTokens);
+            Request.PartJsons.Add(MoveTemp(PartJson));
+        }
+
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Graph %s exceeds the ~%d token input budget, splitting it into %d requests"),
+                *Graph.Name, Options.InputBudget, Parts.Num()),
+            EN2CLogSeverity::Info);
+        CompleteRequest();
+        return true;
+    };
+
+    // Send a changed graph as its delta against the previous batch and the code saved there, if that is smaller
+    int32 NumDeltaRequests = 0;
+    auto AddDeltaRequest = [&AddRequest, &FullBlueprint, PreviousBlueprint, &OutPlan, &Options, &NumDeltaRequests](const FN2CGraph& Graph, int32 GraphTokens)
+    {
+        const FN2CGraph* PreviousGraph = PreviousBlueprint->Graphs.FindByPredicate(
+            [&Graph](const FN2CGraph& Candidate) { return Candidate.Name == Graph.Name; });
+        if (!PreviousGraph)
+        {
+            return false;
+        }
+
+        // A graph whose nodes are unchanged changed through the shared context, which only a full translation picks up
+        const FN2CGraphDelta Delta = FN2CGraphDelta::Compute(*PreviousGraph, Graph);
+        if (Delta.IsEmpty() || Delta.GetChangedFraction() > Options.MaxDeltaFraction)
+        {
+            return false;
+        }
+
+        FN2CGeneratedCode PreviousCode;
+        if (!UN2CLLMModule::LoadBatchGraphCode(OutPlan.PreviousRootPath, Graph.Name, PreviousCode))
+        {
+            return false;
+        }
+
+        // The previous code travels with the delta, so a delta can be larger than the graph itself
+        FString DeltaJson = FN2CSerializer::GraphDeltaToJson(FullBlueprint.Metadata, *PreviousGraph, Graph, Delta, PreviousCode);
+        if (DeltaJson.IsEmpty() || FN2CTokenEstimator::EstimateTokens(DeltaJson, Options.Provider) >= GraphTokens)
+        {
+            return false;
+        }
+
+        AddRequest(MoveTemp(DeltaJson), { Graph.Name });
+        NumDeltaRequests++;
+        return true;
+    };
 
-    // First pass: build per-graph JSON payloads so we know how many requests
-    // will be sent for this Blueprint (used for batch completion logging).
-    TArray<TPair<FString, FString>> PendingRequests; // Json, GraphName
-    TArray<FString> SerializationFailedGraphs; // Track graphs that failed JSON serialization
+    TArray<FString> PackGraphJsons;
+    TArray<FString> PackGraphNames;
+    TSet<FString> PackReferencedNames;
+    int32 PackTokens = 0;
+
+    auto FlushPack = [&AddRequest, &PackGraphJsons, &PackGraphNames, &PackReferencedNames, &PackTokens, &GetRequestContext]()
+    {
+        if (PackGraphJsons.Num() > 0)
+        {
+            AddRequest(FN2CSerializer::ToJsonForGraphs(GetRequestContext(PackReferencedNames), PackGraphJsons), MoveTemp(PackGraphNames));
+        }
+        PackGraphJsons.Reset();
+        PackGraphNames.Reset();
+        PackReferencedNames.Reset();
+        PackTokens = 0;
+    };
 
     for (const FN2CGraph& Graph : FullBlueprint.Graphs)
     {
@@ -128,183 +716,696 @@ void FN2CEditorIntegration::ExecuteTranslateEntireBlueprintForEditor(TWeakPtr<FB
             continue;
         }
 
-        FN2CBlueprint PerGraphBlueprint;
-        PerGraphBlueprint.Version    = FullBlueprint.Version;
-        PerGraphBlueprint.Metadata   = FullBlueprint.Metadata;
-        PerGraphBlueprint.Variables  = FullBlueprint.Variables;
-        PerGraphBlueprint.Components = FullBlueprint.Components;
-        PerGraphBlueprint.Structs    = FullBlueprint.Structs;
-        PerGraphBlueprint.Enums      = FullBlueprint.Enums;
-        PerGraphBlueprint.Graphs.Reset(1);
-        PerGraphBlueprint.Graphs.Add(Graph);
-
-        FN2CSerializer::SetPrettyPrint(false);
-        FString JsonOutput = FN2CSerializer::ToJson(PerGraphBlueprint);
-        if (JsonOutput.IsEmpty())
+        FString GraphJson = FN2CSerializer::GraphToJson(Graph, Dialect);
+        if (GraphJson.IsEmpty())
         {
             FN2CLogger::Get().LogError(FString::Printf(TEXT("JSON serialization failed for graph: %s"), *GraphName));
-            SerializationFailedGraphs.Add(GraphName);
+            OutPlan.SerializationFailedGraphs.Add(GraphName);
+            continue;
+        }
+
+        const FString Fingerprint = FN2CNodeTranslator::ComputeGraphFingerprint(
+            Options.bPruneContext ? FN2CSerializer::SharedContextToJson(FullBlueprint, Dialect, &Graph.ReferencedNames) : ContextJson,
+            GraphJson);
+        OutPlan.GraphFingerprints.Add(GraphName, Fingerprint);
+
+        if (PreviousFingerprints)
+        {
+            const FString* PreviousFingerprint = PreviousFingerprints->Find(GraphName);
+            if (PreviousFingerprint && *PreviousFingerprint == Fingerprint)
+            {
+                OutPlan.UnchangedGraphs.Add(GraphName, Fingerprint);
+                continue;
+            }
+        }
+
+        // Trivial functions are written out here; callers still get their declaration
+        FN2CGraphTranslation LocalTranslation;
+        if (Options.MaxLocalTranslationNodes > 0
+            && FN2CLocalTranslator::TryTranslate(Graph, FullBlueprint.Metadata, Options.Language, Options.MaxLocalTranslationNodes, LocalTranslation))
+        {
+            if (!LocalTranslation.Code.GraphDeclaration.IsEmpty())
+            {
+                OutPlan.CarriedCalleeDeclarations.Add(GraphName, LocalTranslation.Code.GraphDeclaration);
+            }
+            OutPlan.LocalTranslations.Add(MoveTemp(LocalTranslation));
+            continue;
+        }
+
+        const int32 GraphTokens = FN2CTokenEstimator::EstimateTokens(GraphJson, Options.Provider);
+        if (PreviousBlueprint && PreviousFingerprints && PreviousFingerprints->Contains(GraphName) && AddDeltaRequest(Graph, GraphTokens))
+        {
+            continue;
+        }
+
+        if (GraphTokens >= PackTokenBudget)
+        {
+            // Large graphs keep a request of their own, or several if they overflow the context window
+            FString RequestJson = FN2CSerializer::ToJsonForGraphs(GetRequestContext(Graph.ReferencedNames), { GraphJson });
+            if (Options.InputBudget > 0 && FN2CTokenEstimator::EstimateTokens(RequestJson, Options.Provider) > Options.InputBudget
+                && AddSplitRequest(Graph))
+            {
+                continue;
+            }
+            AddRequest(MoveTemp(RequestJson), { GraphName });
             continue;
         }
 
-        PendingRequests.Emplace(JsonOutput, GraphName);
+        if (PackTokens + GraphTokens > PackTokenBudget)
+        {
+            FlushPack();
+        }
+        PackGraphJsons.Add(MoveTemp(GraphJson));
+        PackGraphNames.Add(GraphName);
+        PackReferencedNames.Append(Graph.ReferencedNames);
+        PackTokens += GraphTokens;
+    }
+    FlushPack();
+
+    if (NumDeltaRequests > 0)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Sending %d changed graphs as edits to their previous code"), NumDeltaRequests), EN2CLogSeverity::Info);
+    }
+
+    if (Options.bOrderByCalls)
+    {
+        LinkRequestsByCalls(FullBlueprint, OutPlan);
+    }
+
+    return true;
+}
+
+void FN2CEditorIntegration::LinkRequestsByCalls(const FN2CBlueprint& FullBlueprint, FBatchTranslationPlan& OutPlan)
+{
+    TArray<FBatchTranslationPlan::FPendingRequest>& PendingRequests = OutPlan.PendingRequests;
+
+    auto CleanClassName = [](FString Name)
+    {
+        Name.RemoveFromStart(TEXT("SKEL_"));
+        Name.RemoveFromEnd(TEXT("_C"));
+        return Name;
+    };
+    const FString BlueprintName = FullBlueprint.Metadata.Name;
+    const FString BlueprintClass = CleanClassName(FullBlueprint.Metadata.BlueprintClass);
+
+    // Graphs that others can call, by name
+    TMap<FString, const FN2CGraph*> CallableGraphs;
+    for (const FN2CGraph& Graph : FullBlueprint.Graphs)
+    {
+        if (Graph.GraphType == EN2CGraphType::Function || Graph.GraphType == EN2CGraphType::Macro)
+        {
+            CallableGraphs.Add(Graph.Name, &Graph);
+        }
+    }
+    if (CallableGraphs.Num() == 0)
+    {
+        return;
+    }
+
+    TMap<FString, int32> RequestOfGraph;
+    for (int32 RequestIndex = 0; RequestIndex < PendingRequests.Num(); ++RequestIndex)
+    {
+        for (const FString& GraphName : PendingRequests[RequestIndex].GraphNames)
+        {
+            RequestOfGraph.Add(GraphName, RequestIndex);
+        }
+    }
+
+    // Only calls on this Blueprint's own functions and macros; parent and other-object calls have no graph here
+    auto FindCallee = [&CallableGraphs, &BlueprintName, &BlueprintClass](const FN2CNodeDefinition& Node) -> const FN2CGraph*
+    {
+        EN2CGraphType ExpectedType;
+        if (Node.NodeType == EN2CNodeType::CallFunction)
+        {
+            ExpectedType = EN2CGraphType::Function;
+        }
+        else if (Node.NodeType == EN2CNodeType::MacroInstance)
+        {
+            ExpectedType = EN2CGraphType::Macro;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        const FString Parent = Node.GetCleanMemberParent();
+        if (!Parent.IsEmpty() && Parent != BlueprintName && Parent != BlueprintClass)
+        {
+            return nullptr;
+        }
+
+        const FN2CGraph* const* Callee = CallableGraphs.Find(Node.MemberName);
+        return Callee && (*Callee)->GraphType == ExpectedType ? *Callee : nullptr;
+    };
+
+    int32 NumLinked = 0;
+    for (int32 RequestIndex = 0; RequestIndex < PendingRequests.Num(); ++RequestIndex)
+    {
+        FBatchTranslationPlan::FPendingRequest& Request = PendingRequests[RequestIndex];
+        for (const FString& GraphName : Request.GraphNames)
+        {
+            const FN2CGraph* Graph = FullBlueprint.Graphs.FindByPredicate(
+                [&GraphName](const FN2CGraph& Candidate) { return Candidate.Name == GraphName; });
+            if (!Graph)
+            {
+                continue;
+            }
+
+            for (const FN2CNodeDefinition& Node : Graph->Nodes)
+            {
+                const FN2CGraph* Callee = FindCallee(Node);
+                if (!Callee || Request.GraphNames.Contains(Callee->Name) || Request.CalleeGraphs.Contains(Callee->Name))
+                {
+                    continue;
+                }
+
+                // A pending callee is waited for; an unchanged one already has its code in the previous batch
+                if (const int32* CalleeRequest = RequestOfGraph.Find(Callee->Name))
+                {
+                    Request.CalleeGraphs.Add(Callee->Name);
+                    Request.Dependencies.AddUnique(*CalleeRequest);
+                }
+                else if (OutPlan.CarriedCalleeDeclarations.Contains(Callee->Name))
+                {
+                    Request.CalleeGraphs.Add(Callee->Name);
+                }
+                else
+                {
+                    FN2CGeneratedCode CalleeCode;
+                    if (!OutPlan.PreviousRootPath.IsEmpty()
+                        && UN2CLLMModule::LoadBatchGraphCode(OutPlan.PreviousRootPath, Callee->Name, CalleeCode)
+                        && !CalleeCode.GraphDeclaration.IsEmpty())
+                    {
+                        OutPlan.CarriedCalleeDeclarations.Add(Callee->Name, CalleeCode.GraphDeclaration);
+                        Request.CalleeGraphs.Add(Callee->Name);
+                    }
+                }
+            }
+        }
+        NumLinked += Request.Dependencies.Num() > 0 ? 1 : 0;
+    }
+
+    // Mutually recursive graphs would wait on each other forever, so requests left in a cycle do not wait
+    TArray<int32> WaitingOn;
+    TArray<TArray<int32>> Dependents;
+    WaitingOn.SetNumZeroed(PendingRequests.Num());
+    Dependents.SetNum(PendingRequests.Num());
+    TArray<int32> Ready;
+    for (int32 RequestIndex = 0; RequestIndex < PendingRequests.Num(); ++RequestIndex)
+    {
+        WaitingOn[RequestIndex] = PendingRequests[RequestIndex].Dependencies.Num();
+        for (const int32 Dependency : PendingRequests[RequestIndex].Dependencies)
+        {
+            Dependents[Dependency].Add(RequestIndex);
+        }
+        if (WaitingOn[RequestIndex] == 0)
+        {
+            Ready.Add(RequestIndex);
+        }
+    }
+    for (int32 ReadyIndex = 0; ReadyIndex < Ready.Num(); ++ReadyIndex)
+    {
+        for (const int32 Dependent : Dependents[Ready[ReadyIndex]])
+        {
+            if (--WaitingOn[Dependent] == 0)
+            {
+                Ready.Add(Dependent);
+            }
+        }
+    }
+    if (Ready.Num() < PendingRequests.Num())
+    {
+        for (int32 RequestIndex = 0; RequestIndex < PendingRequests.Num(); ++RequestIndex)
+        {
+            if (WaitingOn[RequestIndex] > 0)
+            {
+                PendingRequests[RequestIndex].Dependencies.Reset();
+                NumLinked--;
+            }
+        }
+        FN2CLogger::Get().LogWarning(FString::Printf(
+            TEXT("%d requests call each other in a cycle and are sent without waiting for their callees"),
+            PendingRequests.Num() - Ready.Num()));
+    }
+
+    if (NumLinked > 0)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("%d requests wait for the graphs they call to be translated first"), NumLinked), EN2CLogSeverity::Info);
+    }
+}
+
+void FN2CEditorIntegration::DispatchBatchTranslation(const TSharedRef<FBatchTranslationPlan>& Plan, const TSharedPtr<FBatchDispatch>& StreamedDispatch)
+{
+    // The module may have been re-created while the plan was prepared
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (!LLMModule)
+    {
+        FN2CLogger::Get().LogError(TEXT("LLM Module unavailable for Translate Entire Blueprint"));
+        return;
+    }
+
+    if (!Plan->bValid)
+    {
+        // End batch translation on error
+        LLMModule->EndBatchTranslation();
+        return;
+    }
+
+    const FString& BlueprintName = Plan->BlueprintName;
+    const TMap<FString, FString>& UnchangedGraphs = Plan->UnchangedGraphs;
+    const TArray<FString>& SerializationFailedGraphs = Plan->SerializationFailedGraphs;
+
+    if (UnchangedGraphs.Num() > 0)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Skipping %d unchanged graphs since the last translation of %s"), UnchangedGraphs.Num(), *BlueprintName),
+            EN2CLogSeverity::Info
+        );
+        LLMModule->CarryForwardUnchangedGraphs(Plan->PreviousRootPath, UnchangedGraphs);
+    }
+
+    // Locally translated graphs are saved as one response, while the batch is still open
+    auto DeliverLocalTranslations = [LLMModule, &Plan]()
+    {
+        if (Plan->LocalTranslations.Num() == 0)
+        {
+            return;
+        }
+
+        FN2CTranslationResponse LocalResponse;
+        LocalResponse.Graphs = Plan->LocalTranslations;
+        LLMModule->DeliverLocalTranslation(LocalResponse, Plan->Session);
+
+        TArray<FString> GraphNames;
+        for (const FN2CGraphTranslation& Graph : Plan->LocalTranslations)
+        {
+            LLMModule->RecordGraphFingerprint(Graph.GraphName, Plan->GraphFingerprints.FindRef(Graph.GraphName));
+            GraphNames.Add(Graph.GraphName);
+        }
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Translated %d trivial graphs without the LLM: %s"), GraphNames.Num(), *FString::Join(GraphNames, TEXT(", "))),
+            EN2CLogSeverity::Info);
+    };
+
+    // A streamed plan's requests were sent while it was built
+    const int32 TotalRequests = StreamedDispatch.IsValid() ? StreamedDispatch->Requests.Num() : Plan->PendingRequests.Num();
+    if (TotalRequests == 0 && (UnchangedGraphs.Num() > 0 || Plan->LocalTranslations.Num() > 0) && SerializationFailedGraphs.Num() == 0)
+    {
+        DeliverLocalTranslations();
+        FN2CLogger::Get().Log(Plan->LocalTranslations.Num() > 0
+            ? TEXT("No graph needs the LLM - nothing to send")
+            : TEXT("All graphs are unchanged since the last translation - nothing to send"), EN2CLogSeverity::Info);
+        LLMModule->EndBatchTranslation();
+        return;
+    }
+
+    if (TotalRequests == 0)
+    {
+        DeliverLocalTranslations();
+        FN2CLogger::Get().LogWarning(TEXT("No valid graphs to translate for this Blueprint"));
+        // End batch translation since there are no requests
+        if (LLMModule)
+        {
+            LLMModule->EndBatchTranslation();
+        }
+        return;
+    }
+
+    if (StreamedDispatch.IsValid())
+    {
+        const int32 StreamedGraphs = Algo::TransformAccumulate(StreamedDispatch->Requests,
+            [](const FBatchTranslationPlan::FPendingRequest& Request) { return Request.GraphNames.Num(); }, 0);
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Prepared batch translation: %d graphs for Blueprint: %s (%d graphs sent in %d requests as they were serialized, %d failed serialization)"),
+                Plan->TotalGraphs, *BlueprintName, StreamedGraphs, TotalRequests, SerializationFailedGraphs.Num()),
+            EN2CLogSeverity::Info
+        );
+
+        StreamedDispatch->Plan = Plan;
+        StreamedDispatch->FailedGraphs.Append(SerializationFailedGraphs);
+        DeliverLocalTranslations();
+        StreamedDispatch->bPlanning = false;
+        if (StreamedDispatch->RemainingResponses <= 0)
+        {
+            FinishBatchDispatch(StreamedDispatch.ToSharedRef());
+        }
+        return;
+    }
+
+    TSharedRef<FBatchDispatch> Dispatch = MakeShared<FBatchDispatch>();
+    Dispatch->Plan = Plan;
+    Dispatch->Session = Plan->Session;
+    Dispatch->Requests = MoveTemp(Plan->PendingRequests);
+    Dispatch->GraphFingerprints = Plan->GraphFingerprints;
+    const TArray<FBatchTranslationPlan::FPendingRequest>& PendingRequests = Dispatch->Requests;
+    const int32 TotalPendingGraphs = Algo::TransformAccumulate(PendingRequests,
+        [](const FBatchTranslationPlan::FPendingRequest& Request) { return Request.GraphNames.Num(); }, 0);
+    Dispatch->RemainingResponses = TotalRequests;
+    Dispatch->FailedGraphs = SerializationFailedGraphs; // Include serialization failures
+    Dispatch->CalleeDeclarations = Plan->CarriedCalleeDeclarations;
+    Dispatch->LatencyModel = LLMModule->GetLatencyModel();
+    Dispatch->PeakMemory.Reset();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && Settings->bRouteAcrossProviders && Settings->bRouteLargestToFastestProvider)
+    {
+        // The upper quartile of the batch's estimates, so only its largest requests claim the fastest provider
+        TArray<double> Estimates;
+        for (const FBatchTranslationPlan::FPendingRequest& Request : PendingRequests)
+        {
+            Estimates.Add(Dispatch->LatencyModel.EstimateSeconds(Request.EstimatedTokens, Request.ComplexityScore));
+        }
+        Estimates.Sort(TGreater<>());
+        Dispatch->LargeRequestSeconds = Estimates.Num() > 0 ? Estimates[(Estimates.Num() - 1) / 4] : 0.0;
+    }
+    Dispatch->WaitingOn.SetNumZeroed(TotalRequests);
+    Dispatch->Dependents.SetNum(TotalRequests);
+    ActiveBatchDispatch = Dispatch;
+    DeliverLocalTranslations();
+
+    TArray<int32> ReadyRequests;
+    for (int32 RequestIndex = 0; RequestIndex < TotalRequests; ++RequestIndex)
+    {
+        const FBatchTranslationPlan::FPendingRequest& Request = PendingRequests[RequestIndex];
+        for (const FString& GraphName : Request.GraphNames)
+        {
+            LLMModule->RecordGraphQueued(GraphName, Plan->GraphFingerprints.FindRef(GraphName));
+        }
+
+        Dispatch->WaitingOn[RequestIndex] = Request.Dependencies.Num();
+        for (const int32 Dependency : Request.Dependencies)
+        {
+            Dispatch->Dependents[Dependency].Add(RequestIndex);
+        }
+        if (Request.Dependencies.Num() == 0)
+        {
+            ReadyRequests.Add(RequestIndex);
+        }
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Starting batch translation: %d graphs to translate for Blueprint: %s (%d graphs in %d requests queued, %d failed serialization)"),
+            Plan->TotalGraphs, *BlueprintName, TotalPendingGraphs, TotalRequests, SerializationFailedGraphs.Num()),
+        EN2CLogSeverity::Info
+    );
+
+    // Hand every request that waits on no callee to the LLM module at once, longest expected first so the
+    // largest graphs do not finish the batch last; its scheduler throttles them per provider. The rest follow
+    // as their callees complete
+    const FN2CLatencyModel& LatencyModel = Dispatch->LatencyModel;
+    Algo::StableSortBy(ReadyRequests,
+        [&LatencyModel, &PendingRequests](int32 RequestIndex)
+        {
+            const FBatchTranslationPlan::FPendingRequest& Request = PendingRequests[RequestIndex];
+            return LatencyModel.EstimateSeconds(Request.EstimatedTokens, Request.ComplexityScore);
+        },
+        TGreater<>());
+    for (const int32 RequestIndex : ReadyRequests)
+    {
+        SendBatchRequest(Dispatch, RequestIndex);
+    }
+}
+
+void FN2CEditorIntegration::SendBatchRequest(const TSharedRef<FBatchDispatch>& Dispatch, int32 RequestIndex)
+{
+    FBatchTranslationPlan::FPendingRequest& Request = Dispatch->Requests[RequestIndex];
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (Dispatch->bCancelled || !LLMModule)
+    {
+        HandleBatchResponse(Dispatch, RequestIndex, FN2CTranslationResponse(), false);
+        return;
+    }
+
+    // Declarations of the callees translated by now, in this batch or an earlier one
+    TArray<TPair<FString, FString>> Declarations;
+    int32 DeclarationTokens = 0;
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    for (const FString& Callee : Request.CalleeGraphs)
+    {
+        if (const FString* Declaration = Dispatch->CalleeDeclarations.Find(Callee))
+        {
+            Declarations.Emplace(Callee, *Declaration);
+            DeclarationTokens += Settings ? FN2CTokenEstimator::EstimateTokens(*Declaration, Settings->Provider) : 0;
+        }
+    }
+
+    const double EstimatedSeconds = Dispatch->LatencyModel.EstimateSeconds(Request.EstimatedTokens + DeclarationTokens, Request.ComplexityScore);
+    const bool bPreferFastestProvider = Dispatch->LargeRequestSeconds > 0.0
+        && Dispatch->LatencyModel.EstimateSeconds(Request.EstimatedTokens, Request.ComplexityScore) >= Dispatch->LargeRequestSeconds;
+    N2C_LOG(Debug, TEXT("Sending translation request for graphs: %s (~%.1fs expected%s)"),
+        *FString::Join(Request.GraphNames, TEXT(", ")), EstimatedSeconds, bPreferFastestProvider ? TEXT(", fastest provider") : TEXT(""));
+
+    // Callee declarations are spliced into the payload on a worker while earlier requests upload and parse,
+    // and the payload moved on from there; the stage owns it from here on
+    const TSharedPtr<const FN2CTranslationSession> Session = Dispatch->Session;
+    const auto OnTranslated = [Dispatch, RequestIndex](FN2CTranslationResult Result)
+    {
+        FN2CEditorIntegration::Get().HandleBatchResponse(Dispatch, RequestIndex, *Result.Response, Result.bSuccess);
+    };
+    const auto IsAbandoned = [Dispatch, RequestIndex]()
+    {
+        if (Dispatch->bCancelled || !UN2CLLMModule::Get())
+        {
+            FN2CEditorIntegration::Get().HandleBatchResponse(Dispatch, RequestIndex, FN2CTranslationResponse(), false);
+            return true;
+        }
+        return false;
+    };
+
+    if (Request.PartJsons.Num() > 0)
+    {
+        TArray<int32> PartEstimatedTokens;
+        for (const int32 PartTokens : Request.PartEstimatedTokens)
+        {
+            PartEstimatedTokens.Add(PartTokens + DeclarationTokens);
+        }
+
+        UN2CLLMModule::LaunchStage<TArray<FString>>(
+            [PartJsons = MoveTemp(Request.PartJsons), Declarations = MoveTemp(Declarations)]()
+            {
+                TArray<FString> Payloads;
+                Payloads.Reserve(PartJsons.Num());
+                for (const FString& PartJson : PartJsons)
+                {
+                    Payloads.Add(FN2CSerializer::WithCalleeDeclarations(PartJson, Declarations));
+                }
+                return Payloads;
+            })
+            .Next([Session, PartEstimatedTokens, EstimatedSeconds, bPreferFastestProvider, OnTranslated, IsAbandoned](TArray<FString> PartJsons)
+            {
+                if (IsAbandoned())
+                {
+                    return;
+                }
+                for (const FString& PartJson : PartJsons)
+                {
+                    FN2CLogger::Get().LogPayload(TEXT("JSON Output"), PartJson);
+                }
+                UN2CLLMModule::Get()->TranslateN2CJsonParts(PartJsons, PartEstimatedTokens, Session, EstimatedSeconds, bPreferFastestProvider)
+                    .Next(OnTranslated);
+            });
+    }
+    else
+    {
+        const int32 EstimatedTokens = Request.EstimatedTokens + DeclarationTokens;
+        UN2CLLMModule::LaunchStage<FString>(
+            [Json = MoveTemp(Request.Json), Declarations = MoveTemp(Declarations)]()
+            {
+                return FN2CSerializer::WithCalleeDeclarations(Json, Declarations);
+            })
+            .Next([Session, EstimatedTokens, EstimatedSeconds, bPreferFastestProvider, OnTranslated, IsAbandoned](FString JsonOutput)
+            {
+                if (IsAbandoned())
+                {
+                    return;
+                }
+                FN2CLogger::Get().LogPayload(TEXT("JSON Output"), JsonOutput);
+                UN2CLLMModule::Get()->TranslateN2CJson(JsonOutput, EstimatedTokens, Session, EstimatedSeconds, bPreferFastestProvider)
+                    .Next(OnTranslated);
+            });
+    }
+}
+
+void FN2CEditorIntegration::HandleBatchResponse(
+    const TSharedRef<FBatchDispatch>& Dispatch,
+    int32 RequestIndex,
+    const FN2CTranslationResponse& TranslationResponse,
+    bool bSuccess)
+{
+    const TArray<FString>& GraphNames = Dispatch->Requests[RequestIndex].GraphNames;
+    const FString GraphList = FString::Join(GraphNames, TEXT(", "));
+
+    // The module has already parsed, saved and broadcast the response
+    if (bSuccess)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Successfully parsed LLM response for graphs: %s (Input: %d Output: %d tokens)"),
+                *GraphList, TranslationResponse.Usage.InputTokens, TranslationResponse.Usage.OutputTokens),
+            EN2CLogSeverity::Info
+        );
+    }
+
+    // A packed response is unpacked by graph name; any graph missing from it counts as failed
+    for (const FString& GraphName : GraphNames)
+    {
+        const FN2CGraphTranslation* GraphTranslation = !bSuccess ? nullptr
+            : GraphNames.Num() == 1 ? (TranslationResponse.Graphs.Num() > 0 ? &TranslationResponse.Graphs[0] : nullptr)
+            : TranslationResponse.Graphs.FindByPredicate([&GraphName](const FN2CGraphTranslation& Graph) { return Graph.GraphName == GraphName; });
+        const bool bGraphTranslated = bSuccess && (GraphNames.Num() == 1 || GraphTranslation);
+
+        if (bGraphTranslated)
+        {
+            Dispatch->SuccessfulGraphs.Add(GraphName);
+            UN2CLLMModule::Get()->RecordGraphFingerprint(GraphName, Dispatch->GraphFingerprints.FindRef(GraphName));
+
+            // Callers sent after this get the signature it was actually given
+            if (GraphTranslation && !GraphTranslation->Code.GraphDeclaration.IsEmpty())
+            {
+                Dispatch->CalleeDeclarations.Add(GraphName, GraphTranslation->Code.GraphDeclaration);
+            }
+        }
+        else
+        {
+            FN2CLogger::Get().LogError(
+                FString::Printf(TEXT("Failed to translate graph: %s"), *GraphName)
+            );
+            Dispatch->FailedGraphs.Add(GraphName);
+            if (UN2CLLMModule* LLMModule = UN2CLLMModule::Get())
+            {
+                LLMModule->RecordGraphFailed(GraphName);
+            }
+        }
+    }
+
+    // Callers go out once all their callees are done; a failed callee only leaves them without its declaration
+    TArray<int32> ReleasedRequests;
+    for (const int32 Dependent : Dispatch->Dependents[RequestIndex])
+    {
+        if (--Dispatch->WaitingOn[Dependent] == 0)
+        {
+            ReleasedRequests.Add(Dependent);
+        }
+    }
+
+    Dispatch->PeakMemory.Sample();
+
+    // Decrement remaining counter and log summary when the batch completes. A streamed batch may have
+    // answered every request sent so far while its later ones are still being serialized
+    const int32 NewRemaining = --Dispatch->RemainingResponses;
+    if (NewRemaining <= 0 && !Dispatch->bPlanning)
+    {
+        FinishBatchDispatch(Dispatch);
+        return;
+    }
+
+    for (const int32 Released : ReleasedRequests)
+    {
+        SendBatchRequest(Dispatch, Released);
+    }
+}
+
+void FN2CEditorIntegration::FinishBatchDispatch(const TSharedRef<FBatchDispatch>& Dispatch)
+{
+    const FBatchTranslationPlan& Plan = *Dispatch->Plan;
+    const TArray<FString>& SuccessfulGraphs = Dispatch->SuccessfulGraphs;
+    const TArray<FString>& FailedGraphs = Dispatch->FailedGraphs;
+
+    // Build summary message
+    FString Summary = FString::Printf(
+        TEXT("Full Blueprint translation complete for: %s\n")
+        TEXT("  Total graphs: %d\n")
+        TEXT("  Successful: %d\n")
+        TEXT("  Unchanged (skipped): %d\n")
+        TEXT("  Translated locally: %d\n")
+        TEXT("  Failed: %d"),
+        *Plan.BlueprintName,
+        Plan.TotalGraphs,
+        SuccessfulGraphs.Num(),
+        Plan.UnchangedGraphs.Num(),
+        Plan.LocalTranslations.Num(),
+        FailedGraphs.Num()
+    );
+
+    if (FailedGraphs.Num() > 0)
+    {
+        Summary += TEXT("\n  Failed graphs: ");
+        Summary += FString::Join(FailedGraphs, TEXT(", "));
+    }
+
+    if (SuccessfulGraphs.Num() > 0)
+    {
+        Summary += TEXT("\n  Successful graphs: ");
+        Summary += FString::Join(SuccessfulGraphs, TEXT(", "));
+    }
+
+    Dispatch->PeakMemory.Sample();
+    Summary += TEXT("\n  ") + Dispatch->PeakMemory.ToString();
+
+    // Log summary with appropriate severity
+    if (FailedGraphs.Num() > 0)
+    {
+        FN2CLogger::Get().LogWarning(Summary);
     }
-
-    if (PendingRequests.Num() == 0)
+    else
     {
-        FN2CLogger::Get().LogWarning(TEXT("No valid graphs to translate for this Blueprint"));
-        // End batch translation since there are no requests
-        if (LLMModule)
-        {
-            LLMModule->EndBatchTranslation();
-        }
-        return;
+        FN2CLogger::Get().Log(Summary, EN2CLogSeverity::Info);
     }
 
-    // Shared counter and result tracking for batch completion logging.
-    // We keep these local to the editor integration and update them from the per-request callback.
-    const int32 TotalRequests = PendingRequests.Num();
-    const int32 TotalGraphs = FullBlueprint.Graphs.Num(); // Total including serialization failures
-    TSharedRef<int32> RemainingResponses = MakeShared<int32>(TotalRequests);
-    TSharedRef<TArray<FString>> SuccessfulGraphs = MakeShared<TArray<FString>>();
-    TSharedRef<TArray<FString>> FailedGraphs = MakeShared<TArray<FString>>(SerializationFailedGraphs); // Include serialization failures
-
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Starting batch translation: %d graphs to translate for Blueprint: %s (%d requests queued, %d failed serialization)"),
-            TotalGraphs, *BlueprintName, TotalRequests, SerializationFailedGraphs.Num()),
-        EN2CLogSeverity::Info
-    );
+    // End batch translation - clear the batch root path
+    UN2CLLMModule* BatchLLMModule = UN2CLLMModule::Get();
+    if (BatchLLMModule)
+    {
+        BatchLLMModule->EndBatchTranslation();
+    }
+}
 
-    // Second pass: actually send requests to the LLM
-    for (const TPair<FString, FString>& Request : PendingRequests)
+void FN2CEditorIntegration::CancelTranslation()
+{
+    if (bPreparingTranslation)
     {
-        const FString& JsonOutput = Request.Key;
-        const FString& GraphName  = Request.Value;
+        bCancelPreparedTranslation = true;
+    }
 
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Sending translation request for graph: %s"), *GraphName),
-            EN2CLogSeverity::Debug
-        );
-        FN2CLogger::Get().Log(TEXT("JSON Output:"), EN2CLogSeverity::Debug);
-        FN2CLogger::Get().Log(JsonOutput, EN2CLogSeverity::Debug);
+    // Requests still waiting for their callees are never sent
+    if (const TSharedPtr<FBatchDispatch> Dispatch = ActiveBatchDispatch.Pin())
+    {
+        Dispatch->bCancelled = true;
+    }
 
-        LLMModule->ProcessN2CJson(JsonOutput, FOnLLMResponseReceived::CreateLambda(
-            [GraphName, RemainingResponses, BlueprintName, SuccessfulGraphs, FailedGraphs, TotalGraphs](const FString& Response)
-            {
-                bool bSuccess = false;
-                FString ErrorMessage;
-
-                FN2CLogger::Get().Log(
-                    FString::Printf(TEXT("Received LLM response for graph: %s"), *GraphName),
-                    EN2CLogSeverity::Debug
-                );
-                FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response for graph %s:\n\n%s"), *GraphName, *Response), EN2CLogSeverity::Debug);
-                
-                FN2CTranslationResponse TranslationResponse;
-                TScriptInterface<IN2CLLMService> ActiveService = UN2CLLMModule::Get()->GetActiveService();
-                if (ActiveService.GetInterface())
-                {
-                    UN2CResponseParserBase* Parser = ActiveService->GetResponseParser();
-                    if (Parser)
-                    {
-                        if (Parser->ParseLLMResponse(Response, TranslationResponse))
-                        {
-                            FN2CLogger::Get().Log(
-                                FString::Printf(TEXT("Successfully parsed LLM response for graph: %s"), *GraphName),
-                                EN2CLogSeverity::Info
-                            );
-                            bSuccess = true;
-                            SuccessfulGraphs->Add(GraphName);
-                        }
-                        else
-                        {
-                            ErrorMessage = TEXT("Failed to parse LLM response");
-                            FN2CLogger::Get().LogError(
-                                FString::Printf(TEXT("Failed to parse LLM response for graph: %s"), *GraphName)
-                            );
-                            FailedGraphs->Add(GraphName);
-                        }
-                    }
-                    else
-                    {
-                        ErrorMessage = TEXT("No response parser available");
-                        FN2CLogger::Get().LogError(
-                            FString::Printf(TEXT("No response parser available for graph: %s"), *GraphName)
-                        );
-                        FailedGraphs->Add(GraphName);
-                    }
-                }
-                else
-                {
-                    ErrorMessage = TEXT("No active LLM service");
-                    FN2CLogger::Get().LogError(
-                        FString::Printf(TEXT("No active LLM service for graph: %s"), *GraphName)
-                    );
-                    FailedGraphs->Add(GraphName);
-                }
+    // Each cancelled request reports failure, so a batch still logs its summary and ends
+    if (UN2CLLMModule* LLMModule = UN2CLLMModule::Get())
+    {
+        LLMModule->CancelTranslations();
+    }
+}
 
-                // Decrement remaining counter and log summary when the batch completes.
-                const int32 NewRemaining = --(*RemainingResponses);
-                if (NewRemaining <= 0)
-                {
-                    // Build summary message
-                    FString Summary = FString::Printf(
-                        TEXT("Full Blueprint translation complete for: %s\n")
-                        TEXT("  Total graphs: %d\n")
-                        TEXT("  Successful: %d\n")
-                        TEXT("  Failed: %d"),
-                        *BlueprintName,
-                        TotalGraphs,
-                        SuccessfulGraphs->Num(),
-                        FailedGraphs->Num()
-                    );
-
-                    if (FailedGraphs->Num() > 0)
-                    {
-                        Summary += TEXT("\n  Failed graphs: ");
-                        for (int32 i = 0; i < FailedGraphs->Num(); ++i)
-                        {
-                            if (i > 0)
-                            {
-                                Summary += TEXT(", ");
-                            }
-                            Summary += (*FailedGraphs)[i];
-                        }
-                    }
+bool FN2CEditorIntegration::IsTranslationInProgress() const
+{
+    const UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    return bPreparingTranslation
+        || (LLMModule && (LLMModule->GetSystemStatus() == EN2CSystemStatus::Processing || LLMModule->HasPendingTranslations()));
+}
 
-                    if (SuccessfulGraphs->Num() > 0)
-                    {
-                        Summary += TEXT("\n  Successful graphs: ");
-                        for (int32 i = 0; i < SuccessfulGraphs->Num(); ++i)
-                        {
-                            if (i > 0)
-                            {
-                                Summary += TEXT(", ");
-                            }
-                            Summary += (*SuccessfulGraphs)[i];
-                        }
-                    }
+FString FN2CEditorIntegration::GetPrettyJson(const FN2CBlueprint& Blueprint)
+{
+    const FString Fingerprint = ComputeBlueprintFingerprint(Blueprint);
+    {
+        FScopeLock Lock(&PrettyJsonCacheLock);
+        if (Fingerprint == CachedPrettyJsonFingerprint)
+        {
+            return CachedPrettyJson;
+        }
+    }
 
-                    // Log summary with appropriate severity
-                    if (FailedGraphs->Num() > 0)
-                    {
-                        FN2CLogger::Get().LogWarning(Summary);
-                    }
-                    else
-                    {
-                        FN2CLogger::Get().Log(Summary, EN2CLogSeverity::Info);
-                    }
-                    
-                    // End batch translation - clear the batch root path
-                    UN2CLLMModule* BatchLLMModule = UN2CLLMModule::Get();
-                    if (BatchLLMModule)
-                    {
-                        BatchLLMModule->EndBatchTranslation();
-                    }
-                }
-            }
-        ));
+    FString JsonOutput = FN2CSerializer::ToJson(Blueprint);
+    if (!JsonOutput.IsEmpty())
+    {
+        FScopeLock Lock(&PrettyJsonCacheLock);
+        CachedPrettyJsonFingerprint = Fingerprint;
+        CachedPrettyJson = JsonOutput;
     }
+    return JsonOutput;
 }
 
 void FN2CEditorIntegration::ExecuteCopyJsonForEditor(TWeakPtr<FBlueprintEditor> InEditor)
@@ -340,52 +1441,43 @@ void FN2CEditorIntegration::ExecuteCopyJsonForEditor(TWeakPtr<FBlueprintEditor>
         EN2CLogSeverity::Info
     );
 
-    // Get collector instance
-    FN2CNodeCollector& Collector = FN2CNodeCollector::Get();
-
-    // Collect nodes using the specific editor
-    TArray<UK2Node*> CollectedNodes;
-    if (Collector.CollectNodesFromGraph(FocusedGraph, CollectedNodes))
+    // The live model kept since the graph last changed, or one built from its nodes now
+    const TSharedPtr<const FN2CBlueprint> Model = FN2CLiveGraphModel::Get().GetModel(FocusedGraph);
+    if (Model.IsValid())
     {
-        FString Context = FString::Printf(TEXT("Collected %d nodes"), CollectedNodes.Num());
-        FN2CLogger::Get().Log(TEXT("Node collection successful"), EN2CLogSeverity::Info, Context);
+        FN2CLogger::Get().Log(TEXT("Node translation successful"), EN2CLogSeverity::Info);
 
-        // Get translator instance                                                                                                                                                                        
-        FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
-
-        // Generate N2CStruct from collected nodes
-        if (Translator.GenerateN2CStruct(CollectedNodes))
+        if (bCopyingJson)
         {
-            FN2CLogger::Get().Log(TEXT("Node translation successful"), EN2CLogSeverity::Info);
+            FN2CLogger::Get().LogWarning(TEXT("Blueprint JSON is already being copied, please wait"));
+            return;
+        }
 
-            // Get the Blueprint structure
-            const FN2CBlueprint& Blueprint = FN2CNodeTranslator::Get().GetN2CBlueprint();
+        // Pretty-printing a large graph takes long enough to hitch the editor, so it runs on a worker
+        TSharedRef<const FN2CBlueprint> Blueprint = Model.ToSharedRef();
+
+        FNotificationInfo Info(NSLOCTEXT("NodeToCode", "BlueprintJsonCopying", "Copying Blueprint JSON..."));
+        Info.bFireAndForget = false;
+        Info.FadeInDuration = 0.2f;
+        Info.FadeOutDuration = 0.5f;
+        Info.ExpireDuration = 2.0f;
+        Info.bUseThrobber = true;
+        Info.bUseSuccessFailIcons = true;
+        TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+        if (Notification.IsValid())
+        {
+            Notification->SetCompletionState(SNotificationItem::CS_Pending);
+        }
 
-            // Validate the generated Blueprint
-            if (Blueprint.IsValid())
+        bCopyingJson = true;
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Blueprint, Notification]()
+        {
+            FString JsonOutput;
+            if (Blueprint->IsValid())
             {
                 FN2CLogger::Get().Log(TEXT("Node translation validation successful"), EN2CLogSeverity::Info);
-
-                // Serialize to JSON with pretty printing enabled for clipboard                                                                                                                                   
-                FN2CSerializer::SetPrettyPrint(true);
-                FString JsonOutput = FN2CSerializer::ToJson(Blueprint);                                                                                                                                       
-
-                // Copy JSON to clipboard if not empty                                                                                                                                                         
-                if (!JsonOutput.IsEmpty())                                                                                                                                                                    
-                {                                                                                                                                                                                             
-                    FPlatformApplicationMisc::ClipboardCopy(*JsonOutput);
-
-                    // Show notification
-                    FNotificationInfo Info(NSLOCTEXT("NodeToCode", "BlueprintJsonCopied", "Blueprint JSON copied to clipboard"));
-                    Info.bFireAndForget = true;
-                    Info.FadeInDuration = 0.2f;
-                    Info.FadeOutDuration = 0.5f;
-                    Info.ExpireDuration = 2.0f;
-                    FSlateNotificationManager::Get().AddNotification(Info);
-
-                    FN2CLogger::Get().Log(TEXT("Blueprint JSON copied to clipboard successfully"), EN2CLogSeverity::Info);
-                }
-                else
+                JsonOutput = GetPrettyJson(*Blueprint);
+                if (JsonOutput.IsEmpty())
                 {
                     FN2CLogger::Get().LogError(TEXT("JSON serialization failed"));
                 }
@@ -394,12 +1486,57 @@ void FN2CEditorIntegration::ExecuteCopyJsonForEditor(TWeakPtr<FBlueprintEditor>
             {
                 FN2CLogger::Get().LogError(TEXT("Node translation validation failed"));
             }
-        }
-        else
-        {
-            FN2CLogger::Get().LogError(TEXT("Failed to translate nodes"));
-        }
+
+            // The clipboard and notifications belong to the game thread
+            AsyncTask(ENamedThreads::GameThread, [this, JsonOutput = MoveTemp(JsonOutput), Notification]()
+            {
+                bCopyingJson = false;
+
+                const bool bCopied = !JsonOutput.IsEmpty();
+                if (bCopied)
+                {
+                    FPlatformApplicationMisc::ClipboardCopy(*JsonOutput);
+                    FN2CLogger::Get().Log(TEXT("Blueprint JSON copied to clipboard successfully"), EN2CLogSeverity::Info);
+                }
+
+                if (Notification.IsValid())
+                {
+                    Notification->SetText(bCopied
+                        ? NSLOCTEXT("NodeToCode", "BlueprintJsonCopied", "Blueprint JSON copied to clipboard")
+                        : NSLOCTEXT("NodeToCode", "BlueprintJsonCopyFailed", "Failed to copy Blueprint JSON"));
+                    Notification->SetCompletionState(bCopied ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+                    Notification->ExpireAndFadeout();
+                }
+            });
+        });
     }
+    else
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to translate nodes"));
+    }
+}
+
+void FN2CEditorIntegration::ExecuteInspectBlueprintForEditor(TWeakPtr<FBlueprintEditor> InEditor)
+{
+    TSharedPtr<FBlueprintEditor> Editor = InEditor.Pin();
+    UEdGraph* FocusedGraph = Editor.IsValid() ? Editor->GetFocusedGraph() : nullptr;
+    if (!FocusedGraph)
+    {
+        FN2CLogger::Get().LogError(TEXT("No focused graph in Blueprint Editor"));
+        return;
+    }
+
+    // The same model a translation of the graph would send
+    const TSharedPtr<const FN2CBlueprint> Model = FN2CLiveGraphModel::Get().GetModel(FocusedGraph);
+    if (!Model.IsValid())
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to translate nodes"));
+        return;
+    }
+
+    const UBlueprint* Blueprint = Cast<UBlueprint>(FocusedGraph->GetOuter());
+    SN2CBlueprintInspector::Inspect(Model.ToSharedRef(),
+        FString::Printf(TEXT("%s / %s"), Blueprint ? *Blueprint->GetName() : TEXT("Unknown"), *FocusedGraph->GetName()));
 }
 
 void FN2CEditorIntegration::Initialize()
@@ -407,24 +1544,20 @@ void FN2CEditorIntegration::Initialize()
     // Register commands
     FN2CToolbarCommand::Register();
 
-    // Register tab spawner
+    // Register tab spawners
     SN2CEditorWindow::RegisterTabSpawner();
+    SN2CBlueprintInspector::RegisterTabSpawner();
 
-    // Subscribe to asset editor opened events
-    if (GEditor)
+    // Add the toolbar menu once menus are ready
+    UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FN2CEditorIntegration::RegisterToolbarMenu));
+
+    // Watch graph edits to pre-translate the focused graph while the user works
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && Settings->bSpeculativeTranslation)
     {
-        UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-        if (ensure(AssetEditorSubsystem))
-        {
-            AssetEditorSubsystem->OnAssetEditorOpened().AddLambda([this](UObject* Asset)
-            {
-                if (IAssetEditorInstance* EditorInstance = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->FindEditorForAsset(Asset, false))
-                {
-                    HandleAssetEditorOpened(Asset, EditorInstance);
-                }
-            });
-            FN2CLogger::Get().Log(TEXT("N2C Editor Integration: Subscribed to OnAssetEditorOpened via AssetEditorSubsystem"), EN2CLogSeverity::Info);
-        }
+        ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FN2CEditorIntegration::HandleObjectModified);
+        SpeculativeTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FN2CEditorIntegration::TickSpeculativeTranslation), 0.5f);
     }
 
     FN2CLogger::Get().Log(TEXT("N2C Editor Integration initialized"), EN2CLogSeverity::Info);
@@ -432,245 +1565,203 @@ void FN2CEditorIntegration::Initialize()
 
 void FN2CEditorIntegration::Shutdown()
 {
-    // Unregister tab spawner
+    // Unregister tab spawners
     SN2CEditorWindow::UnregisterTabSpawner();
+    SN2CBlueprintInspector::UnregisterTabSpawner();
 
-    // Clear editor command lists
-    EditorCommandLists.Empty();
+    // Remove the toolbar menu
+    UToolMenus::UnRegisterStartupCallback(this);
+    UToolMenus::UnregisterOwner(this);
 
-    // Unsubscribe from asset editor events
-    if (GEditor)
+    FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(SpeculativeTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(SlicedExtractionTickerHandle);
+    SlicedExtractionTickerHandle.Reset();
+    SlicedExtractionNotification.Reset();
+    FN2CNodeTranslator::Get().CancelSlicedExtraction();
+    ObjectModifiedHandle.Reset();
+    SpeculativeTickerHandle.Reset();
+    SpeculativeGraph.Reset();
+
+    // Let translation files still queued reach the disk before the module goes away
+    FN2CTranslationOutputWriter::Get().Flush();
+
+    FN2CLogger::Get().Log(TEXT("N2C Editor Integration shutdown"), EN2CLogSeverity::Info);
+}
+
+void FN2CEditorIntegration::HandleObjectModified(UObject* Object)
+{
+    UEdGraph* Graph = Cast<UEdGraph>(Object);
+    if (!Graph)
     {
-        UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-        if (AssetEditorSubsystem)
+        if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
         {
-            AssetEditorSubsystem->OnAssetEditorOpened().RemoveAll(this);
+            Graph = Node->GetGraph();
         }
     }
 
-    FN2CLogger::Get().Log(TEXT("N2C Editor Integration shutdown"), EN2CLogSeverity::Info);
+    if (Graph)
+    {
+        SpeculativeGraph = Graph;
+        LastGraphEditTime = FPlatformTime::Seconds();
+    }
 }
 
-
-TSharedPtr<FBlueprintEditor> FN2CEditorIntegration::GetBlueprintEditorFromTab() const
+bool FN2CEditorIntegration::TickSpeculativeTranslation(float DeltaTime)
 {
-    // Mark as deprecated
-    FN2CLogger::Get().LogWarning(TEXT("GetBlueprintEditorFromTab is deprecated - editors should be accessed directly"));
-    return nullptr;
-}
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    UEdGraph* Graph = SpeculativeGraph.Get();
+    if (!Graph || !Settings || !Settings->bSpeculativeTranslation
+        || FPlatformTime::Seconds() - LastGraphEditTime < Settings->SpeculativeIdleSeconds)
+    {
+        return true;
+    }
 
-void FN2CEditorIntegration::HandleAssetEditorOpened(UObject* Asset, IAssetEditorInstance* EditorInstance)
-{
-    if (!Asset || !EditorInstance)
+    // Requested translations come first, and only the graph being looked at is worth guessing
+    if (bPreparingSpeculation || IsTranslationInProgress())
     {
-        return;
+        return true;
     }
 
-    // Check if the asset is a Blueprint or a child class of Blueprint
-    UBlueprint* OpenedBlueprint = Cast<UBlueprint>(Asset);
-    if (!OpenedBlueprint)
+    SpeculativeGraph.Reset();
+    const TSharedPtr<FBlueprintEditor> Editor = GetBlueprintEditorFromTab();
+    if (Editor.IsValid() && Editor->GetFocusedGraph() == Graph)
     {
-        return; // Not a Blueprint, so ignore
+        StartSpeculativeTranslation(Graph);
     }
+    return true;
+}
 
-    // Convert the EditorInstance to the correct type
-    FBlueprintEditor* BlueprintEditorPtr = static_cast<FBlueprintEditor*>(EditorInstance);
-    if (!BlueprintEditorPtr)
+void FN2CEditorIntegration::StartSpeculativeTranslation(UEdGraph* Graph)
+{
+    // Building the model here also leaves it ready for Translate Focused Graph
+    const TSharedPtr<const FN2CBlueprint> Model = FN2CLiveGraphModel::Get().GetModel(Graph);
+    if (!Model.IsValid())
     {
         return;
     }
 
-    // Convert to SharedPtr so it matches our existing RegisterToolbarForEditor() signature
-    TSharedPtr<FBlueprintEditor> BlueprintEditorShared = StaticCastSharedRef<FBlueprintEditor>(BlueprintEditorPtr->AsShared());
-    if (BlueprintEditorShared.IsValid())
+    // Serialized exactly like Translate Focused Graph, so its request finds the cached result
+    TSharedRef<const FN2CBlueprint> Blueprint = Model.ToSharedRef();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const EN2CJsonDialect Dialect = Settings && Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+
+    bPreparingSpeculation = true;
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Blueprint, Dialect]()
     {
-        // Check if we already have this editor registered
-        TWeakPtr<FBlueprintEditor> WeakEditor(BlueprintEditorShared);
-        if (!EditorCommandLists.Contains(WeakEditor))
+        FString JsonOutput = Blueprint->IsValid() ? FN2CSerializer::ToCondensedJson(*Blueprint, Dialect) : FString();
+        AsyncTask(ENamedThreads::GameThread, [this, JsonOutput = MoveTemp(JsonOutput)]()
         {
-            FString BlueprintPath = OpenedBlueprint->GetPathName();
-            
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Registering toolbar for Blueprint Editor: %s"), 
-                *BlueprintPath), 
-                EN2CLogSeverity::Info
-            );
-            
-            RegisterToolbarForEditor(BlueprintEditorShared);
-        }
-        else
-        {
-            FN2CLogger::Get().Log(
-                TEXT("Blueprint Editor already registered"), 
-                EN2CLogSeverity::Debug
-            );
-        }
-    }
+            bPreparingSpeculation = false;
+            UN2CLLMModule* ActiveLLMModule = UN2CLLMModule::Get();
+            if (!JsonOutput.IsEmpty() && ActiveLLMModule && ActiveLLMModule->Initialize())
+            {
+                ActiveLLMModule->PreTranslateN2CJson(JsonOutput);
+            }
+        });
+    });
 }
 
-
-void FN2CEditorIntegration::RegisterToolbarForEditor(TSharedPtr<FBlueprintEditor> InEditor)
+TSharedPtr<FBlueprintEditor> FN2CEditorIntegration::GetBlueprintEditorFromTab() const
 {
-    FN2CLogger::Get().Log(TEXT("Starting toolbar registration for editor"), EN2CLogSeverity::Info);
+    // Mark as deprecated
+    FN2CLogger::Get().LogWarning(TEXT("GetBlueprintEditorFromTab is deprecated - editors should be accessed directly"));
+    return nullptr;
+}
 
-    if (!InEditor.IsValid())
+void FN2CEditorIntegration::RegisterToolbarMenu()
+{
+    // Registered once; editors whose toolbars derive from the Blueprint editor's pick the entry up as they open
+    FToolMenuOwnerScoped OwnerScoped(this);
+    UToolMenu* ToolbarMenu = UToolMenus::Get()->ExtendMenu(TEXT("AssetEditor.BlueprintEditor.ToolBar"));
+    if (!ToolbarMenu)
     {
-        FN2CLogger::Get().LogError(TEXT("Invalid editor pointer provided to RegisterToolbarForEditor"));
+        FN2CLogger::Get().LogError(TEXT("Failed to extend the Blueprint Editor toolbar"));
         return;
     }
 
-    // Get Blueprint name for context
-    FString BlueprintName = TEXT("Unknown");
-    if (InEditor->GetBlueprintObj())
-    {
-        BlueprintName = InEditor->GetBlueprintObj()->GetName();
-    }
+    FToolMenuSection& Section = ToolbarMenu->AddSection(
+        TEXT("NodeToCode"), FText::GetEmpty(), FToolMenuInsert(TEXT("Asset"), EToolMenuInsertType::After));
+    Section.AddEntry(FToolMenuEntry::InitComboButton(
+        TEXT("NodeToCodeActions"),
+        FUIAction(),
+        FNewToolMenuDelegate::CreateRaw(this, &FN2CEditorIntegration::FillToolbarMenu),
+        NSLOCTEXT("NodeToCode", "NodeToCodeActions", "Node to Code"),
+        NSLOCTEXT("NodeToCode", "NodeToCodeTooltip", "Node to Code Actions"),
+        FSlateIcon("NodeToCodeStyle", "NodeToCode.ToolbarButton")
+    ));
+
+    FN2CLogger::Get().Log(TEXT("Registered Node to Code toolbar menu"), EN2CLogSeverity::Info);
+}
 
-    // Check if we already have a command list for this editor
-    TWeakPtr<FBlueprintEditor> WeakEditor(InEditor);
-    if (EditorCommandLists.Contains(WeakEditor))
+void FN2CEditorIntegration::FillToolbarMenu(UToolMenu* InMenu)
+{
+    if (!InMenu)
     {
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Editor already has command list registered: %s"), *BlueprintName),
-            EN2CLogSeverity::Warning
-        );
         return;
     }
 
-    // Create command list for this editor
-    TSharedPtr<FUICommandList> CommandList = MakeShareable(new FUICommandList);
-    
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Created command list for Blueprint: %s"), *BlueprintName), 
-        EN2CLogSeverity::Info
-    );
+    // The editor is resolved when the menu opens, so nothing is kept per editor
+    TWeakPtr<FBlueprintEditor> WeakEditor;
+    if (const UBlueprintEditorToolMenuContext* Context = InMenu->FindContext<UBlueprintEditorToolMenuContext>())
+    {
+        WeakEditor = Context->BlueprintEditor;
+    }
 
-    // Map the Open Window command
-    CommandList->MapAction(
-        FN2CToolbarCommand::Get().OpenWindowCommand,
-        FExecuteAction::CreateLambda([this]()
-        {
-            FGlobalTabmanager::Get()->TryInvokeTab(SN2CEditorWindow::TabId);
-            FN2CLogger::Get().Log(TEXT("Node to Code window opened"), EN2CLogSeverity::Info);
-        }),
-        FCanExecuteAction::CreateLambda([]() { return true; })
-    );
+    const FCanExecuteAction InGraphMode = FCanExecuteAction::CreateLambda([WeakEditor]()
+    {
+        TSharedPtr<FBlueprintEditor> Editor = WeakEditor.Pin();
+        return Editor.IsValid() && Editor->GetCurrentMode() == FBlueprintEditorApplicationModes::StandardBlueprintEditorMode;
+    });
 
-    // Map the Collect Nodes command
-    CommandList->MapAction(
-        FN2CToolbarCommand::Get().CollectNodesCommand,
-        FExecuteAction::CreateLambda([this, WeakEditor, BlueprintName]()
-        {
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Node to Code collection triggered for Blueprint: %s"), *BlueprintName),
-                EN2CLogSeverity::Info
-            );
-            ExecuteCollectNodesForEditor(WeakEditor);
-        }),
-        FCanExecuteAction::CreateLambda([WeakEditor]()
-        {
-            TSharedPtr<FBlueprintEditor> Editor = WeakEditor.Pin();
-            if (!Editor.IsValid())
-            {
-                return false;
-            }
-            return Editor->GetCurrentMode() == FBlueprintEditorApplicationModes::StandardBlueprintEditorMode;
-        })
-    );
+    FToolMenuSection& Section = InMenu->AddSection(TEXT("NodeToCode"));
+    auto AddCommandEntry = [&Section](const TSharedPtr<FUICommandInfo>& Command, const FUIAction& Action)
+    {
+        Section.AddMenuEntry(
+            Command->GetCommandName(), Command->GetLabel(), Command->GetDescription(), Command->GetIcon(), Action);
+    };
 
-    // Map the Translate Entire Blueprint command
-    CommandList->MapAction(
-        FN2CToolbarCommand::Get().TranslateEntireBlueprintCommand,
-        FExecuteAction::CreateLambda([this, WeakEditor, BlueprintName]()
-        {
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Translate Entire Blueprint triggered for Blueprint: %s"), *BlueprintName),
-                EN2CLogSeverity::Info
-            );
-            ExecuteTranslateEntireBlueprintForEditor(WeakEditor);
-        }),
-        FCanExecuteAction::CreateLambda([WeakEditor]()
-        {
-            TSharedPtr<FBlueprintEditor> Editor = WeakEditor.Pin();
-            if (!Editor.IsValid())
-            {
-                return false;
-            }
-            return Editor->GetCurrentMode() == FBlueprintEditorApplicationModes::StandardBlueprintEditorMode;
-        })
-    );
-    
-    // Map the Copy JSON command
-    CommandList->MapAction(
-        FN2CToolbarCommand::Get().CopyJsonCommand,
-        FExecuteAction::CreateLambda([this, WeakEditor, BlueprintName]()
-        {
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Copy Blueprint JSON triggered for Blueprint: %s"), *BlueprintName),
-                EN2CLogSeverity::Info
-            );
-            ExecuteCopyJsonForEditor(WeakEditor);
-        }),
-        FCanExecuteAction::CreateLambda([WeakEditor]()
+    const FN2CToolbarCommand& Commands = FN2CToolbarCommand::Get();
+    AddCommandEntry(Commands.OpenWindowCommand, FUIAction(FExecuteAction::CreateLambda([]()
+    {
+        FGlobalTabmanager::Get()->TryInvokeTab(SN2CEditorWindow::TabId);
+        FN2CLogger::Get().Log(TEXT("Node to Code window opened"), EN2CLogSeverity::Info);
+    })));
+    AddCommandEntry(Commands.CollectNodesCommand, FUIAction(FExecuteAction::CreateLambda([this, WeakEditor]()
+    {
+        FN2CLogger::Get().Log(TEXT("Node to Code collection triggered"), EN2CLogSeverity::Info);
+        ExecuteCollectNodesForEditor(WeakEditor);
+    }), InGraphMode));
+    AddCommandEntry(Commands.CopyJsonCommand, FUIAction(FExecuteAction::CreateLambda([this, WeakEditor]()
+    {
+        FN2CLogger::Get().Log(TEXT("Copy Blueprint JSON triggered"), EN2CLogSeverity::Info);
+        ExecuteCopyJsonForEditor(WeakEditor);
+    }), InGraphMode));
+    AddCommandEntry(Commands.InspectBlueprintCommand, FUIAction(FExecuteAction::CreateLambda([this, WeakEditor]()
+    {
+        ExecuteInspectBlueprintForEditor(WeakEditor);
+    }), InGraphMode));
+    AddCommandEntry(Commands.TranslateEntireBlueprintCommand, FUIAction(FExecuteAction::CreateLambda([this, WeakEditor]()
+    {
+        FN2CLogger::Get().Log(TEXT("Translate Entire Blueprint triggered"), EN2CLogSeverity::Info);
+        ExecuteTranslateEntireBlueprintForEditor(WeakEditor);
+    }), InGraphMode));
+    AddCommandEntry(Commands.SavePreviewCommand, FUIAction(FExecuteAction::CreateLambda([]()
+    {
+        if (UN2CLLMModule* LLMModule = UN2CLLMModule::Get())
         {
-            TSharedPtr<FBlueprintEditor> Editor = WeakEditor.Pin();
-            if (!Editor.IsValid())
-            {
-                return false;
-            }
-            return Editor->GetCurrentMode() == FBlueprintEditorApplicationModes::StandardBlueprintEditorMode;
-        })
-    );
-
-    // Store in our map
-    EditorCommandLists.Add(WeakEditor, CommandList);
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Added command list to map for Blueprint: %s"), *BlueprintName),
-        EN2CLogSeverity::Info
-    );
-
-    // Add toolbar extension
-    TSharedPtr<FExtender> ToolbarExtender = MakeShareable(new FExtender);
-    ToolbarExtender->AddToolBarExtension(
-        "Asset",
-        EExtensionHook::After,
-        CommandList,
-        FToolBarExtensionDelegate::CreateLambda([CommandList](FToolBarBuilder& Builder)
-        {
-            Builder.BeginSection("NodeToCode");
-            
-            // Add dropdown button
-            Builder.AddComboButton(
-                FUIAction(),
-                FOnGetContent::CreateLambda([CommandList]() -> TSharedRef<SWidget>
-                {
-                    FMenuBuilder MenuBuilder(true, CommandList);
-                    
-                    MenuBuilder.AddMenuEntry(FN2CToolbarCommand::Get().OpenWindowCommand);
-                    MenuBuilder.AddMenuEntry(FN2CToolbarCommand::Get().CollectNodesCommand);
-                    MenuBuilder.AddMenuEntry(FN2CToolbarCommand::Get().CopyJsonCommand);
-                    MenuBuilder.AddMenuEntry(FN2CToolbarCommand::Get().TranslateEntireBlueprintCommand);
-
-                    return MenuBuilder.MakeWidget();
-                }),
-                NSLOCTEXT("NodeToCode", "NodeToCodeActions", "Node to Code"),
-                NSLOCTEXT("NodeToCode", "NodeToCodeTooltip", "Node to Code Actions"),
-                FSlateIcon("NodeToCodeStyle", "NodeToCode.ToolbarButton")
-            );
-            
-            Builder.EndSection();
-        })
-    );
-
-    // Add the extender to this specific editor
-    InEditor->AddToolbarExtender(ToolbarExtender);
-
-    InEditor->RegenerateMenusAndToolbars();
-    
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Completed toolbar registration for Blueprint: %s"), *BlueprintName), 
-        EN2CLogSeverity::Info
-    );
+            LLMModule->PersistPreviewTranslation();
+        }
+    }), FCanExecuteAction::CreateLambda([]()
+    {
+        const UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+        return LLMModule && LLMModule->HasPreviewTranslation();
+    })));
+    AddCommandEntry(Commands.CancelTranslationCommand, FUIAction(FExecuteAction::CreateLambda([this]()
+    {
+        FN2CLogger::Get().Log(TEXT("Cancel Translation triggered"), EN2CLogSeverity::Info);
+        CancelTranslation();
+    }), FCanExecuteAction::CreateLambda([this]() { return IsTranslationInProgress(); })));
 }
 
 TArray<FName> FN2CEditorIntegration::GetAvailableThemes(EN2CCodeLanguage Language) const
@@ -709,7 +1800,7 @@ void FN2CEditorIntegration::ExecuteCollectNodesForEditor(TWeakPtr<FBlueprintEdit
 {
     // Check if translation is already in progress
     UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
-    if (LLMModule && LLMModule->GetSystemStatus() == EN2CSystemStatus::Processing)
+    if (bPreparingTranslation || (LLMModule && LLMModule->GetSystemStatus() == EN2CSystemStatus::Processing))
     {
         FN2CLogger::Get().LogWarning(TEXT("Translation already in progress, please wait"));
         return;
@@ -750,99 +1841,99 @@ void FN2CEditorIntegration::ExecuteCollectNodesForEditor(TWeakPtr<FBlueprintEdit
         EN2CLogSeverity::Info
     );
 
-    // Get collector instance
-    FN2CNodeCollector& Collector = FN2CNodeCollector::Get();
-    
-    // Collect nodes using the specific editor
-    TArray<UK2Node*> CollectedNodes;
-    if (Collector.CollectNodesFromGraph(FocusedGraph, CollectedNodes))
-    {
-        FString Context = FString::Printf(TEXT("Collected %d nodes"), CollectedNodes.Num());
-        FN2CLogger::Get().Log(TEXT("Node collection successful"), EN2CLogSeverity::Info, Context);
-        
-        // Get translator instance                                                                                                                                                                        
-        FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
-
-        // Generate N2CStruct from collected nodes
-        if (Translator.GenerateN2CStruct(CollectedNodes))
-        {
-            FN2CLogger::Get().Log(TEXT("Node translation successful"), EN2CLogSeverity::Info);
-
-            // Get the Blueprint structure
-            const FN2CBlueprint& Blueprint = FN2CNodeTranslator::Get().GetN2CBlueprint();
-            
-            // Validate the generated Blueprint
-            if (Blueprint.IsValid())
+    // The live model kept since the graph last changed, or one built from its nodes now
+    const TSharedPtr<const FN2CBlueprint> Model = FN2CLiveGraphModel::Get().GetModel(FocusedGraph);
+    if (Model.IsValid())
+    {
+        FN2CLogger::Get().Log(TEXT("Node translation successful"), EN2CLogSeverity::Info);
+
+        // Validate and serialize a copy of the Blueprint structure on a worker
+        TSharedRef<const FN2CBlueprint> Blueprint = Model.ToSharedRef();
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        const EN2CJsonDialect Dialect = Settings && Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+
+        bPreparingTranslation = true;
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Blueprint, Dialect]()
+        {
+            FString JsonOutput;
+            if (Blueprint->IsValid())
             {
                 FN2CLogger::Get().Log(TEXT("Node translation validation successful"), EN2CLogSeverity::Info);
-
-                // Serialize to JSON with pretty printing enabled                                                                                                                                             
-                FN2CSerializer::SetPrettyPrint(false);
-                FString JsonOutput = FN2CSerializer::ToJson(Blueprint);                                                                                                                                       
-                                                                                                                                                                                                           
-                // Log the JSON output                                                                                                                                                                        
-                if (!JsonOutput.IsEmpty())                                                                                                                                                                    
-                {                                                                                                                                                                                             
-                    FN2CLogger::Get().Log(TEXT("JSON Output:"), EN2CLogSeverity::Debug);                                                                                                                       
-                    FN2CLogger::Get().Log(JsonOutput, EN2CLogSeverity::Debug);
-                    
-                    if (LLMModule->Initialize())
-                    {
-                        // Send JSON to LLM service                                                                                                                                                        
-                        LLMModule->ProcessN2CJson(JsonOutput, FOnLLMResponseReceived::CreateLambda(
-                            [](const FString& Response)                                                                                                                                                   
-                            {                                                                                                                                                                             
-                                FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response:\n\n%s"), *Response), EN2CLogSeverity::Debug);                                                                                                      
-                            
-                                // Create translation response struct
-                                FN2CTranslationResponse TranslationResponse;
-                            
-                                // Get active service's response parser
-                                TScriptInterface<IN2CLLMService> ActiveService = UN2CLLMModule::Get()->GetActiveService();
-                                if (ActiveService.GetInterface())
-                                {
-                                    UN2CResponseParserBase* Parser = ActiveService->GetResponseParser();
-                                    if (Parser)
-                                    {
-                                        if (Parser->ParseLLMResponse(Response, TranslationResponse))
-                                        {
-                                            // Log successful parsing
-                                            FN2CLogger::Get().Log(TEXT("Successfully parsed LLM response"), EN2CLogSeverity::Info);
-                                        }
-                                        else
-                                        {
-                                            FN2CLogger::Get().LogError(TEXT("Failed to parse LLM response"));
-                                        }
-                                    }
-                                    else
-                                    {
-                                        FN2CLogger::Get().LogError(TEXT("No response parser available"));
-                                    }
-                                }
-                                else
-                                {
-                                    FN2CLogger::Get().LogError(TEXT("No active LLM service"));
-                                }
-                            }));
-                    }
-                    else
-                    {
-                        FN2CLogger::Get().LogError(TEXT("Failed to initialize LLM Module"));
-                    }
+                JsonOutput = FN2CSerializer::ToCondensedJson(*Blueprint, Dialect);
+                if (JsonOutput.IsEmpty())
+                {
+                    FN2CLogger::Get().LogError(TEXT("JSON serialization failed"));
                 }
                 else
                 {
-                    FN2CLogger::Get().LogError(TEXT("JSON serialization failed"));
+                    // Copy JSON right after translating the same graph is then instant
+                    UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Blueprint]() { GetPrettyJson(*Blueprint); });
                 }
             }
             else
             {
                 FN2CLogger::Get().LogError(TEXT("Node translation validation failed"));
             }
-        }
-        else
-        {
-            FN2CLogger::Get().LogError(TEXT("Failed to translate nodes"));
-        }
+
+            AsyncTask(ENamedThreads::GameThread, [this, Blueprint, JsonOutput = MoveTemp(JsonOutput)]()
+            {
+                bPreparingTranslation = false;
+                if (JsonOutput.IsEmpty())
+                {
+                    return;
+                }
+
+                // Log the JSON output
+                FN2CLogger::Get().LogPayload(TEXT("JSON Output"), JsonOutput);
+
+                UN2CLLMModule* ActiveLLMModule = UN2CLLMModule::Get();
+                const UN2CSettings* RequestSettings = GetDefault<UN2CSettings>();
+                if (ActiveLLMModule && ActiveLLMModule->Initialize())
+                {
+                    // Send JSON to LLM service, once per target language
+                    const TArray<EN2CCodeLanguage> Languages = RequestSettings
+                        ? RequestSettings->GetTargetLanguages()
+                        : TArray<EN2CCodeLanguage>{ EN2CCodeLanguage::Cpp };
+
+                    // Saved with this graph's Blueprint, whatever is translated while the requests are out
+                    const TSharedRef<FN2CTranslationSession> Session = ActiveLLMModule->CreateSession(Blueprint);
+                    Session->bPreview = RequestSettings && RequestSettings->bPreviewTranslations && Languages.Num() == 1;
+
+                    // A pre-translated graph is shown at once; translating it again sends the full request
+                    if (RequestSettings && RequestSettings->bSpeculativeTranslation && Languages.Num() == 1
+                        && JsonOutput != LastSpeculativeJsonShown
+                        && ActiveLLMModule->DeliverSpeculativeTranslation(JsonOutput, FOnLLMTranslationComplete(), Session))
+                    {
+                        LastSpeculativeJsonShown = JsonOutput;
+                        FN2CLogger::Get().Log(TEXT("Showing the pre-translation of this graph, translate again for the full-quality translation"), EN2CLogSeverity::Info);
+                        return;
+                    }
+                    LastSpeculativeJsonShown.Empty();
+
+                    ActiveLLMModule->ProcessN2CJsonForLanguages(JsonOutput, Languages, FOnLLMLanguageTranslationComplete::CreateLambda(
+                        [](EN2CCodeLanguage Language, const FN2CTranslationResponse& TranslationResponse, bool bSuccess)
+                        {
+                            const FString LanguageName = StaticEnum<EN2CCodeLanguage>()->GetNameStringByValue(static_cast<int64>(Language));
+                            if (bSuccess)
+                            {
+                                // Log successful parsing
+                                FN2CLogger::Get().Log(FString::Printf(TEXT("Successfully parsed %s LLM response"), *LanguageName), EN2CLogSeverity::Info);
+                            }
+                            else
+                            {
+                                FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to parse %s LLM response"), *LanguageName));
+                            }
+                        }), INDEX_NONE, Session);
+                }
+                else
+                {
+                    FN2CLogger::Get().LogError(TEXT("Failed to initialize LLM Module"));
+                }
+            });
+        });
+    }
+    else
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to translate nodes"));
     }
 }
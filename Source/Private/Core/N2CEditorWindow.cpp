@@ -4,8 +4,13 @@
 #include "Core/N2CWidgetContainer.h"
 #include "EditorUtilityWidget.h"
 #include "EditorUtilityWidgetBlueprint.h"
+#include "LLM/N2CLLMModule.h"
 #include "Utils/N2CLogger.h"
+#include "Styling/CoreStyle.h"
 #include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Layout/SExpandableArea.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
 
 const FName SN2CEditorWindow::TabId(TEXT("NodeToCodeEditor"));
 TWeakPtr<SDockTab> SN2CEditorWindow::ActiveTab;
@@ -51,6 +56,13 @@ TSharedRef<SDockTab> SN2CEditorWindow::SpawnTab(const FSpawnTabArgs& Args)
     TSharedRef<SN2CEditorWindow> EditorWindow = SNew(SN2CEditorWindow);
     SpawnedTab->SetContent(EditorWindow);
 
+    // A translation usually follows soon after the window opens
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (LLMModule && (LLMModule->IsInitialized() || LLMModule->Initialize()))
+    {
+        LLMModule->WarmUpConnections();
+    }
+
     return SpawnedTab;
 }
 
@@ -95,11 +107,75 @@ void SN2CEditorWindow::Construct(const FArguments& InArgs)
         return;
     }
 
-    // 3) Embed the widget's Slate widget in our Nomad tab
+    // 3) Embed the widget's Slate widget in our Nomad tab, above the request metrics
     ChildSlot
     [
-        EditorWidget->TakeWidget()
+        SNew(SVerticalBox)
+        + SVerticalBox::Slot()
+        .FillHeight(1.0f)
+        [
+            EditorWidget->TakeWidget()
+        ]
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        [
+            BuildMetricsPanel()
+        ]
     ];
 
     FN2CLogger::Get().Log(TEXT("Successfully created and embedded NodeToCodeUI widget"), EN2CLogSeverity::Info);
 }
+
+TSharedRef<SWidget> SN2CEditorWindow::BuildMetricsPanel()
+{
+    RefreshMetrics(0.0, 0.0f);
+    RegisterActiveTimer(1.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SN2CEditorWindow::RefreshMetrics));
+
+    return SNew(SExpandableArea)
+        .InitiallyCollapsed(true)
+        .AreaTitle(NSLOCTEXT("NodeToCode", "MetricsTitle", "Requests"))
+        .BodyContent()
+        [
+            SNew(STextBlock)
+            .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+            .Text_Lambda([this]() { return MetricsText; })
+        ];
+}
+
+EActiveTimerReturnType SN2CEditorWindow::RefreshMetrics(double InCurrentTime, float InDeltaTime)
+{
+    if (const UN2CLLMModule* LLMModule = UN2CLLMModule::Get())
+    {
+        MetricsText = FormatMetrics(LLMModule->GetMetricsDashboard());
+    }
+    return EActiveTimerReturnType::Continue;
+}
+
+FText SN2CEditorWindow::FormatMetrics(const FN2CMetricsDashboard& Dashboard)
+{
+    FString Out = FString::Printf(TEXT("Queued %d   In flight %d   Cache hits %d batch / %d session\n"),
+        Dashboard.QueuedRequests, Dashboard.InFlightRequests, Dashboard.BatchCacheHits, Dashboard.SessionCacheHits);
+
+    const auto AppendSummaries = [&Out](const TCHAR* Title, const TArray<FN2CMetricsSummary>& Summaries)
+    {
+        float Cost = 0.0f;
+        for (const FN2CMetricsSummary& Summary : Summaries)
+        {
+            Cost += Summary.Cost;
+        }
+        Out += FString::Printf(TEXT("\n%s  $%.4f\n"), Title, Cost);
+        Out += TEXT("  Provider/Model                          Req  Fail   p50 s   p95 s   tok/s    In (cached)       Out      Cost\n");
+        for (const FN2CMetricsSummary& Summary : Summaries)
+        {
+            const FString Name = StaticEnum<EN2CLLMProvider>()->GetNameStringByValue(static_cast<int64>(Summary.Provider))
+                + TEXT("/") + Summary.Model;
+            Out += FString::Printf(TEXT("  %-38s %4d %5d %7.2f %7.2f %7.1f %8lld (%6lld) %8lld  $%.4f\n"),
+                *Name.Left(38), Summary.Requests, Summary.Failures, Summary.P50TotalSeconds, Summary.P95TotalSeconds,
+                Summary.OutputTokensPerSecond, Summary.InputTokens, Summary.CachedInputTokens, Summary.OutputTokens, Summary.Cost);
+        }
+    };
+    AppendSummaries(TEXT("Batch"), Dashboard.Batch);
+    AppendSummaries(TEXT("Session"), Dashboard.Session);
+
+    return FText::FromString(Out);
+}
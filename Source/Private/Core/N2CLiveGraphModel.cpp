@@ -0,0 +1,241 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CLiveGraphModel.h"
+
+#include "Core/N2CNodeCollector.h"
+#include "Core/N2CNodeTranslator.h"
+#include "Core/N2CSettings.h"
+#include "Utils/N2CLogger.h"
+#include "Editor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+namespace
+{
+    /** Seconds without a change before marked models are rebuilt, so a drag or a run of edits rebuilds once */
+    constexpr double RebuildIdleSeconds = 1.0;
+}
+
+FN2CLiveGraphModel& FN2CLiveGraphModel::Get()
+{
+    static FN2CLiveGraphModel Instance;
+    return Instance;
+}
+
+FN2CLiveGraphModel::FN2CLiveGraphModel()
+{
+    FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FN2CLiveGraphModel::HandleObjectModified);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FN2CLiveGraphModel::HandleObjectPropertyChanged);
+    FEditorDelegates::PostUndoRedo.AddRaw(this, &FN2CLiveGraphModel::HandleUndoRedo);
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FN2CLiveGraphModel::Tick), 0.25f);
+}
+
+bool FN2CLiveGraphModel::IsEnabled()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings && Settings->bMaintainLiveGraphModels;
+}
+
+TSharedPtr<const FN2CBlueprint> FN2CLiveGraphModel::GetModel(UEdGraph* Graph)
+{
+    if (!Graph)
+    {
+        return nullptr;
+    }
+
+    if (!IsEnabled())
+    {
+        Reset();
+        FGraphModel Model;
+        BuildModel(Graph, Model);
+        return Model.Blueprint;
+    }
+
+    FGraphModel& Model = Models.FindOrAdd(Graph);
+    if (Model.bDirty)
+    {
+        BuildModel(Graph, Model);
+    }
+    else
+    {
+        N2C_LOG(Debug, TEXT("[LiveGraphModel] Reusing the model of unchanged graph: %s"), *Graph->GetName());
+    }
+    return Model.Blueprint;
+}
+
+void FN2CLiveGraphModel::Reset()
+{
+    for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& Pair : WatchedGraphs)
+    {
+        if (UEdGraph* Graph = Pair.Key.Get())
+        {
+            Graph->RemoveOnGraphChangedHandler(Pair.Value);
+        }
+    }
+    WatchedGraphs.Empty();
+    Models.Empty();
+}
+
+void FN2CLiveGraphModel::BuildModel(UEdGraph* Graph, FGraphModel& Model)
+{
+    Model.Blueprint.Reset();
+    Model.Sources.Reset();
+    Model.Owner = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+    Model.bDirty = false;
+
+    TArray<FN2CCollectedNode> CollectedNodes;
+    FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+    if (!FN2CNodeCollector::Get().CollectNodesFromGraph(Graph, CollectedNodes) || CollectedNodes.Num() == 0
+        || !Translator.GenerateN2CStruct(CollectedNodes))
+    {
+        return;
+    }
+    Model.Blueprint = MakeShared<FN2CBlueprint>(Translator.GetN2CBlueprint());
+
+    if (IsEnabled())
+    {
+        WatchGraph(Graph);
+        for (UEdGraph* Source : Translator.GetNestedGraphs())
+        {
+            if (Source && Source != Graph)
+            {
+                Model.Sources.Add(Source);
+                WatchGraph(Source);
+            }
+        }
+    }
+}
+
+void FN2CLiveGraphModel::WatchGraph(UEdGraph* Graph)
+{
+    if (!WatchedGraphs.Contains(Graph))
+    {
+        WatchedGraphs.Add(Graph, Graph->AddOnGraphChangedHandler(
+            FOnGraphChanged::FDelegate::CreateRaw(this, &FN2CLiveGraphModel::HandleGraphChanged)));
+    }
+}
+
+void FN2CLiveGraphModel::MarkGraphDirty(const UEdGraph* Graph)
+{
+    for (TPair<TWeakObjectPtr<UEdGraph>, FGraphModel>& Pair : Models)
+    {
+        FGraphModel& Model = Pair.Value;
+        if (!Model.bDirty && (Pair.Key.Get() == Graph
+            || Model.Sources.ContainsByPredicate([Graph](const TWeakObjectPtr<UEdGraph>& Source) { return Source.Get() == Graph; })))
+        {
+            Model.bDirty = true;
+            LastChangeTime = FPlatformTime::Seconds();
+        }
+    }
+}
+
+void FN2CLiveGraphModel::MarkBlueprintDirty(const UBlueprint* Blueprint)
+{
+    for (TPair<TWeakObjectPtr<UEdGraph>, FGraphModel>& Pair : Models)
+    {
+        if (!Pair.Value.bDirty && Pair.Value.Owner.Get() == Blueprint)
+        {
+            Pair.Value.bDirty = true;
+            LastChangeTime = FPlatformTime::Seconds();
+        }
+    }
+}
+
+void FN2CLiveGraphModel::MarkAllDirty()
+{
+    for (TPair<TWeakObjectPtr<UEdGraph>, FGraphModel>& Pair : Models)
+    {
+        Pair.Value.bDirty = true;
+    }
+    LastChangeTime = FPlatformTime::Seconds();
+}
+
+void FN2CLiveGraphModel::HandleGraphChanged(const FEdGraphEditAction& Action)
+{
+    MarkGraphDirty(Action.Graph);
+}
+
+void FN2CLiveGraphModel::HandleObjectModified(UObject* Object)
+{
+    // Called for every object the editor modifies, so this stays cheap when nothing is modelled
+    if (Models.Num() == 0 || !Object)
+    {
+        return;
+    }
+
+    if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+    {
+        MarkGraphDirty(Node->GetGraph());
+    }
+    else if (const UEdGraph* Graph = Cast<UEdGraph>(Object))
+    {
+        MarkGraphDirty(Graph);
+    }
+    else if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+    {
+        MarkBlueprintDirty(Blueprint);
+    }
+    else if (Object->IsA<UScriptStruct>() || Object->IsA<UEnum>())
+    {
+        // Any model may reference the type, through a pin or a nested struct
+        MarkAllDirty();
+    }
+}
+
+void FN2CLiveGraphModel::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    HandleObjectModified(Object);
+}
+
+void FN2CLiveGraphModel::HandleUndoRedo()
+{
+    // Undo restores objects without telling which graphs they belong to
+    MarkAllDirty();
+}
+
+bool FN2CLiveGraphModel::Tick(float DeltaTime)
+{
+    if (Models.Num() == 0)
+    {
+        return true;
+    }
+
+    if (!IsEnabled())
+    {
+        Reset();
+        return true;
+    }
+
+    if (FPlatformTime::Seconds() - LastChangeTime < RebuildIdleSeconds)
+    {
+        return true;
+    }
+
+    for (auto It = WatchedGraphs.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // One rebuild per tick, so a Blueprint with many modelled graphs never hitches the editor at once
+    for (auto It = Models.CreateIterator(); It; ++It)
+    {
+        UEdGraph* Graph = It.Key().Get();
+        if (!Graph)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        if (It.Value().bDirty)
+        {
+            BuildModel(Graph, It.Value());
+            break;
+        }
+    }
+    return true;
+}
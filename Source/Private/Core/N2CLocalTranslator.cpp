@@ -0,0 +1,911 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CLocalTranslator.h"
+
+namespace
+{
+    using FPinKey = TPair<int32, int32>;
+
+    /** C++ type of a non-container value pin, or empty if it is not a plain value type */
+    FString GetScalarType(const FN2CPinDefinition& Pin)
+    {
+        static const TMap<FString, FString> StructTypes = {
+            { TEXT("Vector"), TEXT("FVector") },
+            { TEXT("Vector2D"), TEXT("FVector2D") },
+            { TEXT("Rotator"), TEXT("FRotator") },
+            { TEXT("Transform"), TEXT("FTransform") },
+            { TEXT("Quat"), TEXT("FQuat") },
+        };
+
+        switch (Pin.Type)
+        {
+        case EN2CPinType::Boolean: return TEXT("bool");
+        case EN2CPinType::Byte: return Pin.SubType.IsEmpty() ? TEXT("uint8") : FString(); // Enum bytes name their enum
+        case EN2CPinType::Integer: return TEXT("int32");
+        case EN2CPinType::Integer64: return TEXT("int64");
+        case EN2CPinType::Float: return TEXT("float");
+        case EN2CPinType::Double: return TEXT("double");
+        case EN2CPinType::Real: return Pin.SubType == TEXT("float") ? TEXT("float") : TEXT("double");
+        case EN2CPinType::String: return TEXT("FString");
+        case EN2CPinType::Name: return TEXT("FName");
+        case EN2CPinType::Text: return TEXT("FText");
+        case EN2CPinType::Vector: return TEXT("FVector");
+        case EN2CPinType::Vector2D: return TEXT("FVector2D");
+        case EN2CPinType::Rotator: return TEXT("FRotator");
+        case EN2CPinType::Transform: return TEXT("FTransform");
+        case EN2CPinType::Quat: return TEXT("FQuat");
+        case EN2CPinType::Struct:
+        {
+            const FString* StructType = StructTypes.Find(Pin.SubType);
+            return StructType ? *StructType : FString();
+        }
+        default: return FString();
+        }
+    }
+
+    /** C++ type of a value pin, or empty if the translator does not handle it */
+    FString GetValueType(const FN2CPinDefinition& Pin)
+    {
+        if (Pin.bIsMap || Pin.bIsSet)
+        {
+            return FString();
+        }
+        const FString Scalar = GetScalarType(Pin);
+        return Pin.bIsArray && !Scalar.IsEmpty() ? FString::Printf(TEXT("TArray<%s>"), *Scalar) : Scalar;
+    }
+
+    bool IsPassedByValue(const FN2CPinDefinition& Pin)
+    {
+        switch (Pin.Type)
+        {
+        case EN2CPinType::Boolean:
+        case EN2CPinType::Byte:
+        case EN2CPinType::Integer:
+        case EN2CPinType::Integer64:
+        case EN2CPinType::Float:
+        case EN2CPinType::Double:
+        case EN2CPinType::Real:
+            return !Pin.bIsArray;
+        default:
+            return false;
+        }
+    }
+
+    /** The object a call or variable node acts on, which is self unless connected */
+    bool IsSelfPin(const FN2CPinDefinition& Pin)
+    {
+        return (Pin.Type == EN2CPinType::Object || Pin.Type == EN2CPinType::Self)
+            && (Pin.Name.Equals(TEXT("Target"), ESearchCase::IgnoreCase) || Pin.Name.Equals(TEXT("self"), ESearchCase::IgnoreCase));
+    }
+
+    /** Name with everything but letters, digits and underscores dropped */
+    FString MakeIdentifier(const FString& Name)
+    {
+        FString Identifier;
+        Identifier.Reserve(Name.Len());
+        for (const TCHAR Char : Name)
+        {
+            if (FChar::IsAlnum(Char) || Char == TEXT('_'))
+            {
+                Identifier.AppendChar(Char);
+            }
+        }
+        if (Identifier.IsEmpty() || FChar::IsDigit(Identifier[0]))
+        {
+            Identifier.InsertAt(0, TEXT('_'));
+        }
+        return Identifier;
+    }
+
+    FString EscapeString(const FString& Value)
+    {
+        return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+    }
+
+    /** Split a "X,Y,Z" default into three numbers; an empty default is all zeros */
+    bool ParseTriple(const FString& Value, TArray<FString>& OutParts)
+    {
+        if (Value.IsEmpty())
+        {
+            OutParts = { TEXT("0.0"), TEXT("0.0"), TEXT("0.0") };
+            return true;
+        }
+
+        Value.ParseIntoArray(OutParts, TEXT(","));
+        if (OutParts.Num() != 3)
+        {
+            return false;
+        }
+        for (FString& Part : OutParts)
+        {
+            Part.TrimStartAndEndInline();
+            if (!FCString::IsNumeric(*Part))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Infix operator that a math library call is written as, or null */
+    const TCHAR* FindOperator(const FN2CNodeDefinition& Node, int32 NumArgs)
+    {
+        struct FOperator
+        {
+            const TCHAR* Prefix;
+            const TCHAR* Symbol;
+            bool bVariadic;
+        };
+
+        // Integer division and modulo guard against zero in Blueprint, so they stay calls
+        static const FOperator Operators[] = {
+            { TEXT("Add_"), TEXT("+"), true },
+            { TEXT("Subtract_"), TEXT("-"), false },
+            { TEXT("Multiply_"), TEXT("*"), true },
+            { TEXT("Less_"), TEXT("<"), false },
+            { TEXT("LessEqual_"), TEXT("<="), false },
+            { TEXT("Greater_"), TEXT(">"), false },
+            { TEXT("GreaterEqual_"), TEXT(">="), false },
+            { TEXT("EqualEqual_"), TEXT("=="), false },
+            { TEXT("NotEqual_"), TEXT("!="), false },
+            { TEXT("BooleanAND"), TEXT("&&"), true },
+            { TEXT("BooleanOR"), TEXT("||"), true },
+        };
+
+        if (Node.GetCleanMemberParent() != TEXT("KismetMathLibrary"))
+        {
+            return nullptr;
+        }
+        for (const FOperator& Operator : Operators)
+        {
+            if (Node.MemberName.StartsWith(Operator.Prefix, ESearchCase::CaseSensitive)
+                && (NumArgs == 2 || (Operator.bVariadic && NumArgs > 2)))
+            {
+                return Operator.Symbol;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Expression text, and whether it needs parentheses as an operand */
+    struct FExpression
+    {
+        FString Text;
+        bool bOperator = false;
+
+        FString AsOperand() const { return bOperator ? FString::Printf(TEXT("(%s)"), *Text) : Text; }
+    };
+
+    /** One graph's translation, written as its exec chain is walked */
+    class FLocalEmitter
+    {
+    public:
+        FLocalEmitter(const FN2CGraph& InGraph, EN2CCodeLanguage Language)
+            : Graph(InGraph)
+            , bCpp(Language == EN2CCodeLanguage::Cpp)
+        {
+        }
+
+        bool Emit(const FN2CMetadata& Metadata, FN2CGraphTranslation& OutTranslation);
+
+    private:
+        bool Prepare();
+        bool WalkExecChain();
+
+        bool EmitCall(int32 NodeIndex);
+        bool EmitVariableSet(int32 NodeIndex);
+        bool EmitBranch(int32 NodeIndex);
+        bool EmitReturn(int32 NodeIndex);
+
+        /** Value reaching an input pin, from its link or its default */
+        bool InputExpression(int32 NodeIndex, int32 PinIndex, FExpression& Out, int32 Depth) const;
+        bool OutputExpression(int32 NodeIndex, int32 PinIndex, FExpression& Out, int32 Depth) const;
+        bool CallExpression(int32 NodeIndex, FExpression& Out, int32 Depth) const;
+        bool Literal(const FN2CPinDefinition& Pin, FString& Out) const;
+
+        /** The single input pin that is neither exec nor self, or INDEX_NONE */
+        static int32 FindValueInput(const FN2CNodeDefinition& Node);
+
+        FString MakeUniqueName(const FString& Base);
+        void AddLine(const FString& Line);
+
+        const FN2CGraph& Graph;
+        const bool bCpp;
+
+        int32 EntryIndex = INDEX_NONE;
+
+        /** Input pins of the result nodes that define what the function returns */
+        TArray<FN2CPinDefinition> ReturnPins;
+
+        TArray<TArray<int32>> Successors;
+
+        /** Output pin feeding each linked input pin */
+        TMap<FPinKey, FPinKey> Sources;
+
+        /** Output pins read through a link */
+        TSet<FPinKey> LinkedOutputs;
+
+        /** Parameters and stored call results, named by their output pin */
+        TMap<FPinKey, FString> Names;
+        TSet<FString> UsedNames;
+
+        TArray<FString> Lines;
+        int32 Indent = 1;
+        int32 NumBranches = 0;
+    };
+
+    bool FLocalEmitter::Prepare()
+    {
+        for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+        {
+            const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+            switch (Node.NodeType)
+            {
+            case EN2CNodeType::FunctionEntry:
+                if (EntryIndex != INDEX_NONE)
+                {
+                    return false;
+                }
+                EntryIndex = NodeIndex;
+                break;
+            case EN2CNodeType::FunctionResult:
+                if (ReturnPins.Num() == 0)
+                {
+                    ReturnPins = Node.InputPins.FilterByPredicate([](const FN2CPinDefinition& Pin) { return Pin.Type != EN2CPinType::Exec; });
+                }
+                break;
+            case EN2CNodeType::VariableGet:
+            case EN2CNodeType::VariableSet:
+            case EN2CNodeType::CallFunction:
+            case EN2CNodeType::Branch:
+                break;
+            default:
+                return false;
+            }
+
+            if (Node.bLatent)
+            {
+                return false;
+            }
+
+            // Every value must have a type the declaration and locals can be written with
+            for (int32 PinIndex = 0; PinIndex < Node.NumPins(); ++PinIndex)
+            {
+                const FN2CPinDefinition& Pin = *Node.GetPin(PinIndex);
+                const bool bInput = PinIndex < Node.InputPins.Num();
+                if (Pin.Type == EN2CPinType::Exec || (bInput && IsSelfPin(Pin) && !Pin.bConnected))
+                {
+                    continue;
+                }
+                if (GetValueType(Pin).IsEmpty())
+                {
+                    return false;
+                }
+            }
+        }
+        if (EntryIndex == INDEX_NONE)
+        {
+            return false;
+        }
+
+        Successors.SetNum(Graph.Nodes.Num());
+        for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
+        {
+            const TConstArrayView<int32> Chain = Graph.Flows.GetExecutionChain(ChainIndex);
+            for (int32 Step = 1; Step < Chain.Num(); ++Step)
+            {
+                if (!Graph.Nodes.IsValidIndex(Chain[Step - 1]) || !Graph.Nodes.IsValidIndex(Chain[Step]))
+                {
+                    return false;
+                }
+                Successors[Chain[Step - 1]].AddUnique(Chain[Step]);
+            }
+        }
+
+        for (const FN2CDataFlow& Flow : Graph.Flows.Data)
+        {
+            if (!Graph.Nodes.IsValidIndex(Flow.SourceNode) || !Graph.Nodes.IsValidIndex(Flow.TargetNode))
+            {
+                return false;
+            }
+            Sources.Add(FPinKey(Flow.TargetNode, Flow.TargetPin), FPinKey(Flow.SourceNode, Flow.SourcePin));
+            LinkedOutputs.Add(FPinKey(Flow.SourceNode, Flow.SourcePin));
+        }
+
+        // Member variables, parameters and locals share one scope
+        for (const FN2CNodeDefinition& Node : Graph.Nodes)
+        {
+            if (Node.NodeType == EN2CNodeType::VariableGet || Node.NodeType == EN2CNodeType::VariableSet)
+            {
+                UsedNames.Add(MakeIdentifier(Node.MemberName));
+            }
+        }
+        const FN2CNodeDefinition& Entry = Graph.Nodes[EntryIndex];
+        for (int32 OutputIndex = 0; OutputIndex < Entry.OutputPins.Num(); ++OutputIndex)
+        {
+            const FN2CPinDefinition& Pin = Entry.OutputPins[OutputIndex];
+            if (Pin.Type != EN2CPinType::Exec)
+            {
+                Names.Add(FPinKey(EntryIndex, Entry.InputPins.Num() + OutputIndex), MakeUniqueName(MakeIdentifier(Pin.Name)));
+            }
+        }
+        for (const FN2CPinDefinition& Pin : ReturnPins)
+        {
+            const FString ReturnName = MakeIdentifier(Pin.Name);
+            if (UsedNames.Contains(ReturnName))
+            {
+                return false;
+            }
+            UsedNames.Add(ReturnName);
+        }
+        return true;
+    }
+
+    bool FLocalEmitter::WalkExecChain()
+    {
+        TSet<int32> Visited;
+        int32 OpenBlocks = 0;
+        bool bReturned = false;
+        int32 Current = EntryIndex;
+        while (!bReturned)
+        {
+            // Several successors are a sequence or a branch with both outputs linked
+            const TArray<int32>& Next = Successors[Current];
+            if (Next.Num() > 1)
+            {
+                return false;
+            }
+            if (Next.Num() == 0)
+            {
+                break;
+            }
+
+            Current = Next[0];
+            bool bAlreadyVisited = false;
+            Visited.Add(Current, &bAlreadyVisited);
+            if (bAlreadyVisited)
+            {
+                return false;
+            }
+
+            bool bEmitted = false;
+            switch (Graph.Nodes[Current].NodeType)
+            {
+            case EN2CNodeType::CallFunction:
+                bEmitted = !Graph.Nodes[Current].bPure && EmitCall(Current);
+                break;
+            case EN2CNodeType::VariableSet:
+                bEmitted = EmitVariableSet(Current);
+                break;
+            case EN2CNodeType::Branch:
+                bEmitted = EmitBranch(Current);
+                OpenBlocks += bEmitted ? 1 : 0;
+                break;
+            case EN2CNodeType::FunctionResult:
+                bEmitted = Successors[Current].Num() == 0 && EmitReturn(Current);
+                bReturned = true;
+                break;
+            default:
+                break;
+            }
+            if (!bEmitted)
+            {
+                return false;
+            }
+        }
+
+        // Outputs must be set on every path, which a branch with one linked output does not do
+        if (ReturnPins.Num() > 0 && (!bReturned || NumBranches > 0))
+        {
+            return false;
+        }
+
+        for (; OpenBlocks > 0; --OpenBlocks)
+        {
+            --Indent;
+            AddLine(bCpp ? TEXT("}") : TEXT("ENDIF"));
+        }
+        return true;
+    }
+
+    bool FLocalEmitter::EmitCall(int32 NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+
+        int32 ResultPin = INDEX_NONE;
+        for (int32 OutputIndex = 0; OutputIndex < Node.OutputPins.Num(); ++OutputIndex)
+        {
+            if (Node.OutputPins[OutputIndex].Type == EN2CPinType::Exec)
+            {
+                continue;
+            }
+            // Output parameters beyond the return value would need locals of their own
+            if (ResultPin != INDEX_NONE)
+            {
+                return false;
+            }
+            ResultPin = Node.InputPins.Num() + OutputIndex;
+        }
+
+        FExpression Call;
+        if (!CallExpression(NodeIndex, Call, 0))
+        {
+            return false;
+        }
+
+        if (ResultPin == INDEX_NONE || !LinkedOutputs.Contains(FPinKey(NodeIndex, ResultPin)))
+        {
+            AddLine(bCpp ? FString::Printf(TEXT("%s;"), *Call.Text) : FString::Printf(TEXT("CALL %s"), *Call.Text));
+            return true;
+        }
+
+        // A result read later is stored, since the call runs once
+        const FN2CPinDefinition& Result = *Node.GetPin(ResultPin);
+        const FString ResultName = MakeUniqueName(MakeIdentifier(Node.MemberName) + TEXT("Result"));
+        Names.Add(FPinKey(NodeIndex, ResultPin), ResultName);
+        AddLine(bCpp
+            ? FString::Printf(TEXT("const %s %s = %s;"), *GetValueType(Result), *ResultName, *Call.Text)
+            : FString::Printf(TEXT("SET %s TO %s"), *ResultName, *Call.Text));
+        return true;
+    }
+
+    bool FLocalEmitter::EmitVariableSet(int32 NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+        const int32 ValuePin = FindValueInput(Node);
+        FExpression Value;
+        if (Node.MemberName.IsEmpty() || ValuePin == INDEX_NONE || !InputExpression(NodeIndex, ValuePin, Value, 0))
+        {
+            return false;
+        }
+
+        const FString Variable = MakeIdentifier(Node.MemberName);
+        AddLine(bCpp ? FString::Printf(TEXT("%s = %s;"), *Variable, *Value.Text) : FString::Printf(TEXT("SET %s TO %s"), *Variable, *Value.Text));
+        return true;
+    }
+
+    bool FLocalEmitter::EmitBranch(int32 NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+
+        // The first exec output runs when the condition is true
+        int32 NumExecOutputs = 0;
+        int32 LinkedOutput = INDEX_NONE;
+        for (const FN2CPinDefinition& Pin : Node.OutputPins)
+        {
+            if (Pin.Type != EN2CPinType::Exec)
+            {
+                continue;
+            }
+            if (Pin.bConnected)
+            {
+                if (LinkedOutput != INDEX_NONE)
+                {
+                    return false;
+                }
+                LinkedOutput = NumExecOutputs;
+            }
+            NumExecOutputs++;
+        }
+        if (LinkedOutput == INDEX_NONE || LinkedOutput > 1 || Successors[NodeIndex].Num() != 1)
+        {
+            return false;
+        }
+
+        const int32 ConditionPin = FindValueInput(Node);
+        FExpression Condition;
+        if (ConditionPin == INDEX_NONE || !InputExpression(NodeIndex, ConditionPin, Condition, 0))
+        {
+            return false;
+        }
+
+        if (bCpp)
+        {
+            AddLine(LinkedOutput == 0 ? FString::Printf(TEXT("if (%s)"), *Condition.Text) : FString::Printf(TEXT("if (!%s)"), *Condition.AsOperand()));
+            AddLine(TEXT("{"));
+        }
+        else
+        {
+            AddLine(LinkedOutput == 0 ? FString::Printf(TEXT("IF %s THEN"), *Condition.Text) : FString::Printf(TEXT("IF NOT %s THEN"), *Condition.AsOperand()));
+        }
+        ++Indent;
+        ++NumBranches;
+        return true;
+    }
+
+    bool FLocalEmitter::EmitReturn(int32 NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+
+        TArray<FString> Values;
+        int32 NumReturned = 0;
+        for (int32 PinIndex = 0; PinIndex < Node.InputPins.Num(); ++PinIndex)
+        {
+            const FN2CPinDefinition& Pin = Node.InputPins[PinIndex];
+            if (Pin.Type == EN2CPinType::Exec)
+            {
+                continue;
+            }
+            if (!ReturnPins.IsValidIndex(NumReturned) || ReturnPins[NumReturned].Name != Pin.Name)
+            {
+                return false;
+            }
+            NumReturned++;
+
+            FExpression Value;
+            if (!InputExpression(NodeIndex, PinIndex, Value, 0))
+            {
+                return false;
+            }
+            Values.Add(Value.Text);
+        }
+        if (NumReturned != ReturnPins.Num())
+        {
+            return false;
+        }
+
+        if (Values.Num() == 1)
+        {
+            AddLine(bCpp ? FString::Printf(TEXT("return %s;"), *Values[0]) : FString::Printf(TEXT("RETURN %s"), *Values[0]));
+        }
+        else if (bCpp)
+        {
+            // Several outputs are reference parameters
+            for (int32 ValueIndex = 0; ValueIndex < Values.Num(); ++ValueIndex)
+            {
+                AddLine(FString::Printf(TEXT("%s = %s;"), *MakeIdentifier(ReturnPins[ValueIndex].Name), *Values[ValueIndex]));
+            }
+        }
+        else if (Values.Num() > 1)
+        {
+            AddLine(FString::Printf(TEXT("RETURN %s"), *FString::Join(Values, TEXT(", "))));
+        }
+        return true;
+    }
+
+    bool FLocalEmitter::InputExpression(int32 NodeIndex, int32 PinIndex, FExpression& Out, int32 Depth) const
+    {
+        if (const FPinKey* Source = Sources.Find(FPinKey(NodeIndex, PinIndex)))
+        {
+            return OutputExpression(Source->Key, Source->Value, Out, Depth);
+        }
+
+        const FN2CPinDefinition* Pin = Graph.Nodes[NodeIndex].GetPin(PinIndex);
+        if (!Pin || Pin->bConnected)
+        {
+            return false;
+        }
+        Out.bOperator = false;
+        return Literal(*Pin, Out.Text);
+    }
+
+    bool FLocalEmitter::OutputExpression(int32 NodeIndex, int32 PinIndex, FExpression& Out, int32 Depth) const
+    {
+        // Pure nodes are inlined where they are read, so a cycle of them would never end
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+        if (Depth > Graph.Nodes.Num() || PinIndex < Node.InputPins.Num() || !Node.GetPin(PinIndex))
+        {
+            return false;
+        }
+
+        if (const FString* Name = Names.Find(FPinKey(NodeIndex, PinIndex)))
+        {
+            Out.Text = *Name;
+            Out.bOperator = false;
+            return true;
+        }
+
+        switch (Node.NodeType)
+        {
+        case EN2CNodeType::VariableGet:
+        case EN2CNodeType::VariableSet:
+            if (Node.MemberName.IsEmpty() || Node.InputPins.ContainsByPredicate([](const FN2CPinDefinition& Pin) { return IsSelfPin(Pin) && Pin.bConnected; }))
+            {
+                return false;
+            }
+            Out.Text = MakeIdentifier(Node.MemberName);
+            Out.bOperator = false;
+            return true;
+        case EN2CNodeType::CallFunction:
+            // Impure results are only readable once stored, after their call ran
+            return Node.bPure && Node.OutputPins.Num() == 1 && CallExpression(NodeIndex, Out, Depth + 1);
+        default:
+            return false;
+        }
+    }
+
+    bool FLocalEmitter::CallExpression(int32 NodeIndex, FExpression& Out, int32 Depth) const
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+        if (Node.MemberName.IsEmpty())
+        {
+            return false;
+        }
+
+        TArray<FExpression> Args;
+        bool bHasSelf = false;
+        for (int32 PinIndex = 0; PinIndex < Node.InputPins.Num(); ++PinIndex)
+        {
+            const FN2CPinDefinition& Pin = Node.InputPins[PinIndex];
+            if (Pin.Type == EN2CPinType::Exec)
+            {
+                continue;
+            }
+            if (IsSelfPin(Pin))
+            {
+                // Calls on other objects need object values, which the translator does not handle
+                if (Pin.bConnected)
+                {
+                    return false;
+                }
+                bHasSelf = true;
+                continue;
+            }
+
+            FExpression& Arg = Args.AddDefaulted_GetRef();
+            if (!InputExpression(NodeIndex, PinIndex, Arg, Depth))
+            {
+                return false;
+            }
+        }
+
+        if (const TCHAR* Operator = !bHasSelf ? FindOperator(Node, Args.Num()) : nullptr)
+        {
+            TArray<FString> Operands;
+            for (const FExpression& Arg : Args)
+            {
+                Operands.Add(Arg.AsOperand());
+            }
+            Out.Text = FString::Join(Operands, *FString::Printf(TEXT(" %s "), Operator));
+            Out.bOperator = true;
+            return true;
+        }
+        if (!bHasSelf && Node.GetCleanMemberParent() == TEXT("KismetMathLibrary") && Node.MemberName == TEXT("Not_PreBool") && Args.Num() == 1)
+        {
+            Out.Text = bCpp ? FString::Printf(TEXT("!%s"), *Args[0].AsOperand()) : FString::Printf(TEXT("NOT %s"), *Args[0].AsOperand());
+            Out.bOperator = false;
+            return true;
+        }
+
+        // Calls without a target are static, and only function libraries can be named from here
+        const FString Parent = Node.GetCleanMemberParent();
+        if (!bHasSelf && !Parent.EndsWith(TEXT("Library")))
+        {
+            return false;
+        }
+
+        TArray<FString> ArgTexts;
+        for (const FExpression& Arg : Args)
+        {
+            ArgTexts.Add(Arg.Text);
+        }
+        const FString Callee = bHasSelf || !bCpp ? Node.MemberName : FString::Printf(TEXT("U%s::%s"), *Parent, *Node.MemberName);
+        Out.Text = FString::Printf(TEXT("%s(%s)"), *Callee, *FString::Join(ArgTexts, TEXT(", ")));
+        Out.bOperator = false;
+        return true;
+    }
+
+    bool FLocalEmitter::Literal(const FN2CPinDefinition& Pin, FString& Out) const
+    {
+        if (Pin.bIsArray)
+        {
+            return false;
+        }
+
+        const FString Value = Pin.DefaultValue.TrimStartAndEnd();
+        const bool bStructVector = Pin.Type == EN2CPinType::Struct && Pin.SubType == TEXT("Vector");
+        const bool bStructRotator = Pin.Type == EN2CPinType::Struct && Pin.SubType == TEXT("Rotator");
+        switch (Pin.Type)
+        {
+        case EN2CPinType::Boolean:
+            if (!Value.IsEmpty() && !Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) && !Value.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+            {
+                return false;
+            }
+            Out = Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) ? TEXT("true") : TEXT("false");
+            return true;
+        case EN2CPinType::Byte:
+        case EN2CPinType::Integer:
+        case EN2CPinType::Integer64:
+            if (!Value.IsEmpty() && (!FCString::IsNumeric(*Value) || Value.Contains(TEXT("."))))
+            {
+                return false;
+            }
+            Out = Value.IsEmpty() ? TEXT("0") : Value;
+            return true;
+        case EN2CPinType::Float:
+        case EN2CPinType::Double:
+        case EN2CPinType::Real:
+        {
+            if (!Value.IsEmpty() && !FCString::IsNumeric(*Value))
+            {
+                return false;
+            }
+            Out = Value.IsEmpty() ? TEXT("0") : Value;
+            if (!Out.Contains(TEXT(".")) && !Out.Contains(TEXT("e")))
+            {
+                Out += TEXT(".0");
+            }
+            if (bCpp && GetScalarType(Pin) == TEXT("float"))
+            {
+                Out += TEXT("f");
+            }
+            return true;
+        }
+        case EN2CPinType::String:
+            Out = bCpp ? FString::Printf(TEXT("TEXT(\"%s\")"), *EscapeString(Pin.DefaultValue)) : FString::Printf(TEXT("\"%s\""), *EscapeString(Pin.DefaultValue));
+            return true;
+        case EN2CPinType::Name:
+            if (bCpp)
+            {
+                Out = Value.IsEmpty() || Value == TEXT("None") ? TEXT("NAME_None") : FString::Printf(TEXT("FName(TEXT(\"%s\"))"), *EscapeString(Value));
+            }
+            else
+            {
+                Out = FString::Printf(TEXT("\"%s\""), *EscapeString(Value));
+            }
+            return true;
+        case EN2CPinType::Text:
+            // Text literals need a localization key, which only the LLM can make up
+            if (!Pin.DefaultValue.IsEmpty())
+            {
+                return false;
+            }
+            Out = bCpp ? TEXT("FText::GetEmpty()") : TEXT("\"\"");
+            return true;
+        default:
+            break;
+        }
+
+        if (Pin.Type == EN2CPinType::Vector || Pin.Type == EN2CPinType::Rotator || bStructVector || bStructRotator)
+        {
+            TArray<FString> Parts;
+            if (!ParseTriple(Value, Parts))
+            {
+                return false;
+            }
+            // Rotator defaults are pitch, yaw and roll, as FRotator's constructor takes them
+            const TCHAR* Type = Pin.Type == EN2CPinType::Vector || bStructVector ? TEXT("FVector") : TEXT("FRotator");
+            Out = bCpp
+                ? FString::Printf(TEXT("%s(%s)"), Type, *FString::Join(Parts, TEXT(", ")))
+                : FString::Printf(TEXT("(%s)"), *FString::Join(Parts, TEXT(", ")));
+            return true;
+        }
+        return false;
+    }
+
+    int32 FLocalEmitter::FindValueInput(const FN2CNodeDefinition& Node)
+    {
+        int32 ValuePin = INDEX_NONE;
+        for (int32 PinIndex = 0; PinIndex < Node.InputPins.Num(); ++PinIndex)
+        {
+            const FN2CPinDefinition& Pin = Node.InputPins[PinIndex];
+            if (Pin.Type == EN2CPinType::Exec || (IsSelfPin(Pin) && !Pin.bConnected))
+            {
+                continue;
+            }
+            if (ValuePin != INDEX_NONE)
+            {
+                return INDEX_NONE;
+            }
+            ValuePin = PinIndex;
+        }
+        return ValuePin;
+    }
+
+    FString FLocalEmitter::MakeUniqueName(const FString& Base)
+    {
+        FString Name = Base;
+        for (int32 Suffix = 2; UsedNames.Contains(Name); ++Suffix)
+        {
+            Name = FString::Printf(TEXT("%s%d"), *Base, Suffix);
+        }
+        UsedNames.Add(Name);
+        return Name;
+    }
+
+    void FLocalEmitter::AddLine(const FString& Line)
+    {
+        Lines.Add(FString::ChrN(Indent * 4, TEXT(' ')) + Line);
+    }
+
+    bool FLocalEmitter::Emit(const FN2CMetadata& Metadata, FN2CGraphTranslation& OutTranslation)
+    {
+        if (!Prepare() || !WalkExecChain())
+        {
+            return false;
+        }
+
+        const FN2CNodeDefinition& Entry = Graph.Nodes[EntryIndex];
+        const FString FunctionName = MakeIdentifier(Graph.Name);
+        FString ClassName = Metadata.BlueprintClass.IsEmpty() ? Metadata.Name : Metadata.BlueprintClass;
+        ClassName.RemoveFromStart(TEXT("SKEL_"));
+        ClassName.RemoveFromEnd(TEXT("_C"));
+
+        TArray<FString> Params;
+        for (int32 OutputIndex = 0; OutputIndex < Entry.OutputPins.Num(); ++OutputIndex)
+        {
+            const FN2CPinDefinition& Pin = Entry.OutputPins[OutputIndex];
+            if (Pin.Type == EN2CPinType::Exec)
+            {
+                continue;
+            }
+
+            const FString& Name = Names.FindChecked(FPinKey(EntryIndex, Entry.InputPins.Num() + OutputIndex));
+            if (!bCpp)
+            {
+                Params.Add(Name);
+            }
+            else if (Pin.bIsReference)
+            {
+                Params.Add(FString::Printf(TEXT("%s& %s"), *GetValueType(Pin), *Name));
+            }
+            else
+            {
+                Params.Add(FString::Printf(IsPassedByValue(Pin) ? TEXT("%s %s") : TEXT("const %s& %s"), *GetValueType(Pin), *Name));
+            }
+        }
+
+        FString ReturnType = TEXT("void");
+        if (ReturnPins.Num() == 1)
+        {
+            ReturnType = GetValueType(ReturnPins[0]);
+        }
+        else if (bCpp)
+        {
+            for (const FN2CPinDefinition& Pin : ReturnPins)
+            {
+                Params.Add(FString::Printf(TEXT("%s& %s"), *GetValueType(Pin), *MakeIdentifier(Pin.Name)));
+            }
+        }
+
+        const FString ParamList = FString::Join(Params, TEXT(", "));
+        const FString Body = FString::Join(Lines, TEXT("\n"));
+
+        OutTranslation = FN2CGraphTranslation();
+        OutTranslation.GraphName = Graph.Name;
+        OutTranslation.GraphType = TEXT("Function");
+        OutTranslation.GraphClass = Metadata.BlueprintClass;
+        if (bCpp)
+        {
+            OutTranslation.Code.GraphDeclaration = FString::Printf(TEXT("UFUNCTION(BlueprintCallable)\n%s %s(%s);"), *ReturnType, *FunctionName, *ParamList);
+            OutTranslation.Code.GraphImplementation = FString::Printf(TEXT("%s %s::%s(%s)\n{\n%s%s}"),
+                *ReturnType, *ClassName, *FunctionName, *ParamList, *Body, Lines.Num() > 0 ? TEXT("\n") : TEXT(""));
+        }
+        else
+        {
+            OutTranslation.Code.GraphImplementation = FString::Printf(TEXT("```\nFUNCTION %s(%s)\n%s%sENDFUNCTION\n```"),
+                *FunctionName, *ParamList, *Body, Lines.Num() > 0 ? TEXT("\n") : TEXT(""));
+        }
+        OutTranslation.Code.ImplementationNotes = TEXT("Translated directly from the graph's nodes without an LLM, as the graph is a short sequence of variable and function-call nodes.");
+        return true;
+    }
+}
+
+bool FN2CLocalTranslator::SupportsLanguage(EN2CCodeLanguage Language)
+{
+    return Language == EN2CCodeLanguage::Cpp || Language == EN2CCodeLanguage::Pseudocode;
+}
+
+bool FN2CLocalTranslator::TryTranslate(
+    const FN2CGraph& Graph,
+    const FN2CMetadata& Metadata,
+    EN2CCodeLanguage Language,
+    int32 MaxNodes,
+    FN2CGraphTranslation& OutTranslation)
+{
+    if (Graph.GraphType != EN2CGraphType::Function || Graph.Nodes.Num() == 0 || Graph.Nodes.Num() > MaxNodes
+        || Graph.LocalVariables.Num() > 0 || !SupportsLanguage(Language))
+    {
+        return false;
+    }
+
+    FN2CGraphTranslation Translation;
+    FLocalEmitter Emitter(Graph, Language);
+    if (!Emitter.Emit(Metadata, Translation))
+    {
+        return false;
+    }
+    OutTranslation = MoveTemp(Translation);
+    return true;
+}
@@ -0,0 +1,468 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CModelBenchmarkCommandlet.h"
+
+#include "Containers/Ticker.h"
+#include "Core/N2CNodeTranslator.h"
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSettings.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "LLM/N2CLLMModels.h"
+#include "LLM/N2CLLMModule.h"
+#include "LLM/N2CRequestMetrics.h"
+#include "LLM/N2CTranslationOutputWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Value below which Percentile percent of the samples fall, or -1 if there are none */
+    double GetPercentile(TArray<double> Samples, double Percentile)
+    {
+        if (Samples.Num() == 0)
+        {
+            return -1.0;
+        }
+        Samples.Sort();
+        return Samples[FMath::Clamp(FMath::CeilToInt(Samples.Num() * Percentile / 100.0) - 1, 0, Samples.Num() - 1)];
+    }
+
+    /** Find a model enum value by its name or by the model id it stands for */
+    template <typename TEnum>
+    bool FindModel(const FString& Name, FString (*GetValue)(TEnum), TEnum& OutModel)
+    {
+        const UEnum* Enum = StaticEnum<TEnum>();
+        for (int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+        {
+            const TEnum Model = static_cast<TEnum>(Enum->GetValueByIndex(Index));
+            if (Enum->GetNameStringByIndex(Index).Equals(Name, ESearchCase::IgnoreCase) || GetValue(Model).Equals(Name, ESearchCase::IgnoreCase))
+            {
+                OutModel = Model;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+UN2CModelBenchmarkCommandlet::UN2CModelBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UN2CModelBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    TArray<FString> ConfigSpecs;
+    if (const FString* ConfigsParam = ParamVals.Find(TEXT("Configs")))
+    {
+        ConfigsParam->ParseIntoArray(ConfigSpecs, TEXT("+"));
+    }
+    TArray<FModelConfig> ModelConfigs;
+    for (const FString& Spec : ConfigSpecs)
+    {
+        FModelConfig& ModelConfig = ModelConfigs.AddDefaulted_GetRef();
+        if (!ParseConfig(Spec, ModelConfig))
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Unknown provider or model: %s"), *Spec), TEXT("Benchmark"));
+            return 1;
+        }
+    }
+    if (ModelConfigs.Num() == 0)
+    {
+        FN2CLogger::Get().LogError(TEXT("No configurations given, pass -Configs=Provider:Model+Provider:Model"), TEXT("Benchmark"));
+        return 1;
+    }
+
+    if (const FString* RepeatParam = ParamVals.Find(TEXT("Repeat")))
+    {
+        Repeat = FMath::Max(1, FCString::Atoi(**RepeatParam));
+    }
+    if (const FString* TimeoutParam = ParamVals.Find(TEXT("Timeout")))
+    {
+        TimeoutSeconds = FMath::Max(1.0, FCString::Atod(**TimeoutParam));
+    }
+
+    TArray<FString> AssetPaths;
+    if (const FString* AssetsParam = ParamVals.Find(TEXT("Assets")))
+    {
+        AssetsParam->ParseIntoArray(AssetPaths, TEXT("+"));
+    }
+    const FString* CorpusParam = ParamVals.Find(TEXT("Corpus"));
+    if (!LoadCorpus(CorpusParam ? *CorpusParam : FString(), AssetPaths))
+    {
+        return 1;
+    }
+
+    FString OutputPath;
+    if (const FString* OutputParam = ParamVals.Find(TEXT("Output")))
+    {
+        OutputPath = *OutputParam;
+    }
+    if (OutputPath.IsEmpty())
+    {
+        OutputPath = FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Benchmarks")
+            / FString::Printf(TEXT("Models-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    }
+    const FString OutputRoot = FPaths::GetPath(OutputPath) / FPaths::GetBaseFilename(OutputPath);
+
+    // Every request must reach its provider, and only the configuration being measured may serve it.
+    // The settings are changed for this process only and never saved
+    UN2CSettings* Settings = GetMutableDefault<UN2CSettings>();
+    Settings->bUseTranslationCache = false;
+    Settings->bRouteAcrossProviders = false;
+    Settings->bDraftThenRefine = false;
+    Settings->bSpeculativeTranslation = false;
+
+    TArray<TSharedPtr<FJsonValue>> ConfigReports;
+    int32 Failures = 0;
+    for (int32 Index = 0; Index < ModelConfigs.Num(); ++Index)
+    {
+        UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+        if (!ApplyConfig(ModelConfigs[Index], Settings) || !LLMModule || !LLMModule->Initialize())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to set up: %s"), *ConfigSpecs[Index]), TEXT("Benchmark"));
+            Failures++;
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject> Report = RunConfig(ConfigSpecs[Index], OutputRoot);
+        if (!Report.IsValid())
+        {
+            Failures++;
+            continue;
+        }
+        ConfigReports.Add(MakeShared<FJsonValueObject>(Report));
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    RootObject->SetNumberField(TEXT("corpus_requests"), Corpus.Num());
+    RootObject->SetNumberField(TEXT("repeat"), Repeat);
+    RootObject->SetStringField(TEXT("translations"), OutputRoot);
+    RootObject->SetArrayField(TEXT("configs"), ConfigReports);
+
+    FString Out;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+    if (!FFileHelper::SaveStringToFile(Out, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to write benchmark report: %s"), *OutputPath), TEXT("Benchmark"));
+        return 1;
+    }
+
+    // One row per configuration, in the order given
+    FString Table = TEXT("Config | OK | p50 s | p95 s | TTFB p50 s | out tok/s | graphs/min | cost USD\n");
+    for (const TSharedPtr<FJsonValue>& Value : ConfigReports)
+    {
+        const TSharedPtr<FJsonObject>& Report = Value->AsObject();
+        Table += FString::Printf(TEXT("%s | %.0f%% | %.1f | %.1f | %.1f | %.1f | %.2f | %.4f\n"),
+            *Report->GetStringField(TEXT("config")),
+            Report->GetNumberField(TEXT("parse_success_rate")) * 100.0,
+            Report->GetNumberField(TEXT("p50_total_s")),
+            Report->GetNumberField(TEXT("p95_total_s")),
+            Report->GetNumberField(TEXT("p50_ttfb_s")),
+            Report->GetNumberField(TEXT("output_tokens_per_s")),
+            Report->GetNumberField(TEXT("graphs_per_minute")),
+            Report->GetNumberField(TEXT("cost_usd")));
+    }
+    FN2CLogger::Get().Log(Table, EN2CLogSeverity::Info, TEXT("Benchmark"));
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Model benchmark written to %s"), *OutputPath), EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return Failures > 0 ? 1 : 0;
+}
+
+bool UN2CModelBenchmarkCommandlet::ParseConfig(const FString& Spec, FModelConfig& OutConfig)
+{
+    // Local model names may hold colons themselves (qwen3:32b), so only the first one splits
+    FString ProviderName = Spec;
+    FString ModelName;
+    Spec.Split(TEXT(":"), &ProviderName, &ModelName);
+
+    const int64 Provider = StaticEnum<EN2CLLMProvider>()->GetValueByNameString(ProviderName.TrimStartAndEnd());
+    if (Provider == INDEX_NONE)
+    {
+        return false;
+    }
+    OutConfig.Provider = static_cast<EN2CLLMProvider>(Provider);
+    OutConfig.ModelName = ModelName.TrimStartAndEnd();
+
+    // Checked now, so a typo fails before any request is sent
+    return ApplyConfig(OutConfig, nullptr);
+}
+
+bool UN2CModelBenchmarkCommandlet::ApplyConfig(const FModelConfig& ModelConfig, UN2CSettings* Settings)
+{
+    if (Settings)
+    {
+        Settings->Provider = ModelConfig.Provider;
+    }
+    if (ModelConfig.ModelName.IsEmpty())
+    {
+        return true;
+    }
+
+    switch (ModelConfig.Provider)
+    {
+        case EN2CLLMProvider::OpenAI:
+        {
+            EN2COpenAIModel Model;
+            const bool bFound = FindModel(ModelConfig.ModelName, &FN2CLLMModelUtils::GetOpenAIModelValue, Model);
+            if (bFound && Settings)
+            {
+                Settings->OpenAI_Model = Model;
+            }
+            return bFound;
+        }
+        case EN2CLLMProvider::Anthropic:
+        {
+            EN2CAnthropicModel Model;
+            const bool bFound = FindModel(ModelConfig.ModelName, &FN2CLLMModelUtils::GetAnthropicModelValue, Model);
+            if (bFound && Settings)
+            {
+                Settings->AnthropicModel = Model;
+            }
+            return bFound;
+        }
+        case EN2CLLMProvider::Gemini:
+        {
+            EN2CGeminiModel Model;
+            const bool bFound = FindModel(ModelConfig.ModelName, &FN2CLLMModelUtils::GetGeminiModelValue, Model);
+            if (bFound && Settings)
+            {
+                Settings->Gemini_Model = Model;
+            }
+            return bFound;
+        }
+        case EN2CLLMProvider::DeepSeek:
+        {
+            EN2CDeepSeekModel Model;
+            const bool bFound = FindModel(ModelConfig.ModelName, &FN2CLLMModelUtils::GetDeepSeekModelValue, Model);
+            if (bFound && Settings)
+            {
+                Settings->DeepSeekModel = Model;
+            }
+            return bFound;
+        }
+        case EN2CLLMProvider::Ollama:
+            if (Settings)
+            {
+                Settings->OllamaModel = ModelConfig.ModelName;
+            }
+            return true;
+        case EN2CLLMProvider::LMStudio:
+            if (Settings)
+            {
+                Settings->LMStudioModel = ModelConfig.ModelName;
+            }
+            return true;
+        case EN2CLLMProvider::OpenAICompatible:
+            if (Settings)
+            {
+                Settings->OpenAICompatibleModel = ModelConfig.ModelName;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool UN2CModelBenchmarkCommandlet::LoadCorpus(const FString& CorpusPath, const TArray<FString>& AssetPaths)
+{
+    if (!CorpusPath.IsEmpty())
+    {
+        TArray<FString> Files;
+        if (IFileManager::Get().DirectoryExists(*CorpusPath))
+        {
+            IFileManager::Get().FindFiles(Files, *(CorpusPath / TEXT("*.json")), true, false);
+            IFileManager::Get().FindFiles(Files, *(CorpusPath / TEXT("*.ndjson")), true, false);
+            Files.Sort();
+            for (FString& File : Files)
+            {
+                File = CorpusPath / File;
+            }
+        }
+        else
+        {
+            Files.Add(CorpusPath);
+        }
+
+        for (const FString& File : Files)
+        {
+            FString Content;
+            if (!FFileHelper::LoadFileToString(Content, *File))
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to read corpus file: %s"), *File), TEXT("Benchmark"));
+                return false;
+            }
+
+            // Each line of an export is a request of its own
+            if (File.EndsWith(TEXT(".ndjson")))
+            {
+                TArray<FString> Lines;
+                Content.ParseIntoArrayLines(Lines);
+                for (int32 Line = 0; Line < Lines.Num(); ++Line)
+                {
+                    Corpus.Emplace(FString::Printf(TEXT("%s:%d"), *FPaths::GetBaseFilename(File), Line + 1), MoveTemp(Lines[Line]));
+                }
+            }
+            else if (!Content.IsEmpty())
+            {
+                Corpus.Emplace(FPaths::GetBaseFilename(File), MoveTemp(Content));
+            }
+        }
+    }
+    else
+    {
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        const EN2CJsonDialect Dialect = Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+        FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+        for (const FString& AssetPath : AssetPaths)
+        {
+            UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+            FN2CBatchJsonContext BatchContext;
+            if (!Blueprint || !Translator.GenerateFromBlueprint(Blueprint, Settings->bIncludeVariables)
+                || !Translator.GetN2CBlueprint().IsValid() || !FN2CSerializer::BuildBatchContext(Translator.GetN2CBlueprint(), BatchContext, Dialect))
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to extract Blueprint: %s"), *AssetPath), TEXT("Benchmark"));
+                return false;
+            }
+
+            // One request per graph, as translations are sent
+            for (const FN2CGraph& Graph : Translator.GetN2CBlueprint().Graphs)
+            {
+                if (!Graph.Name.IsEmpty())
+                {
+                    Corpus.Emplace(Blueprint->GetName() + TEXT(".") + Graph.Name, FN2CSerializer::ToJsonForGraph(BatchContext, Graph));
+                }
+            }
+        }
+    }
+
+    if (Corpus.Num() == 0)
+    {
+        FN2CLogger::Get().LogError(TEXT("No corpus given, pass -Corpus=Path or -Assets=/Game/Path/BP.BP"), TEXT("Benchmark"));
+        return false;
+    }
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Benchmark corpus: %d requests"), Corpus.Num()), EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return true;
+}
+
+TSharedPtr<FJsonObject> UN2CModelBenchmarkCommandlet::RunConfig(const FString& Name, const FString& OutputRoot)
+{
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    LLMModule->ClearRequestMetrics();
+
+    // Saved like a batch, in a folder per configuration
+    const FString ConfigRoot = OutputRoot / FPaths::MakeValidFileName(Name.Replace(TEXT(":"), TEXT("-")));
+    IFileManager::Get().MakeDirectory(*ConfigRoot, true);
+    const TSharedRef<FN2CTranslationSession> Session = MakeShared<FN2CTranslationSession>();
+    Session->BatchRootPath = ConfigRoot;
+    const TSharedRef<FN2CCancellationToken> Token = MakeShared<FN2CCancellationToken>();
+
+    // Completion times of each request from the moment the corpus was queued, queue wait included
+    struct FRunState
+    {
+        int32 Finished = 0;
+        int32 Succeeded = 0;
+        TArray<double> EndToEndSeconds;
+    };
+    const TSharedRef<FRunState> RunState = MakeShared<FRunState>();
+    const int32 NumRequests = Corpus.Num() * Repeat;
+
+    const double Start = FPlatformTime::Seconds();
+    for (int32 Round = 0; Round < Repeat; ++Round)
+    {
+        for (const TPair<FString, FString>& Request : Corpus)
+        {
+            const double QueuedAt = FPlatformTime::Seconds();
+            LLMModule->ProcessN2CJsonQuietly(Request.Value, Session, Token, FOnLLMTranslationComplete::CreateLambda(
+                [RunState, QueuedAt](const FN2CTranslationResponse& Response, bool bSuccess)
+                {
+                    RunState->Finished++;
+                    RunState->Succeeded += bSuccess ? 1 : 0;
+                    RunState->EndToEndSeconds.Add(FPlatformTime::Seconds() - QueuedAt);
+                }));
+        }
+    }
+
+    const double Deadline = Start + TimeoutSeconds;
+    double LastTime = FPlatformTime::Seconds();
+    while (RunState->Finished < NumRequests && FPlatformTime::Seconds() < Deadline)
+    {
+        Tick(LastTime);
+    }
+    const double WallSeconds = FPlatformTime::Seconds() - Start;
+
+    if (RunState->Finished < NumRequests)
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("%s timed out with %d of %d requests finished"), *Name, RunState->Finished, NumRequests), TEXT("Benchmark"));
+        Token->Cancel();
+        FN2CLLMRequestScheduler::Get().DrainCancelledRequests();
+    }
+    FN2CTranslationOutputWriter::Get().Flush();
+
+    // The provider's own timings and usage, recorded by the module for each request it sent
+    const TArray<FN2CRequestMetrics> Metrics = LLMModule->GetRequestMetrics();
+    const TArray<FN2CMetricsSummary> Summaries = FN2CRequestMetricsCollector::Summarize(Metrics);
+    FN2CMetricsSummary Summary = Summaries.Num() > 0 ? Summaries[0] : FN2CMetricsSummary();
+    Summary.Provider = LLMModule->GetConfig().Provider;
+    Summary.Model = LLMModule->GetConfig().Model;
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("config"), Name);
+    Report->SetStringField(TEXT("provider"), UEnum::GetValueAsString(Summary.Provider));
+    Report->SetStringField(TEXT("model"), Summary.Model);
+    Report->SetNumberField(TEXT("requests"), NumRequests);
+    Report->SetNumberField(TEXT("finished"), RunState->Finished);
+    Report->SetNumberField(TEXT("succeeded"), RunState->Succeeded);
+    Report->SetNumberField(TEXT("parse_success_rate"), NumRequests > 0 ? static_cast<double>(RunState->Succeeded) / NumRequests : 0.0);
+    Report->SetNumberField(TEXT("provider_requests"), Summary.Requests);
+    Report->SetNumberField(TEXT("provider_failures"), Summary.Failures);
+    Report->SetNumberField(TEXT("wall_s"), WallSeconds);
+    Report->SetNumberField(TEXT("graphs_per_minute"), WallSeconds > 0.0 ? RunState->Succeeded * 60.0 / WallSeconds : 0.0);
+    Report->SetNumberField(TEXT("p50_end_to_end_s"), GetPercentile(RunState->EndToEndSeconds, 50.0));
+    Report->SetNumberField(TEXT("p95_end_to_end_s"), GetPercentile(RunState->EndToEndSeconds, 95.0));
+    Report->SetNumberField(TEXT("p50_total_s"), Summary.P50TotalSeconds);
+    Report->SetNumberField(TEXT("p95_total_s"), Summary.P95TotalSeconds);
+    Report->SetNumberField(TEXT("p50_ttfb_s"), Summary.P50TimeToFirstByteSeconds);
+    Report->SetNumberField(TEXT("p95_ttfb_s"), Summary.P95TimeToFirstByteSeconds);
+    Report->SetNumberField(TEXT("output_tokens_per_s"), Summary.OutputTokensPerSecond);
+    Report->SetNumberField(TEXT("input_tokens"), Summary.InputTokens);
+    Report->SetNumberField(TEXT("cached_input_tokens"), Summary.CachedInputTokens);
+    Report->SetNumberField(TEXT("output_tokens"), Summary.OutputTokens);
+    Report->SetNumberField(TEXT("cost_usd"), Summary.Cost);
+    Report->SetNumberField(TEXT("cost_per_graph_usd"), RunState->Succeeded > 0 ? Summary.Cost / RunState->Succeeded : 0.0);
+    Report->SetStringField(TEXT("translations"), ConfigRoot);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%s: %d of %d parsed in %.1f s, p50 %.1f s, p95 %.1f s, $%.4f"),
+            *Name, RunState->Succeeded, NumRequests, WallSeconds, Summary.P50TotalSeconds, Summary.P95TotalSeconds, Summary.Cost),
+        EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return Report;
+}
+
+void UN2CModelBenchmarkCommandlet::Tick(double& LastTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    const float DeltaTime = static_cast<float>(Now - LastTime);
+    LastTime = Now;
+
+    FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+    FTSTicker::GetCoreTicker().Tick(DeltaTime);
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    FPlatformProcess::Sleep(0.001f);
+}
@@ -2,6 +2,10 @@
 
 #include "Core/N2CNodeCollector.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "EdGraphSchema_K2.h"
+
+DECLARE_CYCLE_STAT(TEXT("Collect Nodes"), STAT_N2CCollectNodes, STATGROUP_NodeToCode);
 
 FN2CNodeCollector& FN2CNodeCollector::Get()
 {
@@ -9,41 +13,55 @@ FN2CNodeCollector& FN2CNodeCollector::Get()
     return Instance;
 }
 
-bool FN2CNodeCollector::CollectNodesFromGraph(UEdGraph* Graph, TArray<UK2Node*>& OutNodes)
+bool FN2CNodeCollector::CollectNodesFromGraph(UEdGraph* Graph, TArray<FN2CCollectedNode>& OutNodes)
 {
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CCollectNodes);
+    LLM_SCOPE_BYTAG(NodeToCode_Translator);
+
     if (!Graph)
     {
         FN2CLogger::Get().LogWarning(TEXT("Invalid graph provided to CollectNodesFromGraph"));
         return false;
     }
 
-    // Get Blueprint name for context
-    FString BlueprintName = TEXT("Unknown");
-    if (UBlueprint* Blueprint = Cast<UBlueprint>(Graph->GetOuter()))
-    {
-        BlueprintName = Blueprint->GetName();
-    }
-
-    // Log collection start
-    FString Context = FString::Printf(TEXT("Blueprint: %s, Graph: %s"),
-        *BlueprintName,
-        *Graph->GetName());
-    FN2CLogger::Get().Log(TEXT("Starting node collection"), EN2CLogSeverity::Info, Context);
+    OutNodes.Reserve(OutNodes.Num() + Graph->Nodes.Num());
 
-    // Collect K2 nodes from the graph
+    // Filter the pins while each node is at hand, so the translator walks only the ones it keeps
     for (UEdGraphNode* Node : Graph->Nodes)
     {
-        if (UK2Node* K2Node = Cast<UK2Node>(Node))
+        UK2Node* K2Node = Cast<UK2Node>(Node);
+        if (!K2Node)
         {
-            OutNodes.Add(K2Node);
+            continue;
+        }
+
+        FN2CCollectedNode& Collected = OutNodes.AddDefaulted_GetRef();
+        Collected.Node = K2Node;
+        Collected.Pins.Reserve(K2Node->Pins.Num());
+
+        for (UEdGraphPin* Pin : K2Node->Pins)
+        {
+            if (!ValidatePin(Pin) || Pin->bHidden)
+            {
+                continue;
+            }
+
+            Collected.Pins.Add(Pin);
+            if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
+            {
+                Collected.ExecOutputs.Add(Pin);
+            }
         }
     }
 
-    // Log collection results
-    FString ResultContext = FString::Printf(TEXT("%d nodes collected from %s"), 
-        OutNodes.Num(), 
-        *Context);
-    FN2CLogger::Get().Log(TEXT("Node collection complete"), EN2CLogSeverity::Info, ResultContext);
+    if (FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Debug))
+    {
+        const UBlueprint* Blueprint = Cast<UBlueprint>(Graph->GetOuter());
+        N2C_LOG(Debug, TEXT("%d nodes collected from Blueprint: %s, Graph: %s"),
+            OutNodes.Num(),
+            Blueprint ? *Blueprint->GetName() : TEXT("Unknown"),
+            *Graph->GetName());
+    }
 
     return true;
 }
@@ -98,17 +116,15 @@ bool FN2CNodeCollector::CollectPinsFromNode(UK2Node* Node, TArray<UEdGraphPin*>&
         }
     }
 
-    // Log pin collection results
-    FString Context = FString::Printf(TEXT("Node: %s, Input Pins: %d, Output Pins: %d"),
+    N2C_LOG(Debug, TEXT("Pin collection complete. Node: %s, Input Pins: %d, Output Pins: %d"),
         *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(),
         OutInputPins.Num(),
         OutOutputPins.Num());
-    FN2CLogger::Get().Log(TEXT("Pin collection complete"), EN2CLogSeverity::Info, Context);
 
     return true;
 }
 
-bool FN2CNodeCollector::ValidatePin(UEdGraphPin* Pin) const
+bool FN2CNodeCollector::ValidatePin(UEdGraphPin* Pin)
 {
     if (!Pin)
     {
@@ -2,9 +2,13 @@
 
 #include "Core/N2CNodeTranslator.h"
 
+#include "Algo/Count.h"
+#include "Core/N2CSerializer.h"
 #include "Core/N2CSettings.h"
 #include "Utils/N2CLogger.h"
 #include "Utils/N2CNodeTypeRegistry.h"
+#include "Utils/N2CPinPruner.h"
+#include "Utils/N2CStats.h"
 #include "Utils/Validators/N2CBlueprintValidator.h"
 #include "UObject/UnrealType.h"
 #include "UObject/UObjectBase.h"
@@ -15,22 +19,42 @@
 #include "Components/ActorComponent.h"
 #include "Components/SceneComponent.h"
 #include "K2Node_FunctionEntry.h"
+#include "Misc/MemStack.h"
+#include "Misc/SecureHash.h"
+#include "Hash/CityHash.h"
+#include "Async/ParallelFor.h"
 #include "UObject/UnrealType.h"
 
+DECLARE_CYCLE_STAT(TEXT("Generate N2C Struct"), STAT_N2CGenerateN2CStruct, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Generate From Blueprint"), STAT_N2CGenerateFromBlueprint, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Process Node"), STAT_N2CProcessNode, STATGROUP_NodeToCode);
+
+/** Set allocated on the thread's memory stack, for temporaries released when the enclosing FMemMark goes out of scope */
+using FMemStackSetAllocator = TSetAllocator<TSparseArrayAllocator<TMemStackAllocator<>, TMemStackAllocator<>>, TMemStackAllocator<>>;
+
 FN2CNodeTranslator& FN2CNodeTranslator::Get()
 {
     static FN2CNodeTranslator Instance;
     return Instance;
 }
 
-bool FN2CNodeTranslator::GenerateN2CStruct(const TArray<UK2Node*>& CollectedNodes)
+FN2CNodeTranslator::FN2CNodeTranslator()
+{
+    FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FN2CNodeTranslator::HandleObjectModified);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FN2CNodeTranslator::HandleObjectPropertyChanged);
+    FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FN2CNodeTranslator::HandleReloadComplete);
+}
+
+bool FN2CNodeTranslator::GenerateN2CStruct(const TArray<FN2CCollectedNode>& CollectedNodes)
 {
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CGenerateN2CStruct);
+    LLM_SCOPE_BYTAG(NodeToCode_Translator);
+
     // Clear any existing data
     N2CBlueprint = FN2CBlueprint();
-    NodeIDMap.Empty();
-    PinIDMap.Empty();
     ProcessedStructPaths.Empty();  // Clear processed structs set
     ProcessedEnumPaths.Empty();    // Clear processed enums set
+    ResetGraphIndices();
 
     if (CollectedNodes.Num() == 0)
     {
@@ -41,7 +65,7 @@ bool FN2CNodeTranslator::GenerateN2CStruct(const TArray<UK2Node*>& CollectedNode
     FN2CLogger::Get().Log(TEXT("Starting node translation"), EN2CLogSeverity::Info);
 
     // Get Blueprint metadata from first node (all nodes are from the same graph)                                                                                                                                                             
-    if (UK2Node* FirstNode = CollectedNodes[0])                                                                                                                                                                                        
+    if (UK2Node* FirstNode = CollectedNodes[0].Node)                                                                                                                                                                                        
     {
         if (UBlueprint* Blueprint = FirstNode->GetBlueprint())
         {
@@ -87,58 +111,68 @@ bool FN2CNodeTranslator::GenerateN2CStruct(const TArray<UK2Node*>& CollectedNode
     }
     
     // Create initial graph for the nodes
-    FN2CGraph MainGraph;
+    FGraphTranslationContext MainContext;
+    FN2CGraph& MainGraph = MainContext.Graph;
     
     // Get graph info from first node
-    if (CollectedNodes.Num() > 0 && CollectedNodes[0])
+    if (CollectedNodes[0].Node)
     {
-        if (UEdGraph* Graph = CollectedNodes[0]->GetGraph())
+        if (UEdGraph* Graph = CollectedNodes[0].Node->GetGraph())
         {
             MainGraph.Name = Graph->GetName();
             MainGraph.GraphType = DetermineGraphType(Graph);
             
-            FString Context = FString::Printf(TEXT("Created graph: %s of type %s"),
-                *MainGraph.Name,
-                *StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(MainGraph.GraphType)));
-            FN2CLogger::Get().Log(TEXT("Graph info"), EN2CLogSeverity::Debug, Context);
+            if (FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Debug))
+            {
+                FString Context = FString::Printf(TEXT("Created graph: %s of type %s"),
+                    *MainGraph.Name,
+                    *StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(MainGraph.GraphType)));
+                FN2CLogger::Get().Log(TEXT("Graph info"), EN2CLogSeverity::Debug, Context);
+            }
         }
     }
     
-    CurrentGraph = &MainGraph;
-
     // Process each node
-    for (UK2Node* Node : CollectedNodes)
+    ReserveGraphContext(CollectedNodes, MainContext);
+    for (const FN2CCollectedNode& Collected : CollectedNodes)
     {
-        if (!Node)
+        if (!Collected.Node)
         {
             FN2CLogger::Get().LogWarning(TEXT("Null node encountered during translation"));
             continue;
         }
 
         FN2CNodeDefinition NodeDef;
-        if (ProcessNode(Node, NodeDef))
+        if (ProcessNode(Collected, NodeDef, MainContext))
         {
-            CurrentGraph->Nodes.Add(NodeDef);
+            MainGraph.Nodes.Add(MoveTemp(NodeDef));
         }
     }
+    ResolveExecutionFlows(MainContext);
 
     // Add the main graph to the blueprint
-    N2CBlueprint.Graphs.Add(MainGraph);
+    const int32 MainNodeCount = MainGraph.Nodes.Num();
+    MergeGraphContext(MainContext, true);
 
-    // Process any additional graphs that were discovered
+    // Process any additional graphs that were discovered. Each one can queue more, so these stay serial
     while (AdditionalGraphsToProcess.Num() > 0)
     {
         FGraphProcessInfo GraphInfo = AdditionalGraphsToProcess.Pop();
         if (GraphInfo.Graph)
         {
             // Set the depth to parent depth before processing
-            CurrentDepth = GraphInfo.ParentDepth;
-            ProcessGraph(GraphInfo.Graph, DetermineGraphType(GraphInfo.Graph));
+            FGraphTranslationContext GraphContext;
+            GraphContext.Depth = GraphInfo.ParentDepth;
+            const bool bHasNodes = ProcessGraph(GraphInfo.Graph, DetermineGraphType(GraphInfo.Graph), GraphContext);
+            MergeGraphContext(GraphContext, bHasNodes);
         }
     }
 
+    RecordMacroDepths();
+    FN2CPinPruner::Prune(N2CBlueprint, FN2CPinPruner::FOptions::FromSettings());
+
     FString Context = FString::Printf(TEXT("Translated %d nodes in %d graphs"), 
-        MainGraph.Nodes.Num(), 
+        MainNodeCount, 
         N2CBlueprint.Graphs.Num());
     FN2CLogger::Get().Log(TEXT("Node translation complete"), EN2CLogSeverity::Info, Context);
 
@@ -147,19 +181,49 @@ bool FN2CNodeTranslator::GenerateN2CStruct(const TArray<UK2Node*>& CollectedNode
 
 bool FN2CNodeTranslator::GenerateFromBlueprint(UBlueprint* InBlueprint, bool bIncludeVariables)
 {
-    N2CBlueprint = FN2CBlueprint();
-    NodeIDMap.Empty();
-    PinIDMap.Empty();
-    ProcessedStructPaths.Empty();
-    ProcessedEnumPaths.Empty();
-    AdditionalGraphsToProcess.Empty();
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CGenerateFromBlueprint);
+    LLM_SCOPE_BYTAG(NodeToCode_Translator);
 
     if (!InBlueprint)
     {
+        N2CBlueprint = FN2CBlueprint();
         FN2CLogger::Get().LogWarning(TEXT("No Blueprint provided to GenerateFromBlueprint"));
         return false;
     }
 
+    BeginBlueprint(InBlueprint);
+
+    TArray<UEdGraph*> Graphs;
+    GetTopLevelGraphs(InBlueprint, Graphs);
+
+    // Top-level graphs are independent, so each is translated into its own context (in parallel when
+    // enabled) and the results are merged in the original graph order to keep the output deterministic
+    TArray<FGraphTranslationContext> GraphContexts;
+    GraphContexts.SetNum(Graphs.Num());
+    TArray<bool> GraphHasNodes;
+    GraphHasNodes.Init(false, Graphs.Num());
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bParallel = Settings && Settings->bParallelGraphTranslation;
+
+    ParallelFor(Graphs.Num(), [this, &Graphs, &GraphContexts, &GraphHasNodes](int32 Index)
+    {
+        if (UEdGraph* Graph = Graphs[Index])
+        {
+            GraphHasNodes[Index] = ProcessGraph(Graph, DetermineGraphType(Graph), GraphContexts[Index]);
+        }
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    return FinishBlueprint(InBlueprint, bIncludeVariables, GraphContexts, GraphHasNodes);
+}
+
+void FN2CNodeTranslator::BeginBlueprint(UBlueprint* InBlueprint)
+{
+    N2CBlueprint = FN2CBlueprint();
+    ProcessedStructPaths.Empty();
+    ProcessedEnumPaths.Empty();
+    ResetGraphIndices();
+
     // Metadata
     N2CBlueprint.Metadata.Name = InBlueprint->GetName();
     if (InBlueprint->GeneratedClass)
@@ -179,72 +243,822 @@ bool FN2CNodeTranslator::GenerateFromBlueprint(UBlueprint* InBlueprint, bool bIn
         case BPTYPE_FunctionLibrary:  N2CBlueprint.Metadata.BlueprintType = EN2CBlueprintType::FunctionLibrary; break;
         default:                      N2CBlueprint.Metadata.BlueprintType = EN2CBlueprintType::Normal; break;
     }
+}
+
+void FN2CNodeTranslator::GetTopLevelGraphs(UBlueprint* InBlueprint, TArray<UEdGraph*>& OutGraphs)
+{
+    OutGraphs.Reset(InBlueprint->UbergraphPages.Num() + InBlueprint->FunctionGraphs.Num() + InBlueprint->MacroGraphs.Num());
+    OutGraphs.Append(InBlueprint->UbergraphPages);
+    OutGraphs.Append(InBlueprint->FunctionGraphs);
+    OutGraphs.Append(InBlueprint->MacroGraphs);
+}
+
+bool FN2CNodeTranslator::FinishBlueprint(UBlueprint* InBlueprint, bool bIncludeVariables, TArray<FGraphTranslationContext>& GraphContexts, const TArray<bool>& GraphHasNodes)
+{
+    for (int32 Index = 0; Index < GraphContexts.Num(); ++Index)
+    {
+        MergeGraphContext(GraphContexts[Index], GraphHasNodes[Index]);
+    }
+
+    // Collect component overrides defined on this Blueprint (SimpleConstructionScript)
+    CollectComponentOverrides(InBlueprint);
+
+    // Variables
+    if (bIncludeVariables)
+    {
+        for (const FBPVariableDescription& Desc : InBlueprint->NewVariables)
+        {
+            FN2CVariable Var;
+            ConvertVariableDescription(Desc, Var);
+            N2CBlueprint.Variables.Add(Var);
+        }
+    }
+
+    // Synthesize a dedicated ClassItSelf graph to carry only class-level structure
+    // (UCLASS, class declaration, UPROPERTY members, ctor/dtor) separate from EventGraph logic.
+    // 
+    // NOTE: ClassItSelf is a synthetic graph type that does not correspond to any actual Blueprint graph.
+    // It serves as a marker for the LLM to generate class-level C++ code (class declaration, constructor,
+    // destructor, member variables, and component declarations). The actual class-level data (variables
+    // and components) are stored at the Blueprint level (N2CBlueprint.Variables and N2CBlueprint.Components),
+    // not within this graph. The graph itself is intentionally empty (no nodes) because it represents
+    // class structure, not executable flow.
+    {
+        FN2CGraph ClassItSelfGraph;
+        ClassItSelfGraph.Name = TEXT("ClassItSelf");
+        ClassItSelfGraph.GraphType = EN2CGraphType::ClassItSelf;
+        // Intentionally leave this graph empty - it's a marker for class-level code generation
+        // The LLM will use this graph type along with Blueprint-level Variables[] and Components[]
+        // arrays to generate the class skeleton in C++
+        N2CBlueprint.Graphs.Add(ClassItSelfGraph);
+    }
+
+    RecordMacroDepths();
+    FN2CPinPruner::Prune(N2CBlueprint, FN2CPinPruner::FOptions::FromSettings());
+
+    FString Ctx = FString::Printf(
+        TEXT("Generated from Blueprint: %s (Graphs=%d, Vars=%d, Components=%d)"),
+        *N2CBlueprint.Metadata.Name,
+        N2CBlueprint.Graphs.Num(),
+        N2CBlueprint.Variables.Num(),
+        N2CBlueprint.Components.Num());
+    FN2CLogger::Get().Log(TEXT("Blueprint translation complete"), EN2CLogSeverity::Info, Ctx);
+    return N2CBlueprint.Graphs.Num() > 0;
+}
+
+bool FN2CNodeTranslator::BeginSlicedExtraction(UBlueprint* InBlueprint, bool bIncludeVariables)
+{
+    if (!InBlueprint || Sliced.IsValid())
+    {
+        return false;
+    }
+
+    Sliced = MakeUnique<FSlicedExtraction>();
+    Sliced->Blueprint.Reset(InBlueprint);
+    Sliced->bIncludeVariables = bIncludeVariables;
 
-    // Process graphs: event, functions, macros
     TArray<UEdGraph*> Graphs;
-    if (InBlueprint->UbergraphPages.Num() > 0)
+    GetTopLevelGraphs(InBlueprint, Graphs);
+    Sliced->Graphs.Reserve(Graphs.Num());
+    Sliced->Order.Reserve(Graphs.Num());
+    for (UEdGraph* Graph : Graphs)
+    {
+        Sliced->Order.Add(Sliced->Graphs.Num());
+        Sliced->Graphs.Add(Graph);
+        Sliced->TotalNodes += Graph ? Graph->Nodes.Num() : 0;
+    }
+    Sliced->Contexts.SetNum(Graphs.Num());
+    Sliced->GraphHasNodes.Init(false, Graphs.Num());
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Extracting %s in slices: %d graphs, %d nodes"), *InBlueprint->GetName(), Graphs.Num(), Sliced->TotalNodes),
+        EN2CLogSeverity::Info);
+    return true;
+}
+
+bool FN2CNodeTranslator::StepSlicedExtraction(double BudgetSeconds, bool& bOutSucceeded)
+{
+    bOutSucceeded = false;
+    if (!Sliced.IsValid())
+    {
+        return true;
+    }
+
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CGenerateFromBlueprint);
+    LLM_SCOPE_BYTAG(NodeToCode_Translator);
+
+    FSlicedExtraction& State = *Sliced;
+    const double EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+    do
+    {
+        if (State.Cursor >= State.Order.Num())
+        {
+            // Merging moves what the slices built, so the last step stays short
+            UBlueprint* Blueprint = State.Blueprint.Get();
+            TUniquePtr<FSlicedExtraction> Finished = MoveTemp(Sliced);
+
+            BeginBlueprint(Blueprint);
+            bOutSucceeded = FinishBlueprint(Blueprint, Finished->bIncludeVariables, Finished->Contexts, Finished->GraphHasNodes);
+            return true;
+        }
+
+        const int32 GraphIndex = State.Order[State.Cursor];
+        UEdGraph* Graph = State.Graphs[GraphIndex].Get();
+        if (!Graph)
+        {
+            State.GraphHasNodes[GraphIndex] = false;
+            State.Cursor++;
+            continue;
+        }
+
+        // A graph modified part way through starts over with its current nodes
+        if (State.bGraphModified || State.NodeIndex == INDEX_NONE)
+        {
+            State.bGraphModified = false;
+            State.Contexts[GraphIndex] = FGraphTranslationContext();
+            State.CollectedNodes.Reset();
+            BeginGraph(Graph, DetermineGraphType(Graph), State.Contexts[GraphIndex], State.CollectedNodes);
+            ReserveGraphContext(State.CollectedNodes, State.Contexts[GraphIndex]);
+            State.NodeIndex = 0;
+        }
+
+        FGraphTranslationContext& Context = State.Contexts[GraphIndex];
+        if (State.NodeIndex < State.CollectedNodes.Num())
+        {
+            FN2CNodeDefinition NodeDef;
+            if (ProcessNode(State.CollectedNodes[State.NodeIndex++], NodeDef, Context))
+            {
+                Context.Graph.Nodes.Add(MoveTemp(NodeDef));
+            }
+            continue;
+        }
+
+        State.GraphHasNodes[GraphIndex] = FinishGraph(Context);
+        State.FinishedNodes += Graph->Nodes.Num();
+        State.CollectedNodes.Reset();
+        State.NodeIndex = INDEX_NONE;
+        State.Cursor++;
+    }
+    while (FPlatformTime::Seconds() < EndTime);
+
+    return false;
+}
+
+float FN2CNodeTranslator::GetSlicedExtractionProgress() const
+{
+    if (!Sliced.IsValid())
+    {
+        return 1.0f;
+    }
+    if (Sliced->TotalNodes == 0)
+    {
+        return 0.0f;
+    }
+
+    const int32 CurrentNodes = Sliced->NodeIndex != INDEX_NONE ? Sliced->NodeIndex : 0;
+    return FMath::Clamp(static_cast<float>(Sliced->FinishedNodes + CurrentNodes) / Sliced->TotalNodes, 0.0f, 1.0f);
+}
+
+void FN2CNodeTranslator::CancelSlicedExtraction()
+{
+    Sliced.Reset();
+}
+
+FN2CBlueprint FN2CNodeTranslator::TakeN2CBlueprint()
+{
+    FN2CBlueprint Taken;
+    Swap(Taken, N2CBlueprint);
+    return Taken;
+}
+
+void FN2CNodeTranslator::HandleSlicedObjectModified(UObject* Object)
+{
+    UEdGraph* Graph = Cast<UEdGraph>(Object);
+    if (!Graph)
+    {
+        if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+        {
+            Graph = Node->GetGraph();
+        }
+    }
+
+    const int32 GraphIndex = Graph ? Sliced->Graphs.IndexOfByKey(Graph) : INDEX_NONE;
+    if (GraphIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FSlicedExtraction& State = *Sliced;
+    if (State.Cursor < State.Order.Num() && State.Order[State.Cursor] == GraphIndex)
+    {
+        State.bGraphModified = State.NodeIndex != INDEX_NONE;
+        return;
+    }
+
+    // An extracted graph is extracted again once the others are done, unless it already waits for that
+    if (State.Order.FindLastByPredicate([GraphIndex](int32 Index) { return Index == GraphIndex; }) <= State.Cursor)
+    {
+        State.Order.Add(GraphIndex);
+        State.TotalNodes += Graph->Nodes.Num();
+    }
+}
+
+void FN2CNodeTranslator::ResetGraphIndices()
+{
+    AdditionalGraphsToProcess.Empty();
+    ProcessedGraphNames.Empty();
+    QueuedGraphs.Empty();
+    SharedMacroLibraries.Empty();
+    SharedMacroNames.Empty();
+
+    // Assets can move between runs, so package verdicts are only kept for one translation
+    {
+        FWriteScopeLock WriteLock(UserContentLock);
+        UserContentPackages.Empty();
+    }
+
+    // Function graphs can be added, renamed or removed between runs
+    FWriteScopeLock WriteLock(FunctionGraphLock);
+    FunctionGraphIndex.Empty();
+}
+
+FString FN2CNodeTranslator::ComputeGraphFingerprint(const FString& ContextJson, const FString& GraphJson)
+{
+    // Every graph is translated alongside the shared context, so a context change dirties all graphs
+    const FTCHARToUTF8 ContextUtf8(*ContextJson);
+    const FTCHARToUTF8 GraphUtf8(*GraphJson);
+
+    FSHA1 Hasher;
+    Hasher.Update(reinterpret_cast<const uint8*>(ContextUtf8.Get()), ContextUtf8.Length());
+    Hasher.Update(reinterpret_cast<const uint8*>(GraphUtf8.Get()), GraphUtf8.Length());
+    Hasher.Final();
+
+    uint8 Digest[FSHA1::DigestSize];
+    Hasher.GetHash(Digest);
+    return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+namespace N2CStructuralHash
+{
+    /** Append a field with its length so no two field lists write the same text */
+    void AppendField(FString& Out, const FString& Field)
+    {
+        Out.AppendInt(Field.Len());
+        Out.AppendChar(TEXT(':'));
+        Out.Append(Field);
+    }
+
+    void AppendPin(FString& Out, const FN2CPinDefinition& Pin)
+    {
+        AppendField(Out, Pin.Name);
+        Out.AppendInt(static_cast<int32>(Pin.Type));
+        AppendField(Out, Pin.SubType);
+        AppendField(Out, Pin.DefaultValue);
+        Out.AppendChar(Pin.bConnected ? TEXT('c') : TEXT('-'));
+        Out.AppendChar(Pin.bIsReference ? TEXT('r') : TEXT('-'));
+        Out.AppendChar(Pin.bIsConst ? TEXT('k') : TEXT('-'));
+        Out.AppendChar(Pin.bIsArray ? TEXT('a') : TEXT('-'));
+        Out.AppendChar(Pin.bIsMap ? TEXT('m') : TEXT('-'));
+        Out.AppendChar(Pin.bIsSet ? TEXT('s') : TEXT('-'));
+    }
+
+    /** Everything about a node but its ID; pin IDs are left out too, pins are known by position */
+    void AppendNode(FString& Out, const FN2CNodeDefinition& Node)
+    {
+        Out.AppendInt(static_cast<int32>(Node.NodeType));
+        AppendField(Out, Node.Name);
+        AppendField(Out, Node.MemberParent);
+        AppendField(Out, Node.MemberName);
+        AppendField(Out, Node.Comment);
+        Out.AppendChar(Node.bPure ? TEXT('p') : TEXT('-'));
+        Out.AppendChar(Node.bLatent ? TEXT('l') : TEXT('-'));
+        Out.AppendInt(Node.InputPins.Num());
+        for (const FN2CPinDefinition& Pin : Node.InputPins)
+        {
+            AppendPin(Out, Pin);
+        }
+        Out.AppendInt(Node.OutputPins.Num());
+        for (const FN2CPinDefinition& Pin : Node.OutputPins)
+        {
+            AppendPin(Out, Pin);
+        }
+    }
+
+    uint64 HashString(const FString& Text)
+    {
+        const FTCHARToUTF8 Utf8(*Text);
+        return CityHash64(reinterpret_cast<const char*>(Utf8.Get()), Utf8.Length());
+    }
+
+    uint64 Combine(uint64 A, uint64 B)
+    {
+        return CityHash128to64(Uint128_64(A, B));
+    }
+
+    /** One edge end as seen from a node: kind, pins on either end and the label of the node at the other end */
+    uint64 HashNeighbour(uint64 Kind, int32 LocalPin, int32 RemotePin, uint64 RemoteLabel)
+    {
+        const uint64 Pins = (static_cast<uint64>(static_cast<uint32>(LocalPin)) << 32) | static_cast<uint32>(RemotePin);
+        return Combine(Combine(Kind, Pins), RemoteLabel);
+    }
+}
+
+FString FN2CNodeTranslator::ComputeStructuralHash(const FN2CGraph& Graph)
+{
+    using namespace N2CStructuralHash;
+
+    const int32 NumNodes = Graph.Nodes.Num();
+
+    // Local labels
+    TArray<FString> NodeTexts;
+    TArray<uint64> Labels;
+    NodeTexts.SetNum(NumNodes);
+    Labels.SetNumUninitialized(NumNodes);
+    for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+    {
+        AppendNode(NodeTexts[NodeIndex], Graph.Nodes[NodeIndex]);
+        Labels[NodeIndex] = HashString(NodeTexts[NodeIndex]);
+    }
+
+    // Edges by index, dropping any that point outside the graph
+    TArray<FN2CDataFlow> DataFlows;
+    DataFlows.Reserve(Graph.Flows.Data.Num());
+    for (const FN2CDataFlow& Flow : Graph.Flows.Data)
+    {
+        if (Graph.Nodes.IsValidIndex(Flow.SourceNode) && Graph.Nodes.IsValidIndex(Flow.TargetNode))
+        {
+            DataFlows.Add(Flow);
+        }
+    }
+
+    TArray<TArray<int32>> Chains;
+    Chains.Reserve(Graph.Flows.NumExecutionChains());
+    for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
+    {
+        TArray<int32>& Chain = Chains.AddDefaulted_GetRef();
+        for (const int32 NodeIndex : Graph.Flows.GetExecutionChain(ChainIndex))
+        {
+            if (Graph.Nodes.IsValidIndex(NodeIndex))
+            {
+                Chain.Add(NodeIndex);
+            }
+        }
+    }
+
+    // Refine each label with its neighbours' until the number of distinct labels stops growing
+    auto CountDistinct = [](const TArray<uint64>& InLabels)
+    {
+        TSet<uint64> Distinct;
+        Distinct.Reserve(InLabels.Num());
+        Distinct.Append(InLabels);
+        return Distinct.Num();
+    };
+
+    int32 NumDistinct = CountDistinct(Labels);
+    TArray<TArray<uint64>> Neighbours;
+    Neighbours.SetNum(NumNodes);
+    for (int32 Round = 0; Round < NumNodes && NumDistinct < NumNodes; ++Round)
+    {
+        for (TArray<uint64>& NodeNeighbours : Neighbours)
+        {
+            NodeNeighbours.Reset();
+        }
+        for (const FN2CDataFlow& Flow : DataFlows)
+        {
+            Neighbours[Flow.SourceNode].Add(HashNeighbour(1, Flow.SourcePin, Flow.TargetPin, Labels[Flow.TargetNode]));
+            Neighbours[Flow.TargetNode].Add(HashNeighbour(2, Flow.TargetPin, Flow.SourcePin, Labels[Flow.SourceNode]));
+        }
+        for (const TArray<int32>& Chain : Chains)
+        {
+            for (int32 Step = 1; Step < Chain.Num(); ++Step)
+            {
+                Neighbours[Chain[Step - 1]].Add(HashNeighbour(3, Step - 1, Step, Labels[Chain[Step]]));
+                Neighbours[Chain[Step]].Add(HashNeighbour(4, Step, Step - 1, Labels[Chain[Step - 1]]));
+            }
+        }
+
+        TArray<uint64> Refined;
+        Refined.SetNumUninitialized(NumNodes);
+        for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+        {
+            TArray<uint64>& NodeNeighbours = Neighbours[NodeIndex];
+            NodeNeighbours.Sort();
+            uint64 Label = Labels[NodeIndex];
+            for (const uint64 Neighbour : NodeNeighbours)
+            {
+                Label = Combine(Label, Neighbour);
+            }
+            Refined[NodeIndex] = Label;
+        }
+
+        const int32 RefinedDistinct = CountDistinct(Refined);
+        if (RefinedDistinct <= NumDistinct)
+        {
+            break;
+        }
+        Labels = MoveTemp(Refined);
+        NumDistinct = RefinedDistinct;
+    }
+
+    // Canonical order: by label, then by collection order for nodes the labels can't tell apart
+    TArray<int32> Order;
+    Order.SetNumUninitialized(NumNodes);
+    for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+    {
+        Order[NodeIndex] = NodeIndex;
+    }
+    Order.Sort([&Labels](int32 A, int32 B) { return Labels[A] != Labels[B] ? Labels[A] < Labels[B] : A < B; });
+
+    TArray<int32> CanonicalIndex;
+    CanonicalIndex.SetNumUninitialized(NumNodes);
+    for (int32 Position = 0; Position < NumNodes; ++Position)
+    {
+        CanonicalIndex[Order[Position]] = Position;
+    }
+
+    // Write the graph in that order, with flows renumbered and sorted
+    FString Canonical;
+    Canonical.AppendInt(static_cast<int32>(Graph.GraphType));
+    Canonical.AppendChar(TEXT('|'));
+    Canonical.AppendInt(NumNodes);
+    for (const int32 NodeIndex : Order)
+    {
+        Canonical.AppendChar(TEXT('|'));
+        Canonical.Append(NodeTexts[NodeIndex]);
+    }
+
+    TArray<TArray<int32>> CanonicalChains;
+    CanonicalChains.Reserve(Chains.Num());
+    for (const TArray<int32>& Chain : Chains)
+    {
+        TArray<int32>& CanonicalChain = CanonicalChains.AddDefaulted_GetRef();
+        CanonicalChain.Reserve(Chain.Num());
+        for (const int32 NodeIndex : Chain)
+        {
+            CanonicalChain.Add(CanonicalIndex[NodeIndex]);
+        }
+    }
+    CanonicalChains.Sort([](const TArray<int32>& A, const TArray<int32>& B)
+    {
+        for (int32 Index = 0; Index < A.Num() && Index < B.Num(); ++Index)
+        {
+            if (A[Index] != B[Index])
+            {
+                return A[Index] < B[Index];
+            }
+        }
+        return A.Num() < B.Num();
+    });
+    Canonical.Append(TEXT("|exec"));
+    for (const TArray<int32>& Chain : CanonicalChains)
+    {
+        Canonical.AppendChar(TEXT('|'));
+        for (const int32 Position : Chain)
+        {
+            Canonical.AppendInt(Position);
+            Canonical.AppendChar(TEXT(','));
+        }
+    }
+
+    TArray<FN2CDataFlow> CanonicalFlows;
+    CanonicalFlows.Reserve(DataFlows.Num());
+    for (const FN2CDataFlow& Flow : DataFlows)
+    {
+        CanonicalFlows.Emplace(CanonicalIndex[Flow.SourceNode], Flow.SourcePin, CanonicalIndex[Flow.TargetNode], Flow.TargetPin);
+    }
+    CanonicalFlows.Sort([](const FN2CDataFlow& A, const FN2CDataFlow& B)
+    {
+        if (A.SourceNode != B.SourceNode) { return A.SourceNode < B.SourceNode; }
+        if (A.SourcePin != B.SourcePin) { return A.SourcePin < B.SourcePin; }
+        if (A.TargetNode != B.TargetNode) { return A.TargetNode < B.TargetNode; }
+        return A.TargetPin < B.TargetPin;
+    });
+    Canonical.Append(TEXT("|data"));
+    for (const FN2CDataFlow& Flow : CanonicalFlows)
     {
-        Graphs.Append(InBlueprint->UbergraphPages);
+        Canonical.Appendf(TEXT("|%d.%d>%d.%d"), Flow.SourceNode, Flow.SourcePin, Flow.TargetNode, Flow.TargetPin);
     }
-    if (InBlueprint->FunctionGraphs.Num() > 0)
+
+    // Local variables are declared in order, which the translation follows
+    Canonical.Append(TEXT("|locals"));
+    for (const FN2CVariable& Variable : Graph.LocalVariables)
+    {
+        Canonical.AppendChar(TEXT('|'));
+        AppendField(Canonical, Variable.Name);
+        Canonical.AppendInt(static_cast<int32>(Variable.Type));
+        AppendField(Canonical, Variable.TypeName);
+        Canonical.AppendChar(Variable.bIsArray ? TEXT('a') : TEXT('-'));
+        Canonical.AppendChar(Variable.bIsSet ? TEXT('s') : TEXT('-'));
+        Canonical.AppendChar(Variable.bIsMap ? TEXT('m') : TEXT('-'));
+        Canonical.AppendInt(static_cast<int32>(Variable.KeyType));
+        AppendField(Canonical, Variable.KeyTypeName);
+        AppendField(Canonical, Variable.DefaultValue);
+    }
+
+    const FTCHARToUTF8 CanonicalUtf8(*Canonical);
+    FSHA1 Hasher;
+    Hasher.Update(reinterpret_cast<const uint8*>(CanonicalUtf8.Get()), CanonicalUtf8.Length());
+    Hasher.Final();
+
+    uint8 Digest[FSHA1::DigestSize];
+    Hasher.GetHash(Digest);
+    return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+void FN2CNodeTranslator::PartitionGraph(
+    const FN2CGraph& Graph,
+    int32 MaxPartTokens,
+    TFunctionRef<int32(const FN2CGraph&)> MeasureTokens,
+    TArray<FN2CGraph>& OutParts)
+{
+    OutParts.Reset();
+
+    const int32 NumNodes = Graph.Nodes.Num();
+
+    // Exec links give the regions, data links tell which pure nodes each region needs
+    TArray<TArray<int32>> ExecSuccessors;
+    ExecSuccessors.SetNum(NumNodes);
+    TArray<bool> bHasExecInput;
+    bHasExecInput.Init(false, NumNodes);
+    TArray<bool> bInExecFlow;
+    bInExecFlow.Init(false, NumNodes);
+
+    for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
+    {
+        const TConstArrayView<int32> Chain = Graph.Flows.GetExecutionChain(ChainIndex);
+        for (int32 Link = 0; Link + 1 < Chain.Num(); ++Link)
+        {
+            const int32 From = Chain[Link];
+            const int32 To = Chain[Link + 1];
+            if (Graph.Nodes.IsValidIndex(From) && Graph.Nodes.IsValidIndex(To))
+            {
+                ExecSuccessors[From].AddUnique(To);
+                bHasExecInput[To] = true;
+                bInExecFlow[From] = true;
+                bInExecFlow[To] = true;
+            }
+        }
+    }
+
+    // Data flows link an output pin to the input pin it feeds
+    TArray<TArray<int32>> DataProducers;
+    DataProducers.SetNum(NumNodes);
+    for (const FN2CDataFlow& Link : Graph.Flows.Data)
     {
-        Graphs.Append(InBlueprint->FunctionGraphs);
+        if (Graph.Nodes.IsValidIndex(Link.SourceNode) && Graph.Nodes.IsValidIndex(Link.TargetNode) && Link.SourceNode != Link.TargetNode)
+        {
+            DataProducers[Link.TargetNode].AddUnique(Link.SourceNode);
+        }
+    }
+
+    // Nodes of a part plus every pure node feeding them, in graph order
+    auto BuildPart = [&Graph, &NumNodes, &bInExecFlow, &DataProducers](const TArray<int32>& SeedNodes) -> FN2CGraph
+    {
+        TArray<bool> bIncluded;
+        bIncluded.Init(false, NumNodes);
+        TArray<int32> Pending = SeedNodes;
+        for (const int32 Node : SeedNodes)
+        {
+            bIncluded[Node] = true;
+        }
+        while (Pending.Num() > 0)
+        {
+            for (const int32 Producer : DataProducers[Pending.Pop()])
+            {
+                if (!bIncluded[Producer] && !bInExecFlow[Producer])
+                {
+                    bIncluded[Producer] = true;
+                    Pending.Add(Producer);
+                }
+            }
+        }
+
+        FN2CGraph Part;
+        Part.Name = Graph.Name;
+        Part.GraphType = Graph.GraphType;
+        Part.LocalVariables = Graph.LocalVariables;
+        Part.ReferencedNames = Graph.ReferencedNames;
+
+        // Index each included node has in the part
+        TArray<int32> PartIndices;
+        PartIndices.Init(INDEX_NONE, NumNodes);
+        for (int32 Index = 0; Index < NumNodes; ++Index)
+        {
+            if (bIncluded[Index])
+            {
+                PartIndices[Index] = Part.Nodes.Add(Graph.Nodes[Index]);
+            }
+        }
+        auto PartIndex = [&PartIndices](int32 NodeIndex)
+        {
+            return PartIndices.IsValidIndex(NodeIndex) ? PartIndices[NodeIndex] : INDEX_NONE;
+        };
+
+        // Keep the runs of each chain that stay inside the part
+        TArray<int32> Run;
+        for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
+        {
+            const TConstArrayView<int32> Chain = Graph.Flows.GetExecutionChain(ChainIndex);
+            Run.Reset();
+            for (int32 Link = 0; Link <= Chain.Num(); ++Link)
+            {
+                const int32 Node = Link < Chain.Num() ? PartIndex(Chain[Link]) : INDEX_NONE;
+                if (Node == INDEX_NONE)
+                {
+                    if (Run.Num() > 1)
+                    {
+                        Part.Flows.AddExecutionChain(Run);
+                    }
+                    Run.Reset();
+                }
+                else
+                {
+                    Run.Add(Node);
+                }
+            }
+        }
+
+        for (const FN2CDataFlow& Link : Graph.Flows.Data)
+        {
+            const int32 Source = PartIndex(Link.SourceNode);
+            const int32 Target = PartIndex(Link.TargetNode);
+            if (Source != INDEX_NONE && Target != INDEX_NONE)
+            {
+                Part.Flows.Data.Emplace(Source, Link.SourcePin, Target, Link.TargetPin);
+            }
+        }
+
+        return Part;
+    };
+
+    TArray<bool> bAssigned;
+    bAssigned.Init(false, NumNodes);
+
+    // Exec nodes reachable from Start that no earlier region claimed, not walking past StopNode
+    auto WalkExec = [&ExecSuccessors, &bAssigned, &NumNodes](int32 Start, int32 StopNode) -> TArray<int32>
+    {
+        TArray<int32> Region;
+        TArray<bool> bVisited;
+        bVisited.Init(false, NumNodes);
+        TArray<int32> Stack = { Start };
+        while (Stack.Num() > 0)
+        {
+            const int32 Node = Stack.Pop();
+            if (bVisited[Node] || bAssigned[Node])
+            {
+                continue;
+            }
+            bVisited[Node] = true;
+            Region.Add(Node);
+
+            if (Node != StopNode)
+            {
+                // Reversed so the first exec output is walked first
+                for (int32 Succ = ExecSuccessors[Node].Num() - 1; Succ >= 0; --Succ)
+                {
+                    Stack.Add(ExecSuccessors[Node][Succ]);
+                }
+            }
+        }
+        return Region;
+    };
+
+    TArray<TArray<int32>> Regions;
+    TFunction<void(int32)> AddRegion = [&](int32 Start)
+    {
+        TArray<int32> Region = WalkExec(Start, INDEX_NONE);
+        if (Region.Num() > 1 && MeasureTokens(BuildPart(Region)) > MaxPartTokens)
+        {
+            // Every node before the first branch has a single successor, so the prefix is a straight path
+            const int32* Branch = Region.FindByPredicate([&ExecSuccessors, &bAssigned](int32 Node)
+            {
+                return Algo::CountIf(ExecSuccessors[Node], [&bAssigned](int32 Succ) { return !bAssigned[Succ]; }) > 1;
+            });
+            if (Branch)
+            {
+                const int32 BranchNode = *Branch;
+                TArray<int32> Prefix = WalkExec(Start, BranchNode);
+                for (const int32 Node : Prefix)
+                {
+                    bAssigned[Node] = true;
+                }
+                Regions.Add(MoveTemp(Prefix));
+
+                for (const int32 Succ : ExecSuccessors[BranchNode])
+                {
+                    if (!bAssigned[Succ])
+                    {
+                        AddRegion(Succ);
+                    }
+                }
+                return;
+            }
+        }
+
+        for (const int32 Node : Region)
+        {
+            bAssigned[Node] = true;
+        }
+        Regions.Add(MoveTemp(Region));
+    };
+
+    // Entries first, then anything only reachable through a cycle
+    for (int32 Index = 0; Index < NumNodes; ++Index)
+    {
+        if (bInExecFlow[Index] && !bHasExecInput[Index] && !bAssigned[Index])
+        {
+            AddRegion(Index);
+        }
+    }
+    for (int32 Index = 0; Index < NumNodes; ++Index)
+    {
+        if (bInExecFlow[Index] && !bAssigned[Index])
+        {
+            AddRegion(Index);
+        }
+    }
+
+    // Pure nodes no exec node reads from (and comments) travel together in a region of their own
+    TArray<int32> Unreferenced;
+    {
+        TArray<bool> bUsed = bInExecFlow;
+        for (int32 Index = 0; Index < NumNodes; ++Index)
+        {
+            if (bInExecFlow[Index])
+            {
+                for (const int32 Producer : DataProducers[Index])
+                {
+                    bUsed[Producer] = true;
+                }
+            }
+        }
+
+        // Producers of used pure nodes are used too; repeat until nothing changes
+        bool bChanged = true;
+        while (bChanged)
+        {
+            bChanged = false;
+            for (int32 Index = 0; Index < NumNodes; ++Index)
+            {
+                if (bUsed[Index] && !bInExecFlow[Index])
+                {
+                    for (const int32 Producer : DataProducers[Index])
+                    {
+                        if (!bUsed[Producer])
+                        {
+                            bUsed[Producer] = true;
+                            bChanged = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int32 Index = 0; Index < NumNodes; ++Index)
+        {
+            if (!bUsed[Index])
+            {
+                Unreferenced.Add(Index);
+            }
+        }
     }
-    if (InBlueprint->MacroGraphs.Num() > 0)
+    if (Unreferenced.Num() > 0)
     {
-        Graphs.Append(InBlueprint->MacroGraphs);
+        Regions.Add(MoveTemp(Unreferenced));
     }
 
-    for (UEdGraph* Graph : Graphs)
+    // Pack consecutive regions while the part still fits
+    TArray<int32> Current;
+    for (const TArray<int32>& Region : Regions)
     {
-        if (!Graph)
+        TArray<int32> Candidate = Current;
+        Candidate.Append(Region);
+
+        if (Current.Num() > 0 && MeasureTokens(BuildPart(Candidate)) > MaxPartTokens)
         {
-            continue;
+            OutParts.Add(BuildPart(Current));
+            Current = Region;
         }
-        CurrentDepth = 0;
-        ProcessGraph(Graph, DetermineGraphType(Graph));
-    }
-
-    // Collect component overrides defined on this Blueprint (SimpleConstructionScript)
-    CollectComponentOverrides(InBlueprint);
-
-    // Variables
-    if (bIncludeVariables)
-    {
-        for (const FBPVariableDescription& Desc : InBlueprint->NewVariables)
+        else
         {
-            FN2CVariable Var;
-            ConvertVariableDescription(Desc, Var);
-            N2CBlueprint.Variables.Add(Var);
+            Current = MoveTemp(Candidate);
         }
     }
+    if (Current.Num() > 0 || OutParts.Num() == 0)
+    {
+        OutParts.Add(BuildPart(Current));
+    }
 
-    // Synthesize a dedicated ClassItSelf graph to carry only class-level structure
-    // (UCLASS, class declaration, UPROPERTY members, ctor/dtor) separate from EventGraph logic.
-    // 
-    // NOTE: ClassItSelf is a synthetic graph type that does not correspond to any actual Blueprint graph.
-    // It serves as a marker for the LLM to generate class-level C++ code (class declaration, constructor,
-    // destructor, member variables, and component declarations). The actual class-level data (variables
-    // and components) are stored at the Blueprint level (N2CBlueprint.Variables and N2CBlueprint.Components),
-    // not within this graph. The graph itself is intentionally empty (no nodes) because it represents
-    // class structure, not executable flow.
+    for (const FN2CGraph& Part : OutParts)
     {
-        FN2CGraph ClassItSelfGraph;
-        ClassItSelfGraph.Name = TEXT("ClassItSelf");
-        ClassItSelfGraph.GraphType = EN2CGraphType::ClassItSelf;
-        // Intentionally leave this graph empty - it's a marker for class-level code generation
-        // The LLM will use this graph type along with Blueprint-level Variables[] and Components[]
-        // arrays to generate the class skeleton in C++
-        N2CBlueprint.Graphs.Add(ClassItSelfGraph);
+        const int32 PartTokens = MeasureTokens(Part);
+        if (PartTokens > MaxPartTokens)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(
+                TEXT("Graph %s has an exec path of ~%d tokens that cannot be split below the %d token budget"),
+                *Graph.Name, PartTokens, MaxPartTokens));
+        }
     }
-    FString Ctx = FString::Printf(
-        TEXT("Generated from Blueprint: %s (Graphs=%d, Vars=%d, Components=%d)"),
-        *N2CBlueprint.Metadata.Name,
-        N2CBlueprint.Graphs.Num(),
-        N2CBlueprint.Variables.Num(),
-        N2CBlueprint.Components.Num());
-    FN2CLogger::Get().Log(TEXT("Blueprint translation complete"), EN2CLogSeverity::Info, Ctx);
-    return N2CBlueprint.Graphs.Num() > 0;
 }
 
 void FN2CNodeTranslator::CollectComponentOverrides(UBlueprint* InBlueprint)
@@ -266,6 +1080,20 @@ void FN2CNodeTranslator::CollectComponentOverrides(UBlueprint* InBlueprint)
         return;
     }
 
+    // Index the SCS nodes by template once so parent lookups don't rescan every node
+    TMap<const UActorComponent*, const USCS_Node*> NodesByTemplate;
+    NodesByTemplate.Reserve(AllNodes.Num());
+    for (const USCS_Node* Node : AllNodes)
+    {
+        if (Node && Node->ComponentTemplate)
+        {
+            NodesByTemplate.Add(Node->ComponentTemplate, Node);
+        }
+    }
+
+    // Blueprint component classes share one filtered property list within this Blueprint
+    TMap<TWeakObjectPtr<const UClass>, TArray<FComponentProperty>> BlueprintComponentProperties;
+
     for (USCS_Node* Node : AllNodes)
     {
         if (!Node)
@@ -298,37 +1126,15 @@ void FN2CNodeTranslator::CollectComponentOverrides(UBlueprint* InBlueprint)
         // Note: Different UE versions have different APIs for accessing SCS node hierarchy
         ComponentOverride.AttachParentName = TEXT("");
 
-        // For SceneComponents, try to find parent through AttachParent property
+        // For SceneComponents, find the SCS node whose template is the AttachParent
         if (USceneComponent* SceneComp = Cast<USceneComponent>(Template))
         {
-            // Check AttachParent property (FObjectProperty pointing to the parent component)
-            // FindField is a template function, need to use the correct syntax
-            FObjectProperty* AttachParentProp = CastField<FObjectProperty>(
-                ComponentClass->FindPropertyByName(TEXT("AttachParent")));
-
-            if (AttachParentProp)
+            if (const USCS_Node* const* ParentNode = NodesByTemplate.Find(SceneComp->GetAttachParent()))
             {
-                UObject* AttachParentObj = AttachParentProp->GetObjectPropertyValue(
-                    AttachParentProp->ContainerPtrToValuePtr<void>(Template));
-
-                if (USceneComponent* AttachParent = Cast<USceneComponent>(AttachParentObj))
-                {
-                    // Find the SCS node that corresponds to this parent component
-                    // by matching the component template
-                    for (USCS_Node* OtherNode : AllNodes)
-                    {
-                        if (OtherNode && OtherNode->ComponentTemplate == AttachParent)
-                        {
-                            ComponentOverride.AttachParentName = OtherNode->GetVariableName().ToString();
-                            FN2CLogger::Get().Log(FString::Printf(
-                                TEXT("Component '%s' has parent '%s' from AttachParent property"),
-                                *ComponentOverride.ComponentName,
-                                *ComponentOverride.AttachParentName),
-                                EN2CLogSeverity::Debug);
-                            break;
-                        }
-                    }
-                }
+                ComponentOverride.AttachParentName = (*ParentNode)->GetVariableName().ToString();
+                N2C_LOG(Debug, TEXT("Component '%s' has parent '%s' from AttachParent property"),
+                    *ComponentOverride.ComponentName,
+                    *ComponentOverride.AttachParentName);
             }
         }
 
@@ -342,76 +1148,34 @@ void FN2CNodeTranslator::CollectComponentOverrides(UBlueprint* InBlueprint)
             {
                 // Likely the root component, no parent
                 ComponentOverride.AttachParentName = TEXT("");
-                FN2CLogger::Get().Log(FString::Printf(
-                    TEXT("Component '%s' is likely the root component (no parent)"),
-                    *ComponentOverride.ComponentName),
-                    EN2CLogSeverity::Debug);
+                N2C_LOG(Debug, TEXT("Component '%s' is likely the root component (no parent)"),
+                    *ComponentOverride.ComponentName);
             }
         }
-        // Diff properties between the Blueprint component template and the class CDO
-        for (TFieldIterator<FProperty> PropIt(ComponentClass, EFieldIteratorFlags::IncludeSuper); PropIt; ++PropIt)
-        {
-            FProperty* Property = *PropIt;
-            if (!Property)
-            {
-                continue;
-            }
 
-            // Skip transient or non-config properties that are unlikely to be Blueprint-edited defaults
-            if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient | CPF_TextExportTransient))
-            {
-                continue;
-            }
+        TMap<TWeakObjectPtr<const UClass>, TArray<FComponentProperty>>& PropertyCache =
+            ComponentClass->HasAnyClassFlags(CLASS_Native) ? NativeComponentProperties : BlueprintComponentProperties;
+        const TArray<FComponentProperty>* ComponentProperties = PropertyCache.Find(ComponentClass);
+        if (!ComponentProperties)
+        {
+            TArray<FComponentProperty>& Built = PropertyCache.Add(ComponentClass);
+            BuildComponentProperties(ComponentClass, Built);
+            ComponentProperties = &Built;
+        }
 
-            // If values are identical, skip
+        // Diff properties between the Blueprint component template and the class CDO. Most are unchanged,
+        // so only the ones that differ are exported
+        for (const FComponentProperty& ComponentProperty : *ComponentProperties)
+        {
+            const FProperty* Property = ComponentProperty.Property;
             if (Property->Identical_InContainer(Template, ClassDefaultObject))
             {
                 continue;
             }
 
-            FN2CVariable Var;
-            Var.Name = Property->GetName();
-
-            // Map property type to EN2CStructMemberType and TypeName when possible
-            Var.Type = ConvertPropertyToStructMemberType(Property);
-
-            if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
-            {
-                if (UScriptStruct* Struct = StructProp->Struct)
-                {
-                    Var.TypeName = Struct->GetName();
-                }
-            }
-            else if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
-            {
-                if (UClass* ObjClass = ObjProp->PropertyClass)
-                {
-                    Var.TypeName = ObjClass->GetName();
-                }
-            }
-            else if (FClassProperty* ClassProp = CastField<FClassProperty>(Property))
-            {
-                if (UClass* MetaClass = ClassProp->MetaClass)
-                {
-                    Var.TypeName = MetaClass->GetName();
-                }
-            }
-            else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
-            {
-                if (UEnum* Enum = EnumProp->GetEnum())
-                {
-                    Var.TypeName = Enum->GetName();
-                }
-            }
-
-            // Export the overridden value as text
-            FString ExportedValue;
-            void* TemplateValuePtr = Property->ContainerPtrToValuePtr<void>(Template);
-            void* DefaultValuePtr = Property->ContainerPtrToValuePtr<void>(ClassDefaultObject);
-            Property->ExportText_Direct(ExportedValue, TemplateValuePtr, DefaultValuePtr, nullptr, PPF_None);
-            Var.DefaultValue = ExportedValue;
-
-            ComponentOverride.OverriddenProperties.Add(Var);
+            FN2CVariable& Var = ComponentOverride.OverriddenProperties.Add_GetRef(ComponentProperty.Variable);
+            Property->ExportText_Direct(Var.DefaultValue, Property->ContainerPtrToValuePtr<void>(Template),
+                Property->ContainerPtrToValuePtr<void>(ClassDefaultObject), nullptr, PPF_None);
         }
 
         const bool bHasOverrides = ComponentOverride.OverriddenProperties.Num() > 0;
@@ -430,6 +1194,56 @@ void FN2CNodeTranslator::CollectComponentOverrides(UBlueprint* InBlueprint)
     }
 }
 
+void FN2CNodeTranslator::BuildComponentProperties(const UClass* ComponentClass, TArray<FComponentProperty>& OutProperties) const
+{
+    for (TFieldIterator<FProperty> PropIt(ComponentClass, EFieldIteratorFlags::IncludeSuper); PropIt; ++PropIt)
+    {
+        // Skip transient or non-config properties that are unlikely to be Blueprint-edited defaults
+        FProperty* Property = *PropIt;
+        if (!Property || Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient | CPF_TextExportTransient))
+        {
+            continue;
+        }
+
+        FComponentProperty& Entry = OutProperties.AddDefaulted_GetRef();
+        Entry.Property = Property;
+        FN2CVariable& Var = Entry.Variable;
+        Var.Name = Property->GetName();
+
+        // Map property type to EN2CStructMemberType and TypeName when possible
+        Var.Type = ConvertPropertyToStructMemberType(Property);
+
+        if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+        {
+            if (UScriptStruct* Struct = StructProp->Struct)
+            {
+                Var.TypeName = Struct->GetName();
+            }
+        }
+        else if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
+        {
+            if (UClass* ObjClass = ObjProp->PropertyClass)
+            {
+                Var.TypeName = ObjClass->GetName();
+            }
+        }
+        else if (FClassProperty* ClassProp = CastField<FClassProperty>(Property))
+        {
+            if (UClass* MetaClass = ClassProp->MetaClass)
+            {
+                Var.TypeName = MetaClass->GetName();
+            }
+        }
+        else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+        {
+            if (UEnum* Enum = EnumProp->GetEnum())
+            {
+                Var.TypeName = Enum->GetName();
+            }
+        }
+    }
+}
+
 void FN2CNodeTranslator::ConvertVariableDescription(const FBPVariableDescription& Desc, FN2CVariable& OutVar)
 {
     OutVar = FN2CVariable();
@@ -587,17 +1401,28 @@ void FN2CNodeTranslator::CollectLocalVariables(UK2Node_FunctionEntry* EntryNode,
     }
 }
 
-FString FN2CNodeTranslator::GenerateNodeID()
+int32 FN2CNodeTranslator::FindOrAddNodeNumber(const FGuid& NodeGuid, FGraphTranslationContext& Context)
 {
-    return FString::Printf(TEXT("N%d"), NodeIDMap.Num() + 1);
+    if (const int32* Existing = Context.NodeIDMap.Find(NodeGuid))
+    {
+        return *Existing;
+    }
+    return Context.NodeIDMap.Add(NodeGuid, Context.NodeIDMap.Num() + 1);
+}
+
+void FN2CNodeTranslator::AppendNodeID(FString& Out, int32 NodeNumber)
+{
+    Out.AppendChar(TEXT('N'));
+    Out.AppendInt(NodeNumber);
 }
 
-FString FN2CNodeTranslator::GeneratePinID(int32 PinCount)
+void FN2CNodeTranslator::AppendPinID(FString& Out, int32 PinNumber)
 {
-    return FString::Printf(TEXT("P%d"), PinCount + 1);
+    Out.AppendChar(TEXT('P'));
+    Out.AppendInt(PinNumber);
 }
 
-bool FN2CNodeTranslator::InitializeNodeProcessing(UK2Node* Node, FN2CNodeDefinition& OutNodeDef)
+bool FN2CNodeTranslator::InitializeNodeProcessing(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
 {
     if (!Node)
     {
@@ -612,203 +1437,406 @@ bool FN2CNodeTranslator::InitializeNodeProcessing(UK2Node* Node, FN2CNodeDefinit
         return false;
     }
 
-    // Check if we already have an ID for this node
-    FString* ExistingID = NodeIDMap.Find(Node->NodeGuid);
-    if (ExistingID)
+    // Reuse the node's number if a flow already referenced it, otherwise assign the next one
+    const bool bExisting = Context.NodeIDMap.Contains(Node->NodeGuid);
+    const int32 NodeNumber = FindOrAddNodeNumber(Node->NodeGuid, Context);
+    OutNodeDef.ID.Reset();
+    AppendNodeID(OutNodeDef.ID, NodeNumber);
+    N2C_LOG(Debug, TEXT("%s node ID %s for node %s"), 
+        bExisting ? TEXT("Reusing existing") : TEXT("Generated new"),
+        *OutNodeDef.ID,
+        *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+
+    return true;
+}
+
+bool FN2CNodeTranslator::ProcessNode(const FN2CCollectedNode& Collected, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CProcessNode);
+
+    UK2Node* Node = Collected.Node;
+    if (!InitializeNodeProcessing(Node, OutNodeDef, Context))
+    {
+        return false;
+    }
+
+    // Every node processed successfully is appended to the context's graph by the caller
+    Context.NodeIndexMap.Add(Node->NodeGuid, Context.Graph.Nodes.Num());
+
+    // An unchanged node reuses its definition, but the types and graphs it references are still queued for this translation
+    const uint32 Signature = ComputeNodeSignature(Collected);
+    if (FindCachedNode(Collected, Signature, OutNodeDef))
+    {
+        MapNodePins(Collected, Context);
+        ProcessNodeReferences(Node, OutNodeDef, Context);
+    }
+    else
+    {
+        ProcessNodeTypeAndProperties(Node, OutNodeDef, Context);
+        ProcessNodePins(Collected, OutNodeDef, Context);
+        StoreCachedNode(Collected, Signature, OutNodeDef);
+    }
+
+    ProcessNodeFlows(Collected, Context);
+    LogNodeDetails(OutNodeDef);
+
+    return true;
+}
+
+void FN2CNodeTranslator::AddGraphToProcess(UEdGraph* Graph, FGraphTranslationContext& Context)
+{
+    if (!Graph)
+    {
+        return;
+    }
+
+    // Graphs already processed or queued for the Blueprint are filtered out in MergeGraphContext,
+    // repeat references from the same graph are dropped here
+    if (Context.DiscoveredGraphSet.Contains(Graph))
+    {
+        return;
+    }
+
+    // Check if this is a user-created graph
+    bool bIsUserCreated = false;
+
+    // Check if this is a composite/collapsed graph
+    if (Cast<UK2Node_Composite>(Graph->GetOuter()))
+    {
+        bIsUserCreated = !Graph->GetOuter()->IsA<UK2Node_MathExpression>();  
+
+        if (bIsUserCreated)
+        {
+            N2C_LOG(Debug, TEXT("Found composite graph: %s"), *Graph->GetName());
+        }
+    }
+    // Otherwise check if it's in a user content directory
+    else if (UBlueprint* OwningBP = Cast<UBlueprint>(Graph->GetOuter()))
+    {
+        // Check if the Blueprint is in a user content directory
+        bIsUserCreated = IsUserContent(OwningBP);
+
+        // For macros, also check if it's a user-created macro
+        if (UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Graph->GetOuter()))
+        {
+            if (UEdGraph* MacroGraph = MacroNode->GetMacroGraph())
+            {
+                if (UBlueprint* MacroBP = Cast<UBlueprint>(MacroGraph->GetOuter()))
+                {
+                    bIsUserCreated = IsUserContent(MacroBP);
+                }
+            }
+        }
+    }
+
+    // Only process user-created graphs
+    if (bIsUserCreated)
     {
-        OutNodeDef.ID = *ExistingID;
-        FString Context = FString::Printf(TEXT("Reusing existing node ID %s for node %s"), 
-            *OutNodeDef.ID,
-            *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-        FN2CLogger::Get().Log(Context, EN2CLogSeverity::Debug);
+        // Now check recursion depth limit since we know it's a user graph
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        int32 NextDepth = Context.Depth + 1;
+        if (Settings && NextDepth > Settings->TranslationDepth)
+        {
+            FString LogContext = FString::Printf(TEXT("Skipping graph '%s' - maximum translation depth reached (%d)"), 
+                *Graph->GetName(), Settings->TranslationDepth);
+            FN2CLogger::Get().Log(LogContext, EN2CLogSeverity::Warning);
+            return;
+        }
+
+        Context.DiscoveredGraphSet.Add(Graph);
+
+        // The library is translated on its own, and the macro instance node already names the graph
+        UBlueprint* MacroLibrary = Cast<UBlueprint>(Graph->GetOuter());
+        if (bShareMacroGraphs && MacroLibrary && MacroLibrary->BlueprintType == BPTYPE_MacroLibrary)
+        {
+            N2C_LOG(Debug, TEXT("Leaving shared macro graph to its library: %s"), *Graph->GetName());
+            Context.SharedMacroNames.Add(GetCleanClassName(Graph->GetName()));
+            Context.MacroLibraries.Add(MacroLibrary);
+            return;
+        }
+
+        Context.DiscoveredGraphs.Add(FGraphProcessInfo(Graph, Context.Depth));
     }
     else
     {
-        // Generate and map new node ID
-        FString NodeID = GenerateNodeID();
-        NodeIDMap.Add(Node->NodeGuid, NodeID);
-        OutNodeDef.ID = NodeID;
-        FString Context = FString::Printf(TEXT("Generated new node ID %s for node %s"), 
-            *NodeID,
-            *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-        FN2CLogger::Get().Log(Context, EN2CLogSeverity::Debug);
+        // Only log at Debug severity since this is expected behavior
+        N2C_LOG(Debug, TEXT("Skipping engine graph: %s"), *Graph->GetName());
+    }
+}
+
+bool FN2CNodeTranslator::ProcessGraph(UEdGraph* Graph, EN2CGraphType GraphType, FGraphTranslationContext& Context)
+{
+    if (!Graph)
+    {
+        FN2CLogger::Get().LogWarning(TEXT("Attempted to process null graph"));
+        return false;
+    }
+
+    TArray<FN2CCollectedNode> CollectedNodes;
+    BeginGraph(Graph, GraphType, Context, CollectedNodes);
+    ReserveGraphContext(CollectedNodes, Context);
+    for (const FN2CCollectedNode& Collected : CollectedNodes)
+    {
+        FN2CNodeDefinition NodeDef;
+        if (ProcessNode(Collected, NodeDef, Context))
+        {
+            Context.Graph.Nodes.Add(MoveTemp(NodeDef));
+        }
+    }
+    return FinishGraph(Context);
+}
+
+void FN2CNodeTranslator::BeginGraph(UEdGraph* Graph, EN2CGraphType GraphType, FGraphTranslationContext& Context, TArray<FN2CCollectedNode>& OutCollectedNodes)
+{
+    // Fill the graph structure owned by this context
+    FN2CGraph& NewGraph = Context.Graph;
+    NewGraph.Name = Graph->GetName();
+    NewGraph.GraphType = GraphType;
+
+    // Collect function-local variables from the entry node (if any)
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node))
+        {
+            CollectLocalVariables(EntryNode, NewGraph.LocalVariables);
+            break;
+        }
+    }
+
+    // Collapse reroute chains once so flow extraction is a single lookup per link
+    BuildKnotResolution(Graph, Context);
+
+    // Collect the nodes from this graph
+    FN2CNodeCollector::Get().CollectNodesFromGraph(Graph, OutCollectedNodes);
+}
+
+void FN2CNodeTranslator::ReserveGraphContext(const TArray<FN2CCollectedNode>& CollectedNodes, FGraphTranslationContext& Context)
+{
+    // Count what the graph's nodes will add so each container is allocated once
+    int32 NumPins = 0;
+    int32 NumExecLinks = 0;
+    int32 NumDataSources = 0;
+    for (const FN2CCollectedNode& Collected : CollectedNodes)
+    {
+        NumPins += Collected.Pins.Num();
+        for (const UEdGraphPin* ExecOutput : Collected.ExecOutputs)
+        {
+            NumExecLinks += ExecOutput->LinkedTo.Num();
+        }
+        for (const UEdGraphPin* Pin : Collected.Pins)
+        {
+            if (Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0 && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
+            {
+                NumDataSources++;
+            }
+        }
+    }
+
+    const int32 NumNodes = CollectedNodes.Num();
+    Context.Graph.Nodes.Reserve(NumNodes);
+    Context.NodeIDMap.Reserve(NumNodes);
+    Context.NodeIndexMap.Reserve(NumNodes);
+    Context.PinIDMap.Reserve(NumPins);
+    Context.PinIndexMap.Reserve(NumPins);
+    Context.PendingExecLinks.Reserve(NumExecLinks);
+    Context.Graph.Flows.Data.Reserve(NumDataSources);
+    Context.DataFlowBySource.Reserve(NumDataSources);
+}
+
+bool FN2CNodeTranslator::FinishGraph(FGraphTranslationContext& Context)
+{
+    FN2CGraph& NewGraph = Context.Graph;
+    ResolveExecutionFlows(Context);
+
+    // The graph is only added to the blueprint if it has nodes
+    if (NewGraph.Nodes.Num() > 0)
+    {
+        // Validate all flow references
+        if (!ValidateFlowReferences(NewGraph))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Flow validation issues found in graph: %s"), *NewGraph.Name));
+        }
+
+        FString LogContext = FString::Printf(TEXT("Processed graph: %s with %d nodes"), 
+            *NewGraph.Name, 
+            NewGraph.Nodes.Num());
+        FN2CLogger::Get().Log(TEXT("Graph processing complete"), EN2CLogSeverity::Info, LogContext);
+        
+        return true;
     }
 
-    return true;
+    return false;
 }
 
-bool FN2CNodeTranslator::ProcessNode(UK2Node* Node, FN2CNodeDefinition& OutNodeDef)
+bool FN2CNodeTranslator::IsUserContent(const UObject* Object)
 {
-    if (!InitializeNodeProcessing(Node, OutNodeDef))
+    const UPackage* Package = Object ? Object->GetOutermost() : nullptr;
+    if (!Package)
     {
         return false;
     }
 
-    ProcessNodeTypeAndProperties(Node, OutNodeDef);
+    // Every object in a package gets the same verdict, so the path test runs once per package
+    {
+        FReadScopeLock ReadLock(UserContentLock);
+        if (const bool* Cached = UserContentPackages.Find(Package))
+        {
+            return *Cached;
+        }
+    }
 
-    // Track pin connections for flows
-    TArray<UEdGraphPin*> ExecInputs;
-    TArray<UEdGraphPin*> ExecOutputs;
-    ProcessNodePins(Node, OutNodeDef, ExecInputs, ExecOutputs);
-    ProcessNodeFlows(Node, ExecInputs, ExecOutputs);
-    LogNodeDetails(OutNodeDef);
+    const FString PackageName = Package->GetName();
+    const bool bIsUserContent = PackageName.StartsWith(TEXT("/Game/")) || PackageName.Contains(TEXT("/Content/"));
 
-    return true;
+    FWriteScopeLock WriteLock(UserContentLock);
+    UserContentPackages.Add(Package, bIsUserContent);
+    return bIsUserContent;
 }
 
-void FN2CNodeTranslator::AddGraphToProcess(UEdGraph* Graph)
+UEdGraph* FN2CNodeTranslator::FindFunctionGraph(const UBlueprint* Blueprint, FName FunctionName)
 {
-    if (!Graph)
+    if (!Blueprint)
     {
-        return;
+        return nullptr;
     }
 
-    // Check if we've already processed this graph
-    for (const FN2CGraph& ExistingGraph : N2CBlueprint.Graphs)
     {
-        if (ExistingGraph.Name == Graph->GetName())
+        FReadScopeLock ReadLock(FunctionGraphLock);
+        if (const TMap<FName, UEdGraph*>* Graphs = FunctionGraphIndex.Find(Blueprint))
         {
-            return;
+            return Graphs->FindRef(FunctionName);
         }
     }
 
-    // Check if this is a user-created graph
-    bool bIsUserCreated = false;
-
-    // Check if this is a composite/collapsed graph
-    if (Cast<UK2Node_Composite>(Graph->GetOuter()))
-    {
-        bIsUserCreated = !Graph->GetOuter()->IsA<UK2Node_MathExpression>();  
-
-        if (bIsUserCreated)
-        {
-            FString Context = FString::Printf(TEXT("Found composite graph: %s"), *Graph->GetName());
-            FN2CLogger::Get().Log(Context, EN2CLogSeverity::Debug);
-        }
-    }
-    // Otherwise check if it's in a user content directory
-    else if (UBlueprint* OwningBP = Cast<UBlueprint>(Graph->GetOuter()))
+    // Index every function graph of the Blueprint at once, so further calls into it are a lookup
+    FWriteScopeLock WriteLock(FunctionGraphLock);
+    TMap<FName, UEdGraph*>& Graphs = FunctionGraphIndex.FindOrAdd(Blueprint);
+    if (Graphs.Num() == 0)
     {
-        // Check if the Blueprint is in a user content directory
-        FString BlueprintPath = OwningBP->GetPathName();
-        bIsUserCreated = BlueprintPath.Contains(TEXT("/Game/")) || 
-                        BlueprintPath.Contains(TEXT("/Content/"));
-
-        // For macros, also check if it's a user-created macro
-        if (UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Graph->GetOuter()))
+        Graphs.Reserve(Blueprint->FunctionGraphs.Num());
+        for (UEdGraph* FuncGraph : Blueprint->FunctionGraphs)
         {
-            if (UEdGraph* MacroGraph = MacroNode->GetMacroGraph())
+            if (FuncGraph)
             {
-                if (UBlueprint* MacroBP = Cast<UBlueprint>(MacroGraph->GetOuter()))
+                // The first graph of a name wins, as it did when the graphs were scanned in order
+                if (!Graphs.Contains(FuncGraph->GetFName()))
                 {
-                    FString MacroPath = MacroBP->GetPathName();
-                    bIsUserCreated = MacroPath.Contains(TEXT("/Game/")) || 
-                                   MacroPath.Contains(TEXT("/Content/"));
+                    Graphs.Add(FuncGraph->GetFName(), FuncGraph);
                 }
             }
         }
     }
+    return Graphs.FindRef(FunctionName);
+}
 
-    // Only process user-created graphs
-    if (bIsUserCreated)
+void FN2CNodeTranslator::RecordMacroDepths()
+{
+    TMap<FString, int32> MacroGraphs;
+    for (int32 GraphIndex = 0; GraphIndex < N2CBlueprint.Graphs.Num(); ++GraphIndex)
     {
-        // Now check recursion depth limit since we know it's a user graph
-        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-        int32 NextDepth = CurrentDepth + 1;
-        if (Settings && NextDepth > Settings->TranslationDepth)
+        if (N2CBlueprint.Graphs[GraphIndex].GraphType == EN2CGraphType::Macro)
         {
-            FString Context = FString::Printf(TEXT("Skipping graph '%s' - maximum translation depth reached (%d)"), 
-                *Graph->GetName(), Settings->TranslationDepth);
-            FN2CLogger::Get().Log(Context, EN2CLogSeverity::Warning);
-            return;
+            MacroGraphs.Add(N2CBlueprint.Graphs[GraphIndex].Name, GraphIndex);
         }
+    }
 
-        // Check if we already have this graph queued
-        bool bAlreadyQueued = false;
-        for (const FGraphProcessInfo& Info : AdditionalGraphsToProcess)
+    // Depth first with memoization; a graph still being measured counts as no deeper, which ends recursive macros
+    TArray<int32> Depths;
+    Depths.Init(INDEX_NONE, N2CBlueprint.Graphs.Num());
+    TFunction<int32(int32)> MeasureDepth = [this, &MacroGraphs, &Depths, &MeasureDepth](int32 GraphIndex)
+    {
+        if (Depths[GraphIndex] != INDEX_NONE)
         {
-            if (Info.Graph == Graph)
-            {
-                bAlreadyQueued = true;
-                break;
-            }
+            return Depths[GraphIndex];
         }
+        Depths[GraphIndex] = 0;
 
-        if (!bAlreadyQueued)
+        int32 Depth = 0;
+        for (const FN2CNodeDefinition& Node : N2CBlueprint.Graphs[GraphIndex].Nodes)
         {
-            FString Context = FString::Printf(TEXT("Adding user-created graph to process: %s (Parent Depth: %d)"), 
-                *Graph->GetName(), CurrentDepth);
-            FN2CLogger::Get().Log(Context, EN2CLogSeverity::Debug);
-            AdditionalGraphsToProcess.Add(FGraphProcessInfo(Graph, CurrentDepth));
+            if (Node.NodeType == EN2CNodeType::MacroInstance)
+            {
+                const int32* MacroGraph = MacroGraphs.Find(Node.MemberName);
+                Depth = FMath::Max(Depth, 1 + (MacroGraph && *MacroGraph != GraphIndex ? MeasureDepth(*MacroGraph) : 0));
+            }
         }
-    }
-    else
+        Depths[GraphIndex] = Depth;
+        return Depth;
+    };
+
+    for (int32 GraphIndex = 0; GraphIndex < N2CBlueprint.Graphs.Num(); ++GraphIndex)
     {
-        // Only log at Debug severity since this is expected behavior
-        FString Context = FString::Printf(TEXT("Skipping engine graph: %s"), *Graph->GetName());
-        FN2CLogger::Get().Log(Context, EN2CLogSeverity::Debug);
+        N2CBlueprint.Graphs[GraphIndex].Complexity.MacroDepth = MeasureDepth(GraphIndex);
     }
 }
 
-bool FN2CNodeTranslator::ProcessGraph(UEdGraph* Graph, EN2CGraphType GraphType)
+void FN2CNodeTranslator::MergeGraphContext(FGraphTranslationContext& Context, bool bAddGraph)
 {
-    if (!Graph)
+    // Record what the graph uses before its types are moved into the Blueprint
+    if (bAddGraph)
     {
-        FN2CLogger::Get().LogWarning(TEXT("Attempted to process null graph"));
-        return false;
+        FN2CGraph& Graph = Context.Graph;
+        Graph.RecordReferencedNames();
+        Graph.RecordComplexity();
+        for (const TPair<FString, FN2CStruct>& Struct : Context.Structs)
+        {
+            Graph.ReferencedNames.Add(Struct.Value.Name);
+        }
+        for (const TPair<FString, FN2CEnum>& Enum : Context.Enums)
+        {
+            Graph.ReferencedNames.Add(Enum.Value.Name);
+        }
     }
 
-    // Create new graph structure
-    FN2CGraph NewGraph;
-    NewGraph.Name = Graph->GetName();
-    NewGraph.GraphType = GraphType;
-
-    // Collect function-local variables from the entry node (if any)
-    for (UEdGraphNode* Node : Graph->Nodes)
+    // Types are deduplicated across graphs here, in merge order, so the result matches serial processing
+    for (TPair<FString, FN2CStruct>& Struct : Context.Structs)
     {
-        if (UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node))
+        if (!ProcessedStructPaths.Contains(Struct.Key))
         {
-            CollectLocalVariables(EntryNode, NewGraph.LocalVariables);
-            break;
+            ProcessedStructPaths.Add(Struct.Key);
+            N2CBlueprint.Structs.Add(MoveTemp(Struct.Value));
         }
     }
 
-    CurrentGraph = &NewGraph;
-
-    // Collect and process nodes from this graph
-    TArray<UK2Node*> GraphNodes;
-    for (UEdGraphNode* Node : Graph->Nodes)
+    for (TPair<FString, FN2CEnum>& Enum : Context.Enums)
     {
-        if (UK2Node* K2Node = Cast<UK2Node>(Node))
+        if (!ProcessedEnumPaths.Contains(Enum.Key))
         {
-            FN2CNodeDefinition NodeDef;
-            if (ProcessNode(K2Node, NodeDef))
-            {
-                CurrentGraph->Nodes.Add(NodeDef);
-            }
+            ProcessedEnumPaths.Add(Enum.Key);
+            N2CBlueprint.Enums.Add(MoveTemp(Enum.Value));
         }
     }
 
-    // Add the processed graph to the blueprint if it has nodes
-    if (CurrentGraph->Nodes.Num() > 0)
+    if (bAddGraph)
     {
-        // Validate all flow references
-        if (!ValidateFlowReferences(NewGraph))
+        ProcessedGraphNames.Add(Context.Graph.Name);
+        N2CBlueprint.Graphs.Add(MoveTemp(Context.Graph));
+    }
+
+    for (UBlueprint* MacroLibrary : Context.MacroLibraries)
+    {
+        SharedMacroLibraries.AddUnique(MacroLibrary);
+    }
+    SharedMacroNames.Append(Context.SharedMacroNames);
+
+    for (const FGraphProcessInfo& Discovered : Context.DiscoveredGraphs)
+    {
+        // Skip graphs we've already processed (by name) or queued (by pointer)
+        if (ProcessedGraphNames.Contains(Discovered.Graph->GetName()))
         {
-            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Flow validation issues found in graph: %s"), *NewGraph.Name));
+            continue;
         }
 
-        N2CBlueprint.Graphs.Add(NewGraph);
-        
-        FString Context = FString::Printf(TEXT("Processed graph: %s with %d nodes"), 
-            *NewGraph.Name, 
-            NewGraph.Nodes.Num());
-        FN2CLogger::Get().Log(TEXT("Graph processing complete"), EN2CLogSeverity::Info, Context);
-        
-        return true;
-    }
+        bool bAlreadyQueued = false;
+        QueuedGraphs.Add(Discovered.Graph, &bAlreadyQueued);
 
-    return false;
+        if (!bAlreadyQueued)
+        {
+            N2C_LOG(Debug, TEXT("Adding user-created graph to process: %s (Parent Depth: %d)"), 
+                *Discovered.Graph->GetName(), Discovered.ParentDepth);
+            AdditionalGraphsToProcess.Add(Discovered);
+        }
+    }
 }
 
 EN2CGraphType FN2CNodeTranslator::DetermineGraphType(UEdGraph* Graph) const
@@ -864,122 +1892,170 @@ EN2CPinType FN2CNodeTranslator::DeterminePinType(const UEdGraphPin* Pin) const
 {
     if (!Pin) return EN2CPinType::Wildcard;
 
-    const FName& PinCategory = Pin->PinType.PinCategory;
-    
-    // Handle execution pins
-    if (PinCategory == UEdGraphSchema_K2::PC_Exec)
-        return EN2CPinType::Exec;
-        
-    // Handle basic types
-    if (PinCategory == UEdGraphSchema_K2::PC_Boolean)
-        return EN2CPinType::Boolean;
-    if (PinCategory == UEdGraphSchema_K2::PC_Byte)
-        return EN2CPinType::Byte;
-    if (PinCategory == UEdGraphSchema_K2::PC_Int)
-        return EN2CPinType::Integer;
-    if (PinCategory == UEdGraphSchema_K2::PC_Int64)
-        return EN2CPinType::Integer64;
-    if (PinCategory == UEdGraphSchema_K2::PC_Float)
-        return EN2CPinType::Float;
-    if (PinCategory == UEdGraphSchema_K2::PC_Double)
-        return EN2CPinType::Double;
-    if (PinCategory == UEdGraphSchema_K2::PC_Real)
-        return EN2CPinType::Real;
-    if (PinCategory == UEdGraphSchema_K2::PC_String)
-        return EN2CPinType::String;
-    if (PinCategory == UEdGraphSchema_K2::PC_Name)
-        return EN2CPinType::Name;
-    if (PinCategory == UEdGraphSchema_K2::PC_Text)
-        return EN2CPinType::Text;
-        
-    // Handle object types
-    if (PinCategory == UEdGraphSchema_K2::PC_Object)
-        return EN2CPinType::Object;
-    if (PinCategory == UEdGraphSchema_K2::PC_Class)
-        return EN2CPinType::Class;
-    if (PinCategory == UEdGraphSchema_K2::PC_Interface)
-        return EN2CPinType::Interface;
-    if (PinCategory == UEdGraphSchema_K2::PC_Struct)
-        return EN2CPinType::Struct;
-    if (PinCategory == UEdGraphSchema_K2::PC_Enum)
-        return EN2CPinType::Enum;
-        
-    // Handle delegate types
-    if (PinCategory == UEdGraphSchema_K2::PC_Delegate)
-        return EN2CPinType::Delegate;
-    if (PinCategory == UEdGraphSchema_K2::PC_MCDelegate)
-        return EN2CPinType::MulticastDelegate;
-        
-    // Handle field path and special types
-    if (PinCategory == UEdGraphSchema_K2::PC_FieldPath)
-        return EN2CPinType::FieldPath;
-    if (PinCategory == UEdGraphSchema_K2::PC_Wildcard)
-        return EN2CPinType::Wildcard;
-        
-    // Handle soft references
-    if (PinCategory == UEdGraphSchema_K2::PC_SoftObject)
-        return EN2CPinType::SoftObject;
-    if (PinCategory == UEdGraphSchema_K2::PC_SoftClass)
-        return EN2CPinType::SoftClass;
-
-    // Handle special subcategories
-    if (Pin->PinType.PinSubCategory == UEdGraphSchema_K2::PSC_Bitmask)
-        return EN2CPinType::Bitmask;
-    if (Pin->PinType.PinSubCategory == UEdGraphSchema_K2::PSC_Self)
-        return EN2CPinType::Self;
-    if (Pin->PinType.PinSubCategory == UEdGraphSchema_K2::PSC_Index)
-        return EN2CPinType::Index;
+    // FName keys hash by index, so each pin is typed with one lookup instead of a comparison per category.
+    // Container and reference modifiers are recorded separately on the pin definition
+    static const TMap<FName, EN2CPinType> CategoryTypes = {
+        { UEdGraphSchema_K2::PC_Exec, EN2CPinType::Exec },
+        { UEdGraphSchema_K2::PC_Boolean, EN2CPinType::Boolean },
+        { UEdGraphSchema_K2::PC_Byte, EN2CPinType::Byte },
+        { UEdGraphSchema_K2::PC_Int, EN2CPinType::Integer },
+        { UEdGraphSchema_K2::PC_Int64, EN2CPinType::Integer64 },
+        { UEdGraphSchema_K2::PC_Float, EN2CPinType::Float },
+        { UEdGraphSchema_K2::PC_Double, EN2CPinType::Double },
+        { UEdGraphSchema_K2::PC_Real, EN2CPinType::Real },
+        { UEdGraphSchema_K2::PC_String, EN2CPinType::String },
+        { UEdGraphSchema_K2::PC_Name, EN2CPinType::Name },
+        { UEdGraphSchema_K2::PC_Text, EN2CPinType::Text },
+        { UEdGraphSchema_K2::PC_Object, EN2CPinType::Object },
+        { UEdGraphSchema_K2::PC_Class, EN2CPinType::Class },
+        { UEdGraphSchema_K2::PC_Interface, EN2CPinType::Interface },
+        { UEdGraphSchema_K2::PC_Struct, EN2CPinType::Struct },
+        { UEdGraphSchema_K2::PC_Enum, EN2CPinType::Enum },
+        { UEdGraphSchema_K2::PC_Delegate, EN2CPinType::Delegate },
+        { UEdGraphSchema_K2::PC_MCDelegate, EN2CPinType::MulticastDelegate },
+        { UEdGraphSchema_K2::PC_FieldPath, EN2CPinType::FieldPath },
+        { UEdGraphSchema_K2::PC_Wildcard, EN2CPinType::Wildcard },
+        { UEdGraphSchema_K2::PC_SoftObject, EN2CPinType::SoftObject },
+        { UEdGraphSchema_K2::PC_SoftClass, EN2CPinType::SoftClass },
+    };
+
+    // Special subcategories, for pins of no known category
+    static const TMap<FName, EN2CPinType> SubCategoryTypes = {
+        { UEdGraphSchema_K2::PSC_Bitmask, EN2CPinType::Bitmask },
+        { UEdGraphSchema_K2::PSC_Self, EN2CPinType::Self },
+        { UEdGraphSchema_K2::PSC_Index, EN2CPinType::Index },
+    };
+
+    if (const EN2CPinType* Type = CategoryTypes.Find(Pin->PinType.PinCategory))
+    {
+        return *Type;
+    }
+    if (const EN2CPinType* Type = SubCategoryTypes.Find(Pin->PinType.PinSubCategory))
+    {
+        return *Type;
+    }
 
     // Default to wildcard for unknown types
     return EN2CPinType::Wildcard;
 }
 
-UEdGraphPin* FN2CNodeTranslator::TraceConnectionThroughKnots(UEdGraphPin* StartPin) const
+UEdGraphPin* FN2CNodeTranslator::TraceConnectionThroughKnots(UEdGraphPin* StartPin, FGraphTranslationContext& Context) const
 {
     if (!StartPin)
     {
         return nullptr;
     }
 
-    UEdGraphPin* CurrentPin = StartPin;
-    TSet<UEdGraphNode*> VisitedNodes;  // Prevent infinite loops
+    UEdGraphNode* OwningNode = StartPin->GetOwningNode();
+    if (!OwningNode)
+    {
+        return nullptr;
+    }
+
+    // Most links point straight at a non-knot node
+    if (!OwningNode->IsA<UK2Node_Knot>())
+    {
+        return StartPin;
+    }
+
+    if (UEdGraphPin** Resolved = Context.KnotResolution.Find(StartPin))
+    {
+        return *Resolved;
+    }
+
+    // Knots outside the graph pre-pass (e.g. a partial node selection) are resolved on demand
+    return ResolveKnotChain(StartPin, Context.KnotResolution);
+}
+
+UEdGraphPin* FN2CNodeTranslator::ResolveKnotChain(UEdGraphPin* EntryPin, TMap<UEdGraphPin*, UEdGraphPin*>& Resolution)
+{
+    // Every knot pin walked on the way shares the same result
+    TArray<UEdGraphPin*, TInlineAllocator<8>> ChainPins;
+    TSet<UEdGraphNode*, DefaultKeyFuncs<UEdGraphNode*>, TInlineSetAllocator<8>> VisitedNodes;  // Prevent infinite loops
+
+    UEdGraphPin* Result = nullptr;
+    UEdGraphPin* CurrentPin = EntryPin;
 
     while (CurrentPin)
     {
-        UEdGraphNode* OwningNode = CurrentPin->GetOwningNode();
-        if (!OwningNode)
+        if (UEdGraphPin** Resolved = Resolution.Find(CurrentPin))
         {
-            return nullptr;
+            Result = *Resolved;
+            break;
         }
 
-        // If we've hit this node before, we have a loop
-        if (VisitedNodes.Contains(OwningNode))
+        UEdGraphNode* OwningNode = CurrentPin->GetOwningNode();
+        if (!OwningNode)
         {
-            FN2CLogger::Get().LogWarning(TEXT("Detected loop in knot node chain"));
-            return nullptr;
+            break;
         }
-        VisitedNodes.Add(OwningNode);
 
         // If this isn't a knot node, we've found our target
         if (!OwningNode->IsA<UK2Node_Knot>())
         {
-            return CurrentPin;
+            Result = CurrentPin;
+            break;
+        }
+
+        // If we've hit this node before, we have a loop
+        bool bAlreadyVisited = false;
+        VisitedNodes.Add(OwningNode, &bAlreadyVisited);
+        if (bAlreadyVisited)
+        {
+            FN2CLogger::Get().LogWarning(TEXT("Detected loop in knot node chain"));
+            break;
         }
 
+        ChainPins.Add(CurrentPin);
+
         // For knot nodes, follow to the next connection
         // Knots should only have one connection on the opposite side
-        TArray<UEdGraphPin*>& LinkedPins = (CurrentPin->Direction == EGPD_Input) ? 
+        const TArray<UEdGraphPin*>& LinkedPins = (CurrentPin->Direction == EGPD_Input) ? 
             OwningNode->Pins[1]->LinkedTo : OwningNode->Pins[0]->LinkedTo;
 
         if (LinkedPins.Num() == 0)
         {
-            return nullptr;  // Dead end
+            break;  // Dead end
         }
 
         CurrentPin = LinkedPins[0];
     }
 
-    return nullptr;
+    for (UEdGraphPin* ChainPin : ChainPins)
+    {
+        Resolution.Add(ChainPin, Result);
+    }
+
+    return Result;
+}
+
+void FN2CNodeTranslator::BuildKnotResolution(UEdGraph* Graph, FGraphTranslationContext& Context)
+{
+    int32 KnotCount = 0;
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (!Node || !Node->IsA<UK2Node_Knot>() || Node->Pins.Num() < 2)
+        {
+            continue;
+        }
+
+        // A chain can be entered from either end, so resolve both directions
+        for (int32 PinIndex = 0; PinIndex < 2; ++PinIndex)
+        {
+            UEdGraphPin* EntryPin = Node->Pins[PinIndex];
+            if (EntryPin && !Context.KnotResolution.Contains(EntryPin))
+            {
+                ResolveKnotChain(EntryPin, Context.KnotResolution);
+            }
+        }
+        KnotCount++;
+    }
+
+    if (KnotCount > 0)
+    {
+        N2C_LOG(Debug, TEXT("Resolved %d knot pins from %d knot nodes in graph %s"),
+            Context.KnotResolution.Num(), KnotCount, *Graph->GetName());
+    }
 }
 
 bool FN2CNodeTranslator::ValidateFlowReferences(FN2CGraph& Graph)
@@ -990,14 +2066,14 @@ bool FN2CNodeTranslator::ValidateFlowReferences(FN2CGraph& Graph)
     return Validator.ValidateFlowReferences(Graph, ErrorMessage);
 }
 
-void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDefinition& OutNodeDef)
+void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
 {
     // Determine node type
     DetermineNodeType(Node, OutNodeDef.NodeType);
 
     // Get the appropriate processor for this node type
-    TSharedPtr<IN2CNodeProcessor> Processor = FN2CNodeProcessorFactory::Get().GetProcessor(OutNodeDef.NodeType);
-    if (Processor.IsValid())
+    IN2CNodeProcessor* Processor = FN2CNodeProcessorFactory::Get().FindProcessor(OutNodeDef.NodeType);
+    if (Processor)
     {
         // Process the node using the processor
         if (!Processor->Process(Node, OutNodeDef))
@@ -1015,8 +2091,8 @@ void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDef
         {
             // Log successful processing
             FString NodeTypeName = StaticEnum<EN2CNodeType>()->GetNameStringByValue(static_cast<int64>(OutNodeDef.NodeType));
-            FN2CLogger::Get().Log(FString::Printf(TEXT("Successfully processed node '%s' using %s processor"),
-                *OutNodeDef.Name, *NodeTypeName), EN2CLogSeverity::Debug);
+            N2C_LOG(Debug, TEXT("Successfully processed node '%s' using %s processor"),
+                *OutNodeDef.Name, *NodeTypeName);
         }
     }
     else
@@ -1031,22 +2107,27 @@ void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDef
         FallbackProcessNodeProperties(Node, OutNodeDef);
     }
 
+    ProcessNodeReferences(Node, OutNodeDef, Context);
+}
+
+void FN2CNodeTranslator::ProcessNodeReferences(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
+{
     // Process any struct or enum types used in this node
-    ProcessRelatedTypes(Node, OutNodeDef);
+    ProcessRelatedTypes(Node, OutNodeDef, Context);
 
     // Check for nested graphs that might need processing
     if (UK2Node_Composite* CompositeNode = Cast<UK2Node_Composite>(Node))
     {
         if (UEdGraph* BoundGraph = CompositeNode->BoundGraph)
         {
-            AddGraphToProcess(BoundGraph);
+            AddGraphToProcess(BoundGraph, Context);
         }
     }
     else if (UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
     {
         if (UEdGraph* MacroGraph = MacroNode->GetMacroGraph())
         {
-            AddGraphToProcess(MacroGraph);
+            AddGraphToProcess(MacroGraph, Context);
         }
     }
     else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
@@ -1058,13 +2139,9 @@ void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDef
                 if (UBlueprint* FunctionBlueprint = Cast<UBlueprint>(BlueprintClass->ClassGeneratedBy))
                 {
                     // Find and add the function graph
-                    for (UEdGraph* FuncGraph : FunctionBlueprint->FunctionGraphs)
+                    if (UEdGraph* FuncGraph = FindFunctionGraph(FunctionBlueprint, Function->GetFName()))
                     {
-                        if (FuncGraph && FuncGraph->GetFName() == Function->GetFName())
-                        {
-                            AddGraphToProcess(FuncGraph);
-                            break;
-                        }
+                        AddGraphToProcess(FuncGraph, Context);
                     }
                 }
             }
@@ -1077,16 +2154,10 @@ void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDef
         {
             if (UBlueprint* BP = Cast<UBlueprint>(ScopeClass->ClassGeneratedBy))
             {
-                for (UEdGraph* FuncGraph : BP->FunctionGraphs)
+                if (UEdGraph* FuncGraph = FindFunctionGraph(BP, CreateDelegateNode->GetFunctionName()))
                 {
-                    if (FuncGraph && FuncGraph->GetFName() == CreateDelegateNode->GetFunctionName())
-                    {
-                        AddGraphToProcess(FuncGraph);
-                        FN2CLogger::Get().Log(
-                            FString::Printf(TEXT("Added delegate function graph to process: %s"), *FuncGraph->GetName()),
-                            EN2CLogSeverity::Debug);
-                        break;
-                    }
+                    AddGraphToProcess(FuncGraph, Context);
+                    N2C_LOG(Debug, TEXT("Added delegate function graph to process: %s"), *FuncGraph->GetName());
                 }
             }
         }
@@ -1097,16 +2168,10 @@ void FN2CNodeTranslator::ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDef
                 if (UBlueprint* FunctionBlueprint = Cast<UBlueprint>(BlueprintClass->ClassGeneratedBy))
                 {
                     // Find and add the function graph
-                    for (UEdGraph* FuncGraph : FunctionBlueprint->FunctionGraphs)
+                    if (UEdGraph* FuncGraph = FindFunctionGraph(FunctionBlueprint, DelegateSignature->GetFName()))
                     {
-                        if (FuncGraph && FuncGraph->GetFName() == DelegateSignature->GetFName())
-                        {
-                            AddGraphToProcess(FuncGraph);
-                            FN2CLogger::Get().Log(
-                                FString::Printf(TEXT("Added delegate signature graph to process: %s"), *FuncGraph->GetName()),
-                                EN2CLogSeverity::Debug);
-                            break;
-                        }
+                        AddGraphToProcess(FuncGraph, Context);
+                        N2C_LOG(Debug, TEXT("Added delegate signature graph to process: %s"), *FuncGraph->GetName());
                     }
                 }
             }
@@ -1130,25 +2195,22 @@ void FN2CNodeTranslator::FallbackProcessNodeProperties(UK2Node* Node, FN2CNodeDe
     OutNodeDef.bPure = Node->IsNodePure();
 }
 
-void FN2CNodeTranslator::ProcessNodePins(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, TArray<UEdGraphPin*>& OutExecInputs, TArray<UEdGraphPin*>& OutExecOutputs)
+void FN2CNodeTranslator::ProcessNodePins(const FN2CCollectedNode& Collected, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
 {
-    // Process input pins
-    for (UEdGraphPin* Pin : Node->Pins)
-    {
-        if (!Pin) continue;
+    UK2Node* Node = Collected.Node;
 
-        // Skip hidden pins entirely
-        if (Pin->bHidden)
-        {
-            continue;
-        }
+    const int32 NumInputs = Algo::CountIf(Collected.Pins, [](const UEdGraphPin* Pin) { return Pin->Direction == EGPD_Input; });
+    OutNodeDef.InputPins.Reserve(NumInputs);
+    OutNodeDef.OutputPins.Reserve(Collected.Pins.Num() - NumInputs);
 
+    // The collector has already dropped hidden and broken pins
+    for (UEdGraphPin* Pin : Collected.Pins)
+    {
         FN2CPinDefinition PinDef;
         
-        // Generate and map pin ID (using local counter for this node)
-        FString PinID = GeneratePinID(OutNodeDef.InputPins.Num() + OutNodeDef.OutputPins.Num());
-        PinIDMap.Add(Pin->PinId, PinID);
-        PinDef.ID = PinID;
+        // Generate pin ID (using local counter for this node)
+        const int32 PinNumber = OutNodeDef.InputPins.Num() + OutNodeDef.OutputPins.Num() + 1;
+        AppendPinID(PinDef.ID, PinNumber);
         
         // Set pin name
         PinDef.Name = Pin->GetDisplayName().ToString();
@@ -1163,6 +2225,8 @@ void FN2CNodeTranslator::ProcessNodePins(UK2Node* Node, FN2CNodeDefinition& OutN
         PinDef.bIsArray = Pin->PinType.ContainerType == EPinContainerType::Array;
         PinDef.bIsMap = Pin->PinType.ContainerType == EPinContainerType::Map;
         PinDef.bIsSet = Pin->PinType.ContainerType == EPinContainerType::Set;
+        PinDef.bAdvancedView = Pin->bAdvancedView;
+        PinDef.bDefaultValueUnchanged = Pin->Direction == EGPD_Input && Pin->DoesDefaultValueMatchAutogenerated();
 
         // Get default value if any
         if (!Pin->DefaultValue.IsEmpty())
@@ -1204,50 +2268,109 @@ void FN2CNodeTranslator::ProcessNodePins(UK2Node* Node, FN2CNodeDefinition& OutN
         // Add to appropriate pin array
         if (Pin->Direction == EGPD_Input)
         {
-            OutNodeDef.InputPins.Add(PinDef);
-            
-            if (Pin->PinType.PinCategory == TEXT("exec"))
-            {
-                OutExecInputs.Add(Pin);
-                FString PinContext = FString::Printf(TEXT("Found exec input pin: %s on node %s"),
-                    *Pin->GetDisplayName().ToString(),
-                    *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-                FN2CLogger::Get().Log(PinContext, EN2CLogSeverity::Debug);
-            }
+            OutNodeDef.InputPins.Add(MoveTemp(PinDef));
         }
-        else if (Pin->Direction == EGPD_Output)
+        else
         {
-            OutNodeDef.OutputPins.Add(PinDef);
-            
-            // Track execution outputs
-            if (Pin->PinType.PinCategory == TEXT("exec"))
-            {
-                OutExecOutputs.Add(Pin);
-                FString PinContext = FString::Printf(TEXT("Found exec output pin: %s on node %s"),
-                    *Pin->GetDisplayName().ToString(),
-                    *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
-                FN2CLogger::Get().Log(PinContext, EN2CLogSeverity::Debug);
-            }
+            OutNodeDef.OutputPins.Add(MoveTemp(PinDef));
+        }
+    }
+
+    MapNodePins(Collected, Context);
+}
+
+void FN2CNodeTranslator::MapNodePins(const FN2CCollectedNode& Collected, FGraphTranslationContext& Context)
+{
+    // Pins are numbered in order from 1, and output pins are indexed after all the inputs
+    int32 InputCount = 0;
+    for (int32 Index = 0; Index < Collected.Pins.Num(); ++Index)
+    {
+        const UEdGraphPin* Pin = Collected.Pins[Index];
+        Context.PinIDMap.Add(Pin->PinId, Index + 1);
+        if (Pin->Direction == EGPD_Input)
+        {
+            Context.PinIndexMap.Add(Pin->PinId, InputCount++);
+        }
+    }
+
+    int32 OutputIndex = InputCount;
+    for (const UEdGraphPin* Pin : Collected.Pins)
+    {
+        if (Pin->Direction != EGPD_Input)
+        {
+            Context.PinIndexMap.Add(Pin->PinId, OutputIndex++);
         }
     }
 }
 
-void FN2CNodeTranslator::ProcessNodeFlows(UK2Node* Node, const TArray<UEdGraphPin*>& ExecInputs, const TArray<UEdGraphPin*>& ExecOutputs)
+uint32 FN2CNodeTranslator::ComputeNodeSignature(const FN2CCollectedNode& Collected)
+{
+    const UK2Node* Node = Collected.Node;
+    uint32 Hash = HashCombineFast(GetTypeHash(Node->GetClass()), GetTypeHash(Node->NodeComment));
+    for (const UEdGraphPin* Pin : Collected.Pins)
+    {
+        const FEdGraphPinType& PinType = Pin->PinType;
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->PinId));
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->PinName));
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->PinFriendlyName.ToString()));
+        Hash = HashCombineFast(Hash, GetTypeHash(PinType.PinCategory));
+        Hash = HashCombineFast(Hash, GetTypeHash(PinType.PinSubCategory));
+        Hash = HashCombineFast(Hash, GetTypeHash(PinType.PinSubCategoryObject.Get()));
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->DefaultValue));
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->DefaultObject));
+        Hash = HashCombineFast(Hash, GetTypeHash(Pin->DefaultTextValue.ToString()));
+
+        const uint32 Flags = static_cast<uint32>(Pin->Direction)
+            | (static_cast<uint32>(PinType.ContainerType) << 2)
+            | (PinType.bIsReference ? 1u << 6 : 0u)
+            | (PinType.bIsConst ? 1u << 7 : 0u)
+            | (Pin->LinkedTo.Num() > 0 ? 1u << 8 : 0u)
+            | (Pin->bAdvancedView ? 1u << 9 : 0u);
+        Hash = HashCombineFast(Hash, Flags);
+    }
+    return Hash;
+}
+
+bool FN2CNodeTranslator::FindCachedNode(const FN2CCollectedNode& Collected, uint32 Signature, FN2CNodeDefinition& OutNodeDef)
+{
+    FReadScopeLock ReadLock(NodeCacheLock);
+
+    // Duplicated Blueprints share node GUIDs, so the entry must also be for this node
+    const FCachedNode* Cached = NodeCache.Find(Collected.Node->NodeGuid);
+    if (!Cached || Cached->Signature != Signature || Cached->Source.Get() != Collected.Node)
+    {
+        return false;
+    }
+
+    FString ID = MoveTemp(OutNodeDef.ID);
+    OutNodeDef = Cached->Definition;
+    OutNodeDef.ID = MoveTemp(ID);
+    return true;
+}
+
+void FN2CNodeTranslator::StoreCachedNode(const FN2CCollectedNode& Collected, uint32 Signature, const FN2CNodeDefinition& NodeDef)
+{
+    FWriteScopeLock WriteLock(NodeCacheLock);
+    FCachedNode& Cached = NodeCache.FindOrAdd(Collected.Node->NodeGuid);
+    Cached.Source = Collected.Node;
+    Cached.Signature = Signature;
+    Cached.Definition = NodeDef;
+}
+
+void FN2CNodeTranslator::ProcessNodeFlows(const FN2CCollectedNode& Collected, FGraphTranslationContext& Context)
 {
+    UK2Node* Node = Collected.Node;
+
     // Record execution flows
-    FString ExecDebug = FString::Printf(TEXT("Node %s has %d exec outputs"), 
+    N2C_LOG(Debug, TEXT("Node %s has %d exec outputs"), 
         *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-        ExecOutputs.Num());
-    FN2CLogger::Get().Log(ExecDebug, EN2CLogSeverity::Debug);
+        Collected.ExecOutputs.Num());
 
-    for (UEdGraphPin* ExecOutput : ExecOutputs)
+    for (UEdGraphPin* ExecOutput : Collected.ExecOutputs)
     {
-        if (!ExecOutput) continue;
-
-        FString PinDebug = FString::Printf(TEXT("Exec output pin %s has %d connections"), 
+        N2C_LOG(Debug, TEXT("Exec output pin %s has %d connections"), 
             *ExecOutput->GetDisplayName().ToString(),
             ExecOutput->LinkedTo.Num());
-        FN2CLogger::Get().Log(PinDebug, EN2CLogSeverity::Debug);
 
         for (UEdGraphPin* LinkedPin : ExecOutput->LinkedTo)
         {
@@ -1258,7 +2381,7 @@ void FN2CNodeTranslator::ProcessNodeFlows(UK2Node* Node, const TArray<UEdGraphPi
             }
 
             // Trace through any knot nodes to find the actual target
-            UEdGraphPin* ActualTargetPin = TraceConnectionThroughKnots(LinkedPin);
+            UEdGraphPin* ActualTargetPin = TraceConnectionThroughKnots(LinkedPin, Context);
             if (!ActualTargetPin)
             {
                 FN2CLogger::Get().Log(TEXT("Could not find valid target through knot chain"), EN2CLogSeverity::Warning);
@@ -1272,91 +2395,83 @@ void FN2CNodeTranslator::ProcessNodeFlows(UK2Node* Node, const TArray<UEdGraphPi
                 continue;
             }
 
-            // Get or generate IDs for the nodes
-            FString SourceNodeID = NodeIDMap.FindRef(Node->NodeGuid);
-            FString TargetNodeID = NodeIDMap.FindRef(TargetNode->NodeGuid);
-            
-            if (SourceNodeID.IsEmpty())
-            {
-                SourceNodeID = GenerateNodeID();
-                NodeIDMap.Add(Node->NodeGuid, SourceNodeID);
-                FN2CLogger::Get().Log(TEXT("Generated new source node ID"), EN2CLogSeverity::Debug);
-            }
-            
-            if (TargetNodeID.IsEmpty())
-            {
-                TargetNodeID = GenerateNodeID();
-                NodeIDMap.Add(TargetNode->NodeGuid, TargetNodeID);
-                FN2CLogger::Get().Log(TEXT("Generated new target node ID"), EN2CLogSeverity::Debug);
-            }
+            // Get or generate numbers for the nodes
+            const int32 SourceNodeNumber = FindOrAddNodeNumber(Node->NodeGuid, Context);
+            const int32 TargetNodeNumber = FindOrAddNodeNumber(TargetNode->NodeGuid, Context);
 
-            // Add execution flow
-            FString FlowStr = FString::Printf(TEXT("%s->%s"), *SourceNodeID, *TargetNodeID);
-            CurrentGraph->Flows.Execution.AddUnique(FlowStr);
+            // The target may come later in the graph, so the link is resolved to node indices afterwards
+            Context.PendingExecLinks.Emplace(Node->NodeGuid, TargetNode->NodeGuid);
             
             // Log execution flow
-            FString FlowContext = FString::Printf(TEXT("Added execution flow: %s (%s) -> %s (%s)"),
-                *SourceNodeID, *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(),
-                *TargetNodeID, *TargetNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
-            FN2CLogger::Get().Log(FlowContext, EN2CLogSeverity::Debug);
+            N2C_LOG(Debug, TEXT("Added execution flow: N%d (%s) -> N%d (%s)"),
+                SourceNodeNumber, *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(),
+                TargetNodeNumber, *TargetNode->GetNodeTitle(ENodeTitleType::ListView).ToString());
         }
     }
 
     // Record data flows
-    for (UEdGraphPin* Pin : Node->Pins)
+    for (UEdGraphPin* Pin : Collected.Pins)
     {
-        if (Pin && Pin->PinType.PinCategory != TEXT("exec"))
+        if (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
         {
             for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
             {
                 // Trace through any knot nodes to find the actual source and target
                 UEdGraphPin* ActualSourcePin = Pin;
-                UEdGraphPin* ActualTargetPin = TraceConnectionThroughKnots(LinkedPin);
+                UEdGraphPin* ActualTargetPin = TraceConnectionThroughKnots(LinkedPin, Context);
                 
                 if (ActualSourcePin && ActualTargetPin && 
                     ActualSourcePin->GetOwningNode() && ActualTargetPin->GetOwningNode())
                 {
-                    // Get node and pin IDs
-                    FString SourceNodeID = NodeIDMap.FindRef(ActualSourcePin->GetOwningNode()->NodeGuid);
-                    FString SourcePinID = PinIDMap.FindRef(ActualSourcePin->PinId);
-                    FString TargetNodeID = NodeIDMap.FindRef(ActualTargetPin->GetOwningNode()->NodeGuid);
-                    FString TargetPinID = PinIDMap.FindRef(ActualTargetPin->PinId);
+                    // Both ends are processed once their pins are numbered: the other node earlier, or this one
+                    const int32 SourceNodeNumber = Context.NodeIDMap.FindRef(ActualSourcePin->GetOwningNode()->NodeGuid);
+                    const int32 SourcePinNumber = Context.PinIDMap.FindRef(ActualSourcePin->PinId);
+                    const int32 TargetNodeNumber = Context.NodeIDMap.FindRef(ActualTargetPin->GetOwningNode()->NodeGuid);
+                    const int32 TargetPinNumber = Context.PinIDMap.FindRef(ActualTargetPin->PinId);
+                    const int32* SourceNodeIndex = Context.NodeIndexMap.Find(ActualSourcePin->GetOwningNode()->NodeGuid);
+                    const int32* SourcePinIndex = Context.PinIndexMap.Find(ActualSourcePin->PinId);
+                    const int32* TargetNodeIndex = Context.NodeIndexMap.Find(ActualTargetPin->GetOwningNode()->NodeGuid);
+                    const int32* TargetPinIndex = Context.PinIndexMap.Find(ActualTargetPin->PinId);
                     
-                    if (!SourceNodeID.IsEmpty() && !SourcePinID.IsEmpty() && 
-                        !TargetNodeID.IsEmpty() && !TargetPinID.IsEmpty())
+                    if (SourceNodeIndex && SourcePinIndex && TargetNodeIndex && TargetPinIndex)
                     {
-                        // Add data flow (always store as output->input direction)
-                        FString SourceRef = FString::Printf(TEXT("%s.%s"), *SourceNodeID, *SourcePinID);
-                        FString TargetRef = FString::Printf(TEXT("%s.%s"), *TargetNodeID, *TargetPinID);
-                
                         // Always store flow from output pin to input pin
-                        if (ActualSourcePin->Direction == EGPD_Output)
+                        const bool bSourceIsOutput = ActualSourcePin->Direction == EGPD_Output;
+                        const FN2CDataFlow Flow = bSourceIsOutput
+                            ? FN2CDataFlow(*SourceNodeIndex, *SourcePinIndex, *TargetNodeIndex, *TargetPinIndex)
+                            : FN2CDataFlow(*TargetNodeIndex, *TargetPinIndex, *SourceNodeIndex, *SourcePinIndex);
+
+                        // One flow per output pin; a later link from the same pin replaces the earlier one
+                        const TPair<int32, int32> SourceKey(Flow.SourceNode, Flow.SourcePin);
+                        if (const int32* Existing = Context.DataFlowBySource.Find(SourceKey))
                         {
-                            CurrentGraph->Flows.Data.Add(SourceRef, TargetRef);
-                    
-                            // Log data flow
-                            FString FlowContext = FString::Printf(TEXT("Added data flow: %s.%s (%s.%s) -> %s.%s (%s.%s)"),
-                                *SourceNodeID, *SourcePinID, 
+                            Context.Graph.Flows.Data[*Existing] = Flow;
+                        }
+                        else
+                        {
+                            Context.DataFlowBySource.Add(SourceKey, Context.Graph.Flows.Data.Add(Flow));
+                        }
+
+                        // Log data flow
+                        if (bSourceIsOutput)
+                        {
+                            N2C_LOG(Debug, TEXT("Added data flow: N%d.P%d (%s.%s) -> N%d.P%d (%s.%s)"),
+                                SourceNodeNumber, SourcePinNumber, 
                                 *ActualSourcePin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(), 
                                 *ActualSourcePin->GetDisplayName().ToString(),
-                                *TargetNodeID, *TargetPinID,
+                                TargetNodeNumber, TargetPinNumber,
                                 *ActualTargetPin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(),
                                 *ActualTargetPin->GetDisplayName().ToString());
-                            FN2CLogger::Get().Log(FlowContext, EN2CLogSeverity::Debug);
                         }
                         else
                         {
-                            CurrentGraph->Flows.Data.Add(TargetRef, SourceRef);
-                    
-                            // Log data flow
-                            FString FlowContext = FString::Printf(TEXT("Added data flow: %s.%s (%s.%s) -> %s.%s (%s.%s)"),
-                                *TargetNodeID, *TargetPinID,
+                            N2C_LOG(Debug, TEXT("Added data flow: N%d.P%d (%s.%s) -> N%d.P%d (%s.%s)"),
+                                TargetNodeNumber, TargetPinNumber,
                                 *ActualTargetPin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(),
                                 *ActualTargetPin->GetDisplayName().ToString(),
-                                *SourceNodeID, *SourcePinID,
+                                SourceNodeNumber, SourcePinNumber,
                                 *ActualSourcePin->GetOwningNode()->GetNodeTitle(ENodeTitleType::ListView).ToString(),
                                 *ActualSourcePin->GetDisplayName().ToString());
-                            FN2CLogger::Get().Log(FlowContext, EN2CLogSeverity::Debug);
                         }
                     }
                 }
@@ -1365,7 +2480,34 @@ void FN2CNodeTranslator::ProcessNodeFlows(UK2Node* Node, const TArray<UEdGraphPi
     }
 }
 
-FN2CEnum FN2CNodeTranslator::ProcessBlueprintEnum(UEnum* Enum)
+void FN2CNodeTranslator::ResolveExecutionFlows(FGraphTranslationContext& Context)
+{
+    // Links to nodes that were never processed (skipped or filtered out) have nothing to point at
+    FMemMark Mark(FMemStack::Get());
+    TSet<TPair<int32, int32>, DefaultKeyFuncs<TPair<int32, int32>>, FMemStackSetAllocator> AddedLinks;
+    AddedLinks.Reserve(Context.PendingExecLinks.Num());
+    for (const TPair<FGuid, FGuid>& Link : Context.PendingExecLinks)
+    {
+        const int32* Source = Context.NodeIndexMap.Find(Link.Key);
+        const int32* Target = Context.NodeIndexMap.Find(Link.Value);
+        if (!Source || !Target || !Context.Graph.Nodes.IsValidIndex(*Source) || !Context.Graph.Nodes.IsValidIndex(*Target))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Dropping execution flow to a node that is not part of graph %s"), *Context.Graph.Name));
+            continue;
+        }
+
+        bool bAlreadyAdded = false;
+        AddedLinks.Add(TPair<int32, int32>(*Source, *Target), &bAlreadyAdded);
+        if (!bAlreadyAdded)
+        {
+            const int32 Chain[] = { *Source, *Target };
+            Context.Graph.Flows.AddExecutionChain(Chain);
+        }
+    }
+    Context.PendingExecLinks.Reset();
+}
+
+FN2CEnum FN2CNodeTranslator::ProcessBlueprintEnum(UEnum* Enum, FGraphTranslationContext& Context)
 {
     FN2CEnum Result;
     
@@ -1385,25 +2527,60 @@ FN2CEnum FN2CNodeTranslator::ProcessBlueprintEnum(UEnum* Enum)
         EN2CLogSeverity::Info);
     
     // Check if we've already processed this enum
-    if (ProcessedEnumPaths.Contains(EnumPath))
+    if (Context.ProcessedEnumPaths.Contains(EnumPath))
+    {
+        N2C_LOG(Debug, TEXT("Enum %s already processed - skipping"), *EnumPath);
+        return Result;
+    }
+    
+    // Mark as processed
+    Context.ProcessedEnumPaths.Add(EnumPath);
+    FN2CLogger::Get().Log(TEXT("Added enum to processed paths"), EN2CLogSeverity::Debug);
+
+    // Reuse the definition reflected by an earlier translation, unless the enum's entries have changed since
+    const uint32 Signature = ComputeEnumSignature(Enum);
+    {
+        FReadScopeLock ReadLock(TypeCacheLock);
+        const FCachedEnum* Cached = EnumCache.Find(EnumPath);
+        if (Cached && Cached->Source.Get() == Enum && Cached->Signature == Signature)
+        {
+            N2C_LOG(Debug, TEXT("Enum %s served from type cache"), *EnumPath);
+            return Cached->Definition;
+        }
+    }
+
+    Result = ReflectBlueprintEnum(Enum);
+
+    FWriteScopeLock WriteLock(TypeCacheLock);
+    FCachedEnum& Cached = EnumCache.FindOrAdd(EnumPath);
+    Cached.Source = Enum;
+    Cached.Signature = Signature;
+    Cached.Definition = Result;
+
+    return Result;
+}
+
+uint32 FN2CNodeTranslator::ComputeEnumSignature(const UEnum* Enum)
+{
+    const int32 NumEnums = Enum->NumEnums();
+    uint32 Signature = GetTypeHash(NumEnums);
+    for (int32 Index = 0; Index < NumEnums; ++Index)
     {
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Enum %s already processed - skipping"), *EnumPath),
-            EN2CLogSeverity::Debug);
-        return Result;
+        Signature = HashCombineFast(Signature, GetTypeHash(Enum->GetNameByIndex(Index)));
+        Signature = HashCombineFast(Signature, GetTypeHash(Enum->GetValueByIndex(Index)));
     }
-    
-    // Mark as processed
-    ProcessedEnumPaths.Add(EnumPath);
-    FN2CLogger::Get().Log(TEXT("Added enum to processed paths"), EN2CLogSeverity::Debug);
-    
+    return Signature;
+}
+
+FN2CEnum FN2CNodeTranslator::ReflectBlueprintEnum(UEnum* Enum) const
+{
+    FN2CEnum Result;
+
     // Set basic enum info
-    Result.Name = EnumName;
+    Result.Name = Enum->GetName();
     
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Enum details: Name=%s"), 
-            *Result.Name),
-        EN2CLogSeverity::Debug);
+    N2C_LOG(Debug, TEXT("Enum details: Name=%s"), 
+        *Result.Name);
     
     // Get enum comment if available
     FString EnumComment = Enum->GetMetaData(TEXT("ToolTip"));
@@ -1411,60 +2588,28 @@ FN2CEnum FN2CNodeTranslator::ProcessBlueprintEnum(UEnum* Enum)
     if (!EnumComment.IsEmpty())
     {
         Result.Comment = EnumComment;
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Enum comment: %s"), *Result.Comment),
-            EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("Enum comment: %s"), *Result.Comment);
     }
     
     // Process enum values
     int32 NumEnums = Enum->NumEnums();
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Enum has %d values according to NumEnums()"), NumEnums),
-        EN2CLogSeverity::Debug);
+    N2C_LOG(Debug, TEXT("Enum has %d values according to NumEnums()"), NumEnums);
     
-    // Log all enum names and values for debugging
-    for (int32 i = 0; i < NumEnums; ++i)
+    // The generated _MAX entry and entries marked hidden in the editor are left out
+    const int32 NumValues = Enum->ContainsExistingMax() ? NumEnums - 1 : NumEnums;
+    Result.Values.Reserve(NumValues);
+    for (int32 Index = 0; Index < NumValues; ++Index)
     {
-        FString ValueName = Enum->GetDisplayNameTextByIndex(i).ToString();
-        
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Enum value #%d: Name='%s'"), 
-                i, *ValueName),
-            EN2CLogSeverity::Debug);
-            
-        // Check if this is a hidden enum value (like _MAX or similar)
-        bool bIsHidden = ValueName.Contains(TEXT("_MAX")) || 
-                         ValueName.Contains(TEXT("MAX_")) ||
-                         ValueName.Contains(TEXT("E MAX")) ||
-                         ValueName.Contains(TEXT("MAX")) ||
-                         ValueName.StartsWith(TEXT("_")) ||
-                         ValueName.EndsWith(TEXT("_None"));
-                         
-        if (bIsHidden)
-        {
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("  -> Skipping hidden value '%s'"), *ValueName),
-                EN2CLogSeverity::Debug);
-            continue; // Skip adding this value
-        }
-        
-        FN2CEnumValue Value;
-        Value.Name = ValueName;
-        
-        // Get value comment if available
-        FString ValueComment;
-        if (Enum->HasMetaData(TEXT("ToolTip"), i))
+        if (Enum->HasMetaData(TEXT("Hidden"), Index) || Enum->HasMetaData(TEXT("Spacer"), Index))
         {
-            ValueComment = Enum->GetMetaData(TEXT("ToolTip"), i);
-            Value.Comment = ValueComment;
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("  -> Comment: %s"), *ValueComment),
-                EN2CLogSeverity::Debug);
+            continue;
         }
-        
-        Result.Values.Add(Value);
+
+        FN2CEnumValue& Value = Result.Values.AddDefaulted_GetRef();
+        Value.Name = Enum->GetDisplayNameTextByIndex(Index).ToString();
+        Value.Comment = Enum->GetMetaData(TEXT("ToolTip"), Index);
     }
-    
+
     FN2CLogger::Get().Log(
         FString::Printf(TEXT("Processed enum %s with %d values"), 
             *Result.Name, 
@@ -1493,30 +2638,16 @@ FString FN2CNodeTranslator::GetCleanClassName(const FString& InName)
      return CleanName;
 }
 
-bool FN2CNodeTranslator::IsBlueprintStruct(UScriptStruct* Struct) const
+bool FN2CNodeTranslator::IsBlueprintStruct(UScriptStruct* Struct)
 {
-    if (!Struct)
-    {
-        return false;
-    }
-    
     // Check if the struct is in a user content directory
-    FString StructPath = Struct->GetPathName();
-    return StructPath.Contains(TEXT("/Game/")) || 
-           StructPath.Contains(TEXT("/Content/"));
+    return IsUserContent(Struct);
 }
 
-bool FN2CNodeTranslator::IsBlueprintEnum(UEnum* Enum) const
+bool FN2CNodeTranslator::IsBlueprintEnum(UEnum* Enum)
 {
-    if (!Enum)
-    {
-        return false;
-    }
-    
     // Check if the enum is in a user content directory
-    FString EnumPath = Enum->GetPathName();
-    return EnumPath.Contains(TEXT("/Game/")) || 
-           EnumPath.Contains(TEXT("/Content/"));
+    return IsUserContent(Enum);
 }
 
 EN2CStructMemberType FN2CNodeTranslator::ConvertPropertyToStructMemberType(FProperty* Property) const
@@ -1528,8 +2659,8 @@ EN2CStructMemberType FN2CNodeTranslator::ConvertPropertyToStructMemberType(FProp
     }
     
     FString PropertyName = Property->GetName();
-    FN2CLogger::Get().Log(FString::Printf(TEXT("ConvertPropertyToStructMemberType: Property '%s'"), 
-        *PropertyName), EN2CLogSeverity::Debug);
+    N2C_LOG(Debug, TEXT("ConvertPropertyToStructMemberType: Property '%s'"), 
+        *PropertyName);
     
     if (CastField<FBoolProperty>(Property))
     {
@@ -1572,8 +2703,8 @@ EN2CStructMemberType FN2CNodeTranslator::ConvertPropertyToStructMemberType(FProp
         FString StructName = StructProp->Struct ? StructProp->Struct->GetName() : TEXT("Unknown");
         FString StructPath = StructProp->Struct ? StructProp->Struct->GetPathName() : TEXT("Unknown");
         
-        FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Identified as Struct type: %s (Path: %s)"), 
-            *StructName, *StructPath), EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("  -> Identified as Struct type: %s (Path: %s)"), 
+            *StructName, *StructPath);
             
         if (StructProp->Struct->GetFName() == NAME_Vector)
         {
@@ -1604,102 +2735,53 @@ EN2CStructMemberType FN2CNodeTranslator::ConvertPropertyToStructMemberType(FProp
         FString EnumName = EnumProp->GetEnum() ? EnumProp->GetEnum()->GetName() : TEXT("Unknown");
         FString EnumPath = EnumProp->GetEnum() ? EnumProp->GetEnum()->GetPathName() : TEXT("Unknown");
         
-        FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Identified as Enum type: %s (Path: %s)"), 
-            *EnumName, *EnumPath), EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("  -> Identified as Enum type: %s (Path: %s)"), 
+            *EnumName, *EnumPath);
         return EN2CStructMemberType::Enum;
     }
     if (FClassProperty* ClassProp = CastField<FClassProperty>(Property))
     {
         FString ClassName = ClassProp->MetaClass ? ClassProp->MetaClass->GetName() : TEXT("Unknown");
         
-        FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Identified as Class type: %s"), *ClassName), 
-            EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("  -> Identified as Class type: %s"), *ClassName);
         return EN2CStructMemberType::Class;
     }
     if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
     {
         FString ObjClassName = ObjProp->PropertyClass ? ObjProp->PropertyClass->GetName() : TEXT("Unknown");
         
-        FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Identified as Object type: %s"), *ObjClassName), 
-            EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("  -> Identified as Object type: %s"), *ObjClassName);
         return EN2CStructMemberType::Object;
     }
 
-    FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Unrecognized property type '%s', using Custom type"), 
-        *Property->GetClass()->GetName()), EN2CLogSeverity::Debug);
+    N2C_LOG(Debug, TEXT("  -> Unrecognized property type '%s', using Custom type"), 
+        *Property->GetClass()->GetName());
     return EN2CStructMemberType::Custom; // For any other types
 }
 
-void FN2CNodeTranslator::ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition& OutNodeDef)
+void FN2CNodeTranslator::ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context)
 {
     if (!Node)
     {
         return;
     }
     
-    // Check for struct nodes - use string comparison for class names
-    const FString NodeClassName = Node->GetClass()->GetName();
-    
-    // Check for struct operation nodes
-    if (NodeClassName.Contains(TEXT("K2Node_StructOperation")))
+    // Make, break and set-members nodes are all struct operations
+    if (UK2Node_StructOperation* StructNode = Cast<UK2Node_StructOperation>(Node))
     {
-        UK2Node_StructOperation* StructNode = (UK2Node_StructOperation*)Node;
         if (UScriptStruct* Struct = StructNode->StructType)
         {
             if (IsBlueprintStruct(Struct))
             {
-                FN2CStruct StructDef = ProcessBlueprintStruct(Struct);
-                if (StructDef.IsValid())
-                {
-                    N2CBlueprint.Structs.Add(StructDef);
-                    
-                    FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("Added Blueprint struct %s from struct operation node"), 
-                        *StructDef.Name),
-                        EN2CLogSeverity::Info);
-                }
-            }
-        }
-    }
-    
-    // Check make struct nodes
-    if (NodeClassName.Contains(TEXT("K2Node_MakeStruct")))
-    {
-        UK2Node_MakeStruct* MakeStructNode = (UK2Node_MakeStruct*)Node;
-        if (UScriptStruct* Struct = MakeStructNode->StructType)
-        {
-            if (IsBlueprintStruct(Struct))
-            {
-                FN2CStruct StructDef = ProcessBlueprintStruct(Struct);
-                if (StructDef.IsValid())
-                {
-                    N2CBlueprint.Structs.Add(StructDef);
-                    
-                    FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("Added Blueprint struct %s from make struct node"), 
-                        *StructDef.Name),
-                        EN2CLogSeverity::Info);
-                }
-            }
-        }
-    }
-    
-    // Check break struct nodes
-    if (NodeClassName.Contains(TEXT("K2Node_BreakStruct")))
-    {
-        UK2Node_BreakStruct* BreakStructNode = (UK2Node_BreakStruct*)Node;
-        if (UScriptStruct* Struct = BreakStructNode->StructType)
-        {
-            if (IsBlueprintStruct(Struct))
-            {
-                FN2CStruct StructDef = ProcessBlueprintStruct(Struct);
+                FN2CStruct StructDef = ProcessBlueprintStruct(Struct, Context);
                 if (StructDef.IsValid())
                 {
-                    N2CBlueprint.Structs.Add(StructDef);
+                    Context.Structs.Emplace(Struct->GetPathName(), StructDef);
                     
                     FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("Added Blueprint struct %s from break struct node"), 
-                        *StructDef.Name),
+                        FString::Printf(TEXT("Added Blueprint struct %s from %s node"), 
+                        *StructDef.Name,
+                        *Node->GetClass()->GetName()),
                         EN2CLogSeverity::Info);
                 }
             }
@@ -1718,10 +2800,10 @@ void FN2CNodeTranslator::ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition&
             UScriptStruct* Struct = (UScriptStruct*)Pin->PinType.PinSubCategoryObject.Get();
             if (Struct && IsBlueprintStruct(Struct))
             {
-                FN2CStruct StructDef = ProcessBlueprintStruct(Struct);
+                FN2CStruct StructDef = ProcessBlueprintStruct(Struct, Context);
                 if (StructDef.IsValid())
                 {
-                    N2CBlueprint.Structs.Add(StructDef);
+                    Context.Structs.Emplace(Struct->GetPathName(), StructDef);
                     
                     FN2CLogger::Get().Log(
                         FString::Printf(TEXT("Added Blueprint struct %s from pin type"), 
@@ -1738,10 +2820,10 @@ void FN2CNodeTranslator::ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition&
             UEnum* Enum = (UEnum*)Pin->PinType.PinSubCategoryObject.Get();
             if (Enum && IsBlueprintEnum(Enum))
             {
-                FN2CEnum EnumDef = ProcessBlueprintEnum(Enum);
+                FN2CEnum EnumDef = ProcessBlueprintEnum(Enum, Context);
                 if (EnumDef.IsValid())
                 {
-                    N2CBlueprint.Enums.Add(EnumDef);
+                    Context.Enums.Emplace(Enum->GetPathName(), EnumDef);
                     
                     FN2CLogger::Get().Log(
                         FString::Printf(TEXT("Added Blueprint enum %s from pin type"), 
@@ -1755,6 +2837,11 @@ void FN2CNodeTranslator::ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition&
 
 void FN2CNodeTranslator::LogNodeDetails(const FN2CNodeDefinition& NodeDef)
 {
+    if (!FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Debug))
+    {
+        return;
+    }
+
     // Log detailed node info
     FString NodeInfo = FString::Printf(TEXT("Node Details:\n")
         TEXT("  ID: %s\n")
@@ -1852,259 +2939,111 @@ FString FN2CNodeTranslator::CleanPropertyName(const FString& RawName) const
         if (MatchStart > 0)
         {
          CleanName = CleanName.Left(MatchStart);
-         FN2CLogger::Get().Log(FString::Printf(TEXT("Cleaned property name from '%s' to '%s'"),
-             *RawName, *CleanName), EN2CLogSeverity::Debug);
+         N2C_LOG(Debug, TEXT("Cleaned property name from '%s' to '%s'"),
+             *RawName, *CleanName);
         }
     }
 
  return CleanName;
 }
 
-FN2CStructMember FN2CNodeTranslator::ProcessStructMember(FProperty* Property)
+FN2CNodeTranslator::FStructMemberDescriptor FN2CNodeTranslator::DescribeStructMember(FProperty* Property) const
 {
-    FN2CStructMember Member;
-
-    if (!Property)
-    {
-        FN2CLogger::Get().LogWarning(TEXT("Null property provided to ProcessStructMember"));
-        return Member;
-    }
+    FStructMemberDescriptor Descriptor;
+    FN2CStructMember& Member = Descriptor.Member;
 
     // Set member name with cleaned version
     Member.Name = CleanPropertyName(Property->GetName());
-    
-    FString DebugInfo = FString::Printf(TEXT("ProcessStructMember: Processing property '%s'"), 
-        *Member.Name);
-    FN2CLogger::Get().Log(DebugInfo, EN2CLogSeverity::Debug);
+    Member.Comment = Property->GetMetaData(TEXT("ToolTip"));
+    Member.Type = ConvertPropertyToStructMemberType(Property);
 
-    // Get member comment if available
-    if (Property->HasMetaData(TEXT("ToolTip")))
+    // Struct and enum types named by the member, a container's element, key or value
+    const auto DescribeType = [&Descriptor](FProperty* TypeProperty, FString& OutTypeName)
     {
-        Member.Comment = Property->GetMetaData(TEXT("ToolTip"));
-        FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Found comment: %s"), *Member.Comment), EN2CLogSeverity::Debug);
-    }
-
-    // Determine member type
-    Member.Type = ConvertPropertyToStructMemberType(Property);
-    FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Determined type: %s"), 
-        *StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type))), 
-        EN2CLogSeverity::Debug);
+        if (FStructProperty* StructProp = CastField<FStructProperty>(TypeProperty))
+        {
+            OutTypeName = StructProp->Struct->GetName();
+            Descriptor.NestedStructs.Add(StructProp->Struct);
+        }
+        else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(TypeProperty))
+        {
+            OutTypeName = EnumProp->GetEnum()->GetName();
+            Descriptor.NestedEnums.Add(EnumProp->GetEnum());
+        }
+    };
 
     // Handle container types
     if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
     {
-        FN2CLogger::Get().Log(TEXT("  -> Processing as Array property"), EN2CLogSeverity::Debug);
         Member.bIsArray = true;
-        FProperty* InnerProp = ArrayProp->Inner;
-        if (InnerProp)
+        if (FProperty* InnerProp = ArrayProp->Inner)
         {
-            FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Array inner type: %s"), 
-                *InnerProp->GetClass()->GetName()), EN2CLogSeverity::Debug);
-                
             Member.Type = ConvertPropertyToStructMemberType(InnerProp);
-
-            // Handle inner struct or enum types
-            if (FStructProperty* InnerStructProp = CastField<FStructProperty>(InnerProp))
-            {
-                Member.TypeName = InnerStructProp->Struct->GetName();
-                FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Array of struct: %s"), 
-                    *Member.TypeName), EN2CLogSeverity::Debug);
-
-                // Process nested struct if it's Blueprint-defined
-                if (IsBlueprintStruct(InnerStructProp->Struct))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined nested struct"), EN2CLogSeverity::Debug);
-                    FN2CStruct NestedStruct = ProcessBlueprintStruct(InnerStructProp->Struct);
-                    if (NestedStruct.IsValid())
-                    {
-                        N2CBlueprint.Structs.Add(NestedStruct);
-                        FN2CLogger::Get().Log(TEXT("  -> Added nested struct to blueprint"), EN2CLogSeverity::Debug);
-                    }
-                    else
-                    {
-                        FN2CLogger::Get().LogWarning(TEXT("  -> Nested struct validation failed"));
-                    }
-                }
-            }
-            else if (FEnumProperty* InnerEnumProp = CastField<FEnumProperty>(InnerProp))
-            {
-                Member.TypeName = InnerEnumProp->GetEnum()->GetName();
-                FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Array of enum: %s"), 
-                    *Member.TypeName), EN2CLogSeverity::Debug);
-
-                // Process enum if it's Blueprint-defined
-                if (IsBlueprintEnum(InnerEnumProp->GetEnum()))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined nested enum"), EN2CLogSeverity::Debug);
-                    FN2CEnum NestedEnum = ProcessBlueprintEnum(InnerEnumProp->GetEnum());
-                    if (NestedEnum.IsValid())
-                    {
-                        N2CBlueprint.Enums.Add(NestedEnum);
-                        FN2CLogger::Get().Log(TEXT("  -> Added nested enum to blueprint"), EN2CLogSeverity::Debug);
-                    }
-                    else
-                    {
-                        FN2CLogger::Get().LogWarning(TEXT("  -> Nested enum validation failed"));
-                    }
-                }
-            }
+            DescribeType(InnerProp, Member.TypeName);
         }
         else
         {
             FN2CLogger::Get().LogWarning(TEXT("  -> Array property has null inner property"));
         }
     }
-    else if (FSetProperty* SetProp = CastField<FSetProperty>(Property))
+    else if (CastField<FSetProperty>(Property))
     {
-        FN2CLogger::Get().Log(TEXT("  -> Processing as Set property"), EN2CLogSeverity::Debug);
         Member.bIsSet = true;
-        // Similar logic for sets as for arrays
     }
     else if (FMapProperty* MapProp = CastField<FMapProperty>(Property))
     {
-        FN2CLogger::Get().Log(TEXT("  -> Processing as Map property"), EN2CLogSeverity::Debug);
         Member.bIsMap = true;
-        
-        // Process key type
-        FProperty* KeyProp = MapProp->KeyProp;
-        if (KeyProp)
+        if (FProperty* KeyProp = MapProp->KeyProp)
         {
             Member.KeyType = ConvertPropertyToStructMemberType(KeyProp);
-            FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Map key type: %s"), 
-                *StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.KeyType))), 
-                EN2CLogSeverity::Debug);
-                
-            // Handle key type name for complex types
-            if (FStructProperty* KeyStructProp = CastField<FStructProperty>(KeyProp))
-            {
-                Member.KeyTypeName = KeyStructProp->Struct->GetName();
-                
-                // Process nested struct if it's Blueprint-defined
-                if (IsBlueprintStruct(KeyStructProp->Struct))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined key struct"), EN2CLogSeverity::Debug);
-                    FN2CStruct NestedStruct = ProcessBlueprintStruct(KeyStructProp->Struct);
-                    if (NestedStruct.IsValid())
-                    {
-                        N2CBlueprint.Structs.Add(NestedStruct);
-                    }
-                }
-            }
-            else if (FEnumProperty* KeyEnumProp = CastField<FEnumProperty>(KeyProp))
-            {
-                Member.KeyTypeName = KeyEnumProp->GetEnum()->GetName();
-                
-                // Process enum if it's Blueprint-defined
-                if (IsBlueprintEnum(KeyEnumProp->GetEnum()))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined key enum"), EN2CLogSeverity::Debug);
-                    FN2CEnum NestedEnum = ProcessBlueprintEnum(KeyEnumProp->GetEnum());
-                    if (NestedEnum.IsValid())
-                    {
-                        N2CBlueprint.Enums.Add(NestedEnum);
-                    }
-                }
-            }
+            DescribeType(KeyProp, Member.KeyTypeName);
         }
-        
-        // Process value type (similar to array inner type)
-        FProperty* ValueProp = MapProp->ValueProp;
-        if (ValueProp)
+        if (FProperty* ValueProp = MapProp->ValueProp)
         {
             Member.Type = ConvertPropertyToStructMemberType(ValueProp);
-            FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Map value type: %s"), 
-                *StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type))), 
-                EN2CLogSeverity::Debug);
-                
-            // Handle value type name for complex types
-            if (FStructProperty* ValueStructProp = CastField<FStructProperty>(ValueProp))
-            {
-                Member.TypeName = ValueStructProp->Struct->GetName();
-                
-                // Process nested struct if it's Blueprint-defined
-                if (IsBlueprintStruct(ValueStructProp->Struct))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined value struct"), EN2CLogSeverity::Debug);
-                    FN2CStruct NestedStruct = ProcessBlueprintStruct(ValueStructProp->Struct);
-                    if (NestedStruct.IsValid())
-                    {
-                        N2CBlueprint.Structs.Add(NestedStruct);
-                    }
-                }
-            }
-            else if (FEnumProperty* ValueEnumProp = CastField<FEnumProperty>(ValueProp))
-            {
-                Member.TypeName = ValueEnumProp->GetEnum()->GetName();
-                
-                // Process enum if it's Blueprint-defined
-                if (IsBlueprintEnum(ValueEnumProp->GetEnum()))
-                {
-                    FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined value enum"), EN2CLogSeverity::Debug);
-                    FN2CEnum NestedEnum = ProcessBlueprintEnum(ValueEnumProp->GetEnum());
-                    if (NestedEnum.IsValid())
-                    {
-                        N2CBlueprint.Enums.Add(NestedEnum);
-                    }
-                }
-            }
+            DescribeType(ValueProp, Member.TypeName);
         }
     }
     else
     {
-        // Handle non-container types
-        if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
-        {
-            Member.TypeName = StructProp->Struct->GetName();
-            FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Struct type: %s (Path: %s)"), 
-                *Member.TypeName, *StructProp->Struct->GetPathName()), EN2CLogSeverity::Debug);
+        DescribeType(Property, Member.TypeName);
+    }
 
-            // Process nested struct if it's Blueprint-defined
-            if (IsBlueprintStruct(StructProp->Struct))
-            {
-                FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined struct"), EN2CLogSeverity::Debug);
-                FN2CStruct NestedStruct = ProcessBlueprintStruct(StructProp->Struct);
-                if (NestedStruct.IsValid())
-                {
-                    N2CBlueprint.Structs.Add(NestedStruct);
-                    FN2CLogger::Get().Log(TEXT("  -> Added struct to blueprint"), EN2CLogSeverity::Debug);
-                }
-                else
-                {
-                    FN2CLogger::Get().LogWarning(TEXT("  -> Struct validation failed"));
-                }
-            }
-        }
-        else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+    N2C_LOG(Debug, TEXT("Described struct member '%s' of type '%s'"),
+        *Member.Name,
+        *StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type)));
+
+    return Descriptor;
+}
+
+TSharedRef<const FN2CNodeTranslator::FStructDescriptor> FN2CNodeTranslator::GetStructDescriptor(UScriptStruct* Struct, const FString& StructPath)
+{
+    {
+        FReadScopeLock ReadLock(TypeCacheLock);
+        const TSharedPtr<const FStructDescriptor>* Found = StructDescriptors.Find(StructPath);
+        if (Found && (*Found)->Source.Get() == Struct && (*Found)->FirstProperty == Struct->ChildProperties)
         {
-            Member.TypeName = EnumProp->GetEnum()->GetName();
-            FN2CLogger::Get().Log(FString::Printf(TEXT("  -> Enum type: %s (Path: %s)"), 
-                *Member.TypeName, *EnumProp->GetEnum()->GetPathName()), EN2CLogSeverity::Debug);
+            return Found->ToSharedRef();
+        }
+    }
 
-            // Process enum if it's Blueprint-defined
-            if (IsBlueprintEnum(EnumProp->GetEnum()))
-            {
-                FN2CLogger::Get().Log(TEXT("  -> Processing blueprint-defined enum"));
-                FN2CEnum NestedEnum = ProcessBlueprintEnum(EnumProp->GetEnum());
-                if (NestedEnum.IsValid())
-                {
-                    N2CBlueprint.Enums.Add(NestedEnum);
-                    FN2CLogger::Get().Log(TEXT("  -> Added enum to blueprint"), EN2CLogSeverity::Debug);
-                }
-                else
-                {
-                    FN2CLogger::Get().LogWarning(TEXT("  -> Enum validation failed"));
-                }
-            }
+    TSharedRef<FStructDescriptor> Descriptor = MakeShared<FStructDescriptor>();
+    Descriptor->Source = Struct;
+    Descriptor->FirstProperty = Struct->ChildProperties;
+    for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+    {
+        if (FProperty* Property = *PropIt)
+        {
+            Descriptor->Members.Add(DescribeStructMember(Property));
         }
     }
-    
-    FN2CLogger::Get().Log(FString::Printf(TEXT("ProcessStructMember: Completed processing of '%s'"), *Member.Name), 
-        EN2CLogSeverity::Debug);
-                                                                                                                                                                                                                                                                                                                      
-    return Member;
+
+    FWriteScopeLock WriteLock(TypeCacheLock);
+    StructDescriptors.Add(StructPath, Descriptor);
+    return Descriptor;
 }
 
-FN2CStruct FN2CNodeTranslator::ProcessBlueprintStruct(UScriptStruct* Struct)
+FN2CStruct FN2CNodeTranslator::ProcessBlueprintStruct(UScriptStruct* Struct, FGraphTranslationContext& Context)
 {
     FN2CStruct Result;
     
@@ -2124,105 +3063,191 @@ FN2CStruct FN2CNodeTranslator::ProcessBlueprintStruct(UScriptStruct* Struct)
         EN2CLogSeverity::Info);
     
     // Check if we've already processed this struct
-    if (ProcessedStructPaths.Contains(StructPath))
+    if (Context.ProcessedStructPaths.Contains(StructPath))
     {
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Struct %s already processed - skipping"), *StructPath),
-            EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("Struct %s already processed - skipping"), *StructPath);
         return Result;
     }
     
+    // Structs being reflected further up the stack are left out to break cycles
+    if (Context.StructStack.Contains(StructPath))
+    {
+        return Result;
+    }
+
     // Mark as processed
-    ProcessedStructPaths.Add(StructPath);
+    Context.ProcessedStructPaths.Add(StructPath);
     FN2CLogger::Get().Log(TEXT("Added struct to processed paths"), EN2CLogSeverity::Debug);
-    
-    // Set basic struct info
-    Result.Name = StructName;
-    
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Struct details: Name=%s"), 
-            *Result.Name),
-        EN2CLogSeverity::Debug);
-    
-    // Get struct comment if available
-    FString StructComment = Struct->GetMetaData(TEXT("ToolTip"));
-    
-    if (!StructComment.IsEmpty())
+
+    // Reuse the definition and nested types reflected by an earlier translation
     {
-        Result.Comment = StructComment;
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("Struct comment: %s"), *Result.Comment),
-            EN2CLogSeverity::Debug);
+        FReadScopeLock ReadLock(TypeCacheLock);
+        const FCachedStruct* Cached = StructCache.Find(StructPath);
+        if (Cached && Cached->Source.Get() == Struct && !Struct->GetPackage()->IsDirty())
+        {
+            N2C_LOG(Debug, TEXT("Struct %s served from type cache"), *StructPath);
+            MergeNestedTypes(Cached->NestedStructs, Cached->NestedEnums, Context);
+            return Cached->Definition;
+        }
     }
-    
-    // Log property iteration start
-    FN2CLogger::Get().Log(TEXT("Beginning property iteration for struct members..."), EN2CLogSeverity::Debug);
-    
-    // Process struct members
-    int32 PropertyCount = 0;
-    for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+
+    // Reflect into a scratch context so the nested types recorded for the cache are complete,
+    // even when this graph has already picked some of them up
+    FGraphTranslationContext Scratch;
+    Scratch.Depth = Context.Depth;
+    Scratch.StructStack = Context.StructStack;
+    Scratch.StructStack.Add(StructPath);
+    Scratch.ProcessedStructPaths.Add(StructPath);
+
+    Result = ReflectBlueprintStruct(Struct, Scratch);
+    MergeNestedTypes(Scratch.Structs, Scratch.Enums, Context);
+
+    // Structs in packages with unsaved edits are re-reflected every time
+    if (!Struct->GetPackage()->IsDirty())
     {
-        PropertyCount++;
-        if (FProperty* Property = *PropIt)
+        FWriteScopeLock WriteLock(TypeCacheLock);
+        FCachedStruct& Cached = StructCache.FindOrAdd(StructPath);
+        Cached.Source = Struct;
+        Cached.Definition = Result;
+        Cached.NestedStructs = MoveTemp(Scratch.Structs);
+        Cached.NestedEnums = MoveTemp(Scratch.Enums);
+    }
+
+    return Result;
+}
+
+void FN2CNodeTranslator::MergeNestedTypes(
+    const TArray<TPair<FString, FN2CStruct>>& NestedStructs,
+    const TArray<TPair<FString, FN2CEnum>>& NestedEnums,
+    FGraphTranslationContext& Context)
+{
+    for (const TPair<FString, FN2CStruct>& Nested : NestedStructs)
+    {
+        if (!Context.ProcessedStructPaths.Contains(Nested.Key))
         {
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Found property #%d: '%s' of class '%s'"), 
-                    PropertyCount,
-                    *Property->GetName(), 
-                    *Property->GetClass()->GetName()),
-                EN2CLogSeverity::Debug);
-                
-            FN2CStructMember Member = ProcessStructMember(Property);
-            Result.Members.Add(Member);
-            
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("Added member '%s' of type '%s' to struct"), 
-                    *Member.Name,
-                    *StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type))),
-                EN2CLogSeverity::Debug);
+            Context.ProcessedStructPaths.Add(Nested.Key);
+            Context.Structs.Add(Nested);
         }
-        else
+    }
+
+    for (const TPair<FString, FN2CEnum>& Nested : NestedEnums)
+    {
+        if (!Context.ProcessedEnumPaths.Contains(Nested.Key))
         {
-            FN2CLogger::Get().LogWarning(
-                FString::Printf(TEXT("Null property found at index %d"), PropertyCount));
+            Context.ProcessedEnumPaths.Add(Nested.Key);
+            Context.Enums.Add(Nested);
         }
     }
-    
-    if (PropertyCount == 0)
+}
+
+void FN2CNodeTranslator::InvalidateTypeCache()
+{
+    {
+        FWriteScopeLock WriteLock(TypeCacheLock);
+        StructCache.Empty();
+        EnumCache.Empty();
+        StructDescriptors.Empty();
+    }
+
+    // Node definitions hold the pin types of the structs and enums they use
+    FWriteScopeLock WriteLock(NodeCacheLock);
+    NodeCache.Empty();
+}
+
+void FN2CNodeTranslator::HandleObjectModified(UObject* Object)
+{
+    if (Sliced.IsValid())
+    {
+        HandleSlicedObjectModified(Object);
+    }
+
+    // Nested types are cached inside their parents, so any struct or enum edit drops everything
+    if (Object && (Object->IsA<UScriptStruct>() || Object->IsA<UEnum>()))
+    {
+        InvalidateTypeCache();
+    }
+    else if (const UK2Node* Node = Cast<UK2Node>(Object))
+    {
+        FWriteScopeLock WriteLock(NodeCacheLock);
+        NodeCache.Remove(Node->NodeGuid);
+    }
+    else if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+    {
+        // Renamed functions, variables and components change the nodes that refer to them without touching the nodes
+        FWriteScopeLock WriteLock(NodeCacheLock);
+        for (auto It = NodeCache.CreateIterator(); It; ++It)
+        {
+            const UK2Node* CachedNode = It.Value().Source.Get();
+            if (!CachedNode || CachedNode->GetBlueprint() == Blueprint)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+}
+
+void FN2CNodeTranslator::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+    HandleObjectModified(Object);
+}
+
+void FN2CNodeTranslator::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+    InvalidateTypeCache();
+
+    // Reloaded native classes can change layout
+    NativeComponentProperties.Empty();
+}
+
+FN2CStruct FN2CNodeTranslator::ReflectBlueprintStruct(UScriptStruct* Struct, FGraphTranslationContext& Context)
+{
+    FN2CStruct Result;
+    Result.Name = Struct->GetName();
+    Result.Comment = Struct->GetMetaData(TEXT("ToolTip"));
+
+    const TSharedRef<const FStructDescriptor> Descriptor = GetStructDescriptor(Struct, Struct->GetPathName());
+    if (Descriptor->Members.Num() == 0)
     {
         FN2CLogger::Get().LogWarning(
-            FString::Printf(TEXT("No properties found in struct '%s' - TFieldIterator returned no results"), *StructName));
-            
-        // Try alternative property access if available
-        UStruct* BaseStruct = Cast<UStruct>(Struct);
-        if (BaseStruct && BaseStruct->Children)
+            FString::Printf(TEXT("No properties found in struct '%s'"), *Result.Name));
+    }
+
+    Result.Members.Reserve(Descriptor->Members.Num());
+    for (const FStructMemberDescriptor& Member : Descriptor->Members)
+    {
+        Result.Members.Add(Member.Member);
+
+        // Blueprint-defined types the member refers to are reflected with the struct
+        for (const TWeakObjectPtr<UScriptStruct>& WeakNested : Member.NestedStructs)
         {
-            FN2CLogger::Get().Log(TEXT("Attempting alternative property access via Children field..."), EN2CLogSeverity::Debug);
-            
-            for (FField* Field = BaseStruct->ChildProperties; Field; Field = Field->Next)
+            UScriptStruct* Nested = WeakNested.Get();
+            if (Nested && IsBlueprintStruct(Nested))
             {
-                if (FProperty* Property = CastField<FProperty>(Field))
+                FN2CStruct NestedStruct = ProcessBlueprintStruct(Nested, Context);
+                if (NestedStruct.IsValid())
                 {
-                    FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("Found property via Children: '%s' of class '%s'"), 
-                            *Property->GetName(), 
-                            *Property->GetClass()->GetName()),
-                        EN2CLogSeverity::Debug);
-                        
-                    FN2CStructMember Member = ProcessStructMember(Property);
-                    Result.Members.Add(Member);
+                    Context.Structs.Emplace(Nested->GetPathName(), MoveTemp(NestedStruct));
+                }
+            }
+        }
+        for (const TWeakObjectPtr<UEnum>& WeakNested : Member.NestedEnums)
+        {
+            UEnum* Nested = WeakNested.Get();
+            if (Nested && IsBlueprintEnum(Nested))
+            {
+                FN2CEnum NestedEnum = ProcessBlueprintEnum(Nested, Context);
+                if (NestedEnum.IsValid())
+                {
+                    Context.Enums.Emplace(Nested->GetPathName(), MoveTemp(NestedEnum));
                 }
             }
         }
     }
-    
+
     FN2CLogger::Get().Log(
-        FString::Printf(TEXT("Processed struct %s with %d members (found %d properties during iteration)"), 
-            *Result.Name, 
-            Result.Members.Num(),
-            PropertyCount),
+        FString::Printf(TEXT("Processed struct %s with %d members"), *Result.Name, Result.Members.Num()),
         EN2CLogSeverity::Info);
-    
+
     return Result;
 }
 
@@ -0,0 +1,306 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CPipelineBenchmarkCommandlet.h"
+
+#include "Core/N2CNodeCollector.h"
+#include "Core/N2CNodeTranslator.h"
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSettings.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformMemory.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "LLM/N2CLLMModule.h"
+#include "LLM/N2CTranslationOutputWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    double Median(TArray<double> Values)
+    {
+        if (Values.Num() == 0)
+        {
+            return 0.0;
+        }
+        Values.Sort();
+        return Values[Values.Num() / 2];
+    }
+}
+
+UN2CPipelineBenchmarkCommandlet::UN2CPipelineBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UN2CPipelineBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    TArray<FString> AssetPaths;
+    if (const FString* AssetsParam = ParamVals.Find(TEXT("Assets")))
+    {
+        AssetsParam->ParseIntoArray(AssetPaths, TEXT("+"));
+    }
+    if (AssetPaths.Num() == 0)
+    {
+        FN2CLogger::Get().LogError(TEXT("No Blueprints given, pass -Assets=/Game/Path/BP.BP"), TEXT("Benchmark"));
+        return 1;
+    }
+
+    if (const FString* IterationsParam = ParamVals.Find(TEXT("Iterations")))
+    {
+        Iterations = FMath::Max(1, FCString::Atoi(**IterationsParam));
+    }
+    if (const FString* TimeoutParam = ParamVals.Find(TEXT("Timeout")))
+    {
+        TimeoutSeconds = FMath::Max(1.0, FCString::Atod(**TimeoutParam));
+    }
+    const bool bRecord = Switches.Contains(TEXT("Record"));
+
+    FString OutputPath;
+    if (const FString* OutputParam = ParamVals.Find(TEXT("Output")))
+    {
+        OutputPath = *OutputParam;
+    }
+    if (OutputPath.IsEmpty())
+    {
+        OutputPath = FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Benchmarks")
+            / FString::Printf(TEXT("Pipeline-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    }
+
+    // Every iteration must reach the HTTP layer, and only the requests being measured are sent.
+    // The settings are changed for this process only and never saved
+    UN2CSettings* Settings = GetMutableDefault<UN2CSettings>();
+    Settings->ReplayMode = bRecord ? EN2CHttpReplayMode::Record : EN2CHttpReplayMode::Replay;
+    Settings->bUseTranslationCache = false;
+    Settings->bDraftThenRefine = false;
+    Settings->bSpeculativeTranslation = false;
+
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (!LLMModule || !LLMModule->Initialize())
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to initialize LLM Module"), TEXT("Benchmark"));
+        return 1;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> BlueprintReports;
+    int32 Failures = 0;
+    for (const FString& AssetPath : AssetPaths)
+    {
+        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *AssetPath);
+        const TSharedPtr<FJsonObject> Report = Blueprint ? RunBlueprint(Blueprint) : nullptr;
+        if (!Report.IsValid())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to benchmark: %s"), *AssetPath), TEXT("Benchmark"));
+            Failures++;
+            continue;
+        }
+        Report->SetStringField(TEXT("asset"), AssetPath);
+        BlueprintReports.Add(MakeShared<FJsonValueObject>(Report));
+    }
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    RootObject->SetStringField(TEXT("mode"), bRecord ? TEXT("record") : TEXT("replay"));
+    RootObject->SetNumberField(TEXT("iterations"), Iterations);
+    RootObject->SetNumberField(TEXT("peak_used_physical_mb"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+    RootObject->SetNumberField(TEXT("peak_used_virtual_mb"), MemoryStats.PeakUsedVirtual / (1024.0 * 1024.0));
+    RootObject->SetArrayField(TEXT("blueprints"), BlueprintReports);
+
+    FString Out;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+    if (!FFileHelper::SaveStringToFile(Out, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to write benchmark report: %s"), *OutputPath), TEXT("Benchmark"));
+        return 1;
+    }
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Pipeline benchmark written to %s"), *OutputPath), EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return Failures > 0 ? 1 : 0;
+}
+
+TSharedPtr<FJsonObject> UN2CPipelineBenchmarkCommandlet::RunBlueprint(UBlueprint* Blueprint)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bIncludeVariables = Settings->bIncludeVariables;
+    const EN2CJsonDialect Dialect = Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+
+    TArray<UEdGraph*> Graphs;
+    Blueprint->GetAllGraphs(Graphs);
+
+    FN2CNodeCollector& Collector = FN2CNodeCollector::Get();
+    FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+
+    FStageSamples Collect, Translate, Validate, Serialize, Request, Save;
+    int32 NodeCount = 0;
+    int32 JsonLength = 0;
+    int32 FailedRequests = 0;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        const bool bCollected = TimeStage(Collect, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Collect"));
+            NodeCount = 0;
+            for (UEdGraph* Graph : Graphs)
+            {
+                TArray<FN2CCollectedNode> CollectedNodes;
+                Collector.CollectNodesFromGraph(Graph, CollectedNodes);
+                NodeCount += CollectedNodes.Num();
+            }
+            return true;
+        });
+
+        const bool bTranslated = TimeStage(Translate, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Translate"));
+            return Translator.GenerateFromBlueprint(Blueprint, bIncludeVariables);
+        });
+        if (!bCollected || !bTranslated)
+        {
+            return nullptr;
+        }
+
+        const FN2CBlueprint& N2CBlueprint = Translator.GetN2CBlueprint();
+        if (!TimeStage(Validate, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Validate"));
+            return N2CBlueprint.IsValid();
+        }))
+        {
+            return nullptr;
+        }
+
+        FString Json;
+        TimeStage(Serialize, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Serialize"));
+            Json = FN2CSerializer::ToCondensedJson(N2CBlueprint, Dialect);
+            return !Json.IsEmpty();
+        });
+        JsonLength = Json.Len();
+
+        // Payload build, the replayed HTTP round trip and parsing, up to the translation being handed over
+        if (!TimeStage(Request, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Request"));
+            return RunRequest(Json);
+        }))
+        {
+            FailedRequests++;
+        }
+
+        TimeStage(Save, [&]()
+        {
+            LLM_SCOPE_BYNAME(TEXT("NodeToCode/Benchmark/Save"));
+            return FN2CTranslationOutputWriter::Get().Flush();
+        });
+    }
+
+    // The module records how long each request spent building its payload and on the wire
+    const TArray<FN2CRequestMetrics> Metrics = UN2CLLMModule::Get()->GetRequestMetrics();
+    TArray<double> PayloadSeconds;
+    TArray<double> ProviderSeconds;
+    for (int32 Index = FMath::Max(0, Metrics.Num() - Iterations); Index < Metrics.Num(); ++Index)
+    {
+        PayloadSeconds.Add(Metrics[Index].SerializeSeconds);
+        ProviderSeconds.Add(Metrics[Index].TotalSeconds);
+    }
+
+    TSharedPtr<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+    StagesObject->SetObjectField(TEXT("collect"), SummarizeStage(Collect));
+    StagesObject->SetObjectField(TEXT("translate"), SummarizeStage(Translate));
+    StagesObject->SetObjectField(TEXT("validate"), SummarizeStage(Validate));
+    StagesObject->SetObjectField(TEXT("serialize"), SummarizeStage(Serialize));
+    StagesObject->SetObjectField(TEXT("request"), SummarizeStage(Request));
+    StagesObject->SetObjectField(TEXT("save"), SummarizeStage(Save));
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("name"), Blueprint->GetName());
+    Report->SetNumberField(TEXT("graphs"), Graphs.Num());
+    Report->SetNumberField(TEXT("nodes"), NodeCount);
+    Report->SetNumberField(TEXT("json_chars"), JsonLength);
+    Report->SetNumberField(TEXT("failed_requests"), FailedRequests);
+    Report->SetNumberField(TEXT("payload_build_median_ms"), Median(PayloadSeconds) * 1000.0);
+    Report->SetNumberField(TEXT("http_and_parse_median_ms"), Median(ProviderSeconds) * 1000.0);
+    Report->SetObjectField(TEXT("stages"), StagesObject);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%s: %d nodes, translate %.2f ms, serialize %.2f ms, request %.2f ms"),
+            *Blueprint->GetName(), NodeCount, Median(Translate.Seconds) * 1000.0, Median(Serialize.Seconds) * 1000.0,
+            Median(Request.Seconds) * 1000.0),
+        EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return Report;
+}
+
+bool UN2CPipelineBenchmarkCommandlet::RunRequest(const FString& Json) const
+{
+    TSharedRef<bool> bDone = MakeShared<bool>(false);
+    TSharedRef<bool> bSucceeded = MakeShared<bool>(false);
+    UN2CLLMModule::Get()->ProcessN2CJson(Json, FOnLLMTranslationComplete::CreateLambda(
+        [bDone, bSucceeded](const FN2CTranslationResponse& Response, bool bSuccess)
+        {
+            *bDone = true;
+            *bSucceeded = bSuccess;
+        }));
+
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    double LastTime = FPlatformTime::Seconds();
+    while (!*bDone && FPlatformTime::Seconds() < Deadline)
+    {
+        Tick(LastTime);
+    }
+
+    if (!*bDone)
+    {
+        FN2CLogger::Get().LogError(TEXT("Request timed out"), TEXT("Benchmark"));
+        UN2CLLMModule::Get()->CancelTranslations();
+    }
+    return *bSucceeded;
+}
+
+bool UN2CPipelineBenchmarkCommandlet::TimeStage(FStageSamples& Samples, TFunctionRef<bool()> Stage)
+{
+    const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+    const double Start = FPlatformTime::Seconds();
+    const bool bResult = Stage();
+    Samples.Seconds.Add(FPlatformTime::Seconds() - Start);
+
+    // Process-wide, so an upper bound on what the stage itself keeps alive
+    Samples.MemoryDeltaBytes.Add(static_cast<double>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<double>(UsedBefore));
+    return bResult;
+}
+
+TSharedPtr<FJsonObject> UN2CPipelineBenchmarkCommandlet::SummarizeStage(const FStageSamples& Samples)
+{
+    TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+    Object->SetNumberField(TEXT("median_ms"), Median(Samples.Seconds) * 1000.0);
+    Object->SetNumberField(TEXT("min_ms"), Samples.Seconds.Num() > 0 ? FMath::Min(Samples.Seconds) * 1000.0 : 0.0);
+    Object->SetNumberField(TEXT("max_ms"), Samples.Seconds.Num() > 0 ? FMath::Max(Samples.Seconds) * 1000.0 : 0.0);
+    Object->SetNumberField(TEXT("memory_delta_kb"), Median(Samples.MemoryDeltaBytes) / 1024.0);
+    return Object;
+}
+
+void UN2CPipelineBenchmarkCommandlet::Tick(double& LastTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    const float DeltaTime = static_cast<float>(Now - LastTime);
+    LastTime = Now;
+
+    FHttpModule::Get().GetHttpManager().Tick(DeltaTime);
+    FTSTicker::GetCoreTicker().Tick(DeltaTime);
+    FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    FPlatformProcess::Sleep(0.001f);
+}
@@ -1,1082 +1,2474 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "Core/N2CSerializer.h"
+#include "Utils/N2CJsonEscape.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "Algo/Count.h"
 
-// Initialize static members
-bool FN2CSerializer::bPrettyPrint = true;
-int32 FN2CSerializer::IndentLevel = 1;
+DECLARE_CYCLE_STAT(TEXT("Serialize Blueprint"), STAT_N2CToJson, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Serialize Graph"), STAT_N2CGraphToJson, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Deserialize Blueprint"), STAT_N2CFromJson, STATGROUP_NodeToCode);
 
-FString FN2CSerializer::ToJson(const FN2CBlueprint& Blueprint)
+/** Field names of one JSON dialect */
+struct FN2CSerializer::FKeys
 {
+    /** Compact dialect: dictionary-encoded node types and no empty arrays */
+    bool bCompact;
+
+    const TCHAR* Version;
+    const TCHAR* Metadata;
+    const TCHAR* Name;
+    const TCHAR* BlueprintType;
+    const TCHAR* BlueprintClass;
+    const TCHAR* Graphs;
+    const TCHAR* Structs;
+    const TCHAR* Enums;
+    const TCHAR* Variables;
+    const TCHAR* Components;
+    const TCHAR* ComponentName;
+    const TCHAR* ComponentClassName;
+    const TCHAR* AttachParentName;
+    const TCHAR* OverriddenProperties;
+    const TCHAR* GraphType;
+    const TCHAR* NodeTypes;
+    const TCHAR* Nodes;
+    const TCHAR* Flows;
+    const TCHAR* ID;
+    const TCHAR* Type;
+    const TCHAR* MemberParent;
+    const TCHAR* MemberName;
+    const TCHAR* Comment;
+    const TCHAR* Pure;
+    const TCHAR* Latent;
+    const TCHAR* InputPins;
+    const TCHAR* OutputPins;
+    const TCHAR* SubType;
+    const TCHAR* DefaultValue;
+    const TCHAR* Connected;
+    const TCHAR* IsReference;
+    const TCHAR* IsConst;
+    const TCHAR* IsArray;
+    const TCHAR* IsMap;
+    const TCHAR* IsSet;
+    const TCHAR* Execution;
+    const TCHAR* Data;
+    const TCHAR* Members;
+    const TCHAR* TypeName;
+    const TCHAR* KeyType;
+    const TCHAR* KeyTypeName;
+    const TCHAR* Values;
+};
+
+const FN2CSerializer::FKeys& FN2CSerializer::GetKeys(EN2CJsonDialect Dialect)
+{
+    static const FKeys StandardKeys = {
+        false,
+        TEXT("version"), TEXT("metadata"), TEXT("name"), TEXT("blueprint_type"), TEXT("blueprint_class"),
+        TEXT("graphs"), TEXT("structs"), TEXT("enums"), TEXT("variables"), TEXT("components"),
+        TEXT("component_name"), TEXT("component_class_name"), TEXT("attach_parent_name"), TEXT("overridden_properties"),
+        TEXT("graph_type"), nullptr, TEXT("nodes"), TEXT("flows"),
+        TEXT("id"), TEXT("type"), TEXT("member_parent"), TEXT("member_name"), TEXT("comment"), TEXT("pure"), TEXT("latent"),
+        TEXT("input_pins"), TEXT("output_pins"), TEXT("sub_type"), TEXT("default_value"),
+        TEXT("connected"), TEXT("is_reference"), TEXT("is_const"), TEXT("is_array"), TEXT("is_map"), TEXT("is_set"),
+        TEXT("execution"), TEXT("data"),
+        TEXT("members"), TEXT("type_name"), TEXT("key_type"), TEXT("key_type_name"), TEXT("values")
+    };
+
+    // Keep in sync with the legend in Content/Prompting/CompactDialect.md
+    static const FKeys CompactKeys = {
+        true,
+        TEXT("v"), TEXT("m"), TEXT("n"), TEXT("bt"), TEXT("bc"),
+        TEXT("g"), TEXT("s"), TEXT("e"), TEXT("vars"), TEXT("comp"),
+        TEXT("n"), TEXT("cls"), TEXT("parent"), TEXT("props"),
+        TEXT("gt"), TEXT("nt"), TEXT("nodes"), TEXT("f"),
+        TEXT("i"), TEXT("t"), TEXT("mp"), TEXT("mn"), TEXT("c"), TEXT("pure"), TEXT("latent"),
+        TEXT("in"), TEXT("out"), TEXT("st"), TEXT("d"),
+        TEXT("cn"), TEXT("ref"), TEXT("const"), TEXT("arr"), TEXT("map"), TEXT("set"),
+        TEXT("x"), TEXT("dt"),
+        TEXT("mb"), TEXT("tn"), TEXT("kt"), TEXT("ktn"), TEXT("vals")
+    };
+
+    return Dialect == EN2CJsonDialect::Compact ? CompactKeys : StandardKeys;
+}
+
+FString FN2CSerializer::ToJson(const FN2CBlueprint& Blueprint, const FN2CJsonOptions& Options)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CToJson);
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
+
     // Validate Blueprint before serialization
     if (!Blueprint.IsValid())
     {
         FN2CLogger::Get().LogWarning(TEXT("Blueprint validation failed - attempting partial serialization"));
     }
 
-    // Create JSON object
-    TSharedPtr<FJsonObject> JsonObject = BlueprintToJsonObject(Blueprint);
-    if (!JsonObject.IsValid())
-    {
-        FN2CLogger::Get().LogError(TEXT("Failed to create JSON object from Blueprint"), TEXT("Serialization"));
-        return TEXT("");
-    }
-
     FString OutputString;
+    OutputString.Reserve(EstimateJsonLength(Blueprint, Options.bPrettyPrint));
 
-    if (bPrettyPrint)
+    // Written in a single pass straight from the Blueprint, without building a JSON object tree first
+    bool bWritten = false;
+    const FKeys& Keys = GetKeys(Options.Dialect);
+    if (Options.bPrettyPrint)
     {
-        TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer =
-            TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutputString, IndentLevel);
-
-        if (!FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer))
-        {
-            FN2CLogger::Get().LogError(TEXT("Failed to serialize JSON object to string"));
-            return TEXT("");
-        }
+        TSharedRef<FPrettyWriter> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&OutputString, FMath::Max(0, Options.IndentLevel));
+        WriteBlueprint(*Writer, Keys, Blueprint, Options.Sections);
+        bWritten = Writer->Close();
     }
     else
     {
-        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
-            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+        TSharedRef<FCondensedWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+        WriteBlueprint(*Writer, Keys, Blueprint, Options.Sections);
+        bWritten = Writer->Close();
+    }
 
-        if (!FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer))
-        {
-            FN2CLogger::Get().LogError(TEXT("Failed to serialize JSON object to string"));
-            return TEXT("");
-        }
+    if (!bWritten)
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to serialize Blueprint to JSON"), TEXT("Serialization"));
+        return TEXT("");
     }
 
     return OutputString;
 }
 
-bool FN2CSerializer::FromJson(const FString& JsonString, FN2CBlueprint& OutBlueprint)
+FString FN2CSerializer::ToCondensedJson(const FN2CBlueprint& Blueprint, EN2CJsonDialect Dialect)
 {
-    // Parse JSON string
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-    {
-        FN2CLogger::Get().LogError(TEXT("Failed to parse JSON string"));
-        return false;
-    }
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
 
-    // Convert to Blueprint
-    return ParseBlueprintFromJson(JsonObject, OutBlueprint);
+    const FKeys& Keys = GetKeys(Dialect);
+    return WriteCondensed([&Keys, &Blueprint](FCondensedWriter& Writer)
+    {
+        WriteBlueprint(Writer, Keys, Blueprint, EN2CJsonSections::All);
+    }, EstimateJsonLength(Blueprint));
 }
 
-void FN2CSerializer::SetPrettyPrint(bool bEnabled)
+FString FN2CSerializer::GraphToJson(const FN2CGraph& Graph, EN2CJsonDialect Dialect)
 {
-    bPrettyPrint = bEnabled;
-}
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CGraphToJson);
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
 
-void FN2CSerializer::SetIndentLevel(int32 Level)
-{
-    IndentLevel = FMath::Max(0, Level);
+    const FKeys& Keys = GetKeys(Dialect);
+    return WriteCondensed([&Keys, &Graph](FCondensedWriter& Writer)
+    {
+        WriteGraph(Writer, Keys, Graph);
+    }, EstimateGraphJsonLength(Graph));
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::BlueprintToJsonObject(const FN2CBlueprint& Blueprint)
+FString FN2CSerializer::CompactGraphToJson(const FN2CCompactGraph& Graph, const FN2CStringArena& Strings, EN2CJsonDialect Dialect)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
 
-    // Add version
-    JsonObject->SetStringField(TEXT("version"), Blueprint.Version.Value);
+    // Field order and omission rules mirror WriteGraph, WriteNode, WritePin and WriteFlows
+    const FKeys& Keys = GetKeys(Dialect);
 
-    // Add metadata
-    TSharedPtr<FJsonObject> MetadataObject = MakeShared<FJsonObject>();
-    MetadataObject->SetStringField(TEXT("name"), Blueprint.Metadata.Name);
-    MetadataObject->SetStringField(TEXT("blueprint_type"), 
-        StaticEnum<EN2CBlueprintType>()->GetNameStringByValue(static_cast<int64>(Blueprint.Metadata.BlueprintType)));
-    MetadataObject->SetStringField(TEXT("blueprint_class"), Blueprint.Metadata.BlueprintClass);
-    JsonObject->SetObjectField(TEXT("metadata"), MetadataObject);
+    FString Out;
+    Out.Reserve(256 + Graph.NumNodes() * 128 + Graph.PinIDs.Num() * 48);
 
-    // Add graphs array
-    TArray<TSharedPtr<FJsonValue>> GraphsArray;
-    for (const FN2CGraph& Graph : Blueprint.Graphs)
+    auto AppendKey = [&Out](const TCHAR* Key)
+    {
+        Out.Append(TEXT(",\""));
+        Out.Append(Key);
+        Out.Append(TEXT("\":"));
+    };
+
+    auto AppendField = [&Out](const TCHAR* Key, FStringView Value)
+    {
+        Out.AppendChar(TEXT('"'));
+        Out.Append(Key);
+        Out.Append(TEXT("\":"));
+        AppendJsonString(Out, Value);
+    };
+
+    auto AppendFlag = [&Out](const TCHAR* Key)
+    {
+        Out.Append(TEXT(",\""));
+        Out.Append(Key);
+        Out.Append(TEXT("\":true"));
+    };
+
+    const UEnum* NodeTypeEnum = StaticEnum<EN2CNodeType>();
+    const UEnum* PinTypeEnum = StaticEnum<EN2CPinType>();
+
+    Out.AppendChar(TEXT('{'));
+    AppendField(Keys.Name, Strings.Get(Graph.Name));
+    Out.AppendChar(TEXT(','));
+    AppendField(Keys.GraphType,
+        StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(Graph.GraphType)));
+
+    // The compact dialect lists each node type once and refers to it by index
+    TArray<EN2CNodeType, TInlineAllocator<16>> NodeTypes;
+    if (Keys.bCompact)
     {
-        TSharedPtr<FJsonObject> GraphObject = GraphToJsonObject(Graph);
-        if (GraphObject.IsValid())
+        for (const EN2CNodeType NodeType : Graph.NodeTypes)
         {
-            GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObject));
+            NodeTypes.AddUnique(NodeType);
         }
-    }
-    JsonObject->SetArrayField(TEXT("graphs"), GraphsArray);
 
-    // Add structs array
-    TArray<TSharedPtr<FJsonValue>> StructsArray;
-    for (const FN2CStruct& Struct : Blueprint.Structs)
-    {
-        TSharedPtr<FJsonObject> StructObject = StructToJsonObject(Struct);
-        if (StructObject.IsValid())
+        if (NodeTypes.Num() > 0)
         {
-            StructsArray.Add(MakeShared<FJsonValueObject>(StructObject));
+            AppendKey(Keys.NodeTypes);
+            Out.AppendChar(TEXT('['));
+            for (int32 Index = 0; Index < NodeTypes.Num(); ++Index)
+            {
+                if (Index > 0)
+                {
+                    Out.AppendChar(TEXT(','));
+                }
+                AppendJsonString(Out, NodeTypeEnum->GetNameStringByValue(static_cast<int64>(NodeTypes[Index])));
+            }
+            Out.AppendChar(TEXT(']'));
         }
     }
-    JsonObject->SetArrayField(TEXT("structs"), StructsArray);
 
-    // Add enums array
-    TArray<TSharedPtr<FJsonValue>> EnumsArray;
-    for (const FN2CEnum& Enum : Blueprint.Enums)
+    AppendKey(Keys.Nodes);
+    Out.AppendChar(TEXT('['));
+
+    for (int32 NodeIndex = 0; NodeIndex < Graph.NumNodes(); ++NodeIndex)
     {
-        TSharedPtr<FJsonObject> EnumObject = EnumToJsonObject(Enum);
-        if (EnumObject.IsValid())
+        if (NodeIndex > 0)
+        {
+            Out.AppendChar(TEXT(','));
+        }
+
+        Out.AppendChar(TEXT('{'));
+        AppendField(Keys.ID, Strings.Get(Graph.NodeIDs[NodeIndex]));
+        if (Keys.bCompact)
+        {
+            AppendKey(Keys.Type);
+            Out.AppendInt(NodeTypes.IndexOfByKey(Graph.NodeTypes[NodeIndex]));
+        }
+        else
+        {
+            Out.AppendChar(TEXT(','));
+            AppendField(Keys.Type, NodeTypeEnum->GetNameStringByValue(static_cast<int64>(Graph.NodeTypes[NodeIndex])));
+        }
+        Out.AppendChar(TEXT(','));
+        AppendField(Keys.Name, Strings.Get(Graph.NodeNames[NodeIndex]));
+
+        if (Graph.NodeMemberParents[NodeIndex] != 0)
+        {
+            Out.AppendChar(TEXT(','));
+            AppendField(Keys.MemberParent, Strings.Get(Graph.NodeMemberParents[NodeIndex]));
+        }
+        if (Graph.NodeMemberNames[NodeIndex] != 0)
+        {
+            Out.AppendChar(TEXT(','));
+            AppendField(Keys.MemberName, Strings.Get(Graph.NodeMemberNames[NodeIndex]));
+        }
+        if (Graph.NodeComments[NodeIndex] != 0)
         {
-            EnumsArray.Add(MakeShared<FJsonValueObject>(EnumObject));
+            Out.AppendChar(TEXT(','));
+            AppendField(Keys.Comment, Strings.Get(Graph.NodeComments[NodeIndex]));
         }
+
+        const uint8 NodeFlags = Graph.NodeFlags[NodeIndex];
+        if (NodeFlags & FN2CCompactGraph::NodePure)
+        {
+            AppendFlag(Keys.Pure);
+        }
+        if (NodeFlags & FN2CCompactGraph::NodeLatent)
+        {
+            AppendFlag(Keys.Latent);
+        }
+
+        auto AppendPins = [&](const TCHAR* Key, int32 FirstPin, int32 PinCount)
+        {
+            if (Keys.bCompact && PinCount == 0)
+            {
+                return;
+            }
+
+            AppendKey(Key);
+            Out.AppendChar(TEXT('['));
+
+            for (int32 PinIndex = FirstPin; PinIndex < FirstPin + PinCount; ++PinIndex)
+            {
+                if (PinIndex > FirstPin)
+                {
+                    Out.AppendChar(TEXT(','));
+                }
+
+                Out.AppendChar(TEXT('{'));
+                AppendField(Keys.ID, Strings.Get(Graph.PinIDs[PinIndex]));
+                Out.AppendChar(TEXT(','));
+                AppendField(Keys.Name, Strings.Get(Graph.PinNames[PinIndex]));
+
+                if (Graph.PinTypes[PinIndex] != EN2CPinType::Exec)
+                {
+                    Out.AppendChar(TEXT(','));
+                    AppendField(Keys.Type, PinTypeEnum->GetNameStringByValue(static_cast<int64>(Graph.PinTypes[PinIndex])));
+                }
+                if (Graph.PinSubTypes[PinIndex] != 0)
+                {
+                    Out.AppendChar(TEXT(','));
+                    AppendField(Keys.SubType, Strings.Get(Graph.PinSubTypes[PinIndex]));
+                }
+                if (Graph.PinDefaultValues[PinIndex] != 0)
+                {
+                    Out.AppendChar(TEXT(','));
+                    AppendField(Keys.DefaultValue, Strings.Get(Graph.PinDefaultValues[PinIndex]));
+                }
+
+                const uint8 PinFlags = Graph.PinFlags[PinIndex];
+                if (PinFlags & FN2CCompactGraph::PinConnected)
+                {
+                    AppendFlag(Keys.Connected);
+                }
+                if (PinFlags & FN2CCompactGraph::PinReference)
+                {
+                    AppendFlag(Keys.IsReference);
+                }
+                if (PinFlags & FN2CCompactGraph::PinConst)
+                {
+                    AppendFlag(Keys.IsConst);
+                }
+                if (PinFlags & FN2CCompactGraph::PinArray)
+                {
+                    AppendFlag(Keys.IsArray);
+                }
+                if (PinFlags & FN2CCompactGraph::PinMap)
+                {
+                    AppendFlag(Keys.IsMap);
+                }
+                if (PinFlags & FN2CCompactGraph::PinSet)
+                {
+                    AppendFlag(Keys.IsSet);
+                }
+                Out.AppendChar(TEXT('}'));
+            }
+            Out.AppendChar(TEXT(']'));
+        };
+
+        const int32 FirstPin = Graph.NodeFirstPin[NodeIndex];
+        const int32 InputCount = Graph.NodeInputPinCounts[NodeIndex];
+        AppendPins(Keys.InputPins, FirstPin, InputCount);
+        AppendPins(Keys.OutputPins, FirstPin + InputCount, Graph.NodeOutputPinCounts[NodeIndex]);
+        Out.AppendChar(TEXT('}'));
     }
-    JsonObject->SetArrayField(TEXT("enums"), EnumsArray);
+    Out.AppendChar(TEXT(']'));
 
-    // Add variables array
-    TArray<TSharedPtr<FJsonValue>> VarsArray;
-    for (const FN2CVariable& Var : Blueprint.Variables)
+    AppendKey(Keys.Flows);
+    Out.AppendChar(TEXT('{'));
+
+    // Flow ends are rendered from the ID columns, as WriteFlows renders them from the nodes
+    const FN2CFlows& Flows = Graph.Flows;
+    auto AppendNodeID = [&Graph, &Strings](FString& Reference, int32 NodeIndex)
     {
-        TSharedPtr<FJsonObject> VarObject = VariableToJsonObject(Var);
-        if (VarObject.IsValid())
+        if (!Graph.NodeIDs.IsValidIndex(NodeIndex))
         {
-            VarsArray.Add(MakeShared<FJsonValueObject>(VarObject));
+            return false;
         }
-    }
-    JsonObject->SetArrayField(TEXT("variables"), VarsArray);
+        Reference.Append(Strings.Get(Graph.NodeIDs[NodeIndex]));
+        return true;
+    };
 
-    // Add components array
-    TArray<TSharedPtr<FJsonValue>> ComponentsArray;
-    for (const FN2CComponentOverride& Component : Blueprint.Components)
+    auto AppendPinReference = [&Graph, &Strings, &AppendNodeID](FString& Reference, int32 NodeIndex, int32 PinIndex)
     {
-        TSharedPtr<FJsonObject> ComponentObject = MakeShared<FJsonObject>();
+        if (!AppendNodeID(Reference, NodeIndex) || PinIndex < 0
+            || PinIndex >= Graph.NodeInputPinCounts[NodeIndex] + Graph.NodeOutputPinCounts[NodeIndex])
+        {
+            return false;
+        }
+        Reference.AppendChar(TEXT('.'));
+        Reference.Append(Strings.Get(Graph.PinIDs[Graph.NodeFirstPin[NodeIndex] + PinIndex]));
+        return true;
+    };
+
+    // Tracks whether the flows object has a field yet, since the compact dialect may leave both out
+    FString Reference;
+    FString Target;
+    bool bFirstFlowField = true;
+    if (!Keys.bCompact || Flows.NumExecutionChains() > 0)
+    {
+        Out.AppendChar(TEXT('"'));
+        Out.Append(Keys.Execution);
+        Out.Append(TEXT("\":["));
+        bool bFirstChain = true;
+        for (int32 ChainIndex = 0; ChainIndex < Flows.NumExecutionChains(); ++ChainIndex)
+        {
+            Reference.Reset();
+            bool bResolved = true;
+            for (const int32 NodeIndex : Flows.GetExecutionChain(ChainIndex))
+            {
+                if (!Reference.IsEmpty())
+                {
+                    Reference.Append(TEXT("->"));
+                }
+                bResolved = bResolved && AppendNodeID(Reference, NodeIndex);
+            }
+            if (!bResolved)
+            {
+                continue;
+            }
 
-        ComponentObject->SetStringField(TEXT("component_name"), Component.ComponentName);
-        ComponentObject->SetStringField(TEXT("component_class_name"), Component.ComponentClassName);
+            if (!bFirstChain)
+            {
+                Out.AppendChar(TEXT(','));
+            }
+            AppendJsonString(Out, Reference);
+            bFirstChain = false;
+        }
+        Out.AppendChar(TEXT(']'));
+        bFirstFlowField = false;
+    }
 
-        if (!Component.AttachParentName.IsEmpty())
+    if (!Keys.bCompact || Flows.Data.Num() > 0)
+    {
+        if (!bFirstFlowField)
         {
-            ComponentObject->SetStringField(TEXT("attach_parent_name"), Component.AttachParentName);
+            Out.AppendChar(TEXT(','));
         }
-
-        // Serialize overridden properties as an array of variable objects
-        TArray<TSharedPtr<FJsonValue>> OverriddenPropsArray;
-        for (const FN2CVariable& Var : Component.OverriddenProperties)
+        Out.AppendChar(TEXT('"'));
+        Out.Append(Keys.Data);
+        Out.Append(TEXT("\":{"));
+        bool bFirstData = true;
+        for (const FN2CDataFlow& DataFlow : Flows.Data)
         {
-            TSharedPtr<FJsonObject> VarObject = VariableToJsonObject(Var);
-            if (VarObject.IsValid())
+            Reference.Reset();
+            Target.Reset();
+            if (!AppendPinReference(Reference, DataFlow.SourceNode, DataFlow.SourcePin)
+                || !AppendPinReference(Target, DataFlow.TargetNode, DataFlow.TargetPin))
             {
-                OverriddenPropsArray.Add(MakeShared<FJsonValueObject>(VarObject));
+                continue;
             }
-        }
-        ComponentObject->SetArrayField(TEXT("overridden_properties"), OverriddenPropsArray);
 
-        ComponentsArray.Add(MakeShared<FJsonValueObject>(ComponentObject));
+            if (!bFirstData)
+            {
+                Out.AppendChar(TEXT(','));
+            }
+            AppendJsonString(Out, Reference);
+            Out.AppendChar(TEXT(':'));
+            AppendJsonString(Out, Target);
+            bFirstData = false;
+        }
+        Out.AppendChar(TEXT('}'));
     }
-    JsonObject->SetArrayField(TEXT("components"), ComponentsArray);
+    Out.Append(TEXT("}}"));
 
-    return JsonObject;
+    return Out;
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::GraphToJsonObject(const FN2CGraph& Graph)
+void FN2CSerializer::AppendJsonString(FString& Out, FStringView Value)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    // Same escaping as the engine JSON writer, with clean runs copied in bulk
+    FN2CJsonEscape::AppendQuoted(Out, Value);
+}
 
-    // Add basic properties
-    JsonObject->SetStringField(TEXT("name"), Graph.Name);
-    JsonObject->SetStringField(TEXT("graph_type"), 
-        StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(Graph.GraphType)));
+TSet<FString> FN2CSerializer::ExpandReferencedNames(const FN2CBlueprint& Blueprint, const TSet<FString>& ReferencedNames)
+{
+    TSet<FString> Expanded = ReferencedNames;
+    auto AddType = [&Expanded](const FN2CVariable& Var)
+    {
+        if (!Var.TypeName.IsEmpty())
+        {
+            Expanded.Add(Var.TypeName);
+        }
+        if (!Var.KeyTypeName.IsEmpty())
+        {
+            Expanded.Add(Var.KeyTypeName);
+        }
+    };
 
-    // Add nodes array
-    TArray<TSharedPtr<FJsonValue>> NodesArray;
-    for (const FN2CNodeDefinition& Node : Graph.Nodes)
+    for (const FN2CVariable& Var : Blueprint.Variables)
+    {
+        if (ReferencedNames.Contains(Var.Name))
+        {
+            AddType(Var);
+        }
+    }
+    for (const FN2CComponentOverride& Component : Blueprint.Components)
     {
-        TSharedPtr<FJsonObject> NodeObject = NodeToJsonObject(Node);
-        if (NodeObject.IsValid())
+        if (ReferencedNames.Contains(Component.ComponentName))
         {
-            NodesArray.Add(MakeShared<FJsonValueObject>(NodeObject));
+            for (const FN2CVariable& Var : Component.OverriddenProperties)
+            {
+                AddType(Var);
+            }
         }
     }
-    JsonObject->SetArrayField(TEXT("nodes"), NodesArray);
 
-    // Add flows
-    JsonObject->SetObjectField(TEXT("flows"), FlowsToJsonObject(Graph.Flows));
+    // Structs can nest, so repeat until no referenced struct adds a new member type
+    bool bAdded = true;
+    while (bAdded)
+    {
+        bAdded = false;
+        for (const FN2CStruct& Struct : Blueprint.Structs)
+        {
+            if (!Expanded.Contains(Struct.Name))
+            {
+                continue;
+            }
+            for (const FN2CStructMember& Member : Struct.Members)
+            {
+                for (const FString* TypeName : { &Member.TypeName, &Member.KeyTypeName })
+                {
+                    if (!TypeName->IsEmpty() && !Expanded.Contains(*TypeName))
+                    {
+                        Expanded.Add(*TypeName);
+                        bAdded = true;
+                    }
+                }
+            }
+        }
+    }
+    return Expanded;
+}
 
-    return JsonObject;
+FString FN2CSerializer::SharedContextToJson(const FN2CBlueprint& Blueprint, EN2CJsonDialect Dialect, const TSet<FString>* ReferencedNames)
+{
+    // Only the shared sections, so the graphs are never serialized here
+    const FKeys& Keys = GetKeys(Dialect);
+    const TSet<FString> Expanded = ReferencedNames ? ExpandReferencedNames(Blueprint, *ReferencedNames) : TSet<FString>();
+    const TSet<FString>* Filter = ReferencedNames ? &Expanded : nullptr;
+    return WriteCondensed([&Keys, &Blueprint, Filter](FCondensedWriter& Writer)
+    {
+        Writer.WriteObjectStart();
+        WriteHeaderFields(Writer, Keys, Blueprint);
+        WriteSharedFields(Writer, Keys, Blueprint, EN2CJsonSections::All, Filter);
+        Writer.WriteObjectEnd();
+    });
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::NodeToJsonObject(const FN2CNodeDefinition& Node)
+bool FN2CSerializer::BuildBatchContext(
+    const FN2CBlueprint& Blueprint,
+    FN2CBatchJsonContext& OutContext,
+    EN2CJsonDialect Dialect,
+    const TSet<FString>* ReferencedNames)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
 
-    // Required fields
-    JsonObject->SetStringField(TEXT("id"), Node.ID);
-    JsonObject->SetStringField(TEXT("type"), 
-        StaticEnum<EN2CNodeType>()->GetNameStringByValue(static_cast<int64>(Node.NodeType)));
-    JsonObject->SetStringField(TEXT("name"), Node.Name);
-    
-    // Optional fields - only add if non-empty
-    if (!Node.GetCleanMemberParent().IsEmpty())
+    const FKeys& Keys = GetKeys(Dialect);
+    const TSet<FString> Expanded = ReferencedNames ? ExpandReferencedNames(Blueprint, *ReferencedNames) : TSet<FString>();
+    const TSet<FString>* Filter = ReferencedNames ? &Expanded : nullptr;
+    FString HeadJson = WriteCondensed([&Keys, &Blueprint](FCondensedWriter& Writer)
     {
-        JsonObject->SetStringField(TEXT("member_parent"), Node.GetCleanMemberParent());
-    }
-    if (!Node.MemberName.IsEmpty())
+        Writer.WriteObjectStart();
+        WriteHeaderFields(Writer, Keys, Blueprint);
+        Writer.WriteObjectEnd();
+    });
+
+    FString TailJson = WriteCondensed([&Keys, &Blueprint, Filter](FCondensedWriter& Writer)
     {
-        JsonObject->SetStringField(TEXT("member_name"), Node.MemberName);
-    }
-    if (!Node.Comment.IsEmpty())
+        Writer.WriteObjectStart();
+        WriteSharedFields(Writer, Keys, Blueprint, EN2CJsonSections::All, Filter);
+        Writer.WriteObjectEnd();
+    });
+
+    if (HeadJson.Len() < 2 || TailJson.Len() < 2)
     {
-        JsonObject->SetStringField(TEXT("comment"), Node.Comment);
+        FN2CLogger::Get().LogError(TEXT("Failed to serialize shared Blueprint context"), TEXT("Serialization"));
+        return false;
     }
-    
-    // Only add flags if true
-    if (Node.bPure)
+
+    // Drop the closing brace of the head and the opening brace of the tail so a graphs array fits between them
+    HeadJson.LeftChopInline(1);
+    TailJson.RightChopInline(1);
+
+    OutContext.Head = MoveTemp(HeadJson);
+    OutContext.Tail = MoveTemp(TailJson);
+    OutContext.Dialect = Dialect;
+    return true;
+}
+
+FString FN2CSerializer::ToJsonForGraph(const FN2CBatchJsonContext& Context, const FN2CGraph& Graph)
+{
+    const FString GraphJson = GraphToJson(Graph, Context.Dialect);
+    if (GraphJson.IsEmpty())
     {
-        JsonObject->SetBoolField(TEXT("pure"), true);
+        return TEXT("");
     }
-    if (Node.bLatent)
+
+    return ToJsonForGraphs(Context, { GraphJson });
+}
+
+FString FN2CSerializer::ToJsonForGraphs(const FN2CBatchJsonContext& Context, const TArray<FString>& GraphJsons)
+{
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
+
+    if (!Context.IsValid() || GraphJsons.Num() == 0)
     {
-        JsonObject->SetBoolField(TEXT("latent"), true);
+        return TEXT("");
     }
 
-    // Add input pins array
-    TArray<TSharedPtr<FJsonValue>> InputPinsArray;
-    for (const FN2CPinDefinition& Pin : Node.InputPins)
+    // Same field order as WriteBlueprint: version, metadata, graphs, then shared sections
+    const FKeys& Keys = GetKeys(Context.Dialect);
+
+    int32 TotalLength = Context.Head.Len() + Context.Tail.Len() + 16;
+    for (const FString& GraphJson : GraphJsons)
     {
-        TSharedPtr<FJsonObject> PinObject = PinToJsonObject(Pin);
-        if (PinObject.IsValid())
-        {
-            InputPinsArray.Add(MakeShared<FJsonValueObject>(PinObject));
-        }
+        TotalLength += GraphJson.Len() + 1;
     }
-    JsonObject->SetArrayField(TEXT("input_pins"), InputPinsArray);
 
-    // Add output pins array
-    TArray<TSharedPtr<FJsonValue>> OutputPinsArray;
-    for (const FN2CPinDefinition& Pin : Node.OutputPins)
-    {
-        TSharedPtr<FJsonObject> PinObject = PinToJsonObject(Pin);
-        if (PinObject.IsValid())
+    FString OutputString;
+    OutputString.Reserve(TotalLength);
+    OutputString += Context.Head;
+    OutputString += TEXT(",\"");
+    OutputString += Keys.Graphs;
+    OutputString += TEXT("\":[");
+    for (int32 Index = 0; Index < GraphJsons.Num(); ++Index)
+    {
+        if (Index > 0)
         {
-            OutputPinsArray.Add(MakeShared<FJsonValueObject>(PinObject));
+            OutputString += TEXT(",");
         }
+        OutputString += GraphJsons[Index];
     }
-    JsonObject->SetArrayField(TEXT("output_pins"), OutputPinsArray);
-
-    return JsonObject;
+    // A tail of just the closing brace means every shared section was left out
+    OutputString += Context.Tail.Len() > 1 ? TEXT("],") : TEXT("]");
+    OutputString += Context.Tail;
+    return OutputString;
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::PinToJsonObject(const FN2CPinDefinition& Pin)
+FString FN2CSerializer::GraphDeltaToJson(
+    const FN2CMetadata& Metadata,
+    const FN2CGraph& Previous,
+    const FN2CGraph& Current,
+    const FN2CGraphDelta& Delta,
+    const FN2CGeneratedCode& PreviousCode)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
 
-    // Required fields
-    JsonObject->SetStringField(TEXT("id"), Pin.ID);
-    JsonObject->SetStringField(TEXT("name"), Pin.Name);
-    
-    // Only add type if not Exec
-    if (Pin.Type != EN2CPinType::Exec)
-    {
-        JsonObject->SetStringField(TEXT("type"), 
-            StaticEnum<EN2CPinType>()->GetNameStringByValue(static_cast<int64>(Pin.Type)));
-    }
-    
-    // Optional fields - only add if non-empty
-    if (!Pin.SubType.IsEmpty())
+    auto RemovedID = [](const FString& ID)
     {
-        JsonObject->SetStringField(TEXT("sub_type"), Pin.SubType);
-    }
-    if (!Pin.DefaultValue.IsEmpty())
+        return TEXT("R") + (ID.StartsWith(TEXT("N")) ? ID.RightChop(1) : ID);
+    };
+
+    // Subgraph of the given nodes, in graph order, keeping their IDs unless renamed
+    auto BuildSubgraph = [](const FN2CGraph& Source, const TSet<int32>& Nodes, TFunctionRef<FString(int32)> GetID, TArray<int32>& OutIndices)
     {
-        JsonObject->SetStringField(TEXT("default_value"), Pin.DefaultValue);
-    }
-    
-    // Only add connection status if true
-    if (Pin.bConnected)
+        FN2CGraph Subgraph;
+        Subgraph.Name = Source.Name;
+        Subgraph.GraphType = Source.GraphType;
+
+        TArray<int32> SortedNodes = Nodes.Array();
+        SortedNodes.Sort();
+        OutIndices.Init(INDEX_NONE, Source.Nodes.Num());
+        for (const int32 NodeIndex : SortedNodes)
+        {
+            OutIndices[NodeIndex] = Subgraph.Nodes.Num();
+            FN2CNodeDefinition& Node = Subgraph.Nodes.Add_GetRef(Source.Nodes[NodeIndex]);
+            Node.ID = GetID(NodeIndex);
+        }
+        return Subgraph;
+    };
+
+    // Current side: added and changed nodes, and the nodes the added flows reach
+    TSet<int32> CurrentNodes;
+    CurrentNodes.Append(Delta.AddedNodes);
+    CurrentNodes.Append(Delta.ChangedNodes);
+    for (const FN2CGraphDelta::FExecLink& Link : Delta.AddedExecLinks)
     {
-        JsonObject->SetBoolField(TEXT("connected"), true);
+        CurrentNodes.Add(Link.From);
+        CurrentNodes.Add(Link.To);
     }
-    
-    // Only add flags if true
-    if (Pin.bIsReference)
+    for (const FN2CDataFlow& Flow : Delta.AddedDataFlows)
     {
-        JsonObject->SetBoolField(TEXT("is_reference"), true);
+        CurrentNodes.Add(Flow.SourceNode);
+        CurrentNodes.Add(Flow.TargetNode);
     }
-    if (Pin.bIsConst)
+
+    TArray<int32> CurrentIndices;
+    FN2CGraph CurrentPart = BuildSubgraph(Current, CurrentNodes, [&Current](int32 NodeIndex) { return Current.Nodes[NodeIndex].ID; }, CurrentIndices);
+    for (const FN2CGraphDelta::FExecLink& Link : Delta.AddedExecLinks)
     {
-        JsonObject->SetBoolField(TEXT("is_const"), true);
+        CurrentPart.Flows.AddExecutionChain({ CurrentIndices[Link.From], CurrentIndices[Link.To] });
     }
-    if (Pin.bIsArray)
+    for (const FN2CDataFlow& Flow : Delta.AddedDataFlows)
     {
-        JsonObject->SetBoolField(TEXT("is_array"), true);
+        CurrentPart.Flows.Data.Emplace(CurrentIndices[Flow.SourceNode], Flow.SourcePin, CurrentIndices[Flow.TargetNode], Flow.TargetPin);
     }
-    if (Pin.bIsMap)
+
+    // Previous side: removed nodes, and the nodes the removed flows reached, known by their current IDs where they remain
+    TSet<int32> PreviousNodes;
+    PreviousNodes.Append(Delta.RemovedNodes);
+    for (const FN2CGraphDelta::FExecLink& Link : Delta.RemovedExecLinks)
     {
-        JsonObject->SetBoolField(TEXT("is_map"), true);
+        PreviousNodes.Add(Link.From);
+        PreviousNodes.Add(Link.To);
     }
-    if (Pin.bIsSet)
+    for (const FN2CDataFlow& Flow : Delta.RemovedDataFlows)
     {
-        JsonObject->SetBoolField(TEXT("is_set"), true);
+        PreviousNodes.Add(Flow.SourceNode);
+        PreviousNodes.Add(Flow.TargetNode);
     }
 
-    return JsonObject;
-}
-
-TSharedPtr<FJsonObject> FN2CSerializer::FlowsToJsonObject(const FN2CFlows& Flows)
-{
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-
-    // Add execution flows array
-    TArray<TSharedPtr<FJsonValue>> ExecutionArray;
-    for (const FString& Flow : Flows.Execution)
+    auto GetPreviousID = [&Previous, &Current, &Delta, &RemovedID](int32 NodeIndex)
     {
-        ExecutionArray.Add(MakeShared<FJsonValueString>(Flow));
-    }
-    JsonObject->SetArrayField(TEXT("execution"), ExecutionArray);
+        const int32 CurrentIndex = Delta.PreviousToCurrent[NodeIndex];
+        return CurrentIndex != INDEX_NONE ? Current.Nodes[CurrentIndex].ID : RemovedID(Previous.Nodes[NodeIndex].ID);
+    };
 
-    // Add data flows object
-    TSharedPtr<FJsonObject> DataFlowsObject = MakeShared<FJsonObject>();
-    for (const auto& DataFlow : Flows.Data)
+    TArray<int32> PreviousIndices;
+    FN2CGraph RemovedPart = BuildSubgraph(Previous, PreviousNodes, GetPreviousID, PreviousIndices);
+    for (const FN2CGraphDelta::FExecLink& Link : Delta.RemovedExecLinks)
     {
-        DataFlowsObject->SetStringField(DataFlow.Key, DataFlow.Value);
+        RemovedPart.Flows.AddExecutionChain({ PreviousIndices[Link.From], PreviousIndices[Link.To] });
     }
-    JsonObject->SetObjectField(TEXT("data"), DataFlowsObject);
-
-    return JsonObject;
-}
-
-TSharedPtr<FJsonObject> FN2CSerializer::StructToJsonObject(const FN2CStruct& Struct)
-{
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-    
-    // Add basic struct info
-    JsonObject->SetStringField(TEXT("name"), Struct.Name);
-    
-    if (!Struct.Comment.IsEmpty())
+    for (const FN2CDataFlow& Flow : Delta.RemovedDataFlows)
     {
-        JsonObject->SetStringField(TEXT("comment"), Struct.Comment);
+        RemovedPart.Flows.Data.Emplace(PreviousIndices[Flow.SourceNode], Flow.SourcePin, PreviousIndices[Flow.TargetNode], Flow.TargetPin);
     }
-    
-    // Add members array
-    TArray<TSharedPtr<FJsonValue>> MembersArray;
-    for (const FN2CStructMember& Member : Struct.Members)
+
+    const FKeys& Keys = GetKeys(EN2CJsonDialect::Standard);
+    return WriteCondensed([&Keys, &Metadata, &Previous, &Current, &Delta, &PreviousCode, &CurrentPart, &RemovedPart, &RemovedID](FCondensedWriter& Writer)
     {
-        TSharedPtr<FJsonObject> MemberObject = MakeShared<FJsonObject>();
-        
-        // Add member properties
-        MemberObject->SetStringField(TEXT("name"), Member.Name);
-        MemberObject->SetStringField(TEXT("type"), 
-            StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type)));
-        
-        if (!Member.TypeName.IsEmpty())
-        {
-            MemberObject->SetStringField(TEXT("type_name"), Member.TypeName);
-        }
-        
-        if (Member.bIsArray)
-        {
-            MemberObject->SetBoolField(TEXT("is_array"), true);
-        }
-        
-        if (Member.bIsSet)
+        Writer.WriteObjectStart();
+        Writer.WriteValue(Keys.Version, FString(FN2CVersion::DeltaValue()));
+
+        Writer.WriteObjectStart(Keys.Metadata);
+        Writer.WriteValue(Keys.Name, Metadata.Name);
+        Writer.WriteValue(Keys.BlueprintType,
+            StaticEnum<EN2CBlueprintType>()->GetNameStringByValue(static_cast<int64>(Metadata.BlueprintType)));
+        Writer.WriteValue(Keys.BlueprintClass, Metadata.BlueprintClass);
+        Writer.WriteObjectEnd();
+
+        Writer.WriteValue(TEXT("graph_name"), Current.Name);
+        Writer.WriteValue(TEXT("graph_type"), StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(Current.GraphType)));
+
+        Writer.WriteArrayStart(TEXT("added_nodes"));
+        for (const int32 NodeIndex : Delta.AddedNodes)
         {
-            MemberObject->SetBoolField(TEXT("is_set"), true);
+            Writer.WriteValue(Current.Nodes[NodeIndex].ID);
         }
-        
-        if (Member.bIsMap)
+        Writer.WriteArrayEnd();
+
+        Writer.WriteArrayStart(TEXT("changed_nodes"));
+        for (const int32 NodeIndex : Delta.ChangedNodes)
         {
-            MemberObject->SetBoolField(TEXT("is_map"), true);
-            MemberObject->SetStringField(TEXT("key_type"), 
-                StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.KeyType)));
-                
-            if (!Member.KeyTypeName.IsEmpty())
-            {
-                MemberObject->SetStringField(TEXT("key_type_name"), Member.KeyTypeName);
-            }
+            Writer.WriteValue(Current.Nodes[NodeIndex].ID);
         }
-        
-        if (!Member.DefaultValue.IsEmpty())
+        Writer.WriteArrayEnd();
+
+        Writer.WriteArrayStart(TEXT("removed_nodes"));
+        for (const int32 NodeIndex : Delta.RemovedNodes)
         {
-            MemberObject->SetStringField(TEXT("default_value"), Member.DefaultValue);
+            Writer.WriteValue(RemovedID(Previous.Nodes[NodeIndex].ID));
         }
-        
-        if (!Member.Comment.IsEmpty())
+        Writer.WriteArrayEnd();
+
+        Writer.WriteIdentifierPrefix(TEXT("current"));
+        WriteGraph(Writer, Keys, CurrentPart);
+        Writer.WriteIdentifierPrefix(TEXT("removed"));
+        WriteGraph(Writer, Keys, RemovedPart);
+
+        // Same keys as the "code" object of a response
+        Writer.WriteObjectStart(TEXT("previous_code"));
+        Writer.WriteValue(TEXT("graphDeclaration"), PreviousCode.GraphDeclaration);
+        Writer.WriteValue(TEXT("graphImplementation"), PreviousCode.GraphImplementation);
+        Writer.WriteValue(TEXT("implementationNotes"), PreviousCode.ImplementationNotes);
+        Writer.WriteObjectEnd();
+
+        Writer.WriteObjectEnd();
+    }, EstimateGraphJsonLength(CurrentPart) + EstimateGraphJsonLength(RemovedPart)
+        + PreviousCode.GraphDeclaration.Len() + PreviousCode.GraphImplementation.Len() + PreviousCode.ImplementationNotes.Len() + 512);
+}
+
+FString FN2CSerializer::WithCalleeDeclarations(const FString& Json, const TArray<TPair<FString, FString>>& Declarations)
+{
+    int32 CloseIndex = INDEX_NONE;
+    if (Declarations.Num() == 0 || !Json.FindLastChar(TEXT('}'), CloseIndex))
+    {
+        return Json;
+    }
+
+    int32 ReserveLength = Json.Len() + 32;
+    for (const TPair<FString, FString>& Declaration : Declarations)
+    {
+        ReserveLength += Declaration.Key.Len() + Declaration.Value.Len() + 8;
+    }
+
+    FString Out;
+    Out.Reserve(ReserveLength);
+    Out.Append(*Json, CloseIndex);
+    Out.Append(TEXT(",\"callee_declarations\":{"));
+    for (int32 Index = 0; Index < Declarations.Num(); ++Index)
+    {
+        if (Index > 0)
         {
-            MemberObject->SetStringField(TEXT("comment"), Member.Comment);
+            Out.AppendChar(TEXT(','));
         }
-        
-        MembersArray.Add(MakeShared<FJsonValueObject>(MemberObject));
+        AppendJsonString(Out, Declarations[Index].Key);
+        Out.AppendChar(TEXT(':'));
+        AppendJsonString(Out, Declarations[Index].Value);
     }
-    
-    JsonObject->SetArrayField(TEXT("members"), MembersArray);
-    
-    return JsonObject;
+    Out.AppendChar(TEXT('}'));
+    Out.Append(FStringView(Json).RightChop(CloseIndex));
+    return Out;
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::EnumToJsonObject(const FN2CEnum& Enum)
+FString FN2CSerializer::WithSharedMacros(const FString& Json, const TArray<FString>& MacroNames)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-    
-    // Add basic enum info
-    JsonObject->SetStringField(TEXT("name"), Enum.Name);
-    
-    if (!Enum.Comment.IsEmpty())
+    int32 CloseIndex = INDEX_NONE;
+    if (MacroNames.Num() == 0 || !Json.FindLastChar(TEXT('}'), CloseIndex))
+    {
+        return Json;
+    }
+
+    int32 ReserveLength = Json.Len() + 24;
+    for (const FString& MacroName : MacroNames)
     {
-        JsonObject->SetStringField(TEXT("comment"), Enum.Comment);
+        ReserveLength += MacroName.Len() + 4;
     }
-    
-    // Add values array
-    TArray<TSharedPtr<FJsonValue>> ValuesArray;
-    for (const FN2CEnumValue& Value : Enum.Values)
+
+    FString Out;
+    Out.Reserve(ReserveLength);
+    Out.Append(*Json, CloseIndex);
+    Out.Append(TEXT(",\"shared_macros\":["));
+    for (int32 Index = 0; Index < MacroNames.Num(); ++Index)
     {
-        TSharedPtr<FJsonObject> ValueObject = MakeShared<FJsonObject>();
-        
-        // Add value properties
-        ValueObject->SetStringField(TEXT("name"), Value.Name);
-        
-        if (!Value.Comment.IsEmpty())
+        if (Index > 0)
         {
-            ValueObject->SetStringField(TEXT("comment"), Value.Comment);
+            Out.AppendChar(TEXT(','));
         }
-        
-        ValuesArray.Add(MakeShared<FJsonValueObject>(ValueObject));
+        AppendJsonString(Out, MacroNames[Index]);
     }
-    
-    JsonObject->SetArrayField(TEXT("values"), ValuesArray);
-    
-    return JsonObject;
+    Out.AppendChar(TEXT(']'));
+    Out.Append(FStringView(Json).RightChop(CloseIndex));
+    return Out;
 }
 
-TSharedPtr<FJsonObject> FN2CSerializer::VariableToJsonObject(const FN2CVariable& Var)
+FString FN2CSerializer::WriteCondensed(TFunctionRef<void(FCondensedWriter&)> Write, int32 ReserveLength)
 {
-    TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+    FString OutputString;
+    OutputString.Reserve(ReserveLength);
 
-    JsonObject->SetStringField(TEXT("name"), Var.Name);
-    JsonObject->SetStringField(TEXT("type"),
-        StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Var.Type)));
+    TSharedRef<FCondensedWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+    Write(*Writer);
 
-    if (!Var.TypeName.IsEmpty())
+    if (!Writer->Close())
     {
-        JsonObject->SetStringField(TEXT("type_name"), Var.TypeName);
+        FN2CLogger::Get().LogError(TEXT("Failed to serialize JSON object to string"));
+        return TEXT("");
     }
 
-    if (Var.bIsArray)
+    return OutputString;
+}
+
+int32 FN2CSerializer::EstimateGraphJsonLength(const FN2CGraph& Graph)
+{
+    // Rough per-element sizes of condensed output, only used to size the output buffer up front
+    int32 PinCount = 0;
+    for (const FN2CNodeDefinition& Node : Graph.Nodes)
     {
-        JsonObject->SetBoolField(TEXT("is_array"), true);
+        PinCount += Node.InputPins.Num() + Node.OutputPins.Num();
     }
-    if (Var.bIsSet)
+
+    return 256 + Graph.Nodes.Num() * 128 + PinCount * 48 + (Graph.Flows.NumExecutionChains() + Graph.Flows.Data.Num()) * 32;
+}
+
+int32 FN2CSerializer::EstimateJsonLength(const FN2CBlueprint& Blueprint, bool bPrettyPrint)
+{
+    int32 Length = 1024 + (Blueprint.Variables.Num() + Blueprint.Components.Num()) * 128;
+    for (const FN2CGraph& Graph : Blueprint.Graphs)
     {
-        JsonObject->SetBoolField(TEXT("is_set"), true);
+        Length += EstimateGraphJsonLength(Graph);
     }
-    if (Var.bIsMap)
-    {
-        JsonObject->SetBoolField(TEXT("is_map"), true);
-        JsonObject->SetStringField(TEXT("key_type"),
+
+    // Pretty output adds line breaks and indentation to every field
+    return bPrettyPrint ? Length * 2 : Length;
+}
+
+bool FN2CSerializer::FromJson(const FString& JsonString, FN2CBlueprint& OutBlueprint)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CFromJson);
+    LLM_SCOPE_BYTAG(NodeToCode_Serializer);
+
+    // Populate the Blueprint directly from the token stream, without building a JSON object tree
+    TSharedRef<FTokenReader> Reader = TJsonReaderFactory<TCHAR>::Create(JsonString);
+
+    EJsonNotation Notation;
+    if (!ReadToken(*Reader, Notation) || Notation != EJsonNotation::ObjectStart || !ReadBlueprint(*Reader, OutBlueprint))
+    {
+        if (!Reader->GetErrorMessage().IsEmpty())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to parse JSON string: %s"), *Reader->GetErrorMessage()));
+        }
+        else if (Notation != EJsonNotation::ObjectStart)
+        {
+            FN2CLogger::Get().LogError(TEXT("Failed to parse JSON string"));
+        }
+        return false;
+    }
+
+    return true;
+}
+
+template <class WriterType>
+bool FN2CSerializer::WriteArrayStart(WriterType& Writer, const FKeys& Keys, const TCHAR* Key, int32 Num)
+{
+    // The compact dialect leaves out empty arrays
+    if (Keys.bCompact && Num == 0)
+    {
+        return false;
+    }
+
+    Writer.WriteArrayStart(Key);
+    return true;
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteBlueprint(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint, EN2CJsonSections Sections)
+{
+    Writer.WriteObjectStart();
+
+    WriteHeaderFields(Writer, Keys, Blueprint);
+
+    // Write graphs array
+    Writer.WriteArrayStart(Keys.Graphs);
+    for (const FN2CGraph& Graph : Blueprint.Graphs)
+    {
+        WriteGraph(Writer, Keys, Graph);
+    }
+    Writer.WriteArrayEnd();
+
+    WriteSharedFields(Writer, Keys, Blueprint, Sections);
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteHeaderFields(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint)
+{
+    // Write version, the compact dialect carries its own schema version
+    Writer.WriteValue(Keys.Version, Keys.bCompact ? FString(FN2CVersion::CompactValue()) : Blueprint.Version.Value);
+
+    // Write metadata
+    Writer.WriteObjectStart(Keys.Metadata);
+    Writer.WriteValue(Keys.Name, Blueprint.Metadata.Name);
+    Writer.WriteValue(Keys.BlueprintType,
+        StaticEnum<EN2CBlueprintType>()->GetNameStringByValue(static_cast<int64>(Blueprint.Metadata.BlueprintType)));
+    Writer.WriteValue(Keys.BlueprintClass, Blueprint.Metadata.BlueprintClass);
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteSharedFields(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint, EN2CJsonSections Sections, const TSet<FString>* ReferencedNames)
+{
+    // Entries outside ReferencedNames are left out when it is given
+    auto IsReferenced = [ReferencedNames](const FString& Name)
+    {
+        return !ReferencedNames || ReferencedNames->Contains(Name);
+    };
+
+    // Write structs array
+    const int32 NumStructs = static_cast<int32>(Algo::CountIf(Blueprint.Structs, [&IsReferenced](const FN2CStruct& Struct) { return IsReferenced(Struct.Name); }));
+    if (EnumHasAnyFlags(Sections, EN2CJsonSections::Structs) && WriteArrayStart(Writer, Keys, Keys.Structs, NumStructs))
+    {
+        for (const FN2CStruct& Struct : Blueprint.Structs)
+        {
+            if (IsReferenced(Struct.Name))
+            {
+                WriteStruct(Writer, Keys, Struct);
+            }
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    // Write enums array
+    const int32 NumEnums = static_cast<int32>(Algo::CountIf(Blueprint.Enums, [&IsReferenced](const FN2CEnum& Enum) { return IsReferenced(Enum.Name); }));
+    if (EnumHasAnyFlags(Sections, EN2CJsonSections::Enums) && WriteArrayStart(Writer, Keys, Keys.Enums, NumEnums))
+    {
+        for (const FN2CEnum& Enum : Blueprint.Enums)
+        {
+            if (IsReferenced(Enum.Name))
+            {
+                WriteEnum(Writer, Keys, Enum);
+            }
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    // Write variables array
+    const int32 NumVariables = static_cast<int32>(Algo::CountIf(Blueprint.Variables, [&IsReferenced](const FN2CVariable& Var) { return IsReferenced(Var.Name); }));
+    if (EnumHasAnyFlags(Sections, EN2CJsonSections::Variables) && WriteArrayStart(Writer, Keys, Keys.Variables, NumVariables))
+    {
+        for (const FN2CVariable& Var : Blueprint.Variables)
+        {
+            if (IsReferenced(Var.Name))
+            {
+                WriteVariable(Writer, Keys, Var);
+            }
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    // Write components array
+    const int32 NumComponents = static_cast<int32>(Algo::CountIf(Blueprint.Components,
+        [&IsReferenced](const FN2CComponentOverride& Component) { return IsReferenced(Component.ComponentName); }));
+    if (EnumHasAnyFlags(Sections, EN2CJsonSections::Components) && WriteArrayStart(Writer, Keys, Keys.Components, NumComponents))
+    {
+        for (const FN2CComponentOverride& Component : Blueprint.Components)
+        {
+            if (!IsReferenced(Component.ComponentName))
+            {
+                continue;
+            }
+
+            Writer.WriteObjectStart();
+
+            Writer.WriteValue(Keys.ComponentName, Component.ComponentName);
+            Writer.WriteValue(Keys.ComponentClassName, Component.ComponentClassName);
+
+            if (!Component.AttachParentName.IsEmpty())
+            {
+                Writer.WriteValue(Keys.AttachParentName, Component.AttachParentName);
+            }
+
+            // Overridden properties are written as an array of variable objects
+            if (WriteArrayStart(Writer, Keys, Keys.OverriddenProperties, Component.OverriddenProperties.Num()))
+            {
+                for (const FN2CVariable& Var : Component.OverriddenProperties)
+                {
+                    WriteVariable(Writer, Keys, Var);
+                }
+                Writer.WriteArrayEnd();
+            }
+
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+    }
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteGraph(WriterType& Writer, const FKeys& Keys, const FN2CGraph& Graph)
+{
+    Writer.WriteObjectStart();
+
+    // Write basic properties
+    Writer.WriteValue(Keys.Name, Graph.Name);
+    Writer.WriteValue(Keys.GraphType,
+        StaticEnum<EN2CGraphType>()->GetNameStringByValue(static_cast<int64>(Graph.GraphType)));
+
+    // The compact dialect lists each node type once and refers to it by index
+    TArray<EN2CNodeType, TInlineAllocator<16>> NodeTypes;
+    if (Keys.bCompact)
+    {
+        for (const FN2CNodeDefinition& Node : Graph.Nodes)
+        {
+            NodeTypes.AddUnique(Node.NodeType);
+        }
+
+        if (WriteArrayStart(Writer, Keys, Keys.NodeTypes, NodeTypes.Num()))
+        {
+            for (const EN2CNodeType NodeType : NodeTypes)
+            {
+                Writer.WriteValue(StaticEnum<EN2CNodeType>()->GetNameStringByValue(static_cast<int64>(NodeType)));
+            }
+            Writer.WriteArrayEnd();
+        }
+    }
+
+    // Write nodes array
+    Writer.WriteArrayStart(Keys.Nodes);
+    for (const FN2CNodeDefinition& Node : Graph.Nodes)
+    {
+        WriteNode(Writer, Keys, Node, Keys.bCompact ? NodeTypes.IndexOfByKey(Node.NodeType) : INDEX_NONE);
+    }
+    Writer.WriteArrayEnd();
+
+    // Write flows
+    Writer.WriteObjectStart(Keys.Flows);
+    WriteFlows(Writer, Keys, Graph);
+    Writer.WriteObjectEnd();
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteNode(WriterType& Writer, const FKeys& Keys, const FN2CNodeDefinition& Node, int32 NodeTypeIndex)
+{
+    Writer.WriteObjectStart();
+
+    // Required fields
+    Writer.WriteValue(Keys.ID, Node.ID);
+    if (NodeTypeIndex != INDEX_NONE)
+    {
+        Writer.WriteValue(Keys.Type, NodeTypeIndex);
+    }
+    else
+    {
+        Writer.WriteValue(Keys.Type,
+            StaticEnum<EN2CNodeType>()->GetNameStringByValue(static_cast<int64>(Node.NodeType)));
+    }
+    Writer.WriteValue(Keys.Name, Node.Name);
+
+    // Optional fields - only write if non-empty
+    const FString MemberParent = Node.GetCleanMemberParent();
+    if (!MemberParent.IsEmpty())
+    {
+        Writer.WriteValue(Keys.MemberParent, MemberParent);
+    }
+    if (!Node.MemberName.IsEmpty())
+    {
+        Writer.WriteValue(Keys.MemberName, Node.MemberName);
+    }
+    if (!Node.Comment.IsEmpty())
+    {
+        Writer.WriteValue(Keys.Comment, Node.Comment);
+    }
+
+    // Only write flags if true
+    if (Node.bPure)
+    {
+        Writer.WriteValue(Keys.Pure, true);
+    }
+    if (Node.bLatent)
+    {
+        Writer.WriteValue(Keys.Latent, true);
+    }
+
+    // Write input pins array
+    if (WriteArrayStart(Writer, Keys, Keys.InputPins, Node.InputPins.Num()))
+    {
+        for (const FN2CPinDefinition& Pin : Node.InputPins)
+        {
+            WritePin(Writer, Keys, Pin);
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    // Write output pins array
+    if (WriteArrayStart(Writer, Keys, Keys.OutputPins, Node.OutputPins.Num()))
+    {
+        for (const FN2CPinDefinition& Pin : Node.OutputPins)
+        {
+            WritePin(Writer, Keys, Pin);
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WritePin(WriterType& Writer, const FKeys& Keys, const FN2CPinDefinition& Pin)
+{
+    Writer.WriteObjectStart();
+
+    // Required fields
+    Writer.WriteValue(Keys.ID, Pin.ID);
+    Writer.WriteValue(Keys.Name, Pin.Name);
+
+    // Only write type if not Exec
+    if (Pin.Type != EN2CPinType::Exec)
+    {
+        Writer.WriteValue(Keys.Type,
+            StaticEnum<EN2CPinType>()->GetNameStringByValue(static_cast<int64>(Pin.Type)));
+    }
+
+    // Optional fields - only write if non-empty
+    if (!Pin.SubType.IsEmpty())
+    {
+        Writer.WriteValue(Keys.SubType, Pin.SubType);
+    }
+    if (!Pin.DefaultValue.IsEmpty())
+    {
+        Writer.WriteValue(Keys.DefaultValue, Pin.DefaultValue);
+    }
+
+    // Only write connection status if true
+    if (Pin.bConnected)
+    {
+        Writer.WriteValue(Keys.Connected, true);
+    }
+
+    // Only write flags if true
+    if (Pin.bIsReference)
+    {
+        Writer.WriteValue(Keys.IsReference, true);
+    }
+    if (Pin.bIsConst)
+    {
+        Writer.WriteValue(Keys.IsConst, true);
+    }
+    if (Pin.bIsArray)
+    {
+        Writer.WriteValue(Keys.IsArray, true);
+    }
+    if (Pin.bIsMap)
+    {
+        Writer.WriteValue(Keys.IsMap, true);
+    }
+    if (Pin.bIsSet)
+    {
+        Writer.WriteValue(Keys.IsSet, true);
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteFlows(WriterType& Writer, const FKeys& Keys, const FN2CGraph& Graph)
+{
+    const FN2CFlows& Flows = Graph.Flows;
+
+    // Write execution flows array, rendering each chain's node IDs as "N1->N2->N3"
+    FString Reference;
+    if (WriteArrayStart(Writer, Keys, Keys.Execution, Flows.NumExecutionChains()))
+    {
+        for (int32 ChainIndex = 0; ChainIndex < Flows.NumExecutionChains(); ++ChainIndex)
+        {
+            Reference.Reset();
+            if (Graph.AppendExecutionChain(Reference, ChainIndex))
+            {
+                Writer.WriteValue(Reference);
+            }
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    // Write data flows object, from "N1.P4" to "N2.P3"
+    if (!Keys.bCompact || Flows.Data.Num() > 0)
+    {
+        Writer.WriteObjectStart(Keys.Data);
+        FString Target;
+        for (const FN2CDataFlow& DataFlow : Flows.Data)
+        {
+            Reference.Reset();
+            Target.Reset();
+            if (Graph.AppendPinReference(Reference, DataFlow.SourceNode, DataFlow.SourcePin)
+                && Graph.AppendPinReference(Target, DataFlow.TargetNode, DataFlow.TargetPin))
+            {
+                Writer.WriteValue(Reference, Target);
+            }
+        }
+        Writer.WriteObjectEnd();
+    }
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteStruct(WriterType& Writer, const FKeys& Keys, const FN2CStruct& Struct)
+{
+    Writer.WriteObjectStart();
+
+    // Write basic struct info
+    Writer.WriteValue(Keys.Name, Struct.Name);
+
+    if (!Struct.Comment.IsEmpty())
+    {
+        Writer.WriteValue(Keys.Comment, Struct.Comment);
+    }
+
+    // Write members array
+    if (WriteArrayStart(Writer, Keys, Keys.Members, Struct.Members.Num()))
+    {
+        for (const FN2CStructMember& Member : Struct.Members)
+        {
+            Writer.WriteObjectStart();
+
+            // Write member properties
+            Writer.WriteValue(Keys.Name, Member.Name);
+            Writer.WriteValue(Keys.Type,
+                StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.Type)));
+
+            if (!Member.TypeName.IsEmpty())
+            {
+                Writer.WriteValue(Keys.TypeName, Member.TypeName);
+            }
+
+            if (Member.bIsArray)
+            {
+                Writer.WriteValue(Keys.IsArray, true);
+            }
+
+            if (Member.bIsSet)
+            {
+                Writer.WriteValue(Keys.IsSet, true);
+            }
+
+            if (Member.bIsMap)
+            {
+                Writer.WriteValue(Keys.IsMap, true);
+                Writer.WriteValue(Keys.KeyType,
+                    StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Member.KeyType)));
+
+                if (!Member.KeyTypeName.IsEmpty())
+                {
+                    Writer.WriteValue(Keys.KeyTypeName, Member.KeyTypeName);
+                }
+            }
+
+            if (!Member.DefaultValue.IsEmpty())
+            {
+                Writer.WriteValue(Keys.DefaultValue, Member.DefaultValue);
+            }
+
+            if (!Member.Comment.IsEmpty())
+            {
+                Writer.WriteValue(Keys.Comment, Member.Comment);
+            }
+
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteEnum(WriterType& Writer, const FKeys& Keys, const FN2CEnum& Enum)
+{
+    Writer.WriteObjectStart();
+
+    // Write basic enum info
+    Writer.WriteValue(Keys.Name, Enum.Name);
+
+    if (!Enum.Comment.IsEmpty())
+    {
+        Writer.WriteValue(Keys.Comment, Enum.Comment);
+    }
+
+    // Write values array
+    if (WriteArrayStart(Writer, Keys, Keys.Values, Enum.Values.Num()))
+    {
+        for (const FN2CEnumValue& Value : Enum.Values)
+        {
+            Writer.WriteObjectStart();
+
+            Writer.WriteValue(Keys.Name, Value.Name);
+
+            if (!Value.Comment.IsEmpty())
+            {
+                Writer.WriteValue(Keys.Comment, Value.Comment);
+            }
+
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+template <class WriterType>
+void FN2CSerializer::WriteVariable(WriterType& Writer, const FKeys& Keys, const FN2CVariable& Var)
+{
+    Writer.WriteObjectStart();
+
+    Writer.WriteValue(Keys.Name, Var.Name);
+    Writer.WriteValue(Keys.Type,
+        StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Var.Type)));
+
+    if (!Var.TypeName.IsEmpty())
+    {
+        Writer.WriteValue(Keys.TypeName, Var.TypeName);
+    }
+
+    if (Var.bIsArray)
+    {
+        Writer.WriteValue(Keys.IsArray, true);
+    }
+    if (Var.bIsSet)
+    {
+        Writer.WriteValue(Keys.IsSet, true);
+    }
+    if (Var.bIsMap)
+    {
+        Writer.WriteValue(Keys.IsMap, true);
+        Writer.WriteValue(Keys.KeyType,
             StaticEnum<EN2CStructMemberType>()->GetNameStringByValue(static_cast<int64>(Var.KeyType)));
         if (!Var.KeyTypeName.IsEmpty())
         {
-            JsonObject->SetStringField(TEXT("key_type_name"), Var.KeyTypeName);
+            Writer.WriteValue(Keys.KeyTypeName, Var.KeyTypeName);
+        }
+    }
+
+    if (!Var.DefaultValue.IsEmpty())
+    {
+        Writer.WriteValue(Keys.DefaultValue, Var.DefaultValue);
+    }
+    if (!Var.Comment.IsEmpty())
+    {
+        Writer.WriteValue(Keys.Comment, Var.Comment);
+    }
+
+    Writer.WriteObjectEnd();
+}
+
+bool FN2CSerializer::ReadToken(FTokenReader& Reader, EJsonNotation& OutNotation)
+{
+    // End of input and malformed input both stop the reader
+    if (!Reader.ReadNext(OutNotation))
+    {
+        OutNotation = EJsonNotation::Error;
+    }
+    return OutNotation != EJsonNotation::Error;
+}
+
+bool FN2CSerializer::SkipValue(FTokenReader& Reader, EJsonNotation Notation)
+{
+    switch (Notation)
+    {
+    case EJsonNotation::ObjectStart:
+        return Reader.SkipObject();
+    case EJsonNotation::ArrayStart:
+        return Reader.SkipArray();
+    default:
+        // Scalars are consumed with their token
+        return true;
+    }
+}
+
+template <typename ElementReaderType>
+bool FN2CSerializer::ReadObjectArray(FTokenReader& Reader, int32& OutInvalidCount, ElementReaderType&& ReadElement)
+{
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation))
+    {
+        if (Notation == EJsonNotation::ArrayEnd)
+        {
+            return true;
+        }
+
+        if (Notation != EJsonNotation::ObjectStart)
+        {
+            // Non-object entries are ignored
+            if (!SkipValue(Reader, Notation))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        // An invalid element has still been read to its end, a malformed one stops the next ReadToken
+        if (!ReadElement())
+        {
+            ++OutInvalidCount;
+        }
+    }
+    return false;
+}
+
+bool FN2CSerializer::ParseEnumName(const TCHAR* FieldName, const UEnum* Enum, const FString& NameString, int64& OutValue)
+{
+    OutValue = Enum->GetValueByNameString(NameString, EGetByNameFlags::None);
+    if (OutValue == INDEX_NONE)
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Invalid %s in JSON: %s"), FieldName, *NameString));
+        return false;
+    }
+    return true;
+}
+
+bool FN2CSerializer::ReadBlueprint(FTokenReader& Reader, FN2CBlueprint& OutBlueprint)
+{
+    bool bHasVersion = false;
+    bool bHasMetadata = false;
+    bool bMetadataValid = false;
+    bool bHasGraphs = false;
+    int32 InvalidGraphCount = 0;
+
+    OutBlueprint.Graphs.Empty();
+    OutBlueprint.Structs.Empty();
+    OutBlueprint.Enums.Empty();
+    OutBlueprint.Variables.Empty();
+    OutBlueprint.Components.Empty();
+    OutBlueprint.MarkModified();
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
+    {
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String && Field == TEXT("version"))
+        {
+            OutBlueprint.Version.Value = Reader.GetValueAsString();
+            bHasVersion = true;
+        }
+        else if (Notation == EJsonNotation::ObjectStart && Field == TEXT("metadata"))
+        {
+            bHasMetadata = true;
+            bMetadataValid = ReadMetadata(Reader, OutBlueprint.Metadata);
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("graphs"))
+        {
+            bHasGraphs = true;
+            bRead = ReadObjectArray(Reader, InvalidGraphCount, [&Reader, &OutBlueprint]()
+            {
+                FN2CGraph Graph;
+                if (!ReadGraph(Reader, Graph))
+                {
+                    FN2CLogger::Get().LogWarning(TEXT("Skipping invalid graph during deserialization"));
+                    return false;
+                }
+                OutBlueprint.Graphs.Add(MoveTemp(Graph));
+                return true;
+            });
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("structs"))
+        {
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutBlueprint]()
+            {
+                FN2CStruct Struct;
+                if (!ReadStruct(Reader, Struct))
+                {
+                    return false;
+                }
+                OutBlueprint.Structs.Add(MoveTemp(Struct));
+                return true;
+            });
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("enums"))
+        {
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutBlueprint]()
+            {
+                FN2CEnum Enum;
+                if (!ReadEnum(Reader, Enum))
+                {
+                    return false;
+                }
+                OutBlueprint.Enums.Add(MoveTemp(Enum));
+                return true;
+            });
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("variables"))
+        {
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutBlueprint]()
+            {
+                FN2CVariable Var;
+                if (!ReadVariable(Reader, Var))
+                {
+                    return false;
+                }
+                OutBlueprint.Variables.Add(MoveTemp(Var));
+                return true;
+            });
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("components"))
+        {
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutBlueprint]()
+            {
+                FN2CComponentOverride Component;
+                if (!ReadComponent(Reader, Component))
+                {
+                    return false;
+                }
+                OutBlueprint.Components.Add(MoveTemp(Component));
+                return true;
+            });
+        }
+        else
+        {
+            bRead = SkipValue(Reader, Notation);
+        }
+
+        if (!bRead)
+        {
+            return false;
+        }
+    }
+
+    if (Notation != EJsonNotation::ObjectEnd)
+    {
+        return false;
+    }
+
+    if (!bHasVersion)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing version field in JSON"), TEXT("Deserialization"));
+        return false;
+    }
+
+    if (OutBlueprint.Version.Value != TEXT("1.0.0"))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Unexpected version '%s' - expected '1.0.0'"), *OutBlueprint.Version.Value));
+    }
+
+    if (!bHasMetadata)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing metadata object in JSON"), TEXT("Deserialization"));
+        return false;
+    }
+
+    if (!bMetadataValid)
+    {
+        return false;
+    }
+
+    if (!bHasGraphs)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing graphs array in JSON"), TEXT("Deserialization"));
+        return false;
+    }
+
+    // Log deserialization results
+    if (InvalidGraphCount > 0)
+    {
+        const int32 ValidGraphCount = OutBlueprint.Graphs.Num();
+        FString LogContext = FString::Printf(TEXT("Processed %d/%d graphs successfully"),
+            ValidGraphCount, ValidGraphCount + InvalidGraphCount);
+        FN2CLogger::Get().LogWarning(TEXT("Partial deserialization completed"), LogContext);
+        return ValidGraphCount > 0;  // Return true if we got at least one valid graph
+    }
+
+    return true;
+}
+
+bool FN2CSerializer::ReadMetadata(FTokenReader& Reader, FN2CMetadata& OutMetadata)
+{
+    bool bHasName = false;
+    bool bHasClass = false;
+    FString TypeString;
+    bool bHasType = false;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
+    {
+        const FString& Field = Reader.GetIdentifier();
+        if (Notation == EJsonNotation::String && Field == TEXT("name"))
+        {
+            OutMetadata.Name = Reader.GetValueAsString();
+            bHasName = true;
+        }
+        else if (Notation == EJsonNotation::String && Field == TEXT("blueprint_type"))
+        {
+            TypeString = Reader.GetValueAsString();
+            bHasType = true;
+        }
+        else if (Notation == EJsonNotation::String && Field == TEXT("blueprint_class"))
+        {
+            OutMetadata.BlueprintClass = Reader.GetValueAsString();
+            bHasClass = true;
+        }
+        else if (!SkipValue(Reader, Notation))
+        {
+            return false;
+        }
+    }
+
+    if (Notation != EJsonNotation::ObjectEnd)
+    {
+        return false;
+    }
+
+    if (!bHasName || !bHasType || !bHasClass)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing required metadata fields in JSON"));
+        return false;
+    }
+
+    // Convert type string to enum
+    int64 TypeValue;
+    if (!ParseEnumName(TEXT("blueprint_type"), StaticEnum<EN2CBlueprintType>(), TypeString, TypeValue))
+    {
+        return false;
+    }
+    OutMetadata.BlueprintType = static_cast<EN2CBlueprintType>(TypeValue);
+
+    return true;
+}
+
+bool FN2CSerializer::ReadGraph(FTokenReader& Reader, FN2CGraph& OutGraph)
+{
+    // Flows may be read before the nodes they refer to, so they are resolved once the graph is read
+    FSerializedFlows Flows;
+    bool bHasName = false;
+    bool bHasNodes = false;
+    bool bHasFlows = false;
+    bool bFlowsValid = false;
+    FString TypeString;
+    bool bHasType = false;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
+    {
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String && Field == TEXT("name"))
+        {
+            OutGraph.Name = Reader.GetValueAsString();
+            bHasName = true;
+        }
+        else if (Notation == EJsonNotation::String && Field == TEXT("graph_type"))
+        {
+            TypeString = Reader.GetValueAsString();
+            bHasType = true;
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("nodes"))
+        {
+            bHasNodes = true;
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutGraph]()
+            {
+                FN2CNodeDefinition Node;
+                if (!ReadNode(Reader, Node))
+                {
+                    return false;
+                }
+                OutGraph.Nodes.Add(MoveTemp(Node));
+                return true;
+            });
+        }
+        else if (Notation == EJsonNotation::ObjectStart && Field == TEXT("flows"))
+        {
+            bHasFlows = true;
+            bFlowsValid = ReadFlows(Reader, Flows);
+        }
+        else
+        {
+            bRead = SkipValue(Reader, Notation);
+        }
+
+        if (!bRead)
+        {
+            return false;
+        }
+    }
+
+    if (Notation != EJsonNotation::ObjectEnd)
+    {
+        return false;
+    }
+
+    if (!bHasName || !bHasType)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing required graph fields in JSON"));
+        return false;
+    }
+
+    // Convert type string to enum
+    int64 TypeValue;
+    if (!ParseEnumName(TEXT("graph_type"), StaticEnum<EN2CGraphType>(), TypeString, TypeValue))
+    {
+        return false;
+    }
+    OutGraph.GraphType = static_cast<EN2CGraphType>(TypeValue);
+
+    if (!bHasNodes)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing nodes array in JSON"));
+        return false;
+    }
+
+    if (!bHasFlows)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing flows object in JSON"));
+        return false;
+    }
+
+    if (!bFlowsValid)
+    {
+        return false;
+    }
+
+    ResolveFlows(Flows, OutGraph);
+    return true;
+}
+
+bool FN2CSerializer::ReadNode(FTokenReader& Reader, FN2CNodeDefinition& OutNode)
+{
+    bool bHasID = false;
+    bool bHasName = false;
+    bool bHasInputPins = false;
+    bool bHasOutputPins = false;
+    FString TypeString;
+    bool bHasType = false;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
+    {
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String)
+        {
+            if (Field == TEXT("id"))
+            {
+                OutNode.ID = Reader.GetValueAsString();
+                bHasID = true;
+            }
+            else if (Field == TEXT("type"))
+            {
+                TypeString = Reader.GetValueAsString();
+                bHasType = true;
+            }
+            else if (Field == TEXT("name"))
+            {
+                OutNode.Name = Reader.GetValueAsString();
+                bHasName = true;
+            }
+            else if (Field == TEXT("member_parent"))
+            {
+                OutNode.MemberParent = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("member_name"))
+            {
+                OutNode.MemberName = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("comment"))
+            {
+                OutNode.Comment = Reader.GetValueAsString();
+            }
+        }
+        else if (Notation == EJsonNotation::Boolean)
+        {
+            if (Field == TEXT("pure"))
+            {
+                OutNode.bPure = Reader.GetValueAsBoolean();
+            }
+            else if (Field == TEXT("latent"))
+            {
+                OutNode.bLatent = Reader.GetValueAsBoolean();
+            }
+        }
+        else if (Notation == EJsonNotation::ArrayStart && (Field == TEXT("input_pins") || Field == TEXT("output_pins")))
+        {
+            const bool bInput = Field == TEXT("input_pins");
+            TArray<FN2CPinDefinition>& Pins = bInput ? OutNode.InputPins : OutNode.OutputPins;
+            (bInput ? bHasInputPins : bHasOutputPins) = true;
+
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &Pins]()
+            {
+                FN2CPinDefinition Pin;
+                if (!ReadPin(Reader, Pin))
+                {
+                    return false;
+                }
+                Pins.Add(MoveTemp(Pin));
+                return true;
+            });
+        }
+        else
+        {
+            bRead = SkipValue(Reader, Notation);
+        }
+
+        if (!bRead)
+        {
+            return false;
+        }
+    }
+
+    if (Notation != EJsonNotation::ObjectEnd)
+    {
+        return false;
+    }
+
+    if (!bHasID || !bHasType || !bHasName)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing required node fields in JSON"));
+        return false;
+    }
+
+    // Convert type string to enum
+    int64 TypeValue;
+    if (!ParseEnumName(TEXT("node_type"), StaticEnum<EN2CNodeType>(), TypeString, TypeValue))
+    {
+        return false;
+    }
+    OutNode.NodeType = static_cast<EN2CNodeType>(TypeValue);
+
+    if (!bHasInputPins)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing input_pins array in JSON"));
+        return false;
+    }
+
+    if (!bHasOutputPins)
+    {
+        FN2CLogger::Get().LogError(TEXT("Missing output_pins array in JSON"));
+        return false;
+    }
+
+    return true;
+}
+
+bool FN2CSerializer::ReadPin(FTokenReader& Reader, FN2CPinDefinition& OutPin)
+{
+    bool bHasID = false;
+    bool bHasName = false;
+    FString TypeString;
+    bool bHasType = false;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
+    {
+        const FString& Field = Reader.GetIdentifier();
+        if (Notation == EJsonNotation::String)
+        {
+            if (Field == TEXT("id"))
+            {
+                OutPin.ID = Reader.GetValueAsString();
+                bHasID = true;
+            }
+            else if (Field == TEXT("name"))
+            {
+                OutPin.Name = Reader.GetValueAsString();
+                bHasName = true;
+            }
+            else if (Field == TEXT("type"))
+            {
+                TypeString = Reader.GetValueAsString();
+                bHasType = true;
+            }
+            else if (Field == TEXT("sub_type"))
+            {
+                OutPin.SubType = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("default_value"))
+            {
+                OutPin.DefaultValue = Reader.GetValueAsString();
+            }
+        }
+        else if (Notation == EJsonNotation::Boolean)
+        {
+            const bool bValue = Reader.GetValueAsBoolean();
+            if (Field == TEXT("connected"))
+            {
+                OutPin.bConnected = bValue;
+            }
+            else if (Field == TEXT("is_reference"))
+            {
+                OutPin.bIsReference = bValue;
+            }
+            else if (Field == TEXT("is_const"))
+            {
+                OutPin.bIsConst = bValue;
+            }
+            else if (Field == TEXT("is_array"))
+            {
+                OutPin.bIsArray = bValue;
+            }
+            else if (Field == TEXT("is_map"))
+            {
+                OutPin.bIsMap = bValue;
+            }
+            else if (Field == TEXT("is_set"))
+            {
+                OutPin.bIsSet = bValue;
+            }
+        }
+        else if (!SkipValue(Reader, Notation))
+        {
+            return false;
         }
     }
 
-    if (!Var.DefaultValue.IsEmpty())
-    {
-        JsonObject->SetStringField(TEXT("default_value"), Var.DefaultValue);
-    }
-    if (!Var.Comment.IsEmpty())
-    {
-        JsonObject->SetStringField(TEXT("comment"), Var.Comment);
-    }
-
-    return JsonObject;
-}
-
-bool FN2CSerializer::ParseBlueprintFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CBlueprint& OutBlueprint)
-{
-    if (!JsonObject.IsValid())
-    {
-        return false;
-    }
-
-    // Parse version
-    FString Version;
-    if (!JsonObject->TryGetStringField(TEXT("version"), Version))
+    if (Notation != EJsonNotation::ObjectEnd)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing version field in JSON"), TEXT("Deserialization"));
         return false;
     }
-    
-    if (Version != TEXT("1.0.0"))
-    {
-        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Unexpected version '%s' - expected '1.0.0'"), *Version));
-    }
-    OutBlueprint.Version.Value = Version;
 
-    // Parse metadata
-    const TSharedPtr<FJsonObject>* MetadataObject;
-    if (!JsonObject->TryGetObjectField(TEXT("metadata"), MetadataObject))
+    if (!bHasID || !bHasName)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing metadata object in JSON"), TEXT("Deserialization"));
+        FN2CLogger::Get().LogError(TEXT("Missing required pin fields in JSON"));
         return false;
     }
 
-    // Track partial deserialization state
-    bool bHasPartialData = false;
-
-    FString Name, TypeString, Class;
-    if (!(*MetadataObject)->TryGetStringField(TEXT("name"), Name) ||
-        !(*MetadataObject)->TryGetStringField(TEXT("blueprint_type"), TypeString) ||
-        !(*MetadataObject)->TryGetStringField(TEXT("blueprint_class"), Class))
+    // The writer omits the type of exec pins
+    if (!bHasType)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required metadata fields in JSON"));
-        return false;
+        OutPin.Type = EN2CPinType::Exec;
+        return true;
     }
 
-    OutBlueprint.Metadata.Name = Name;
-    OutBlueprint.Metadata.BlueprintClass = Class;
-
     // Convert type string to enum
-    int64 TypeValue = StaticEnum<EN2CBlueprintType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-    if (TypeValue == INDEX_NONE)
+    int64 TypeValue;
+    if (!ParseEnumName(TEXT("pin_type"), StaticEnum<EN2CPinType>(), TypeString, TypeValue))
     {
-        FN2CLogger::Get().LogError(TEXT("Invalid blueprint_type in JSON"));
         return false;
     }
-    OutBlueprint.Metadata.BlueprintType = static_cast<EN2CBlueprintType>(TypeValue);
+    OutPin.Type = static_cast<EN2CPinType>(TypeValue);
 
-    // Parse graphs array
-    const TArray<TSharedPtr<FJsonValue>>* GraphsArray;
-    if (!JsonObject->TryGetArrayField(TEXT("graphs"), GraphsArray))
-    {
-        FN2CLogger::Get().LogError(TEXT("Missing graphs array in JSON"), TEXT("Deserialization"));
-        return false;
-    }
+    return true;
+}
 
-    int32 ValidGraphCount = 0;
-    int32 TotalGraphCount = GraphsArray->Num();
+bool FN2CSerializer::ReadFlows(FTokenReader& Reader, FSerializedFlows& OutFlows)
+{
+    bool bHasExecution = false;
+    bool bHasData = false;
 
-    OutBlueprint.Graphs.Empty();
-    for (const TSharedPtr<FJsonValue>& GraphValue : *GraphsArray)
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
     {
-        const TSharedPtr<FJsonObject>& GraphObject = GraphValue->AsObject();
-        if (!GraphObject.IsValid())
+        const FString& Field = Reader.GetIdentifier();
+        if (Notation == EJsonNotation::ArrayStart && Field == TEXT("execution"))
         {
-            continue;
-        }
+            bHasExecution = true;
 
-        FN2CGraph Graph;
-        if (ParseGraphFromJson(GraphObject, Graph))
-        {
-            OutBlueprint.Graphs.Add(Graph);
-            ValidGraphCount++;
+            EJsonNotation FlowNotation;
+            while (ReadToken(Reader, FlowNotation) && FlowNotation != EJsonNotation::ArrayEnd)
+            {
+                if (FlowNotation == EJsonNotation::String)
+                {
+                    OutFlows.Execution.Add(Reader.GetValueAsString());
+                }
+                else if (!SkipValue(Reader, FlowNotation))
+                {
+                    return false;
+                }
+            }
+
+            if (FlowNotation != EJsonNotation::ArrayEnd)
+            {
+                return false;
+            }
         }
-        else
+        else if (Notation == EJsonNotation::ObjectStart && Field == TEXT("data"))
         {
-            FN2CLogger::Get().LogWarning(TEXT("Skipping invalid graph during deserialization"));
-            bHasPartialData = true;
-        }
-    }
-
-    // Log deserialization results
-    if (ValidGraphCount < TotalGraphCount)
-    {
-        FString Context = FString::Printf(TEXT("Processed %d/%d graphs successfully"), 
-            ValidGraphCount, TotalGraphCount);
-        FN2CLogger::Get().LogWarning(TEXT("Partial deserialization completed"), Context);
-        return ValidGraphCount > 0;  // Return true if we got at least one valid graph
-    }
+            bHasData = true;
 
-    // Optionally parse variables array
-    const TArray<TSharedPtr<FJsonValue>>* VarsArray;
-    if (JsonObject->TryGetArrayField(TEXT("variables"), VarsArray))
-    {
-        OutBlueprint.Variables.Empty();
-        for (const TSharedPtr<FJsonValue>& VarValue : *VarsArray)
-        {
-            const TSharedPtr<FJsonObject>& VarObject = VarValue->AsObject();
-            if (!VarObject.IsValid())
+            EJsonNotation FlowNotation;
+            while (ReadToken(Reader, FlowNotation) && FlowNotation != EJsonNotation::ObjectEnd)
             {
-                continue;
+                if (FlowNotation == EJsonNotation::String)
+                {
+                    OutFlows.Data.Emplace(Reader.GetIdentifier(), Reader.GetValueAsString());
+                }
+                else if (!SkipValue(Reader, FlowNotation))
+                {
+                    return false;
+                }
             }
 
-            FN2CVariable Var;
-            if (ParseVariableFromJson(VarObject, Var))
+            if (FlowNotation != EJsonNotation::ObjectEnd)
             {
-                OutBlueprint.Variables.Add(Var);
+                return false;
             }
         }
+        else if (!SkipValue(Reader, Notation))
+        {
+            return false;
+        }
     }
 
-    return true;
-}
-
-bool FN2CSerializer::ParseVariableFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CVariable& OutVar)
-{
-    if (!JsonObject.IsValid())
+    if (Notation != EJsonNotation::ObjectEnd)
     {
         return false;
     }
 
-    FString Name, TypeString;
-    if (!JsonObject->TryGetStringField(TEXT("name"), Name) ||
-        !JsonObject->TryGetStringField(TEXT("type"), TypeString))
+    if (!bHasExecution)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required variable fields in JSON"));
+        FN2CLogger::Get().LogError(TEXT("Missing execution array in JSON"));
         return false;
     }
 
-    OutVar.Name = Name;
-
-    int64 TypeValue = StaticEnum<EN2CStructMemberType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-    if (TypeValue == INDEX_NONE)
+    if (!bHasData)
     {
-        FN2CLogger::Get().LogError(FString::Printf(TEXT("Invalid variable type: %s"), *TypeString));
+        FN2CLogger::Get().LogError(TEXT("Missing data flows object in JSON"));
         return false;
     }
-    OutVar.Type = static_cast<EN2CStructMemberType>(TypeValue);
-
-    // Optional fields
-    JsonObject->TryGetStringField(TEXT("type_name"), OutVar.TypeName);
-    JsonObject->TryGetBoolField(TEXT("is_array"), OutVar.bIsArray);
-    JsonObject->TryGetBoolField(TEXT("is_set"), OutVar.bIsSet);
-    JsonObject->TryGetBoolField(TEXT("is_map"), OutVar.bIsMap);
-
-    if (OutVar.bIsMap)
-    {
-        FString KeyTypeString;
-        if (JsonObject->TryGetStringField(TEXT("key_type"), KeyTypeString))
-        {
-            int64 KeyTypeValue = StaticEnum<EN2CStructMemberType>()->GetValueByNameString(KeyTypeString, EGetByNameFlags::None);
-            if (KeyTypeValue != INDEX_NONE)
-            {
-                OutVar.KeyType = static_cast<EN2CStructMemberType>(KeyTypeValue);
-            }
-        }
-        JsonObject->TryGetStringField(TEXT("key_type_name"), OutVar.KeyTypeName);
-    }
-
-    JsonObject->TryGetStringField(TEXT("default_value"), OutVar.DefaultValue);
-    JsonObject->TryGetStringField(TEXT("comment"), OutVar.Comment);
 
     return true;
 }
 
-bool FN2CSerializer::ParseGraphFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CGraph& OutGraph)
+void FN2CSerializer::ResolveFlows(const FSerializedFlows& Flows, FN2CGraph& OutGraph)
 {
-    if (!JsonObject.IsValid())
+    TMap<FStringView, int32> NodeIndices;
+    NodeIndices.Reserve(OutGraph.Nodes.Num());
+    for (int32 Index = 0; Index < OutGraph.Nodes.Num(); ++Index)
     {
-        return false;
+        NodeIndices.Add(FStringView(OutGraph.Nodes[Index].ID), Index);
     }
 
-    // Parse basic properties
-    FString Name, TypeString;
-    if (!JsonObject->TryGetStringField(TEXT("name"), Name) ||
-        !JsonObject->TryGetStringField(TEXT("graph_type"), TypeString))
+    // Resolve "N1.P4" to its node and pin index, or false
+    auto ResolvePin = [&NodeIndices, &OutGraph](FStringView Reference, int32& OutNode, int32& OutPin)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required graph fields in JSON"));
-        return false;
-    }
+        int32 Dot = INDEX_NONE;
+        if (!Reference.FindChar(TEXT('.'), Dot))
+        {
+            return false;
+        }
+        const int32* Node = NodeIndices.Find(Reference.Left(Dot));
+        OutNode = Node ? *Node : INDEX_NONE;
+        OutPin = Node ? OutGraph.Nodes[*Node].FindPinIndex(Reference.RightChop(Dot + 1)) : INDEX_NONE;
+        return OutPin != INDEX_NONE;
+    };
+
+    FN2CFlows& OutFlows = OutGraph.Flows;
+    OutFlows.Reset();
+    OutFlows.ExecutionChainStarts.Reserve(Flows.Execution.Num());
+    OutFlows.Data.Reserve(Flows.Data.Num());
+
+    TArray<int32> Chain;
+    for (const FString& ChainString : Flows.Execution)
+    {
+        Chain.Reset();
+        bool bResolved = true;
+        FStringView Rest(ChainString);
+        while (bResolved && !Rest.IsEmpty())
+        {
+            const int32 Arrow = Rest.Find(TEXTVIEW("->"));
+            const FStringView NodeID = Arrow == INDEX_NONE ? Rest : Rest.Left(Arrow);
+            Rest.RightChopInline(Arrow == INDEX_NONE ? Rest.Len() : Arrow + 2);
+            if (NodeID.IsEmpty())
+            {
+                continue;
+            }
 
-    OutGraph.Name = Name;
+            const int32* Node = NodeIndices.Find(NodeID);
+            bResolved = Node != nullptr;
+            Chain.Add(Node ? *Node : INDEX_NONE);
+        }
 
-    // Convert type string to enum
-    int64 TypeValue = StaticEnum<EN2CGraphType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-    if (TypeValue == INDEX_NONE)
-    {
-        FN2CLogger::Get().LogError(TEXT("Invalid graph_type in JSON"));
-        return false;
+        if (!bResolved)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Dropping execution flow %s of graph %s: unknown node"), *ChainString, *OutGraph.Name));
+            continue;
+        }
+        OutFlows.AddExecutionChain(Chain);
     }
-    OutGraph.GraphType = static_cast<EN2CGraphType>(TypeValue);
 
-    // Parse nodes array
-    const TArray<TSharedPtr<FJsonValue>>* NodesArray;
-    if (!JsonObject->TryGetArrayField(TEXT("nodes"), NodesArray))
+    for (const TPair<FString, FString>& DataFlow : Flows.Data)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing nodes array in JSON"));
-        return false;
+        FN2CDataFlow Flow;
+        if (!ResolvePin(DataFlow.Key, Flow.SourceNode, Flow.SourcePin) || !ResolvePin(DataFlow.Value, Flow.TargetNode, Flow.TargetPin))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Dropping data flow %s -> %s of graph %s: unknown node or pin"),
+                *DataFlow.Key, *DataFlow.Value, *OutGraph.Name));
+            continue;
+        }
+        OutFlows.Data.Add(Flow);
     }
+}
+
+bool FN2CSerializer::ReadStruct(FTokenReader& Reader, FN2CStruct& OutStruct)
+{
+    bool bHasName = false;
+    bool bHasMembers = false;
 
-    OutGraph.Nodes.Empty();
-    for (const TSharedPtr<FJsonValue>& NodeValue : *NodesArray)
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
     {
-        const TSharedPtr<FJsonObject>& NodeObject = NodeValue->AsObject();
-        if (!NodeObject.IsValid())
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String && Field == TEXT("name"))
         {
-            continue;
+            OutStruct.Name = Reader.GetValueAsString();
+            bHasName = true;
+        }
+        else if (Notation == EJsonNotation::String && Field == TEXT("comment"))
+        {
+            OutStruct.Comment = Reader.GetValueAsString();
+        }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("members"))
+        {
+            bHasMembers = true;
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutStruct]()
+            {
+                FN2CStructMember Member;
+                if (!ReadStructMember(Reader, Member))
+                {
+                    return false;
+                }
+                OutStruct.Members.Add(MoveTemp(Member));
+                return true;
+            });
+        }
+        else
+        {
+            bRead = SkipValue(Reader, Notation);
         }
 
-        FN2CNodeDefinition Node;
-        if (ParseNodeFromJson(NodeObject, Node))
+        if (!bRead)
         {
-            OutGraph.Nodes.Add(Node);
+            return false;
         }
     }
 
-    // Parse flows
-    const TSharedPtr<FJsonObject>* FlowsObject;
-    if (!JsonObject->TryGetObjectField(TEXT("flows"), FlowsObject))
+    if (Notation != EJsonNotation::ObjectEnd)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing flows object in JSON"));
         return false;
     }
 
-    return ParseFlowsFromJson(*FlowsObject, OutGraph.Flows);
-}
-
-bool FN2CSerializer::ParseNodeFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CNodeDefinition& OutNode)
-{
-    if (!JsonObject.IsValid())
+    if (!bHasName)
     {
+        FN2CLogger::Get().LogError(TEXT("Missing required struct fields in JSON"));
         return false;
     }
 
-    // Parse basic properties
-    FString ID, TypeString, Name, MemberParent, MemberName, Comment;
-    if (!JsonObject->TryGetStringField(TEXT("id"), ID) ||
-        !JsonObject->TryGetStringField(TEXT("type"), TypeString) ||
-        !JsonObject->TryGetStringField(TEXT("name"), Name))
+    if (!bHasMembers)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required node fields in JSON"));
+        FN2CLogger::Get().LogError(TEXT("Missing members array in JSON"));
         return false;
     }
 
-    OutNode.ID = ID;
-    OutNode.Name = Name;
-
-    // Optional fields
-    JsonObject->TryGetStringField(TEXT("member_parent"), MemberParent);
-    JsonObject->TryGetStringField(TEXT("member_name"), MemberName);
-    JsonObject->TryGetStringField(TEXT("comment"), Comment);
-
-    OutNode.MemberParent = MemberParent;
-    OutNode.MemberName = MemberName;
-    OutNode.Comment = Comment;
+    return true;
+}
 
-    // Convert type string to enum
-    int64 TypeValue = StaticEnum<EN2CNodeType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-    if (TypeValue == INDEX_NONE)
+bool FN2CSerializer::ReadStructMember(FTokenReader& Reader, FN2CStructMember& OutMember)
+{
+    FN2CVariable Var;
+    if (!ReadVariable(Reader, Var))
     {
-        FN2CLogger::Get().LogError(TEXT("Invalid node_type in JSON"));
         return false;
     }
-    OutNode.NodeType = static_cast<EN2CNodeType>(TypeValue);
 
-    // Parse flags
-    bool bPure = false;
-    bool bLatent = false;
-    JsonObject->TryGetBoolField(TEXT("pure"), bPure);
-    JsonObject->TryGetBoolField(TEXT("latent"), bLatent);
-    OutNode.bPure = bPure;
-    OutNode.bLatent = bLatent;
+    // Struct members and variables share the same fields
+    OutMember.Name = MoveTemp(Var.Name);
+    OutMember.Type = Var.Type;
+    OutMember.TypeName = MoveTemp(Var.TypeName);
+    OutMember.bIsArray = Var.bIsArray;
+    OutMember.bIsSet = Var.bIsSet;
+    OutMember.bIsMap = Var.bIsMap;
+    OutMember.KeyType = Var.KeyType;
+    OutMember.KeyTypeName = MoveTemp(Var.KeyTypeName);
+    OutMember.DefaultValue = MoveTemp(Var.DefaultValue);
+    OutMember.Comment = MoveTemp(Var.Comment);
+    return true;
+}
 
-    // Parse input pins array
-    const TArray<TSharedPtr<FJsonValue>>* InputPinsArray;
-    if (!JsonObject->TryGetArrayField(TEXT("input_pins"), InputPinsArray))
-    {
-        FN2CLogger::Get().LogError(TEXT("Missing input_pins array in JSON"));
-        return false;
-    }
+bool FN2CSerializer::ReadEnum(FTokenReader& Reader, FN2CEnum& OutEnum)
+{
+    bool bHasName = false;
+    bool bHasValues = false;
 
-    OutNode.InputPins.Empty();
-    for (const TSharedPtr<FJsonValue>& PinValue : *InputPinsArray)
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
     {
-        const TSharedPtr<FJsonObject>& PinObject = PinValue->AsObject();
-        if (!PinObject.IsValid())
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String && Field == TEXT("name"))
         {
-            continue;
+            OutEnum.Name = Reader.GetValueAsString();
+            bHasName = true;
         }
-
-        FN2CPinDefinition Pin;
-        if (ParsePinFromJson(PinObject, Pin))
+        else if (Notation == EJsonNotation::String && Field == TEXT("comment"))
         {
-            OutNode.InputPins.Add(Pin);
+            OutEnum.Comment = Reader.GetValueAsString();
         }
-    }
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("values"))
+        {
+            bHasValues = true;
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutEnum]()
+            {
+                FN2CEnumValue Value;
+                bool bHasValueName = false;
 
-    // Parse output pins array
-    const TArray<TSharedPtr<FJsonValue>>* OutputPinsArray;
-    if (!JsonObject->TryGetArrayField(TEXT("output_pins"), OutputPinsArray))
-    {
-        FN2CLogger::Get().LogError(TEXT("Missing output_pins array in JSON"));
-        return false;
-    }
+                EJsonNotation ValueNotation;
+                while (ReadToken(Reader, ValueNotation) && ValueNotation != EJsonNotation::ObjectEnd)
+                {
+                    const FString& ValueField = Reader.GetIdentifier();
+                    if (ValueNotation == EJsonNotation::String && ValueField == TEXT("name"))
+                    {
+                        Value.Name = Reader.GetValueAsString();
+                        bHasValueName = true;
+                    }
+                    else if (ValueNotation == EJsonNotation::String && ValueField == TEXT("comment"))
+                    {
+                        Value.Comment = Reader.GetValueAsString();
+                    }
+                    else if (!SkipValue(Reader, ValueNotation))
+                    {
+                        return false;
+                    }
+                }
 
-    OutNode.OutputPins.Empty();
-    for (const TSharedPtr<FJsonValue>& PinValue : *OutputPinsArray)
-    {
-        const TSharedPtr<FJsonObject>& PinObject = PinValue->AsObject();
-        if (!PinObject.IsValid())
+                if (ValueNotation != EJsonNotation::ObjectEnd)
+                {
+                    return false;
+                }
+
+                if (!bHasValueName)
+                {
+                    FN2CLogger::Get().LogError(TEXT("Missing required enum value fields in JSON"));
+                    return false;
+                }
+
+                OutEnum.Values.Add(MoveTemp(Value));
+                return true;
+            });
+        }
+        else
         {
-            continue;
+            bRead = SkipValue(Reader, Notation);
         }
 
-        FN2CPinDefinition Pin;
-        if (ParsePinFromJson(PinObject, Pin))
+        if (!bRead)
         {
-            OutNode.OutputPins.Add(Pin);
+            return false;
         }
     }
 
-    return true;
-}
-
-bool FN2CSerializer::ParsePinFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CPinDefinition& OutPin)
-{
-    if (!JsonObject.IsValid())
+    if (Notation != EJsonNotation::ObjectEnd)
     {
         return false;
     }
 
-    // Parse basic properties
-    FString ID, Name, TypeString, SubType, DefaultValue;
-    if (!JsonObject->TryGetStringField(TEXT("id"), ID) ||
-        !JsonObject->TryGetStringField(TEXT("name"), Name) ||
-        !JsonObject->TryGetStringField(TEXT("type"), TypeString))
+    if (!bHasName)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required pin fields in JSON"));
+        FN2CLogger::Get().LogError(TEXT("Missing required enum fields in JSON"));
         return false;
     }
 
-    OutPin.ID = ID;
-    OutPin.Name = Name;
-
-    // Convert type string to enum
-    int64 TypeValue = StaticEnum<EN2CPinType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-    if (TypeValue == INDEX_NONE)
+    if (!bHasValues)
     {
-        FN2CLogger::Get().LogError(TEXT("Invalid pin_type in JSON"));
+        FN2CLogger::Get().LogError(TEXT("Missing values array in JSON"));
         return false;
     }
-    OutPin.Type = static_cast<EN2CPinType>(TypeValue);
-
-    // Optional fields
-    JsonObject->TryGetStringField(TEXT("sub_type"), OutPin.SubType);
-    JsonObject->TryGetStringField(TEXT("default_value"), OutPin.DefaultValue);
-
-    // Parse flags
-    bool bConnected = false;
-    bool bIsReference = false;
-    bool bIsConst = false;
-    bool bIsArray = false;
-    bool bIsMap = false;
-    bool bIsSet = false;
-
-    JsonObject->TryGetBoolField(TEXT("connected"), bConnected);
-    JsonObject->TryGetBoolField(TEXT("is_reference"), bIsReference);
-    JsonObject->TryGetBoolField(TEXT("is_const"), bIsConst);
-    JsonObject->TryGetBoolField(TEXT("is_array"), bIsArray);
-    JsonObject->TryGetBoolField(TEXT("is_map"), bIsMap);
-    JsonObject->TryGetBoolField(TEXT("is_set"), bIsSet);
-
-    OutPin.bConnected = bConnected;
-    OutPin.bIsReference = bIsReference;
-    OutPin.bIsConst = bIsConst;
-    OutPin.bIsArray = bIsArray;
-    OutPin.bIsMap = bIsMap;
-    OutPin.bIsSet = bIsSet;
 
     return true;
 }
 
-bool FN2CSerializer::ParseFlowsFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CFlows& OutFlows)
+bool FN2CSerializer::ReadVariable(FTokenReader& Reader, FN2CVariable& OutVar)
 {
-    if (!JsonObject.IsValid())
+    bool bHasName = false;
+    FString TypeString;
+    bool bHasType = false;
+    FString KeyTypeString;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
     {
-        return false;
+        const FString& Field = Reader.GetIdentifier();
+        if (Notation == EJsonNotation::String)
+        {
+            if (Field == TEXT("name"))
+            {
+                OutVar.Name = Reader.GetValueAsString();
+                bHasName = true;
+            }
+            else if (Field == TEXT("type"))
+            {
+                TypeString = Reader.GetValueAsString();
+                bHasType = true;
+            }
+            else if (Field == TEXT("type_name"))
+            {
+                OutVar.TypeName = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("key_type"))
+            {
+                KeyTypeString = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("key_type_name"))
+            {
+                OutVar.KeyTypeName = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("default_value"))
+            {
+                OutVar.DefaultValue = Reader.GetValueAsString();
+            }
+            else if (Field == TEXT("comment"))
+            {
+                OutVar.Comment = Reader.GetValueAsString();
+            }
+        }
+        else if (Notation == EJsonNotation::Boolean)
+        {
+            if (Field == TEXT("is_array"))
+            {
+                OutVar.bIsArray = Reader.GetValueAsBoolean();
+            }
+            else if (Field == TEXT("is_set"))
+            {
+                OutVar.bIsSet = Reader.GetValueAsBoolean();
+            }
+            else if (Field == TEXT("is_map"))
+            {
+                OutVar.bIsMap = Reader.GetValueAsBoolean();
+            }
+        }
+        else if (!SkipValue(Reader, Notation))
+        {
+            return false;
+        }
     }
 
-    // Parse execution flows array
-    const TArray<TSharedPtr<FJsonValue>>* ExecutionArray;
-    if (!JsonObject->TryGetArrayField(TEXT("execution"), ExecutionArray))
+    if (Notation != EJsonNotation::ObjectEnd)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing execution array in JSON"));
         return false;
     }
 
-    OutFlows.Execution.Empty();
-    for (const TSharedPtr<FJsonValue>& FlowValue : *ExecutionArray)
+    if (!bHasName || !bHasType)
     {
-        if (FlowValue->Type == EJson::String)
-        {
-            OutFlows.Execution.Add(FlowValue->AsString());
-        }
+        FN2CLogger::Get().LogError(TEXT("Missing required variable fields in JSON"));
+        return false;
     }
 
-    // Parse data flows object
-    const TSharedPtr<FJsonObject>* DataFlowsObject;
-    if (!JsonObject->TryGetObjectField(TEXT("data"), DataFlowsObject))
+    int64 TypeValue;
+    if (!ParseEnumName(TEXT("variable type"), StaticEnum<EN2CStructMemberType>(), TypeString, TypeValue))
     {
-        FN2CLogger::Get().LogError(TEXT("Missing data flows object in JSON"));
         return false;
     }
+    OutVar.Type = static_cast<EN2CStructMemberType>(TypeValue);
 
-    OutFlows.Data.Empty();
-    for (const auto& DataFlow : (*DataFlowsObject)->Values)
+    // Key type is only meaningful for maps, and an unknown one keeps the default
+    if (OutVar.bIsMap && !KeyTypeString.IsEmpty())
     {
-        if (DataFlow.Value->Type == EJson::String)
+        const int64 KeyTypeValue = StaticEnum<EN2CStructMemberType>()->GetValueByNameString(KeyTypeString, EGetByNameFlags::None);
+        if (KeyTypeValue != INDEX_NONE)
         {
-            OutFlows.Data.Add(DataFlow.Key, DataFlow.Value->AsString());
+            OutVar.KeyType = static_cast<EN2CStructMemberType>(KeyTypeValue);
         }
     }
 
     return true;
 }
 
-bool FN2CSerializer::ParseStructFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CStruct& OutStruct)
+bool FN2CSerializer::ReadComponent(FTokenReader& Reader, FN2CComponentOverride& OutComponent)
 {
-    if (!JsonObject.IsValid())
-    {
-        return false;
-    }
-    
-    // Parse basic struct info
-    FString Name;
-    
-    if (!JsonObject->TryGetStringField(TEXT("name"), Name))
-    {
-        FN2CLogger::Get().LogError(TEXT("Missing required struct fields in JSON"));
-        return false;
-    }
-    
-    OutStruct.Name = Name;
-    
-    // Parse optional comment
-    FString Comment;
-    if (JsonObject->TryGetStringField(TEXT("comment"), Comment))
-    {
-        OutStruct.Comment = Comment;
-    }
-    
-    // Parse members array
-    const TArray<TSharedPtr<FJsonValue>>* MembersArray;
-    if (!JsonObject->TryGetArrayField(TEXT("members"), MembersArray))
-    {
-        FN2CLogger::Get().LogError(TEXT("Missing members array in JSON"));
-        return false;
-    }
-    
-    OutStruct.Members.Empty();
-    for (const TSharedPtr<FJsonValue>& MemberValue : *MembersArray)
+    bool bHasName = false;
+    bool bHasClass = false;
+
+    EJsonNotation Notation;
+    while (ReadToken(Reader, Notation) && Notation != EJsonNotation::ObjectEnd)
     {
-        const TSharedPtr<FJsonObject>& MemberObject = MemberValue->AsObject();
-        if (!MemberObject.IsValid())
+        const FString& Field = Reader.GetIdentifier();
+        bool bRead = true;
+
+        if (Notation == EJsonNotation::String && Field == TEXT("component_name"))
         {
-            continue;
+            OutComponent.ComponentName = Reader.GetValueAsString();
+            bHasName = true;
         }
-        
-        FN2CStructMember Member;
-        
-        // Parse member properties
-        FString MemberName, TypeString, TypeName;
-        
-        if (!MemberObject->TryGetStringField(TEXT("name"), MemberName) ||
-            !MemberObject->TryGetStringField(TEXT("type"), TypeString))
+        else if (Notation == EJsonNotation::String && Field == TEXT("component_class_name"))
         {
-            FN2CLogger::Get().LogError(TEXT("Missing required member fields in JSON"));
-            continue;
+            OutComponent.ComponentClassName = Reader.GetValueAsString();
+            bHasClass = true;
         }
-        
-        Member.Name = MemberName;
-        
-        // Convert type string to enum
-        int64 TypeValue = StaticEnum<EN2CStructMemberType>()->GetValueByNameString(TypeString, EGetByNameFlags::None);
-        if (TypeValue == INDEX_NONE)
+        else if (Notation == EJsonNotation::String && Field == TEXT("attach_parent_name"))
         {
-            FN2CLogger::Get().LogError(FString::Printf(TEXT("Invalid member type: %s"), *TypeString));
-            continue;
+            OutComponent.AttachParentName = Reader.GetValueAsString();
         }
-        Member.Type = static_cast<EN2CStructMemberType>(TypeValue);
-        
-        // Parse optional fields
-        MemberObject->TryGetStringField(TEXT("type_name"), Member.TypeName);
-        MemberObject->TryGetBoolField(TEXT("is_array"), Member.bIsArray);
-        MemberObject->TryGetBoolField(TEXT("is_set"), Member.bIsSet);
-        MemberObject->TryGetBoolField(TEXT("is_map"), Member.bIsMap);
-        
-        if (Member.bIsMap)
-        {
-            FString KeyTypeString;
-            if (MemberObject->TryGetStringField(TEXT("key_type"), KeyTypeString))
-            {
-                int64 KeyTypeValue = StaticEnum<EN2CStructMemberType>()->GetValueByNameString(KeyTypeString, EGetByNameFlags::None);
-                if (KeyTypeValue != INDEX_NONE)
+        else if (Notation == EJsonNotation::ArrayStart && Field == TEXT("overridden_properties"))
+        {
+            int32 InvalidCount = 0;
+            bRead = ReadObjectArray(Reader, InvalidCount, [&Reader, &OutComponent]()
+            {
+                FN2CVariable Var;
+                if (!ReadVariable(Reader, Var))
                 {
-                    Member.KeyType = static_cast<EN2CStructMemberType>(KeyTypeValue);
+                    return false;
                 }
-            }
-            
-            MemberObject->TryGetStringField(TEXT("key_type_name"), Member.KeyTypeName);
+                OutComponent.OverriddenProperties.Add(MoveTemp(Var));
+                return true;
+            });
+        }
+        else
+        {
+            bRead = SkipValue(Reader, Notation);
         }
-        
-        MemberObject->TryGetStringField(TEXT("default_value"), Member.DefaultValue);
-        MemberObject->TryGetStringField(TEXT("comment"), Member.Comment);
-        
-        OutStruct.Members.Add(Member);
-    }
-    
-    return true;
-}
 
-bool FN2CSerializer::ParseEnumFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CEnum& OutEnum)
-{
-    if (!JsonObject.IsValid())
-    {
-        return false;
+        if (!bRead)
+        {
+            return false;
+        }
     }
-    
-    // Parse basic enum info
-    FString Name;
-    
-    if (!JsonObject->TryGetStringField(TEXT("name"), Name))
+
+    if (Notation != EJsonNotation::ObjectEnd)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing required enum fields in JSON"));
         return false;
     }
-    
-    OutEnum.Name = Name;
-    
-    // Parse optional comment
-    FString Comment;
-    if (JsonObject->TryGetStringField(TEXT("comment"), Comment))
-    {
-        OutEnum.Comment = Comment;
-    }
-    
-    // Parse values array
-    const TArray<TSharedPtr<FJsonValue>>* ValuesArray;
-    if (!JsonObject->TryGetArrayField(TEXT("values"), ValuesArray))
+
+    if (!bHasName || !bHasClass)
     {
-        FN2CLogger::Get().LogError(TEXT("Missing values array in JSON"));
+        FN2CLogger::Get().LogError(TEXT("Missing required component fields in JSON"));
         return false;
     }
-    
-    OutEnum.Values.Empty();
-    for (const TSharedPtr<FJsonValue>& ValueValue : *ValuesArray)
-    {
-        const TSharedPtr<FJsonObject>& ValueObject = ValueValue->AsObject();
-        if (!ValueObject.IsValid())
-        {
-            continue;
-        }
-        
-        FN2CEnumValue Value;
-        
-        // Parse value properties
-        FString ValueName;
-        double ValueNumber;
-        
-        if (!ValueObject->TryGetStringField(TEXT("name"), ValueName) ||
-            !ValueObject->TryGetNumberField(TEXT("value"), ValueNumber))
-        {
-            FN2CLogger::Get().LogError(TEXT("Missing required enum value fields in JSON"));
-            continue;
-        }
-        
-        Value.Name = ValueName;
-        
-        // Parse optional comment
-        FString ValueComment;
-        if (ValueObject->TryGetStringField(TEXT("comment"), ValueComment))
-        {
-            Value.Comment = ValueComment;
-        }
-        
-        OutEnum.Values.Add(Value);
-    }
-    
+
     return true;
 }
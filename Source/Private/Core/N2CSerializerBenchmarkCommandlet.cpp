@@ -0,0 +1,301 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CSerializerBenchmarkCommandlet.h"
+
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSnapshot.h"
+#include "Models/N2CBlueprint.h"
+#include "Utils/N2CLogger.h"
+#include "HAL/PlatformMemory.h"
+#include "Math/RandomStream.h"
+
+/** Largest generated graph, bigger Blueprints are split across several graphs */
+static constexpr int32 NodesPerGraph = 500;
+
+/** Longest generated execution chain, real graphs break chains at branches and events */
+static constexpr int32 NodesPerExecutionChain = 8;
+
+namespace
+{
+    FN2CPinDefinition MakePin(int32 Index, const TCHAR* Name, EN2CPinType Type, const TCHAR* SubType = TEXT(""), const TCHAR* DefaultValue = TEXT(""))
+    {
+        FN2CPinDefinition Pin;
+        Pin.ID = FString::Printf(TEXT("P%d"), Index);
+        Pin.Name = Name;
+        Pin.Type = Type;
+        Pin.SubType = SubType;
+        Pin.DefaultValue = DefaultValue;
+        return Pin;
+    }
+}
+
+UN2CSerializerBenchmarkCommandlet::UN2CSerializerBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UN2CSerializerBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    TArray<int32> NodeCounts;
+    if (const FString* NodesParam = ParamVals.Find(TEXT("Nodes")))
+    {
+        TArray<FString> Counts;
+        NodesParam->ParseIntoArray(Counts, TEXT("+"));
+        for (const FString& Count : Counts)
+        {
+            NodeCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+        }
+    }
+    if (NodeCounts.Num() == 0)
+    {
+        NodeCounts = { 100, 1000, 10000, 50000 };
+    }
+
+    int32 Iterations = 5;
+    if (const FString* IterationsParam = ParamVals.Find(TEXT("Iterations")))
+    {
+        Iterations = FMath::Max(1, FCString::Atoi(**IterationsParam));
+    }
+
+    int32 Seed = 1;
+    if (const FString* SeedParam = ParamVals.Find(TEXT("Seed")))
+    {
+        Seed = FCString::Atoi(**SeedParam);
+    }
+
+    for (const int32 NodeCount : NodeCounts)
+    {
+        FN2CBlueprint Blueprint;
+        GenerateBlueprint(NodeCount, Seed, Blueprint);
+
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("%d nodes in %d graphs, %d iterations"), NodeCount, Blueprint.Graphs.Num(), Iterations),
+            EN2CLogSeverity::Info, TEXT("Benchmark"));
+
+        FN2CJsonOptions CondensedOptions;
+        CondensedOptions.bPrettyPrint = false;
+
+        const FString PrettyJson = FN2CSerializer::ToJson(Blueprint);
+        const FString CondensedJson = FN2CSerializer::ToJson(Blueprint, CondensedOptions);
+        TArray<uint8> SnapshotBytes;
+        FN2CSnapshot::SaveToMemory(Blueprint, SnapshotBytes);
+
+        RunOperation(TEXT("ToJson (pretty)"), NodeCount, Iterations, [&Blueprint]()
+        {
+            return static_cast<int64>(FN2CSerializer::ToJson(Blueprint).Len() * sizeof(TCHAR));
+        });
+
+        RunOperation(TEXT("ToJson (condensed)"), NodeCount, Iterations, [&Blueprint, &CondensedOptions]()
+        {
+            return static_cast<int64>(FN2CSerializer::ToJson(Blueprint, CondensedOptions).Len() * sizeof(TCHAR));
+        });
+
+        RunOperation(TEXT("ToJson (compact dialect)"), NodeCount, Iterations, [&Blueprint]()
+        {
+            return static_cast<int64>(FN2CSerializer::ToCondensedJson(Blueprint, EN2CJsonDialect::Compact).Len() * sizeof(TCHAR));
+        });
+
+        RunOperation(TEXT("FromJson"), NodeCount, Iterations, [&PrettyJson]()
+        {
+            FN2CBlueprint Parsed;
+            FN2CSerializer::FromJson(PrettyJson, Parsed);
+            return static_cast<int64>(PrettyJson.Len() * sizeof(TCHAR));
+        });
+
+        RunOperation(TEXT("IsValid"), NodeCount, Iterations, [&Blueprint]()
+        {
+            Blueprint.IsValid();
+            return static_cast<int64>(0);
+        });
+
+        RunOperation(TEXT("Snapshot save"), NodeCount, Iterations, [&Blueprint]()
+        {
+            TArray<uint8> Bytes;
+            FN2CSnapshot::SaveToMemory(Blueprint, Bytes);
+            return static_cast<int64>(Bytes.Num());
+        });
+
+        RunOperation(TEXT("Snapshot load"), NodeCount, Iterations, [&SnapshotBytes]()
+        {
+            FN2CBlueprint Loaded;
+            FN2CSnapshot::LoadFromMemory(SnapshotBytes, Loaded);
+            return static_cast<int64>(SnapshotBytes.Num());
+        });
+
+        // Round trips must reproduce the same output, otherwise the timings above measure broken code
+        FN2CBlueprint Parsed;
+        FN2CBlueprint Loaded;
+        if (!FN2CSerializer::FromJson(CondensedJson, Parsed) || FN2CSerializer::ToJson(Parsed, CondensedOptions) != CondensedJson
+            || !FN2CSnapshot::LoadFromMemory(SnapshotBytes, Loaded) || FN2CSerializer::ToJson(Loaded, CondensedOptions) != CondensedJson)
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Round trip mismatch at %d nodes"), NodeCount), TEXT("Benchmark"));
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void UN2CSerializerBenchmarkCommandlet::GenerateBlueprint(int32 NodeCount, int32 Seed, FN2CBlueprint& OutBlueprint)
+{
+    FRandomStream Random(Seed);
+
+    OutBlueprint = FN2CBlueprint();
+    OutBlueprint.Metadata.Name = FString::Printf(TEXT("BP_Benchmark_%d"), NodeCount);
+    OutBlueprint.Metadata.BlueprintClass = OutBlueprint.Metadata.Name + TEXT("_C");
+
+    for (int32 Index = 0; Index < 16; ++Index)
+    {
+        FN2CVariable& Var = OutBlueprint.Variables.AddDefaulted_GetRef();
+        Var.Name = FString::Printf(TEXT("Variable%d"), Index);
+        Var.Type = EN2CStructMemberType::Float;
+        Var.DefaultValue = TEXT("0.0");
+    }
+
+    for (int32 FirstNode = 0; FirstNode < NodeCount; FirstNode += NodesPerGraph)
+    {
+        FN2CGraph& Graph = OutBlueprint.Graphs.AddDefaulted_GetRef();
+        Graph.Name = FString::Printf(TEXT("Graph%d"), OutBlueprint.Graphs.Num());
+        Graph.GraphType = OutBlueprint.Graphs.Num() == 1 ? EN2CGraphType::EventGraph : EN2CGraphType::Function;
+
+        const int32 GraphNodes = FMath::Min(NodesPerGraph, NodeCount - FirstNode);
+        Graph.Nodes.Reserve(GraphNodes);
+
+        // Exec-connected nodes in order, and value outputs not yet linked to an input
+        TArray<int32> ExecNodes;
+        TArray<TPair<int32, int32>> OpenOutputs;
+
+        for (int32 NodeIndex = 0; NodeIndex < GraphNodes; ++NodeIndex)
+        {
+            FN2CNodeDefinition& Node = Graph.Nodes.AddDefaulted_GetRef();
+            Node.ID = FString::Printf(TEXT("N%d"), NodeIndex + 1);
+
+            // Mostly function calls, fed by pure variable reads and math nodes
+            const float Roll = NodeIndex == 0 ? -1.0f : Random.FRand();
+            if (Roll < 0.0f)
+            {
+                Node.NodeType = EN2CNodeType::Event;
+                Node.Name = TEXT("Event BeginPlay");
+                Node.OutputPins.Add(MakePin(1, TEXT("Then"), EN2CPinType::Exec));
+            }
+            else if (Roll < 0.25f)
+            {
+                Node.NodeType = EN2CNodeType::VariableGet;
+                Node.Name = FString::Printf(TEXT("Get Variable%d"), Random.RandHelper(16));
+                Node.MemberName = Node.Name.RightChop(4);
+                Node.bPure = true;
+                Node.OutputPins.Add(MakePin(1, TEXT("Value"), EN2CPinType::Float));
+            }
+            else if (Roll < 0.4f)
+            {
+                Node.NodeType = EN2CNodeType::CallFunction;
+                Node.Name = TEXT("Multiply");
+                Node.MemberParent = TEXT("KismetMathLibrary");
+                Node.MemberName = TEXT("Multiply_DoubleDouble");
+                Node.bPure = true;
+                Node.InputPins.Add(MakePin(1, TEXT("A"), EN2CPinType::Float, TEXT(""), TEXT("0.0")));
+                Node.InputPins.Add(MakePin(2, TEXT("B"), EN2CPinType::Float, TEXT(""), TEXT("1.0")));
+                Node.OutputPins.Add(MakePin(3, TEXT("Return Value"), EN2CPinType::Float));
+            }
+            else if (Roll < 0.5f)
+            {
+                Node.NodeType = EN2CNodeType::VariableSet;
+                Node.Name = FString::Printf(TEXT("Set Variable%d"), Random.RandHelper(16));
+                Node.MemberName = Node.Name.RightChop(4);
+                Node.InputPins.Add(MakePin(1, TEXT("Execute"), EN2CPinType::Exec));
+                Node.InputPins.Add(MakePin(2, TEXT("Value"), EN2CPinType::Float, TEXT(""), TEXT("0.0")));
+                Node.OutputPins.Add(MakePin(3, TEXT("Then"), EN2CPinType::Exec));
+                Node.OutputPins.Add(MakePin(4, TEXT("Output_Get"), EN2CPinType::Float));
+            }
+            else
+            {
+                Node.NodeType = EN2CNodeType::CallFunction;
+                Node.Name = TEXT("Set Actor Location");
+                Node.MemberParent = TEXT("Actor");
+                Node.MemberName = TEXT("K2_SetActorLocation");
+                Node.Comment = Random.FRand() < 0.1f ? TEXT("Move the actor into place") : TEXT("");
+                Node.InputPins.Add(MakePin(1, TEXT("Execute"), EN2CPinType::Exec));
+                Node.InputPins.Add(MakePin(2, TEXT("Target"), EN2CPinType::Object, TEXT("Actor"), TEXT("self")));
+                Node.InputPins.Add(MakePin(3, TEXT("New Location"), EN2CPinType::Struct, TEXT("Vector"), TEXT("0, 0, 0")));
+                Node.InputPins.Add(MakePin(4, TEXT("Sweep"), EN2CPinType::Boolean, TEXT(""), TEXT("false")));
+                Node.OutputPins.Add(MakePin(5, TEXT("Then"), EN2CPinType::Exec));
+                Node.OutputPins.Add(MakePin(6, TEXT("Return Value"), EN2CPinType::Boolean));
+            }
+
+            // Link earlier value outputs into this node's value inputs
+            for (int32 PinIndex = 0; PinIndex < Node.InputPins.Num(); ++PinIndex)
+            {
+                FN2CPinDefinition& Pin = Node.InputPins[PinIndex];
+                if (Pin.Type != EN2CPinType::Exec && OpenOutputs.Num() > 0 && Random.FRand() < 0.7f)
+                {
+                    const int32 OutputIndex = Random.RandHelper(OpenOutputs.Num());
+                    Graph.Flows.Data.Emplace(OpenOutputs[OutputIndex].Key, OpenOutputs[OutputIndex].Value, NodeIndex, PinIndex);
+                    OpenOutputs.RemoveAtSwap(OutputIndex);
+                    Pin.bConnected = true;
+                }
+            }
+
+            for (int32 PinIndex = 0; PinIndex < Node.OutputPins.Num(); ++PinIndex)
+            {
+                FN2CPinDefinition& Pin = Node.OutputPins[PinIndex];
+                if (Pin.Type == EN2CPinType::Exec)
+                {
+                    Pin.bConnected = true;
+                }
+                else
+                {
+                    OpenOutputs.Emplace(NodeIndex, Node.InputPins.Num() + PinIndex);
+                }
+            }
+
+            if (!Node.bPure)
+            {
+                ExecNodes.Add(NodeIndex);
+            }
+        }
+
+        // Chains share their boundary node, like the translator's output for long sequences
+        for (int32 ChainStart = 0; ChainStart + 1 < ExecNodes.Num(); ChainStart += NodesPerExecutionChain - 1)
+        {
+            const int32 ChainEnd = FMath::Min(ChainStart + NodesPerExecutionChain, ExecNodes.Num());
+            Graph.Flows.AddExecutionChain(TConstArrayView<int32>(ExecNodes).Slice(ChainStart, ChainEnd - ChainStart));
+        }
+    }
+}
+
+void UN2CSerializerBenchmarkCommandlet::RunOperation(const TCHAR* Label, int32 NodeCount, int32 Iterations, TFunctionRef<int64()> Operation)
+{
+    TArray<double> Seconds;
+    Seconds.Reserve(Iterations);
+
+    int64 OutputBytes = 0;
+    const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+    uint64 PeakUsed = UsedBefore;
+
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        const double Start = FPlatformTime::Seconds();
+        OutputBytes = Operation();
+        Seconds.Add(FPlatformTime::Seconds() - Start);
+
+        PeakUsed = FMath::Max(PeakUsed, FPlatformMemory::GetStats().UsedPhysical);
+    }
+
+    Seconds.Sort();
+    const double Median = Seconds[Seconds.Num() / 2];
+
+    // Process-wide memory, so this is an upper bound on what the operation itself keeps alive
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("  %-26s %10.1f ns/node  %9.2f ms  mem +%8.1f KB  output %10lld bytes"),
+            Label, Median * 1e9 / NodeCount, Median * 1e3,
+            static_cast<double>(PeakUsed - UsedBefore) / 1024.0, OutputBytes),
+        EN2CLogSeverity::Info, TEXT("Benchmark"));
+}
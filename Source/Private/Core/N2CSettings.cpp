@@ -7,7 +7,9 @@
 #include "PropertyEditorModule.h"
 #include "IDetailsView.h"
 #include "LLM/N2CLLMModels.h"
+#include "LLM/N2CPromptFileCache.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CTelemetry.h"
 
 #if PLATFORM_WINDOWS
 #include "Windows/WindowsPlatformApplicationMisc.h"
@@ -26,13 +28,16 @@ UN2CSettings::UN2CSettings()
     // Initialize pricing for each model
     InitializePricing();
 
+    // Initialize request scheduling limits for each provider
+    InitializeRequestLimits();
+
     // Validate reference source paths on startup
     ValidateReferenceSourcePaths();
     
     if (!UserSecrets)
     {
+        // The secrets object reads the file when it is created
         UserSecrets = NewObject<UN2CUserSecrets>();
-        UserSecrets->LoadSecrets();
         
         FN2CLogger::Get().Log(
             FString::Printf(TEXT("Loaded user secrets from: %s"), *UN2CUserSecrets::GetSecretsFilePath()),
@@ -44,6 +49,7 @@ UN2CSettings::UN2CSettings()
     Anthropic_API_Key_UI = UserSecrets->Anthropic_API_Key;
     Gemini_API_Key_UI = UserSecrets->Gemini_API_Key;
     DeepSeek_API_Key_UI = UserSecrets->DeepSeek_API_Key;
+    OpenAICompatible_API_Key_UI = UserSecrets->OpenAICompatible_API_Key;
     
     // Initialize token estimate
     EstimatedReferenceTokens = GetReferenceFilesTokenEstimate();
@@ -61,35 +67,51 @@ FText UN2CSettings::GetSectionText() const
     return LOCTEXT("SettingsSection", "Node to Code");
 }
 
-FString UN2CSettings::GetActiveApiKey() const
+UN2CUserSecrets* UN2CSettings::GetUserSecrets() const
 {
     if (!UserSecrets)
     {
-        // Create and load secrets if not already done
         UserSecrets = NewObject<UN2CUserSecrets>();
-        UserSecrets->LoadSecrets();
     }
+    UserSecrets->EnsureLoaded();
+    return UserSecrets;
+}
 
-    switch (Provider)
+void UN2CSettings::FlushUserSecrets() const
+{
+    if (UserSecrets)
+    {
+        UserSecrets->FlushPendingSave();
+    }
+}
+
+FString UN2CSettings::GetApiKey(EN2CLLMProvider InProvider) const
+{
+    // Keys are held in memory; the file is only read again after it changed on disk
+    UN2CUserSecrets* Secrets = GetUserSecrets();
+
+    switch (InProvider)
     {
         case EN2CLLMProvider::OpenAI:
-            return UserSecrets->OpenAI_API_Key;
+            return Secrets->OpenAI_API_Key;
         case EN2CLLMProvider::Anthropic:
-            return UserSecrets->Anthropic_API_Key;
+            return Secrets->Anthropic_API_Key;
         case EN2CLLMProvider::Gemini:
-            return UserSecrets->Gemini_API_Key;
+            return Secrets->Gemini_API_Key;
         case EN2CLLMProvider::DeepSeek:
-            return UserSecrets->DeepSeek_API_Key;
+            return Secrets->DeepSeek_API_Key;
         case EN2CLLMProvider::LMStudio:
             return "lm-studio"; // LM Studio just requires a dummy API key for its OpenAI endpoint
+        case EN2CLLMProvider::OpenAICompatible:
+            return Secrets->OpenAICompatible_API_Key; // Servers started without --api-key need none
         default:
             return FString();
     }
 }
 
-FString UN2CSettings::GetActiveModel() const
+FString UN2CSettings::GetModel(EN2CLLMProvider InProvider) const
 {
-    switch (Provider)
+    switch (InProvider)
     {
         case EN2CLLMProvider::OpenAI:
             return FN2CLLMModelUtils::GetOpenAIModelValue(OpenAI_Model);
@@ -103,11 +125,87 @@ FString UN2CSettings::GetActiveModel() const
             return OllamaModel;
         case EN2CLLMProvider::LMStudio:
             return LMStudioModel;
+        case EN2CLLMProvider::OpenAICompatible:
+            return OpenAICompatibleModel;
         default:
             return FString();
     }
 }
 
+float UN2CSettings::GetInputCost(EN2CLLMProvider InProvider) const
+{
+    switch (InProvider)
+    {
+        case EN2CLLMProvider::OpenAI:
+            if (const FN2COpenAIPricing* Pricing = OpenAIModelPricing.Find(OpenAI_Model))
+            {
+                return Pricing->InputCost;
+            }
+            return FN2CLLMModelUtils::GetOpenAIPricing(OpenAI_Model).InputCost;
+        case EN2CLLMProvider::Anthropic:
+            if (const FN2CAnthropicPricing* Pricing = AnthropicModelPricing.Find(AnthropicModel))
+            {
+                return Pricing->InputCost;
+            }
+            return FN2CLLMModelUtils::GetAnthropicPricing(AnthropicModel).InputCost;
+        case EN2CLLMProvider::Gemini:
+            if (const FN2CGeminiPricing* Pricing = GeminiModelPricing.Find(Gemini_Model))
+            {
+                return Pricing->InputCost;
+            }
+            return FN2CLLMModelUtils::GetGeminiPricing(Gemini_Model).InputCost;
+        case EN2CLLMProvider::DeepSeek:
+            if (const FN2CDeepSeekPricing* Pricing = DeepSeekModelPricing.Find(DeepSeekModel))
+            {
+                return Pricing->InputCost;
+            }
+            return FN2CLLMModelUtils::GetDeepSeekPricing(DeepSeekModel).InputCost;
+        case EN2CLLMProvider::Ollama:
+        case EN2CLLMProvider::LMStudio:
+        case EN2CLLMProvider::OpenAICompatible:
+            return 0.0f; // Local models are free
+        default:
+            return 0.0f;
+    }
+}
+
+float UN2CSettings::GetOutputCost(EN2CLLMProvider InProvider) const
+{
+    switch (InProvider)
+    {
+        case EN2CLLMProvider::OpenAI:
+            if (const FN2COpenAIPricing* Pricing = OpenAIModelPricing.Find(OpenAI_Model))
+            {
+                return Pricing->OutputCost;
+            }
+            return FN2CLLMModelUtils::GetOpenAIPricing(OpenAI_Model).OutputCost;
+        case EN2CLLMProvider::Anthropic:
+            if (const FN2CAnthropicPricing* Pricing = AnthropicModelPricing.Find(AnthropicModel))
+            {
+                return Pricing->OutputCost;
+            }
+            return FN2CLLMModelUtils::GetAnthropicPricing(AnthropicModel).OutputCost;
+        case EN2CLLMProvider::Gemini:
+            if (const FN2CGeminiPricing* Pricing = GeminiModelPricing.Find(Gemini_Model))
+            {
+                return Pricing->OutputCost;
+            }
+            return FN2CLLMModelUtils::GetGeminiPricing(Gemini_Model).OutputCost;
+        case EN2CLLMProvider::DeepSeek:
+            if (const FN2CDeepSeekPricing* Pricing = DeepSeekModelPricing.Find(DeepSeekModel))
+            {
+                return Pricing->OutputCost;
+            }
+            return FN2CLLMModelUtils::GetDeepSeekPricing(DeepSeekModel).OutputCost;
+        case EN2CLLMProvider::Ollama:
+        case EN2CLLMProvider::LMStudio:
+        case EN2CLLMProvider::OpenAICompatible:
+            return 0.0f; // Local models are free
+        default:
+            return 0.0f;
+    }
+}
+
 void UN2CSettings::PreEditChange(FProperty* PropertyAboutToChange)
 {
     Super::PreEditChange(PropertyAboutToChange);
@@ -180,6 +278,54 @@ void UN2CSettings::InitializePricing()
     DeepSeekModelPricing.Add(EN2CDeepSeekModel::DeepSeek_V3, FN2CDeepSeekPricing(0.14f, 0.28f));
 }
 
+void UN2CSettings::InitializeRequestLimits()
+{
+    // Cloud providers tolerate a few parallel requests; local servers generally process one at a time
+    ProviderRequestLimits.Add(EN2CLLMProvider::OpenAI, FN2CProviderRequestLimits(4, 60.0f, 4));
+    ProviderRequestLimits.Add(EN2CLLMProvider::Anthropic, FN2CProviderRequestLimits(4, 50.0f, 4));
+    ProviderRequestLimits.Add(EN2CLLMProvider::Gemini, FN2CProviderRequestLimits(4, 60.0f, 4));
+    ProviderRequestLimits.Add(EN2CLLMProvider::DeepSeek, FN2CProviderRequestLimits(4, 60.0f, 4));
+    ProviderRequestLimits.Add(EN2CLLMProvider::Ollama, FN2CProviderRequestLimits(1, 0.0f, 1));
+    ProviderRequestLimits.Add(EN2CLLMProvider::LMStudio, FN2CProviderRequestLimits(1, 0.0f, 1));
+
+    // Servers with continuous batching gain throughput from many requests in flight
+    ProviderRequestLimits.Add(EN2CLLMProvider::OpenAICompatible, FN2CProviderRequestLimits(32, 0.0f, 32));
+}
+
+FN2CProviderRequestLimits UN2CSettings::GetProviderRequestLimits(EN2CLLMProvider InProvider) const
+{
+    if (const FN2CProviderRequestLimits* Limits = ProviderRequestLimits.Find(InProvider))
+    {
+        return *Limits;
+    }
+    return FN2CProviderRequestLimits();
+}
+
+TArray<EN2CCodeLanguage> UN2CSettings::GetTargetLanguages() const
+{
+    TArray<EN2CCodeLanguage> Languages;
+    Languages.Add(TargetLanguage);
+    for (const EN2CCodeLanguage Language : AdditionalTargetLanguages)
+    {
+        Languages.AddUnique(Language);
+    }
+    return Languages;
+}
+
+int32 UN2CSettings::GetReferenceFilesTokenEstimate() const
+{
+    // Shares the prompt file cache, so estimating does not read files the requests already hold
+    int32 TotalTokens = 0;
+    for (const FFilePath& Path : ReferenceSourceFilePaths)
+    {
+        if (const TSharedPtr<const FString> Content = FN2CPromptFileCache::Get().LoadShared(Path.FilePath))
+        {
+            TotalTokens += FN2CTokenEstimator::EstimateTokens(*Content, Provider);
+        }
+    }
+    return TotalTokens;
+}
+
 void UN2CSettings::ValidateReferenceSourcePaths()
 {
     TArray<FFilePath> ValidPaths;
@@ -227,46 +373,32 @@ void UN2CSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
         // Handle API key changes
         if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, OpenAI_API_Key_UI))
         {
-            if (!UserSecrets)
-            {
-                UserSecrets = NewObject<UN2CUserSecrets>();
-                UserSecrets->LoadSecrets();
-            }
-            UserSecrets->OpenAI_API_Key = OpenAI_API_Key_UI;
-            UserSecrets->SaveSecrets();
+            GetUserSecrets()->OpenAI_API_Key = OpenAI_API_Key_UI;
+            UserSecrets->SaveSecretsDeferred();
             return;
         }
         if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, Anthropic_API_Key_UI))
         {
-            if (!UserSecrets)
-            {
-                UserSecrets = NewObject<UN2CUserSecrets>();
-                UserSecrets->LoadSecrets();
-            }
-            UserSecrets->Anthropic_API_Key = Anthropic_API_Key_UI;
-            UserSecrets->SaveSecrets();
+            GetUserSecrets()->Anthropic_API_Key = Anthropic_API_Key_UI;
+            UserSecrets->SaveSecretsDeferred();
             return;
         }
         if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, Gemini_API_Key_UI))
         {
-            if (!UserSecrets)
-            {
-                UserSecrets = NewObject<UN2CUserSecrets>();
-                UserSecrets->LoadSecrets();
-            }
-            UserSecrets->Gemini_API_Key = Gemini_API_Key_UI;
-            UserSecrets->SaveSecrets();
+            GetUserSecrets()->Gemini_API_Key = Gemini_API_Key_UI;
+            UserSecrets->SaveSecretsDeferred();
             return;
         }
         if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, DeepSeek_API_Key_UI))
         {
-            if (!UserSecrets)
-            {
-                UserSecrets = NewObject<UN2CUserSecrets>();
-                UserSecrets->LoadSecrets();
-            }
-            UserSecrets->DeepSeek_API_Key = DeepSeek_API_Key_UI;
-            UserSecrets->SaveSecrets();
+            GetUserSecrets()->DeepSeek_API_Key = DeepSeek_API_Key_UI;
+            UserSecrets->SaveSecretsDeferred();
+            return;
+        }
+        if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, OpenAICompatible_API_Key_UI))
+        {
+            GetUserSecrets()->OpenAICompatible_API_Key = OpenAICompatible_API_Key_UI;
+            UserSecrets->SaveSecretsDeferred();
             return;
         }
 
@@ -276,11 +408,25 @@ void UN2CSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChanged
             FN2CLogger::Get().SetMinSeverity(MinSeverity);
         }
 
+        if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, bArchiveEvictedLogs))
+        {
+            FN2CLogger::Get().EnableArchive(bArchiveEvictedLogs);
+        }
+
+        if (PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, bExportTelemetry)
+            || PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, TelemetryIntervalSeconds))
+        {
+            FN2CTelemetry::Get().ApplySettings();
+        }
+
         // Check for both array changes and changes to FilePath within the struct                                                                                                                         
         const bool bIsFilePathChange = PropertyName == GET_MEMBER_NAME_CHECKED(FFilePath, FilePath);                                                                                              
         const bool bIsArrayChange = PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, ReferenceSourceFilePaths);
 
-        if (bIsFilePathChange || bIsArrayChange)
+        // Estimates depend on the provider's tokenizer
+        const bool bIsProviderChange = PropertyName == GET_MEMBER_NAME_CHECKED(UN2CSettings, Provider);
+
+        if (bIsFilePathChange || bIsArrayChange || bIsProviderChange)
         {
             EstimatedReferenceTokens = GetReferenceFilesTokenEstimate();
             FN2CLogger::Get().Log(
@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CSnapshot.h"
+#include "Utils/N2CLogger.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Memory/MemoryView.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** "N2CS" */
+    constexpr uint32 SnapshotMagic = 0x5343324E;
+
+    /** Bump whenever the layout written by FN2CSnapshot::Serialize changes */
+    constexpr uint32 SnapshotVersion = 2;
+}
+
+void FN2CSnapshot::SaveToMemory(const FN2CBlueprint& Blueprint, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes, true);
+
+    uint32 Magic = SnapshotMagic;
+    uint32 Version = SnapshotVersion;
+    Writer << Magic;
+    Writer << Version;
+
+    // Serialize is bidirectional, so it takes a mutable reference even when only saving
+    Serialize(Writer, const_cast<FN2CBlueprint&>(Blueprint));
+}
+
+bool FN2CSnapshot::LoadFromMemory(TConstArrayView<uint8> Bytes, FN2CBlueprint& OutBlueprint)
+{
+    FMemoryReaderView Reader(FMemoryView(Bytes.GetData(), Bytes.Num()), true);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    Reader << Magic;
+    Reader << Version;
+
+    if (Reader.IsError() || Magic != SnapshotMagic)
+    {
+        FN2CLogger::Get().LogError(TEXT("Not a Node to Code snapshot"), TEXT("Snapshot"));
+        return false;
+    }
+    if (Version != SnapshotVersion)
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Unsupported snapshot version %u (expected %u)"), Version, SnapshotVersion), TEXT("Snapshot"));
+        return false;
+    }
+
+    OutBlueprint = FN2CBlueprint();
+    Serialize(Reader, OutBlueprint);
+
+    if (Reader.IsError())
+    {
+        FN2CLogger::Get().LogError(TEXT("Snapshot is truncated or corrupt"), TEXT("Snapshot"));
+        OutBlueprint = FN2CBlueprint();
+        return false;
+    }
+
+    return true;
+}
+
+bool FN2CSnapshot::SaveToFile(const FN2CBlueprint& Blueprint, const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    SaveToMemory(Blueprint, Bytes);
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to save snapshot: %s"), *FilePath), TEXT("Snapshot"));
+        return false;
+    }
+
+    return true;
+}
+
+bool FN2CSnapshot::LoadFromFile(const FString& FilePath, FN2CBlueprint& OutBlueprint)
+{
+    // Read straight from a mapping of the file when the platform allows it, so nothing is copied up front
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+    if (MappedFile.IsValid() && MappedFile->GetFileSize() > 0)
+    {
+        TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (Region.IsValid())
+        {
+            return LoadFromMemory(TConstArrayView<uint8>(Region->GetMappedPtr(), Region->GetMappedSize()), OutBlueprint);
+        }
+    }
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to read snapshot: %s"), *FilePath), TEXT("Snapshot"));
+        return false;
+    }
+
+    return LoadFromMemory(Bytes, OutBlueprint);
+}
+
+template <typename ElementType>
+void FN2CSnapshot::SerializeArray(FArchive& Ar, TArray<ElementType>& Array)
+{
+    int32 Num = Array.Num();
+    Ar << Num;
+
+    if (Ar.IsLoading())
+    {
+        // Every element takes at least one byte, so a larger count can only come from corrupt input
+        if (Num < 0 || Num > Ar.TotalSize() - Ar.Tell())
+        {
+            Ar.SetError();
+            return;
+        }
+
+        Array.Reset();
+        Array.SetNum(Num);
+    }
+
+    for (ElementType& Element : Array)
+    {
+        Serialize(Ar, Element);
+        if (Ar.IsError())
+        {
+            return;
+        }
+    }
+}
+
+template <typename EnumType>
+void FN2CSnapshot::SerializeEnum(FArchive& Ar, EnumType& Value)
+{
+    uint8 Byte = static_cast<uint8>(Value);
+    Ar << Byte;
+    Value = static_cast<EnumType>(Byte);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CBlueprint& Blueprint)
+{
+    Ar << Blueprint.Version.Value;
+    Ar << Blueprint.Metadata.Name;
+    SerializeEnum(Ar, Blueprint.Metadata.BlueprintType);
+    Ar << Blueprint.Metadata.BlueprintClass;
+
+    SerializeArray(Ar, Blueprint.Graphs);
+    SerializeArray(Ar, Blueprint.Structs);
+    SerializeArray(Ar, Blueprint.Enums);
+    SerializeArray(Ar, Blueprint.Variables);
+    SerializeArray(Ar, Blueprint.Components);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CGraph& Graph)
+{
+    Ar << Graph.Name;
+    SerializeEnum(Ar, Graph.GraphType);
+    SerializeArray(Ar, Graph.Nodes);
+    Serialize(Ar, Graph.Flows);
+    SerializeArray(Ar, Graph.LocalVariables);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CNodeDefinition& Node)
+{
+    Ar << Node.ID;
+    SerializeEnum(Ar, Node.NodeType);
+    Ar << Node.Name;
+    Ar << Node.MemberParent;
+    Ar << Node.MemberName;
+    Ar << Node.Comment;
+
+    uint8 Flags = (Node.bPure ? 1 : 0) | (Node.bLatent ? 2 : 0);
+    Ar << Flags;
+    Node.bPure = (Flags & 1) != 0;
+    Node.bLatent = (Flags & 2) != 0;
+
+    SerializeArray(Ar, Node.InputPins);
+    SerializeArray(Ar, Node.OutputPins);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CPinDefinition& Pin)
+{
+    Ar << Pin.ID;
+    Ar << Pin.Name;
+    SerializeEnum(Ar, Pin.Type);
+    Ar << Pin.SubType;
+    Ar << Pin.DefaultValue;
+
+    uint8 Flags = (Pin.bConnected ? 1 << 0 : 0) | (Pin.bIsReference ? 1 << 1 : 0) | (Pin.bIsConst ? 1 << 2 : 0)
+        | (Pin.bIsArray ? 1 << 3 : 0) | (Pin.bIsMap ? 1 << 4 : 0) | (Pin.bIsSet ? 1 << 5 : 0);
+    Ar << Flags;
+    Pin.bConnected = (Flags & (1 << 0)) != 0;
+    Pin.bIsReference = (Flags & (1 << 1)) != 0;
+    Pin.bIsConst = (Flags & (1 << 2)) != 0;
+    Pin.bIsArray = (Flags & (1 << 3)) != 0;
+    Pin.bIsMap = (Flags & (1 << 4)) != 0;
+    Pin.bIsSet = (Flags & (1 << 5)) != 0;
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CFlows& Flows)
+{
+    Ar << Flows.ExecutionNodes;
+    Ar << Flows.ExecutionChainStarts;
+    SerializeArray(Ar, Flows.Data);
+
+    // Chain starts index ExecutionNodes directly, so a corrupt table must not get through
+    if (Ar.IsLoading())
+    {
+        int32 PreviousStart = 0;
+        for (const int32 Start : Flows.ExecutionChainStarts)
+        {
+            if (Start < PreviousStart || Start > Flows.ExecutionNodes.Num())
+            {
+                Ar.SetError();
+                return;
+            }
+            PreviousStart = Start;
+        }
+    }
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CDataFlow& Flow)
+{
+    Ar << Flow.SourceNode;
+    Ar << Flow.SourcePin;
+    Ar << Flow.TargetNode;
+    Ar << Flow.TargetPin;
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CStruct& Struct)
+{
+    Ar << Struct.Name;
+    Ar << Struct.Comment;
+    SerializeArray(Ar, Struct.Members);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CStructMember& Member)
+{
+    Ar << Member.Name;
+    SerializeEnum(Ar, Member.Type);
+    Ar << Member.TypeName;
+    Ar << Member.bIsArray;
+    Ar << Member.bIsSet;
+    Ar << Member.bIsMap;
+    SerializeEnum(Ar, Member.KeyType);
+    Ar << Member.KeyTypeName;
+    Ar << Member.DefaultValue;
+    Ar << Member.Comment;
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CEnum& Enum)
+{
+    Ar << Enum.Name;
+    Ar << Enum.Comment;
+    SerializeArray(Ar, Enum.Values);
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CEnumValue& Value)
+{
+    Ar << Value.Name;
+    Ar << Value.Comment;
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CVariable& Var)
+{
+    Ar << Var.Name;
+    SerializeEnum(Ar, Var.Type);
+    Ar << Var.TypeName;
+    Ar << Var.bIsArray;
+    Ar << Var.bIsSet;
+    Ar << Var.bIsMap;
+    SerializeEnum(Ar, Var.KeyType);
+    Ar << Var.KeyTypeName;
+    Ar << Var.DefaultValue;
+    Ar << Var.Comment;
+}
+
+void FN2CSnapshot::Serialize(FArchive& Ar, FN2CComponentOverride& Component)
+{
+    Ar << Component.ComponentName;
+    Ar << Component.ComponentClassName;
+    Ar << Component.AttachParentName;
+    SerializeArray(Ar, Component.OverriddenProperties);
+}
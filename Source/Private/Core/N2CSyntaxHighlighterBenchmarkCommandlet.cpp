@@ -0,0 +1,381 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CSyntaxHighlighterBenchmarkCommandlet.h"
+
+#include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
+#include "Code Editor/Syntax/N2CSyntaxDefinitionFactory.h"
+#include "Code Editor/Syntax/N2CSyntaxTokenizer.h"
+#include "Dom/JsonObject.h"
+#include "Framework/Text/SlateTextLayout.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Theme the runs are styled with; every theme resolves to the same kind of style */
+    const FName BenchmarkTheme(TEXT("Midnight Code"));
+
+    /** Stages faster or smaller than this in the baseline are too noisy to fail a run */
+    constexpr double MinComparedMilliseconds = 0.1;
+    constexpr double MinComparedKilobytes = 64.0;
+
+    struct FBenchmarkLanguage
+    {
+        EN2CCodeLanguage Language;
+        const TCHAR* Name;
+
+        /** One block of code, repeated with $ replaced by the block number until the file is long enough */
+        TArray<const TCHAR*> Block;
+    };
+
+    const TArray<FBenchmarkLanguage>& GetBenchmarkLanguages()
+    {
+        static const TArray<FBenchmarkLanguage> Languages = {
+            { EN2CCodeLanguage::Cpp, TEXT("Cpp"), {
+                TEXT("// Updates the movement state of actor $"),
+                TEXT("#include \"Generated/Module$.h\""),
+                TEXT("/* Block comment spanning"),
+                TEXT("   two lines for block $ */"),
+                TEXT("void AMyActor$::Tick(float DeltaTime)"),
+                TEXT("{"),
+                TEXT("    const FString Label = TEXT(\"Actor \\\"$\\\" ticking\");"),
+                TEXT("    float Speed = 0x1F + $ * 2.5f;"),
+                TEXT("    if (Speed > 100.0f && Items[$ % 4] != nullptr)"),
+                TEXT("    {"),
+                TEXT("        return;"),
+                TEXT("    }"),
+                TEXT("}"),
+                TEXT(""),
+            } },
+            { EN2CCodeLanguage::CSharp, TEXT("CSharp"), {
+                TEXT("// Updates the movement state of actor $"),
+                TEXT("using Generated.Module$;"),
+                TEXT("/* Block comment spanning"),
+                TEXT("   two lines for block $ */"),
+                TEXT("public void Tick$(float deltaTime)"),
+                TEXT("{"),
+                TEXT("    var label = \"Actor \\\"$\\\" ticking\";"),
+                TEXT("    float speed = 0x1F + $ * 2.5f;"),
+                TEXT("    if (speed > 100.0f && items[$ % 4] != null)"),
+                TEXT("    {"),
+                TEXT("        return;"),
+                TEXT("    }"),
+                TEXT("}"),
+                TEXT(""),
+            } },
+            { EN2CCodeLanguage::Python, TEXT("Python"), {
+                TEXT("# Updates the movement state of actor $"),
+                TEXT("from generated.module$ import Actor"),
+                TEXT("def tick_$(self, delta_time):"),
+                TEXT("    \"\"\"Docstring spanning"),
+                TEXT("    two lines for block $\"\"\""),
+                TEXT("    label = f\"Actor \\\"{$}\\\" ticking\""),
+                TEXT("    speed = 0x1F + $ * 2.5"),
+                TEXT("    if speed > 100.0 and self.items[$ % 4] is not None:"),
+                TEXT("        return [speed, {'label': label}]"),
+                TEXT("    return None"),
+                TEXT(""),
+            } },
+            { EN2CCodeLanguage::Swift, TEXT("Swift"), {
+                TEXT("// Updates the movement state of actor $"),
+                TEXT("import GeneratedModule$"),
+                TEXT("/* Block comment spanning"),
+                TEXT("   two lines for block $ */"),
+                TEXT("func tick$(deltaTime: Float) -> Bool {"),
+                TEXT("    let label = \"Actor \\\"\\($)\\\" ticking\""),
+                TEXT("    var speed: Float = 0x1F + $ * 2.5"),
+                TEXT("    if speed > 100.0 && items[$ % 4] != nil {"),
+                TEXT("        return false"),
+                TEXT("    }"),
+                TEXT("    return true"),
+                TEXT("}"),
+                TEXT(""),
+            } },
+        };
+        return Languages;
+    }
+
+    TSharedPtr<FJsonObject> SummarizeStage(double MedianSeconds, double MemoryDeltaBytes)
+    {
+        TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetNumberField(TEXT("median_ms"), MedianSeconds * 1000.0);
+        Object->SetNumberField(TEXT("memory_delta_kb"), MemoryDeltaBytes / 1024.0);
+        return Object;
+    }
+
+    FString GetRunKey(const FJsonObject& Run)
+    {
+        return FString::Printf(TEXT("%s/%d"), *Run.GetStringField(TEXT("language")), static_cast<int32>(Run.GetNumberField(TEXT("lines"))));
+    }
+}
+
+UN2CSyntaxHighlighterBenchmarkCommandlet::UN2CSyntaxHighlighterBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UN2CSyntaxHighlighterBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<FString> Tokens;
+    TArray<FString> Switches;
+    TMap<FString, FString> ParamVals;
+    ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+    TArray<int32> LineCounts;
+    if (const FString* LinesParam = ParamVals.Find(TEXT("Lines")))
+    {
+        TArray<FString> Counts;
+        LinesParam->ParseIntoArray(Counts, TEXT("+"));
+        for (const FString& Count : Counts)
+        {
+            LineCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+        }
+    }
+    if (LineCounts.Num() == 0)
+    {
+        LineCounts = { 1000, 10000, 50000 };
+    }
+
+    if (const FString* IterationsParam = ParamVals.Find(TEXT("Iterations")))
+    {
+        Iterations = FMath::Max(1, FCString::Atoi(**IterationsParam));
+    }
+    if (const FString* ToleranceParam = ParamVals.Find(TEXT("Tolerance")))
+    {
+        TolerancePercent = FMath::Max(0.0, FCString::Atod(**ToleranceParam));
+    }
+
+    TSharedPtr<FJsonObject> BaselineObject;
+    if (const FString* BaselineParam = ParamVals.Find(TEXT("Baseline")))
+    {
+        FString BaselineJson;
+        if (!FFileHelper::LoadFileToString(BaselineJson, **BaselineParam)
+            || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineJson), BaselineObject) || !BaselineObject.IsValid())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to read baseline report: %s"), **BaselineParam), TEXT("Benchmark"));
+            return 1;
+        }
+    }
+
+    FString OutputPath;
+    if (const FString* OutputParam = ParamVals.Find(TEXT("Output")))
+    {
+        OutputPath = *OutputParam;
+    }
+    if (OutputPath.IsEmpty())
+    {
+        OutputPath = FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Benchmarks")
+            / FString::Printf(TEXT("SyntaxHighlighter-%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    }
+
+    TArray<TSharedPtr<FJsonValue>> RunReports;
+    for (const FBenchmarkLanguage& Language : GetBenchmarkLanguages())
+    {
+        for (const int32 LineCount : LineCounts)
+        {
+            const TSharedPtr<FJsonObject> Report = RunLanguage(Language.Language, LineCount);
+            Report->SetStringField(TEXT("language"), Language.Name);
+            RunReports.Add(MakeShared<FJsonValueObject>(Report));
+        }
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    RootObject->SetNumberField(TEXT("iterations"), Iterations);
+    RootObject->SetArrayField(TEXT("runs"), RunReports);
+
+    FString Out;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+    if (!FFileHelper::SaveStringToFile(Out, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to write benchmark report: %s"), *OutputPath), TEXT("Benchmark"));
+        return 1;
+    }
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Syntax highlighter benchmark written to %s"), *OutputPath), EN2CLogSeverity::Info, TEXT("Benchmark"));
+
+    if (BaselineObject.IsValid())
+    {
+        const int32 Regressions = CompareWithBaseline(*RootObject, *BaselineObject);
+        if (Regressions > 0)
+        {
+            FN2CLogger::Get().LogError(
+                FString::Printf(TEXT("%d stage(s) regressed by more than %.0f%%"), Regressions, TolerancePercent), TEXT("Benchmark"));
+            return 1;
+        }
+        FN2CLogger::Get().Log(TEXT("No regressions against the baseline"), EN2CLogSeverity::Info, TEXT("Benchmark"));
+    }
+    return 0;
+}
+
+FString UN2CSyntaxHighlighterBenchmarkCommandlet::GenerateSource(EN2CCodeLanguage Language, int32 LineCount)
+{
+    const FBenchmarkLanguage* Benchmark = GetBenchmarkLanguages().FindByPredicate(
+        [Language](const FBenchmarkLanguage& Candidate) { return Candidate.Language == Language; });
+    check(Benchmark);
+
+    FString Source;
+    Source.Reserve(LineCount * 48);
+    for (int32 Line = 0; Line < LineCount; ++Line)
+    {
+        const int32 BlockIndex = Line / Benchmark->Block.Num();
+        Source += FString(Benchmark->Block[Line % Benchmark->Block.Num()]).Replace(TEXT("$"), *FString::FromInt(BlockIndex));
+        Source += TEXT("\n");
+    }
+    return Source;
+}
+
+TSharedPtr<FJsonObject> UN2CSyntaxHighlighterBenchmarkCommandlet::RunLanguage(EN2CCodeLanguage Language, int32 LineCount) const
+{
+    const FString Source = GenerateSource(Language, LineCount);
+    TArray<FTextRange> LineRanges;
+    FTextRange::CalculateLineRangesFromString(Source, LineRanges);
+
+    const TSharedRef<FN2CSyntaxTokenizer> Tokenizer = FN2CSyntaxDefinitionFactory::Get().GetTokenizer(Language).ToSharedRef();
+    const TSharedRef<FN2CRichTextSyntaxHighlighter> Highlighter = FN2CRichTextSyntaxHighlighter::Create(Language, BenchmarkTheme);
+
+    int32 NumTokens = 0;
+    const FStageResult Tokenize = TimeStage([]() {}, [&]()
+    {
+        NumTokens = 0;
+        for (const FTextRange& LineRange : LineRanges)
+        {
+            ISyntaxTokenizer::FTokenizedLine TokenizedLine;
+            Tokenizer->TokenizeLine(Source, LineRange, TokenizedLine);
+            NumTokens += TokenizedLine.Tokens.Num();
+        }
+    });
+
+    // The viewer path lexes synchronously at any size, where SetText moves large texts to a worker
+    const FStageResult Lex = TimeStage([&]() { Highlighter->SetViewerText(Source); }, [&]()
+    {
+        Highlighter->LexViewerLines(LineRanges.Num() - 1);
+    });
+
+    // Every line is lexed by now, so this only builds model strings and runs
+    TSharedPtr<FSlateTextLayout> TextLayout;
+    const FTextBlockStyle& NormalStyle = Highlighter->GetSyntaxTextStyle().NormalTextStyle;
+    const FStageResult Runs = TimeStage([&]() { TextLayout = FSlateTextLayout::Create(nullptr, NormalStyle); }, [&]()
+    {
+        for (int32 LineIndex = 0; LineIndex < LineRanges.Num(); ++LineIndex)
+        {
+            Highlighter->AddViewerLineToLayout(LineIndex, *TextLayout);
+        }
+    });
+
+    // Lexing is tokenizing plus classifying, so classifying is what lexing adds
+    const double ClassifySeconds = FMath::Max(0.0, Lex.MedianSeconds - Tokenize.MedianSeconds);
+
+    TSharedPtr<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+    StagesObject->SetObjectField(TEXT("tokenize"), SummarizeStage(Tokenize.MedianSeconds, Tokenize.MemoryDeltaBytes));
+    StagesObject->SetObjectField(TEXT("classify"), SummarizeStage(ClassifySeconds, FMath::Max(0.0, Lex.MemoryDeltaBytes - Tokenize.MemoryDeltaBytes)));
+    StagesObject->SetObjectField(TEXT("lex"), SummarizeStage(Lex.MedianSeconds, Lex.MemoryDeltaBytes));
+    StagesObject->SetObjectField(TEXT("runs"), SummarizeStage(Runs.MedianSeconds, Runs.MemoryDeltaBytes));
+
+    TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("lines"), LineCount);
+    Report->SetNumberField(TEXT("chars"), Source.Len());
+    Report->SetNumberField(TEXT("tokens"), NumTokens);
+    Report->SetObjectField(TEXT("stages"), StagesObject);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("%-10s %6d lines: tokenize %8.2f ms, classify %8.2f ms, runs %8.2f ms (%.0f ns/line end to end)"),
+            *UEnum::GetDisplayValueAsText(Language).ToString(), LineCount, Tokenize.MedianSeconds * 1e3, ClassifySeconds * 1e3,
+            Runs.MedianSeconds * 1e3, (Lex.MedianSeconds + Runs.MedianSeconds) * 1e9 / LineCount),
+        EN2CLogSeverity::Info, TEXT("Benchmark"));
+    return Report;
+}
+
+UN2CSyntaxHighlighterBenchmarkCommandlet::FStageResult UN2CSyntaxHighlighterBenchmarkCommandlet::TimeStage(
+    TFunctionRef<void()> Setup,
+    TFunctionRef<void()> Stage) const
+{
+    TArray<double> Seconds;
+    TArray<double> MemoryDeltas;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        Setup();
+
+        const uint64 UsedBefore = FPlatformMemory::GetStats().UsedPhysical;
+        const double Start = FPlatformTime::Seconds();
+        Stage();
+        Seconds.Add(FPlatformTime::Seconds() - Start);
+
+        // Process-wide, so an upper bound on what the stage itself keeps alive
+        MemoryDeltas.Add(static_cast<double>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<double>(UsedBefore));
+    }
+
+    Seconds.Sort();
+    MemoryDeltas.Sort();
+
+    FStageResult Result;
+    Result.MedianSeconds = Seconds[Seconds.Num() / 2];
+    Result.MemoryDeltaBytes = FMath::Max(0.0, MemoryDeltas[MemoryDeltas.Num() / 2]);
+    return Result;
+}
+
+int32 UN2CSyntaxHighlighterBenchmarkCommandlet::CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline) const
+{
+    TMap<FString, TSharedPtr<FJsonObject>> BaselineRuns;
+    const TArray<TSharedPtr<FJsonValue>>* BaselineValues = nullptr;
+    if (Baseline.TryGetArrayField(TEXT("runs"), BaselineValues))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *BaselineValues)
+        {
+            const TSharedPtr<FJsonObject>* Run = nullptr;
+            if (Value->TryGetObject(Run) && Run->IsValid())
+            {
+                BaselineRuns.Add(GetRunKey(**Run), *Run);
+            }
+        }
+    }
+
+    const double Limit = 1.0 + TolerancePercent / 100.0;
+    int32 Regressions = 0;
+    for (const TSharedPtr<FJsonValue>& Value : Report.GetArrayField(TEXT("runs")))
+    {
+        const TSharedPtr<FJsonObject>& Run = Value->AsObject();
+        const FString RunKey = GetRunKey(*Run);
+        const TSharedPtr<FJsonObject>* BaselineRun = BaselineRuns.Find(RunKey);
+        const TSharedPtr<FJsonObject>* BaselineStages = nullptr;
+        if (!BaselineRun || !(*BaselineRun)->TryGetObjectField(TEXT("stages"), BaselineStages))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("%s is not in the baseline"), *RunKey), TEXT("Benchmark"));
+            continue;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Stage : Run->GetObjectField(TEXT("stages"))->Values)
+        {
+            const TSharedPtr<FJsonObject>* BaselineStage = nullptr;
+            if (!(*BaselineStages)->TryGetObjectField(Stage.Key, BaselineStage))
+            {
+                continue;
+            }
+
+            const TSharedPtr<FJsonObject> Current = Stage.Value->AsObject();
+            const double Milliseconds = Current->GetNumberField(TEXT("median_ms"));
+            const double BaselineMilliseconds = (*BaselineStage)->GetNumberField(TEXT("median_ms"));
+            if (BaselineMilliseconds >= MinComparedMilliseconds && Milliseconds > BaselineMilliseconds * Limit)
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("%s %s: %.2f ms, baseline %.2f ms"),
+                    *RunKey, *Stage.Key, Milliseconds, BaselineMilliseconds), TEXT("Benchmark"));
+                ++Regressions;
+            }
+
+            const double Kilobytes = Current->GetNumberField(TEXT("memory_delta_kb"));
+            const double BaselineKilobytes = (*BaselineStage)->GetNumberField(TEXT("memory_delta_kb"));
+            if (BaselineKilobytes >= MinComparedKilobytes && Kilobytes > BaselineKilobytes * Limit)
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("%s %s: +%.1f KB, baseline +%.1f KB"),
+                    *RunKey, *Stage.Key, Kilobytes, BaselineKilobytes), TEXT("Benchmark"));
+                ++Regressions;
+            }
+        }
+    }
+    return Regressions;
+}
@@ -66,6 +66,30 @@ void FN2CToolbarCommand::RegisterCommands()
         EUserInterfaceActionType::Button,
         FInputChord()
     );
+
+    UI_COMMAND(
+        CancelTranslationCommand,
+        "Cancel Translation",
+        "Cancel the running translation, including requests still waiting to be sent.",
+        EUserInterfaceActionType::Button,
+        FInputChord()
+    );
+
+    UI_COMMAND(
+        SavePreviewCommand,
+        "Save Translation Preview",
+        "Save the graph translation shown as a preview to a translation folder.",
+        EUserInterfaceActionType::Button,
+        FInputChord()
+    );
+
+    UI_COMMAND(
+        InspectBlueprintCommand,
+        "Inspect Blueprint Data",
+        "Browse the data extracted from the current graph, or a saved Blueprint JSON or snapshot, as a searchable tree.",
+        EUserInterfaceActionType::Button,
+        FInputChord()
+    );
     
     FN2CLogger::Get().Log(TEXT("N2C toolbar commands registered"), EN2CLogSeverity::Debug);
 }
@@ -0,0 +1,300 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Core/N2CTranslationJob.h"
+
+#include "Async/Async.h"
+#include "Core/N2CDependencyPreloader.h"
+#include "Core/N2CNodeTranslator.h"
+#include "Core/N2CSerializer.h"
+#include "Core/N2CSettings.h"
+#include "Engine/Blueprint.h"
+#include "LLM/N2CHttpHandlerBase.h"
+#include "LLM/N2CLLMModule.h"
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "LLM/N2CTranslationOutputWriter.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
+#include "Utils/N2CLogger.h"
+
+UN2CTranslationJob* UN2CTranslationJob::StartTranslationJob(const TArray<FString>& AssetPaths, const FN2CTranslationJobOptions& Options)
+{
+    if (AssetPaths.Num() == 0)
+    {
+        FN2CLogger::Get().LogWarning(TEXT("No assets given to translate"), TEXT("TranslationJob"));
+        return nullptr;
+    }
+
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    if (!LLMModule || !LLMModule->Initialize())
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to initialize LLM module"), TEXT("TranslationJob"));
+        return nullptr;
+    }
+
+    UN2CTranslationJob* Job = NewObject<UN2CTranslationJob>();
+    Job->Options = Options;
+    Job->Options.MaxConcurrentBlueprints = FMath::Max(1, Options.MaxConcurrentBlueprints);
+    Job->Token = MakeShared<FN2CCancellationToken>();
+
+    // A package path names the asset of the same name inside it
+    for (const FString& AssetPath : AssetPaths)
+    {
+        FSoftObjectPath ObjectPath(AssetPath);
+        if (ObjectPath.IsValid() && ObjectPath.GetAssetName().IsEmpty())
+        {
+            ObjectPath = FSoftObjectPath(AssetPath + TEXT(".") + FPackageName::GetShortName(AssetPath));
+        }
+        if (!ObjectPath.IsValid())
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Not an asset path: %s"), *AssetPath), TEXT("TranslationJob"));
+            continue;
+        }
+        Job->Assets.Add(ObjectPath);
+    }
+
+    // Kept alive while it runs, since scripts often drop the handle and only bind its events
+    Job->AddToRoot();
+    Job->State = EN2CTranslationJobState::Running;
+    Job->PeakMemory.Reset();
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Starting translation job for %d Blueprints"), Job->Assets.Num()),
+        EN2CLogSeverity::Info, TEXT("TranslationJob"));
+
+    Job->StartLoads();
+    Job->FinishIfDone();
+    return Job;
+}
+
+void UN2CTranslationJob::Cancel()
+{
+    if (IsDone())
+    {
+        return;
+    }
+
+    FN2CLogger::Get().Log(TEXT("Cancelling translation job"), EN2CLogSeverity::Info, TEXT("TranslationJob"));
+
+    // Queued requests report failure as they drain, which finishes their Blueprints
+    State = EN2CTranslationJobState::Cancelled;
+    Token->Cancel();
+    FN2CLLMRequestScheduler::Get().DrainCancelledRequests();
+    FinishIfDone();
+}
+
+float UN2CTranslationJob::GetProgress() const
+{
+    if (Assets.Num() == 0)
+    {
+        return 1.0f;
+    }
+
+    float Finished = FinishedBlueprints;
+    for (const TPair<int32, FActiveBlueprint>& Active : ActiveBlueprints)
+    {
+        Finished += Active.Value.Graphs > 0 ? static_cast<float>(Active.Value.Finished) / Active.Value.Graphs : 0.0f;
+    }
+    return FMath::Clamp(Finished / Assets.Num(), 0.0f, 1.0f);
+}
+
+void UN2CTranslationJob::StartLoads()
+{
+    while (!Token->IsCancelled() && NextAsset < Assets.Num()
+        && BlueprintsPreparing + ActiveBlueprints.Num() < Options.MaxConcurrentBlueprints)
+    {
+        const int32 AssetIndex = NextAsset++;
+        BlueprintsPreparing++;
+
+        LoadPackageAsync(Assets[AssetIndex].GetLongPackageName(), FLoadPackageAsyncDelegate::CreateLambda(
+            [this, AssetIndex](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+            {
+                UBlueprint* Blueprint = Result == EAsyncLoadingResult::Succeeded ? Cast<UBlueprint>(Assets[AssetIndex].ResolveObject()) : nullptr;
+                if (!Blueprint)
+                {
+                    FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to load Blueprint: %s"), *Assets[AssetIndex].ToString()), TEXT("TranslationJob"));
+                    BlueprintsPreparing--;
+                    FinishBlueprint(AssetIndex, true);
+                    return;
+                }
+
+                // Loading a package brings in its imports, but not the soft references a deep translation may follow
+                const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+                FN2CDependencyPreloader::Preload(Blueprint, Settings ? Settings->TranslationDepth : 0,
+                    [WeakJob = TWeakObjectPtr<UN2CTranslationJob>(this), AssetIndex, WeakBlueprint = TWeakObjectPtr<UBlueprint>(Blueprint)]()
+                    {
+                        UN2CTranslationJob* Job = WeakJob.Get();
+                        if (!Job)
+                        {
+                            return;
+                        }
+                        if (UBlueprint* LoadedBlueprint = WeakBlueprint.Get())
+                        {
+                            Job->ExtractBlueprint(AssetIndex, LoadedBlueprint);
+                            return;
+                        }
+                        Job->BlueprintsPreparing--;
+                        Job->FinishBlueprint(AssetIndex, true);
+                    });
+            }));
+    }
+}
+
+void UN2CTranslationJob::ExtractBlueprint(int32 AssetIndex, UBlueprint* Blueprint)
+{
+    if (Token->IsCancelled())
+    {
+        BlueprintsPreparing--;
+        FinishBlueprint(AssetIndex, true);
+        return;
+    }
+
+    // Extraction reads UObjects, so it stays on the game thread
+    FN2CNodeTranslator& Translator = FN2CNodeTranslator::Get();
+    if (!Translator.GenerateFromBlueprint(Blueprint, Options.bIncludeVariables))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to extract Blueprint: %s"), *Blueprint->GetName()), TEXT("TranslationJob"));
+        BlueprintsPreparing--;
+        FinishBlueprint(AssetIndex, true);
+        return;
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const EN2CJsonDialect Dialect = Settings && Settings->bUseCompactJson ? EN2CJsonDialect::Compact : EN2CJsonDialect::Standard;
+    TSharedRef<const FN2CBlueprint> Extracted = MakeShared<FN2CBlueprint>(Translator.TakeN2CBlueprint());
+
+    // Validation and serialization only read the copy, so they run on a worker
+    TWeakObjectPtr<UN2CTranslationJob> WeakJob(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakJob, AssetIndex, Extracted, Dialect]()
+    {
+        TArray<TPair<FString, FString>> GraphJsons;
+        FN2CBatchJsonContext BatchContext;
+        const bool bValid = Extracted->IsValid() && FN2CSerializer::BuildBatchContext(*Extracted, BatchContext, Dialect);
+        if (bValid)
+        {
+            for (const FN2CGraph& Graph : Extracted->Graphs)
+            {
+                if (!Graph.Name.IsEmpty())
+                {
+                    GraphJsons.Emplace(Graph.Name, FN2CSerializer::ToJsonForGraph(BatchContext, Graph));
+                }
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakJob, AssetIndex, Extracted, bValid, GraphJsons = MoveTemp(GraphJsons)]()
+        {
+            UN2CTranslationJob* Job = WeakJob.Get();
+            if (!Job)
+            {
+                return;
+            }
+
+            Job->BlueprintsPreparing--;
+            if (!bValid)
+            {
+                FN2CLogger::Get().LogError(FString::Printf(TEXT("Validation failed for: %s"), *Extracted->Metadata.Name), TEXT("TranslationJob"));
+                Job->FinishBlueprint(AssetIndex, true);
+                return;
+            }
+            Job->SendGraphs(AssetIndex, Extracted, GraphJsons);
+        });
+    });
+}
+
+void UN2CTranslationJob::SendGraphs(int32 AssetIndex, const TSharedRef<const FN2CBlueprint>& Extracted, const TArray<TPair<FString, FString>>& GraphJsons)
+{
+    if (Token->IsCancelled() || GraphJsons.Num() == 0)
+    {
+        FinishBlueprint(AssetIndex, Token->IsCancelled());
+        return;
+    }
+
+    UN2CLLMModule* LLMModule = UN2CLLMModule::Get();
+    const TSharedRef<FN2CTranslationSession> Session = LLMModule->CreateFolderSession(Extracted);
+    Session->Priority = EN2CRequestPriority::Batch;
+
+    FActiveBlueprint& Active = ActiveBlueprints.Add(AssetIndex);
+    Active.Graphs = GraphJsons.Num();
+
+    TWeakObjectPtr<UN2CTranslationJob> WeakJob(this);
+    for (const TPair<FString, FString>& GraphJson : GraphJsons)
+    {
+        LLMModule->ProcessN2CJsonQuietly(GraphJson.Value, Session, Token.ToSharedRef(), FOnLLMTranslationComplete::CreateLambda(
+            [WeakJob, AssetIndex, GraphName = GraphJson.Key](const FN2CTranslationResponse& Response, bool bSuccess)
+            {
+                // The module has already written the response into the Blueprint's folder
+                if (UN2CTranslationJob* Job = WeakJob.Get())
+                {
+                    Job->OnGraphComplete(AssetIndex, GraphName, bSuccess);
+                }
+            }));
+    }
+}
+
+void UN2CTranslationJob::OnGraphComplete(int32 AssetIndex, const FString& GraphName, bool bSuccess)
+{
+    FActiveBlueprint* Active = ActiveBlueprints.Find(AssetIndex);
+    if (!Active)
+    {
+        return;
+    }
+
+    (bSuccess ? TranslatedGraphs : FailedGraphs)++;
+    Active->Finished++;
+    PeakMemory.Sample();
+    const bool bBlueprintDone = Active->Finished >= Active->Graphs;
+
+    OnGraphTranslated.Broadcast(this, Assets[AssetIndex].ToString(), GraphName, bSuccess);
+
+    if (bBlueprintDone)
+    {
+        ActiveBlueprints.Remove(AssetIndex);
+        FinishBlueprint(AssetIndex, false);
+    }
+    else
+    {
+        OnProgress.Broadcast(this, GetProgress());
+    }
+}
+
+void UN2CTranslationJob::FinishBlueprint(int32 AssetIndex, bool bFailed)
+{
+    FinishedBlueprints++;
+    if (bFailed)
+    {
+        FailedBlueprints++;
+    }
+
+    OnProgress.Broadcast(this, GetProgress());
+    StartLoads();
+    FinishIfDone();
+}
+
+void UN2CTranslationJob::FinishIfDone()
+{
+    if (!IsRooted() || BlueprintsPreparing > 0 || ActiveBlueprints.Num() > 0 || (!Token->IsCancelled() && NextAsset < Assets.Num()))
+    {
+        return;
+    }
+
+    // CancelTranslations cancels the job's token without going through Cancel
+    if (Token->IsCancelled())
+    {
+        State = EN2CTranslationJobState::Cancelled;
+    }
+    else
+    {
+        State = FailedBlueprints > 0 || FailedGraphs > 0 ? EN2CTranslationJobState::Failed : EN2CTranslationJobState::Succeeded;
+    }
+
+    FN2CTranslationOutputWriter::Get().Flush();
+
+    PeakMemory.Sample();
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Translation job finished: %d of %d Blueprints, %d graphs translated, %d failed. %s"),
+            FinishedBlueprints - FailedBlueprints, Assets.Num(), TranslatedGraphs, FailedGraphs, *PeakMemory.ToString()),
+        State == EN2CTranslationJobState::Succeeded ? EN2CLogSeverity::Info : EN2CLogSeverity::Warning, TEXT("TranslationJob"));
+
+    RemoveFromRoot();
+    OnFinished.Broadcast(this, State);
+}
@@ -1,17 +1,41 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "Core/N2CUserSecrets.h"
+#include "DirectoryWatcherModule.h"
 #include "HAL/FileManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Utils/N2CLogger.h"
 
 UN2CUserSecrets::UN2CUserSecrets()
 {
-    // Load secrets when the object is created
-    LoadSecrets();
+    // Load secrets when the object is created; the class default object holds no keys
+    if (!HasAnyFlags(RF_ClassDefaultObject))
+    {
+        LoadSecrets();
+    }
+}
+
+void UN2CUserSecrets::BeginDestroy()
+{
+    FlushPendingSave();
+
+    if (WatcherHandle.IsValid())
+    {
+        if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+        {
+            if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+            {
+                DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchedDirectory, WatcherHandle);
+            }
+        }
+        WatcherHandle.Reset();
+    }
+
+    Super::BeginDestroy();
 }
 
 FString UN2CUserSecrets::GetSecretsFilePath()
@@ -37,6 +61,9 @@ void UN2CUserSecrets::EnsureSecretsDirectoryExists()
 void UN2CUserSecrets::LoadSecrets()
 {
     FString SecretsFilePath = GetSecretsFilePath();
+    bLoaded = true;
+    bFileChanged = false;
+    KnownFileTimestamp = IFileManager::Get().GetTimeStamp(*SecretsFilePath);
     
     // Check if the file exists
     if (!FPaths::FileExists(SecretsFilePath))
@@ -71,6 +98,10 @@ void UN2CUserSecrets::LoadSecrets()
     Anthropic_API_Key = JsonObject->GetStringField(TEXT("Anthropic_API_Key"));
     Gemini_API_Key = JsonObject->GetStringField(TEXT("Gemini_API_Key"));
     DeepSeek_API_Key = JsonObject->GetStringField(TEXT("DeepSeek_API_Key"));
+
+    // Secrets files written before the OpenAI-compatible provider existed have no key for it
+    OpenAICompatible_API_Key.Reset();
+    JsonObject->TryGetStringField(TEXT("OpenAICompatible_API_Key"), OpenAICompatible_API_Key);
     
     FN2CLogger::Get().Log(
         FString::Printf(TEXT("Successfully loaded secrets from: %s"), *SecretsFilePath),
@@ -88,6 +119,7 @@ void UN2CUserSecrets::SaveSecrets()
     JsonObject->SetStringField(TEXT("Anthropic_API_Key"), Anthropic_API_Key);
     JsonObject->SetStringField(TEXT("Gemini_API_Key"), Gemini_API_Key);
     JsonObject->SetStringField(TEXT("DeepSeek_API_Key"), DeepSeek_API_Key);
+    JsonObject->SetStringField(TEXT("OpenAICompatible_API_Key"), OpenAICompatible_API_Key);
     
     // Serialize to string
     FString JsonString;
@@ -107,7 +139,94 @@ void UN2CUserSecrets::SaveSecrets()
         return;
     }
     
+    // Our own write shouldn't make the watcher reload what is already in memory
+    KnownFileTimestamp = IFileManager::Get().GetTimeStamp(*SecretsFilePath);
+
     FN2CLogger::Get().Log(
         FString::Printf(TEXT("Successfully saved secrets to: %s"), *SecretsFilePath),
         EN2CLogSeverity::Info);
 }
+
+void UN2CUserSecrets::EnsureLoaded()
+{
+    if (IsInGameThread())
+    {
+        WatchSecretsDirectory();
+    }
+
+    // Keys edited here and not yet saved win over the file; the save will overwrite it
+    if ((!bLoaded || bFileChanged) && !SaveTickerHandle.IsValid())
+    {
+        LoadSecrets();
+    }
+}
+
+void UN2CUserSecrets::SaveSecretsDeferred()
+{
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+    }
+
+    SaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateWeakLambda(this, [this](float DeltaTime)
+        {
+            SaveTickerHandle.Reset();
+            SaveSecrets();
+            return false;
+        }),
+        SaveDelaySeconds);
+}
+
+void UN2CUserSecrets::FlushPendingSave()
+{
+    if (SaveTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+        SaveTickerHandle.Reset();
+        SaveSecrets();
+    }
+}
+
+void UN2CUserSecrets::WatchSecretsDirectory()
+{
+    if (WatcherHandle.IsValid())
+    {
+        return;
+    }
+
+    FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+    if (!DirectoryWatcher)
+    {
+        return;
+    }
+
+    // The directory must exist to be watched, even before the first key is saved
+    EnsureSecretsDirectoryExists();
+    WatchedDirectory = FPaths::GetPath(GetSecretsFilePath());
+    if (!DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+        WatchedDirectory,
+        IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UN2CUserSecrets::OnSecretsDirectoryChanged),
+        WatcherHandle))
+    {
+        WatcherHandle.Reset();
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Could not watch %s, edits to the secrets file need an editor restart"), *WatchedDirectory));
+    }
+}
+
+void UN2CUserSecrets::OnSecretsDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+    const FString SecretsFilePath = GetSecretsFilePath();
+    for (const FFileChangeData& Change : FileChanges)
+    {
+        if (FPaths::IsSamePath(FPaths::ConvertRelativePathToFull(Change.Filename), SecretsFilePath)
+            && IFileManager::Get().GetTimeStamp(*SecretsFilePath) != KnownFileTimestamp)
+        {
+            bFileChanged = true;
+            FN2CLogger::Get().Log(TEXT("Secrets file changed on disk, reloading on next use"), EN2CLogSeverity::Debug);
+            return;
+        }
+    }
+}
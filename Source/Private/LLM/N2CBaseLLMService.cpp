@@ -1,10 +1,76 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "LLM/N2CBaseLLMService.h"
+#include "Containers/Ticker.h"
+#include "Core/N2CSettings.h"
 #include "LLM/N2CHttpHandler.h"
+#include "LLM/N2CLLMRouter.h"
+#include "LLM/N2CLocalEndpointPool.h"
 #include "LLM/N2CSystemPromptManager.h"
 #include "LLM/N2CResponseParserBase.h"
+#include "LLM/N2CTokenEstimator.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Templates/UnrealTemplate.h"
+
+DECLARE_CYCLE_STAT(TEXT("Build Request Payload"), STAT_N2CBuildPayload, STATGROUP_NodeToCode);
+
+namespace
+{
+    /** Latencies kept per provider for the hedging percentile */
+    constexpr int32 MaxLatencySamples = 50;
+
+    /** Hedging waits until this many latencies are known, so one fast request cannot trigger duplicates */
+    constexpr int32 MinLatencySamples = 5;
+
+    /** Recent successful request latencies in seconds, newest last. Outlives the services, which are recreated on every initialize */
+    TMap<EN2CLLMProvider, TArray<double>>& GetLatencySamples()
+    {
+        static TMap<EN2CLLMProvider, TArray<double>> Samples;
+        return Samples;
+    }
+
+    void RecordLatency(EN2CLLMProvider Provider, double Seconds)
+    {
+        TArray<double>& Samples = GetLatencySamples().FindOrAdd(Provider);
+        if (Samples.Num() >= MaxLatencySamples)
+        {
+            Samples.RemoveAt(0);
+        }
+        Samples.Add(Seconds);
+    }
+
+    /** Latency below which Percentile percent of recent requests completed, or a negative value while too few are known */
+    double GetLatencyPercentile(EN2CLLMProvider Provider, float Percentile)
+    {
+        const TArray<double>* Samples = GetLatencySamples().Find(Provider);
+        if (!Samples || Samples->Num() < MinLatencySamples)
+        {
+            return -1.0;
+        }
+
+        TArray<double> Sorted = *Samples;
+        Sorted.Sort();
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Sorted.Num() * Percentile / 100.0f) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Index];
+    }
+
+    /** Response token limit of a probe, enough to time the first tokens of a response */
+    constexpr int32 ProbeOutputTokens = 16;
+
+    /** Seconds a probe may take, retries included, before it counts as failed */
+    constexpr double ProbeTimeoutSeconds = 30.0;
+
+    /** The HTTP handler reports failures as a JSON body with a top-level error field */
+    bool IsErrorResponse(const FString& Response)
+    {
+        const FString Head = Response.Left(64).TrimStart();
+        return Head.IsEmpty() || (Head.StartsWith(TEXT("{")) && Head.Contains(TEXT("\"error\"")));
+    }
+}
 
 bool UN2CBaseLLMService::Initialize(const FN2CLLMConfig& InConfig)
 {
@@ -16,8 +82,17 @@ bool UN2CBaseLLMService::Initialize(const FN2CLLMConfig& InConfig)
         Config.ApiEndpoint = GetDefaultEndpoint();
     }
 
-    // Initialize components
-    InitializeComponents();
+    // A pooled service being reconfigured keeps its HTTP handler, response parser and prompt manager,
+    // and the connections and caches they hold, and only takes the new configuration
+    if (bIsInitialized && HttpHandler && ResponseParser && PromptManager)
+    {
+        HttpHandler->Initialize(Config);
+        PromptManager->Initialize(Config);
+    }
+    else
+    {
+        InitializeComponents();
+    }
     
     // Set provider-specific headers
     TMap<FString, FString> Headers;
@@ -61,10 +136,162 @@ void UN2CBaseLLMService::InitializeComponents()
     PromptManager->Initialize(Config);
 }
 
+void UN2CBaseLLMService::WarmUpConnection() const
+{
+    // Local servers have no TLS handshake worth hiding
+    const EN2CLLMProvider Provider = GetProviderType();
+    if (!HttpHandler || Provider == EN2CLLMProvider::Ollama || Provider == EN2CLLMProvider::LMStudio)
+    {
+        return;
+    }
+    HttpHandler->WarmUpConnection(Config.ApiEndpoint);
+}
+
+void UN2CBaseLLMService::SendProbe(TFunction<void(const FN2CProviderProbe&)>&& OnComplete)
+{
+    if (!bIsInitialized || !HttpHandler || !PromptManager)
+    {
+        OnComplete(FN2CProviderProbe());
+        return;
+    }
+
+    TArray<uint8> Payload;
+    {
+        TGuardValue<int32> ProbeBudget(OutputTokensOverride, ProbeOutputTokens);
+        TGuardValue<bool> NoReferenceFiles(PromptManager->bOmitReferenceFiles, true);
+        Payload = FormatRequestPayload(TEXT("{\"ping\":true}"), TEXT("Reply with the single word OK."));
+    }
+
+    FString Endpoint, AuthToken;
+    bool bSupportsSystemPrompts;
+    GetConfiguration(Endpoint, AuthToken, bSupportsSystemPrompts);
+
+    // Streamed responses are decoded as they arrive, so throughput after the first byte can be measured
+    TSharedRef<FN2CLLMStreamState> StreamState = MakeShared<FN2CLLMStreamState>();
+    FOnLLMStreamChunkReceived OnChunk;
+    if (Config.bStreamResponses && ResponseParser)
+    {
+        OnChunk = FOnLLMStreamChunkReceived::CreateLambda([StreamState, WeakParser = TWeakObjectPtr<UN2CResponseParserBase>(ResponseParser)](const FString& Chunk)
+        {
+            if (const UN2CResponseParserBase* Parser = WeakParser.Get())
+            {
+                Parser->ConsumeStreamChunk(*StreamState, Chunk);
+            }
+        });
+    }
+
+    const TSharedRef<FN2CHttpRequestHandle> Handle = MakeShared<FN2CHttpRequestHandle>();
+    Handle->Deadline = FPlatformTime::Seconds() + ProbeTimeoutSeconds;
+    const EN2CLLMProvider Provider = GetProviderType();
+    HttpHandler->PostLLMStreamingRequest(
+        Endpoint,
+        AuthToken,
+        MoveTemp(Payload),
+        OnChunk,
+        FOnLLMResponseReceived::CreateLambda([Handle, StreamState, Provider, OnComplete = MoveTemp(OnComplete)](const FString& Response)
+        {
+            FN2CProviderProbe Probe;
+            Probe.bSucceeded = !IsErrorResponse(Response) && Handle->SentTime > 0.0;
+            if (Probe.bSucceeded)
+            {
+                const double Now = FPlatformTime::Seconds();
+                const double FirstByteTime = Handle->FirstByteTime > 0.0 ? Handle->FirstByteTime : Now;
+                Probe.FirstByteSeconds = FirstByteTime - Handle->SentTime;
+
+                const double StreamSeconds = Now - FirstByteTime;
+                const int32 OutputTokens = FN2CTokenEstimator::EstimateTokens(StreamState->Content, Provider);
+                if (StreamSeconds > KINDA_SMALL_NUMBER && OutputTokens > 1)
+                {
+                    Probe.OutputTokensPerSecond = OutputTokens / StreamSeconds;
+                }
+            }
+            OnComplete(Probe);
+        }),
+        Handle);
+}
+
+int32 UN2CBaseLLMService::GetMaxOutputTokens(const FString& UserMessage) const
+{
+    const int32 Ceiling = GetOutputTokenCeiling();
+    if (OutputTokensOverride > 0)
+    {
+        return FMath::Min(OutputTokensOverride, Ceiling);
+    }
+
+    // Local servers take their response limit from their own configuration
+    const EN2CLLMProvider Provider = GetProviderType();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings || !Settings->bBudgetResponseTokens || UsesReasoningTokens()
+        || Provider == EN2CLLMProvider::Ollama || Provider == EN2CLLMProvider::LMStudio)
+    {
+        return Ceiling;
+    }
+    const int32 JsonTokens = FN2CTokenEstimator::EstimateTokens(UserMessage, Provider);
+    return FN2CTokenEstimator::GetOutputBudget(JsonTokens, Ceiling);
+}
+
+EN2CReasoningEffort UN2CBaseLLMService::GetReasoningEffort(const FString& UserMessage) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const EN2CReasoningEffort Effort = Settings ? Settings->ReasoningEffort : EN2CReasoningEffort::Auto;
+    if (Effort != EN2CReasoningEffort::Auto)
+    {
+        return Effort;
+    }
+
+    // A few nodes need little thought; long graphs with many branches benefit from planning
+    constexpr int32 LowEffortMaxTokens = 2000;
+    constexpr int32 MediumEffortMaxTokens = 8000;
+    const int32 JsonTokens = FN2CTokenEstimator::EstimateTokens(UserMessage, GetProviderType());
+    return JsonTokens <= LowEffortMaxTokens ? EN2CReasoningEffort::Low
+        : JsonTokens <= MediumEffortMaxTokens ? EN2CReasoningEffort::Medium
+        : EN2CReasoningEffort::High;
+}
+
+int32 UN2CBaseLLMService::GetOutputTokenCeiling() const
+{
+    return FN2CTokenEstimator::OutputTokenReserve;
+}
+
+FString UN2CBaseLLMService::BuildBatchRequestBody(const FString& UserMessage, const FString& SystemMessage) const
+{
+    // A cut-off batch result can't be resent, so batch requests always get the full limit
+    TGuardValue<int32> FullBudget(OutputTokensOverride, GetOutputTokenCeiling());
+    const TArray<uint8> Payload = FormatRequestPayload(UserMessage, SystemMessage);
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+
+    TSharedPtr<FJsonObject> Body;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(FStringView(Converted.Get(), Converted.Length()));
+    if (!FJsonSerializer::Deserialize(Reader, Body) || !Body.IsValid())
+    {
+        return FString();
+    }
+
+    // Batch results are collected whole, so streaming the response is not allowed
+    Body->RemoveField(TEXT("stream"));
+    Body->RemoveField(TEXT("stream_options"));
+
+    FString Out;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+    FJsonSerializer::Serialize(Body.ToSharedRef(), Writer);
+    return Out;
+}
+
 void UN2CBaseLLMService::SendRequest(
     const FString& JsonPayload,
     const FString& SystemMessage,
     const FOnLLMResponseReceived& OnComplete)
+{
+    SendStreamingRequest(JsonPayload, SystemMessage, FOnLLMStreamChunkReceived(), OnComplete);
+}
+
+void UN2CBaseLLMService::SendStreamingRequest(
+    const FString& JsonPayload,
+    const FString& SystemMessage,
+    const FOnLLMStreamChunkReceived& OnPartialContent,
+    const FOnLLMResponseReceived& OnComplete,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
 {
     if (!bIsInitialized)
     {
@@ -81,19 +308,226 @@ void UN2CBaseLLMService::SendRequest(
         TEXT("BaseLLMService")
     );
 
-    // Format request payload
-    FString FormattedPayload = FormatRequestPayload(JsonPayload, SystemMessage);
+    // Format request payload, already encoded as the UTF-8 request body
+    TArray<uint8> FormattedPayload;
+    {
+        N2C_SCOPE_CYCLE_COUNTER(STAT_N2CBuildPayload);
+        LLM_SCOPE_BYTAG(NodeToCode_LLM);
+        const double FormatStart = FPlatformTime::Seconds();
+        FormattedPayload = FormatRequestPayload(JsonPayload, SystemMessage);
+        if (Handle.IsValid())
+        {
+            Handle->PayloadSeconds = FPlatformTime::Seconds() - FormatStart;
+        }
+    }
+
+    // A response cut off by a budgeted token limit is requested once more with the full limit
+    FOnLLMResponseReceived OnResponse = OnComplete;
+    const int32 MaxOutputTokens = GetMaxOutputTokens(JsonPayload);
+    if (MaxOutputTokens < GetOutputTokenCeiling())
+    {
+        TWeakObjectPtr<UN2CBaseLLMService> WeakThis(this);
+        OnResponse = FOnLLMResponseReceived::CreateLambda(
+            [WeakThis, JsonPayload, SystemMessage, OnPartialContent, OnComplete, Handle, MaxOutputTokens](const FString& Response)
+            {
+                UN2CBaseLLMService* This = WeakThis.Get();
+                if (This && This->ResponseParser && This->ResponseParser->IsTruncatedResponse(Response)
+                    && !(Handle.IsValid() && Handle->bCancelled))
+                {
+                    FN2CLogger::Get().LogWarning(
+                        FString::Printf(TEXT("Response reached its %d token limit, requesting it again with %d"),
+                            MaxOutputTokens, This->GetOutputTokenCeiling()),
+                        TEXT("BaseLLMService"));
+                    // Called non-virtually so the limit holds while the payload is formatted; any provider setup already ran
+                    TGuardValue<int32> FullBudget(This->OutputTokensOverride, This->GetOutputTokenCeiling());
+                    This->UN2CBaseLLMService::SendStreamingRequest(JsonPayload, SystemMessage, OnPartialContent, OnComplete, Handle);
+                    return;
+                }
+                const bool bExecuted = OnComplete.ExecuteIfBound(Response);
+            });
+    }
 
     // Get endpoint and auth token
     FString Endpoint, AuthToken;
     bool bSupportsSystemPrompts;
     GetConfiguration(Endpoint, AuthToken, bSupportsSystemPrompts);
 
+    // Decode stream events as they arrive so callers can show progress
+    FOnLLMStreamChunkReceived OnChunk;
+    if (Config.bStreamResponses && OnPartialContent.IsBound() && ResponseParser)
+    {
+        TSharedRef<FN2CLLMStreamState> StreamState = MakeShared<FN2CLLMStreamState>();
+        TWeakObjectPtr<UN2CResponseParserBase> WeakParser(ResponseParser);
+        OnChunk = FOnLLMStreamChunkReceived::CreateLambda(
+            [StreamState, WeakParser, OnPartialContent](const FString& Chunk)
+            {
+                if (const UN2CResponseParserBase* Parser = WeakParser.Get())
+                {
+                    const int32 PreviousLength = StreamState->Content.Len();
+                    Parser->ConsumeStreamChunk(*StreamState, Chunk);
+                    if (StreamState->Content.Len() != PreviousLength)
+                    {
+                        OnPartialContent.ExecuteIfBound(StreamState->Content);
+                    }
+                }
+            });
+    }
+
+    // Local providers with several servers send each request to the least loaded one
+    const EN2CLLMProvider Provider = GetProviderType();
+    FString PooledEndpoint;
+    FOnLLMResponseReceived OnRequestComplete = OnResponse;
+    if (FN2CLocalEndpointPool::Get().AcquireEndpoint(Provider, PooledEndpoint))
+    {
+        Endpoint = PooledEndpoint;
+
+        // The slot is freed exactly once, whether the request completes or is cancelled
+        TSharedRef<bool> bReleased = MakeShared<bool>(false);
+        OnRequestComplete = FOnLLMResponseReceived::CreateLambda([Provider, PooledEndpoint, bReleased, OnResponse](const FString& Response)
+        {
+            if (!*bReleased)
+            {
+                *bReleased = true;
+                FN2CLocalEndpointPool::Get().ReleaseEndpoint(Provider, PooledEndpoint, !IsErrorResponse(Response));
+            }
+            const bool bExecuted = OnResponse.ExecuteIfBound(Response);
+        });
+        if (Handle.IsValid())
+        {
+            Handle->OnCancelled = FSimpleDelegate::CreateLambda([Provider, PooledEndpoint, bReleased, OnCancelled = Handle->OnCancelled]()
+            {
+                if (!*bReleased)
+                {
+                    *bReleased = true;
+                    FN2CLocalEndpointPool::Get().ReleaseEndpoint(Provider, PooledEndpoint, true);
+                }
+                const bool bExecuted = OnCancelled.ExecuteIfBound();
+            });
+        }
+    }
+
+    // Hedge once enough latencies are known to tell a slow request from a normal one
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const double HedgeDelay = Settings && Settings->bHedgeSlowRequests
+        ? GetLatencyPercentile(Provider, Settings->HedgeLatencyPercentile)
+        : -1.0;
+    if (HedgeDelay >= 0.0)
+    {
+        SendHedgedRequest(Endpoint, AuthToken, MoveTemp(FormattedPayload), OnChunk, OnRequestComplete, HedgeDelay, Handle);
+        return;
+    }
+
     // Send request through HTTP handler
-    HttpHandler->PostLLMRequest(
+    const double StartTime = FPlatformTime::Seconds();
+    HttpHandler->PostLLMStreamingRequest(
         Endpoint,
         AuthToken,
-        FormattedPayload,
-        OnComplete
+        MoveTemp(FormattedPayload),
+        OnChunk,
+        FOnLLMResponseReceived::CreateLambda([Provider, StartTime, OnRequestComplete](const FString& Response)
+        {
+            if (!IsErrorResponse(Response))
+            {
+                RecordLatency(Provider, FPlatformTime::Seconds() - StartTime);
+            }
+            const bool bExecuted = OnRequestComplete.ExecuteIfBound(Response);
+        }),
+        Handle
     );
 }
+
+void UN2CBaseLLMService::SendHedgedRequest(
+    const FString& Endpoint,
+    const FString& AuthToken,
+    TArray<uint8>&& Payload,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    double HedgeDelay,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    struct FHedgeState
+    {
+        TSharedRef<FN2CHttpRequestHandle> Primary = MakeShared<FN2CHttpRequestHandle>();
+        TSharedRef<FN2CHttpRequestHandle> Hedge = MakeShared<FN2CHttpRequestHandle>();
+        bool bHedgeSent = false;
+        bool bDone = false;
+        int32 Failures = 0;
+    };
+    TSharedRef<FHedgeState> State = MakeShared<FHedgeState>();
+    const EN2CLLMProvider Provider = GetProviderType();
+    if (Handle.IsValid())
+    {
+        State->Primary->Deadline = Handle->Deadline;
+        State->Hedge->Deadline = Handle->Deadline;
+        Handle->Linked.Add(State->Primary);
+        Handle->Linked.Add(State->Hedge);
+    }
+
+    const TWeakPtr<FN2CHttpRequestHandle> WeakHandle = Handle;
+    auto MakeOnComplete = [State, Provider, OnComplete, WeakHandle](bool bIsHedge, double SentTime)
+    {
+        return FOnLLMResponseReceived::CreateLambda([State, Provider, OnComplete, WeakHandle, bIsHedge, SentTime](const FString& Response)
+        {
+            if (State->bDone)
+            {
+                return;
+            }
+
+            // A failure only counts once the other request cannot succeed either
+            const bool bFailed = IsErrorResponse(Response);
+            if (bFailed && ++State->Failures < (State->bHedgeSent ? 2 : 1))
+            {
+                return;
+            }
+
+            State->bDone = true;
+            (bIsHedge ? State->Primary : State->Hedge)->Cancel();
+
+            // The caller's handle reports the timings of the request that answered
+            if (const TSharedPtr<FN2CHttpRequestHandle> CallerHandle = WeakHandle.Pin())
+            {
+                const FN2CHttpRequestHandle& Winner = *(bIsHedge ? State->Hedge : State->Primary);
+                CallerHandle->SentTime = Winner.SentTime;
+                CallerHandle->UploadedTime = Winner.UploadedTime;
+                CallerHandle->FirstByteTime = Winner.FirstByteTime;
+            }
+
+            if (!bFailed)
+            {
+                RecordLatency(Provider, FPlatformTime::Seconds() - SentTime);
+                if (bIsHedge)
+                {
+                    FN2CLogger::Get().Log(TEXT("Hedged request finished first"), EN2CLogSeverity::Info, TEXT("BaseLLMService"));
+                }
+            }
+            const bool bExecuted = OnComplete.ExecuteIfBound(Response);
+        });
+    };
+
+    TWeakObjectPtr<UN2CBaseLLMService> WeakThis(this);
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakThis, State, Endpoint, AuthToken, HedgePayload = Payload, MakeOnComplete, HedgeDelay](float DeltaTime) mutable
+        {
+            // A request that is already streaming is slow, not stuck
+            UN2CBaseLLMService* StrongThis = WeakThis.Get();
+            if (!StrongThis || !StrongThis->HttpHandler || State->bDone || State->Primary->bReceivedBytes || State->Primary->bCancelled)
+            {
+                return false;
+            }
+
+            FN2CLogger::Get().LogWarning(
+                FString::Printf(TEXT("No response after %.1fs, sending a hedged duplicate request"), HedgeDelay),
+                TEXT("BaseLLMService"));
+
+            // Only the primary streams, so partial content never mixes two responses
+            State->bHedgeSent = true;
+            StrongThis->HttpHandler->PostLLMStreamingRequest(
+                Endpoint, AuthToken, MoveTemp(HedgePayload), FOnLLMStreamChunkReceived(),
+                MakeOnComplete(true, FPlatformTime::Seconds()), State->Hedge);
+            return false;
+        }),
+        static_cast<float>(HedgeDelay));
+
+    HttpHandler->PostLLMStreamingRequest(
+        Endpoint, AuthToken, MoveTemp(Payload), OnChunk, MakeOnComplete(false, FPlatformTime::Seconds()), State->Primary);
+}
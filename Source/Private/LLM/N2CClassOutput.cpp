@@ -0,0 +1,324 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CClassOutput.h"
+
+#include "LLM/N2CTranslationOutputWriter.h"
+#include "Utils/N2CLogger.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    const TCHAR* LayoutFileName = TEXT("N2C_Layout.json");
+
+    /** Types are declared before the class that uses them, and the class before its members */
+    int32 GetTypeRank(const FString& GraphType)
+    {
+        if (GraphType.Equals(TEXT("Enum"), ESearchCase::IgnoreCase))
+        {
+            return 0;
+        }
+        if (GraphType.Equals(TEXT("Struct"), ESearchCase::IgnoreCase))
+        {
+            return 1;
+        }
+        if (GraphType.Equals(TEXT("ClassItSelf"), ESearchCase::IgnoreCase))
+        {
+            return 2;
+        }
+        return 3;
+    }
+
+    /** Text with every run of whitespace removed, for telling whether a declaration is already in the skeleton */
+    FString RemoveWhitespace(const FString& Text)
+    {
+        FString Result;
+        Result.Reserve(Text.Len());
+        for (const TCHAR Char : Text)
+        {
+            if (!FChar::IsWhitespace(Char))
+            {
+                Result.AppendChar(Char);
+            }
+        }
+        return Result;
+    }
+
+    void AppendSection(FString& Out, const FString& Banner, const FString& Code)
+    {
+        Out += Banner;
+        Out += Code.TrimEnd();
+        Out += TEXT("\n\n");
+    }
+}
+
+FN2CClassOutput::FN2CClassOutput(EN2CCodeLanguage InLanguage, const FString& InExtension)
+    : Language(InLanguage)
+    , Extension(InExtension)
+{
+}
+
+const TCHAR* FN2CClassOutput::GetFolderName()
+{
+    return TEXT("Consolidated");
+}
+
+void FN2CClassOutput::AddGraph(const FN2CGraphTranslation& Graph, const FString& Directory, const FString& FileBaseName)
+{
+    FEntry* Existing = Entries.FindByPredicate([&Graph](const FEntry& Entry) { return Entry.Graph.GraphName == Graph.GraphName; });
+    FEntry& Entry = Existing ? *Existing : Entries.AddDefaulted_GetRef();
+    Entry.Graph = Graph;
+    Entry.Directory = Directory;
+    Entry.FileBaseName = FileBaseName;
+}
+
+void FN2CClassOutput::LoadCarriedForward(const FString& RootPath, TArray<FEntry>& InOutEntries) const
+{
+    // The layout was copied in with the graph folders when the batch carried them forward
+    FString LayoutJson;
+    if (!FFileHelper::LoadFileToString(LayoutJson, *FPaths::Combine(RootPath, GetFolderName(), LayoutFileName)))
+    {
+        return;
+    }
+
+    TSharedPtr<FJsonObject> Layout;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LayoutJson);
+    const TArray<TSharedPtr<FJsonValue>>* Graphs = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, Layout) || !Layout.IsValid() || !Layout->TryGetArrayField(TEXT("graphs"), Graphs))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Ignoring unreadable consolidated layout in: %s"), *RootPath), TEXT("ClassOutput"));
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& Value : *Graphs)
+    {
+        const TSharedPtr<FJsonObject>* GraphObject = nullptr;
+        if (!Value.IsValid() || !Value->TryGetObject(GraphObject))
+        {
+            continue;
+        }
+
+        FEntry Entry;
+        (*GraphObject)->TryGetStringField(TEXT("name"), Entry.Graph.GraphName);
+        (*GraphObject)->TryGetStringField(TEXT("type"), Entry.Graph.GraphType);
+        (*GraphObject)->TryGetStringField(TEXT("class"), Entry.Graph.GraphClass);
+        (*GraphObject)->TryGetStringField(TEXT("directory"), Entry.Directory);
+        (*GraphObject)->TryGetStringField(TEXT("file"), Entry.FileBaseName);
+        if (Entry.Graph.GraphName.IsEmpty() || Entry.FileBaseName.IsEmpty()
+            || InOutEntries.ContainsByPredicate([&Entry](const FEntry& Other) { return Other.Graph.GraphName == Entry.Graph.GraphName; }))
+        {
+            continue;
+        }
+
+        // A graph whose files are gone was dropped from the Blueprint
+        const FString FileBasePath = FPaths::Combine(RootPath, Entry.Directory, Entry.FileBaseName);
+        const bool bHasImplementation = FFileHelper::LoadFileToString(Entry.Graph.Code.GraphImplementation, *(FileBasePath + Extension));
+        const bool bHasDeclaration = FFileHelper::LoadFileToString(Entry.Graph.Code.GraphDeclaration, *(FileBasePath + TEXT(".h")));
+        if (bHasImplementation || bHasDeclaration)
+        {
+            FFileHelper::LoadFileToString(Entry.Graph.Code.ImplementationNotes, *(FileBasePath + TEXT("_Notes.txt")));
+            InOutEntries.Add(MoveTemp(Entry));
+        }
+    }
+}
+
+FString FN2CClassOutput::MakeBanner(const FN2CGraphTranslation& Graph) const
+{
+    const FString Title = Graph.GraphType.IsEmpty()
+        ? Graph.GraphName
+        : FString::Printf(TEXT("%s (%s)"), *Graph.GraphName, *Graph.GraphType);
+
+    switch (Language)
+    {
+        case EN2CCodeLanguage::Python:
+            return FString::Printf(TEXT("# ---- %s ----\n\n"), *Title);
+        case EN2CCodeLanguage::Pseudocode:
+            return FString::Printf(TEXT("## %s\n\n"), *Title);
+        default:
+            return FString::Printf(TEXT("// ---- %s ----\n\n"), *Title);
+    }
+}
+
+FString FN2CClassOutput::BuildHeader(const TArray<const FEntry*>& SortedEntries)
+{
+    FString Types;
+    FString Skeleton;
+    TArray<const FEntry*> Members;
+    for (const FEntry* Entry : SortedEntries)
+    {
+        const FString Declaration = Entry->Graph.Code.GraphDeclaration.TrimStartAndEnd();
+        if (Declaration.IsEmpty())
+        {
+            continue;
+        }
+
+        const int32 Rank = GetTypeRank(Entry->Graph.GraphType);
+        if (Rank < 2)
+        {
+            Types += Declaration + TEXT("\n\n");
+        }
+        else if (Rank == 2 && Skeleton.IsEmpty())
+        {
+            Skeleton = Declaration;
+        }
+        else
+        {
+            Members.Add(Entry);
+        }
+    }
+
+    // Members go inside the skeleton's class body, except those the skeleton already declares
+    const int32 BodyEnd = Skeleton.Find(TEXT("};"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+    const FString SkeletonText = RemoveWhitespace(Skeleton);
+    FString MemberText;
+    for (const FEntry* Entry : Members)
+    {
+        const FString Declaration = Entry->Graph.Code.GraphDeclaration.TrimStartAndEnd();
+        if (BodyEnd == INDEX_NONE || !SkeletonText.Contains(RemoveWhitespace(Declaration)))
+        {
+            MemberText += FString::Printf(TEXT("    // %s\n%s\n\n"), *Entry->Graph.GraphName, *Declaration);
+        }
+    }
+
+    FString Header = TEXT("#pragma once\n\n#include \"CoreMinimal.h\"\n\n") + Types;
+    if (BodyEnd != INDEX_NONE)
+    {
+        if (!MemberText.IsEmpty())
+        {
+            Skeleton.InsertAt(BodyEnd, TEXT("\npublic:\n") + MemberText);
+        }
+        Header += Skeleton + TEXT("\n");
+    }
+    else
+    {
+        if (!Skeleton.IsEmpty())
+        {
+            Header += Skeleton + TEXT("\n\n");
+        }
+        Header += MemberText;
+    }
+    return Header;
+}
+
+void FN2CClassOutput::Write(const FString& RootPath, const FString& FallbackClassName, int32 UnityGraphCount) const
+{
+    TArray<FEntry> AllEntries = Entries;
+    LoadCarriedForward(RootPath, AllEntries);
+    if (AllEntries.Num() == 0)
+    {
+        return;
+    }
+
+    // A fixed order, so a batch that changed nothing writes the same bytes
+    TArray<const FEntry*> Sorted;
+    for (const FEntry& Entry : AllEntries)
+    {
+        Sorted.Add(&Entry);
+    }
+    Sorted.Sort([](const FEntry& A, const FEntry& B)
+    {
+        const int32 RankA = GetTypeRank(A.Graph.GraphType);
+        const int32 RankB = GetTypeRank(B.Graph.GraphType);
+        return RankA != RankB ? RankA < RankB : A.Graph.GraphName < B.Graph.GraphName;
+    });
+
+    // Named after the class the graphs belong to, preferring the one the ClassItSelf graph declares
+    FString ClassName;
+    for (const FEntry* Entry : Sorted)
+    {
+        if (!Entry->Graph.GraphClass.IsEmpty() && (ClassName.IsEmpty() || GetTypeRank(Entry->Graph.GraphType) == 2))
+        {
+            ClassName = Entry->Graph.GraphClass;
+        }
+    }
+    ClassName = FPaths::MakeValidFileName(ClassName.IsEmpty() ? FallbackClassName : ClassName, TEXT('_'));
+
+    const FString OutputDir = FPaths::Combine(RootPath, GetFolderName());
+    const bool bIsCpp = Language == EN2CCodeLanguage::Cpp;
+    FN2CTranslationOutputWriter& OutputWriter = FN2CTranslationOutputWriter::Get();
+
+    TArray<FString> WrittenFiles;
+    auto QueueFile = [&OutputWriter, &OutputDir, &WrittenFiles](const FString& FileName, FString&& Content)
+    {
+        WrittenFiles.Add(FileName);
+        OutputWriter.Write(FPaths::Combine(OutputDir, FileName), MoveTemp(Content));
+    };
+
+    if (bIsCpp)
+    {
+        QueueFile(ClassName + TEXT(".h"), BuildHeader(Sorted));
+    }
+
+    // Implementations, in unity files of UnityGraphCount graphs when splitting C++
+    TArray<const FEntry*> Implemented = Sorted.FilterByPredicate([](const FEntry* Entry)
+    {
+        return !Entry->Graph.Code.GraphImplementation.TrimStartAndEnd().IsEmpty();
+    });
+    const int32 GraphsPerFile = bIsCpp && UnityGraphCount > 0 ? UnityGraphCount : FMath::Max(Implemented.Num(), 1);
+    const int32 FileCount = FMath::DivideAndRoundUp(Implemented.Num(), GraphsPerFile);
+    for (int32 FileIndex = 0; FileIndex < FileCount; ++FileIndex)
+    {
+        FString Implementation = bIsCpp ? FString::Printf(TEXT("#include \"%s.h\"\n\n"), *ClassName) : FString();
+        const int32 End = FMath::Min((FileIndex + 1) * GraphsPerFile, Implemented.Num());
+        for (int32 EntryIndex = FileIndex * GraphsPerFile; EntryIndex < End; ++EntryIndex)
+        {
+            AppendSection(Implementation, MakeBanner(Implemented[EntryIndex]->Graph), Implemented[EntryIndex]->Graph.Code.GraphImplementation);
+        }
+
+        const FString FileName = FileCount > 1
+            ? FString::Printf(TEXT("%s_Unity%d%s"), *ClassName, FileIndex + 1, *Extension)
+            : ClassName + Extension;
+        QueueFile(FileName, MoveTemp(Implementation));
+    }
+
+    FString Notes;
+    for (const FEntry* Entry : Sorted)
+    {
+        if (!Entry->Graph.Code.ImplementationNotes.TrimStartAndEnd().IsEmpty())
+        {
+            AppendSection(Notes, FString::Printf(TEXT("---- %s ----\n\n"), *Entry->Graph.GraphName), Entry->Graph.Code.ImplementationNotes);
+        }
+    }
+    if (!Notes.IsEmpty())
+    {
+        QueueFile(ClassName + TEXT("_Notes.txt"), MoveTemp(Notes));
+    }
+
+    // Where each merged graph's files are, so a later batch that carries them forward can merge them again
+    TArray<TSharedPtr<FJsonValue>> GraphValues;
+    for (const FEntry* Entry : Sorted)
+    {
+        TSharedPtr<FJsonObject> GraphObject = MakeShared<FJsonObject>();
+        GraphObject->SetStringField(TEXT("name"), Entry->Graph.GraphName);
+        GraphObject->SetStringField(TEXT("type"), Entry->Graph.GraphType);
+        GraphObject->SetStringField(TEXT("class"), Entry->Graph.GraphClass);
+        GraphObject->SetStringField(TEXT("directory"), Entry->Directory);
+        GraphObject->SetStringField(TEXT("file"), Entry->FileBaseName);
+        GraphValues.Add(MakeShared<FJsonValueObject>(GraphObject));
+    }
+    TSharedPtr<FJsonObject> Layout = MakeShared<FJsonObject>();
+    Layout->SetStringField(TEXT("class"), ClassName);
+    Layout->SetArrayField(TEXT("graphs"), GraphValues);
+
+    FString LayoutJson;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&LayoutJson);
+    FJsonSerializer::Serialize(Layout.ToSharedRef(), Writer);
+    QueueFile(LayoutFileName, MoveTemp(LayoutJson));
+
+    // Files of an earlier layout, such as unity files from a different split, would compile twice
+    TArray<FString> ExistingFiles;
+    IFileManager::Get().FindFiles(ExistingFiles, *FPaths::Combine(OutputDir, TEXT("*")), true, false);
+    for (const FString& ExistingFile : ExistingFiles)
+    {
+        if (!WrittenFiles.Contains(ExistingFile))
+        {
+            IFileManager::Get().Delete(*FPaths::Combine(OutputDir, ExistingFile));
+        }
+    }
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Consolidated %d graphs into %d files in: %s"),
+        Sorted.Num(), WrittenFiles.Num(), *OutputDir), EN2CLogSeverity::Info);
+}
@@ -1,10 +1,179 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "LLM/N2CHttpHandlerBase.h"
+#include "Core/N2CSettings.h"
+#include "LLM/N2CHttpReplay.h"
+#include "LLM/N2CLLMRequestScheduler.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
 #include "HttpModule.h"
+#include "PlatformHttp.h"
+#include "Containers/Ticker.h"
+#include "Misc/Compression.h"
 #include "Interfaces/IHttpResponse.h"
 
+DECLARE_CYCLE_STAT(TEXT("Compress Request Body"), STAT_N2CCompressBody, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Handle HTTP Response"), STAT_N2CHandleHttpResponse, STATGROUP_NodeToCode);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HTTP Requests Completed"), STAT_N2CHttpRequests, STATGROUP_NodeToCode);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("HTTP Request Time (s)"), STAT_N2CHttpSeconds, STATGROUP_NodeToCode);
+
+namespace
+{
+    /** Record the first response byte and the end of the upload on a request's handle */
+    void NoteRequestProgress(FN2CHttpRequestHandle& Handle, const FHttpRequestPtr& Request, uint64 BytesSent, uint64 BytesReceived)
+    {
+        const double Now = FPlatformTime::Seconds();
+        if (Handle.UploadedTime == 0.0 && Request.IsValid() && BytesSent >= static_cast<uint64>(Request->GetContentLength()))
+        {
+            Handle.UploadedTime = Now;
+        }
+        if (BytesReceived > 0)
+        {
+            Handle.bReceivedBytes = true;
+            if (Handle.FirstByteTime == 0.0)
+            {
+                Handle.FirstByteTime = Now;
+
+                // A response can start before the last progress report of the upload
+                if (Handle.UploadedTime == 0.0)
+                {
+                    Handle.UploadedTime = Now;
+                }
+            }
+        }
+    }
+
+    /** Seconds before a host is warmed up again, within the time servers usually keep idle connections */
+    constexpr double WarmUpInterval = 60.0;
+
+    /** Seconds a warm-up request may take */
+    constexpr float WarmUpTimeout = 10.0f;
+
+    /** Smallest request body worth compressing; below this the saving does not cover the compression time */
+    constexpr int32 MinCompressedBodySize = 64 * 1024;
+
+    /** When each host was last warmed up, shared by every handler since connections belong to the HTTP module */
+    TMap<FString, double>& GetLastWarmUpTimes()
+    {
+        static TMap<FString, double> LastWarmUpTimes;
+        return LastWarmUpTimes;
+    }
+
+    /** Rate limits, overloads (Anthropic's 529) and transient gateway errors */
+    bool IsRetryableResponseCode(int32 ResponseCode)
+    {
+        switch (ResponseCode)
+        {
+            case 408:
+            case 429:
+            case 500:
+            case 502:
+            case 503:
+            case 504:
+            case 529:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** Parse a duration such as "1s", "6m0s", "1.5s" or "250ms" into seconds, or a negative value */
+    double ParseDurationSeconds(const FString& Value)
+    {
+        double Seconds = 0.0;
+        int32 Index = 0;
+        bool bParsedAny = false;
+
+        while (Index < Value.Len())
+        {
+            const int32 NumberStart = Index;
+            while (Index < Value.Len() && (FChar::IsDigit(Value[Index]) || Value[Index] == TEXT('.')))
+            {
+                ++Index;
+            }
+            if (Index == NumberStart)
+            {
+                return -1.0;
+            }
+            const double Number = FCString::Atod(*Value.Mid(NumberStart, Index - NumberStart));
+
+            const int32 UnitStart = Index;
+            while (Index < Value.Len() && FChar::IsAlpha(Value[Index]))
+            {
+                ++Index;
+            }
+            const FString Unit = Value.Mid(UnitStart, Index - UnitStart);
+
+            if (Unit == TEXT("ms")) { Seconds += Number / 1000.0; }
+            else if (Unit == TEXT("s") || Unit.IsEmpty()) { Seconds += Number; }
+            else if (Unit == TEXT("m")) { Seconds += Number * 60.0; }
+            else if (Unit == TEXT("h")) { Seconds += Number * 3600.0; }
+            else { return -1.0; }
+
+            bParsedAny = true;
+        }
+
+        return bParsedAny ? Seconds : -1.0;
+    }
+
+    /** Seconds until an HTTP date or ISO 8601 timestamp, or a negative value if it does not parse */
+    double ParseSecondsUntil(const FString& Value)
+    {
+        FDateTime Time;
+        if (FDateTime::ParseHttpDate(Value, Time) || FDateTime::ParseIso8601(*Value, Time))
+        {
+            return FMath::Max(0.0, (Time - FDateTime::UtcNow()).GetTotalSeconds());
+        }
+        return -1.0;
+    }
+}
+
+void FN2CHttpRequestHandle::Cancel()
+{
+    if (bCancelled)
+    {
+        return;
+    }
+
+    bCancelled = true;
+    if (Request.IsValid())
+    {
+        Request->CancelRequest();
+    }
+    for (const TSharedRef<FN2CHttpRequestHandle>& Handle : Linked)
+    {
+        Handle->Cancel();
+    }
+    const bool bExecuted = OnCancelled.ExecuteIfBound();
+}
+
+void FN2CCancellationToken::Cancel()
+{
+    bCancelled = true;
+
+    // Cancelling runs completion callbacks, which may start and track new requests
+    TArray<TWeakPtr<FN2CHttpRequestHandle>> ToCancel = MoveTemp(Handles);
+    for (const TWeakPtr<FN2CHttpRequestHandle>& WeakHandle : ToCancel)
+    {
+        if (TSharedPtr<FN2CHttpRequestHandle> Handle = WeakHandle.Pin())
+        {
+            Handle->Cancel();
+        }
+    }
+}
+
+void FN2CCancellationToken::Track(const TSharedRef<FN2CHttpRequestHandle>& Handle)
+{
+    if (bCancelled)
+    {
+        Handle->Cancel();
+        return;
+    }
+
+    Handles.RemoveAll([](const TWeakPtr<FN2CHttpRequestHandle>& WeakHandle) { return !WeakHandle.IsValid(); });
+    Handles.Add(Handle);
+}
+
 void UN2CHttpHandlerBase::Initialize(const FN2CLLMConfig& InConfig)
 {
     Config = InConfig;
@@ -16,6 +185,30 @@ void UN2CHttpHandlerBase::PostLLMRequest(
     const FString& AuthToken,
     const FString& Payload,
     const FOnLLMResponseReceived& OnComplete)
+{
+    PostLLMStreamingRequest(Endpoint, AuthToken, Payload, FOnLLMStreamChunkReceived(), OnComplete);
+}
+
+void UN2CHttpHandlerBase::PostLLMStreamingRequest(
+    const FString& Endpoint,
+    const FString& AuthToken,
+    const FString& Payload,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete)
+{
+    // Encode once; the bytes are then moved into the request
+    const FTCHARToUTF8 Converted(*Payload, Payload.Len());
+    TArray<uint8> PayloadBytes(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+    PostLLMStreamingRequest(Endpoint, AuthToken, MoveTemp(PayloadBytes), OnChunk, OnComplete);
+}
+
+void UN2CHttpHandlerBase::PostLLMStreamingRequest(
+    const FString& Endpoint,
+    const FString& AuthToken,
+    TArray<uint8>&& Payload,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
 {
     // Validate request parameters
     if (!ValidateRequest(Endpoint, Payload))
@@ -31,6 +224,9 @@ void UN2CHttpHandlerBase::PostLLMRequest(
     Request->SetVerb(TEXT("POST"));
     Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 
+    // Gateways that default to closing should keep the connection for the next request of the batch
+    Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+
     // Add authorization if provided
     if (!AuthToken.IsEmpty())
     {
@@ -43,23 +239,160 @@ void UN2CHttpHandlerBase::PostLLMRequest(
         Request->SetHeader(Header.Key, Header.Value);
     }
 
-    Request->SetContentAsString(Payload);
-    Request->SetTimeout(RequestTimeout);
+    // N2C JSON and reference sources compress several times over, which matters on slow uplinks
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && Settings->GetProviderRequestLimits(Config.Provider).bCompressRequestBody && Payload.Num() >= MinCompressedBodySize)
+    {
+        N2C_SCOPE_CYCLE_COUNTER(STAT_N2CCompressBody);
+        LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+        const double CompressStart = FPlatformTime::Seconds();
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Payload.Num());
+        TArray<uint8> Compressed;
+        Compressed.SetNumUninitialized(CompressedSize);
+        if (FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num()))
+        {
+            Compressed.SetNum(CompressedSize);
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("Request body compressed from %.1f KB to %.1f KB in %.1f ms"),
+                    Payload.Num() / 1024.0, CompressedSize / 1024.0, (FPlatformTime::Seconds() - CompressStart) * 1000.0),
+                EN2CLogSeverity::Info, TEXT("HttpHandler"));
+
+            Payload = MoveTemp(Compressed);
+            Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+        }
+        else
+        {
+            FN2CLogger::Get().LogWarning(TEXT("Failed to compress request body, sending it uncompressed"), TEXT("HttpHandler"));
+        }
+    }
+
+    Request->SetContent(MoveTemp(Payload));
+
+    SendRequest(Request, OnChunk, OnComplete, 0, Handle);
+}
+
+void UN2CHttpHandlerBase::WarmUpConnection(const FString& Endpoint) const
+{
+    const FString Host = FPlatformHttp::GetUrlDomain(Endpoint);
+    if (Host.IsEmpty())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    double& LastWarmUpTime = GetLastWarmUpTimes().FindOrAdd(Host, -WarmUpInterval);
+    if (Now - LastWarmUpTime < WarmUpInterval)
+    {
+        return;
+    }
+    LastWarmUpTime = Now;
+
+    // Any response, even 404 or 405, means the connection is open; no credentials are sent
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(Endpoint);
+    Request->SetVerb(TEXT("HEAD"));
+    Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+    Request->SetTimeout(WarmUpTimeout);
+    Request->OnProcessRequestComplete().BindLambda([Host](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Warmed up connection to %s (%s)"), *Host, bConnectedSuccessfully ? TEXT("connected") : TEXT("failed")),
+            EN2CLogSeverity::Debug, TEXT("HttpHandler"));
+    });
+    Request->ProcessRequest();
+}
+
+void UN2CHttpHandlerBase::SendRequest(
+    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    int32 Attempt,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    float Timeout = RequestTimeout;
+    if (Handle.IsValid())
+    {
+        if (Handle->bCancelled)
+        {
+            return;
+        }
+        Handle->Request = Request;
+
+        // Retries share the deadline of the first attempt
+        if (Handle->Deadline > 0.0)
+        {
+            const double Remaining = Handle->Deadline - FPlatformTime::Seconds();
+            if (Remaining <= 0.0)
+            {
+                FN2CLogger::Get().LogError(TEXT("Request deadline exceeded"), TEXT("HttpHandler"));
+                const bool bExecuted = OnComplete.ExecuteIfBound(TEXT("{\"error\": \"Request deadline exceeded\"}"));
+                return;
+            }
+            Timeout = FMath::Min(Timeout, static_cast<float>(Remaining));
+        }
+    }
+
+    Request->SetTimeout(Timeout);
+
+    if (Handle.IsValid())
+    {
+        Handle->SentTime = FPlatformTime::Seconds();
+        Handle->UploadedTime = 0.0;
+        Handle->FirstByteTime = 0.0;
+    }
+
+    // Offline runs answer from the recordings without touching the network
+    if (FN2CHttpReplay::Get().IsReplaying())
+    {
+        ReplayRequest(Request, OnChunk, OnComplete, Attempt, Handle);
+        return;
+    }
 
     // SetActivityTimeout is only available in UE5.4 and later
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
-    Request->SetActivityTimeout(RequestTimeout);
+    Request->SetActivityTimeout(Timeout);
 #endif
     
     // Create a weak pointer to this for safety
     TWeakObjectPtr<UN2CHttpHandlerBase> WeakThis(this);
 
     // Create a lambda to handle the completion and forward to our handler
+    const double SentTime = FPlatformTime::Seconds();
     Request->OnProcessRequestComplete().BindLambda(
-        [WeakThis, OnComplete](FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful)
+        [WeakThis, OnChunk, OnComplete, Attempt, Handle, SentTime](FHttpRequestPtr InRequest, FHttpResponsePtr InResponse, bool bWasSuccessful)
         {
+            // Time on the wire is asynchronous, so it is accumulated rather than scoped
+            INC_DWORD_STAT(STAT_N2CHttpRequests);
+            INC_FLOAT_STAT_BY(STAT_N2CHttpSeconds, FPlatformTime::Seconds() - SentTime);
+            N2C_SCOPE_CYCLE_COUNTER(STAT_N2CHandleHttpResponse);
+            LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+            // Whoever cancelled the request no longer wants its result
+            if (Handle.IsValid() && Handle->bCancelled)
+            {
+                return;
+            }
+
             if (UN2CHttpHandlerBase* StrongThis = WeakThis.Get())
             {
+                // Let the scheduler size concurrency to the headroom the account actually has
+                if (InResponse.IsValid())
+                {
+                    const int32 ResponseCode = InResponse->GetResponseCode();
+                    FN2CLLMRequestScheduler::Get().ReportRateLimits(
+                        StrongThis->Config.Provider, GetRateLimitsFromHeaders(InResponse), ResponseCode == 429 || ResponseCode == 529);
+                }
+
+                // Transient failures are resent instead of reaching the caller
+                const bool bConnectionFailed = !bWasSuccessful || !InResponse.IsValid();
+                if (StrongThis->TryScheduleRetry(InRequest, bConnectionFailed, bConnectionFailed ? 0 : InResponse->GetResponseCode(),
+                    bConnectionFailed ? -1.0 : GetRetryDelayFromHeaders(InResponse), OnChunk, OnComplete, Attempt, Handle))
+                {
+                    return;
+                }
                 StrongThis->OnRequestComplete(InRequest, InResponse, bWasSuccessful, OnComplete);
             }
             else
@@ -70,6 +403,41 @@ void UN2CHttpHandlerBase::PostLLMRequest(
         }
     );
 
+    // Report body lines as they arrive when the caller wants incremental output, and note the first byte for the handle
+    if (OnChunk.IsBound() || Handle.IsValid())
+    {
+        TSharedRef<int32> ConsumedBytes = MakeShared<int32>(0);
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
+        Request->OnRequestProgress64().BindLambda(
+            [ConsumedBytes, OnChunk, Handle](FHttpRequestPtr InRequest, uint64 BytesSent, uint64 BytesReceived)
+            {
+                if (Handle.IsValid())
+                {
+                    NoteRequestProgress(*Handle, InRequest, BytesSent, BytesReceived);
+                }
+                if (OnChunk.IsBound())
+                {
+                    ForwardReceivedLines(InRequest, ConsumedBytes, OnChunk);
+                }
+            }
+        );
+#else
+        Request->OnRequestProgress().BindLambda(
+            [ConsumedBytes, OnChunk, Handle](FHttpRequestPtr InRequest, int32 BytesSent, int32 BytesReceived)
+            {
+                if (Handle.IsValid())
+                {
+                    NoteRequestProgress(*Handle, InRequest, BytesSent, BytesReceived);
+                }
+                if (OnChunk.IsBound())
+                {
+                    ForwardReceivedLines(InRequest, ConsumedBytes, OnChunk);
+                }
+            }
+        );
+#endif
+    }
+
     // Send request
     if (!Request->ProcessRequest())
     {
@@ -81,7 +449,295 @@ void UN2CHttpHandlerBase::PostLLMRequest(
     FN2CLogger::Get().Log(TEXT("HTTP request sent successfully"), EN2CLogSeverity::Info, TEXT("HttpHandler"));
 }
 
-bool UN2CHttpHandlerBase::ValidateRequest(const FString& Endpoint, const FString& Payload) const
+void UN2CHttpHandlerBase::ReplayRequest(
+    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    int32 Attempt,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    FN2CHttpReplay& Replay = FN2CHttpReplay::Get();
+    const float Latency = Replay.NextLatency();
+    const EN2CReplayFault Fault = Replay.NextFault();
+
+    TWeakObjectPtr<UN2CHttpHandlerBase> WeakThis(this);
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakThis, Request, Fault, OnChunk, OnComplete, Attempt, Handle](float)
+        {
+            if (Handle.IsValid() && Handle->bCancelled)
+            {
+                return false;
+            }
+            if (UN2CHttpHandlerBase* StrongThis = WeakThis.Get())
+            {
+                StrongThis->CompleteReplayedRequest(Request, Fault, OnChunk, OnComplete, Attempt, Handle);
+            }
+            else
+            {
+                OnComplete.ExecuteIfBound(TEXT("{\"error\": \"HTTP handler was destroyed\"}"));
+            }
+            return false;
+        }), Latency);
+}
+
+void UN2CHttpHandlerBase::CompleteReplayedRequest(
+    const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+    EN2CReplayFault Fault,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    int32 Attempt,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    INC_DWORD_STAT(STAT_N2CHttpRequests);
+
+    // Injected failures take the same retry path as real ones
+    if (Fault == EN2CReplayFault::RateLimited || Fault == EN2CReplayFault::TimedOut)
+    {
+        const bool bTimedOut = Fault == EN2CReplayFault::TimedOut;
+        if (!bTimedOut)
+        {
+            FN2CLLMRequestScheduler::Get().ReportRateLimits(Config.Provider, FN2CRateLimitState(), true);
+        }
+        if (TryScheduleRetry(Request, bTimedOut, bTimedOut ? 0 : 429, -1.0, OnChunk, OnComplete, Attempt, Handle))
+        {
+            return;
+        }
+
+        FN2CLogger::Get().LogError(bTimedOut ? TEXT("Replayed request timed out") : TEXT("Replayed request rate limited"), TEXT("HttpHandler"));
+        const bool bExecuted = OnComplete.ExecuteIfBound(bTimedOut
+            ? TEXT("{\"error\": \"Request failed\"}")
+            : TEXT("{\"error\": \"HTTP 429 - Injected rate limit\"}"));
+        OnTranslationResultReady.Broadcast(MakeShared<const FN2CTranslationResponse>(), false);
+        return;
+    }
+
+    FString Response;
+    if (!FN2CHttpReplay::Get().Find(Request->GetContent(), Response))
+    {
+        const bool bExecuted = OnComplete.ExecuteIfBound(TEXT("{\"error\": \"No recorded response\"}"));
+        OnTranslationResultReady.Broadcast(MakeShared<const FN2CTranslationResponse>(), false);
+        return;
+    }
+
+    if (Fault == EN2CReplayFault::Truncated)
+    {
+        Response.LeftInline(Response.Len() / 2);
+    }
+
+    if (Handle.IsValid())
+    {
+        Handle->bReceivedBytes = true;
+        Handle->UploadedTime = Handle->FirstByteTime = FPlatformTime::Seconds();
+    }
+
+    // The whole body arrives at once, as a single chunk
+    OnChunk.ExecuteIfBound(Response);
+    const bool bExecuted = OnComplete.ExecuteIfBound(Response);
+}
+
+bool UN2CHttpHandlerBase::TryScheduleRetry(
+    FHttpRequestPtr Request,
+    bool bConnectionFailed,
+    int32 ResponseCode,
+    double RetryDelayHint,
+    const FOnLLMStreamChunkReceived& OnChunk,
+    const FOnLLMResponseReceived& OnComplete,
+    int32 Attempt,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    if (!Request.IsValid())
+    {
+        return false;
+    }
+
+    if (!bConnectionFailed && !IsRetryableResponseCode(ResponseCode))
+    {
+        return false;
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FN2CProviderRequestLimits Limits = Settings ? Settings->GetProviderRequestLimits(Config.Provider) : FN2CProviderRequestLimits();
+    if (Attempt >= Limits.MaxRetries)
+    {
+        if (Limits.MaxRetries > 0)
+        {
+            FN2CLogger::Get().LogWarning(
+                FString::Printf(TEXT("Giving up after %d retries"), Attempt), TEXT("HttpHandler"));
+        }
+        return false;
+    }
+
+    // Prefer the provider's own hint; otherwise back off exponentially with half the delay jittered
+    // so parallel batch requests do not all come back at once
+    double Delay = RetryDelayHint;
+    if (Delay >= 0.0)
+    {
+        Delay *= FMath::FRandRange(1.0, 1.1);
+    }
+    else
+    {
+        const double Backoff = FMath::Min<double>(Limits.MaxRetryDelaySeconds, Limits.InitialRetryDelaySeconds * FMath::Pow(2.0, Attempt));
+        Delay = Backoff * 0.5 + FMath::FRandRange(0.0, Backoff * 0.5);
+    }
+
+    // A retry that cannot start before the deadline would only hold the slot longer
+    if (Handle.IsValid() && Handle->Deadline > 0.0 && FPlatformTime::Seconds() + Delay >= Handle->Deadline)
+    {
+        FN2CLogger::Get().LogWarning(TEXT("Not retrying, the request deadline would pass first"), TEXT("HttpHandler"));
+        return false;
+    }
+
+    FN2CLogger::Get().LogWarning(
+        FString::Printf(TEXT("%s, retry %d of %d in %.1fs"),
+            bConnectionFailed ? TEXT("HTTP request failed") : *FString::Printf(TEXT("HTTP %d"), ResponseCode),
+            Attempt + 1, Limits.MaxRetries, Delay),
+        TEXT("HttpHandler"));
+
+    // A completed request cannot be processed again, so resend a copy of it
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> RetryRequest = FHttpModule::Get().CreateRequest();
+    RetryRequest->SetURL(Request->GetURL());
+    RetryRequest->SetVerb(Request->GetVerb());
+    for (const FString& Header : Request->GetAllHeaders())
+    {
+        FString Name, Value;
+        if (Header.Split(TEXT(": "), &Name, &Value))
+        {
+            RetryRequest->SetHeader(Name, Value);
+        }
+    }
+    RetryRequest->SetContent(Request->GetContent());
+
+    TWeakObjectPtr<UN2CHttpHandlerBase> WeakThis(this);
+    FN2CLLMRequestScheduler::Get().ScheduleRetry(Config.Provider, static_cast<float>(Delay),
+        [WeakThis, RetryRequest, OnChunk, OnComplete, Attempt, Handle]()
+        {
+            if (Handle.IsValid() && Handle->bCancelled)
+            {
+                return;
+            }
+            if (UN2CHttpHandlerBase* StrongThis = WeakThis.Get())
+            {
+                StrongThis->SendRequest(RetryRequest, OnChunk, OnComplete, Attempt + 1, Handle);
+            }
+            else
+            {
+                OnComplete.ExecuteIfBound(TEXT("{\"error\": \"HTTP handler was destroyed\"}"));
+            }
+        });
+    return true;
+}
+
+FN2CRateLimitState UN2CHttpHandlerBase::GetRateLimitsFromHeaders(const FHttpResponsePtr& Response)
+{
+    // OpenAI and OpenAI-compatible providers use x-ratelimit-*, Anthropic its own prefix
+    auto ReadHeader = [&Response](const TCHAR* OpenAIName, const TCHAR* AnthropicName) -> int64
+    {
+        FString Value = Response->GetHeader(OpenAIName);
+        if (Value.IsEmpty())
+        {
+            Value = Response->GetHeader(AnthropicName);
+        }
+        return !Value.IsEmpty() && FCString::IsNumeric(*Value) ? FCString::Atoi64(*Value) : -1;
+    };
+
+    FN2CRateLimitState RateLimits;
+    RateLimits.RequestsLimit = ReadHeader(TEXT("x-ratelimit-limit-requests"), TEXT("anthropic-ratelimit-requests-limit"));
+    RateLimits.RequestsRemaining = ReadHeader(TEXT("x-ratelimit-remaining-requests"), TEXT("anthropic-ratelimit-requests-remaining"));
+    RateLimits.TokensLimit = ReadHeader(TEXT("x-ratelimit-limit-tokens"), TEXT("anthropic-ratelimit-tokens-limit"));
+    RateLimits.TokensRemaining = ReadHeader(TEXT("x-ratelimit-remaining-tokens"), TEXT("anthropic-ratelimit-tokens-remaining"));
+    return RateLimits;
+}
+
+double UN2CHttpHandlerBase::GetRetryDelayFromHeaders(const FHttpResponsePtr& Response)
+{
+    const FString RetryAfterMs = Response->GetHeader(TEXT("retry-after-ms"));
+    if (!RetryAfterMs.IsEmpty() && FCString::IsNumeric(*RetryAfterMs))
+    {
+        return FCString::Atod(*RetryAfterMs) / 1000.0;
+    }
+
+    // Retry-After is either delta seconds or an HTTP date
+    const FString RetryAfter = Response->GetHeader(TEXT("retry-after"));
+    if (!RetryAfter.IsEmpty())
+    {
+        if (FCString::IsNumeric(*RetryAfter))
+        {
+            return FCString::Atod(*RetryAfter);
+        }
+        const double Seconds = ParseSecondsUntil(RetryAfter);
+        if (Seconds >= 0.0)
+        {
+            return Seconds;
+        }
+    }
+
+    // Otherwise wait for whichever exhausted limit resets last. OpenAI sends durations, Anthropic timestamps
+    struct FRateLimitHeaders
+    {
+        const TCHAR* Remaining;
+        const TCHAR* Reset;
+    };
+    static const FRateLimitHeaders RateLimitHeaders[] =
+    {
+        { TEXT("x-ratelimit-remaining-requests"), TEXT("x-ratelimit-reset-requests") },
+        { TEXT("x-ratelimit-remaining-tokens"), TEXT("x-ratelimit-reset-tokens") },
+        { TEXT("anthropic-ratelimit-requests-remaining"), TEXT("anthropic-ratelimit-requests-reset") },
+        { TEXT("anthropic-ratelimit-tokens-remaining"), TEXT("anthropic-ratelimit-tokens-reset") },
+    };
+
+    double Delay = -1.0;
+    for (const FRateLimitHeaders& Headers : RateLimitHeaders)
+    {
+        if (Response->GetHeader(Headers.Remaining) != TEXT("0"))
+        {
+            continue;
+        }
+
+        const FString Reset = Response->GetHeader(Headers.Reset);
+        double Seconds = ParseDurationSeconds(Reset);
+        if (Seconds < 0.0)
+        {
+            Seconds = ParseSecondsUntil(Reset);
+        }
+        Delay = FMath::Max(Delay, Seconds);
+    }
+
+    return Delay;
+}
+
+void UN2CHttpHandlerBase::ForwardReceivedLines(
+    FHttpRequestPtr Request,
+    const TSharedRef<int32>& ConsumedBytes,
+    const FOnLLMStreamChunkReceived& OnChunk)
+{
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    const FHttpResponsePtr Response = Request.IsValid() ? Request->GetResponse() : nullptr;
+    if (!Response.IsValid())
+    {
+        return;
+    }
+
+    const TArray<uint8>& Content = Response->GetContent();
+
+    // Only forward up to the last newline so multi-byte characters and events are never split
+    int32 End = Content.Num();
+    while (End > *ConsumedBytes && Content[End - 1] != '\n')
+    {
+        --End;
+    }
+    if (End <= *ConsumedBytes)
+    {
+        return;
+    }
+
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData() + *ConsumedBytes), End - *ConsumedBytes);
+    *ConsumedBytes = End;
+
+    OnChunk.ExecuteIfBound(FString(Converted.Length(), Converted.Get()));
+}
+
+bool UN2CHttpHandlerBase::ValidateRequest(const FString& Endpoint, const TArray<uint8>& Payload) const
 {
     if (Endpoint.IsEmpty())
     {
@@ -89,7 +745,7 @@ bool UN2CHttpHandlerBase::ValidateRequest(const FString& Endpoint, const FString
         return false;
     }
 
-    if (Payload.IsEmpty())
+    if (Payload.Num() == 0)
     {
         FN2CLogger::Get().LogError(TEXT("Empty request payload"), TEXT("HttpHandler"));
         return false;
@@ -104,22 +760,33 @@ void UN2CHttpHandlerBase::OnRequestComplete(
     bool bWasSuccessful,
     FOnLLMResponseReceived OnComplete)
 {
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
     if (!bWasSuccessful || !Response.IsValid())
     {
         FString ErrorMsg = TEXT("{\"error\": \"Request failed\"}");
         FN2CLogger::Get().LogError(TEXT("HTTP request failed"), TEXT("HttpHandler"));
         const bool bExecuted = OnComplete.ExecuteIfBound(ErrorMsg);
-        OnTranslationResponseReceived.Broadcast(FN2CTranslationResponse(), false);
+        OnTranslationResultReady.Broadcast(MakeShared<const FN2CTranslationResponse>(), false);
         return;
     }
 
     // Check response code
     const int32 ResponseCode = Response->GetResponseCode();
-    const FString ResponseContent = Response->GetContentAsString();
+
+    // Decoded straight from the body bytes, which GetContentAsString would first copy to null-terminate. This is
+    // the only copy of the body: every callback down to the parser takes it by reference and parses it in place
+    const TArray<uint8>& Content = Response->GetContent();
+    const FString ResponseContent(Content.Num(), reinterpret_cast<const UTF8CHAR*>(Content.GetData()));
 
     // Handle successful responses (200-299)
     if (ResponseCode >= 200 && ResponseCode < 300)
     {
+        if (Request.IsValid() && FN2CHttpReplay::Get().IsRecording())
+        {
+            FN2CHttpReplay::Get().Record(Request->GetContent(), ResponseContent);
+        }
+
         // Return successful response
         const bool bExecuted = OnComplete.ExecuteIfBound(ResponseContent);
         return;
@@ -150,5 +817,5 @@ void UN2CHttpHandlerBase::OnRequestComplete(
     );
 
     const bool bExecuted = OnComplete.ExecuteIfBound(ErrorMsg);
-    OnTranslationResponseReceived.Broadcast(FN2CTranslationResponse(), false);
+    OnTranslationResultReady.Broadcast(MakeShared<const FN2CTranslationResponse>(), false);
 }
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CHttpReplay.h"
+
+#include "Core/N2CSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Utils/N2CLogger.h"
+
+FN2CHttpReplay& FN2CHttpReplay::Get()
+{
+    static FN2CHttpReplay Instance;
+    return Instance;
+}
+
+bool FN2CHttpReplay::IsRecording() const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings && Settings->ReplayMode == EN2CHttpReplayMode::Record;
+}
+
+bool FN2CHttpReplay::IsReplaying() const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings && Settings->ReplayMode == EN2CHttpReplayMode::Replay;
+}
+
+void FN2CHttpReplay::Record(const TArray<uint8>& RequestBody, const FString& Response)
+{
+    const FString Hash = HashRequestBody(RequestBody);
+    Responses.Add(Hash, Response);
+
+    // The request is kept for inspection only; replays are looked up by the hash
+    const FString BasePath = GetReplayDirectory() / Hash;
+    if (!FFileHelper::SaveArrayToFile(RequestBody, *(BasePath + TEXT(".request")))
+        || !FFileHelper::SaveStringToFile(Response, *(BasePath + TEXT(".response")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to record response: %s"), *BasePath), TEXT("HttpReplay"));
+        return;
+    }
+
+    N2C_LOG(Debug, TEXT("Recorded response %s"), *Hash);
+}
+
+bool FN2CHttpReplay::Find(const TArray<uint8>& RequestBody, FString& OutResponse)
+{
+    const FString Hash = HashRequestBody(RequestBody);
+    if (const FString* Response = Responses.Find(Hash))
+    {
+        OutResponse = *Response;
+        return true;
+    }
+
+    if (!FFileHelper::LoadFileToString(OutResponse, *(GetReplayDirectory() / Hash + TEXT(".response"))))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("No recorded response for request %s"), *Hash), TEXT("HttpReplay"));
+        return false;
+    }
+
+    Responses.Add(Hash, OutResponse);
+    return true;
+}
+
+float FN2CHttpReplay::NextLatency()
+{
+    SyncSeed();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings ? Settings->ReplayLatencySeconds + Random.FRandRange(0.0f, Settings->ReplayLatencyJitterSeconds) : 0.0f;
+}
+
+EN2CReplayFault FN2CHttpReplay::NextFault()
+{
+    SyncSeed();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings)
+    {
+        return EN2CReplayFault::None;
+    }
+
+    // One draw per request, so changing one rate does not reshuffle which requests get the others
+    const float Roll = Random.GetFraction();
+    float Threshold = Settings->ReplayRateLimitRate;
+    if (Roll < Threshold)
+    {
+        return EN2CReplayFault::RateLimited;
+    }
+    Threshold += Settings->ReplayTimeoutRate;
+    if (Roll < Threshold)
+    {
+        return EN2CReplayFault::TimedOut;
+    }
+    Threshold += Settings->ReplayTruncationRate;
+    return Roll < Threshold ? EN2CReplayFault::Truncated : EN2CReplayFault::None;
+}
+
+void FN2CHttpReplay::Reset()
+{
+    Responses.Empty();
+    bSeeded = false;
+}
+
+FString FN2CHttpReplay::GetReplayDirectory()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && !Settings->ReplayDirectory.Path.IsEmpty())
+    {
+        return Settings->ReplayDirectory.Path;
+    }
+    return FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Replay");
+}
+
+FString FN2CHttpReplay::HashRequestBody(const TArray<uint8>& RequestBody)
+{
+    uint8 Digest[FSHA1::DigestSize];
+    FSHA1::HashBuffer(RequestBody.GetData(), RequestBody.Num(), Digest);
+    return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+void FN2CHttpReplay::SyncSeed()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const int32 SettingSeed = Settings ? Settings->ReplaySeed : 0;
+    if (!bSeeded || SettingSeed != Seed)
+    {
+        Seed = SettingSeed;
+        Random.Initialize(Seed);
+        bSeeded = true;
+    }
+}
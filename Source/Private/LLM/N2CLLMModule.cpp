@@ -5,16 +5,129 @@
 #include "Core/N2CNodeTranslator.h"
 #include "Core/N2CSerializer.h"
 #include "Core/N2CSettings.h"
+#include "Core/N2CSnapshot.h"
 #include "LLM/N2CSystemPromptManager.h"
 #include "LLM/N2CBaseLLMService.h"
 #include "LLM/N2CLLMProviderRegistry.h"
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "LLM/N2CLLMRouter.h"
+#include "LLM/N2CSyntaxVerifier.h"
+#include "LLM/N2CTokenEstimator.h"
+#include "LLM/N2CTranslationArchive.h"
+#include "LLM/N2CTranslationCache.h"
+#include "LLM/N2CTranslationHistory.h"
+#include "LLM/N2CTranslationOutputWriter.h"
 #include "LLM/Providers/N2CAnthropicService.h"
 #include "LLM/Providers/N2CDeepSeekService.h"
 #include "LLM/Providers/N2CGeminiService.h"
 #include "LLM/Providers/N2CLMStudioService.h"
+#include "LLM/Providers/N2COpenAICompatibleService.h"
 #include "LLM/Providers/N2COpenAIService.h"
 #include "LLM/Providers/N2COllamaService.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "Utils/N2CTelemetry.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+DECLARE_CYCLE_STAT(TEXT("Prepare Request"), STAT_N2CSendJson, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Parse Response"), STAT_N2CParseResponse, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Save Translation"), STAT_N2CSaveTranslation, STATGROUP_NodeToCode);
+
+/** File written to each batch output folder listing the fingerprints of the graphs it contains */
+static const TCHAR* GraphFingerprintManifestName = TEXT("N2C_GraphFingerprints.json");
+
+/** Append-only log of a batch's queued, completed and failed graphs, ending with an "end" entry */
+static const TCHAR* BatchJournalName = TEXT("N2C_BatchJournal.jsonl");
+
+/** Files written to each batch output folder with the metrics of the batch's requests */
+static const TCHAR* RequestMetricsCsvName = TEXT("N2C_RequestMetrics.csv");
+static const TCHAR* RequestMetricsJsonName = TEXT("N2C_RequestMetrics.json");
+
+// Sanitize graph names for use as filesystem paths while keeping the
+// original GraphName intact for logical/JSON purposes.
+static FString SanitizeNameForFilesystem(const FString& InName)
+{
+    FString Result = InName;
+    Result = Result.TrimStartAndEnd();
+
+    // Replace Windows-invalid filename characters with underscores
+    const TCHAR InvalidChars[] =
+    {
+        TEXT('<'), TEXT('>'), TEXT(':'), TEXT('"'),
+        TEXT('/'), TEXT('\\'), TEXT('|'), TEXT('?'), TEXT('*')
+    };
+
+    for (TCHAR Ch : InvalidChars)
+    {
+        FString From;
+        From.AppendChar(Ch);
+        Result.ReplaceInline(*From, TEXT("_"), ESearchCase::CaseSensitive);
+    }
+
+    return Result;
+}
+
+// Delegate setting Promise with the translation it is called with
+static FOnLLMTranslationComplete MakePromiseDelegate(const TSharedRef<TPromise<FN2CTranslationResult>>& Promise)
+{
+    return FOnLLMTranslationComplete::CreateLambda([Promise](const FN2CTranslationResponse& Response, bool bSuccess)
+    {
+        FN2CTranslationResult Result;
+        Result.Response = MakeShared<const FN2CTranslationResponse>(Response);
+        Result.bSuccess = bSuccess;
+        Promise->SetValue(MoveTemp(Result));
+    });
+}
+
+// Queue the translation response, as JSON, for writing to FilePath
+static void WriteTranslationJson(const FN2CTranslationResponse& Response, const FString& FilePath)
+{
+    // Serialize the Translation response to JSON
+    TSharedPtr<FJsonObject> TranslationJsonObject = MakeShared<FJsonObject>();
+    
+    // Create graphs array
+    TArray<TSharedPtr<FJsonValue>> GraphsArray;
+    for (const FN2CGraphTranslation& Graph : Response.Graphs)
+    {
+        TSharedPtr<FJsonObject> GraphObject = MakeShared<FJsonObject>();
+        GraphObject->SetStringField(TEXT("graph_name"), Graph.GraphName);
+        GraphObject->SetStringField(TEXT("graph_type"), Graph.GraphType);
+        GraphObject->SetStringField(TEXT("graph_class"), Graph.GraphClass);
+        
+        // Create code object
+        TSharedPtr<FJsonObject> CodeObject = MakeShared<FJsonObject>();
+        CodeObject->SetStringField(TEXT("graphDeclaration"), Graph.Code.GraphDeclaration);
+        CodeObject->SetStringField(TEXT("graphImplementation"), Graph.Code.GraphImplementation);
+        CodeObject->SetStringField(TEXT("implementationNotes"), Graph.Code.ImplementationNotes);
+        
+        GraphObject->SetObjectField(TEXT("code"), CodeObject);
+        GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObject));
+    }
+    
+    TranslationJsonObject->SetArrayField(TEXT("graphs"), GraphsArray);
+    
+    // Add usage information if available
+    if (Response.Usage.InputTokens > 0 || Response.Usage.OutputTokens > 0)
+    {
+        TSharedPtr<FJsonObject> UsageObject = MakeShared<FJsonObject>();
+        UsageObject->SetNumberField(TEXT("input_tokens"), Response.Usage.InputTokens);
+        UsageObject->SetNumberField(TEXT("output_tokens"), Response.Usage.OutputTokens);
+        UsageObject->SetNumberField(TEXT("cached_input_tokens"), Response.Usage.CachedInputTokens);
+        TranslationJsonObject->SetObjectField(TEXT("usage"), UsageObject);
+    }
+    
+    // Serialize to string with pretty printing
+    FString TranslationJsonContent;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&TranslationJsonContent);
+    FJsonSerializer::Serialize(TranslationJsonObject.ToSharedRef(), Writer);
+    
+    FN2CTranslationOutputWriter::Get().Write(FilePath, MoveTemp(TranslationJsonContent));
+}
 
 UN2CLLMModule* UN2CLLMModule::Get()
 {
@@ -29,7 +142,7 @@ UN2CLLMModule* UN2CLLMModule::Get()
     return Instance;
 }
 
-bool UN2CLLMModule::Initialize()
+bool UN2CLLMModule::Initialize(bool bWarmUpConnections)
 {
     CurrentStatus = EN2CSystemStatus::Initializing;
     
@@ -46,190 +159,2334 @@ bool UN2CLLMModule::Initialize()
     Config.Provider = Settings->Provider;
     Config.ApiKey = Settings->GetActiveApiKey();
     Config.Model = Settings->GetActiveModel();
+    Config.bStreamResponses = Settings->bStreamResponses;
+    Config.bUsePromptCaching = Settings->bUsePromptCaching;
 
     // Initialize provider registry
     InitializeProviderRegistry();
 
+    // Picked up again from the settings on the next speculative translation
+    bSpeculativeServiceStale = true;
+
     // Initialize components
     if (!InitializeComponents() || !CreateServiceForProvider(Config.Provider))
     {
         CurrentStatus = EN2CSystemStatus::Error;
         return false;
     }
+    CreateRoutedServices();
 
     bIsInitialized = true;
     CurrentStatus = EN2CSystemStatus::Idle;
     FN2CLogger::Get().Log(TEXT("LLM Module initialized successfully"), EN2CLogSeverity::Info, TEXT("LLMModule"));
+
+    // Translations initialize the module before extracting and serializing, so the connection is
+    // set up while that work runs
+    if (bWarmUpConnections)
+    {
+        WarmUpConnections();
+        StartProbeHeartbeat();
+    }
     return true;
 }
 
+void UN2CLLMModule::WarmUpConnections() const
+{
+    if (const UN2CBaseLLMService* Service = Cast<UN2CBaseLLMService>(ActiveService.GetObject()))
+    {
+        Service->WarmUpConnection();
+    }
+    for (const TPair<EN2CLLMProvider, UObject*>& Pair : RoutedServices)
+    {
+        if (const UN2CBaseLLMService* Service = Cast<UN2CBaseLLMService>(Pair.Value))
+        {
+            Service->WarmUpConnection();
+        }
+    }
+}
+
+void UN2CLLMModule::StartWarmUpHeartbeat()
+{
+    if (WarmUpHeartbeatHandle.IsValid())
+    {
+        return;
+    }
+
+    // Servers of a pool an uneven batch leaves idle would otherwise unload the model before the next batch
+    constexpr float HeartbeatInterval = 60.0f;
+    WarmUpHeartbeatHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakThis = TWeakObjectPtr<UN2CLLMModule>(this)](float DeltaTime)
+        {
+            UN2CLLMModule* Module = WeakThis.Get();
+            if (!Module)
+            {
+                return false;
+            }
+            if (!Module->HasPendingTranslations())
+            {
+                Module->WarmUpHeartbeatHandle.Reset();
+                return false;
+            }
+            Module->WarmUpConnections();
+            return true;
+        }),
+        HeartbeatInterval);
+}
+
+void UN2CLLMModule::StartProbeHeartbeat()
+{
+    LastActivityTime = FPlatformTime::Seconds();
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (ProbeHeartbeatHandle.IsValid() || !Settings || !Settings->bProbeProviderHealth)
+    {
+        return;
+    }
+
+    // Only while in use: probes cost tokens, and data from an idle hour ago says little about the next batch
+    constexpr double IdleSeconds = 900.0;
+    ProbeProviders();
+    ProbeHeartbeatHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([WeakThis = TWeakObjectPtr<UN2CLLMModule>(this), IdleSeconds](float DeltaTime)
+        {
+            UN2CLLMModule* Module = WeakThis.Get();
+            const UN2CSettings* TickSettings = GetDefault<UN2CSettings>();
+            if (!Module)
+            {
+                return false;
+            }
+            if (!TickSettings || !TickSettings->bProbeProviderHealth || FPlatformTime::Seconds() - Module->LastActivityTime > IdleSeconds)
+            {
+                Module->ProbeHeartbeatHandle.Reset();
+                return false;
+            }
+            Module->ProbeProviders();
+            return true;
+        }),
+        Settings->ProviderProbeIntervalSeconds);
+}
+
+void UN2CLLMModule::ProbeProviders()
+{
+    // Providers serving requests are measured by those requests already
+    const FN2CLLMRequestScheduler& Scheduler = FN2CLLMRequestScheduler::Get();
+    for (const EN2CLLMProvider Provider : GetRoutingCandidates())
+    {
+        if (Scheduler.GetQueuedCount(Provider) > 0 || Scheduler.GetActiveCount(Provider) > 0)
+        {
+            continue;
+        }
+
+        const TScriptInterface<IN2CLLMService> Service = GetServiceForProvider(Provider);
+        if (UN2CBaseLLMService* BaseService = Cast<UN2CBaseLLMService>(Service.GetObject()))
+        {
+            BaseService->SendProbe([Provider](const FN2CProviderProbe& Probe)
+            {
+                FN2CLLMRouter::Get().ReportProbe(Provider, Probe);
+            });
+        }
+    }
+}
+
 void UN2CLLMModule::ProcessN2CJson(
     const FString& JsonInput,
-    const FOnLLMResponseReceived& OnComplete)
+    const FOnLLMTranslationComplete& OnComplete,
+    int32 EstimatedJsonTokens,
+    const TSharedPtr<const FN2CTranslationSession>& Session,
+    double EstimatedSeconds,
+    bool bPreferFastestProvider)
 {
-    if (!bIsInitialized)
+    FN2CTranslationTarget Target = GetDefaultTarget();
+    Target.Session = Session;
+    Target.EstimatedSeconds = EstimatedSeconds;
+    Target.bPreferFastestProvider = bPreferFastestProvider;
+    SendN2CJson(JsonInput, Target, OnComplete, EstimatedJsonTokens, true);
+}
+
+void UN2CLLMModule::ProcessN2CJsonForLanguages(
+    const FString& JsonInput,
+    const TArray<EN2CCodeLanguage>& Languages,
+    const FOnLLMLanguageTranslationComplete& OnLanguageComplete,
+    int32 EstimatedJsonTokens,
+    const TSharedPtr<const FN2CTranslationSession>& InSession)
+{
+    if (Languages.Num() == 0)
     {
-        CurrentStatus = EN2CSystemStatus::Error;
-        FN2CLogger::Get().LogError(TEXT("LLM Module not initialized"), TEXT("LLMModule"));
-        const bool bExecuted = OnComplete.ExecuteIfBound(TEXT("{\"error\": \"Module not initialized\"}"));
         return;
     }
 
-    CurrentStatus = EN2CSystemStatus::Processing;
-    
-    // Broadcast that request is being sent
-    OnTranslationRequestSent.Broadcast();
+    const TSharedRef<const FN2CTranslationSession> Session = InSession.IsValid() ? InSession.ToSharedRef() : CreateDefaultSession();
 
-    if (!ActiveService.GetInterface())
+    // One language needs no subfolders, and goes out like any other request
+    if (Languages.Num() == 1)
     {
-        FN2CLogger::Get().LogError(TEXT("No active LLM service"), TEXT("LLMModule"));
-        const bool bExecuted = OnComplete.ExecuteIfBound(TEXT("{\"error\": \"No active service\"}"));
+        FN2CTranslationTarget Target;
+        Target.Language = Languages[0];
+        Target.Session = Session;
+        const EN2CCodeLanguage Language = Target.Language;
+        SendN2CJson(JsonInput, Target, FOnLLMTranslationComplete::CreateLambda(
+            [OnLanguageComplete, Language](const FN2CTranslationResponse& Response, bool bSuccess)
+            {
+                const bool bExecuted = OnLanguageComplete.ExecuteIfBound(Language, Response, bSuccess);
+            }), EstimatedJsonTokens, true);
         return;
     }
 
-    // Get active service
-    TScriptInterface<IN2CLLMService> Service = GetActiveService();
-    if (!Service.GetInterface())
+    // The languages share one translation folder, within a batch or of their own, with the Blueprint files written once
+    FString RootPath = Session->BatchRootPath;
+    if (RootPath.IsEmpty())
     {
-        FN2CLogger::Get().LogError(TEXT("No active service"), TEXT("LLMModule"));
-        return;
+        const FString BlueprintName = Session->Blueprint.IsValid() ? Session->Blueprint->Metadata.Name : FString();
+        RootPath = GenerateTranslationRootPath(BlueprintName.IsEmpty() ? TEXT("UnknownBlueprint") : BlueprintName);
+        if (!EnsureDirectoryExists(RootPath) || (Session->Blueprint.IsValid() && !SaveBlueprintFiles(*Session->Blueprint, RootPath)))
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to create translation directory: %s"), *RootPath), TEXT("LLMModule"));
+        }
     }
 
-    // Check if service supports system prompts
-    bool bSupportsSystemPrompts = false;
-    FString Endpoint, AuthToken;
-    Service->GetConfiguration(Endpoint, AuthToken, bSupportsSystemPrompts);
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Translating to %d languages into %s"), Languages.Num(), *RootPath),
+        EN2CLogSeverity::Info, TEXT("LLMModule"));
+
+    for (int32 Index = 0; Index < Languages.Num(); ++Index)
+    {
+        FN2CTranslationTarget Target;
+        Target.Language = Languages[Index];
+        Target.OutputPath = FPaths::Combine(RootPath, StaticEnum<EN2CCodeLanguage>()->GetNameStringByValue(static_cast<int64>(Target.Language)));
+        Target.bBroadcast = Index == 0;
+        Target.Session = Session;
+
+        const EN2CCodeLanguage Language = Target.Language;
+        SendN2CJson(JsonInput, Target, FOnLLMTranslationComplete::CreateLambda(
+            [OnLanguageComplete, Language](const FN2CTranslationResponse& Response, bool bSuccess)
+            {
+                const bool bExecuted = OnLanguageComplete.ExecuteIfBound(Language, Response, bSuccess);
+            }), EstimatedJsonTokens, true);
+    }
+}
+
+TSharedRef<FN2CTranslationSession> UN2CLLMModule::CreateFolderSession(const TSharedRef<const FN2CBlueprint>& Blueprint)
+{
+    const FString BlueprintName = Blueprint->Metadata.Name.IsEmpty() ? TEXT("UnknownBlueprint") : Blueprint->Metadata.Name;
+    const FString RootPath = GenerateTranslationRootPath(BlueprintName);
+    if (!EnsureDirectoryExists(RootPath) || !SaveBlueprintFiles(*Blueprint, RootPath))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to create translation directory: %s"), *RootPath), TEXT("LLMModule"));
+    }
+
+    TSharedRef<FN2CTranslationSession> Session = MakeShared<FN2CTranslationSession>();
+    Session->BatchRootPath = RootPath;
+    return Session;
+}
+
+void UN2CLLMModule::ProcessN2CJsonQuietly(
+    const FString& JsonInput,
+    const TSharedRef<const FN2CTranslationSession>& Session,
+    const TSharedRef<FN2CCancellationToken>& Token,
+    const FOnLLMTranslationComplete& OnComplete,
+    int32 EstimatedJsonTokens)
+{
+    FN2CTranslationTarget Target = GetDefaultTarget();
+    Target.Session = Session;
+    Target.Token = Token;
+    Target.bBroadcast = false;
+    SendN2CJson(JsonInput, Target, OnComplete, EstimatedJsonTokens, true);
+}
+
+FString UN2CLLMModule::MakeSpeculativeCacheKey(const FString& JsonInput, FString& OutSystemPrompt) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    OutSystemPrompt = BuildSystemPromptForInput(JsonInput, GetDefaultTarget().Language);
+    return FN2CTranslationCache::Get().MakeKey(JsonInput, OutSystemPrompt, GetDefaultTarget().Language,
+        Settings->SpeculativeProvider, Settings->GetSpeculativeModel());
+}
+
+TScriptInterface<IN2CLLMService> UN2CLLMModule::GetSpeculativeService()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings)
+    {
+        return TScriptInterface<IN2CLLMService>();
+    }
 
-    // Get system prompt with language specification
+    if (Settings->SpeculativeProvider == Config.Provider && Settings->GetSpeculativeModel() == Config.Model)
+    {
+        return ActiveService;
+    }
+
+    if (!SpeculativeService || bSpeculativeServiceStale)
+    {
+        // Like a routed provider, with the speculative model and without streaming since nobody watches
+        FN2CLLMConfig ServiceConfig = Config;
+        ServiceConfig.Provider = Settings->SpeculativeProvider;
+        ServiceConfig.ApiKey = Settings->GetApiKey(Settings->SpeculativeProvider);
+        ServiceConfig.Model = Settings->GetSpeculativeModel();
+        ServiceConfig.ApiEndpoint.Empty();
+        ServiceConfig.bStreamResponses = false;
+
+        SpeculativeService = ReconfigureOrCreateService(SpeculativeService, Settings->SpeculativeProvider, ServiceConfig).GetObject();
+        bSpeculativeServiceStale = false;
+    }
+    return SpeculativeService ? TScriptInterface<IN2CLLMService>(SpeculativeService) : TScriptInterface<IN2CLLMService>();
+}
+
+void UN2CLLMModule::PreTranslateN2CJson(const FString& JsonInput)
+{
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    FString SystemPrompt = PromptManager->GetLanguageSpecificPrompt(
-        TEXT("CodeGen"),
-        Settings ? Settings->TargetLanguage : EN2CCodeLanguage::Cpp
-    );
+    if (!bIsInitialized || !Settings || !PromptManager || JsonInput.IsEmpty())
+    {
+        return;
+    }
+
+    FString SystemPrompt;
+    const FString CacheKey = MakeSpeculativeCacheKey(JsonInput, SystemPrompt);
+    FString CachedResponse;
+    if (PendingSpeculativeKeys.Contains(CacheKey) || FN2CTranslationCache::Get().Find(CacheKey, CachedResponse))
+    {
+        return;
+    }
 
-    // Connect the HTTP handler's translation response delegate to our module's delegate
-    if (HttpHandler)
+    if (!GetSpeculativeService().GetInterface())
     {
-        HttpHandler->OnTranslationResponseReceived = OnTranslationResponseReceived;
+        FN2CLogger::Get().LogWarning(TEXT("No service for the speculative provider"), TEXT("LLMModule"));
+        return;
+    }
+
+    N2C_LOG(Debug, TEXT("Queueing speculative translation: %s"), *CacheKey);
+    PendingSpeculativeKeys.Add(CacheKey);
+
+    if (!CancellationToken.IsValid())
+    {
+        CancellationToken = MakeShared<FN2CCancellationToken>();
     }
+    const TSharedRef<FN2CCancellationToken> Token = CancellationToken.ToSharedRef();
+
+    // Speculative requests never touch the translation status, but may be what kept it at Processing
+    const auto Finish = [this, CacheKey](const FSimpleDelegate& OnFinished)
+    {
+        PendingSpeculativeKeys.Remove(CacheKey);
+        OnFinished.ExecuteIfBound();
+        if (CurrentStatus == EN2CSystemStatus::Processing && !FN2CLLMRequestScheduler::Get().HasPendingRequests())
+        {
+            CurrentStatus = EN2CSystemStatus::Idle;
+        }
+    };
 
-    // Send request through service
-    ActiveService->SendRequest(JsonInput, SystemPrompt, FOnLLMResponseReceived::CreateLambda(
-        [this](const FString& Response)
+    FN2CLLMRequestScheduler::Get().EnqueueRequest(Settings->SpeculativeProvider,
+        [this, JsonInput, SystemPrompt, CacheKey, Token, Finish](const FSimpleDelegate& OnFinished)
         {
-            // Create translation response struct
-            FN2CTranslationResponse TranslationResponse;
-            
-            // Get active service's response parser
-            TScriptInterface<IN2CLLMService> ActiveServiceParser = GetActiveService();
-            if (ActiveServiceParser.GetInterface())
+            TScriptInterface<IN2CLLMService> Service = GetSpeculativeService();
+            if (Token->IsCancelled() || !Service.GetInterface())
+            {
+                Finish(OnFinished);
+                return;
+            }
+
+            TSharedRef<FN2CHttpRequestHandle> Handle = MakeShared<FN2CHttpRequestHandle>();
+            TSharedRef<bool> bCompleted = MakeShared<bool>(false);
+            Handle->OnCancelled = FSimpleDelegate::CreateLambda([OnFinished, Finish, bCompleted]()
             {
-                UN2CResponseParserBase* Parser = ActiveServiceParser->GetResponseParser();
-                if (Parser)
+                if (!*bCompleted)
+                {
+                    *bCompleted = true;
+                    Finish(OnFinished);
+                }
+            });
+            Token->Track(Handle);
+
+            UObject* ServiceObject = Service.GetObject();
+            Service->SendStreamingRequest(JsonInput, SystemPrompt, FOnLLMStreamChunkReceived(), FOnLLMResponseReceived::CreateLambda(
+                [CacheKey, OnFinished, Finish, bCompleted, ServiceObject](const FString& Response)
                 {
-                    if (Parser->ParseLLMResponse(Response, TranslationResponse))
+                    if (*bCompleted)
                     {
-                        CurrentStatus = EN2CSystemStatus::Idle;
-                            
-                        // Save translation to disk
-                        const FN2CBlueprint& Blueprint = FN2CNodeTranslator::Get().GetN2CBlueprint();
-                        if (SaveTranslationToDisk(TranslationResponse, Blueprint))
-                        {
-                            FN2CLogger::Get().Log(TEXT("Successfully saved translation to disk"), EN2CLogSeverity::Info);
-                        }
-                            
-                        OnTranslationResponseReceived.Broadcast(TranslationResponse, true);
-                        FN2CLogger::Get().Log(TEXT("Successfully parsed LLM response"), EN2CLogSeverity::Info);
+                        return;
                     }
-                    else
+                    *bCompleted = true;
+                    Finish(OnFinished);
+
+                    // Only keep responses the speculative provider's parser can read
+                    const IN2CLLMService* ResponseService = Cast<IN2CLLMService>(ServiceObject);
+                    UN2CResponseParserBase* Parser = ResponseService ? ResponseService->GetResponseParser() : nullptr;
+                    FN2CTranslationResponse TranslationResponse;
+                    if (Parser && Parser->ParseLLMResponse(Response, TranslationResponse))
                     {
-                        CurrentStatus = EN2CSystemStatus::Error;
-                        FN2CLogger::Get().LogError(TEXT("Failed to parse LLM response"));
-                        OnTranslationResponseReceived.Broadcast(TranslationResponse, false);
+                        FN2CTranslationCache::Get().Store(CacheKey, Response);
+                        N2C_LOG(Info, TEXT("Speculative translation cached: %s"), *CacheKey);
                     }
-                }
-                else
-                {
-                    CurrentStatus = EN2CSystemStatus::Error;
-                    FN2CLogger::Get().LogError(TEXT("No response parser available"));
-                    OnTranslationResponseReceived.Broadcast(TranslationResponse, false);
-                }
-            }
-            else
-            {
-                CurrentStatus = EN2CSystemStatus::Error;
-                FN2CLogger::Get().LogError(TEXT("No active LLM service"));
-                OnTranslationResponseReceived.Broadcast(TranslationResponse, false);
-            }
-        }));
+                }), Handle);
+        }, Token, 0.0, EN2CRequestPriority::Speculative);
 }
 
-bool UN2CLLMModule::InitializeComponents()
+bool UN2CLLMModule::DeliverSpeculativeTranslation(
+    const FString& JsonInput,
+    const FOnLLMTranslationComplete& OnComplete,
+    const TSharedPtr<const FN2CTranslationSession>& Session)
 {
-    // Create and initialize prompt manager
-    PromptManager = NewObject<UN2CSystemPromptManager>(this);
-    if (!PromptManager)
+    if (!bIsInitialized || !PromptManager)
     {
-        FN2CLogger::Get().LogError(TEXT("Failed to create prompt manager"), TEXT("LLMModule"));
         return false;
     }
-    PromptManager->Initialize(Config);
 
-    // Note: HTTP Handler and Response Parser will be created by the specific service
+    FString SystemPrompt;
+    FString CachedResponse;
+    if (!FN2CTranslationCache::Get().Find(MakeSpeculativeCacheKey(JsonInput, SystemPrompt), CachedResponse))
+    {
+        return false;
+    }
+
+    TScriptInterface<IN2CLLMService> Service = GetSpeculativeService();
+    UN2CResponseParserBase* Parser = Service.GetInterface() ? Service->GetResponseParser() : nullptr;
+    FN2CTranslationResponse TranslationResponse;
+    if (!Parser || !Parser->ParseLLMResponse(CachedResponse, TranslationResponse))
+    {
+        return false;
+    }
+
+    FN2CLogger::Get().Log(TEXT("Showing the speculative translation"), EN2CLogSeverity::Info, TEXT("LLMModule"));
+    OnTranslationRequestSent.Broadcast();
+    FN2CTranslationTarget Target = GetDefaultTarget();
+    Target.Session = Session.IsValid() ? Session : CreateDefaultSession();
+    FinishLLMResponse(TranslationResponse, Target, true, true);
+    const bool bExecuted = OnComplete.ExecuteIfBound(TranslationResponse, true);
     return true;
 }
 
-void UN2CLLMModule::OpenTranslationFolder(bool& Success)
+void UN2CLLMModule::ProcessN2CJsonParts(
+    const TArray<FString>& PartJsons,
+    const TArray<int32>& PartEstimatedTokens,
+    const FOnLLMTranslationComplete& OnComplete,
+    const TSharedPtr<const FN2CTranslationSession>& Session,
+    double EstimatedSeconds,
+    bool bPreferFastestProvider)
 {
-    FString PathToOpen = LatestTranslationPath;
-    
-    if (PathToOpen.IsEmpty())
+    if (PartJsons.Num() == 0)
     {
-        FN2CLogger::Get().LogWarning(TEXT("No translation path available, opening the base path"));
-        Success = true;
-        PathToOpen = GetTranslationBasePath();
+        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+        return;
     }
 
-    if (!FPaths::DirectoryExists(PathToOpen))
+    // Every part, and the stitched translation, belongs to the same session
+    FN2CTranslationTarget Target = GetDefaultTarget();
+    Target.Session = Session.IsValid() ? Session : CreateDefaultSession();
+    Target.EstimatedSeconds = EstimatedSeconds;
+    Target.bPreferFastestProvider = bPreferFastestProvider;
+
+    struct FPartResults
     {
-        FN2CLogger::Get().LogError(FString::Printf(TEXT("Translation directory does not exist: %s \n\nOpening the base path"), *PathToOpen));
-        Success = true;
-        PathToOpen = GetTranslationBasePath();
+        TArray<FN2CTranslationResponse> Responses;
+        int32 Remaining = 0;
+        bool bFailed = false;
+    };
+    TSharedRef<FPartResults> Results = MakeShared<FPartResults>();
+    Results->Responses.SetNum(PartJsons.Num());
+    Results->Remaining = PartJsons.Num();
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Sending graph as %d partial requests"), PartJsons.Num()),
+        EN2CLogSeverity::Info, TEXT("LLMModule"));
+
+    for (int32 PartIndex = 0; PartIndex < PartJsons.Num(); ++PartIndex)
+    {
+        const int32 EstimatedTokens = PartEstimatedTokens.IsValidIndex(PartIndex) ? PartEstimatedTokens[PartIndex] : INDEX_NONE;
+        SendN2CJson(PartJsons[PartIndex], Target, FOnLLMTranslationComplete::CreateLambda(
+            [this, Results, PartIndex, OnComplete, Target](const FN2CTranslationResponse& PartResponse, bool bSuccess)
+            {
+                if (bSuccess)
+                {
+                    Results->Responses[PartIndex] = PartResponse;
+                }
+                else
+                {
+                    Results->bFailed = true;
+                }
+
+                if (--Results->Remaining > 0)
+                {
+                    return;
+                }
+
+                // Part failures were already reported as they came in
+                if (Results->bFailed)
+                {
+                    FN2CLogger::Get().LogError(TEXT("Failed to translate one or more parts of a split graph"), TEXT("LLMModule"));
+                    const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                    return;
+                }
+
+                FN2CTranslationResponse Stitched;
+                StitchPartTranslations(Results->Responses, Stitched);
+                DeliverTranslation(Stitched, Target);
+                const bool bExecuted = OnComplete.ExecuteIfBound(Stitched, true);
+            }), EstimatedTokens, false);
     }
+}
 
-#if PLATFORM_WINDOWS
-    FPlatformProcess::ExploreFolder(*PathToOpen);
-    Success = true;
-#endif
-#if PLATFORM_MAC
-    FMacPlatformProcess::ExploreFolder(*PathToOpen);
-    Success = true;
-#endif
+TFuture<FN2CTranslationResult> UN2CLLMModule::TranslateN2CJson(
+    const FString& JsonInput,
+    int32 EstimatedJsonTokens,
+    const TSharedPtr<const FN2CTranslationSession>& Session,
+    double EstimatedSeconds,
+    bool bPreferFastestProvider)
+{
+    TSharedRef<TPromise<FN2CTranslationResult>> Promise = MakeShared<TPromise<FN2CTranslationResult>>();
+    TFuture<FN2CTranslationResult> Future = Promise->GetFuture();
+    ProcessN2CJson(JsonInput, MakePromiseDelegate(Promise), EstimatedJsonTokens, Session, EstimatedSeconds, bPreferFastestProvider);
+    return Future;
+}
+
+TFuture<FN2CTranslationResult> UN2CLLMModule::TranslateN2CJsonParts(
+    const TArray<FString>& PartJsons,
+    const TArray<int32>& PartEstimatedTokens,
+    const TSharedPtr<const FN2CTranslationSession>& Session,
+    double EstimatedSeconds,
+    bool bPreferFastestProvider)
+{
+    TSharedRef<TPromise<FN2CTranslationResult>> Promise = MakeShared<TPromise<FN2CTranslationResult>>();
+    TFuture<FN2CTranslationResult> Future = Promise->GetFuture();
+    ProcessN2CJsonParts(PartJsons, PartEstimatedTokens, MakePromiseDelegate(Promise), Session, EstimatedSeconds, bPreferFastestProvider);
+    return Future;
+}
+
+bool UN2CLLMModule::SubmitBatchJob(TArray<FN2CBatchJobItem>&& Items, const FSimpleDelegate& OnJobsEnded)
+{
+    const EN2CLLMProvider Provider = Config.Provider;
+    UN2CBaseLLMService* Service = Cast<UN2CBaseLLMService>(ActiveService.GetObject());
+    if (!bIsInitialized || !Service)
+    {
+        FN2CLogger::Get().LogError(TEXT("LLM Module not initialized"), TEXT("LLMModule"));
+        return false;
+    }
+    if (!FN2CProviderBatchJob::SupportsProvider(Provider))
+    {
+        FN2CLogger::Get().LogError(
+            FString::Printf(TEXT("%s has no batch API, only Anthropic and OpenAI can run batch jobs"), *UEnum::GetValueAsString(Provider)),
+            TEXT("LLMModule"));
+        return false;
+    }
+
+    CurrentStatus = EN2CSystemStatus::Processing;
+    OnTranslationRequestSent.Broadcast();
+
+    FString Endpoint, AuthToken;
+    bool bSupportsSystemPrompts = false;
+    Service->GetConfiguration(Endpoint, AuthToken, bSupportsSystemPrompts);
+    TMap<FString, FString> Headers;
+    Service->GetProviderHeaders(Headers);
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bUseCache = Settings && Settings->bUseTranslationCache;
+    const FString Model = GetModelForProvider(Provider);
+
+    const int32 NumItems = Items.Num();
+    TSharedRef<TArray<FN2CBatchJobItem>> SharedItems = MakeShared<TArray<FN2CBatchJobItem>>(MoveTemp(Items));
+    TSharedRef<TArray<FString>> Responses = MakeShared<TArray<FString>>();
+    Responses->SetNum(NumItems);
+    TSharedRef<TArray<FString>> CacheKeys = MakeShared<TArray<FString>>();
+    CacheKeys->SetNum(NumItems);
+
+    // Split into jobs within the provider's request count and size limits. Cached graphs are
+    // answered from the cache and never submitted
+    struct FJobChunk
+    {
+        TArray<int32> ItemIndices;
+        TArray<FString> Bodies;
+        int64 Size = 0;
+    };
+    TArray<FJobChunk> Chunks;
+
+    const int32 MaxRequests = FN2CProviderBatchJob::GetMaxRequests(Provider);
+    const int64 MaxSize = FN2CProviderBatchJob::GetMaxPayloadSize(Provider);
+    int32 CacheHits = 0;
+    for (int32 Index = 0; Index < NumItems; ++Index)
+    {
+        const FString& JsonInput = (*SharedItems)[Index].JsonInput;
+        const FString SystemPrompt = BuildSystemPromptForInput(JsonInput, Settings->TargetLanguage);
+
+        if (bUseCache)
+        {
+            FN2CTranslationCache& Cache = FN2CTranslationCache::Get();
+            (*CacheKeys)[Index] = Cache.MakeKey(JsonInput, SystemPrompt, Settings->TargetLanguage, Provider, Model);
+            if (Cache.Find((*CacheKeys)[Index], (*Responses)[Index]))
+            {
+                ++CacheHits;
+                continue;
+            }
+        }
+
+        FString Body = Service->BuildBatchRequestBody(JsonInput, SystemPrompt);
+        if (Body.IsEmpty())
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to build batch request %d"), Index), TEXT("LLMModule"));
+            continue;
+        }
+
+        if (Chunks.Num() == 0 || Chunks.Last().ItemIndices.Num() >= MaxRequests || Chunks.Last().Size + Body.Len() > MaxSize)
+        {
+            Chunks.AddDefaulted();
+        }
+        FJobChunk& Chunk = Chunks.Last();
+        Chunk.ItemIndices.Add(Index);
+        Chunk.Size += Body.Len();
+        Chunk.Bodies.Add(MoveTemp(Body));
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Submitting %d requests in %d %s batch jobs (%d from the translation cache)"),
+            NumItems - CacheHits, Chunks.Num(), *UEnum::GetValueAsString(Provider), CacheHits),
+        EN2CLogSeverity::Info, TEXT("LLMModule"));
+
+    if (Chunks.Num() == 0)
+    {
+        FinishBatchJob(*SharedItems, *Responses, *CacheKeys, Provider, OnJobsEnded);
+        return true;
+    }
+
+    // Jobs are registered before any starts, since a job that fails to submit calls back at once
+    TSharedRef<int32> JobsRemaining = MakeShared<int32>(Chunks.Num());
+    TArray<TSharedPtr<FN2CProviderBatchJob>> Jobs;
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        Jobs.Add(MakeShared<FN2CProviderBatchJob>(Provider, Endpoint, Headers));
+    }
+    BatchJobs.Append(Jobs);
+
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        const FN2CProviderBatchJob* JobPtr = Jobs[ChunkIndex].Get();
+        Jobs[ChunkIndex]->Start(MoveTemp(Chunks[ChunkIndex].Bodies),
+            [this, JobPtr, ItemIndices = MoveTemp(Chunks[ChunkIndex].ItemIndices), SharedItems, Responses, CacheKeys, JobsRemaining, Provider, OnJobsEnded]
+            (const TArray<FString>& ResponseBodies)
+            {
+                for (int32 Result = 0; Result < ItemIndices.Num() && Result < ResponseBodies.Num(); ++Result)
+                {
+                    (*Responses)[ItemIndices[Result]] = ResponseBodies[Result];
+                }
+                BatchJobs.RemoveAll([JobPtr](const TSharedPtr<FN2CProviderBatchJob>& Job) { return Job.Get() == JobPtr; });
+
+                if (--(*JobsRemaining) == 0)
+                {
+                    FinishBatchJob(*SharedItems, *Responses, *CacheKeys, Provider, OnJobsEnded);
+                }
+            });
+    }
+    return true;
+}
+
+void UN2CLLMModule::FinishBatchJob(
+    const TArray<FN2CBatchJobItem>& Items,
+    const TArray<FString>& ResponseBodies,
+    const TArray<FString>& CacheKeys,
+    EN2CLLMProvider Provider,
+    const FSimpleDelegate& OnJobsEnded)
+{
+    // Large batches parse in parallel; saving and reporting stay on the game thread, in item order
+    ParseLLMResponsesAsync(TArray<FString>(ResponseBodies), Provider,
+        [this, Items, CacheKeys, OnJobsEnded](TArray<FParsedResponse>&& Results)
+        {
+            FString OpenBatchName;
+            for (int32 Index = 0; Index < Items.Num(); ++Index)
+            {
+                const FN2CBatchJobItem& Item = Items[Index];
+                if (Item.BatchName != OpenBatchName)
+                {
+                    if (!OpenBatchName.IsEmpty())
+                    {
+                        EndBatchTranslation();
+                    }
+                    OpenBatchName = Item.BatchName;
+                    if (!OpenBatchName.IsEmpty())
+                    {
+                        BeginBatchTranslation(OpenBatchName);
+                    }
+                }
+
+                const FParsedResponse& Result = Results[Index];
+                FinishLLMResponse(Result.TranslationResponse, GetDefaultTarget(), Result.bParsed, true);
+
+                if (Result.bParsed && !CacheKeys[Index].IsEmpty())
+                {
+                    FN2CTranslationCache::Get().Store(CacheKeys[Index], Result.Response);
+                }
+                const bool bExecuted = Item.OnComplete.ExecuteIfBound(Result.TranslationResponse, Result.bParsed);
+            }
+
+            if (!OpenBatchName.IsEmpty())
+            {
+                EndBatchTranslation();
+            }
+
+            const bool bExecuted = OnJobsEnded.ExecuteIfBound();
+        });
+}
+
+void UN2CLLMModule::CancelTranslations()
+{
+    if (!CancellationToken.IsValid() && RequestTokens.Num() == 0 && BatchJobs.Num() == 0)
+    {
+        return;
+    }
+
+    FN2CLogger::Get().Log(TEXT("Cancelling translation requests"), EN2CLogSeverity::Info, TEXT("LLMModule"));
+
+    // Requests made from here on start under a fresh token
+    if (CancellationToken.IsValid())
+    {
+        const TSharedPtr<FN2CCancellationToken> Token = MoveTemp(CancellationToken);
+        Token->Cancel();
+    }
+    for (const TWeakPtr<FN2CCancellationToken>& Tracked : RequestTokens)
+    {
+        if (const TSharedPtr<FN2CCancellationToken> Token = Tracked.Pin())
+        {
+            Token->Cancel();
+        }
+    }
+    RequestTokens.Reset();
+    FN2CLLMRequestScheduler::Get().DrainCancelledRequests();
+
+    // Cancelled jobs fail their items straight away, which removes them from BatchJobs
+    const TArray<TSharedPtr<FN2CProviderBatchJob>> Jobs = BatchJobs;
+    for (const TSharedPtr<FN2CProviderBatchJob>& Job : Jobs)
+    {
+        Job->Cancel();
+    }
+
+    CurrentStatus = EN2CSystemStatus::Idle;
+    BroadcastTranslationResult(MakeShared<const FN2CTranslationResponse>(), false);
+}
+
+bool UN2CLLMModule::HasPendingTranslations() const
+{
+    return FN2CLLMRequestScheduler::Get().HasPendingRequests() || BatchJobs.Num() > 0;
+}
+
+double UN2CLLMModule::GetRequestDeadlineSeconds(int32 EstimatedInputTokens) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings || Settings->RequestDeadlineBaseSeconds <= 0.0f)
+    {
+        return 0.0;
+    }
+
+    const double Deadline = Settings->RequestDeadlineBaseSeconds
+        + FMath::Max(0, EstimatedInputTokens) / 1000.0 * Settings->RequestDeadlineSecondsPerThousandTokens;
+    return Config.TimeoutSeconds > 0.0f ? FMath::Min<double>(Deadline, Config.TimeoutSeconds) : Deadline;
+}
+
+int32 UN2CLLMModule::EstimateSystemPromptTokens(bool bCompactInput) const
+{
+    return PromptManager ? FN2CTokenEstimator::EstimateTokens(BuildSystemPrompt(bCompactInput, GetDefaultTarget().Language), Config.Provider) : 0;
+}
+
+bool UN2CLLMModule::HasCachedTranslation(const FString& JsonInput) const
+{
+    if (!PromptManager)
+    {
+        return false;
+    }
+
+    const EN2CCodeLanguage Language = GetDefaultTarget().Language;
+    const FString SystemPrompt = BuildSystemPromptForInput(JsonInput, Language);
+    const FN2CTranslationCache& Cache = FN2CTranslationCache::Get();
+    for (const EN2CLLMProvider Provider : GetRoutingCandidates())
+    {
+        if (Cache.Contains(Cache.MakeKey(JsonInput, SystemPrompt, Language, Provider, GetModelForProvider(Provider))))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TSharedRef<FN2CTranslationSession> UN2CLLMModule::CreateSession(const TSharedPtr<const FN2CBlueprint>& Blueprint) const
+{
+    TSharedRef<FN2CTranslationSession> Session = MakeShared<FN2CTranslationSession>();
+    Session->Blueprint = Blueprint;
+    Session->BatchRootPath = CurrentBatchRootPath;
+    return Session;
+}
+
+TSharedRef<FN2CTranslationSession> UN2CLLMModule::CreateDefaultSession() const
+{
+    return CreateSession(CurrentBatchRootPath.IsEmpty()
+        ? MakeShared<const FN2CBlueprint>(FN2CNodeTranslator::Get().GetN2CBlueprint())
+        : TSharedPtr<const FN2CBlueprint>());
+}
+
+FN2CTranslationTarget UN2CLLMModule::GetDefaultTarget()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    FN2CTranslationTarget Target;
+    Target.Language = Settings ? Settings->TargetLanguage : EN2CCodeLanguage::Cpp;
+    return Target;
+}
+
+FString UN2CLLMModule::BuildSystemPrompt(bool bCompactInput, EN2CCodeLanguage Language, bool bDeltaInput, bool bCalleeDeclarations, bool bSharedMacros) const
+{
+    FString SystemPrompt = PromptManager->GetLanguageSpecificPrompt(TEXT("CodeGen"), Language);
+
+    if (bCompactInput)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("CompactDialect"));
+    }
+
+    if (bDeltaInput)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("DeltaTranslation"));
+    }
+
+    if (bCalleeDeclarations)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("CalleeDeclarations"));
+    }
+
+    if (bSharedMacros)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("SharedMacros"));
+    }
+
+    // The response format sections come last, since they override the format the language prompt describes
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && Settings->bUseCompactResponses)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("CompactResponse"));
+    }
+
+    if (Settings && Settings->bSkipImplementationNotes)
+    {
+        SystemPrompt += TEXT("\n\n");
+        SystemPrompt += PromptManager->GetSystemPrompt(TEXT("SkipImplementationNotes"));
+    }
+
+    return SystemPrompt;
+}
+
+TSharedPtr<const TMap<FString, FString>> UN2CLLMModule::FindKnownDeclarations(const FString& JsonInput)
+{
+    if (!JsonInput.Left(32).Contains(FN2CVersion::DeltaValue()))
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FJsonObject> DeltaObject;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonInput);
+    const TSharedPtr<FJsonObject>* PreviousCode = nullptr;
+    FString GraphName, Declaration;
+    if (!FJsonSerializer::Deserialize(Reader, DeltaObject) || !DeltaObject.IsValid()
+        || !DeltaObject->TryGetStringField(TEXT("graph_name"), GraphName)
+        || !DeltaObject->TryGetObjectField(TEXT("previous_code"), PreviousCode)
+        || !(*PreviousCode)->TryGetStringField(TEXT("graphDeclaration"), Declaration) || Declaration.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    TSharedRef<TMap<FString, FString>> Declarations = MakeShared<TMap<FString, FString>>();
+    Declarations->Add(GraphName, Declaration);
+    return Declarations;
+}
+
+FString UN2CLLMModule::BuildSystemPromptForInput(const FString& JsonInput, EN2CCodeLanguage Language) const
+{
+    const FString Head = JsonInput.Left(32);
+
+    // Declarations are appended last, so searching from the end finds them after at most their own length
+    const bool bCalleeDeclarations = JsonInput.Find(TEXT("\"callee_declarations\":"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) != INDEX_NONE;
+    const bool bSharedMacros = JsonInput.Find(TEXT("\"shared_macros\":"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) != INDEX_NONE;
+    return BuildSystemPrompt(Head.Contains(FN2CVersion::CompactValue()), Language, Head.Contains(FN2CVersion::DeltaValue()), bCalleeDeclarations, bSharedMacros);
+}
+
+void UN2CLLMModule::SendN2CJson(
+    const FString& JsonInput,
+    const FN2CTranslationTarget& InTarget,
+    const FOnLLMTranslationComplete& OnComplete,
+    int32 EstimatedJsonTokens,
+    bool bDeliverResponse)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CSendJson);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    // Pin the Blueprint and batch folder now; the response may arrive after others have started
+    FN2CTranslationTarget Target = InTarget;
+    if (!Target.Session.IsValid())
+    {
+        Target.Session = CreateDefaultSession();
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings && Settings->bUseCompactResponses && !Target.KnownDeclarations.IsValid())
+    {
+        Target.KnownDeclarations = FindKnownDeclarations(JsonInput);
+    }
+
+    if (!bIsInitialized)
+    {
+        CurrentStatus = EN2CSystemStatus::Error;
+        FN2CLogger::Get().LogError(TEXT("LLM Module not initialized"), TEXT("LLMModule"));
+        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+        return;
+    }
+
+    CurrentStatus = EN2CSystemStatus::Processing;
+    
+    // Broadcast that request is being sent
+    OnTranslationRequestSent.Broadcast();
+
+    if (!ActiveService.GetInterface())
+    {
+        FN2CLogger::Get().LogError(TEXT("No active LLM service"), TEXT("LLMModule"));
+        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+        return;
+    }
+
+    // Get active service
+    TScriptInterface<IN2CLLMService> Service = GetActiveService();
+    if (!Service.GetInterface())
+    {
+        FN2CLogger::Get().LogError(TEXT("No active service"), TEXT("LLMModule"));
+        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+        return;
+    }
+
+    // Check if service supports system prompts
+    bool bSupportsSystemPrompts = false;
+    FString Endpoint, AuthToken;
+    Service->GetConfiguration(Endpoint, AuthToken, bSupportsSystemPrompts);
+
+    // Get system prompt with language specification. Compact and delta input open with their version
+    // markers and need their legends to be readable
+    const FString SystemPrompt = BuildSystemPromptForInput(JsonInput, Target.Language);
+
+    // Route the HTTP handler's failed requests to our module's delegates
+    if (HttpHandler && !HttpHandler->OnTranslationResultReady.IsBoundToObject(this))
+    {
+        HttpHandler->OnTranslationResultReady.AddUObject(this, &UN2CLLMModule::BroadcastTranslationResult);
+    }
+
+    // Serve unchanged graphs from the translation cache without an HTTP round trip. A response is
+    // cached under the provider that produced it, since only that provider's parser can read it
+    if (Settings && Settings->bUseTranslationCache)
+    {
+        FN2CTranslationCache& Cache = FN2CTranslationCache::Get();
+        const TArray<EN2CLLMProvider> Candidates = GetRoutingCandidates();
+        TArray<FString> CacheKeys;
+        for (const EN2CLLMProvider Provider : Candidates)
+        {
+            const FString& CacheKey = CacheKeys.Add_GetRef(Cache.MakeKey(JsonInput, SystemPrompt, Target.Language, Provider, GetModelForProvider(Provider)));
+
+            FString CachedResponse;
+            if (Cache.Find(CacheKey, CachedResponse))
+            {
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Translation cache hit: %s"), *CacheKey),
+                    EN2CLogSeverity::Info, TEXT("LLMModule"));
+                RequestMetrics.RecordCacheHit();
+                FN2CTelemetry::Get().Increment(TEXT("CacheHits"));
+                FN2CTranslationResponse TranslationResponse;
+                const bool bParsed = HandleLLMResponse(CachedResponse, Provider, Target, TranslationResponse, bDeliverResponse);
+                const bool bExecuted = OnComplete.ExecuteIfBound(TranslationResponse, bParsed);
+                return;
+            }
+        }
+
+        // Teammates may have paid for the translation already. The lookup finishes before the request would
+        // enter the scheduler, so it holds none of the provider's slots while it waits
+        if (Settings->bShareTranslationCache)
+        {
+            const TSharedRef<FN2CCancellationToken> Token = GetRequestToken(Target);
+            TWeakObjectPtr<UN2CLLMModule> WeakThis(this);
+            Cache.FindShared(CacheKeys, [WeakThis, Token, Candidates, JsonInput, SystemPrompt, Target, OnComplete, EstimatedJsonTokens, bDeliverResponse]
+                (int32 HitIndex, const FString& CachedResponse)
+                {
+                    UN2CLLMModule* Module = WeakThis.Get();
+                    if (!Module || Token->IsCancelled())
+                    {
+                        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                        return;
+                    }
+
+                    if (HitIndex == INDEX_NONE)
+                    {
+                        Module->SendUncachedN2CJson(JsonInput, SystemPrompt, Target, OnComplete, EstimatedJsonTokens, bDeliverResponse);
+                        return;
+                    }
+
+                    Module->RequestMetrics.RecordCacheHit();
+                    FN2CTelemetry::Get().Increment(TEXT("CacheHits"));
+                    FN2CTranslationResponse TranslationResponse;
+                    const bool bParsed = Module->HandleLLMResponse(CachedResponse, Candidates[HitIndex], Target, TranslationResponse, bDeliverResponse);
+                    const bool bExecuted = OnComplete.ExecuteIfBound(TranslationResponse, bParsed);
+                });
+            return;
+        }
+    }
+
+    SendUncachedN2CJson(JsonInput, SystemPrompt, Target, OnComplete, EstimatedJsonTokens, bDeliverResponse);
+}
+
+TSharedRef<FN2CCancellationToken> UN2CLLMModule::GetRequestToken(const FN2CTranslationTarget& Target)
+{
+    if (!CancellationToken.IsValid())
+    {
+        CancellationToken = MakeShared<FN2CCancellationToken>();
+    }
+
+    // A request with its own token is still cancelled with the rest
+    if (!Target.Token.IsValid())
+    {
+        return CancellationToken.ToSharedRef();
+    }
+
+    RequestTokens.RemoveAll([](const TWeakPtr<FN2CCancellationToken>& Tracked) { return !Tracked.IsValid(); });
+    RequestTokens.AddUnique(Target.Token);
+    return Target.Token.ToSharedRef();
+}
+
+void UN2CLLMModule::SendUncachedN2CJson(
+    const FString& JsonInput,
+    const FString& SystemPrompt,
+    const FN2CTranslationTarget& Target,
+    const FOnLLMTranslationComplete& OnComplete,
+    int32 EstimatedJsonTokens,
+    bool bDeliverResponse)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+
+    if (EstimatedJsonTokens == INDEX_NONE)
+    {
+        EstimatedJsonTokens = FN2CTokenEstimator::EstimateTokens(JsonInput, Config.Provider);
+    }
+    const int32 EstimatedInputTokens = EstimatedJsonTokens
+        + FN2CTokenEstimator::EstimateTokens(SystemPrompt, Config.Provider)
+        + (Settings ? Settings->EstimatedReferenceTokens : 0);
+
+    // Catch requests that cannot fit the model's context here rather than after a long upload
+    const int32 ContextWindow = Settings ? FN2CTokenEstimator::GetContextWindow(*Settings) : 0;
+    if (ContextWindow > 0)
+    {
+        const int32 InputBudget = FN2CTokenEstimator::GetInputBudget(ContextWindow);
+
+        if (EstimatedInputTokens > InputBudget)
+        {
+            CurrentStatus = EN2CSystemStatus::Error;
+            FN2CLogger::Get().LogError(
+                FString::Printf(TEXT("Request of ~%d input tokens exceeds the %d token input budget of %s (context window %d)"),
+                    EstimatedInputTokens, InputBudget, *Config.Model, ContextWindow),
+                TEXT("LLMModule"));
+            const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+            return;
+        }
+
+        if (EstimatedInputTokens > InputBudget * 0.9f)
+        {
+            FN2CLogger::Get().LogWarning(
+                FString::Printf(TEXT("Request of ~%d input tokens is close to the %d token input budget of %s"),
+                    EstimatedInputTokens, InputBudget, *Config.Model),
+                TEXT("LLMModule"));
+        }
+    }
+
+    const TSharedRef<FN2CCancellationToken> Token = GetRequestToken(Target);
+
+    // A second Translate click, or a copy of a graph earlier in the batch, joins the identical request already
+    // queued or in flight and is delivered its parsed response into its own target
+    const FString FlightKey = FN2CTranslationCache::Get().MakeKey(JsonInput, SystemPrompt, Target.Language, Config.Provider, Config.Model);
+    if (TArray<FCoalescedRequest>* Followers = InFlightRequests.Find(FlightKey))
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Joining identical request already in flight: %s"), *FlightKey),
+            EN2CLogSeverity::Debug, TEXT("LLMModule"));
+        Followers->Add({ JsonInput, SystemPrompt, Target, OnComplete, EstimatedJsonTokens, bDeliverResponse, Token });
+        return;
+    }
+    InFlightRequests.Add(FlightKey);
+
+    TWeakObjectPtr<UN2CLLMModule> WeakThis(this);
+    const FOnLLMTranslationComplete OnLeaderComplete = FOnLLMTranslationComplete::CreateLambda(
+        [WeakThis, FlightKey, OnComplete, Token](const FN2CTranslationResponse& Response, bool bSuccess)
+        {
+            // Taken out first so a request made from the callbacks starts a flight of its own
+            UN2CLLMModule* Module = WeakThis.Get();
+            TArray<FCoalescedRequest> Followers;
+            if (Module)
+            {
+                Module->InFlightRequests.RemoveAndCopyValue(FlightKey, Followers);
+            }
+
+            const bool bExecuted = OnComplete.ExecuteIfBound(Response, bSuccess);
+            if (!WeakThis.IsValid())
+            {
+                return;
+            }
+
+            for (const FCoalescedRequest& Follower : Followers)
+            {
+                if (Follower.Token->IsCancelled())
+                {
+                    const bool bFollowerExecuted = Follower.OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                }
+                else if (!bSuccess && Token->IsCancelled())
+                {
+                    // Only the request they joined was cancelled; the first of them sends it again for the rest
+                    Module->SendUncachedN2CJson(Follower.JsonInput, Follower.SystemPrompt, Follower.Target, Follower.OnComplete,
+                        Follower.EstimatedJsonTokens, Follower.bDeliverResponse);
+                }
+                else if (bSuccess)
+                {
+                    Module->FinishLLMResponse(Response, Follower.Target, true, Follower.bDeliverResponse);
+                    const bool bFollowerExecuted = Follower.OnComplete.ExecuteIfBound(Response, true);
+                }
+                else
+                {
+                    // The failure was broadcast with the request they joined
+                    const bool bFollowerExecuted = Follower.OnComplete.ExecuteIfBound(Response, false);
+                }
+            }
+        });
+
+    // Drafts only help when they come from a different, faster model
+    if (Settings && Settings->bDraftThenRefine
+        && (Settings->SpeculativeProvider != Config.Provider || Settings->GetSpeculativeModel() != Config.Model)
+        && GetSpeculativeService().GetInterface())
+    {
+        DispatchDraftN2CJson(JsonInput, SystemPrompt, Target, OnLeaderComplete, bDeliverResponse,
+            Token, GetRequestDeadlineSeconds(EstimatedInputTokens));
+        return;
+    }
+
+    DispatchN2CJson(JsonInput, SystemPrompt, Target, OnLeaderComplete, bDeliverResponse, TSet<EN2CLLMProvider>(),
+        Token, GetRequestDeadlineSeconds(EstimatedInputTokens));
+}
+
+void UN2CLLMModule::DispatchDraftN2CJson(
+    const FString& JsonInput,
+    const FString& SystemPrompt,
+    const FN2CTranslationTarget& Target,
+    const FOnLLMTranslationComplete& OnComplete,
+    bool bDeliverResponse,
+    const TSharedRef<FN2CCancellationToken>& Token,
+    double DeadlineSeconds)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const EN2CLLMProvider DraftProvider = Settings->SpeculativeProvider;
+    const bool bRefine = Settings->bRefineDrafts;
+    const FString DraftCacheKey = FN2CTranslationCache::Get().MakeKey(
+        JsonInput, SystemPrompt, Target.Language, DraftProvider, Settings->GetSpeculativeModel());
+
+    // The draft tier has its own provider queue, so drafts of a batch go out while earlier graphs are refined
+    FN2CLLMRequestScheduler::Get().EnqueueRequest(DraftProvider,
+        [this, JsonInput, SystemPrompt, Target, OnComplete, bDeliverResponse, Token, DeadlineSeconds, bRefine, DraftCacheKey](const FSimpleDelegate& OnFinished)
+        {
+            if (Token->IsCancelled())
+            {
+                OnFinished.ExecuteIfBound();
+                const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                return;
+            }
+
+            // Without a draft the selected model translates as usual
+            const auto FinishDraft = [this, JsonInput, SystemPrompt, Target, OnComplete, bDeliverResponse, Token, DeadlineSeconds, bRefine, DraftCacheKey](
+                const FString& Response, const FN2CTranslationResponse& Draft, bool bParsed)
+            {
+                if (bParsed)
+                {
+                    FN2CTranslationCache::Get().Store(DraftCacheKey, Response);
+                    if (Target.bBroadcast && Draft.Graphs.Num() > 0 && !Draft.Graphs[0].Code.GraphImplementation.IsEmpty())
+                    {
+                        OnTranslationStreamProgress.Broadcast(Draft.Graphs[0].Code.GraphImplementation);
+                    }
+                }
+
+                if (bParsed && !bRefine)
+                {
+                    FinishLLMResponse(Draft, Target, true, bDeliverResponse);
+                    const bool bExecuted = OnComplete.ExecuteIfBound(Draft, true);
+                    return;
+                }
+
+                if (Token->IsCancelled())
+                {
+                    const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                    return;
+                }
+                DispatchN2CJson(JsonInput, SystemPrompt, Target, OnComplete, bDeliverResponse, TSet<EN2CLLMProvider>(),
+                    Token, DeadlineSeconds, bParsed ? FormatDraftForRefinement(Draft) : FString());
+            };
+
+            TScriptInterface<IN2CLLMService> Service = GetSpeculativeService();
+            if (!Service.GetInterface())
+            {
+                OnFinished.ExecuteIfBound();
+                FinishDraft(FString(), FN2CTranslationResponse(), false);
+                return;
+            }
+
+            // A draft served from the cache needs no request
+            FString CachedResponse;
+            UN2CResponseParserBase* Parser = Service->GetResponseParser();
+            FN2CTranslationResponse CachedDraft;
+            if (Parser && FN2CTranslationCache::Get().Find(DraftCacheKey, CachedResponse) && Parser->ParseLLMResponse(CachedResponse, CachedDraft))
+            {
+                OnFinished.ExecuteIfBound();
+                FinishDraft(CachedResponse, CachedDraft, true);
+                return;
+            }
+
+            TSharedRef<FN2CHttpRequestHandle> Handle = MakeShared<FN2CHttpRequestHandle>();
+            TSharedRef<bool> bCompleted = MakeShared<bool>(false);
+            Handle->OnCancelled = FSimpleDelegate::CreateLambda([OnFinished, OnComplete, bCompleted]()
+            {
+                if (!*bCompleted)
+                {
+                    *bCompleted = true;
+                    OnFinished.ExecuteIfBound();
+                    const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                }
+            });
+            Token->Track(Handle);
+
+            UObject* ServiceObject = Service.GetObject();
+            Service->SendStreamingRequest(JsonInput, SystemPrompt, FOnLLMStreamChunkReceived(), FOnLLMResponseReceived::CreateLambda(
+                [OnFinished, FinishDraft, bCompleted, ServiceObject](const FString& Response)
+                {
+                    if (*bCompleted)
+                    {
+                        return;
+                    }
+                    *bCompleted = true;
+                    OnFinished.ExecuteIfBound();
+
+                    const IN2CLLMService* ResponseService = Cast<IN2CLLMService>(ServiceObject);
+                    UN2CResponseParserBase* ResponseParser = ResponseService ? ResponseService->GetResponseParser() : nullptr;
+                    FN2CTranslationResponse Draft;
+                    const bool bParsed = ResponseParser && ResponseParser->ParseLLMResponse(Response, Draft);
+                    if (!bParsed)
+                    {
+                        FN2CLogger::Get().LogWarning(TEXT("Draft translation failed, sending the request without it"), TEXT("LLMModule"));
+                    }
+                    FinishDraft(Response, Draft, bParsed);
+                }), Handle);
+        }, Token, Target.EstimatedSeconds, Target.Session->Priority);
+}
+
+FString UN2CLLMModule::FormatDraftForRefinement(const FN2CTranslationResponse& Draft)
+{
+    FString Result = TEXT("\n\nA faster model drafted the translation below. Use it as a starting point: keep what is correct, ")
+        TEXT("fix what is wrong or missing, and respond in the usual format.\n");
+    for (const FN2CGraphTranslation& Graph : Draft.Graphs)
+    {
+        Result += FString::Printf(TEXT("\n### %s\n%s\n%s\n"),
+            *Graph.GraphName, *Graph.Code.GraphDeclaration, *Graph.Code.GraphImplementation);
+    }
+    return Result;
+}
+
+FString UN2CLLMModule::FormatDiagnosticsForRetry(const FN2CTranslationResponse& Translation, const FString& Diagnostics)
+{
+    FString Result = TEXT("\n\nYour previous translation, below, does not compile. Fix the syntax errors listed after it ")
+        TEXT("and respond with the whole translation in the usual format.\n");
+    for (const FN2CGraphTranslation& Graph : Translation.Graphs)
+    {
+        Result += FString::Printf(TEXT("\n### %s\n%s\n%s\n"),
+            *Graph.GraphName, *Graph.Code.GraphDeclaration, *Graph.Code.GraphImplementation);
+    }
+    Result += TEXT("\nErrors:\n") + Diagnostics;
+    return Result;
+}
+
+void UN2CLLMModule::DispatchN2CJson(
+    const FString& JsonInput,
+    const FString& SystemPrompt,
+    const FN2CTranslationTarget& Target,
+    const FOnLLMTranslationComplete& OnComplete,
+    bool bDeliverResponse,
+    const TSet<EN2CLLMProvider>& TriedProviders,
+    const TSharedRef<FN2CCancellationToken>& Token,
+    double DeadlineSeconds,
+    const FString& Draft)
+{
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    const TArray<EN2CLLMProvider> Candidates = GetRoutingCandidates();
+    EN2CLLMProvider Provider = Config.Provider;
+    if (!FN2CLLMRouter::Get().SelectProvider(Candidates, TriedProviders, Provider, Target.bPreferFastestProvider))
+    {
+        CurrentStatus = EN2CSystemStatus::Error;
+        FN2CLogger::Get().LogError(TEXT("No LLM provider left to try"), TEXT("LLMModule"));
+        BroadcastTranslationResult(MakeShared<const FN2CTranslationResponse>(), false);
+        const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+        return;
+    }
+
+    TSet<EN2CLLMProvider> Tried = TriedProviders;
+    Tried.Add(Provider);
+    const bool bCanFailOver = Candidates.ContainsByPredicate([&Tried](EN2CLLMProvider Candidate) { return !Tried.Contains(Candidate); });
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bCanRetry = FN2CSyntaxVerifier::IsEnabledFor(Target.Language) && Target.VerificationAttempts < Settings->MaxSyntaxRetries;
+    const FString CacheKey = Settings && Settings->bUseTranslationCache
+        ? FN2CTranslationCache::Get().MakeKey(JsonInput, SystemPrompt, Target.Language, Provider, GetModelForProvider(Provider))
+        : FString();
+
+    StartWarmUpHeartbeat();
+    StartProbeHeartbeat();
+
+    // Queue the request with the scheduler so batches respect the provider's concurrency and rate limits
+    const FDateTime QueuedAt = FDateTime::UtcNow();
+    const double QueueTime = FPlatformTime::Seconds();
+    FN2CLLMRequestScheduler::Get().EnqueueRequest(Provider,
+        [this, JsonInput, SystemPrompt, Target, CacheKey, OnComplete, bDeliverResponse, Provider, Tried, bCanFailOver, bCanRetry, Token, DeadlineSeconds, QueuedAt, QueueTime, Draft](const FSimpleDelegate& OnFinished)
+        {
+            // Cancelled while queued: report it without sending anything
+            if (Token->IsCancelled())
+            {
+                OnFinished.ExecuteIfBound();
+                const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                return;
+            }
+
+            TScriptInterface<IN2CLLMService> DispatchService = GetServiceForProvider(Provider);
+            if (!DispatchService.GetInterface())
+            {
+                FN2CLogger::Get().LogError(TEXT("No active LLM service"), TEXT("LLMModule"));
+                OnFinished.ExecuteIfBound();
+                CurrentStatus = EN2CSystemStatus::Error;
+                const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                return;
+            }
+
+            // Surface the graph implementation being written while the response streams in. The content
+            // only grows, so each update decodes just the text added since the last one
+            TSharedRef<FN2CPartialTranslationParser> PartialParser = MakeShared<FN2CPartialTranslationParser>();
+            const FOnLLMStreamChunkReceived OnPartialContent = FOnLLMStreamChunkReceived::CreateLambda(
+                [this, PartialParser](const FString& PartialContent)
+                {
+                    // A retried request streams its content from the start again
+                    if (PartialContent.Len() < PartialParser->GetConsumedLength())
+                    {
+                        *PartialParser = FN2CPartialTranslationParser();
+                    }
+
+                    const bool bChanged = PartialParser->Feed(FStringView(PartialContent).RightChop(PartialParser->GetConsumedLength()));
+                    const FString& PartialCode = PartialParser->GetCode().GraphImplementation;
+                    if (bChanged && !PartialCode.IsEmpty())
+                    {
+                        OnTranslationStreamProgress.Broadcast(PartialCode);
+                    }
+                });
+
+            // The deadline runs from dispatch, so time spent queued behind other requests does not count.
+            // A cancelled request reports failure from the handle instead of its response
+            const double StartTime = FPlatformTime::Seconds();
+            TSharedRef<FN2CHttpRequestHandle> Handle = MakeShared<FN2CHttpRequestHandle>();
+            Handle->Deadline = DeadlineSeconds > 0.0 ? StartTime + DeadlineSeconds : 0.0;
+            TSharedRef<bool> bCompleted = MakeShared<bool>(false);
+            Handle->OnCancelled = FSimpleDelegate::CreateLambda([OnFinished, OnComplete, bCompleted]()
+            {
+                if (!*bCompleted)
+                {
+                    *bCompleted = true;
+                    OnFinished.ExecuteIfBound();
+                    const bool bExecuted = OnComplete.ExecuteIfBound(FN2CTranslationResponse(), false);
+                }
+            });
+            Token->Track(Handle);
+
+            // Send request through service. The handle is held weakly, since its request holds this callback,
+            // and the callback keeps the JSON and prompt only if it may have to send them again, to another provider
+            // or with the errors its translation failed the syntax check with
+            const double QueueWaitSeconds = StartTime - QueueTime;
+            const TWeakPtr<FN2CHttpRequestHandle> WeakHandle = Handle;
+            // A refined request carries the draft after the graph; it is cached as the graph's own translation
+            DispatchService->SendStreamingRequest(JsonInput + Draft, SystemPrompt, OnPartialContent, FOnLLMResponseReceived::CreateLambda(
+                [this, ResendJson = bCanFailOver || bCanRetry ? JsonInput : FString(), ResendPrompt = bCanFailOver || bCanRetry ? SystemPrompt : FString(), Target, CacheKey, OnComplete, OnFinished, bDeliverResponse, Provider, Tried, bCanFailOver, bCanRetry, StartTime, Token, DeadlineSeconds, bCompleted, QueuedAt, QueueWaitSeconds, WeakHandle, Draft](const FString& Response)
+                {
+                    if (*bCompleted)
+                    {
+                        return;
+                    }
+                    *bCompleted = true;
+
+                    // Release the scheduler slot first so the next queued request can go out
+                    OnFinished.ExecuteIfBound();
+
+                    // Parse once, on a worker; callers get the parsed translation rather than the raw response
+                    TArray<FString> Responses;
+                    Responses.Add(Response);
+                    ParseLLMResponsesAsync(MoveTemp(Responses), Provider,
+                        [this, ResendJson, ResendPrompt, Target, CacheKey, OnComplete, bDeliverResponse, Provider, Tried, bCanFailOver, bCanRetry, StartTime, Token, DeadlineSeconds, QueuedAt, QueueWaitSeconds, WeakHandle, Draft]
+                        (TArray<FParsedResponse>&& Results)
+                        {
+                            const FParsedResponse& Result = Results[0];
+                            const FN2CTranslationResponse& TranslationResponse = Result.TranslationResponse;
+                            const bool bParsed = Result.bParsed;
+                            if (const TSharedPtr<FN2CHttpRequestHandle> RequestHandle = WeakHandle.Pin())
+                            {
+                                RecordRequestMetrics(Provider, QueuedAt, QueueWaitSeconds, StartTime, *RequestHandle, TranslationResponse, bParsed);
+                            }
+
+                            if (bParsed)
+                            {
+                                FN2CLLMRouter::Get().ReportSuccess(Provider, FPlatformTime::Seconds() - StartTime);
+                            }
+                            else
+                            {
+                                FN2CLLMRouter::Get().ReportFailure(Provider);
+                                if (bCanFailOver)
+                                {
+                                    FN2CLogger::Get().LogWarning(
+                                        FString::Printf(TEXT("Request to %s failed, failing over to another provider"), *UEnum::GetValueAsString(Provider)),
+                                        TEXT("LLMModule"));
+                                    DispatchN2CJson(ResendJson, ResendPrompt, Target, OnComplete, bDeliverResponse, Tried, Token, DeadlineSeconds, Draft);
+                                    return;
+                                }
+                            }
+
+                            const auto Finish = [this, Target, CacheKey, OnComplete, bDeliverResponse](
+                                const FN2CTranslationResponse& FinalResponse, const FString& RawResponse, bool bSucceeded)
+                            {
+                                FinishLLMResponse(FinalResponse, Target, bSucceeded, bDeliverResponse);
+
+                                // Only responses that parsed into a translation are worth replaying
+                                if (bSucceeded && !CacheKey.IsEmpty())
+                                {
+                                    FN2CTranslationCache::Get().Store(CacheKey, RawResponse);
+                                }
+                                const bool bExecuted = OnComplete.ExecuteIfBound(FinalResponse, bSucceeded);
+                            };
+
+                            if (!bParsed || !FN2CSyntaxVerifier::IsEnabledFor(Target.Language))
+                            {
+                                Finish(TranslationResponse, Result.Response, bParsed);
+                                return;
+                            }
+
+                            // Checked off the scheduler, whose slot is already free, so other requests go out meanwhile
+                            FN2CSyntaxVerifier::Get().Verify(TranslationResponse, Target.Language,
+                                [this, Finish, TranslationResponse, RawResponse = Result.Response, ResendJson, ResendPrompt, Target, OnComplete, bDeliverResponse, bCanRetry, Token, DeadlineSeconds]
+                                (bool bPassed, const FString& Diagnostics)
+                                {
+                                    if (!bPassed && bCanRetry && !Token->IsCancelled())
+                                    {
+                                        FN2CLogger::Get().LogWarning(
+                                            FString::Printf(TEXT("Translation failed its syntax check, sending it again with the errors:\n%s"), *Diagnostics),
+                                            TEXT("LLMModule"));
+                                        FN2CTranslationTarget RetryTarget = Target;
+                                        ++RetryTarget.VerificationAttempts;
+                                        DispatchN2CJson(ResendJson, ResendPrompt, RetryTarget, OnComplete, bDeliverResponse, TSet<EN2CLLMProvider>(),
+                                            Token, DeadlineSeconds, FormatDiagnosticsForRetry(TranslationResponse, Diagnostics));
+                                        return;
+                                    }
+
+                                    // Kept once out of retries; the errors may only be names the check could not see
+                                    if (!bPassed)
+                                    {
+                                        FN2CLogger::Get().LogWarning(
+                                            FString::Printf(TEXT("Translation kept despite failing its syntax check:\n%s"), *Diagnostics), TEXT("LLMModule"));
+                                    }
+                                    Finish(TranslationResponse, RawResponse, true);
+                                });
+                        });
+                }), Handle);
+        }, Token, Target.EstimatedSeconds, Target.Session->Priority);
+}
+
+void UN2CLLMModule::RecordRequestMetrics(
+    EN2CLLMProvider Provider,
+    const FDateTime& QueuedAt,
+    double QueueWaitSeconds,
+    double StartTime,
+    const FN2CHttpRequestHandle& Handle,
+    const FN2CTranslationResponse& TranslationResponse,
+    bool bParsed)
+{
+    FN2CRequestMetrics Metrics;
+    Metrics.Provider = Provider;
+    Metrics.Model = GetModelForProvider(Provider);
+    Metrics.QueuedAt = QueuedAt;
+    Metrics.QueueWaitSeconds = QueueWaitSeconds;
+    Metrics.SerializeSeconds = Handle.PayloadSeconds;
+    Metrics.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+    if (Handle.SentTime > 0.0)
+    {
+        Metrics.UploadSeconds = Handle.UploadedTime > 0.0 ? Handle.UploadedTime - Handle.SentTime : -1.0f;
+        Metrics.TimeToFirstByteSeconds = Handle.FirstByteTime > 0.0 ? Handle.FirstByteTime - Handle.SentTime : -1.0f;
+    }
+
+    const FN2CTranslationUsage& Usage = TranslationResponse.Usage;
+    Metrics.InputTokens = Usage.InputTokens;
+    Metrics.OutputTokens = Usage.OutputTokens;
+    Metrics.CachedInputTokens = Usage.CachedInputTokens;
+
+    // Prices are per million tokens
+    if (const UN2CSettings* Settings = GetDefault<UN2CSettings>())
+    {
+        Metrics.Cost = (Usage.InputTokens * Settings->GetInputCost(Provider) + Usage.OutputTokens * Settings->GetOutputCost(Provider)) / 1000000.0f;
+    }
+    Metrics.bSucceeded = bParsed;
+
+    FN2CTelemetry& Telemetry = FN2CTelemetry::Get();
+    Telemetry.Increment(TEXT("Requests"));
+    Telemetry.Increment(bParsed ? TEXT("SucceededRequests") : TEXT("FailedRequests"));
+    Telemetry.Increment(TEXT("InputTokens"), Usage.InputTokens);
+    Telemetry.Increment(TEXT("OutputTokens"), Usage.OutputTokens);
+    Telemetry.RecordSeconds("QueueWait", Metrics.QueueWaitSeconds);
+    Telemetry.RecordSeconds("Upload", Metrics.UploadSeconds);
+    Telemetry.RecordSeconds("TimeToFirstByte", Metrics.TimeToFirstByteSeconds);
+    Telemetry.RecordSeconds("Request", Metrics.TotalSeconds);
+    RequestMetrics.Record(MoveTemp(Metrics));
+}
+
+FN2CMetricsDashboard UN2CLLMModule::GetMetricsDashboard() const
+{
+    FN2CMetricsDashboard Dashboard;
+    const FN2CLLMRequestScheduler& Scheduler = FN2CLLMRequestScheduler::Get();
+    const UEnum* ProviderEnum = StaticEnum<EN2CLLMProvider>();
+    for (int32 Index = 0; Index < ProviderEnum->NumEnums() - 1; ++Index)
+    {
+        const EN2CLLMProvider Provider = static_cast<EN2CLLMProvider>(ProviderEnum->GetValueByIndex(Index));
+        Dashboard.QueuedRequests += Scheduler.GetQueuedCount(Provider);
+        Dashboard.InFlightRequests += Scheduler.GetActiveCount(Provider);
+    }
+
+    Dashboard.SessionCacheHits = RequestMetrics.GetCacheHits();
+    Dashboard.BatchCacheHits = FMath::Max(RequestMetrics.GetCacheHits() - CurrentBatchFirstCacheHit, 0);
+    Dashboard.Session = FN2CRequestMetricsCollector::Summarize(RequestMetrics.GetMetrics());
+    Dashboard.Batch = FN2CRequestMetricsCollector::Summarize(RequestMetrics.GetMetricsSince(CurrentBatchFirstMetric));
+    return Dashboard;
+}
+
+bool UN2CLLMModule::ExportRequestMetrics(const FString& FilePath) const
+{
+    const TArray<FN2CRequestMetrics>& Metrics = RequestMetrics.GetMetrics();
+    const FString Content = FPaths::GetExtension(FilePath).Equals(TEXT("csv"), ESearchCase::IgnoreCase)
+        ? FN2CRequestMetricsCollector::ToCsv(Metrics)
+        : FN2CRequestMetricsCollector::ToJson(Metrics);
+    if (!FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to export request metrics to: %s"), *FilePath), TEXT("LLMModule"));
+        return false;
+    }
+    return true;
+}
+
+bool UN2CLLMModule::HandleLLMResponse(const FString& Response, EN2CLLMProvider Provider, const FN2CTranslationTarget& Target, FN2CTranslationResponse& TranslationResponse, bool bDeliverResponse)
+{
+    const bool bParsed = ParseLLMResponse(Response, Provider, TranslationResponse);
+    FinishLLMResponse(TranslationResponse, Target, bParsed, bDeliverResponse);
+    return bParsed;
+}
+
+bool UN2CLLMModule::ParseLLMResponse(const FString& Response, EN2CLLMProvider Provider, FN2CTranslationResponse& TranslationResponse)
+{
+    // Get the response parser of the service that produced the response
+    TScriptInterface<IN2CLLMService> ResponseService = GetServiceForProvider(Provider);
+    if (!ResponseService.GetInterface())
+    {
+        FN2CLogger::Get().LogError(TEXT("No active LLM service"));
+        return false;
+    }
+    return ParseWithParser(ResponseService->GetResponseParser(), Response, TranslationResponse);
+}
+
+bool UN2CLLMModule::ParseWithParser(UN2CResponseParserBase* Parser, const FString& Response, FN2CTranslationResponse& TranslationResponse)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CParseResponse);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response"), Response);
+
+    if (!Parser)
+    {
+        FN2CLogger::Get().LogError(TEXT("No response parser available"));
+        return false;
+    }
+
+    if (!Parser->ParseLLMResponse(Response, TranslationResponse))
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to parse LLM response"));
+        return false;
+    }
+
+    FN2CLogger::Get().Log(TEXT("Successfully parsed LLM response"), EN2CLogSeverity::Info);
+    return true;
+}
+
+void UN2CLLMModule::ParseLLMResponsesAsync(TArray<FString>&& Responses, EN2CLLMProvider Provider, TUniqueFunction<void(TArray<FParsedResponse>&&)>&& OnParsed)
+{
+    TScriptInterface<IN2CLLMService> ResponseService = GetServiceForProvider(Provider);
+    if (!ResponseService.GetInterface())
+    {
+        FN2CLogger::Get().LogError(TEXT("No active LLM service"));
+    }
+
+    // The parser is held until the results are back on the game thread, where it is also released,
+    // so a service reinitialized in the meantime cannot collect it mid-parse
+    TStrongObjectPtr<UN2CResponseParserBase> Parser(ResponseService.GetInterface() ? ResponseService->GetResponseParser() : nullptr);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Parser = MoveTemp(Parser), Responses = MoveTemp(Responses), OnParsed = MoveTemp(OnParsed)]() mutable
+    {
+        TArray<FParsedResponse> Results;
+        Results.SetNum(Responses.Num());
+        ParallelFor(Responses.Num(), [&Parser, &Responses, &Results](int32 Index)
+        {
+            FParsedResponse& Result = Results[Index];
+            Result.Response = MoveTemp(Responses[Index]);
+            Result.bParsed = !Result.Response.IsEmpty() && ParseWithParser(Parser.Get(), Result.Response, Result.TranslationResponse);
+        });
+
+        AsyncTask(ENamedThreads::GameThread, [Parser = MoveTemp(Parser), Results = MoveTemp(Results), OnParsed = MoveTemp(OnParsed)]() mutable
+        {
+            Parser.Reset();
+            OnParsed(MoveTemp(Results));
+        });
+    });
+}
+
+void UN2CLLMModule::FinishLLMResponse(const FN2CTranslationResponse& TranslationResponse, const FN2CTranslationTarget& Target, bool bParsed, bool bDeliverResponse)
+{
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    // A compact response leaves out declarations the request already held
+    if (bParsed && Target.KnownDeclarations.IsValid())
+    {
+        FN2CTranslationResponse Completed = TranslationResponse;
+        for (FN2CGraphTranslation& Graph : Completed.Graphs)
+        {
+            const FString* Declaration = Target.KnownDeclarations->Find(Graph.GraphName);
+            if (Declaration && Graph.Code.GraphDeclaration.IsEmpty())
+            {
+                Graph.Code.GraphDeclaration = *Declaration;
+            }
+        }
+
+        FN2CTranslationTarget Rest = Target;
+        Rest.KnownDeclarations.Reset();
+        FinishLLMResponse(Completed, Rest, bParsed, bDeliverResponse);
+        return;
+    }
+
+    if (!bParsed)
+    {
+        CurrentStatus = EN2CSystemStatus::Error;
+        BroadcastTranslationResult(MakeShared<const FN2CTranslationResponse>(TranslationResponse), false);
+    }
+    else if (bDeliverResponse)
+    {
+        DeliverTranslation(TranslationResponse, Target);
+    }
+    else
+    {
+        // The stitched translation is delivered once the remaining parts arrive
+        CurrentStatus = EN2CSystemStatus::Processing;
+    }
+}
+
+void UN2CLLMModule::BroadcastTranslationResult(const TSharedRef<const FN2CTranslationResponse>& Response, bool bSuccess)
+{
+    if (bSuccess)
+    {
+        LatestTranslation = Response;
+    }
+
+    OnTranslationResultReady.Broadcast(Response, bSuccess);
+    OnTranslationFinished.Broadcast(bSuccess);
+
+    // Every Blueprint listener takes its own copy of the response, so only build the call when one is bound
+    if (OnTranslationResponseReceived.IsBound())
+    {
+        OnTranslationResponseReceived.Broadcast(*Response, bSuccess);
+    }
+}
+
+bool UN2CLLMModule::GetLatestTranslationGraph(int32 GraphIndex, FN2CGraphTranslation& OutGraph) const
+{
+    if (!LatestTranslation.IsValid() || !LatestTranslation->Graphs.IsValidIndex(GraphIndex))
+    {
+        return false;
+    }
+
+    OutGraph = LatestTranslation->Graphs[GraphIndex];
+    return true;
+}
+
+void UN2CLLMModule::DeliverTranslation(const FN2CTranslationResponse& TranslationResponse, const FN2CTranslationTarget& Target)
+{
+    // Only report idle once every queued and in-flight request has finished
+    CurrentStatus = FN2CLLMRequestScheduler::Get().HasPendingRequests() ? EN2CSystemStatus::Processing : EN2CSystemStatus::Idle;
+
+    // Save translation to disk, with the Blueprint and batch it was sent from
+    const TSharedRef<const FN2CTranslationSession> Session = Target.Session.IsValid() ? Target.Session.ToSharedRef() : CreateDefaultSession();
+    const TSharedRef<const FN2CTranslationResponse> Response = MakeShared<const FN2CTranslationResponse>(TranslationResponse);
+    if (Session->bPreview && Session->BatchRootPath.IsEmpty() && Target.OutputPath.IsEmpty())
+    {
+        // No folder until it is persisted; the response stays in the translation cache for the same graph
+        PreviewTranslation = Response;
+        PreviewSession = Session;
+        FN2CLogger::Get().Log(TEXT("Translation preview ready, not saved to disk"), EN2CLogSeverity::Info);
+    }
+    else
+    {
+        const bool bSaved = Target.OutputPath.IsEmpty()
+            ? SaveTranslationToDisk(TranslationResponse, *Session)
+            : SaveLanguageTranslation(TranslationResponse, Target, *Session);
+        if (bSaved)
+        {
+            FN2CLogger::Get().Log(TEXT("Successfully saved translation to disk"), EN2CLogSeverity::Info);
+        }
+    }
+
+    if (Target.bBroadcast)
+    {
+        BroadcastTranslationResult(Response, true);
+    }
+}
+
+bool UN2CLLMModule::PersistPreviewTranslation()
+{
+    if (!PreviewTranslation.IsValid() || !PreviewSession.IsValid())
+    {
+        return false;
+    }
+
+    const TSharedRef<const FN2CTranslationResponse> Response = PreviewTranslation.ToSharedRef();
+    const TSharedRef<const FN2CTranslationSession> Session = PreviewSession.ToSharedRef();
+    PreviewTranslation.Reset();
+    PreviewSession.Reset();
+
+    // Queued on the output writer like any other translation, so the editor does not wait on the disk
+    const bool bSaved = SaveTranslationToDisk(*Response, *Session);
+    if (bSaved)
+    {
+        FN2CLogger::Get().Log(TEXT("Saved translation preview"), EN2CLogSeverity::Info);
+    }
+    return bSaved;
+}
+
+FN2CLatencyModel UN2CLLMModule::GetLatencyModel() const
+{
+    const FString Model = GetModelForProvider(Config.Provider);
+    for (const FN2CMetricsSummary& Summary : FN2CRequestMetricsCollector::Summarize(RequestMetrics.GetMetrics()))
+    {
+        if (Summary.Provider == Config.Provider && Summary.Model == Model)
+        {
+            return FN2CLatencyModel::FromSummary(Summary);
+        }
+    }
+    return FN2CLatencyModel();
+}
+
+void UN2CLLMModule::DeliverLocalTranslation(const FN2CTranslationResponse& TranslationResponse, const TSharedPtr<const FN2CTranslationSession>& Session)
+{
+    FN2CTranslationTarget Target = GetDefaultTarget();
+    Target.Session = Session;
+    DeliverTranslation(TranslationResponse, Target);
+}
+
+void UN2CLLMModule::StitchPartTranslations(const TArray<FN2CTranslationResponse>& Parts, FN2CTranslationResponse& OutResponse)
+{
+    OutResponse = FN2CTranslationResponse();
+
+    // Each part repeats the function declaration; implementations and notes follow the part order
+    TMap<FString, TArray<FString>> SeenDeclarations;
+    auto AppendSection = [](FString& Section, const FString& Addition)
+    {
+        if (Addition.TrimStartAndEnd().IsEmpty())
+        {
+            return;
+        }
+        if (!Section.IsEmpty())
+        {
+            Section += TEXT("\n\n");
+        }
+        Section += Addition;
+    };
+
+    for (const FN2CTranslationResponse& Part : Parts)
+    {
+        OutResponse.Usage.InputTokens += Part.Usage.InputTokens;
+        OutResponse.Usage.OutputTokens += Part.Usage.OutputTokens;
+        OutResponse.Usage.CachedInputTokens += Part.Usage.CachedInputTokens;
+
+        for (const FN2CGraphTranslation& PartGraph : Part.Graphs)
+        {
+            FN2CGraphTranslation* Graph = OutResponse.Graphs.FindByPredicate(
+                [&PartGraph](const FN2CGraphTranslation& Existing) { return Existing.GraphName == PartGraph.GraphName; });
+            if (!Graph)
+            {
+                Graph = &OutResponse.Graphs.AddDefaulted_GetRef();
+                Graph->GraphName = PartGraph.GraphName;
+                Graph->GraphType = PartGraph.GraphType;
+                Graph->GraphClass = PartGraph.GraphClass;
+            }
+
+            const FString Declaration = PartGraph.Code.GraphDeclaration.TrimStartAndEnd();
+            TArray<FString>& Declarations = SeenDeclarations.FindOrAdd(PartGraph.GraphName);
+            if (!Declarations.Contains(Declaration))
+            {
+                Declarations.Add(Declaration);
+                AppendSection(Graph->Code.GraphDeclaration, Declaration);
+            }
+            AppendSection(Graph->Code.GraphImplementation, PartGraph.Code.GraphImplementation);
+            AppendSection(Graph->Code.ImplementationNotes, PartGraph.Code.ImplementationNotes);
+        }
+    }
+}
+
+bool UN2CLLMModule::InitializeComponents()
+{
+    // Create and initialize prompt manager, kept across reconfigurations
+    if (!PromptManager)
+    {
+        PromptManager = NewObject<UN2CSystemPromptManager>(this);
+    }
+    if (!PromptManager)
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to create prompt manager"), TEXT("LLMModule"));
+        return false;
+    }
+    PromptManager->Initialize(Config);
+
+    // Note: HTTP Handler and Response Parser will be created by the specific service
+    return true;
+}
+
+void UN2CLLMModule::OpenTranslationFolder(bool& Success)
+{
+    FString PathToOpen = LatestTranslationPath;
+
+    // Before anything is translated this session, the newest folder of an earlier one
+    if (PathToOpen.IsEmpty())
+    {
+        if (const FN2CTranslationRun* LatestRun = GetTranslationHistory().GetLatestRun())
+        {
+            PathToOpen = LatestRun->RootPath;
+        }
+    }
+    
+    if (PathToOpen.IsEmpty())
+    {
+        FN2CLogger::Get().LogWarning(TEXT("No translation path available, opening the base path"));
+        Success = true;
+        PathToOpen = GetTranslationBasePath();
+    }
+
+    if (!FPaths::DirectoryExists(PathToOpen))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Translation directory does not exist: %s \n\nOpening the base path"), *PathToOpen));
+        Success = true;
+        PathToOpen = GetTranslationBasePath();
+    }
+
+#if PLATFORM_WINDOWS
+    FPlatformProcess::ExploreFolder(*PathToOpen);
+    Success = true;
+#endif
+#if PLATFORM_MAC
+    FMacPlatformProcess::ExploreFolder(*PathToOpen);
+    Success = true;
+#endif
     
 }
 
-void UN2CLLMModule::BeginBatchTranslation(const FString& BlueprintName)
+void UN2CLLMModule::BeginBatchTranslation(const FString& BlueprintName, const FN2CBlueprint* Blueprint)
+{
+    // Generate a shared root path for this batch
+    FString BlueprintNameToUse = BlueprintName;
+    if (BlueprintNameToUse.IsEmpty())
+    {
+        BlueprintNameToUse = TEXT("UnknownBlueprint");
+    }
+    CurrentBatchRootPath = GenerateTranslationRootPath(BlueprintNameToUse);
+    CurrentBatchFingerprints.Empty();
+    CurrentBatchClassOutputs.Empty();
+    CurrentBatchBlueprintName = BlueprintNameToUse;
+    CurrentBatchFirstMetric = RequestMetrics.GetTotalRecorded();
+    CurrentBatchFirstCacheHit = RequestMetrics.GetCacheHits();
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Batch translation started, root path: %s"), *CurrentBatchRootPath), EN2CLogSeverity::Info);
+    GetTranslationHistory().BeginRun(BlueprintNameToUse, CurrentBatchRootPath);
+
+    if (Blueprint && EnsureDirectoryExists(CurrentBatchRootPath) && SaveBlueprintFiles(*Blueprint, CurrentBatchRootPath))
+    {
+        LatestTranslationPath = CurrentBatchRootPath;
+    }
+
+    TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("event"), TEXT("begin"));
+    Entry->SetStringField(TEXT("blueprint"), BlueprintNameToUse);
+    AppendJournalEntry(Entry);
+}
+
+void UN2CLLMModule::EndBatchTranslation()
+{
+    // Merged from the graph files on disk, including those carried forward, so those are flushed first
+    FN2CTranslationOutputWriter::FFlushStats ConsolidatedFlushStats;
+    if (CurrentBatchClassOutputs.Num() > 0)
+    {
+        FN2CTranslationOutputWriter::Get().Flush(&ConsolidatedFlushStats);
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        const int32 UnityGraphCount = Settings ? Settings->ConsolidatedUnityGraphCount : 0;
+        for (const TPair<FString, FN2CClassOutput>& Pair : CurrentBatchClassOutputs)
+        {
+            Pair.Value.Write(Pair.Key, CurrentBatchBlueprintName, UnityGraphCount);
+        }
+        CurrentBatchClassOutputs.Empty();
+    }
+
+    // Record which graphs this batch covers so the next run can skip unchanged ones
+    if (!CurrentBatchRootPath.IsEmpty() && CurrentBatchFingerprints.Num() > 0)
+    {
+        TSharedPtr<FJsonObject> GraphsObject = MakeShared<FJsonObject>();
+        for (const TPair<FString, FString>& Pair : CurrentBatchFingerprints)
+        {
+            GraphsObject->SetStringField(Pair.Key, Pair.Value);
+        }
+
+        TSharedPtr<FJsonObject> ManifestObject = MakeShared<FJsonObject>();
+        ManifestObject->SetObjectField(TEXT("graphs"), GraphsObject);
+
+        FString ManifestContent;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ManifestContent);
+        FJsonSerializer::Serialize(ManifestObject.ToSharedRef(), Writer);
+
+        const FString ManifestPath = FPaths::Combine(CurrentBatchRootPath, GraphFingerprintManifestName);
+        FN2CTranslationOutputWriter::Get().Write(ManifestPath, MoveTemp(ManifestContent));
+    }
+
+    // Timings and cost of the batch's requests, for comparing providers and models
+    const TArray<FN2CRequestMetrics> BatchMetrics = RequestMetrics.GetMetricsSince(CurrentBatchFirstMetric);
+    if (!CurrentBatchRootPath.IsEmpty() && BatchMetrics.Num() > 0)
+    {
+        FN2CTranslationOutputWriter& OutputWriter = FN2CTranslationOutputWriter::Get();
+        OutputWriter.Write(FPaths::Combine(CurrentBatchRootPath, RequestMetricsCsvName), FN2CRequestMetricsCollector::ToCsv(BatchMetrics));
+        OutputWriter.Write(FPaths::Combine(CurrentBatchRootPath, RequestMetricsJsonName), FN2CRequestMetricsCollector::ToJson(BatchMetrics));
+    }
+
+    // Written after the manifest, so a journal without it marks a batch that never finished
+    TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("event"), TEXT("end"));
+    AppendJournalEntry(Entry);
+
+    // Packed after everything above is written, and before the index marks the batch ended
+    const UN2CSettings* ArchiveSettings = GetDefault<UN2CSettings>();
+    if (!CurrentBatchRootPath.IsEmpty() && ArchiveSettings && ArchiveSettings->bArchiveBatchOutput)
+    {
+        FN2CTranslationOutputWriter::Get().Archive(CurrentBatchRootPath);
+    }
+
+    // The one point a batch waits on its output, so the folder is complete once this returns
+    FN2CTranslationOutputWriter::FFlushStats FlushStats;
+    if (!FN2CTranslationOutputWriter::Get().Flush(&FlushStats))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Some translation files could not be saved to: %s"), *CurrentBatchRootPath));
+    }
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Wrote %d translation files, %d already up to date"),
+        FlushStats.WrittenFiles + ConsolidatedFlushStats.WrittenFiles, FlushStats.UnchangedFiles + ConsolidatedFlushStats.UnchangedFiles),
+        EN2CLogSeverity::Info);
+
+    // Only marked ended in the index once the folder is complete
+    if (!CurrentBatchRootPath.IsEmpty())
+    {
+        FN2CTranslationHistory& History = GetTranslationHistory();
+        History.EndRun(CurrentBatchRootPath);
+        History.Flush();
+    }
+
+    CurrentBatchFingerprints.Empty();
+    CurrentBatchRootPath.Empty();
+    FN2CLogger::Get().Log(TEXT("Batch translation ended"), EN2CLogSeverity::Info);
+}
+
+bool UN2CLLMModule::FindInterruptedBatch(
+    const FString& BlueprintName,
+    TMap<FString, FString>& OutCompletedFingerprints,
+    FString& OutRootPath) const
+{
+    OutCompletedFingerprints.Empty();
+    OutRootPath.Empty();
+
+    // Only the latest run counts; an older unfinished one was superseded by whatever ran after it
+    for (const FN2CTranslationRun* Run : GetTranslationHistory().GetRuns(BlueprintName))
+    {
+        if (Run->RootPath == CurrentBatchRootPath)
+        {
+            continue;
+        }
+        if (Run->bEnded)
+        {
+            return false;
+        }
+
+        // The journal has the graphs completed since the index was last saved. Entries may still be queued
+        const FString FolderPath = Run->RootPath;
+        FN2CTranslationOutputWriter::Get().Flush();
+        bool bEnded = true;
+        if (!LoadBatchJournal(FolderPath, OutCompletedFingerprints, bEnded) || bEnded)
+        {
+            OutCompletedFingerprints.Empty();
+            return false;
+        }
+
+        OutRootPath = FolderPath;
+        return OutCompletedFingerprints.Num() > 0;
+    }
+
+    return false;
+}
+
+bool UN2CLLMModule::FindPreviousBatchFingerprints(
+    const FString& BlueprintName,
+    TMap<FString, FString>& OutFingerprints,
+    FString& OutPreviousRootPath) const
+{
+    OutFingerprints.Empty();
+    OutPreviousRootPath.Empty();
+
+    bool bFlushed = false;
+    for (const FN2CTranslationRun* Run : GetTranslationHistory().GetRuns(BlueprintName))
+    {
+        if (Run->RootPath == CurrentBatchRootPath)
+        {
+            continue;
+        }
+
+        // A run that ended recorded the same fingerprints in the index as in its manifest
+        if (Run->bEnded && !Run->bIndexedFromDisk)
+        {
+            for (const TPair<FString, FN2CTranslationRecord>& Pair : Run->Graphs)
+            {
+                if (!Pair.Value.Fingerprint.IsEmpty())
+                {
+                    OutFingerprints.Add(Pair.Key, Pair.Value.Fingerprint);
+                }
+            }
+        }
+        else
+        {
+            // Journals and manifests still queued would otherwise read as missing
+            if (!bFlushed)
+            {
+                FN2CTranslationOutputWriter::Get().Flush();
+                bFlushed = true;
+            }
+            LoadFolderFingerprints(Run->RootPath, OutFingerprints);
+        }
+
+        if (OutFingerprints.Num() > 0)
+        {
+            OutPreviousRootPath = Run->RootPath;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool UN2CLLMModule::LoadFolderFingerprints(const FString& FolderPath, TMap<FString, FString>& OutFingerprints)
+{
+    OutFingerprints.Empty();
+
+    FString ManifestContent;
+    if (!FFileHelper::LoadFileToString(ManifestContent, *FPaths::Combine(FolderPath, GraphFingerprintManifestName)))
+    {
+        // A batch that was interrupted before writing its manifest still journaled what it finished
+        bool bEnded = false;
+        if (LoadBatchJournal(FolderPath, OutFingerprints, bEnded) && OutFingerprints.Num() > 0)
+        {
+            return true;
+        }
+        OutFingerprints.Empty();
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> ManifestObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ManifestContent);
+    const TSharedPtr<FJsonObject>* GraphsObject = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, ManifestObject) || !ManifestObject.IsValid()
+        || !ManifestObject->TryGetObjectField(TEXT("graphs"), GraphsObject))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Ignoring unreadable graph fingerprint manifest in: %s"), *FolderPath));
+        return false;
+    }
+
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*GraphsObject)->Values)
+    {
+        OutFingerprints.Add(Pair.Key, Pair.Value->AsString());
+    }
+    return true;
+}
+
+void UN2CLLMModule::CarryForwardUnchangedGraphs(
+    const FString& PreviousRootPath,
+    const TMap<FString, FString>& UnchangedFingerprints)
+{
+    if (CurrentBatchRootPath.IsEmpty() || UnchangedFingerprints.Num() == 0 || !EnsureDirectoryExists(CurrentBatchRootPath))
+    {
+        return;
+    }
+
+    // Archived files are extracted into the new folder, which is packed again if it is archived too
+    TArray<FString> ArchivedFiles;
+    FN2CTranslationArchive::GetArchivedFiles(PreviousRootPath, ArchivedFiles);
+    for (const FString& RelativePath : ArchivedFiles)
+    {
+        FString Content;
+        if (FN2CTranslationArchive::LoadFileToString(Content, FPaths::Combine(PreviousRootPath, RelativePath)))
+        {
+            FN2CTranslationOutputWriter::Get().Write(FPaths::Combine(CurrentBatchRootPath, RelativePath), MoveTemp(Content));
+        }
+    }
+
+    // Copy graph and class directories only; the top-level N2C_*.json files are rewritten per batch
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TArray<FString> SubDirectories;
+    IFileManager::Get().FindFiles(SubDirectories, *FPaths::Combine(PreviousRootPath, TEXT("*")), false, true);
+    for (const FString& SubDirectory : SubDirectories)
+    {
+        const FString Destination = FPaths::Combine(CurrentBatchRootPath, SubDirectory);
+        if (!PlatformFile.CopyDirectoryTree(*Destination, *FPaths::Combine(PreviousRootPath, SubDirectory), true))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to carry forward previous output: %s"), *Destination));
+        }
+    }
+
+    CurrentBatchFingerprints.Append(UnchangedFingerprints);
+    GetTranslationHistory().CarryForward(PreviousRootPath, CurrentBatchRootPath, UnchangedFingerprints);
+    LatestTranslationPath = CurrentBatchRootPath;
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Carried forward %d unchanged graphs from: %s"), UnchangedFingerprints.Num(), *PreviousRootPath),
+        EN2CLogSeverity::Info);
+}
+
+void UN2CLLMModule::RecordGraphFingerprint(const FString& GraphName, const FString& Fingerprint)
+{
+    if (!CurrentBatchRootPath.IsEmpty() && !Fingerprint.IsEmpty())
+    {
+        CurrentBatchFingerprints.Add(GraphName, Fingerprint);
+        GetTranslationHistory().RecordFingerprint(CurrentBatchRootPath, GraphName, Fingerprint);
+
+        TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+        Entry->SetStringField(TEXT("event"), TEXT("completed"));
+        Entry->SetStringField(TEXT("graph"), GraphName);
+        Entry->SetStringField(TEXT("fingerprint"), Fingerprint);
+        AppendJournalEntry(Entry);
+    }
+}
+
+void UN2CLLMModule::RecordGraphQueued(const FString& GraphName, const FString& Fingerprint)
+{
+    TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("event"), TEXT("queued"));
+    Entry->SetStringField(TEXT("graph"), GraphName);
+    Entry->SetStringField(TEXT("fingerprint"), Fingerprint);
+    AppendJournalEntry(Entry);
+}
+
+void UN2CLLMModule::RecordGraphFailed(const FString& GraphName)
+{
+    if (!CurrentBatchRootPath.IsEmpty())
+    {
+        GetTranslationHistory().RecordFingerprint(CurrentBatchRootPath, GraphName, FString());
+    }
+
+    TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("event"), TEXT("failed"));
+    Entry->SetStringField(TEXT("graph"), GraphName);
+    AppendJournalEntry(Entry);
+}
+
+void UN2CLLMModule::AppendJournalEntry(const TSharedRef<FJsonObject>& Entry) const
+{
+    if (CurrentBatchRootPath.IsEmpty())
+    {
+        return;
+    }
+
+    FString Line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    FJsonSerializer::Serialize(Entry, Writer);
+    Line += TEXT("\n");
+
+    // Appended and closed per entry, so everything journaled survives a crash. Sharing the output
+    // writer's queue keeps a "completed" entry behind the graph files it vouches for
+    const FString JournalPath = FPaths::Combine(CurrentBatchRootPath, BatchJournalName);
+    FN2CTranslationOutputWriter::Get().Append(JournalPath, MoveTemp(Line));
+}
+
+bool UN2CLLMModule::LoadBatchJournal(const FString& RootPath, TMap<FString, FString>& OutCompletedFingerprints, bool& bOutEnded)
+{
+    bOutEnded = false;
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FPaths::Combine(RootPath, BatchJournalName)))
+    {
+        return false;
+    }
+
+    for (const FString& Line : Lines)
+    {
+        // The last line may be cut short by a crash
+        TSharedPtr<FJsonObject> Entry;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+        if (!FJsonSerializer::Deserialize(Reader, Entry) || !Entry.IsValid())
+        {
+            continue;
+        }
+
+        const FString Event = Entry->GetStringField(TEXT("event"));
+        const FString GraphName = Entry->GetStringField(TEXT("graph"));
+        if (Event == TEXT("completed"))
+        {
+            OutCompletedFingerprints.Add(GraphName, Entry->GetStringField(TEXT("fingerprint")));
+        }
+        else if (Event == TEXT("failed"))
+        {
+            OutCompletedFingerprints.Remove(GraphName);
+        }
+        else if (Event == TEXT("end"))
+        {
+            bOutEnded = true;
+        }
+    }
+
+    return true;
+}
+
+bool UN2CLLMModule::LoadPreviousGraphCode(const FString& BlueprintName, const FN2CGraphTranslation& Graph, FN2CGeneratedCode& OutCode) const
+{
+    if (Graph.GraphName.IsEmpty())
+    {
+        return false;
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FString Extension = GetFileExtensionForLanguage(Settings ? Settings->TargetLanguage : EN2CCodeLanguage::Cpp);
+
+    // Where each way of saving puts the graph: class-centric for ClassItSelf in batches, then the
+    // sanitized batch name, then the plain name single translations use
+    TArray<FString> FileBaseNames;
+    if (Graph.GraphType.Equals(TEXT("ClassItSelf"), ESearchCase::IgnoreCase) && !Graph.GraphClass.IsEmpty())
+    {
+        FileBaseNames.Add(Graph.GraphClass);
+    }
+    FileBaseNames.AddUnique(SanitizeNameForFilesystem(Graph.GraphName));
+    FileBaseNames.AddUnique(Graph.GraphName);
+
+    const EN2CCodeLanguage Language = Settings ? Settings->TargetLanguage : EN2CCodeLanguage::Cpp;
+    for (const FN2CTranslationRun* Run : GetTranslationHistory().GetRuns(BlueprintName))
+    {
+        if (Run->RootPath == LatestTranslationPath || Run->RootPath == CurrentBatchRootPath)
+        {
+            continue;
+        }
+
+        // Folders indexed from disk are probed; for the rest the index says where the graph was saved, if at all
+        if (Run->bIndexedFromDisk)
+        {
+            if (LoadGraphCodeFromFolder(Run->RootPath, FileBaseNames, Extension, OutCode))
+            {
+                return true;
+            }
+            continue;
+        }
+
+        const FN2CTranslationRecord* Record = Run->Graphs.Find(Graph.GraphName);
+        const FN2CTranslationOutput* Output = Record ? Record->FindOutput(Language) : nullptr;
+        if (Output && LoadGraphCodeFromFolder(FPaths::Combine(Run->RootPath, Output->RelativeDir), { Output->FileBaseName }, Extension, OutCode))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UN2CLLMModule::LoadBatchGraphCode(const FString& RootPath, const FString& GraphName, FN2CGeneratedCode& OutCode)
+{
+    if (GraphName.IsEmpty())
+    {
+        return false;
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FString Extension = GetFileExtensionForLanguage(Settings ? Settings->TargetLanguage : EN2CCodeLanguage::Cpp);
+
+    TArray<FString> FileBaseNames;
+    FileBaseNames.Add(SanitizeNameForFilesystem(GraphName));
+    FileBaseNames.AddUnique(GraphName);
+    return LoadGraphCodeFromFolder(RootPath, FileBaseNames, Extension, OutCode);
+}
+
+bool UN2CLLMModule::LoadBatchSnapshot(const FString& RootPath, FN2CBlueprint& OutBlueprint)
+{
+    return FN2CSnapshot::LoadFromFile(GetSnapshotPath(RootPath), OutBlueprint);
+}
+
+FString UN2CLLMModule::GetSnapshotPath(const FString& RootPath)
+{
+    return FPaths::Combine(RootPath,
+        FString::Printf(TEXT("N2C_BP_%s%s"), *FPaths::GetBaseFilename(RootPath), FN2CSnapshot::GetFileExtension()));
+}
+
+bool UN2CLLMModule::LoadGraphCodeFromFolder(
+    const FString& FolderPath, const TArray<FString>& FileBaseNames, const FString& Extension, FN2CGeneratedCode& OutCode)
+{
+    for (const FString& FileBaseName : FileBaseNames)
+    {
+        const FString GraphDir = FPaths::Combine(FolderPath, FileBaseName);
+        FN2CGeneratedCode Code;
+        const bool bHasImplementation = FN2CTranslationArchive::LoadFileToString(Code.GraphImplementation, FPaths::Combine(GraphDir, FileBaseName + Extension));
+        const bool bHasDeclaration = FN2CTranslationArchive::LoadFileToString(Code.GraphDeclaration, FPaths::Combine(GraphDir, FileBaseName + TEXT(".h")));
+        if (bHasImplementation || bHasDeclaration)
+        {
+            FN2CTranslationArchive::LoadFileToString(Code.ImplementationNotes, FPaths::Combine(GraphDir, FileBaseName + TEXT("_Notes.txt")));
+            OutCode = MoveTemp(Code);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UN2CLLMModule::SaveBlueprintFiles(const FN2CBlueprint& Blueprint, const FString& RootPath) const
 {
-    // Generate a shared root path for this batch
-    FString BlueprintNameToUse = BlueprintName;
-    if (BlueprintNameToUse.IsEmpty())
+    // Save the Blueprint JSON (pretty-printed)
+    FString JsonFileName = FString::Printf(TEXT("N2C_BP_%s.json"), *FPaths::GetBaseFilename(RootPath));
+    FString JsonFilePath = FPaths::Combine(RootPath, JsonFileName);
+    
+    // Serialize the Blueprint to JSON with pretty printing
+    FN2CTranslationOutputWriter::Get().Write(JsonFilePath, FN2CSerializer::ToJson(Blueprint));
+    
+    // Save minified version of the Blueprint JSON
+    FString MinifiedJsonFileName = FString::Printf(TEXT("N2C_BP_Minified_%s.json"), *FPaths::GetBaseFilename(RootPath));
+    FString MinifiedJsonFilePath = FPaths::Combine(RootPath, MinifiedJsonFileName);
+    
+    // Serialize the Blueprint to JSON without pretty printing
+    FN2CJsonOptions MinifiedOptions;
+    MinifiedOptions.bPrettyPrint = false;
+    FN2CTranslationOutputWriter::Get().Write(MinifiedJsonFilePath, FN2CSerializer::ToJson(Blueprint, MinifiedOptions));
+
+    // Save the binary snapshot, which reloads far faster than the JSON for incremental and diff workflows
+    const FString SnapshotFilePath = GetSnapshotPath(RootPath);
+    if (!FN2CSnapshot::SaveToFile(Blueprint, SnapshotFilePath))
     {
-        BlueprintNameToUse = TEXT("UnknownBlueprint");
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save Blueprint snapshot: %s"), *SnapshotFilePath));
+        // Continue even if the snapshot fails
     }
-    CurrentBatchRootPath = GenerateTranslationRootPath(BlueprintNameToUse);
-    FN2CLogger::Get().Log(FString::Printf(TEXT("Batch translation started, root path: %s"), *CurrentBatchRootPath), EN2CLogSeverity::Info);
-}
 
-void UN2CLLMModule::EndBatchTranslation()
-{
-    CurrentBatchRootPath.Empty();
-    FN2CLogger::Get().Log(TEXT("Batch translation ended"), EN2CLogSeverity::Info);
+    return true;
 }
 
-bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Response, const FN2CBlueprint& Blueprint)
+bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Response, const FN2CTranslationSession& Session)
 {
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CSaveTranslation);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
     // Get blueprint name from metadata
-    FString BlueprintName = Blueprint.Metadata.Name;
+    FString BlueprintName = Session.Blueprint.IsValid() ? Session.Blueprint->Metadata.Name : FString();
     if (BlueprintName.IsEmpty())
     {
         BlueprintName = TEXT("UnknownBlueprint");
@@ -237,10 +2494,10 @@ bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Respons
     
     // Use batch root path if in batch mode, otherwise generate a new timestamped path for each translation
     FString RootPath;
-    if (!CurrentBatchRootPath.IsEmpty())
+    if (!Session.BatchRootPath.IsEmpty())
     {
         // Batch mode: reuse the shared root path
-        RootPath = CurrentBatchRootPath;
+        RootPath = Session.BatchRootPath;
     }
     else
     {
@@ -248,7 +2505,7 @@ bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Respons
         RootPath = GenerateTranslationRootPath(BlueprintName);
     }
     
-    // Ensure the directory exists
+    // Ensure the directory exists (the Blueprint snapshot is written straight away)
     if (!EnsureDirectoryExists(RootPath))
     {
         FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to create translation directory: %s"), *RootPath));
@@ -258,81 +2515,17 @@ bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Respons
     // Store the path for later reference
     LatestTranslationPath = RootPath;
     
-    // Save the Blueprint JSON (pretty-printed)
-    FString JsonFileName = FString::Printf(TEXT("N2C_BP_%s.json"), *FPaths::GetBaseFilename(RootPath));
-    FString JsonFilePath = FPaths::Combine(RootPath, JsonFileName);
-    
-    // Serialize the Blueprint to JSON with pretty printing
-    FN2CSerializer::SetPrettyPrint(true);
-    FString JsonContent = FN2CSerializer::ToJson(Blueprint);
-    
-    if (!FFileHelper::SaveStringToFile(JsonContent, *JsonFilePath))
+    // A batch wrote its Blueprint files once when it began; only the graph files change per response
+    if (Session.BatchRootPath.IsEmpty() && Session.Blueprint.IsValid() && !SaveBlueprintFiles(*Session.Blueprint, RootPath))
     {
-        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to save JSON file: %s"), *JsonFilePath));
         return false;
     }
-    
-    // Save minified version of the Blueprint JSON
-    FString MinifiedJsonFileName = FString::Printf(TEXT("N2C_BP_Minified_%s.json"), *FPaths::GetBaseFilename(RootPath));
-    FString MinifiedJsonFilePath = FPaths::Combine(RootPath, MinifiedJsonFileName);
-    
-    // Serialize the Blueprint to JSON without pretty printing
-    FN2CSerializer::SetPrettyPrint(false);
-    FString MinifiedJsonContent = FN2CSerializer::ToJson(Blueprint);
-    
-    if (!FFileHelper::SaveStringToFile(MinifiedJsonContent, *MinifiedJsonFilePath))
-    {
-        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save minified JSON file: %s"), *MinifiedJsonFilePath));
-        // Continue even if minified version fails
-    }
-    
+
     // Save the raw LLM translation response JSON
     FString TranslationJsonFileName = FString::Printf(TEXT("N2C_Translation_%s.json"), *FPaths::GetBaseFilename(RootPath));
     FString TranslationJsonFilePath = FPaths::Combine(RootPath, TranslationJsonFileName);
     
-    // Serialize the Translation response to JSON
-    TSharedPtr<FJsonObject> TranslationJsonObject = MakeShared<FJsonObject>();
-    
-    // Create graphs array
-    TArray<TSharedPtr<FJsonValue>> GraphsArray;
-    for (const FN2CGraphTranslation& Graph : Response.Graphs)
-    {
-        TSharedPtr<FJsonObject> GraphObject = MakeShared<FJsonObject>();
-        GraphObject->SetStringField(TEXT("graph_name"), Graph.GraphName);
-        GraphObject->SetStringField(TEXT("graph_type"), Graph.GraphType);
-        GraphObject->SetStringField(TEXT("graph_class"), Graph.GraphClass);
-        
-        // Create code object
-        TSharedPtr<FJsonObject> CodeObject = MakeShared<FJsonObject>();
-        CodeObject->SetStringField(TEXT("graphDeclaration"), Graph.Code.GraphDeclaration);
-        CodeObject->SetStringField(TEXT("graphImplementation"), Graph.Code.GraphImplementation);
-        CodeObject->SetStringField(TEXT("implementationNotes"), Graph.Code.ImplementationNotes);
-        
-        GraphObject->SetObjectField(TEXT("code"), CodeObject);
-        GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObject));
-    }
-    
-    TranslationJsonObject->SetArrayField(TEXT("graphs"), GraphsArray);
-    
-    // Add usage information if available
-    if (Response.Usage.InputTokens > 0 || Response.Usage.OutputTokens > 0)
-    {
-        TSharedPtr<FJsonObject> UsageObject = MakeShared<FJsonObject>();
-        UsageObject->SetNumberField(TEXT("input_tokens"), Response.Usage.InputTokens);
-        UsageObject->SetNumberField(TEXT("output_tokens"), Response.Usage.OutputTokens);
-        TranslationJsonObject->SetObjectField(TEXT("usage"), UsageObject);
-    }
-    
-    // Serialize to string with pretty printing
-    FString TranslationJsonContent;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&TranslationJsonContent);
-    FJsonSerializer::Serialize(TranslationJsonObject.ToSharedRef(), Writer);
-    
-    if (!FFileHelper::SaveStringToFile(TranslationJsonContent, *TranslationJsonFilePath))
-    {
-        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save translation JSON file: %s"), *TranslationJsonFilePath));
-        // Continue even if translation JSON fails
-    }
+    WriteTranslationJson(Response, TranslationJsonFilePath);
     
     // Get the target language from settings
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
@@ -340,8 +2533,8 @@ bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Respons
     
     
     
-    // Determine if we're in batch mode (when CurrentBatchRootPath is set)
-    const bool bIsBatchMode = !CurrentBatchRootPath.IsEmpty();
+    // Determine if we're in batch mode (when the session belongs to a batch)
+    const bool bIsBatchMode = !Session.BatchRootPath.IsEmpty();
     
     // Use batch-specific features for batch translations, original logic for single translations
     if (bIsBatchMode)
@@ -352,42 +2545,75 @@ bool UN2CLLMModule::SaveTranslationToDisk(const FN2CTranslationResponse& Respons
     {
         SaveGraphFilesOriginal(Response, RootPath, TargetLanguage);
     }
+
+    RecordSavedGraphs(Response, BlueprintName, RootPath, FString(), TargetLanguage, bIsBatchMode);
+    if (!bIsBatchMode)
+    {
+        GetTranslationHistory().EndRun(RootPath);
+    }
     
     FN2CLogger::Get().Log(FString::Printf(TEXT("Translation saved to: %s"), *RootPath), EN2CLogSeverity::Info);
     return true;
 }
 
+bool UN2CLLMModule::SaveLanguageTranslation(const FN2CTranslationResponse& Response, const FN2CTranslationTarget& Target, const FN2CTranslationSession& Session)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CSaveTranslation);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    if (!EnsureDirectoryExists(Target.OutputPath))
+    {
+        FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to create translation directory: %s"), *Target.OutputPath));
+        return false;
+    }
+
+    // The Blueprint files are shared by every language, in the folder above
+    LatestTranslationPath = FPaths::GetPath(Target.OutputPath);
+
+    const FString TranslationJsonFileName = FString::Printf(TEXT("N2C_Translation_%s.json"), *FPaths::GetBaseFilename(Target.OutputPath));
+    WriteTranslationJson(Response, FPaths::Combine(Target.OutputPath, TranslationJsonFileName));
+
+    if (Session.BatchRootPath.IsEmpty())
+    {
+        SaveGraphFilesOriginal(Response, Target.OutputPath, Target.Language);
+    }
+    else
+    {
+        SaveGraphFilesWithBatchFeatures(Response, Target.OutputPath, Target.Language);
+    }
+
+    const FString BlueprintName = Session.Blueprint.IsValid() && !Session.Blueprint->Metadata.Name.IsEmpty()
+        ? Session.Blueprint->Metadata.Name : TEXT("UnknownBlueprint");
+    RecordSavedGraphs(Response, BlueprintName, LatestTranslationPath, FPaths::GetCleanFilename(Target.OutputPath),
+        Target.Language, !Session.BatchRootPath.IsEmpty());
+    if (Session.BatchRootPath.IsEmpty())
+    {
+        GetTranslationHistory().EndRun(LatestTranslationPath);
+    }
+
+    FN2CLogger::Get().Log(FString::Printf(TEXT("Translation saved to: %s"), *Target.OutputPath), EN2CLogSeverity::Info);
+    return true;
+}
+
 void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
     const FN2CTranslationResponse& Response,
     const FString& RootPath,
-    EN2CCodeLanguage TargetLanguage) const
+    EN2CCodeLanguage TargetLanguage)
 {
     const bool bIsCpp = (TargetLanguage == EN2CCodeLanguage::Cpp);
-    
-    // Helper to sanitize graph names for use as filesystem paths while keeping the
-    // original GraphName intact for logical/JSON purposes.
-    auto SanitizeNameForFilesystem = [](const FString& InName) -> FString
-    {
-        FString Result = InName;
-        Result = Result.TrimStartAndEnd();
-
-        // Replace Windows-invalid filename characters with underscores
-        const TCHAR InvalidChars[] =
-        {
-            TEXT('<'), TEXT('>'), TEXT(':'), TEXT('"'),
-            TEXT('/'), TEXT('\\'), TEXT('|'), TEXT('?'), TEXT('*')
-        };
 
-        for (TCHAR Ch : InvalidChars)
+    // Merged into class files when the batch ends
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    FN2CClassOutput* ClassOutput = nullptr;
+    if (Settings && Settings->bWriteConsolidatedClassOutput && !CurrentBatchRootPath.IsEmpty())
+    {
+        ClassOutput = CurrentBatchClassOutputs.Find(RootPath);
+        if (!ClassOutput)
         {
-            FString From;
-            From.AppendChar(Ch);
-            Result.ReplaceInline(*From, TEXT("_"), ESearchCase::CaseSensitive);
+            ClassOutput = &CurrentBatchClassOutputs.Add(RootPath, FN2CClassOutput(TargetLanguage, GetFileExtensionForLanguage(TargetLanguage)));
         }
-
-        return Result;
-    };
-
+    }
+    
     // Save each graph's files
     for (const FN2CGraphTranslation& Graph : Response.Graphs)
     {
@@ -402,40 +2628,22 @@ void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
         const bool bHasGraphClass = !Graph.GraphClass.IsEmpty();
 
         // Log graph information for debugging
-        FN2CLogger::Get().Log(
-            FString::Printf(TEXT("[SaveGraphFiles] Processing graph: Name='%s', Type='%s', Class='%s', IsClassItSelf=%d, HasGraphClass=%d"),
-                *Graph.GraphName, *Graph.GraphType, *Graph.GraphClass, bIsClassItSelf ? 1 : 0, bHasGraphClass ? 1 : 0),
-            EN2CLogSeverity::Debug);
+        N2C_LOG(Debug, TEXT("[SaveGraphFiles] Processing graph: Name='%s', Type='%s', Class='%s', IsClassItSelf=%d, HasGraphClass=%d"),
+            *Graph.GraphName, *Graph.GraphType, *Graph.GraphClass, bIsClassItSelf ? 1 : 0, bHasGraphClass ? 1 : 0);
 
         // For ClassItSelf graphs with a class name, save directly to class-centric directory
         // Skip the graph-specific directory to avoid duplicate files
         if (bIsClassItSelf && bHasGraphClass)
         {
             FString ClassDir = FPaths::Combine(RootPath, Graph.GraphClass);
-            if (!EnsureDirectoryExists(ClassDir))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to create class directory: %s"), *ClassDir));
-                continue;
-            }
 
             // Save declaration file (C++ only)
             if (bIsCpp && !Graph.Code.GraphDeclaration.IsEmpty())
             {
                 FString ClassHeaderPath = FPaths::Combine(ClassDir, Graph.GraphClass + TEXT(".h"));
-                FN2CLogger::Get().Log(
-                    FString::Printf(TEXT("[SaveGraphFiles] Saving ClassItSelf header to class-centric path: %s (Graph: %s)"),
-                        *ClassHeaderPath, *Graph.GraphName),
-                    EN2CLogSeverity::Debug);
-                if (!FFileHelper::SaveStringToFile(Graph.Code.GraphDeclaration, *ClassHeaderPath))
-                {
-                    FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save class header file: %s"), *ClassHeaderPath));
-                }
-                else
-                {
-                    FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("[SaveGraphFiles] Successfully saved class header file: %s"), *ClassHeaderPath),
-                        EN2CLogSeverity::Debug);
-                }
+                N2C_LOG(Debug, TEXT("[SaveGraphFiles] Queueing ClassItSelf header to class-centric path: %s (Graph: %s)"),
+                    *ClassHeaderPath, *Graph.GraphName);
+                FN2CTranslationOutputWriter::Get().Write(ClassHeaderPath, CopyTemp(Graph.Code.GraphDeclaration));
             }
 
             // Save implementation file
@@ -443,30 +2651,21 @@ void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
             {
                 FString Extension = GetFileExtensionForLanguage(TargetLanguage);
                 FString ClassImplPath = FPaths::Combine(ClassDir, Graph.GraphClass + Extension);
-                FN2CLogger::Get().Log(
-                    FString::Printf(TEXT("[SaveGraphFiles] Saving ClassItSelf implementation to class-centric path: %s (Graph: %s)"),
-                        *ClassImplPath, *Graph.GraphName),
-                    EN2CLogSeverity::Debug);
-                if (!FFileHelper::SaveStringToFile(Graph.Code.GraphImplementation, *ClassImplPath))
-                {
-                    FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save class implementation file: %s"), *ClassImplPath));
-                }
-                else
-                {
-                    FN2CLogger::Get().Log(
-                        FString::Printf(TEXT("[SaveGraphFiles] Successfully saved class implementation file: %s"), *ClassImplPath),
-                        EN2CLogSeverity::Debug);
-                }
+                N2C_LOG(Debug, TEXT("[SaveGraphFiles] Queueing ClassItSelf implementation to class-centric path: %s (Graph: %s)"),
+                    *ClassImplPath, *Graph.GraphName);
+                FN2CTranslationOutputWriter::Get().Write(ClassImplPath, CopyTemp(Graph.Code.GraphImplementation));
             }
 
             // Save implementation notes to class directory
             if (!Graph.Code.ImplementationNotes.IsEmpty())
             {
                 FString NotesPath = FPaths::Combine(ClassDir, Graph.GraphClass + TEXT("_Notes.txt"));
-                if (!FFileHelper::SaveStringToFile(Graph.Code.ImplementationNotes, *NotesPath))
-                {
-                    FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save notes file: %s"), *NotesPath));
-                }
+                FN2CTranslationOutputWriter::Get().Write(NotesPath, CopyTemp(Graph.Code.ImplementationNotes));
+            }
+
+            if (ClassOutput)
+            {
+                ClassOutput->AddGraph(Graph, Graph.GraphClass, Graph.GraphClass);
             }
 
             // Skip normal graph directory processing for ClassItSelf graphs
@@ -475,11 +2674,6 @@ void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
 
         // For non-ClassItSelf graphs (or ClassItSelf without class name), use normal graph directory
         FString GraphDir = FPaths::Combine(RootPath, SanitizedGraphName);
-        if (!EnsureDirectoryExists(GraphDir))
-        {
-            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to create graph directory: %s"), *GraphDir));
-            continue;
-        }
 
         const FString FileBaseName = SanitizedGraphName;
 
@@ -487,19 +2681,8 @@ void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
         if (bIsCpp && !Graph.Code.GraphDeclaration.IsEmpty())
         {
             FString HeaderPath = FPaths::Combine(GraphDir, FileBaseName + TEXT(".h"));
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("[SaveGraphFiles] Saving header file: %s (Graph: %s)"), *HeaderPath, *Graph.GraphName),
-                EN2CLogSeverity::Debug);
-            if (!FFileHelper::SaveStringToFile(Graph.Code.GraphDeclaration, *HeaderPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save header file: %s"), *HeaderPath));
-            }
-            else
-            {
-                FN2CLogger::Get().Log(
-                    FString::Printf(TEXT("[SaveGraphFiles] Successfully saved header file: %s"), *HeaderPath),
-                    EN2CLogSeverity::Debug);
-            }
+            N2C_LOG(Debug, TEXT("[SaveGraphFiles] Queueing header file: %s (Graph: %s)"), *HeaderPath, *Graph.GraphName);
+            FN2CTranslationOutputWriter::Get().Write(HeaderPath, CopyTemp(Graph.Code.GraphDeclaration));
         }
 
         // Save implementation file with appropriate extension
@@ -507,29 +2690,20 @@ void UN2CLLMModule::SaveGraphFilesWithBatchFeatures(
         {
             FString Extension = GetFileExtensionForLanguage(TargetLanguage);
             FString ImplPath = FPaths::Combine(GraphDir, FileBaseName + Extension);
-            FN2CLogger::Get().Log(
-                FString::Printf(TEXT("[SaveGraphFiles] Saving implementation file: %s (Graph: %s)"), *ImplPath, *Graph.GraphName),
-                EN2CLogSeverity::Debug);
-            if (!FFileHelper::SaveStringToFile(Graph.Code.GraphImplementation, *ImplPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save implementation file: %s"), *ImplPath));
-            }
-            else
-            {
-                FN2CLogger::Get().Log(
-                    FString::Printf(TEXT("[SaveGraphFiles] Successfully saved implementation file: %s"), *ImplPath),
-                    EN2CLogSeverity::Debug);
-            }
+            N2C_LOG(Debug, TEXT("[SaveGraphFiles] Queueing implementation file: %s (Graph: %s)"), *ImplPath, *Graph.GraphName);
+            FN2CTranslationOutputWriter::Get().Write(ImplPath, CopyTemp(Graph.Code.GraphImplementation));
         }
         
         // Save implementation notes
         if (!Graph.Code.ImplementationNotes.IsEmpty())
         {
             FString NotesPath = FPaths::Combine(GraphDir, FileBaseName + TEXT("_Notes.txt"));
-            if (!FFileHelper::SaveStringToFile(Graph.Code.ImplementationNotes, *NotesPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save notes file: %s"), *NotesPath));
-            }
+            FN2CTranslationOutputWriter::Get().Write(NotesPath, CopyTemp(Graph.Code.ImplementationNotes));
+        }
+
+        if (ClassOutput)
+        {
+            ClassOutput->AddGraph(Graph, SanitizedGraphName, FileBaseName);
         }
     }
 }
@@ -548,22 +2722,14 @@ void UN2CLLMModule::SaveGraphFilesOriginal(
             continue;
         }
         
-        // Create directory for this graph
+        // The output writer creates the graph directory with its first file
         FString GraphDir = FPaths::Combine(RootPath, Graph.GraphName);
-        if (!EnsureDirectoryExists(GraphDir))
-        {
-            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to create graph directory: %s"), *GraphDir));
-            continue;
-        }
         
         // Save declaration file (C++ only)
         if (TargetLanguage == EN2CCodeLanguage::Cpp && !Graph.Code.GraphDeclaration.IsEmpty())
         {
             FString HeaderPath = FPaths::Combine(GraphDir, Graph.GraphName + TEXT(".h"));
-            if (!FFileHelper::SaveStringToFile(Graph.Code.GraphDeclaration, *HeaderPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save header file: %s"), *HeaderPath));
-            }
+            FN2CTranslationOutputWriter::Get().Write(HeaderPath, CopyTemp(Graph.Code.GraphDeclaration));
         }
         
         // Save implementation file with appropriate extension
@@ -571,20 +2737,14 @@ void UN2CLLMModule::SaveGraphFilesOriginal(
         {
             FString Extension = GetFileExtensionForLanguage(TargetLanguage);
             FString ImplPath = FPaths::Combine(GraphDir, Graph.GraphName + Extension);
-            if (!FFileHelper::SaveStringToFile(Graph.Code.GraphImplementation, *ImplPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save implementation file: %s"), *ImplPath));
-            }
+            FN2CTranslationOutputWriter::Get().Write(ImplPath, CopyTemp(Graph.Code.GraphImplementation));
         }
         
         // Save implementation notes
         if (!Graph.Code.ImplementationNotes.IsEmpty())
         {
             FString NotesPath = FPaths::Combine(GraphDir, Graph.GraphName + TEXT("_Notes.txt"));
-            if (!FFileHelper::SaveStringToFile(Graph.Code.ImplementationNotes, *NotesPath))
-            {
-                FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save notes file: %s"), *NotesPath));
-            }
+            FN2CTranslationOutputWriter::Get().Write(NotesPath, CopyTemp(Graph.Code.ImplementationNotes));
         }
     }
     
@@ -629,7 +2789,63 @@ FString UN2CLLMModule::GetTranslationBasePath() const
     return BasePath;
 }
 
-FString UN2CLLMModule::GetFileExtensionForLanguage(EN2CCodeLanguage Language) const
+FN2CTranslationHistory& UN2CLLMModule::GetTranslationHistory() const
+{
+    // The base path can be changed in the settings at any time
+    FN2CTranslationHistory& History = FN2CTranslationHistory::Get();
+    History.Open(GetTranslationBasePath());
+    return History;
+}
+
+void UN2CLLMModule::RecordSavedGraphs(
+    const FN2CTranslationResponse& Response,
+    const FString& BlueprintName,
+    const FString& RootPath,
+    const FString& RelativeDir,
+    EN2CCodeLanguage Language,
+    bool bBatch) const
+{
+    // A batch's folder was indexed when it began; single translations are indexed as they are saved
+    FN2CTranslationHistory& History = GetTranslationHistory();
+    History.BeginRun(BlueprintName, RootPath);
+
+    FN2CTranslationRecord Record;
+    Record.Provider = Config.Provider;
+    Record.Model = GetModelForProvider(Config.Provider);
+    Record.Time = FDateTime::Now();
+    Record.InputTokens = Response.Usage.InputTokens;
+    Record.OutputTokens = Response.Usage.OutputTokens;
+    for (const FN2CGraphTranslation& Graph : Response.Graphs)
+    {
+        if (Graph.GraphName.IsEmpty())
+        {
+            continue;
+        }
+
+        // Where SaveGraphFilesWithBatchFeatures and SaveGraphFilesOriginal put the graph's files
+        FN2CTranslationOutput& Output = Record.Outputs.Emplace_GetRef();
+        Output.Language = Language;
+        Output.RelativeDir = RelativeDir;
+        if (!bBatch)
+        {
+            Output.FileBaseName = Graph.GraphName;
+        }
+        else if (Graph.GraphType.Equals(TEXT("ClassItSelf"), ESearchCase::IgnoreCase) && !Graph.GraphClass.IsEmpty())
+        {
+            Output.FileBaseName = Graph.GraphClass;
+        }
+        else
+        {
+            Output.FileBaseName = SanitizeNameForFilesystem(Graph.GraphName);
+        }
+
+        Record.GraphName = Graph.GraphName;
+        History.RecordOutput(RootPath, Record);
+        Record.Outputs.Reset();
+    }
+}
+
+FString UN2CLLMModule::GetFileExtensionForLanguage(EN2CCodeLanguage Language)
 {
     switch (Language)
     {
@@ -670,6 +2886,41 @@ bool UN2CLLMModule::EnsureDirectoryExists(const FString& DirectoryPath) const
 }
 
 bool UN2CLLMModule::CreateServiceForProvider(EN2CLLMProvider Provider)
+{
+    UObject*& Pooled = ServicePool.FindOrAdd(Provider);
+    TScriptInterface<IN2CLLMService> ServiceInterface = ReconfigureOrCreateService(Pooled, Provider, Config);
+    if (!ServiceInterface.GetInterface())
+    {
+        return false;
+    }
+
+    // Store active service
+    Pooled = ServiceInterface.GetObject();
+    ActiveService = ServiceInterface;
+    return true;
+}
+
+TScriptInterface<IN2CLLMService> UN2CLLMModule::ReconfigureOrCreateService(UObject* Existing, EN2CLLMProvider Provider, const FN2CLLMConfig& ServiceConfig)
+{
+    IN2CLLMService* Service = Cast<IN2CLLMService>(Existing);
+    if (!Service || Service->GetProviderType() != Provider)
+    {
+        return CreateService(Provider, ServiceConfig);
+    }
+
+    if (!Service->Initialize(ServiceConfig))
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to reconfigure service"), TEXT("LLMModule"));
+        return nullptr;
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Reconfigured %s service in place for %s"), *UEnum::GetValueAsString(Provider), *ServiceConfig.Model),
+        EN2CLogSeverity::Debug, TEXT("LLMModule"));
+    return TScriptInterface<IN2CLLMService>(Existing);
+}
+
+TScriptInterface<IN2CLLMService> UN2CLLMModule::CreateService(EN2CLLMProvider Provider, const FN2CLLMConfig& ServiceConfig)
 {
     // Get the provider registry
     UN2CLLMProviderRegistry* Registry = UN2CLLMProviderRegistry::Get();
@@ -682,7 +2933,7 @@ bool UN2CLLMModule::CreateServiceForProvider(EN2CLLMProvider Provider)
                 *UEnum::GetValueAsString(Provider)),
             TEXT("LLMModule")
         );
-        return false;
+        return nullptr;
     }
     
     // Create the provider service
@@ -695,19 +2946,88 @@ bool UN2CLLMModule::CreateServiceForProvider(EN2CLLMProvider Provider)
                 *UEnum::GetValueAsString(Provider)),
             TEXT("LLMModule")
         );
-        return false;
+        return nullptr;
     }
 
     // Initialize service
-    if (!ServiceInterface.GetInterface()->Initialize(Config))
+    if (!ServiceInterface.GetInterface()->Initialize(ServiceConfig))
     {
         FN2CLogger::Get().LogError(TEXT("Failed to initialize service"), TEXT("LLMModule"));
-        return false;
+        return nullptr;
     }
 
-    // Store active service
-    ActiveService = ServiceInterface;
-    return true;
+    return ServiceInterface;
+}
+
+void UN2CLLMModule::CreateRoutedServices()
+{
+    // Routed services still configured are reconfigured in place
+    TMap<EN2CLLMProvider, UObject*> PreviousServices = MoveTemp(RoutedServices);
+    RoutedServices.Reset();
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings || !Settings->bRouteAcrossProviders)
+    {
+        return;
+    }
+
+    for (const EN2CLLMProvider Provider : Settings->RoutingProviders)
+    {
+        if (Provider == Config.Provider || RoutedServices.Contains(Provider))
+        {
+            continue;
+        }
+
+        // Each routed provider uses its own key and model, with the shared request options
+        FN2CLLMConfig ServiceConfig = Config;
+        ServiceConfig.Provider = Provider;
+        ServiceConfig.ApiKey = Settings->GetApiKey(Provider);
+        ServiceConfig.Model = Settings->GetModel(Provider);
+        ServiceConfig.ApiEndpoint.Empty();
+
+        TScriptInterface<IN2CLLMService> Service = ReconfigureOrCreateService(PreviousServices.FindRef(Provider), Provider, ServiceConfig);
+        if (Service.GetInterface())
+        {
+            RoutedServices.Add(Provider, Service.GetObject());
+        }
+    }
+
+    if (RoutedServices.Num() > 0)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Routing requests across %d providers"), RoutedServices.Num() + 1),
+            EN2CLogSeverity::Info, TEXT("LLMModule"));
+    }
+}
+
+TArray<EN2CLLMProvider> UN2CLLMModule::GetRoutingCandidates() const
+{
+    TArray<EN2CLLMProvider> Candidates = { Config.Provider };
+    for (const TPair<EN2CLLMProvider, UObject*>& Pair : RoutedServices)
+    {
+        if (Pair.Value)
+        {
+            Candidates.Add(Pair.Key);
+        }
+    }
+    return Candidates;
+}
+
+TScriptInterface<IN2CLLMService> UN2CLLMModule::GetServiceForProvider(EN2CLLMProvider Provider) const
+{
+    if (Provider == Config.Provider)
+    {
+        return ActiveService;
+    }
+
+    UObject* const* Service = RoutedServices.Find(Provider);
+    return Service && *Service ? TScriptInterface<IN2CLLMService>(*Service) : TScriptInterface<IN2CLLMService>();
+}
+
+FString UN2CLLMModule::GetModelForProvider(EN2CLLMProvider Provider) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Provider == Config.Provider || !Settings ? Config.Model : Settings->GetModel(Provider);
 }
 void UN2CLLMModule::InitializeProviderRegistry()
 {
@@ -721,6 +3041,7 @@ void UN2CLLMModule::InitializeProviderRegistry()
     Registry->RegisterProvider(EN2CLLMProvider::DeepSeek, UN2CDeepSeekService::StaticClass());
     Registry->RegisterProvider(EN2CLLMProvider::Ollama, UN2COllamaService::StaticClass());
     Registry->RegisterProvider(EN2CLLMProvider::LMStudio, UN2CLMStudioService::StaticClass());
+    Registry->RegisterProvider(EN2CLLMProvider::OpenAICompatible, UN2COpenAICompatibleService::StaticClass());
     
     FN2CLogger::Get().Log(TEXT("Provider registry initialized"), EN2CLogSeverity::Info, TEXT("LLMModule"));
 }
@@ -1,500 +1,925 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "LLM/N2CLLMPayloadBuilder.h"
+#include "Core/N2CSettings.h"
+#include "Utils/N2CJsonEscape.h"
 #include "Utils/N2CLogger.h"
 #include "Serialization/JsonSerializer.h"
 
-void UN2CLLMPayloadBuilder::Initialize(const FString& InModelName)
+namespace
 {
-    // Create root JSON object
-    RootObject = MakeShared<FJsonObject>();
-    MessagesArray.Empty();
+    void AppendAscii(TArray<uint8>& Out, FAnsiStringView Text)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(Text.GetData()), Text.Len());
+    }
+
+    /** Shortest form that reads back as the same double, as the engine JSON writer prints numbers */
+    void AppendNumber(TArray<uint8>& Out, double Value)
+    {
+        ANSICHAR Buffer[32];
+        const int32 Len = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.17g", Value);
+        AppendAscii(Out, FAnsiStringView(Buffer, FMath::Clamp(Len, 0, int32(UE_ARRAY_COUNT(Buffer)) - 1)));
+    }
+
+    void WriteJsonObjectUtf8(TArray<uint8>& Out, const FJsonObject& Object);
+
+    /** Condensed like TCondensedJsonPrintPolicy, but strings go through the bulk escaper */
+    void WriteJsonValueUtf8(TArray<uint8>& Out, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            AppendAscii(Out, "null");
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::String:
+            FN2CJsonEscape::AppendQuotedUtf8(Out, Value->AsString());
+            break;
+        case EJson::Number:
+            AppendNumber(Out, Value->AsNumber());
+            break;
+        case EJson::Boolean:
+            AppendAscii(Out, Value->AsBool() ? "true" : "false");
+            break;
+        case EJson::Array:
+            {
+                Out.Add('[');
+                const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+                for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ++ItemIndex)
+                {
+                    if (ItemIndex > 0)
+                    {
+                        Out.Add(',');
+                    }
+                    WriteJsonValueUtf8(Out, Items[ItemIndex]);
+                }
+                Out.Add(']');
+            }
+            break;
+        case EJson::Object:
+            {
+                const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+                if (Object.IsValid())
+                {
+                    WriteJsonObjectUtf8(Out, *Object);
+                }
+                else
+                {
+                    AppendAscii(Out, "null");
+                }
+            }
+            break;
+        default:
+            AppendAscii(Out, "null");
+            break;
+        }
+    }
+
+    void WriteJsonObjectUtf8(TArray<uint8>& Out, const FJsonObject& Object)
+    {
+        Out.Add('{');
+        bool bFirst = true;
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+        {
+            if (!bFirst)
+            {
+                Out.Add(',');
+            }
+            bFirst = false;
+
+            FN2CJsonEscape::AppendQuotedUtf8(Out, Field.Key);
+            Out.Add(':');
+            WriteJsonValueUtf8(Out, Field.Value);
+        }
+        Out.Add('}');
+    }
+}
+
+/** Keeps a flag per open object or array for whether it has a member yet, so commas are placed on the way */
+class FN2CLLMPayloadBuilder::FWriter
+{
+public:
+    /** bInsideObject writes bare fields, to be spliced into an object later */
+    explicit FWriter(TArray<uint8>& InOut, bool bInsideObject = false)
+        : Out(InOut)
+    {
+        if (bInsideObject)
+        {
+            bFirst.Push(true);
+        }
+    }
+
+    void BeginObject() { BeginValue(); Out.Add('{'); bFirst.Push(true); }
+    void EndObject() { bFirst.Pop(); Out.Add('}'); }
+    void BeginArray() { BeginValue(); Out.Add('['); bFirst.Push(true); }
+    void EndArray() { bFirst.Pop(); Out.Add(']'); }
+
+    FWriter& Key(FAnsiStringView Name)
+    {
+        Separate();
+        Out.Add('"');
+        AppendAscii(Out, Name);
+        Out.Add('"');
+        Out.Add(':');
+        bAfterKey = true;
+        return *this;
+    }
+
+    void String(FStringView Value) { BeginValue(); FN2CJsonEscape::AppendQuotedUtf8(Out, Value); }
+    void Number(double Value) { BeginValue(); AppendNumber(Out, Value); }
+    void Bool(bool bValue) { BeginValue(); AppendAscii(Out, bValue ? "true" : "false"); }
+    void Object(const FJsonObject& Value) { BeginValue(); WriteJsonObjectUtf8(Out, Value); }
+
+    /** One string written from two parts with a blank line between them, as if they had been joined */
+    void JoinedString(FStringView First, FStringView Second)
+    {
+        BeginValue();
+        Out.Add('"');
+        FN2CJsonEscape::AppendEscapedUtf8(Out, First);
+        AppendAscii(Out, "\\n\\n");
+        FN2CJsonEscape::AppendEscapedUtf8(Out, Second);
+        Out.Add('"');
+    }
+
+    /** Fields written by a writer with bInsideObject, added to the current object */
+    void Fields(const TArray<uint8>& Bytes)
+    {
+        if (Bytes.Num() > 0)
+        {
+            Separate();
+            Out.Append(Bytes);
+        }
+    }
+
+private:
+    void Separate()
+    {
+        if (!bFirst.Last())
+        {
+            Out.Add(',');
+        }
+        bFirst.Last() = false;
+    }
+
+    void BeginValue()
+    {
+        if (bAfterKey)
+        {
+            bAfterKey = false;
+        }
+        else if (bFirst.Num() > 0)
+        {
+            Separate();
+        }
+    }
+
+    TArray<uint8>& Out;
+    TArray<bool, TInlineAllocator<8>> bFirst;
+    bool bAfterKey = false;
+};
+
+void FN2CLLMPayloadBuilder::Initialize(const FString& InModelName)
+{
+    // Buffers and the serialized response format are kept for the next payload
     ModelName = InModelName;
-    
-    // Set model name
-    RootObject->SetStringField(TEXT("model"), ModelName);
-    
-    // Set default values
-    SetTemperature(0.0f);
-    SetMaxTokens(8192);
+    Temperature = 0.0f;
+    MaxTokens = 8192;
+    ReasoningEffort.Reset();
+    bStream.Reset();
+    PromptCacheKey.Reset();
+    CachedContentName.Reset();
+    bPromptCaching = false;
+    OllamaOptions.Reset();
+    OllamaKeepAlive.Reset();
+    Messages.Reset();
+    ResponseSchema.Reset();
 }
 
-void UN2CLLMPayloadBuilder::SetModel(const FString& InModelName)
+void FN2CLLMPayloadBuilder::SetModel(const FString& InModelName)
 {
     ModelName = InModelName;
-    RootObject->SetStringField(TEXT("model"), ModelName);
 }
 
-void UN2CLLMPayloadBuilder::SetTemperature(float Value)
+bool FN2CLLMPayloadBuilder::IsOpenAIReasoningModel() const
+{
+    return ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")) || ModelName.StartsWith(TEXT("o4"));
+}
+
+void FN2CLLMPayloadBuilder::SetTemperature(float Value)
+{
+    if (ProviderType == EN2CLLMProvider::OpenAI && IsOpenAIReasoningModel())
+    {
+        // OpenAI o1, o3, and o4 models don't support temperature
+        FN2CLogger::Get().Log(TEXT("Temperature parameter not supported for o1/o3 models, skipping"), EN2CLogSeverity::Debug);
+    }
+    else if (ProviderType == EN2CLLMProvider::LMStudio)
+    {
+        // Let the LM Studio UI handle temperature. This allows users to configure it there and prevents
+        // interference with reasoning models that may perform worse with low temperatures
+        FN2CLogger::Get().Log(TEXT("Temperature parameter skipped for LM Studio - use LM Studio UI to configure"), EN2CLogSeverity::Debug);
+    }
+    Temperature = Value;
+}
+
+void FN2CLLMPayloadBuilder::SetMaxTokens(int32 Value)
+{
+    // The field it is written to depends on the provider, see BuildUtf8
+    MaxTokens = Value;
+}
+
+void FN2CLLMPayloadBuilder::SetReasoningEffort(EN2CReasoningEffort Effort)
 {
+    ReasoningEffort = Effort;
+}
+
+void FN2CLLMPayloadBuilder::AddSystemMessage(const FString& Content)
+{
+    if (Content.IsEmpty())
+    {
+        return;
+    }
+
+    FMessage& Message = Messages.AddDefaulted_GetRef();
+    Message.bSystem = true;
+    Message.Content = Content;
+}
+
+void FN2CLLMPayloadBuilder::AddUserMessage(const FString& Content)
+{
+    if (Content.IsEmpty())
+    {
+        return;
+    }
+
+    Messages.AddDefaulted_GetRef().Content = Content;
+}
+
+void FN2CLLMPayloadBuilder::AddUserMessageWithPrefix(const FString& StablePrefix, const FString& Content)
+{
+    if (StablePrefix.IsEmpty())
+    {
+        AddUserMessage(Content);
+        return;
+    }
+
+    // Anthropic gets the prefix as a content block of its own; the other providers get one string, kept in
+    // parts here so the two are only joined when the payload is written
+    FMessage& Message = Messages.AddDefaulted_GetRef();
+    Message.Prefix = StablePrefix;
+    Message.Content = Content;
+}
+
+void FN2CLLMPayloadBuilder::SetPromptCaching(bool bEnabled)
+{
+    bPromptCaching = bEnabled;
+}
+
+void FN2CLLMPayloadBuilder::SetPromptCacheKey(const FString& Key)
+{
+    PromptCacheKey = Key;
+}
+
+void FN2CLLMPayloadBuilder::SetCachedContent(const FString& InCachedContentName)
+{
+    CachedContentName = InCachedContentName;
+}
+
+void FN2CLLMPayloadBuilder::SetJsonResponseFormat(const TSharedPtr<FJsonObject>& Schema)
+{
+    if (!Schema.IsValid())
+    {
+        return;
+    }
+
+    if (ProviderType == EN2CLLMProvider::OpenAI && (ModelName == TEXT("o1-preview-2024-09-12") || ModelName == TEXT("o1-mini-2024-09-12")))
+    {
+        // o1-preview and o1-mini don't support response_format at all
+        FN2CLogger::Get().Log(TEXT("Response format not supported for o1-preview/o1-mini, skipping"), EN2CLogSeverity::Debug);
+        return;
+    }
+    ResponseSchema = Schema;
+}
+
+void FN2CLLMPayloadBuilder::SetStreaming(bool bEnabled)
+{
+    bStream = bEnabled;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForOpenAI()
+{
+    ProviderType = EN2CLLMProvider::OpenAI;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForAnthropic()
+{
+    ProviderType = EN2CLLMProvider::Anthropic;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForGemini()
+{
+    ProviderType = EN2CLLMProvider::Gemini;
+
+    // Temperature and maxOutputTokens live in generationConfig, next to the fixed topK and topP
+    Temperature = 0.0f;
+    MaxTokens = 8192;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForDeepSeek()
+{
+    ProviderType = EN2CLLMProvider::DeepSeek;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForOllama(const FN2COllamaConfig& OllamaConfig)
+{
+    ProviderType = EN2CLLMProvider::Ollama;
+
+    // Ollama-specific options; num_predict is written from MaxTokens
+    MaxTokens = OllamaConfig.NumPredict;
+    OllamaOptions = {
+        { "temperature", OllamaConfig.Temperature },
+        { "top_p", OllamaConfig.TopP },
+        { "top_k", OllamaConfig.TopK },
+        { "min_p", OllamaConfig.MinP },
+        { "repeat_penalty", OllamaConfig.RepeatPenalty },
+        { "mirostat", OllamaConfig.Mirostat },
+        { "mirostat_eta", OllamaConfig.MirostatEta },
+        { "mirostat_tau", OllamaConfig.MirostatTau },
+        { "num_ctx", OllamaConfig.NumCtx },
+        { "seed", OllamaConfig.Seed },
+    };
+    OllamaKeepAlive = OllamaConfig.KeepAlive;
+    bStream = false;  // Overridden by SetStreaming
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForLMStudio()
+{
+    ProviderType = EN2CLLMProvider::LMStudio;
+
+    // LM Studio uses OpenAI-compatible format, non-streamed unless SetStreaming enables it. Temperature
+    // is left to the LM Studio UI
+    bStream = false;
+}
+
+void FN2CLLMPayloadBuilder::ConfigureForOpenAICompatible()
+{
+    ProviderType = EN2CLLMProvider::OpenAICompatible;
+
+    // Self-hosted servers follow the OpenAI chat completions format, non-streamed unless SetStreaming enables it
+    bStream = false;
+}
+
+const TArray<uint8>& FN2CLLMPayloadBuilder::GetResponseFormatFields()
+{
+    if (ResponseFormatSchema == ResponseSchema && ResponseFormatProvider == ProviderType && ResponseFormatModel == ModelName)
+    {
+        return ResponseFormatBytes;
+    }
+    ResponseFormatSchema = ResponseSchema;
+    ResponseFormatProvider = ProviderType;
+    ResponseFormatModel = ModelName;
+
+    ResponseFormatBytes.Reset();
+    if (!ResponseSchema.IsValid())
+    {
+        return ResponseFormatBytes;
+    }
+
+    FWriter Writer(ResponseFormatBytes, true);
     switch (ProviderType)
     {
-        case EN2CLLMProvider::Gemini:
-            {
-                // Gemini only accepts temperature in generationConfig
-                TSharedPtr<FJsonObject> GenConfig = RootObject->GetObjectField(TEXT("generationConfig"));
-                if (!GenConfig.IsValid())
-                {
-                    GenConfig = MakeShared<FJsonObject>();
-                    RootObject->SetObjectField(TEXT("generationConfig"), GenConfig);
-                }
-                GenConfig->SetNumberField(TEXT("temperature"), Value);
-            }
-            break;
         case EN2CLLMProvider::OpenAI:
-            // OpenAI o1, o3, and o4 models don't support temperature
-            if (ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")) || ModelName.StartsWith(TEXT("o4")))
+            Writer.Key("response_format").BeginObject();
+            if (ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")))
             {
-                // Skip setting temperature for o1 and o3 models
-                FN2CLogger::Get().Log(TEXT("Temperature parameter not supported for o1/o3 models, skipping"), EN2CLogSeverity::Debug);
+                // Other o1/o3 models use json_object type without schema
+                Writer.Key("type").String(TEXT("json_object"));
             }
             else
             {
-                RootObject->SetNumberField(TEXT("temperature"), Value);
+                Writer.Key("type").String(TEXT("json_schema"));
+                Writer.Key("json_schema").BeginObject();
+                Writer.Key("name").String(TEXT("n2c_translation_schema"));
+                Writer.Key("schema").Object(*ResponseSchema);
+                Writer.EndObject();
             }
+            Writer.EndObject();
+            break;
+
+        case EN2CLLMProvider::Gemini:
+            // Written inside generationConfig
+            Writer.Key("responseMimeType").String(TEXT("application/json"));
+            Writer.Key("responseSchema").Object(*ResponseSchema);
+            break;
+
+        case EN2CLLMProvider::DeepSeek:
+            Writer.Key("response_format").BeginObject();
+            Writer.Key("type").String(TEXT("json_object"));
+            Writer.EndObject();
+            break;
+
+        case EN2CLLMProvider::Ollama:
+            Writer.Key("format").Object(*ResponseSchema);
             break;
+
         case EN2CLLMProvider::LMStudio:
-            // Skip setting temperature for LM Studio - let the LM Studio UI handle this
-            // This allows users to configure temperature in LM Studio and prevents
-            // interference with reasoning models that may perform worse with low temperatures
-            FN2CLogger::Get().Log(TEXT("Temperature parameter skipped for LM Studio - use LM Studio UI to configure"), EN2CLogSeverity::Debug);
+            // LM Studio uses OpenAI-compatible structured output format
+            Writer.Key("response_format").BeginObject();
+            Writer.Key("type").String(TEXT("json_schema"));
+            Writer.Key("json_schema").BeginObject();
+            Writer.Key("name").String(TEXT("n2c_translation_schema"));
+            Writer.Key("strict").String(TEXT("true"));
+            Writer.Key("schema").Object(*ResponseSchema);
+            Writer.EndObject();
+            Writer.EndObject();
             break;
-        default:
-            // All other providers use root-level temperature
-            RootObject->SetNumberField(TEXT("temperature"), Value);
+
+        case EN2CLLMProvider::OpenAICompatible:
+            // vLLM, TGI and SGLang constrain decoding to the schema through the OpenAI structured output format
+            Writer.Key("response_format").BeginObject();
+            Writer.Key("type").String(TEXT("json_schema"));
+            Writer.Key("json_schema").BeginObject();
+            Writer.Key("name").String(TEXT("n2c_translation_schema"));
+            Writer.Key("schema").Object(*ResponseSchema);
+            Writer.EndObject();
+            Writer.EndObject();
+            break;
+
+        case EN2CLLMProvider::Anthropic:
+            // Anthropic has no response format, but a forced tool call returns input matching the schema
+            Writer.Key("tools").BeginArray();
+            Writer.BeginObject();
+            Writer.Key("name").String(TEXT("n2c_translation"));
+            Writer.Key("description").String(TEXT("Return the translated graphs"));
+            Writer.Key("input_schema").Object(*ResponseSchema);
+            Writer.EndObject();
+            Writer.EndArray();
+            Writer.Key("tool_choice").BeginObject();
+            Writer.Key("type").String(TEXT("tool"));
+            Writer.Key("name").String(TEXT("n2c_translation"));
+            Writer.EndObject();
             break;
     }
+    return ResponseFormatBytes;
 }
 
-void UN2CLLMPayloadBuilder::SetMaxTokens(int32 Value)
+void FN2CLLMPayloadBuilder::WriteMessages(FWriter& Writer) const
 {
-    // Different providers use different field names for max tokens
+    auto WriteUserText = [&Writer](const FMessage& Message)
+    {
+        if (Message.Prefix.IsEmpty())
+        {
+            Writer.String(Message.Content);
+        }
+        else
+        {
+            Writer.JoinedString(Message.Prefix, Message.Content);
+        }
+    };
+
     switch (ProviderType)
     {
         case EN2CLLMProvider::Anthropic:
-            RootObject->SetNumberField(TEXT("max_tokens"), Value);
-            break;
-        case EN2CLLMProvider::Gemini:
+            for (const FMessage& Message : Messages)
             {
-                // Gemini uses generationConfig.maxOutputTokens
-                TSharedPtr<FJsonObject> GenConfig = RootObject->GetObjectField(TEXT("generationConfig"));
-                if (!GenConfig.IsValid())
+                if (!Message.bSystem)
+                {
+                    continue;
+                }
+
+                // Anthropic uses a top-level "system" field. A system block with cache_control lets repeated
+                // requests reuse the processed prompt
+                Writer.Key("system");
+                if (bPromptCaching)
+                {
+                    Writer.BeginArray();
+                    Writer.BeginObject();
+                    Writer.Key("type").String(TEXT("text"));
+                    Writer.Key("text").String(Message.Content);
+                    Writer.Key("cache_control").BeginObject();
+                    Writer.Key("type").String(TEXT("ephemeral"));
+                    Writer.EndObject();
+                    Writer.EndObject();
+                    Writer.EndArray();
+                }
+                else
                 {
-                    GenConfig = MakeShared<FJsonObject>();
-                    RootObject->SetObjectField(TEXT("generationConfig"), GenConfig);
+                    Writer.String(Message.Content);
                 }
-                GenConfig->SetNumberField(TEXT("maxOutputTokens"), Value);
+                break;
             }
-            break;
-        case EN2CLLMProvider::Ollama:
+
+            Writer.Key("messages").BeginArray();
+            for (const FMessage& Message : Messages)
             {
-                // Ollama uses options.num_predict
-                TSharedPtr<FJsonObject> Options = RootObject->GetObjectField(TEXT("options"));
-                if (!Options.IsValid())
+                if (Message.bSystem)
                 {
-                    Options = MakeShared<FJsonObject>();
-                    RootObject->SetObjectField(TEXT("options"), Options);
+                    continue;
                 }
-                Options->SetNumberField(TEXT("num_predict"), Value);
+
+                Writer.BeginObject();
+                Writer.Key("role").String(TEXT("user"));
+                Writer.Key("content").BeginArray();
+                if (bPromptCaching && !Message.Prefix.IsEmpty() && !Message.Content.IsEmpty())
+                {
+                    // Separate content blocks so the cache breakpoint sits right after the stable prefix
+                    Writer.BeginObject();
+                    Writer.Key("type").String(TEXT("text"));
+                    Writer.Key("text").String(Message.Prefix);
+                    Writer.Key("cache_control").BeginObject();
+                    Writer.Key("type").String(TEXT("ephemeral"));
+                    Writer.EndObject();
+                    Writer.EndObject();
+
+                    Writer.BeginObject();
+                    Writer.Key("type").String(TEXT("text"));
+                    Writer.Key("text").String(Message.Content);
+                    Writer.EndObject();
+                }
+                else
+                {
+                    Writer.BeginObject();
+                    Writer.Key("type").String(TEXT("text"));
+                    Writer.Key("text");
+                    WriteUserText(Message);
+                    Writer.EndObject();
+                }
+                Writer.EndArray();
+                Writer.EndObject();
             }
+            Writer.EndArray();
             break;
-        case EN2CLLMProvider::OpenAI:
-            // OpenAI o1, o3, and o4 models use max_completion_tokens instead of max_tokens
-            if (ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")) || ModelName.StartsWith(TEXT("o4")))
+
+        case EN2CLLMProvider::Gemini:
+            for (const FMessage& Message : Messages)
             {
-                RootObject->SetNumberField(TEXT("max_completion_tokens"), Value);
+                if (Message.bSystem)
+                {
+                    // Gemini uses systemInstruction.parts
+                    Writer.Key("systemInstruction").BeginObject();
+                    Writer.Key("role").String(TEXT("user"));
+                    Writer.Key("parts").BeginArray();
+                    Writer.BeginObject();
+                    Writer.Key("text").String(Message.Content);
+                    Writer.EndObject();
+                    Writer.EndArray();
+                    Writer.EndObject();
+                    break;
+                }
             }
-            else
+
+            // Gemini uses contents array with parts
+            Writer.Key("contents").BeginArray();
+            for (const FMessage& Message : Messages)
             {
-                RootObject->SetNumberField(TEXT("max_tokens"), Value);
+                if (Message.bSystem)
+                {
+                    continue;
+                }
+
+                Writer.BeginObject();
+                Writer.Key("role").String(TEXT("user"));
+                Writer.Key("parts").BeginArray();
+                Writer.BeginObject();
+                Writer.Key("text");
+                WriteUserText(Message);
+                Writer.EndObject();
+                Writer.EndArray();
+                Writer.EndObject();
             }
+            Writer.EndArray();
             break;
-        case EN2CLLMProvider::LMStudio:
-            // LM Studio uses OpenAI-compatible format with max_tokens
-            RootObject->SetNumberField(TEXT("max_tokens"), Value);
-            break;
+
         default:
-            // DeepSeek uses max_tokens
-            RootObject->SetNumberField(TEXT("max_tokens"), Value);
+            // OpenAI, DeepSeek, LMStudio, Ollama and OpenAI-compatible servers use messages array with role=system and role=user
+            Writer.Key("messages").BeginArray();
+            for (const FMessage& Message : Messages)
+            {
+                Writer.BeginObject();
+                Writer.Key("role").String(Message.bSystem ? TEXT("system") : TEXT("user"));
+                Writer.Key("content");
+                WriteUserText(Message);
+                Writer.EndObject();
+            }
+            Writer.EndArray();
             break;
     }
 }
 
-void UN2CLLMPayloadBuilder::AddSystemMessage(const FString& Content)
+void FN2CLLMPayloadBuilder::WriteGeminiGenerationConfig(FWriter& Writer)
 {
-    if (Content.IsEmpty())
+    Writer.Key("generationConfig").BeginObject();
+    Writer.Key("topK").Number(40.0);
+    Writer.Key("topP").Number(0.95);
+    if (Temperature.IsSet())
     {
-        return;
+        Writer.Key("temperature").Number(Temperature.GetValue());
     }
-    
-    switch (ProviderType)
+    if (MaxTokens.IsSet())
     {
-        case EN2CLLMProvider::Anthropic:
-            // Anthropic uses a top-level "system" field
-            RootObject->SetStringField(TEXT("system"), Content);
-            break;
-            
-        case EN2CLLMProvider::Gemini:
-            {
-                // Gemini uses systemInstruction.parts
-                TSharedPtr<FJsonObject> SysInstructionObj = MakeShared<FJsonObject>();
-                SysInstructionObj->SetStringField(TEXT("role"), TEXT("user"));
-                
-                TArray<TSharedPtr<FJsonValue>> SysPartsArray;
-                TSharedPtr<FJsonObject> PartObj = MakeShared<FJsonObject>();
-                PartObj->SetStringField(TEXT("text"), Content);
-                SysPartsArray.Add(MakeShared<FJsonValueObject>(PartObj));
-                
-                SysInstructionObj->SetArrayField(TEXT("parts"), SysPartsArray);
-                RootObject->SetObjectField(TEXT("systemInstruction"), SysInstructionObj);
-            }
-            break;
-            
-        default:
-            // OpenAI, DeepSeek, LMStudio, and Ollama use messages array with role=system
-            TSharedPtr<FJsonObject> SystemMessageObject = MakeShared<FJsonObject>();
-            SystemMessageObject->SetStringField(TEXT("role"), TEXT("system"));
-            SystemMessageObject->SetStringField(TEXT("content"), Content);
-            MessagesArray.Add(MakeShared<FJsonValueObject>(SystemMessageObject));
-            break;
+        Writer.Key("maxOutputTokens").Number(MaxTokens.GetValue());
     }
+    if (ReasoningEffort.IsSet())
+    {
+        // Pro models cannot turn thinking off and take at least 128 tokens
+        const EN2CReasoningEffort Effort = ReasoningEffort.GetValue();
+        const int32 MinBudget = ModelName.Contains(TEXT("pro")) ? 128 : 0;
+        const int32 Budget = Effort == EN2CReasoningEffort::High ? 16384
+            : Effort == EN2CReasoningEffort::Medium ? 4096
+            : Effort == EN2CReasoningEffort::Low ? 1024 : MinBudget;
+
+        Writer.Key("thinkingConfig").BeginObject();
+        Writer.Key("thinkingBudget").Number(Budget);
+        Writer.EndObject();
+    }
+    Writer.Fields(GetResponseFormatFields());
+    Writer.EndObject();
 }
 
-void UN2CLLMPayloadBuilder::AddUserMessage(const FString& Content)
+FString FN2CLLMPayloadBuilder::Build()
 {
-    if (Content.IsEmpty())
+    const TArray<uint8> Payload = BuildUtf8();
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+    return FString(Converted.Length(), Converted.Get());
+}
+
+TArray<uint8> FN2CLLMPayloadBuilder::BuildUtf8()
+{
+    // Serialize straight into UTF-8 bytes, so the body is written once and never held as a wide string.
+    // Messages and reference files dominate the size, so their clean runs are copied in bulk rather than
+    // escaped character by character.
+    int32 MessageChars = 0;
+    for (const FMessage& Message : Messages)
     {
-        return;
+        MessageChars += Message.Prefix.Len() + Message.Content.Len();
     }
-    
+    TArray<uint8> Payload;
+    Payload.Reserve(FMath::Max(LastPayloadSize, MessageChars + MessageChars / 16 + GetResponseFormatFields().Num() + 512));
+
+    FWriter Writer(Payload);
+    Writer.BeginObject();
+    Writer.Key("model").String(ModelName);
+
     switch (ProviderType)
     {
         case EN2CLLMProvider::Gemini:
+            WriteGeminiGenerationConfig(Writer);
+            if (!CachedContentName.IsEmpty())
             {
-                // Gemini uses contents array with parts
-                TSharedPtr<FJsonObject> UserObject = MakeShared<FJsonObject>();
-                UserObject->SetStringField(TEXT("role"), TEXT("user"));
-                
-                TArray<TSharedPtr<FJsonValue>> PartsArray;
-                TSharedPtr<FJsonObject> PartObj = MakeShared<FJsonObject>();
-                PartObj->SetStringField(TEXT("text"), Content);
-                PartsArray.Add(MakeShared<FJsonValueObject>(PartObj));
-                
-                UserObject->SetArrayField(TEXT("parts"), PartsArray);
-                
-                // Wrap in contents array
-                TArray<TSharedPtr<FJsonValue>> ContentsArray;
-                ContentsArray.Add(MakeShared<FJsonValueObject>(UserObject));
-                
-                RootObject->SetArrayField(TEXT("contents"), ContentsArray);
+                Writer.Key("cachedContent").String(CachedContentName);
             }
             break;
-            
-        case EN2CLLMProvider::Anthropic:
+
+        case EN2CLLMProvider::Ollama:
+            Writer.Key("options").BeginObject();
+            if (MaxTokens.IsSet())
             {
-                // Anthropic uses messages array with content array
-                TSharedPtr<FJsonObject> UserContent = MakeShared<FJsonObject>();
-                UserContent->SetStringField(TEXT("role"), TEXT("user"));
-                
-                // Build content array with text entry
-                TArray<TSharedPtr<FJsonValue>> ContentEntries;
-                TSharedPtr<FJsonObject> TextContent = MakeShared<FJsonObject>();
-                TextContent->SetStringField(TEXT("type"), TEXT("text"));
-                TextContent->SetStringField(TEXT("text"), Content);
-                ContentEntries.Add(MakeShared<FJsonValueObject>(TextContent));
-                
-                UserContent->SetArrayField(TEXT("content"), ContentEntries);
-                MessagesArray.Add(MakeShared<FJsonValueObject>(UserContent));
-                
-                // Set messages array in root
-                RootObject->SetArrayField(TEXT("messages"), MessagesArray);
+                Writer.Key("num_predict").Number(MaxTokens.GetValue());
+            }
+            for (const TPair<const ANSICHAR*, double>& Option : OllamaOptions)
+            {
+                Writer.Key(Option.Key).Number(Option.Value);
+            }
+            Writer.EndObject();
+            if (OllamaKeepAlive.IsSet())
+            {
+                Writer.Key("keep_alive").Number(OllamaKeepAlive.GetValue());
+            }
+            if (ReasoningEffort.IsSet() && ReasoningEffort.GetValue() == EN2CReasoningEffort::Off)
+            {
+                // The API form of /no_think; other levels keep the model's own default
+                Writer.Key("think").Bool(false);
             }
             break;
-            
-        default:
-            // OpenAI, DeepSeek, LMStudio, and Ollama use messages array with role=user
-            TSharedPtr<FJsonObject> UserMessageObject = MakeShared<FJsonObject>();
-            UserMessageObject->SetStringField(TEXT("role"), TEXT("user"));
-            UserMessageObject->SetStringField(TEXT("content"), Content);
-            MessagesArray.Add(MakeShared<FJsonValueObject>(UserMessageObject));
-            
-            // Set messages array in root
-            RootObject->SetArrayField(TEXT("messages"), MessagesArray);
-            break;
-    }
-}
 
-void UN2CLLMPayloadBuilder::SetJsonResponseFormat(const TSharedPtr<FJsonObject>& Schema)
-{
-    if (!Schema.IsValid())
-    {
-        return;
-    }
-    
-    switch (ProviderType)
-    {
         case EN2CLLMProvider::OpenAI:
             {
-                // Special handling for different OpenAI models
-                if (ModelName == TEXT("o1-preview-2024-09-12") || ModelName == TEXT("o1-mini-2024-09-12"))
+                // o1, o3, and o4 models take no temperature and use max_completion_tokens instead of max_tokens
+                const bool bReasoningModel = IsOpenAIReasoningModel();
+                if (Temperature.IsSet() && !bReasoningModel)
                 {
-                    // o1-preview and o1-mini don't support response_format at all
-                    // Skip setting response_format for these models
-                    FN2CLogger::Get().Log(TEXT("Response format not supported for o1-preview/o1-mini, skipping"), EN2CLogSeverity::Debug);
+                    Writer.Key("temperature").Number(Temperature.GetValue());
                 }
-                else if (ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")))
+                if (MaxTokens.IsSet())
                 {
-                    // Other o1/o3 models use json_object type without schema
-                    TSharedPtr<FJsonObject> ResponseFormatObject = MakeShared<FJsonObject>();
-                    ResponseFormatObject->SetStringField(TEXT("type"), TEXT("json_object"));
-                    RootObject->SetObjectField(TEXT("response_format"), ResponseFormatObject);
+                    Writer.Key(bReasoningModel ? "max_completion_tokens" : "max_tokens").Number(MaxTokens.GetValue());
                 }
-                else
+                if (ReasoningEffort.IsSet())
                 {
-                    // Other models use json_schema with schema object
-                    TSharedPtr<FJsonObject> ResponseFormatObject = MakeShared<FJsonObject>();
-                    ResponseFormatObject->SetStringField(TEXT("type"), TEXT("json_schema"));
-                    
-                    // Create a wrapper object with name and schema fields
-                    TSharedPtr<FJsonObject> JsonSchemaWrapper = MakeShared<FJsonObject>();
-                    JsonSchemaWrapper->SetStringField(TEXT("name"), TEXT("n2c_translation_schema"));
-                    JsonSchemaWrapper->SetObjectField(TEXT("schema"), Schema);
-                    
-                    ResponseFormatObject->SetObjectField(TEXT("json_schema"), JsonSchemaWrapper);
-                    RootObject->SetObjectField(TEXT("response_format"), ResponseFormatObject);
+                    // The o-series always reasons, so Off asks for the least it accepts
+                    const EN2CReasoningEffort Effort = ReasoningEffort.GetValue();
+                    Writer.Key("reasoning_effort").String(Effort == EN2CReasoningEffort::High ? TEXT("high")
+                        : Effort == EN2CReasoningEffort::Medium ? TEXT("medium") : TEXT("low"));
                 }
-            }
-            break;
-            
-        case EN2CLLMProvider::Gemini:
-            {
-                // Gemini uses generationConfig
-                TSharedPtr<FJsonObject> GenConfigObj = RootObject->GetObjectField(TEXT("generationConfig"));
-                if (!GenConfigObj.IsValid())
+
+                // Only OpenAI accepts a routing hint that keeps requests sharing a prefix on the same cache
+                if (bPromptCaching && !PromptCacheKey.IsEmpty())
                 {
-                    GenConfigObj = MakeShared<FJsonObject>();
-                    RootObject->SetObjectField(TEXT("generationConfig"), GenConfigObj);
+                    Writer.Key("prompt_cache_key").String(PromptCacheKey);
                 }
-                
-                // Set MIME type and schema
-                GenConfigObj->SetStringField(TEXT("responseMimeType"), TEXT("application/json"));
-                GenConfigObj->SetObjectField(TEXT("responseSchema"), Schema);
             }
             break;
-            
-        case EN2CLLMProvider::DeepSeek:
+
+        case EN2CLLMProvider::LMStudio:
+            // LM Studio uses OpenAI-compatible format with max_tokens
+            if (MaxTokens.IsSet())
             {
-                // DeepSeek uses response_format.type = json_object
-                TSharedPtr<FJsonObject> ResponseFormatObject = MakeShared<FJsonObject>();
-                ResponseFormatObject->SetStringField(TEXT("type"), TEXT("json_object"));
-                RootObject->SetObjectField(TEXT("response_format"), ResponseFormatObject);
+                Writer.Key("max_tokens").Number(MaxTokens.GetValue());
             }
             break;
-            
-        case EN2CLLMProvider::Ollama:
-            // Ollama uses format field
-            RootObject->SetObjectField(TEXT("format"), Schema);
-            break;
-            
-        case EN2CLLMProvider::LMStudio:
+
+        default:
+            // Anthropic, DeepSeek and OpenAI-compatible servers use root-level temperature and max_tokens
+            if (Temperature.IsSet())
             {
-                // LM Studio uses OpenAI-compatible structured output format
-                TSharedPtr<FJsonObject> ResponseFormatObject = MakeShared<FJsonObject>();
-                ResponseFormatObject->SetStringField(TEXT("type"), TEXT("json_schema"));
-                
-                // Create a wrapper object with name and schema fields
-                TSharedPtr<FJsonObject> JsonSchemaWrapper = MakeShared<FJsonObject>();
-                JsonSchemaWrapper->SetStringField(TEXT("name"), TEXT("n2c_translation_schema"));
-                JsonSchemaWrapper->SetStringField(TEXT("strict"), TEXT("true"));
-                JsonSchemaWrapper->SetObjectField(TEXT("schema"), Schema);
-                
-                ResponseFormatObject->SetObjectField(TEXT("json_schema"), JsonSchemaWrapper);
-                RootObject->SetObjectField(TEXT("response_format"), ResponseFormatObject);
+                Writer.Key("temperature").Number(Temperature.GetValue());
+            }
+            if (MaxTokens.IsSet())
+            {
+                Writer.Key("max_tokens").Number(MaxTokens.GetValue());
             }
-            break;
-            
-        case EN2CLLMProvider::Anthropic:
-            // Anthropic doesn't have a specific JSON schema format yet
-            // but we can set the format to json
             break;
     }
-}
 
-void UN2CLLMPayloadBuilder::ConfigureForOpenAI()
-{
-    ProviderType = EN2CLLMProvider::OpenAI;
-    
-    // Clear messages array and recreate it
-    MessagesArray.Empty();
-    
-    // Remove temperature for o1, o3, o4 models as they don't support it
-    if (ModelName.StartsWith(TEXT("o1")) || ModelName.StartsWith(TEXT("o3")) || ModelName.StartsWith(TEXT("o4")))
+    if (Messages.Num() > 0)
     {
-        if (RootObject->HasField(TEXT("temperature")))
-        {
-            RootObject->RemoveField(TEXT("temperature"));
-        }
+        WriteMessages(Writer);
     }
-}
-
-void UN2CLLMPayloadBuilder::ConfigureForAnthropic()
-{
-    ProviderType = EN2CLLMProvider::Anthropic;
-    
-    // Clear messages array and recreate it
-    MessagesArray.Empty();
-}
-
-void UN2CLLMPayloadBuilder::ConfigureForGemini()
-{
-    ProviderType = EN2CLLMProvider::Gemini;
-    
-    // Create generationConfig object if it doesn't exist
-    if (!RootObject->HasField(TEXT("generationConfig")))
+    if (ProviderType != EN2CLLMProvider::Gemini)
     {
-        TSharedPtr<FJsonObject> GenConfigObj = MakeShared<FJsonObject>();
-        GenConfigObj->SetNumberField(TEXT("topK"), 40.0);
-        GenConfigObj->SetNumberField(TEXT("topP"), 0.95);
-        RootObject->SetObjectField(TEXT("generationConfig"), GenConfigObj);
+        Writer.Fields(GetResponseFormatFields());
     }
-    
-    // Remove any root-level temperature that might have been set
-    if (RootObject->HasField(TEXT("temperature")))
+
+    // Gemini streams via the streamGenerateContent endpoint, the body is unchanged
+    if (bStream.IsSet() && ProviderType != EN2CLLMProvider::Gemini)
     {
-        RootObject->RemoveField(TEXT("temperature"));
+        Writer.Key("stream").Bool(bStream.GetValue());
+        if ((ProviderType == EN2CLLMProvider::OpenAI || ProviderType == EN2CLLMProvider::OpenAICompatible) && bStream.GetValue())
+        {
+            // Usage is only reported on streamed responses when explicitly requested
+            Writer.Key("stream_options").BeginObject();
+            Writer.Key("include_usage").Bool(true);
+            Writer.EndObject();
+        }
     }
-    
-    // Remove any root-level max_tokens that might have been set
-    if (RootObject->HasField(TEXT("max_tokens")))
+    Writer.EndObject();
+    LastPayloadSize = Payload.Num();
+
+    // Only decode the payload for logging when debug output is enabled
+    if (FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Debug))
     {
-        RootObject->RemoveField(TEXT("max_tokens"));
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Request Payload:\n\n%s"),
+            *FString(Converted.Length(), Converted.Get())), EN2CLogSeverity::Debug);
     }
-    
-    // Set temperature and maxOutputTokens in generationConfig
-    SetTemperature(0.0f);
-    SetMaxTokens(8192);
-}
 
-void UN2CLLMPayloadBuilder::ConfigureForDeepSeek()
-{
-    ProviderType = EN2CLLMProvider::DeepSeek;
-    
-    // Clear messages array and recreate it
-    MessagesArray.Empty();
+    return Payload;
 }
 
-void UN2CLLMPayloadBuilder::ConfigureForOllama(const FN2COllamaConfig& OllamaConfig)
+FString FN2CLLMPayloadBuilder::BuildGeminiCachedContentPayload(
+    const FString& Model,
+    const FString& SystemMessage,
+    const FString& StablePrefix,
+    int32 TtlSeconds)
 {
-    ProviderType = EN2CLLMProvider::Ollama;
+    TSharedPtr<FJsonObject> CacheObject = MakeShared<FJsonObject>();
+    CacheObject->SetStringField(TEXT("model"), FString::Printf(TEXT("models/%s"), *Model));
+    CacheObject->SetStringField(TEXT("ttl"), FString::Printf(TEXT("%ds"), TtlSeconds));
     
-    // Clear messages array and recreate it
-    MessagesArray.Empty();
+    if (!SystemMessage.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> PartObj = MakeShared<FJsonObject>();
+        PartObj->SetStringField(TEXT("text"), SystemMessage);
+        
+        TArray<TSharedPtr<FJsonValue>> PartsArray;
+        PartsArray.Add(MakeShared<FJsonValueObject>(PartObj));
+        
+        TSharedPtr<FJsonObject> SysInstructionObj = MakeShared<FJsonObject>();
+        SysInstructionObj->SetArrayField(TEXT("parts"), PartsArray);
+        CacheObject->SetObjectField(TEXT("systemInstruction"), SysInstructionObj);
+    }
     
-    // Add Ollama-specific options
-    TSharedPtr<FJsonObject> OptionsObject = MakeShared<FJsonObject>();
-    OptionsObject->SetNumberField(TEXT("temperature"), OllamaConfig.Temperature);
-    OptionsObject->SetNumberField(TEXT("num_predict"), OllamaConfig.NumPredict);
-    OptionsObject->SetNumberField(TEXT("top_p"), OllamaConfig.TopP);
-    OptionsObject->SetNumberField(TEXT("top_k"), OllamaConfig.TopK);
-    OptionsObject->SetNumberField(TEXT("min_p"), OllamaConfig.MinP);
-    OptionsObject->SetNumberField(TEXT("repeat_penalty"), OllamaConfig.RepeatPenalty);
-    OptionsObject->SetNumberField(TEXT("mirostat"), OllamaConfig.Mirostat);
-    OptionsObject->SetNumberField(TEXT("mirostat_eta"), OllamaConfig.MirostatEta);
-    OptionsObject->SetNumberField(TEXT("mirostat_tau"), OllamaConfig.MirostatTau);
-    OptionsObject->SetNumberField(TEXT("num_ctx"), OllamaConfig.NumCtx);
-    OptionsObject->SetNumberField(TEXT("seed"), OllamaConfig.Seed);
+    if (!StablePrefix.IsEmpty())
+    {
+        TSharedPtr<FJsonObject> PartObj = MakeShared<FJsonObject>();
+        PartObj->SetStringField(TEXT("text"), StablePrefix);
+        
+        TArray<TSharedPtr<FJsonValue>> PartsArray;
+        PartsArray.Add(MakeShared<FJsonValueObject>(PartObj));
+        
+        TSharedPtr<FJsonObject> UserObject = MakeShared<FJsonObject>();
+        UserObject->SetStringField(TEXT("role"), TEXT("user"));
+        UserObject->SetArrayField(TEXT("parts"), PartsArray);
+        
+        TArray<TSharedPtr<FJsonValue>> ContentsArray;
+        ContentsArray.Add(MakeShared<FJsonValueObject>(UserObject));
+        CacheObject->SetArrayField(TEXT("contents"), ContentsArray);
+    }
     
-    RootObject->SetObjectField(TEXT("options"), OptionsObject);
-    RootObject->SetBoolField(TEXT("stream"), false);
-    RootObject->SetNumberField(TEXT("keep_alive"), OllamaConfig.KeepAlive);
+    FString Payload;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Payload);
+    FJsonSerializer::Serialize(CacheObject.ToSharedRef(), Writer);
+    return Payload;
 }
 
-void UN2CLLMPayloadBuilder::ConfigureForLMStudio()
+TSharedPtr<FJsonObject> FN2CLLMPayloadBuilder::GetN2CResponseSchema()
 {
-    ProviderType = EN2CLLMProvider::LMStudio;
-    
-    // Clear messages array and recreate it
-    MessagesArray.Empty();
-    
-    // Remove temperature if it was set during Initialize() - let LM Studio UI handle this
-    if (RootObject->HasField(TEXT("temperature")))
-    {
-        RootObject->RemoveField(TEXT("temperature"));
-        FN2CLogger::Get().Log(TEXT("Removed temperature from LM Studio payload - use LM Studio UI to configure"), EN2CLogSeverity::Debug);
-    }
-    
-    // LM Studio uses OpenAI-compatible format with stream=false
-    RootObject->SetBoolField(TEXT("stream"), false);
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bCompact = Settings && Settings->bUseCompactResponses;
+    const bool bNotes = !Settings || !Settings->bSkipImplementationNotes;
+    return GetN2CResponseSchema(bCompact, bNotes);
 }
 
-FString UN2CLLMPayloadBuilder::Build()
+TSharedPtr<FJsonObject> FN2CLLMPayloadBuilder::GetN2CResponseSchema(bool bCompact, bool bNotes)
 {
-    // Serialize JSON to string
-    FString Payload;
-    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Payload);
-    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
-    
-    // Log the payload for debugging
-    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Request Payload:\n\n%s"), *Payload), EN2CLogSeverity::Debug);
-    
-    return Payload;
+    // Parsed on first use; the same object also lets the serialized response format be reused
+    static const TSharedPtr<FJsonObject> Schemas[2][2] = {
+        { BuildN2CResponseSchema(false, false), BuildN2CResponseSchema(false, true) },
+        { BuildN2CResponseSchema(true, false), BuildN2CResponseSchema(true, true) }
+    };
+    return Schemas[bCompact ? 1 : 0][bNotes ? 1 : 0];
 }
 
-TSharedPtr<FJsonObject> UN2CLLMPayloadBuilder::GetN2CResponseSchema()
+TSharedPtr<FJsonObject> FN2CLLMPayloadBuilder::BuildN2CResponseSchema(bool bCompact, bool bNotes)
 {
     // Define the JSON schema for N2C translation responses
-    const FString JsonSchema = TEXT(R"(
-      {
-        "type": "object",
-        "properties": {
-          "graphs": {
-            "type": "array",
-            "items": {
-              "type": "object",
-              "properties": {
-                "graph_name": {
-                  "type": "string"
-                },
-                "graph_type": {
-                  "type": "string"
-                },
-                "graph_class": {
-                  "type": "string"
-                },
-                "code": {
+    const FString JsonSchema = bCompact
+        ? FString(TEXT(R"(
+          {
+            "type": "object",
+            "properties": {
+              "g": {
+                "type": "array",
+                "items": {
+                  "type": "object",
+                  "properties": {
+                    "n": { "type": "string" },
+                    "t": { "type": "string" },
+                    "c": { "type": "string" },
+                    "d": { "type": "string" },
+                    "i": { "type": "string" },
+                    "m": { "type": "string" }
+                  },
+                  "required": [ "n", "t", "c", "i" ]
+                }
+              }
+            },
+            "required": [ "g" ]
+          }
+        )"))
+        : FString(TEXT(R"(
+          {
+            "type": "object",
+            "properties": {
+              "graphs": {
+                "type": "array",
+                "items": {
                   "type": "object",
                   "properties": {
-                    "graphDeclaration": {
+                    "graph_name": {
                       "type": "string"
                     },
-                    "graphImplementation": {
+                    "graph_type": {
                       "type": "string"
                     },
-                    "implementationNotes": {
+                    "graph_class": {
                       "type": "string"
+                    },
+                    "code": {
+                      "type": "object",
+                      "properties": {
+                        "graphDeclaration": {
+                          "type": "string"
+                        },
+                        "graphImplementation": {
+                          "type": "string"
+                        },
+                        "implementationNotes": {
+                          "type": "string"
+                        }
+                      },
+                      "required": [
+                        "graphDeclaration",
+                        "graphImplementation"
+                      ]
                     }
                   },
                   "required": [
-                    "graphDeclaration",
-                    "graphImplementation"
+                    "graph_name",
+                    "graph_type",
+                    "graph_class",
+                    "code"
                   ]
                 }
-              },
-              "required": [
-                "graph_name",
-                "graph_type",
-                "graph_class",
-                "code"
-              ]
-            }
+              }
+            },
+            "required": [
+              "graphs"
+            ]
           }
-        },
-        "required": [
-          "graphs"
-        ]
-      }
-    )");
-    
+        )"));
+
     // Parse the schema string into a JSON object
     TSharedPtr<FJsonObject> SchemaObject;
     TSharedRef<TJsonReader<>> SchemaReader = TJsonReaderFactory<>::Create(JsonSchema);
@@ -503,6 +928,15 @@ TSharedPtr<FJsonObject> UN2CLLMPayloadBuilder::GetN2CResponseSchema()
         FN2CLogger::Get().LogError(TEXT("Failed to parse N2C JSON schema"), TEXT("LLMPayloadBuilder"));
         return MakeShared<FJsonObject>();
     }
-    
+
+    // Without the notes field the model cannot spend output tokens on it
+    if (!bNotes)
+    {
+        TSharedPtr<FJsonObject> Graph = SchemaObject->GetObjectField(TEXT("properties"))
+            ->GetObjectField(bCompact ? TEXT("g") : TEXT("graphs"))->GetObjectField(TEXT("items"));
+        TSharedPtr<FJsonObject> Fields = bCompact ? Graph : Graph->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("code"));
+        Fields->GetObjectField(TEXT("properties"))->RemoveField(bCompact ? TEXT("m") : TEXT("implementationNotes"));
+    }
+
     return SchemaObject;
 }
@@ -0,0 +1,516 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CLLMRequestScheduler.h"
+
+#include "Core/N2CSettings.h"
+#include "Editor.h"
+#include "Editor/EditorPerformanceSettings.h"
+#include "LLM/N2CHttpHandlerBase.h"
+#include "LLM/N2CLocalEndpointPool.h"
+#include "LLM/N2CRequestMetrics.h"
+#include "Utils/N2CLogger.h"
+#include "Utils/N2CTelemetry.h"
+
+namespace
+{
+    /** Headroom above which adaptive concurrency grows */
+    constexpr double GrowHeadroom = 0.25;
+
+    /** Headroom below which adaptive concurrency backs off, ahead of the provider returning 429 */
+    constexpr double ShrinkHeadroom = 0.1;
+
+    /** Longest wait between checks while background requests are held for a time window, so clock changes are seen */
+    constexpr double WindowCheckSeconds = 300.0;
+
+    const TCHAR* GetPriorityName(EN2CRequestPriority Priority)
+    {
+        switch (Priority)
+        {
+        case EN2CRequestPriority::Batch: return TEXT("batch");
+        case EN2CRequestPriority::Speculative: return TEXT("speculative");
+        default: return TEXT("interactive");
+        }
+    }
+}
+
+double FN2CRateLimitState::GetHeadroom() const
+{
+    double Headroom = 1.0;
+    if (RequestsLimit > 0 && RequestsRemaining >= 0)
+    {
+        Headroom = FMath::Min(Headroom, static_cast<double>(RequestsRemaining) / RequestsLimit);
+    }
+    if (TokensLimit > 0 && TokensRemaining >= 0)
+    {
+        Headroom = FMath::Min(Headroom, static_cast<double>(TokensRemaining) / TokensLimit);
+    }
+    return Headroom;
+}
+
+FN2CLatencyModel FN2CLatencyModel::FromSummary(const FN2CMetricsSummary& Summary)
+{
+    FN2CLatencyModel Model;
+    if (Summary.P50TimeToFirstByteSeconds > 0.0f)
+    {
+        Model.FirstByteSeconds = Summary.P50TimeToFirstByteSeconds;
+    }
+    if (Summary.OutputTokensPerSecond > 0.0f)
+    {
+        Model.OutputTokensPerSecond = Summary.OutputTokensPerSecond;
+    }
+    return Model;
+}
+
+double FN2CLatencyModel::EstimateSeconds(int32 InputTokens, float ComplexityScore) const
+{
+    return FirstByteSeconds + FMath::Max(InputTokens, 0) / InputTokensPerSecond
+        + FMath::Max(ComplexityScore, 0.0f) * OutputTokensPerComplexity / OutputTokensPerSecond;
+}
+
+FN2CLLMRequestScheduler& FN2CLLMRequestScheduler::Get()
+{
+    static FN2CLLMRequestScheduler Instance;
+    return Instance;
+}
+
+void FN2CLLMRequestScheduler::EnqueueRequest(
+    EN2CLLMProvider Provider,
+    FN2CScheduledRequest&& Request,
+    const TSharedPtr<FN2CCancellationToken>& Token,
+    double EstimatedSeconds,
+    EN2CRequestPriority Priority)
+{
+    check(IsInGameThread());
+
+    // Ahead of every lower priority request, then longest processing time first: ahead of every shorter
+    // request of the same priority, behind equal ones
+    FProviderState& State = ProviderStates.FindOrAdd(Provider);
+    int32 Position = State.Queue.IndexOfByPredicate([EstimatedSeconds, Priority](const FQueuedRequest& Queued)
+    {
+        return Queued.Priority > Priority
+            || (Queued.Priority == Priority && EstimatedSeconds > 0.0 && Queued.EstimatedSeconds < EstimatedSeconds);
+    });
+    Position = Position != INDEX_NONE ? Position : State.Queue.Num();
+    State.Queue.Insert({ MoveTemp(Request), Token, EstimatedSeconds, Priority }, Position);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Queued %s request for %s at %d (%d queued, %d in flight)"),
+            GetPriorityName(Priority), *UEnum::GetValueAsString(Provider), Position, State.Queue.Num(), State.ActiveRequests),
+        EN2CLogSeverity::Debug, TEXT("RequestScheduler"));
+    FN2CTelemetry::Get().SampleGauge(TEXT("QueueDepth"), State.Queue.Num());
+    FN2CTelemetry::Get().SampleGauge(TEXT("InFlight"), State.ActiveRequests);
+
+    TryDispatch(Provider);
+    UpdateBackgroundThrottling();
+}
+
+void FN2CLLMRequestScheduler::ScheduleRetry(EN2CLLMProvider Provider, float DelaySeconds, TFunction<void()>&& Resend)
+{
+    FProviderState& State = ProviderStates.FindOrAdd(Provider);
+    State.PausedUntil = FMath::Max(State.PausedUntil, FPlatformTime::Seconds() + DelaySeconds);
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Retrying request for %s in %.2fs"), *UEnum::GetValueAsString(Provider), DelaySeconds),
+        EN2CLogSeverity::Info, TEXT("RequestScheduler"));
+
+    FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([this, Provider, Resend = MoveTemp(Resend)](float DeltaTime)
+        {
+            Resend();
+            TryDispatch(Provider);
+            return false;
+        }),
+        DelaySeconds);
+}
+
+void FN2CLLMRequestScheduler::ReportRateLimits(EN2CLLMProvider Provider, const FN2CRateLimitState& RateLimits, bool bThrottled)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FN2CProviderRequestLimits Limits = Settings ? Settings->GetProviderRequestLimits(Provider) : FN2CProviderRequestLimits();
+
+    FProviderState& State = ProviderStates.FindOrAdd(Provider);
+    if (RateLimits.IsKnown())
+    {
+        State.RateLimits = RateLimits;
+    }
+    if (!Limits.bAdaptiveConcurrency || (!bThrottled && !RateLimits.IsKnown()))
+    {
+        return;
+    }
+
+    const int32 Previous = GetConcurrencyLimit(State, Limits);
+    const double Ceiling = FMath::Max(Limits.MaxConcurrentRequests, Limits.MaxAdaptiveConcurrentRequests);
+    const double Headroom = RateLimits.GetHeadroom();
+
+    if (bThrottled || Headroom < ShrinkHeadroom)
+    {
+        State.ConcurrencyLimit = FMath::Max(1.0, State.ConcurrencyLimit * 0.5);
+    }
+    else if (Headroom > GrowHeadroom)
+    {
+        // Each response adds 1/N, so a full round of N responses adds one slot
+        State.ConcurrencyLimit = FMath::Min(Ceiling, State.ConcurrencyLimit + 1.0 / State.ConcurrencyLimit);
+    }
+
+    const int32 Current = GetConcurrencyLimit(State, Limits);
+    if (Current != Previous)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Concurrency for %s %s to %d (headroom %.0f%%)"),
+                *UEnum::GetValueAsString(Provider), Current > Previous ? TEXT("raised") : TEXT("lowered"),
+                Current, Headroom * 100.0),
+            EN2CLogSeverity::Info, TEXT("RequestScheduler"));
+    }
+
+    if (Current > Previous)
+    {
+        TryDispatch(Provider);
+    }
+}
+
+FN2CRateLimitState FN2CLLMRequestScheduler::GetRateLimits(EN2CLLMProvider Provider) const
+{
+    const FProviderState* State = ProviderStates.Find(Provider);
+    return State ? State->RateLimits : FN2CRateLimitState();
+}
+
+int32 FN2CLLMRequestScheduler::GetConcurrencyLimit(EN2CLLMProvider Provider) const
+{
+    const int32 PoolCapacity = FN2CLocalEndpointPool::Get().GetCapacity(Provider);
+    if (PoolCapacity > 0)
+    {
+        return PoolCapacity;
+    }
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FN2CProviderRequestLimits Limits = Settings ? Settings->GetProviderRequestLimits(Provider) : FN2CProviderRequestLimits();
+
+    FProviderState State;
+    if (const FProviderState* Existing = ProviderStates.Find(Provider))
+    {
+        State.ConcurrencyLimit = Existing->ConcurrencyLimit;
+    }
+    return GetConcurrencyLimit(State, Limits);
+}
+
+double FN2CLLMRequestScheduler::GetSecondsUntilBackgroundWindow(EN2CLLMProvider Provider) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings ? GetSecondsUntilWindow(Settings->GetProviderRequestLimits(Provider)) : 0.0;
+}
+
+double FN2CLLMRequestScheduler::GetSecondsUntilWindow(const FN2CProviderRequestLimits& Limits)
+{
+    constexpr double MinutesPerDay = 24.0 * 60.0;
+    const double Start = FMath::Clamp(Limits.BackgroundWindowStartHour, 0.0f, 24.0f) * 60.0;
+    const double End = FMath::Clamp(Limits.BackgroundWindowEndHour, 0.0f, 24.0f) * 60.0;
+    if (!Limits.bUseBackgroundWindow || FMath::IsNearlyEqual(FMath::Fmod(Start, MinutesPerDay), FMath::Fmod(End, MinutesPerDay)))
+    {
+        return 0.0;
+    }
+
+    const FDateTime Now = Limits.bBackgroundWindowInUtc ? FDateTime::UtcNow() : FDateTime::Now();
+    const double Minute = Now.GetTimeOfDay().GetTotalMinutes();
+
+    // A window whose end is before its start spans midnight
+    const bool bOpen = Start < End ? (Minute >= Start && Minute < End) : (Minute >= Start || Minute < End);
+    if (bOpen)
+    {
+        return 0.0;
+    }
+    const double MinutesUntilOpen = Start > Minute ? Start - Minute : Start + MinutesPerDay - Minute;
+    return FMath::Max(1.0, MinutesUntilOpen * 60.0);
+}
+
+void FN2CLLMRequestScheduler::NotifyCapacityChanged(EN2CLLMProvider Provider)
+{
+    TryDispatch(Provider);
+}
+
+int32 FN2CLLMRequestScheduler::GetConcurrencyLimit(FProviderState& State, const FN2CProviderRequestLimits& Limits)
+{
+    const int32 Configured = FMath::Max(1, Limits.MaxConcurrentRequests);
+    if (!Limits.bAdaptiveConcurrency)
+    {
+        return Configured;
+    }
+
+    // Adaptive concurrency starts from the configured limit
+    if (State.ConcurrencyLimit < 1.0)
+    {
+        State.ConcurrencyLimit = Configured;
+    }
+    return FMath::Max(1, FMath::FloorToInt(State.ConcurrencyLimit));
+}
+
+void FN2CLLMRequestScheduler::ClearQueue(EN2CLLMProvider Provider)
+{
+    if (FProviderState* State = ProviderStates.Find(Provider))
+    {
+        State->Queue.Empty();
+        if (State->RetryHandle.IsValid())
+        {
+            FTSTicker::GetCoreTicker().RemoveTicker(State->RetryHandle);
+            State->RetryHandle.Reset();
+        }
+    }
+    UpdateBackgroundThrottling();
+}
+
+int32 FN2CLLMRequestScheduler::GetQueuedCount(EN2CLLMProvider Provider) const
+{
+    const FProviderState* State = ProviderStates.Find(Provider);
+    return State ? State->Queue.Num() : 0;
+}
+
+int32 FN2CLLMRequestScheduler::GetActiveCount(EN2CLLMProvider Provider) const
+{
+    const FProviderState* State = ProviderStates.Find(Provider);
+    return State ? State->ActiveRequests : 0;
+}
+
+bool FN2CLLMRequestScheduler::HasPendingRequests() const
+{
+    for (const TPair<EN2CLLMProvider, FProviderState>& Pair : ProviderStates)
+    {
+        if (Pair.Value.ActiveRequests > 0 || Pair.Value.Queue.Num() > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FN2CLLMRequestScheduler::RefillTokens(FProviderState& State, const FN2CProviderRequestLimits& Limits)
+{
+    const double Now = FPlatformTime::Seconds();
+    const double Capacity = FMath::Max(1, Limits.BurstSize);
+
+    // First use starts with a full bucket
+    if (State.Tokens < 0.0)
+    {
+        State.Tokens = Capacity;
+        State.LastRefillTime = Now;
+        return;
+    }
+
+    const double Elapsed = Now - State.LastRefillTime;
+    State.LastRefillTime = Now;
+    State.Tokens = FMath::Min(Capacity, State.Tokens + Elapsed * (Limits.RequestsPerMinute / 60.0));
+}
+
+void FN2CLLMRequestScheduler::TryDispatch(EN2CLLMProvider Provider)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FN2CProviderRequestLimits Limits = Settings ? Settings->GetProviderRequestLimits(Provider) : FN2CProviderRequestLimits();
+    const bool bRateLimited = Limits.RequestsPerMinute > 0.0f;
+
+    DrainCancelled(Provider);
+
+    while (true)
+    {
+        // Re-find each iteration: starting a request may add state for another provider
+        FProviderState* State = ProviderStates.Find(Provider);
+        const int32 PoolCapacity = FN2CLocalEndpointPool::Get().GetCapacity(Provider);
+        const int32 Limit = PoolCapacity > 0 ? PoolCapacity : (State ? GetConcurrencyLimit(*State, Limits) : 0);
+        if (!State || State->Queue.Num() == 0 || State->ActiveRequests >= Limit)
+        {
+            return;
+        }
+
+        // The queue is ordered by priority, so nothing interactive waits behind a background request at its head.
+        // Background work keeps clear of the reserved slots, though always gets one
+        const bool bBackground = State->Queue[0].Priority != EN2CRequestPriority::Interactive;
+        const int32 Reserved = FMath::Max(0, Limits.ReservedInteractiveRequests);
+        if (bBackground && State->ActiveBackgroundRequests >= FMath::Max(1, Limit - Reserved))
+        {
+            return;
+        }
+
+        // Outside the provider's time window only interactive requests go out. Interactive ones are never behind
+        // a background request, so the whole queue waits for the window
+        const double UntilWindow = bBackground ? GetSecondsUntilWindow(Limits) : 0.0;
+        if (UntilWindow > 0.0)
+        {
+            if (!State->bHeldForWindow)
+            {
+                State->bHeldForWindow = true;
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Holding %d background requests for %s until its time window opens in %.0f minutes"),
+                        State->Queue.Num(), *UEnum::GetValueAsString(Provider), UntilWindow / 60.0),
+                    EN2CLogSeverity::Info, TEXT("RequestScheduler"));
+            }
+            WakeUpIn(Provider, *State, static_cast<float>(FMath::Min(UntilWindow, WindowCheckSeconds)));
+            return;
+        }
+        if (bBackground && State->bHeldForWindow)
+        {
+            State->bHeldForWindow = false;
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("Time window for %s open, sending %d background requests"), *UEnum::GetValueAsString(Provider), State->Queue.Num()),
+                EN2CLogSeverity::Info, TEXT("RequestScheduler"));
+        }
+
+        // A retry is waiting out the provider's backoff; its resend resumes dispatch
+        if (FPlatformTime::Seconds() < State->PausedUntil)
+        {
+            return;
+        }
+
+        if (bRateLimited)
+        {
+            // Background work leaves a token for an interactive request, where the bucket holds more than one
+            const double Needed = bBackground && Reserved > 0 && Limits.BurstSize > 1 ? 2.0 : 1.0;
+            RefillTokens(*State, Limits);
+            if (State->Tokens < Needed)
+            {
+                // Wake up once the next token is available
+                if (!State->RetryHandle.IsValid())
+                {
+                    const float Delay = static_cast<float>((Needed - State->Tokens) * 60.0 / Limits.RequestsPerMinute);
+                    WakeUpIn(Provider, *State, Delay);
+
+                    FN2CLogger::Get().Log(
+                        FString::Printf(TEXT("Rate limit reached for %s, next request in %.2fs"),
+                            *UEnum::GetValueAsString(Provider), Delay),
+                        EN2CLogSeverity::Debug, TEXT("RequestScheduler"));
+                }
+                return;
+            }
+            State->Tokens -= 1.0;
+        }
+
+        FN2CScheduledRequest Request = MoveTemp(State->Queue[0].Request);
+        State->Queue.RemoveAt(0);
+        State->ActiveRequests++;
+        if (bBackground)
+        {
+            State->ActiveBackgroundRequests++;
+        }
+
+        // Guard against a request reporting completion more than once
+        TSharedRef<bool> bFinished = MakeShared<bool>(false);
+        const FSimpleDelegate OnFinished = FSimpleDelegate::CreateLambda([this, Provider, bFinished, bBackground]()
+        {
+            if (!*bFinished)
+            {
+                *bFinished = true;
+                OnRequestFinished(Provider, bBackground);
+            }
+        });
+
+        Request(OnFinished);
+    }
+}
+
+void FN2CLLMRequestScheduler::WakeUpIn(EN2CLLMProvider Provider, FProviderState& State, float DelaySeconds)
+{
+    if (State.RetryHandle.IsValid())
+    {
+        return;
+    }
+
+    State.RetryHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([this, Provider](float DeltaTime)
+        {
+            if (FProviderState* RetryState = ProviderStates.Find(Provider))
+            {
+                RetryState->RetryHandle.Reset();
+            }
+            TryDispatch(Provider);
+            return false;
+        }),
+        DelaySeconds);
+}
+
+void FN2CLLMRequestScheduler::DrainCancelledRequests()
+{
+    TArray<EN2CLLMProvider> Providers;
+    ProviderStates.GetKeys(Providers);
+    for (const EN2CLLMProvider Provider : Providers)
+    {
+        TryDispatch(Provider);
+    }
+    UpdateBackgroundThrottling();
+}
+
+void FN2CLLMRequestScheduler::DrainCancelled(EN2CLLMProvider Provider)
+{
+    FProviderState* State = ProviderStates.Find(Provider);
+    if (!State)
+    {
+        return;
+    }
+
+    TArray<FN2CScheduledRequest> Cancelled;
+    for (int32 Index = State->Queue.Num() - 1; Index >= 0; --Index)
+    {
+        const TSharedPtr<FN2CCancellationToken>& Token = State->Queue[Index].Token;
+        if (Token.IsValid() && Token->IsCancelled())
+        {
+            Cancelled.Insert(MoveTemp(State->Queue[Index].Request), 0);
+            State->Queue.RemoveAt(Index);
+        }
+    }
+
+    // They never held a slot, so there is nothing to release when they finish
+    for (FN2CScheduledRequest& Request : Cancelled)
+    {
+        Request(FSimpleDelegate());
+    }
+}
+
+void FN2CLLMRequestScheduler::OnRequestFinished(EN2CLLMProvider Provider, bool bBackground)
+{
+    if (FProviderState* State = ProviderStates.Find(Provider))
+    {
+        State->ActiveRequests = FMath::Max(0, State->ActiveRequests - 1);
+        if (bBackground)
+        {
+            State->ActiveBackgroundRequests = FMath::Max(0, State->ActiveBackgroundRequests - 1);
+        }
+    }
+
+    TryDispatch(Provider);
+    UpdateBackgroundThrottling();
+}
+
+void FN2CLLMRequestScheduler::UpdateBackgroundThrottling()
+{
+    if (!HasPendingRequests())
+    {
+        RestoreBackgroundThrottling();
+        return;
+    }
+    if (bThrottlingOverridden)
+    {
+        return;
+    }
+
+    // A throttled editor ticks HTTP so rarely in the background that responses stall until it is focused again.
+    // Changed in memory only, so the user's saved choice is never touched
+    UEditorPerformanceSettings* PerfSettings = GetMutableDefault<UEditorPerformanceSettings>();
+    if (GEditor && PerfSettings && PerfSettings->bThrottleCPUWhenNotForeground)
+    {
+        PerfSettings->bThrottleCPUWhenNotForeground = false;
+        bThrottlingOverridden = true;
+        FN2CLogger::Get().Log(TEXT("Background CPU throttling off while requests are pending"), EN2CLogSeverity::Debug, TEXT("RequestScheduler"));
+    }
+}
+
+void FN2CLLMRequestScheduler::RestoreBackgroundThrottling()
+{
+    if (!bThrottlingOverridden)
+    {
+        return;
+    }
+    bThrottlingOverridden = false;
+
+    // Left alone if the user changed it in the meantime
+    UEditorPerformanceSettings* PerfSettings = GetMutableDefault<UEditorPerformanceSettings>();
+    if (PerfSettings && !PerfSettings->bThrottleCPUWhenNotForeground)
+    {
+        PerfSettings->bThrottleCPUWhenNotForeground = true;
+        FN2CLogger::Get().Log(TEXT("Background CPU throttling restored"), EN2CLogSeverity::Debug, TEXT("RequestScheduler"));
+    }
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CLLMRouter.h"
+
+#include "Core/N2CSettings.h"
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Weight given to the newest latency in the moving average */
+    constexpr double LatencySmoothing = 0.3;
+
+    /** Latency assumed for providers that have not completed a request yet */
+    constexpr double UnknownLatencySeconds = 30.0;
+
+    /** Cost per 1M tokens at which a provider's weight is halved relative to a free one */
+    constexpr double CostScale = 10.0;
+
+    /** Cooldown after the first failure, doubled for each further consecutive failure */
+    constexpr double BaseCooldownSeconds = 15.0;
+    constexpr double MaxCooldownSeconds = 300.0;
+
+    /** Weight of the newest probe in the recent and long-term probe averages */
+    constexpr double ProbeSmoothing = 0.3;
+    constexpr double BaselineProbeSmoothing = 0.05;
+
+    /** Most that slow probes stretch a provider's expected latency */
+    constexpr double MaxProbeSlowdown = 10.0;
+
+    /** Output tokens of a typical translation, for estimating latency from probe throughput */
+    constexpr double TypicalOutputTokens = 1500.0;
+
+    /** Least weight a provider keeps however many probes fail, so it is still tried once it recovers */
+    constexpr double MinProbeReliability = 0.05;
+}
+
+FN2CLLMRouter& FN2CLLMRouter::Get()
+{
+    static FN2CLLMRouter Instance;
+    return Instance;
+}
+
+bool FN2CLLMRouter::SelectProvider(
+    const TArray<EN2CLLMProvider>& Candidates,
+    const TSet<EN2CLLMProvider>& Excluded,
+    EN2CLLMProvider& OutProvider,
+    bool bPreferFastest) const
+{
+    TArray<EN2CLLMProvider> Available;
+    TArray<EN2CLLMProvider> CoolingDown;
+    for (const EN2CLLMProvider Provider : Candidates)
+    {
+        if (!Excluded.Contains(Provider))
+        {
+            (IsCoolingDown(Provider) ? CoolingDown : Available).AddUnique(Provider);
+        }
+    }
+
+    if (Available.Num() == 0)
+    {
+        // Better to try a struggling provider than to fail the request outright
+        Available = MoveTemp(CoolingDown);
+    }
+    if (Available.Num() == 0)
+    {
+        return false;
+    }
+    if (Available.Num() == 1)
+    {
+        OutProvider = Available[0];
+        return true;
+    }
+
+    // Unmeasured providers are assumed to be as fast as the measured average so they get a fair trial
+    double LatencySum = 0.0;
+    int32 LatencyCount = 0;
+    for (const EN2CLLMProvider Provider : Available)
+    {
+        const FProviderStats* ProviderStats = Stats.Find(Provider);
+        if (ProviderStats && ProviderStats->AverageLatency > 0.0)
+        {
+            LatencySum += ProviderStats->AverageLatency;
+            ++LatencyCount;
+        }
+    }
+    const double DefaultLatency = LatencyCount > 0 ? LatencySum / LatencyCount : UnknownLatencySeconds;
+
+    if (bPreferFastest)
+    {
+        OutProvider = Available[0];
+        double BestWait = GetExpectedWait(OutProvider, DefaultLatency);
+        for (int32 Index = 1; Index < Available.Num(); ++Index)
+        {
+            const double Wait = GetExpectedWait(Available[Index], DefaultLatency);
+            if (Wait < BestWait)
+            {
+                OutProvider = Available[Index];
+                BestWait = Wait;
+            }
+        }
+        return true;
+    }
+
+    TArray<double> Weights;
+    double TotalWeight = 0.0;
+    for (const EN2CLLMProvider Provider : Available)
+    {
+        TotalWeight += Weights.Add_GetRef(GetWeight(Provider, DefaultLatency));
+    }
+
+    double Pick = FMath::FRand() * TotalWeight;
+    for (int32 Index = 0; Index < Available.Num(); ++Index)
+    {
+        Pick -= Weights[Index];
+        if (Pick <= 0.0)
+        {
+            OutProvider = Available[Index];
+            return true;
+        }
+    }
+
+    OutProvider = Available.Last();
+    return true;
+}
+
+void FN2CLLMRouter::ReportSuccess(EN2CLLMProvider Provider, double LatencySeconds)
+{
+    FProviderStats& ProviderStats = Stats.FindOrAdd(Provider);
+    ProviderStats.AverageLatency = ProviderStats.AverageLatency > 0.0
+        ? FMath::Lerp(ProviderStats.AverageLatency, LatencySeconds, LatencySmoothing)
+        : LatencySeconds;
+    ProviderStats.ConsecutiveFailures = 0;
+    ProviderStats.CooldownUntil = 0.0;
+}
+
+void FN2CLLMRouter::ReportFailure(EN2CLLMProvider Provider)
+{
+    FProviderStats& ProviderStats = Stats.FindOrAdd(Provider);
+    ProviderStats.ConsecutiveFailures++;
+
+    const double Cooldown = FMath::Min(MaxCooldownSeconds,
+        BaseCooldownSeconds * FMath::Pow(2.0, ProviderStats.ConsecutiveFailures - 1));
+    ProviderStats.CooldownUntil = FPlatformTime::Seconds() + Cooldown;
+
+    FN2CLogger::Get().LogWarning(
+        FString::Printf(TEXT("%s failed %d time(s) in a row, routing around it for %.0fs"),
+            *UEnum::GetValueAsString(Provider), ProviderStats.ConsecutiveFailures, Cooldown),
+        TEXT("LLMRouter"));
+}
+
+void FN2CLLMRouter::ReportProbe(EN2CLLMProvider Provider, const FN2CProviderProbe& Probe)
+{
+    FProviderStats& ProviderStats = Stats.FindOrAdd(Provider);
+    ProviderStats.ProbeErrorRate = FMath::Lerp(ProviderStats.ProbeErrorRate, Probe.bSucceeded ? 0.0 : 1.0, ProbeSmoothing);
+    if (!Probe.bSucceeded)
+    {
+        ReportFailure(Provider);
+        return;
+    }
+
+    auto Smooth = [](double Average, double Value, double Smoothing)
+    {
+        return Average > 0.0 ? FMath::Lerp(Average, Value, Smoothing) : Value;
+    };
+    ProviderStats.ProbeFirstByte = Smooth(ProviderStats.ProbeFirstByte, Probe.FirstByteSeconds, ProbeSmoothing);
+    ProviderStats.BaselineProbeFirstByte = Smooth(ProviderStats.BaselineProbeFirstByte, Probe.FirstByteSeconds, BaselineProbeSmoothing);
+    if (Probe.OutputTokensPerSecond > 0.0)
+    {
+        ProviderStats.ProbeTokensPerSecond = Smooth(ProviderStats.ProbeTokensPerSecond, Probe.OutputTokensPerSecond, ProbeSmoothing);
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Probe of %s: %.2fs to first byte, %.0f tokens/s, %.0f%% of recent probes failed"),
+            *UEnum::GetValueAsString(Provider), Probe.FirstByteSeconds, Probe.OutputTokensPerSecond, ProviderStats.ProbeErrorRate * 100.0),
+        EN2CLogSeverity::Debug, TEXT("LLMRouter"));
+}
+
+bool FN2CLLMRouter::IsCoolingDown(EN2CLLMProvider Provider) const
+{
+    const FProviderStats* ProviderStats = Stats.Find(Provider);
+    if (ProviderStats && FPlatformTime::Seconds() < ProviderStats->CooldownUntil)
+    {
+        return true;
+    }
+
+    // A provider that reported no requests or tokens left would only answer with 429s
+    const FN2CRateLimitState RateLimits = FN2CLLMRequestScheduler::Get().GetRateLimits(Provider);
+    return RateLimits.IsKnown() && RateLimits.GetHeadroom() <= 0.0;
+}
+
+double FN2CLLMRouter::GetExpectedWait(EN2CLLMProvider Provider, double DefaultLatency) const
+{
+    const FProviderStats* ProviderStats = Stats.Find(Provider);
+    double Latency = ProviderStats && ProviderStats->AverageLatency > 0.0 ? ProviderStats->AverageLatency : DefaultLatency;
+    if (ProviderStats && ProviderStats->AverageLatency <= 0.0 && ProviderStats->ProbeTokensPerSecond > 0.0)
+    {
+        Latency = ProviderStats->ProbeFirstByte + TypicalOutputTokens / ProviderStats->ProbeTokensPerSecond;
+    }
+
+    // A backend answering probes slower than it usually does is slower for translations too
+    if (ProviderStats && ProviderStats->ProbeFirstByte > 0.0 && ProviderStats->BaselineProbeFirstByte > 0.0)
+    {
+        Latency *= FMath::Clamp(ProviderStats->ProbeFirstByte / ProviderStats->BaselineProbeFirstByte, 1.0, MaxProbeSlowdown);
+    }
+
+    // Spread load: each queued or in-flight request counts as another request to wait behind
+    const FN2CLLMRequestScheduler& Scheduler = FN2CLLMRequestScheduler::Get();
+    const int32 Outstanding = Scheduler.GetQueuedCount(Provider) + Scheduler.GetActiveCount(Provider);
+
+    return FMath::Max(Latency, 0.1) * (1.0 + Outstanding);
+}
+
+double FN2CLLMRouter::GetWeight(EN2CLLMProvider Provider, double DefaultLatency) const
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const double Cost = Settings ? Settings->GetInputCost(Provider) + Settings->GetOutputCost(Provider) : 0.0;
+
+    const FProviderStats* ProviderStats = Stats.Find(Provider);
+    const double Reliability = ProviderStats ? FMath::Max(1.0 - ProviderStats->ProbeErrorRate, MinProbeReliability) : 1.0;
+
+    return Reliability / (GetExpectedWait(Provider, DefaultLatency) * (1.0 + Cost / CostScale));
+}
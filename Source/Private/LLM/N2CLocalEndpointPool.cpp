@@ -0,0 +1,228 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CLocalEndpointPool.h"
+
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "Utils/N2CLogger.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+namespace
+{
+    /** Seconds between probes of a server that is out of rotation */
+    constexpr float HealthCheckInterval = 15.0f;
+
+    /** Seconds a probe may take before the server counts as down */
+    constexpr float HealthCheckTimeout = 5.0f;
+}
+
+FN2CLocalEndpointPool& FN2CLocalEndpointPool::Get()
+{
+    static FN2CLocalEndpointPool Instance;
+    return Instance;
+}
+
+void FN2CLocalEndpointPool::SetEndpoints(EN2CLLMProvider Provider, const TArray<FN2CPooledEndpoint>& Endpoints)
+{
+    check(IsInGameThread());
+
+    if (Endpoints.Num() < 2)
+    {
+        // Requests still in flight release into nothing, which is harmless
+        Pools.Remove(Provider);
+        return;
+    }
+
+    TArray<FEndpointState> Previous = Pools.FindRef(Provider);
+    TArray<FEndpointState>& Pool = Pools.FindOrAdd(Provider);
+    Pool.Reset();
+
+    TArray<FString> NewEndpoints;
+    for (const FN2CPooledEndpoint& Endpoint : Endpoints)
+    {
+        if (Endpoint.RequestUrl.IsEmpty() || Pool.ContainsByPredicate([&Endpoint](const FEndpointState& State) { return State.Endpoint.RequestUrl == Endpoint.RequestUrl; }))
+        {
+            continue;
+        }
+
+        FEndpointState& State = Pool.AddDefaulted_GetRef();
+        if (const FEndpointState* Existing = Previous.FindByPredicate([&Endpoint](const FEndpointState& Old) { return Old.Endpoint.RequestUrl == Endpoint.RequestUrl; }))
+        {
+            State = *Existing;
+        }
+        else
+        {
+            NewEndpoints.Add(Endpoint.RequestUrl);
+        }
+        State.Endpoint = Endpoint;
+        State.Endpoint.MaxConcurrentRequests = FMath::Max(1, Endpoint.MaxConcurrentRequests);
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Balancing %s requests across %d endpoints (%d concurrent)"),
+            *UEnum::GetValueAsString(Provider), Pool.Num(), GetCapacity(Provider)),
+        EN2CLogSeverity::Info, TEXT("EndpointPool"));
+
+    for (const FString& RequestUrl : NewEndpoints)
+    {
+        ProbeEndpoint(Provider, RequestUrl);
+    }
+}
+
+bool FN2CLocalEndpointPool::AcquireEndpoint(EN2CLLMProvider Provider, FString& OutRequestUrl)
+{
+    TArray<FEndpointState>* Pool = Pools.Find(Provider);
+    if (!Pool || Pool->Num() == 0)
+    {
+        return false;
+    }
+
+    // Least outstanding relative to capacity, healthy servers first. When every server is down the
+    // request still goes somewhere so the failure surfaces instead of the queue stalling
+    FEndpointState* Best = nullptr;
+    double BestLoad = 0.0;
+    for (FEndpointState& State : *Pool)
+    {
+        const double Load = static_cast<double>(State.Outstanding) / State.Endpoint.MaxConcurrentRequests
+            + (State.bHealthy ? 0.0 : 1000.0);
+        if (!Best || Load < BestLoad)
+        {
+            Best = &State;
+            BestLoad = Load;
+        }
+    }
+
+    Best->Outstanding++;
+    OutRequestUrl = Best->Endpoint.RequestUrl;
+    return true;
+}
+
+void FN2CLocalEndpointPool::ReleaseEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl, bool bSucceeded)
+{
+    FEndpointState* State = FindEndpoint(Provider, RequestUrl);
+    if (!State)
+    {
+        return;
+    }
+
+    State->Outstanding = FMath::Max(0, State->Outstanding - 1);
+    if (bSucceeded || !State->bHealthy)
+    {
+        return;
+    }
+
+    State->bHealthy = false;
+    FN2CLogger::Get().LogWarning(
+        FString::Printf(TEXT("Endpoint %s failed, taking it out of rotation until it answers a health check"), *RequestUrl),
+        TEXT("EndpointPool"));
+    StartHealthChecks();
+}
+
+int32 FN2CLocalEndpointPool::GetCapacity(EN2CLLMProvider Provider) const
+{
+    const TArray<FEndpointState>* Pool = Pools.Find(Provider);
+    if (!Pool || Pool->Num() == 0)
+    {
+        return 0;
+    }
+
+    int32 Capacity = 0;
+    for (const FEndpointState& State : *Pool)
+    {
+        if (State.bHealthy)
+        {
+            Capacity += State.Endpoint.MaxConcurrentRequests;
+        }
+    }
+
+    // Keep one request moving while every server is down so errors reach the caller
+    return FMath::Max(1, Capacity);
+}
+
+void FN2CLocalEndpointPool::ProbeEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl)
+{
+    FEndpointState* State = FindEndpoint(Provider, RequestUrl);
+    if (!State || State->bProbing || State->Endpoint.HealthUrl.IsEmpty())
+    {
+        return;
+    }
+    State->bProbing = true;
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(State->Endpoint.HealthUrl);
+    Request->SetVerb(TEXT("GET"));
+    Request->SetTimeout(HealthCheckTimeout);
+    Request->OnProcessRequestComplete().BindLambda(
+        [this, Provider, RequestUrl](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            FEndpointState* Probed = FindEndpoint(Provider, RequestUrl);
+            if (!Probed)
+            {
+                return;
+            }
+            Probed->bProbing = false;
+
+            const bool bHealthy = bConnectedSuccessfully && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+            if (bHealthy == Probed->bHealthy)
+            {
+                return;
+            }
+
+            Probed->bHealthy = bHealthy;
+            if (bHealthy)
+            {
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Endpoint %s is back in rotation"), *RequestUrl),
+                    EN2CLogSeverity::Info, TEXT("EndpointPool"));
+
+                // Capacity grew, so queued requests may go out now
+                FN2CLLMRequestScheduler::Get().NotifyCapacityChanged(Provider);
+            }
+            else
+            {
+                FN2CLogger::Get().LogWarning(
+                    FString::Printf(TEXT("Endpoint %s did not answer its health check"), *RequestUrl),
+                    TEXT("EndpointPool"));
+                StartHealthChecks();
+            }
+        });
+    Request->ProcessRequest();
+}
+
+bool FN2CLocalEndpointPool::TickHealthChecks(float DeltaTime)
+{
+    bool bAnyUnhealthy = false;
+    for (const TPair<EN2CLLMProvider, TArray<FEndpointState>>& Pair : Pools)
+    {
+        for (const FEndpointState& State : Pair.Value)
+        {
+            if (!State.bHealthy)
+            {
+                bAnyUnhealthy = true;
+                ProbeEndpoint(Pair.Key, State.Endpoint.RequestUrl);
+            }
+        }
+    }
+
+    if (!bAnyUnhealthy)
+    {
+        HealthCheckHandle.Reset();
+    }
+    return bAnyUnhealthy;
+}
+
+void FN2CLocalEndpointPool::StartHealthChecks()
+{
+    if (!HealthCheckHandle.IsValid())
+    {
+        HealthCheckHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FN2CLocalEndpointPool::TickHealthChecks), HealthCheckInterval);
+    }
+}
+
+FN2CLocalEndpointPool::FEndpointState* FN2CLocalEndpointPool::FindEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl)
+{
+    TArray<FEndpointState>* Pool = Pools.Find(Provider);
+    return Pool ? Pool->FindByPredicate([&RequestUrl](const FEndpointState& State) { return State.Endpoint.RequestUrl == RequestUrl; }) : nullptr;
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CPromptFileCache.h"
+
+#include "Utils/N2CLogger.h"
+#include "DirectoryWatcherModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+
+FN2CPromptFileCache& FN2CPromptFileCache::Get()
+{
+    static FN2CPromptFileCache Instance;
+    return Instance;
+}
+
+bool FN2CPromptFileCache::LoadFile(const FString& FilePath, FString& OutContent)
+{
+    const TSharedPtr<const FString> Content = LoadShared(FilePath);
+    if (!Content.IsValid())
+    {
+        return false;
+    }
+
+    OutContent = *Content;
+    return true;
+}
+
+TSharedPtr<const FString> FN2CPromptFileCache::LoadShared(const FString& FilePath)
+{
+    const FString FullPath = FPaths::ConvertRelativePathToFull(FilePath);
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (const TSharedRef<const FString>* Cached = Files.Find(FullPath))
+        {
+            return *Cached;
+        }
+    }
+
+    FString Loaded;
+    if (!ReadFile(FullPath, Loaded))
+    {
+        return nullptr;
+    }
+    TSharedRef<const FString> Content = MakeShared<const FString>(MoveTemp(Loaded));
+
+    const FString Directory = FPaths::GetPath(FullPath);
+    if (IsInGameThread())
+    {
+        WatchDirectory(Directory);
+    }
+
+    // A file read off the game thread is only kept once its directory is watched, so it can't go stale
+    FScopeLock ScopeLock(&Lock);
+    if (IsInGameThread() || WatchedDirectories.Contains(Directory))
+    {
+        Files.Add(FullPath, Content);
+    }
+    return Content;
+}
+
+bool FN2CPromptFileCache::ReadFile(const FString& FilePath, FString& OutContent)
+{
+    TUniquePtr<IMappedFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (!Handle.IsValid())
+    {
+        return FFileHelper::LoadFileToString(OutContent, *FilePath);
+    }
+
+    const int64 FileSize = Handle->GetFileSize();
+    if (FileSize == 0)
+    {
+        OutContent.Reset();
+        return true;
+    }
+
+    TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, FileSize));
+    if (!Region.IsValid() || FileSize > MAX_int32)
+    {
+        return FFileHelper::LoadFileToString(OutContent, *FilePath);
+    }
+
+    const uint8* Bytes = Region->GetMappedPtr();
+    int32 NumBytes = static_cast<int32>(Region->GetMappedSize());
+    if (NumBytes >= 2 && ((Bytes[0] == 0xFF && Bytes[1] == 0xFE) || (Bytes[0] == 0xFE && Bytes[1] == 0xFF)))
+    {
+        Region.Reset();
+        Handle.Reset();
+        return FFileHelper::LoadFileToString(OutContent, *FilePath);
+    }
+    if (NumBytes >= 3 && Bytes[0] == 0xEF && Bytes[1] == 0xBB && Bytes[2] == 0xBF)
+    {
+        Bytes += 3;
+        NumBytes -= 3;
+    }
+
+    // Decoded in place into the string's own buffer, sized up front
+    const UTF8CHAR* Source = reinterpret_cast<const UTF8CHAR*>(Bytes);
+    const int32 NumChars = FPlatformString::ConvertedLength<TCHAR>(Source, NumBytes);
+    if (NumChars == 0)
+    {
+        OutContent.Reset();
+        return true;
+    }
+
+    TArray<TCHAR, FString::AllocatorType>& Chars = OutContent.GetCharArray();
+    Chars.SetNumUninitialized(NumChars + 1);
+    FPlatformString::Convert(Chars.GetData(), NumChars, Source, NumBytes);
+    Chars[NumChars] = TEXT('\0');
+    return true;
+}
+
+uint32 FN2CPromptFileCache::GetGeneration() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Generation;
+}
+
+void FN2CPromptFileCache::Invalidate()
+{
+    FScopeLock ScopeLock(&Lock);
+    Files.Reset();
+    ++Generation;
+}
+
+void FN2CPromptFileCache::Shutdown()
+{
+    TMap<FString, FDelegateHandle> Watched;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Watched = MoveTemp(WatchedDirectories);
+        WatchedDirectories.Reset();
+    }
+
+    if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+    {
+        if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+        {
+            for (const TPair<FString, FDelegateHandle>& Pair : Watched)
+            {
+                DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Pair.Key, Pair.Value);
+            }
+        }
+    }
+    Invalidate();
+}
+
+void FN2CPromptFileCache::WatchDirectory(const FString& Directory)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (WatchedDirectories.Contains(Directory))
+        {
+            return;
+        }
+    }
+
+    FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+    if (!DirectoryWatcher)
+    {
+        return;
+    }
+
+    FDelegateHandle Handle;
+    if (DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+        Directory,
+        IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FN2CPromptFileCache::OnDirectoryChanged),
+        Handle))
+    {
+        FScopeLock ScopeLock(&Lock);
+        WatchedDirectories.Add(Directory, Handle);
+    }
+    else
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Could not watch %s, changes to its files need an editor restart"), *Directory),
+            TEXT("PromptFileCache"));
+    }
+}
+
+void FN2CPromptFileCache::OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    bool bInvalidated = false;
+    for (const FFileChangeData& Change : FileChanges)
+    {
+        const FString FullPath = FPaths::ConvertRelativePathToFull(Change.Filename);
+        if (Files.Remove(FullPath) > 0)
+        {
+            bInvalidated = true;
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("Reloading changed prompt file: %s"), *FullPath),
+                EN2CLogSeverity::Debug, TEXT("PromptFileCache"));
+        }
+    }
+
+    if (bInvalidated)
+    {
+        ++Generation;
+    }
+}
@@ -0,0 +1,498 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CProviderBatchJob.h"
+
+#include "Utils/N2CLogger.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+    /** Seconds between batch status polls. Batches take minutes to hours, so polling is unhurried */
+    constexpr float PollInterval = 30.0f;
+
+    /** Status polls that may fail in a row before the job is given up */
+    constexpr int32 MaxPollFailures = 10;
+
+    /** Seconds a status poll may take */
+    constexpr float PollTimeout = 60.0f;
+
+    /** Seconds an upload or results download may take */
+    constexpr float TransferTimeout = 600.0f;
+
+    /** Prefix of the id each request is submitted under, followed by its index */
+    const TCHAR* CustomIdPrefix = TEXT("n2c-");
+
+    /** Chat endpoint suffixes stripped to find a provider's API base URL */
+    const TCHAR* AnthropicMessagesPath = TEXT("/messages");
+    const TCHAR* OpenAICompletionsPath = TEXT("/chat/completions");
+
+    FString ToCondensedString(const TSharedPtr<FJsonObject>& Object)
+    {
+        FString Out;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out);
+        FJsonSerializer::Serialize(Object.ToSharedRef(), Writer);
+        return Out;
+    }
+
+    TSharedPtr<FJsonObject> ParseObject(const FString& Content)
+    {
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+        return FJsonSerializer::Deserialize(Reader, Object) ? Object : nullptr;
+    }
+
+    bool IsOk(const FHttpResponsePtr& Response, bool bConnectedSuccessfully)
+    {
+        return bConnectedSuccessfully && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+    }
+
+    FString DescribeFailure(const FHttpResponsePtr& Response)
+    {
+        return Response.IsValid()
+            ? FString::Printf(TEXT("HTTP %d: %s"), Response->GetResponseCode(), *Response->GetContentAsString().Left(512))
+            : FString(TEXT("no response"));
+    }
+}
+
+bool FN2CProviderBatchJob::SupportsProvider(EN2CLLMProvider Provider)
+{
+    return Provider == EN2CLLMProvider::Anthropic || Provider == EN2CLLMProvider::OpenAI;
+}
+
+int32 FN2CProviderBatchJob::GetMaxRequests(EN2CLLMProvider Provider)
+{
+    return Provider == EN2CLLMProvider::Anthropic ? 100000 : 50000;
+}
+
+int64 FN2CProviderBatchJob::GetMaxPayloadSize(EN2CLLMProvider Provider)
+{
+    // Below the 256 MB (Anthropic) and 200 MB (OpenAI) limits, leaving room for the line wrappers
+    // and multi-byte characters
+    return Provider == EN2CLLMProvider::Anthropic ? 200ll * 1024 * 1024 : 150ll * 1024 * 1024;
+}
+
+FN2CProviderBatchJob::FN2CProviderBatchJob(EN2CLLMProvider InProvider, const FString& InEndpoint, const TMap<FString, FString>& InHeaders)
+    : Provider(InProvider)
+    , Endpoint(InEndpoint)
+    , Headers(InHeaders)
+{
+}
+
+FN2CProviderBatchJob::~FN2CProviderBatchJob()
+{
+    if (PollHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PollHandle);
+    }
+}
+
+void FN2CProviderBatchJob::Start(TArray<FString>&& RequestBodies, FOnJobEnded&& OnEnded)
+{
+    NumRequests = RequestBodies.Num();
+    OnJobEnded = MoveTemp(OnEnded);
+    Results.SetNum(NumRequests);
+
+    if (!SupportsProvider(Provider))
+    {
+        Fail(FString::Printf(TEXT("%s has no batch API"), *UEnum::GetValueAsString(Provider)));
+        return;
+    }
+
+    if (NumRequests == 0)
+    {
+        Finish();
+        return;
+    }
+
+    int64 TotalSize = 0;
+    for (const FString& Body : RequestBodies)
+    {
+        TotalSize += Body.Len() + 96;
+    }
+
+    // The bodies are already serialized, so the wrappers are written around them rather than
+    // parsing each body back into a JSON object
+    FString Content;
+    Content.Reserve(static_cast<int32>(FMath::Min<int64>(TotalSize + 32, MAX_int32)));
+
+    if (Provider == EN2CLLMProvider::Anthropic)
+    {
+        Content += TEXT("{\"requests\":[");
+        for (int32 Index = 0; Index < NumRequests; ++Index)
+        {
+            if (Index > 0)
+            {
+                Content += TEXT(",");
+            }
+            Content += FString::Printf(TEXT("{\"custom_id\":\"%s\",\"params\":"), *MakeCustomId(Index));
+            Content += RequestBodies[Index];
+            Content += TEXT("}");
+        }
+        Content += TEXT("]}");
+
+        RequestBodies.Empty();
+        CreateBatch(Content);
+        return;
+    }
+
+    // OpenAI batch lines name the endpoint path each request is sent to
+    const int32 VersionIndex = Endpoint.Find(TEXT("/v1/"));
+    const FString RequestPath = VersionIndex != INDEX_NONE ? Endpoint.RightChop(VersionIndex) : FString(TEXT("/v1/chat/completions"));
+
+    for (int32 Index = 0; Index < NumRequests; ++Index)
+    {
+        Content += FString::Printf(TEXT("{\"custom_id\":\"%s\",\"method\":\"POST\",\"url\":\"%s\",\"body\":"), *MakeCustomId(Index), *RequestPath);
+        Content += RequestBodies[Index];
+        Content += TEXT("}\n");
+    }
+
+    RequestBodies.Empty();
+    UploadInputFile(Content);
+}
+
+void FN2CProviderBatchJob::Cancel()
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bCancelled = true;
+
+    if (!BatchId.IsEmpty())
+    {
+        SendCancel();
+    }
+
+    Fail(TEXT("Batch job cancelled"));
+}
+
+void FN2CProviderBatchJob::SendCancel() const
+{
+    // Fire and forget, the job reports failure straight away rather than waiting for the provider
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), GetBatchUrl() + TEXT("/cancel"));
+    Request->SetTimeout(PollTimeout);
+    Request->ProcessRequest();
+}
+
+void FN2CProviderBatchJob::UploadInputFile(const FString& Jsonl)
+{
+    const FString Boundary = FString::Printf(TEXT("N2CBatch%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+
+    TArray<uint8> Body;
+    auto Append = [&Body](const FString& Text)
+    {
+        const FTCHARToUTF8 Utf8(*Text, Text.Len());
+        Body.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    };
+
+    Append(FString::Printf(TEXT("--%s\r\nContent-Disposition: form-data; name=\"purpose\"\r\n\r\nbatch\r\n"), *Boundary));
+    Append(FString::Printf(TEXT("--%s\r\nContent-Disposition: form-data; name=\"file\"; filename=\"n2c_batch.jsonl\"\r\n")
+        TEXT("Content-Type: application/jsonl\r\n\r\n"), *Boundary));
+    Append(Jsonl);
+    Append(FString::Printf(TEXT("\r\n--%s--\r\n"), *Boundary));
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), GetApiBaseUrl() + TEXT("/files"));
+    Request->SetHeader(TEXT("Content-Type"), FString::Printf(TEXT("multipart/form-data; boundary=%s"), *Boundary));
+    Request->SetContent(MoveTemp(Body));
+    Request->SetTimeout(TransferTimeout);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Job = AsShared()](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            if (Job->bFinished)
+            {
+                return;
+            }
+            if (!IsOk(Response, bConnectedSuccessfully))
+            {
+                Job->Fail(FString::Printf(TEXT("Batch input upload failed (%s)"), *DescribeFailure(Response)));
+                return;
+            }
+
+            const TSharedPtr<FJsonObject> File = ParseObject(Response->GetContentAsString());
+            FString FileId;
+            if (!File.IsValid() || !File->TryGetStringField(TEXT("id"), FileId))
+            {
+                Job->Fail(TEXT("Batch input upload returned no file id"));
+                return;
+            }
+
+            TSharedPtr<FJsonObject> BatchObject = MakeShared<FJsonObject>();
+            BatchObject->SetStringField(TEXT("input_file_id"), FileId);
+            BatchObject->SetStringField(TEXT("endpoint"), TEXT("/v1/chat/completions"));
+            BatchObject->SetStringField(TEXT("completion_window"), TEXT("24h"));
+            Job->CreateBatch(ToCondensedString(BatchObject));
+        });
+    Request->ProcessRequest();
+}
+
+void FN2CProviderBatchJob::CreateBatch(const FString& Body)
+{
+    const FString Url = Provider == EN2CLLMProvider::Anthropic
+        ? GetApiBaseUrl() + TEXT("/messages/batches")
+        : GetApiBaseUrl() + TEXT("/batches");
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("POST"), Url);
+    Request->SetContentAsString(Body);
+    Request->SetTimeout(TransferTimeout);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Job = AsShared()](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            const TSharedPtr<FJsonObject> Batch = IsOk(Response, bConnectedSuccessfully) ? ParseObject(Response->GetContentAsString()) : nullptr;
+            const bool bCreated = Batch.IsValid() && Batch->TryGetStringField(TEXT("id"), Job->BatchId);
+
+            if (Job->bFinished)
+            {
+                // Cancelled while the batch was being created, so stop it before it is billed
+                if (bCreated)
+                {
+                    Job->SendCancel();
+                }
+                return;
+            }
+            if (!bCreated)
+            {
+                Job->Fail(FString::Printf(TEXT("Batch creation failed (%s)"), *DescribeFailure(Response)));
+                return;
+            }
+
+            FN2CLogger::Get().Log(
+                FString::Printf(TEXT("Submitted %s batch %s with %d requests"), *UEnum::GetValueAsString(Job->Provider), *Job->BatchId, Job->NumRequests),
+                EN2CLogSeverity::Info, TEXT("BatchJob"));
+
+            Job->PollHandle = FTSTicker::GetCoreTicker().AddTicker(
+                FTickerDelegate::CreateSP(Job, &FN2CProviderBatchJob::TickPoll), PollInterval);
+        });
+    Request->ProcessRequest();
+}
+
+bool FN2CProviderBatchJob::TickPoll(float DeltaTime)
+{
+    PollHandle.Reset();
+    PollStatus();
+    return false;
+}
+
+void FN2CProviderBatchJob::PollStatus()
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), GetBatchUrl());
+    Request->SetTimeout(PollTimeout);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Job = AsShared()](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            if (Job->bFinished)
+            {
+                return;
+            }
+
+            const TSharedPtr<FJsonObject> Batch = IsOk(Response, bConnectedSuccessfully) ? ParseObject(Response->GetContentAsString()) : nullptr;
+            if (!Batch.IsValid())
+            {
+                // Polls span hours, so a dropped connection is retried at the next interval
+                if (++Job->PollFailures >= MaxPollFailures)
+                {
+                    Job->Fail(FString::Printf(TEXT("Batch status polls keep failing (%s)"), *DescribeFailure(Response)));
+                    return;
+                }
+                Job->PollHandle = FTSTicker::GetCoreTicker().AddTicker(
+                    FTickerDelegate::CreateSP(Job, &FN2CProviderBatchJob::TickPoll), PollInterval);
+                return;
+            }
+            Job->PollFailures = 0;
+
+            FString ResultsUrl;
+            bool bEnded = false;
+            if (Job->Provider == EN2CLLMProvider::Anthropic)
+            {
+                bEnded = Batch->GetStringField(TEXT("processing_status")) == TEXT("ended");
+                Batch->TryGetStringField(TEXT("results_url"), ResultsUrl);
+            }
+            else
+            {
+                const FString Status = Batch->GetStringField(TEXT("status"));
+                if (Status == TEXT("failed"))
+                {
+                    Job->Fail(FString::Printf(TEXT("Batch %s failed: %s"), *Job->BatchId, *Response->GetContentAsString().Left(512)));
+                    return;
+                }
+
+                // Expired and cancelled batches still return the requests they finished
+                bEnded = Status == TEXT("completed") || Status == TEXT("expired") || Status == TEXT("cancelled");
+                FString OutputFileId;
+                if (Batch->TryGetStringField(TEXT("output_file_id"), OutputFileId) && !OutputFileId.IsEmpty())
+                {
+                    ResultsUrl = FString::Printf(TEXT("%s/files/%s/content"), *Job->GetApiBaseUrl(), *OutputFileId);
+                }
+            }
+
+            if (!bEnded)
+            {
+                Job->PollHandle = FTSTicker::GetCoreTicker().AddTicker(
+                    FTickerDelegate::CreateSP(Job, &FN2CProviderBatchJob::TickPoll), PollInterval);
+                return;
+            }
+
+            if (ResultsUrl.IsEmpty())
+            {
+                Job->Fail(FString::Printf(TEXT("Batch %s ended without results"), *Job->BatchId));
+                return;
+            }
+            Job->DownloadResults(ResultsUrl);
+        });
+    Request->ProcessRequest();
+}
+
+void FN2CProviderBatchJob::DownloadResults(const FString& Url)
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateRequest(TEXT("GET"), Url);
+    Request->SetTimeout(TransferTimeout);
+    Request->OnProcessRequestComplete().BindLambda(
+        [Job = AsShared()](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+        {
+            if (Job->bFinished)
+            {
+                return;
+            }
+            if (!IsOk(Response, bConnectedSuccessfully))
+            {
+                Job->Fail(FString::Printf(TEXT("Batch results download failed (%s)"), *DescribeFailure(Response)));
+                return;
+            }
+            Job->ParseResults(Response->GetContentAsString());
+        });
+    Request->ProcessRequest();
+}
+
+void FN2CProviderBatchJob::ParseResults(const FString& Jsonl)
+{
+    TArray<FString> Lines;
+    Jsonl.ParseIntoArrayLines(Lines);
+
+    int32 Succeeded = 0;
+    for (const FString& Line : Lines)
+    {
+        const TSharedPtr<FJsonObject> Result = ParseObject(Line);
+        FString CustomId;
+        if (!Result.IsValid() || !Result->TryGetStringField(TEXT("custom_id"), CustomId) || !CustomId.StartsWith(CustomIdPrefix))
+        {
+            continue;
+        }
+
+        const int32 Index = FCString::Atoi(*CustomId.RightChop(FCString::Strlen(CustomIdPrefix)));
+        if (!Results.IsValidIndex(Index))
+        {
+            continue;
+        }
+
+        // Each result is reduced to the response body a single request would have returned, so the
+        // provider's response parser reads it unchanged
+        const TSharedPtr<FJsonObject>* Body = nullptr;
+        if (Provider == EN2CLLMProvider::Anthropic)
+        {
+            const TSharedPtr<FJsonObject>* Outcome = nullptr;
+            if (Result->TryGetObjectField(TEXT("result"), Outcome)
+                && (*Outcome)->GetStringField(TEXT("type")) == TEXT("succeeded"))
+            {
+                (*Outcome)->TryGetObjectField(TEXT("message"), Body);
+            }
+        }
+        else
+        {
+            const TSharedPtr<FJsonObject>* HttpResponse = nullptr;
+            if (Result->TryGetObjectField(TEXT("response"), HttpResponse)
+                && EHttpResponseCodes::IsOk(static_cast<int32>((*HttpResponse)->GetNumberField(TEXT("status_code")))))
+            {
+                (*HttpResponse)->TryGetObjectField(TEXT("body"), Body);
+            }
+        }
+
+        if (!Body)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Batch request %s failed: %s"), *CustomId, *Line.Left(512)), TEXT("BatchJob"));
+            continue;
+        }
+
+        Results[Index] = ToCondensedString(*Body);
+        ++Succeeded;
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Batch %s ended: %d of %d requests succeeded"), *BatchId, Succeeded, NumRequests),
+        EN2CLogSeverity::Info, TEXT("BatchJob"));
+    Finish();
+}
+
+void FN2CProviderBatchJob::Finish()
+{
+    if (bFinished)
+    {
+        return;
+    }
+    bFinished = true;
+
+    if (PollHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PollHandle);
+        PollHandle.Reset();
+    }
+
+    // The callback may release the last reference to the job
+    FOnJobEnded Callback = MoveTemp(OnJobEnded);
+    TArray<FString> Bodies = MoveTemp(Results);
+    if (Callback)
+    {
+        Callback(Bodies);
+    }
+}
+
+void FN2CProviderBatchJob::Fail(const FString& Reason)
+{
+    if (bCancelled)
+    {
+        FN2CLogger::Get().LogWarning(Reason, TEXT("BatchJob"));
+    }
+    else
+    {
+        FN2CLogger::Get().LogError(Reason, TEXT("BatchJob"));
+    }
+    Finish();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FN2CProviderBatchJob::CreateRequest(const FString& Verb, const FString& Url) const
+{
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+    Request->SetURL(Url);
+    Request->SetVerb(Verb);
+    for (const TPair<FString, FString>& Header : Headers)
+    {
+        Request->SetHeader(Header.Key, Header.Value);
+    }
+    return Request;
+}
+
+FString FN2CProviderBatchJob::GetApiBaseUrl() const
+{
+    const TCHAR* ChatPath = Provider == EN2CLLMProvider::Anthropic ? AnthropicMessagesPath : OpenAICompletionsPath;
+    if (Endpoint.EndsWith(ChatPath))
+    {
+        return Endpoint.LeftChop(FCString::Strlen(ChatPath));
+    }
+    return Provider == EN2CLLMProvider::Anthropic ? TEXT("https://api.anthropic.com/v1") : TEXT("https://api.openai.com/v1");
+}
+
+FString FN2CProviderBatchJob::GetBatchUrl() const
+{
+    return Provider == EN2CLLMProvider::Anthropic
+        ? FString::Printf(TEXT("%s/messages/batches/%s"), *GetApiBaseUrl(), *BatchId)
+        : FString::Printf(TEXT("%s/batches/%s"), *GetApiBaseUrl(), *BatchId);
+}
+
+FString FN2CProviderBatchJob::MakeCustomId(int32 Index)
+{
+    return FString::Printf(TEXT("%s%d"), CustomIdPrefix, Index);
+}
@@ -0,0 +1,563 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CReferenceIndex.h"
+
+#include "LLM/N2CPromptFileCache.h"
+#include "LLM/N2CTokenEstimator.h"
+#include "Utils/N2CLogger.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** Bumped whenever chunking, terms or the saved layout change, so older saved indexes are rebuilt */
+    constexpr int32 IndexVersion = 1;
+
+    /** Declarations longer than this are split between their members */
+    constexpr int32 MaxChunkLines = 80;
+
+    /** Declarations shorter than this (forward declarations, using lines) are kept with the next one */
+    constexpr int32 MinChunkLines = 3;
+
+    /** BM25 term frequency saturation and length normalization */
+    constexpr double K1 = 1.2;
+    constexpr double B = 0.75;
+
+    bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Add the terms of an identifier: itself, without its Unreal type prefix, and its camel-case words */
+    void AddIdentifierTerms(const FString& Identifier, TFunctionRef<void(const FString&)> AddTerm)
+    {
+        if (Identifier.Len() < 2 || FChar::IsDigit(Identifier[0]))
+        {
+            return;
+        }
+
+        AddTerm(Identifier.ToLower());
+        if (Identifier.Len() > 2 && FCString::Strchr(TEXT("AUFEIST"), Identifier[0]) && FChar::IsUpper(Identifier[1]))
+        {
+            AddTerm(Identifier.RightChop(1).ToLower());
+        }
+
+        TArray<FString, TInlineAllocator<8>> Words;
+        int32 Start = 0;
+        for (int32 Index = 1; Index <= Identifier.Len(); ++Index)
+        {
+            const bool bEnd = Index == Identifier.Len();
+            const bool bBreak = bEnd || Identifier[Index] == TEXT('_')
+                || (FChar::IsUpper(Identifier[Index]) && FChar::IsLower(Identifier[Index - 1]))
+                || (FChar::IsUpper(Identifier[Index]) && Index + 1 < Identifier.Len() && FChar::IsLower(Identifier[Index + 1]) && FChar::IsUpper(Identifier[Index - 1]));
+            if (bBreak)
+            {
+                const FString Word = Identifier.Mid(Start, Index - Start);
+                if (Word.Len() >= 3)
+                {
+                    Words.Add(Word.ToLower());
+                }
+                Start = !bEnd && Identifier[Index] == TEXT('_') ? Index + 1 : Index;
+            }
+        }
+
+        if (Words.Num() > 1)
+        {
+            for (const FString& Word : Words)
+            {
+                AddTerm(Word);
+            }
+        }
+    }
+
+    /** Call Visit for every identifier in Text */
+    void ForEachIdentifier(const FString& Text, TFunctionRef<void(const FString&)> Visit)
+    {
+        int32 Index = 0;
+        while (Index < Text.Len())
+        {
+            if (!IsIdentifierChar(Text[Index]))
+            {
+                ++Index;
+                continue;
+            }
+
+            const int32 Start = Index;
+            while (Index < Text.Len() && IsIdentifierChar(Text[Index]))
+            {
+                ++Index;
+            }
+            Visit(Text.Mid(Start, Index - Start));
+        }
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FN2CReferenceIndex::FChunk& Chunk)
+{
+    return Ar << Chunk.StartLine << Chunk.EndLine << Chunk.Text << Chunk.Terms << Chunk.Counts << Chunk.Length;
+}
+
+FArchive& operator<<(FArchive& Ar, FN2CReferenceIndex::FIndexedFile& File)
+{
+    return Ar << File.Path << File.Size << File.TimeStamp << File.Chunks;
+}
+
+FN2CReferenceIndex& FN2CReferenceIndex::Get()
+{
+    static FN2CReferenceIndex Instance;
+    return Instance;
+}
+
+bool FN2CReferenceIndex::Retrieve(
+    const TArray<FString>& FilePaths,
+    uint32 Generation,
+    const TSet<FString>& Symbols,
+    int32 MaxChunks,
+    int32 TokenBudget,
+    EN2CLLMProvider Provider,
+    FString& OutBlock)
+{
+    OutBlock.Reset();
+
+    TSharedPtr<const FIndexState> Current;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (State.IsValid() && State->Generation == Generation && State->FilePaths == FilePaths)
+        {
+            Current = State;
+        }
+    }
+
+    if (!Current.IsValid())
+    {
+        Update(FilePaths, Generation);
+        return false;
+    }
+
+    TSet<FString> QueryTerms;
+    for (const FString& Symbol : Symbols)
+    {
+        AddIdentifierTerms(Symbol, [&QueryTerms](const FString& Term) { QueryTerms.Add(Term); });
+    }
+
+    // BM25 over every chunk containing a query term
+    const int32 NumChunks = Current->Chunks.Num();
+    TArray<double> Scores;
+    Scores.SetNumZeroed(NumChunks);
+    for (const FString& Term : QueryTerms)
+    {
+        const TArray<FPosting>* Postings = Current->Postings.Find(Term);
+        if (!Postings)
+        {
+            continue;
+        }
+
+        const double DocumentFrequency = Postings->Num();
+        const double Idf = FMath::Loge(1.0 + (NumChunks - DocumentFrequency + 0.5) / (DocumentFrequency + 0.5));
+        for (const FPosting& Posting : *Postings)
+        {
+            const TPair<int32, int32>& Ref = Current->Chunks[Posting.Chunk];
+            const double Length = Current->Files[Ref.Key].Chunks[Ref.Value].Length;
+            const double Frequency = Posting.Count;
+            Scores[Posting.Chunk] += Idf * (Frequency * (K1 + 1.0)) / (Frequency + K1 * (1.0 - B + B * Length / Current->AverageLength));
+        }
+    }
+
+    TArray<int32> Ranked;
+    for (int32 Index = 0; Index < NumChunks; ++Index)
+    {
+        if (Scores[Index] > 0.0)
+        {
+            Ranked.Add(Index);
+        }
+    }
+    Ranked.Sort([&Scores](int32 Left, int32 Right) { return Scores[Left] > Scores[Right]; });
+
+    // Best first while they fit; a chunk too large for what is left makes way for smaller ones after it
+    TArray<int32> Selected;
+    int32 UsedTokens = 0;
+    for (const int32 Index : Ranked)
+    {
+        if (Selected.Num() >= MaxChunks)
+        {
+            break;
+        }
+
+        const TPair<int32, int32>& Ref = Current->Chunks[Index];
+        const int32 Tokens = FN2CTokenEstimator::EstimateTokens(Current->Files[Ref.Key].Chunks[Ref.Value].Text, Provider);
+        if (UsedTokens + Tokens <= TokenBudget)
+        {
+            Selected.Add(Index);
+            UsedTokens += Tokens;
+        }
+    }
+
+    // Chunk indices run in file and line order
+    Selected.Sort();
+    for (const int32 Index : Selected)
+    {
+        const TPair<int32, int32>& Ref = Current->Chunks[Index];
+        const FIndexedFile& File = Current->Files[Ref.Key];
+        const FChunk& Chunk = File.Chunks[Ref.Value];
+        if (!OutBlock.IsEmpty())
+        {
+            OutBlock += TEXT("\n\n");
+        }
+        OutBlock += FString::Printf(TEXT("File: %s (lines %d-%d)\n```\n%s\n```"),
+            *FPaths::GetCleanFilename(File.Path), Chunk.StartLine, Chunk.EndLine, *Chunk.Text);
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Retrieved %d of %d reference chunks (%d matching, ~%d tokens)"), Selected.Num(), NumChunks, Ranked.Num(), UsedTokens),
+        EN2CLogSeverity::Debug, TEXT("ReferenceIndex"));
+
+    return true;
+}
+
+void FN2CReferenceIndex::Update(const TArray<FString>& FilePaths, uint32 Generation)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (BuildTask.IsValid() && !BuildTask.IsCompleted())
+    {
+        return;
+    }
+
+    TArray<FIndexedFile> Previous;
+    if (State.IsValid())
+    {
+        Previous = State->Files;
+    }
+    else if (!bLoadedSaved)
+    {
+        bLoadedSaved = true;
+        LoadSavedFiles(Previous);
+    }
+
+    BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, FilePaths, Generation, Previous = MoveTemp(Previous)]()
+    {
+        bool bChanged = false;
+        TSharedRef<const FIndexState> Built = Build(FilePaths, Generation, Previous, bChanged);
+        if (bChanged)
+        {
+            SaveFiles(Built->Files);
+        }
+
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Indexed %d reference chunks from %d files"), Built->Chunks.Num(), Built->Files.Num()),
+            EN2CLogSeverity::Info, TEXT("ReferenceIndex"));
+
+        FScopeLock BuiltLock(&Lock);
+        State = Built;
+    });
+}
+
+void FN2CReferenceIndex::Shutdown()
+{
+    UE::Tasks::FTask Pending;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Pending = BuildTask;
+    }
+
+    if (Pending.IsValid())
+    {
+        Pending.Wait();
+    }
+}
+
+TSharedRef<const FN2CReferenceIndex::FIndexState> FN2CReferenceIndex::Build(
+    const TArray<FString>& FilePaths,
+    uint32 Generation,
+    const TArray<FIndexedFile>& Previous,
+    bool& bOutChanged)
+{
+    TSharedRef<FIndexState> Built = MakeShared<FIndexState>();
+    Built->FilePaths = FilePaths;
+    Built->Generation = Generation;
+    bOutChanged = Previous.Num() != FilePaths.Num();
+
+    for (const FString& Path : FilePaths)
+    {
+        const FFileStatData Stat = IFileManager::Get().GetStatData(*Path);
+        if (!Stat.bIsValid)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to index reference source file: %s"), *Path), TEXT("ReferenceIndex"));
+            bOutChanged = true;
+            continue;
+        }
+
+        const FIndexedFile* Unchanged = Previous.FindByPredicate([&Path, &Stat](const FIndexedFile& File)
+        {
+            return File.Path == Path && File.Size == Stat.FileSize && File.TimeStamp == Stat.ModificationTime;
+        });
+        if (Unchanged)
+        {
+            Built->Files.Add(*Unchanged);
+            continue;
+        }
+
+        FString Content;
+        if (!FN2CPromptFileCache::ReadFile(Path, Content))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to index reference source file: %s"), *Path), TEXT("ReferenceIndex"));
+            bOutChanged = true;
+            continue;
+        }
+
+        FIndexedFile& File = Built->Files.AddDefaulted_GetRef();
+        File.Path = Path;
+        File.Size = Stat.FileSize;
+        File.TimeStamp = Stat.ModificationTime;
+        ChunkFile(Content, File.Chunks);
+        bOutChanged = true;
+    }
+
+    int64 TotalLength = 0;
+    for (int32 FileIndex = 0; FileIndex < Built->Files.Num(); ++FileIndex)
+    {
+        const TArray<FChunk>& Chunks = Built->Files[FileIndex].Chunks;
+        for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+        {
+            const FChunk& Chunk = Chunks[ChunkIndex];
+            const int32 Global = Built->Chunks.Add(TPair<int32, int32>(FileIndex, ChunkIndex));
+            for (int32 TermIndex = 0; TermIndex < Chunk.Terms.Num(); ++TermIndex)
+            {
+                Built->Postings.FindOrAdd(Chunk.Terms[TermIndex]).Add({ Global, Chunk.Counts[TermIndex] });
+            }
+            TotalLength += Chunk.Length;
+        }
+    }
+    Built->AverageLength = Built->Chunks.Num() > 0 ? FMath::Max(1.0, double(TotalLength) / Built->Chunks.Num()) : 1.0;
+
+    return Built;
+}
+
+void FN2CReferenceIndex::ChunkFile(const FString& Content, TArray<FChunk>& OutChunks)
+{
+    TArray<FString> Lines;
+    Content.ParseIntoArray(Lines, TEXT("\n"), false);
+    for (FString& Line : Lines)
+    {
+        Line.RemoveFromEnd(TEXT("\r"));
+    }
+
+    auto EmitChunk = [&Lines, &OutChunks](int32 First, int32 Last, const FString& Continues)
+    {
+        FChunk Chunk;
+        Chunk.StartLine = First + 1;
+        Chunk.EndLine = Last + 1;
+        if (!Continues.IsEmpty())
+        {
+            Chunk.Text = FString::Printf(TEXT("// %s (continued)\n"), *Continues);
+        }
+        for (int32 Index = First; Index <= Last; ++Index)
+        {
+            Chunk.Text += Lines[Index];
+            if (Index < Last)
+            {
+                Chunk.Text += TEXT('\n');
+            }
+        }
+
+        TMap<FString, int32> Counts;
+        ForEachIdentifier(Chunk.Text, [&Counts](const FString& Identifier)
+        {
+            AddIdentifierTerms(Identifier, [&Counts](const FString& Term) { ++Counts.FindOrAdd(Term); });
+        });
+        if (Counts.Num() == 0)
+        {
+            return;
+        }
+
+        for (const TPair<FString, int32>& Term : Counts)
+        {
+            Chunk.Terms.Add(Term.Key);
+            Chunk.Counts.Add(Term.Value);
+            Chunk.Length += Term.Value;
+        }
+        OutChunks.Add(MoveTemp(Chunk));
+    };
+
+    // Brace depth outside namespaces, comments and literals. Declarations end where it returns to zero,
+    // and members where it returns to one
+    TArray<bool, TInlineAllocator<8>> NamespaceBraces;
+    int32 Depth = 0;
+    bool bInBlockComment = false;
+    bool bNamespacePending = false;
+    int32 ChunkStart = 0;
+    FString Declaration;
+    TArray<int32> MemberEnds;
+
+    for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        const FString& Line = Lines[LineIndex];
+        bool bDeclarationEnd = false;
+
+        for (int32 Index = 0; Index < Line.Len(); ++Index)
+        {
+            const TCHAR Char = Line[Index];
+            const TCHAR Next = Index + 1 < Line.Len() ? Line[Index + 1] : TEXT('\0');
+
+            if (bInBlockComment)
+            {
+                if (Char == TEXT('*') && Next == TEXT('/'))
+                {
+                    bInBlockComment = false;
+                    ++Index;
+                }
+                continue;
+            }
+
+            if (Char == TEXT('/') && Next == TEXT('/'))
+            {
+                break;
+            }
+            if (Char == TEXT('/') && Next == TEXT('*'))
+            {
+                bInBlockComment = true;
+                ++Index;
+                continue;
+            }
+            if (Char == TEXT('"') || Char == TEXT('\''))
+            {
+                for (++Index; Index < Line.Len() && Line[Index] != Char; ++Index)
+                {
+                    if (Line[Index] == TEXT('\\'))
+                    {
+                        ++Index;
+                    }
+                }
+                continue;
+            }
+
+            if (IsIdentifierChar(Char))
+            {
+                const int32 Start = Index;
+                while (Index + 1 < Line.Len() && IsIdentifierChar(Line[Index + 1]))
+                {
+                    ++Index;
+                }
+                if (Line.Mid(Start, Index - Start + 1) == TEXT("namespace"))
+                {
+                    bNamespacePending = true;
+                }
+            }
+            else if (Char == TEXT('{'))
+            {
+                NamespaceBraces.Add(bNamespacePending);
+                if (!bNamespacePending && ++Depth == 1)
+                {
+                    // Name the declaration split parts continue, from its line or the one before a lone brace
+                    Declaration = Line.Left(Index).TrimStartAndEnd();
+                    for (int32 Previous = LineIndex - 1; Declaration.IsEmpty() && Previous >= ChunkStart; --Previous)
+                    {
+                        Declaration = Lines[Previous].TrimStartAndEnd();
+                    }
+                    MemberEnds.Reset();
+                }
+                bNamespacePending = false;
+            }
+            else if (Char == TEXT('}'))
+            {
+                const bool bNamespace = NamespaceBraces.Num() > 0 && NamespaceBraces.Pop();
+                if (bNamespace || Depth == 0)
+                {
+                    bDeclarationEnd = true;
+                }
+                else if (--Depth == 0)
+                {
+                    bDeclarationEnd = true;
+                }
+                else if (Depth == 1)
+                {
+                    MemberEnds.AddUnique(LineIndex);
+                }
+            }
+            else if (Char == TEXT(';'))
+            {
+                bNamespacePending = false;
+                if (Depth == 0)
+                {
+                    bDeclarationEnd = true;
+                }
+                else if (Depth == 1)
+                {
+                    MemberEnds.AddUnique(LineIndex);
+                }
+            }
+        }
+
+        if (!bDeclarationEnd && LineIndex + 1 < Lines.Num())
+        {
+            continue;
+        }
+        if (LineIndex - ChunkStart + 1 < MinChunkLines && LineIndex + 1 < Lines.Num())
+        {
+            continue;
+        }
+
+        // Long declarations are split between members, each part after the first naming what it continues
+        int32 PartStart = ChunkStart;
+        if (LineIndex - ChunkStart + 1 > MaxChunkLines)
+        {
+            for (const int32 MemberEnd : MemberEnds)
+            {
+                if (MemberEnd >= PartStart && MemberEnd < LineIndex && MemberEnd - PartStart + 1 >= MaxChunkLines / 2)
+                {
+                    EmitChunk(PartStart, MemberEnd, PartStart == ChunkStart ? FString() : Declaration);
+                    PartStart = MemberEnd + 1;
+                }
+            }
+        }
+        EmitChunk(PartStart, LineIndex, PartStart == ChunkStart ? FString() : Declaration);
+
+        ChunkStart = LineIndex + 1;
+        MemberEnds.Reset();
+    }
+}
+
+void FN2CReferenceIndex::LoadSavedFiles(TArray<FIndexedFile>& OutFiles)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetIndexPath(), FILEREAD_Silent))
+    {
+        return;
+    }
+
+    FMemoryReader Reader(Bytes);
+    int32 Version = 0;
+    Reader << Version;
+    if (Version != IndexVersion)
+    {
+        return;
+    }
+
+    Reader << OutFiles;
+    if (Reader.IsError())
+    {
+        OutFiles.Reset();
+    }
+}
+
+void FN2CReferenceIndex::SaveFiles(const TArray<FIndexedFile>& Files)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    int32 Version = IndexVersion;
+    Writer << Version;
+    Writer << const_cast<TArray<FIndexedFile>&>(Files);
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *GetIndexPath()))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save reference index: %s"), *GetIndexPath()), TEXT("ReferenceIndex"));
+    }
+}
+
+FString FN2CReferenceIndex::GetIndexPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("ReferenceIndex.bin");
+}
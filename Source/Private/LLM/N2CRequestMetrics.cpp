@@ -0,0 +1,193 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CRequestMetrics.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** Value below which Percentile percent of the known (non-negative) samples fall, or -1 if none are known */
+    double GetPercentile(TArray<double> Samples, double Percentile)
+    {
+        Samples.RemoveAll([](double Sample) { return Sample < 0.0; });
+        if (Samples.Num() == 0)
+        {
+            return -1.0;
+        }
+
+        Samples.Sort();
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Samples.Num() * Percentile / 100.0) - 1, 0, Samples.Num() - 1);
+        return Samples[Index];
+    }
+
+    FString GetProviderName(EN2CLLMProvider Provider)
+    {
+        return StaticEnum<EN2CLLMProvider>()->GetNameStringByValue(static_cast<int64>(Provider));
+    }
+
+    /** Quote a CSV field if it holds a separator, quote or line break */
+    FString EscapeCsv(const FString& Value)
+    {
+        if (!Value.Contains(TEXT(",")) && !Value.Contains(TEXT("\"")) && !Value.Contains(TEXT("\n")))
+        {
+            return Value;
+        }
+        return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+    }
+}
+
+void FN2CRequestMetricsCollector::Record(FN2CRequestMetrics&& Metrics)
+{
+    if (Records.Num() >= MaxRecords)
+    {
+        Records.RemoveAt(0, Records.Num() - MaxRecords + 1);
+    }
+    Records.Add(MoveTemp(Metrics));
+    ++TotalRecorded;
+}
+
+TArray<FN2CRequestMetrics> FN2CRequestMetricsCollector::GetMetricsSince(int64 FirstRecorded) const
+{
+    const int32 Count = static_cast<int32>(FMath::Clamp<int64>(TotalRecorded - FirstRecorded, 0, Records.Num()));
+    return TArray<FN2CRequestMetrics>(Records.GetData() + Records.Num() - Count, Count);
+}
+
+void FN2CRequestMetricsCollector::Reset()
+{
+    Records.Reset();
+    CacheHits = 0;
+}
+
+FString FN2CRequestMetricsCollector::ToCsv(TConstArrayView<FN2CRequestMetrics> Metrics)
+{
+    FString Out = TEXT("queued_at,provider,model,succeeded,queue_wait_s,serialize_s,upload_s,ttfb_s,total_s,input_tokens,output_tokens,cached_input_tokens,cost_usd\n");
+    for (const FN2CRequestMetrics& Request : Metrics)
+    {
+        Out += FString::Printf(TEXT("%s,%s,%s,%d,%.3f,%.4f,%.3f,%.3f,%.3f,%d,%d,%d,%.6f\n"),
+            *Request.QueuedAt.ToIso8601(),
+            *GetProviderName(Request.Provider),
+            *EscapeCsv(Request.Model),
+            Request.bSucceeded ? 1 : 0,
+            Request.QueueWaitSeconds,
+            Request.SerializeSeconds,
+            Request.UploadSeconds,
+            Request.TimeToFirstByteSeconds,
+            Request.TotalSeconds,
+            Request.InputTokens,
+            Request.OutputTokens,
+            Request.CachedInputTokens,
+            Request.Cost);
+    }
+    return Out;
+}
+
+TArray<FN2CMetricsSummary> FN2CRequestMetricsCollector::Summarize(TConstArrayView<FN2CRequestMetrics> Metrics)
+{
+    struct FGroup
+    {
+        TArray<double> Total;
+        TArray<double> TimeToFirstByte;
+        double GenerationSeconds = 0.0;
+        int64 StreamedTokens = 0;
+    };
+    TArray<FN2CMetricsSummary> Summaries;
+    TArray<FGroup> Groups;
+
+    for (const FN2CRequestMetrics& Request : Metrics)
+    {
+        int32 GroupIndex = Summaries.IndexOfByPredicate([&Request](const FN2CMetricsSummary& Summary)
+        {
+            return Summary.Provider == Request.Provider && Summary.Model == Request.Model;
+        });
+        if (GroupIndex == INDEX_NONE)
+        {
+            GroupIndex = Summaries.AddDefaulted();
+            Groups.AddDefaulted();
+            Summaries[GroupIndex].Provider = Request.Provider;
+            Summaries[GroupIndex].Model = Request.Model;
+        }
+
+        FN2CMetricsSummary& Summary = Summaries[GroupIndex];
+        FGroup& Group = Groups[GroupIndex];
+        ++Summary.Requests;
+        Summary.Cost += Request.Cost;
+        Summary.InputTokens += Request.InputTokens;
+        Summary.CachedInputTokens += Request.CachedInputTokens;
+        Summary.OutputTokens += Request.OutputTokens;
+        if (!Request.bSucceeded)
+        {
+            ++Summary.Failures;
+            continue;
+        }
+
+        Group.Total.Add(Request.TotalSeconds);
+        Group.TimeToFirstByte.Add(Request.TimeToFirstByteSeconds);
+
+        // Throughput counts the streaming of the answer, not the wait for it to start
+        if (Request.TotalSeconds > 0.0f && Request.OutputTokens > 0)
+        {
+            Group.GenerationSeconds += Request.TotalSeconds - FMath::Max(Request.TimeToFirstByteSeconds, 0.0f);
+            Group.StreamedTokens += Request.OutputTokens;
+        }
+    }
+
+    for (int32 Index = 0; Index < Summaries.Num(); ++Index)
+    {
+        FN2CMetricsSummary& Summary = Summaries[Index];
+        const FGroup& Group = Groups[Index];
+        Summary.P50TotalSeconds = GetPercentile(Group.Total, 50.0);
+        Summary.P95TotalSeconds = GetPercentile(Group.Total, 95.0);
+        Summary.P50TimeToFirstByteSeconds = GetPercentile(Group.TimeToFirstByte, 50.0);
+        Summary.P95TimeToFirstByteSeconds = GetPercentile(Group.TimeToFirstByte, 95.0);
+        Summary.OutputTokensPerSecond = Group.GenerationSeconds > 0.0 ? Group.StreamedTokens / Group.GenerationSeconds : 0.0;
+    }
+    return Summaries;
+}
+
+FString FN2CRequestMetricsCollector::ToJson(TConstArrayView<FN2CRequestMetrics> Metrics)
+{
+    TArray<TSharedPtr<FJsonValue>> RequestValues;
+    for (const FN2CRequestMetrics& Request : Metrics)
+    {
+        TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetStringField(TEXT("queued_at"), Request.QueuedAt.ToIso8601());
+        Object->SetStringField(TEXT("provider"), GetProviderName(Request.Provider));
+        Object->SetStringField(TEXT("model"), Request.Model);
+        Object->SetBoolField(TEXT("succeeded"), Request.bSucceeded);
+        Object->SetNumberField(TEXT("queue_wait_s"), Request.QueueWaitSeconds);
+        Object->SetNumberField(TEXT("serialize_s"), Request.SerializeSeconds);
+        Object->SetNumberField(TEXT("upload_s"), Request.UploadSeconds);
+        Object->SetNumberField(TEXT("ttfb_s"), Request.TimeToFirstByteSeconds);
+        Object->SetNumberField(TEXT("total_s"), Request.TotalSeconds);
+        Object->SetNumberField(TEXT("input_tokens"), Request.InputTokens);
+        Object->SetNumberField(TEXT("output_tokens"), Request.OutputTokens);
+        Object->SetNumberField(TEXT("cached_input_tokens"), Request.CachedInputTokens);
+        Object->SetNumberField(TEXT("cost_usd"), Request.Cost);
+        RequestValues.Add(MakeShared<FJsonValueObject>(Object));
+    }
+
+    TSharedPtr<FJsonObject> SummaryObject = MakeShared<FJsonObject>();
+    for (const FN2CMetricsSummary& Summary : Summarize(Metrics))
+    {
+        TSharedPtr<FJsonObject> GroupObject = MakeShared<FJsonObject>();
+        GroupObject->SetNumberField(TEXT("requests"), Summary.Requests);
+        GroupObject->SetNumberField(TEXT("failures"), Summary.Failures);
+        GroupObject->SetNumberField(TEXT("p50_total_s"), Summary.P50TotalSeconds);
+        GroupObject->SetNumberField(TEXT("p95_total_s"), Summary.P95TotalSeconds);
+        GroupObject->SetNumberField(TEXT("p50_ttfb_s"), Summary.P50TimeToFirstByteSeconds);
+        GroupObject->SetNumberField(TEXT("p95_ttfb_s"), Summary.P95TimeToFirstByteSeconds);
+        GroupObject->SetNumberField(TEXT("output_tokens_per_s"), Summary.OutputTokensPerSecond);
+        GroupObject->SetNumberField(TEXT("cost_usd"), Summary.Cost);
+        SummaryObject->SetObjectField(GetProviderName(Summary.Provider) + TEXT("/") + Summary.Model, GroupObject);
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+    RootObject->SetObjectField(TEXT("summary"), SummaryObject);
+    RootObject->SetArrayField(TEXT("requests"), RequestValues);
+
+    FString Out;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+    return Out;
+}
@@ -2,7 +2,15 @@
 
 #include "LLM/N2CResponseParserBase.h"
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
 #include "Serialization/JsonSerializer.h"
+#include "Misc/Parse.h"
+#include "String/Find.h"
+
+DECLARE_CYCLE_STAT(TEXT("Parse Translation JSON"), STAT_N2CParseTranslationJson, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Decode Stream Chunk"), STAT_N2CConsumeStreamChunk, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Parse Streamed Response"), STAT_N2CParseStreamedResponse, STATGROUP_NodeToCode);
+DECLARE_CYCLE_STAT(TEXT("Decode Partial Translation"), STAT_N2CPartialTranslation, STATGROUP_NodeToCode);
 
 void UN2CResponseParserBase::Initialize()
 {
@@ -13,35 +21,135 @@ bool UN2CResponseParserBase::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
-    // Check for empty or obviously invalid responses
-    if (InJson.IsEmpty() || InJson.Len() < 10)
+    return ParseTranslationJson(FindJsonContent(InJson), OutResponse);
+}
+
+FStringView UN2CResponseParserBase::FindJsonContent(FStringView Content)
+{
+    // Narrow a view over the content rather than building trimmed copies
+    Content.TrimStartInline();
+
+    // Reasoning models served locally put their thoughts in <think> blocks ahead of the answer
+    while (Content.StartsWith(TEXT("<think>")))
+    {
+        const int32 ThinkEnd = UE::String::FindFirst(Content, TEXT("</think>"));
+        if (ThinkEnd == INDEX_NONE)
+        {
+            break;
+        }
+        Content.RightChopInline(ThinkEnd + 8);
+        Content.TrimStartInline();
+    }
+    Content.TrimEndInline();
+
+    // Bare JSON. Fences inside it belong to code in its strings, not around it
+    if (Content.StartsWith(TEXT('{')))
+    {
+        return Content;
+    }
+
+    // Models often wrap the JSON in a ```json code block, sometimes with prose before or after it
+    const int32 FenceStart = UE::String::FindFirst(Content, TEXT("```"));
+    if (FenceStart == INDEX_NONE)
+    {
+        return Content;
+    }
+
+    int32 BodyStart = FenceStart + 3;
+    while (BodyStart < Content.Len() && FChar::IsAlnum(Content[BodyStart]))
+    {
+        ++BodyStart;
+    }
+    Content.RightChopInline(BodyStart);
+
+    // A truncated response may never close the fence
+    const int32 FenceEnd = UE::String::FindLast(Content, TEXT("```"));
+    if (FenceEnd != INDEX_NONE)
+    {
+        Content.LeftInline(FenceEnd);
+    }
+    return Content.TrimStartAndEnd();
+}
+
+bool UN2CResponseParserBase::RepairJson(FStringView Json, FString& OutRepaired)
+{
+    // Keep only the outermost object, dropping any text the model put around it
+    int32 Start = INDEX_NONE;
+    int32 End = INDEX_NONE;
+    if (!Json.FindChar(TEXT('{'), Start) || !Json.FindLastChar(TEXT('}'), End) || End < Start)
     {
-        FN2CLogger::Get().LogError(TEXT("Empty or too short LLM response"), TEXT("ResponseParser"));
         return false;
     }
+    const FStringView Object = Json.Mid(Start, End - Start + 1);
 
-    // Check for truncated JSON by looking for unbalanced braces
-    int32 OpenBraces = 0;
-    int32 CloseBraces = 0;
-    for (const TCHAR& Char : InJson)
+    OutRepaired.Reset(Object.Len() + 16);
+    bool bInString = false;
+    bool bEscaped = false;
+    for (int32 Index = 0; Index < Object.Len(); ++Index)
     {
-        if (Char == '{') OpenBraces++;
-        else if (Char == '}') CloseBraces++;
+        const TCHAR Char = Object[Index];
+        if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Char == TEXT('\\'))
+            {
+                bEscaped = true;
+            }
+            else if (Char == TEXT('"'))
+            {
+                bInString = false;
+            }
+            else if (Char == TEXT('\n') || Char == TEXT('\r') || Char == TEXT('\t'))
+            {
+                // Raw control characters are not allowed in JSON strings
+                OutRepaired += Char == TEXT('\n') ? TEXT("\\n") : Char == TEXT('\r') ? TEXT("\\r") : TEXT("\\t");
+                continue;
+            }
+            OutRepaired.AppendChar(Char);
+            continue;
+        }
+
+        if (Char == TEXT('"'))
+        {
+            bInString = true;
+        }
+        else if (Char == TEXT(','))
+        {
+            // Drop a comma that only whitespace separates from the closing bracket
+            int32 Next = Index + 1;
+            while (Next < Object.Len() && FChar::IsWhitespace(Object[Next]))
+            {
+                ++Next;
+            }
+            if (Next < Object.Len() && (Object[Next] == TEXT('}') || Object[Next] == TEXT(']')))
+            {
+                continue;
+            }
+        }
+        OutRepaired.AppendChar(Char);
     }
-    
-    if (OpenBraces != CloseBraces)
+
+    return !FStringView(OutRepaired).Equals(Json);
+}
+
+bool UN2CResponseParserBase::ParseTranslationJson(FStringView Json, FN2CTranslationResponse& OutResponse)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CParseTranslationJson);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    // Check for empty or obviously invalid responses
+    if (Json.Len() < 10)
     {
-        FN2CLogger::Get().LogError(
-            FString::Printf(TEXT("Potentially truncated or malformed JSON response. Open braces: %d, Close braces: %d"), 
-                OpenBraces, CloseBraces),
-            TEXT("ResponseParser")
-        );
+        FN2CLogger::Get().LogError(TEXT("Empty or too short LLM response"), TEXT("ResponseParser"));
         return false;
     }
 
-    // Parse JSON string with additional safety
+    // Parse straight from the view, so the content is never copied before it is parsed
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(Json);
 
     bool bParseSuccess = false;
     
@@ -57,8 +165,39 @@ bool UN2CResponseParserBase::ParseLLMResponse(
         return false;
     }
 
+    // Repairing a response locally is far cheaper than sending the whole request again
+    FString RepairedJson;
+    if (!bParseSuccess && RepairJson(Json, RepairedJson))
+    {
+        Reader = TJsonReaderFactory<>::CreateFromView(FStringView(RepairedJson));
+        bParseSuccess = FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid();
+        if (bParseSuccess)
+        {
+            FN2CLogger::Get().LogWarning(TEXT("Repaired malformed JSON response"), TEXT("ResponseParser"));
+        }
+    }
+
     if (!bParseSuccess)
     {
+        // Only a failed parse pays for the brace count that tells truncation apart from malformed JSON
+        int32 OpenBraces = 0;
+        int32 CloseBraces = 0;
+        for (const TCHAR Char : Json)
+        {
+            if (Char == '{') OpenBraces++;
+            else if (Char == '}') CloseBraces++;
+        }
+
+        if (OpenBraces != CloseBraces)
+        {
+            FN2CLogger::Get().LogError(
+                FString::Printf(TEXT("Potentially truncated or malformed JSON response. Open braces: %d, Close braces: %d"), 
+                    OpenBraces, CloseBraces),
+                TEXT("ResponseParser")
+            );
+            return false;
+        }
+
         FN2CLogger::Get().LogError(
             FString::Printf(TEXT("Failed to parse JSON response: %s"), 
                 *Reader->GetErrorMessage()),
@@ -74,9 +213,9 @@ bool UN2CResponseParserBase::ParseLLMResponse(
         return false;
     }
 
-    // Get graphs array
+    // Get graphs array, "g" in compact responses
     const TArray<TSharedPtr<FJsonValue>>* GraphsArray;
-    if (!JsonObject->TryGetArrayField(TEXT("graphs"), GraphsArray))
+    if (!JsonObject->TryGetArrayField(TEXT("graphs"), GraphsArray) && !JsonObject->TryGetArrayField(TEXT("g"), GraphsArray))
     {
         FN2CLogger::Get().LogError(TEXT("Missing 'graphs' array in response"), TEXT("ResponseParser"));
         return false;
@@ -108,7 +247,7 @@ FString UN2CResponseParserBase::RemoveNewlines(const FString& Input) const
 
 bool UN2CResponseParserBase::ValidateResponseFormat(const TSharedPtr<FJsonObject>& JsonObject) const
 {
-    if (!JsonObject->HasField(TEXT("graphs")))
+    if (!JsonObject->HasField(TEXT("graphs")) && !JsonObject->HasField(TEXT("g")))
     {
         FN2CLogger::Get().LogError(TEXT("Response missing 'graphs' field"), TEXT("ResponseParser"));
         return false;
@@ -121,6 +260,16 @@ void UN2CResponseParserBase::ExtractGraphData(
     const TSharedPtr<FJsonObject>& GraphObject,
     FN2CGraphTranslation& OutGraph)
 {
+    // Compact responses hold the code fields in the graph object itself, under short keys
+    if (GraphObject->HasTypedField<EJson::String>(TEXT("n")))
+    {
+        OutGraph.GraphName = GraphObject->GetStringField(TEXT("n"));
+        GraphObject->TryGetStringField(TEXT("t"), OutGraph.GraphType);
+        GraphObject->TryGetStringField(TEXT("c"), OutGraph.GraphClass);
+        ExtractCodeData(GraphObject, OutGraph.Code);
+        return;
+    }
+
     // Extract basic graph information
     OutGraph.GraphName = GraphObject->GetStringField(TEXT("graph_name"));
     OutGraph.GraphType = GraphObject->GetStringField(TEXT("graph_type"));
@@ -145,9 +294,18 @@ void UN2CResponseParserBase::ExtractCodeData(
     const TSharedPtr<FJsonObject>& CodeObject,
     FN2CGeneratedCode& OutCode)
 {
+    // Sections the request skipped are left out, and stay empty
+    if (CodeObject->HasField(TEXT("i")))
+    {
+        CodeObject->TryGetStringField(TEXT("d"), OutCode.GraphDeclaration);
+        CodeObject->TryGetStringField(TEXT("i"), OutCode.GraphImplementation);
+        CodeObject->TryGetStringField(TEXT("m"), OutCode.ImplementationNotes);
+        return;
+    }
+
     OutCode.GraphDeclaration = CodeObject->GetStringField(TEXT("graphDeclaration"));
     OutCode.GraphImplementation = CodeObject->GetStringField(TEXT("graphImplementation"));
-    OutCode.ImplementationNotes = CodeObject->GetStringField(TEXT("implementationNotes"));
+    CodeObject->TryGetStringField(TEXT("implementationNotes"), OutCode.ImplementationNotes);
 }
 
 bool UN2CResponseParserBase::HandleCommonErrorResponse(
@@ -236,9 +394,8 @@ bool UN2CResponseParserBase::ExtractStandardMessageContent(
         }
     }
 
-    // Get content string
-    FString RawContent;
-    if (!MessageObject->TryGetStringField(ContentFieldName, RawContent))
+    // Get content string. Code fences are skipped when the content is parsed
+    if (!MessageObject->TryGetStringField(ContentFieldName, OutContent))
     {
         FN2CLogger::Get().LogError(
             FString::Printf(TEXT("Missing '%s' field in response"), *ContentFieldName),
@@ -247,26 +404,364 @@ bool UN2CResponseParserBase::ExtractStandardMessageContent(
         return false;
     }
 
-    // Process content for JSON markers
-    if (ProcessJsonContentWithMarkers(RawContent))
-    {
-        FN2CLogger::Get().Log(TEXT("Stripped JSON markers from response"), EN2CLogSeverity::Debug);
-    }
-    
-    OutContent = RawContent;
     return true;
 }
 
-bool UN2CResponseParserBase::ProcessJsonContentWithMarkers(FString& Content)
+bool UN2CResponseParserBase::IsStreamedResponse(const FString& Body) const
 {
-    // Check if content is wrapped in ```json markers and remove them
-    if (Content.StartsWith(TEXT("```json")) && Content.EndsWith(TEXT("```")))
+    const FString Trimmed = Body.TrimStart();
+
+    // Server-sent events
+    if (Trimmed.StartsWith(TEXT("data:")) || Trimmed.StartsWith(TEXT("event:")))
     {
-        // Remove the ```json prefix and ``` suffix
-        Content = Content.RightChop(7); // Skip past "```json"
-        Content = Content.LeftChop(3);  // Remove trailing "```"
-        Content = Content.TrimStartAndEnd(); // Remove any extra whitespace
         return true;
     }
+
+    // Newline-delimited JSON: more than one top-level object, one per line
+    return Trimmed.StartsWith(TEXT("{")) && Trimmed.TrimEnd().Contains(TEXT("}\n{"));
+}
+
+bool UN2CResponseParserBase::IsTruncatedResponse(const FString& Response) const
+{
+    // OpenAI-compatible chat completions, in the final chunk when streamed
+    return HasStringField(Response, TEXT("finish_reason"), TEXT("length"));
+}
+
+bool UN2CResponseParserBase::HasStringField(FStringView Body, FStringView Field, FStringView Value)
+{
+    const TCHAR* Data = Body.GetData();
+    const int32 Length = Body.Len();
+    for (int32 Index = 0; Index + Field.Len() + 2 <= Length; ++Index)
+    {
+        // A key written inside generated code arrives escaped, as \"finish_reason\"
+        if (Data[Index] != TEXT('"') || (Index > 0 && Data[Index - 1] == TEXT('\\'))
+            || Data[Index + Field.Len() + 1] != TEXT('"')
+            || !Body.Mid(Index + 1, Field.Len()).Equals(Field, ESearchCase::CaseSensitive))
+        {
+            continue;
+        }
+
+        int32 Cursor = Index + Field.Len() + 2;
+        while (Cursor < Length && FChar::IsWhitespace(Data[Cursor]))
+        {
+            ++Cursor;
+        }
+        if (Cursor >= Length || Data[Cursor] != TEXT(':'))
+        {
+            continue;
+        }
+        ++Cursor;
+        while (Cursor < Length && FChar::IsWhitespace(Data[Cursor]))
+        {
+            ++Cursor;
+        }
+        if (Cursor + Value.Len() + 2 <= Length && Data[Cursor] == TEXT('"')
+            && Data[Cursor + Value.Len() + 1] == TEXT('"')
+            && Body.Mid(Cursor + 1, Value.Len()).Equals(Value, ESearchCase::CaseSensitive))
+        {
+            return true;
+        }
+    }
     return false;
 }
+
+void UN2CResponseParserBase::ConsumeStreamChunk(FN2CLLMStreamState& State, const FString& Chunk) const
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CConsumeStreamChunk);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    State.PendingLine += Chunk;
+
+    int32 LineStart = 0;
+    int32 NewlineIndex = INDEX_NONE;
+    while ((NewlineIndex = State.PendingLine.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, LineStart)) != INDEX_NONE)
+    {
+        FString Line = State.PendingLine.Mid(LineStart, NewlineIndex - LineStart).TrimStartAndEnd();
+        LineStart = NewlineIndex + 1;
+
+        // SSE comments, event names and blank separators carry no payload
+        if (Line.IsEmpty() || Line.StartsWith(TEXT(":")) || Line.StartsWith(TEXT("event:")))
+        {
+            continue;
+        }
+
+        if (Line.StartsWith(TEXT("data:")))
+        {
+            Line.RightChopInline(5);
+            Line.TrimStartInline();
+        }
+
+        if (Line == TEXT("[DONE]") || !Line.StartsWith(TEXT("{")))
+        {
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> EventObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(Line);
+        if (!FJsonSerializer::Deserialize(Reader, EventObject) || !EventObject.IsValid())
+        {
+            FN2CLogger::Get().LogWarning(
+                FString::Printf(TEXT("Skipping malformed stream event: %s"), *Line),
+                TEXT("ResponseParser"));
+            continue;
+        }
+
+        if (EventObject->HasField(TEXT("error")))
+        {
+            const TSharedPtr<FJsonObject>* ErrorObject = nullptr;
+            if (EventObject->TryGetObjectField(TEXT("error"), ErrorObject))
+            {
+                (*ErrorObject)->TryGetStringField(TEXT("message"), State.ErrorMessage);
+            }
+            else
+            {
+                EventObject->TryGetStringField(TEXT("error"), State.ErrorMessage);
+            }
+            if (State.ErrorMessage.IsEmpty())
+            {
+                State.ErrorMessage = TEXT("Unknown streaming error");
+            }
+            continue;
+        }
+
+        ProcessStreamEvent(EventObject, State);
+    }
+
+    State.PendingLine.RightChopInline(LineStart);
+}
+
+bool UN2CResponseParserBase::ParseStreamedResponse(const FString& StreamBody, FN2CTranslationResponse& OutResponse)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CParseStreamedResponse);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    FN2CLLMStreamState State;
+
+    // Terminate the last line so it is decoded too
+    ConsumeStreamChunk(State, StreamBody + TEXT("\n"));
+
+    if (!State.ErrorMessage.IsEmpty())
+    {
+        FN2CLogger::Get().LogError(
+            FString::Printf(TEXT("LLM stream reported an error: %s"), *State.ErrorMessage),
+            TEXT("ResponseParser"));
+        return false;
+    }
+
+    FinalizeStreamedContent(State.Content);
+
+    OutResponse.Usage = State.Usage;
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("LLM Token Usage - Input: %d (Cached: %d) Output: %d"),
+            State.Usage.InputTokens, State.Usage.CachedInputTokens, State.Usage.OutputTokens),
+        EN2CLogSeverity::Info);
+    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Streamed Message Content: %s"), *State.Content), EN2CLogSeverity::Debug);
+
+    // Parse the accumulated content as our expected JSON format
+    return UN2CResponseParserBase::ParseLLMResponse(State.Content, OutResponse);
+}
+
+void UN2CResponseParserBase::ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const
+{
+    // OpenAI-compatible chunk: choices[0].delta.content, usage on the final chunk
+    const TArray<TSharedPtr<FJsonValue>>* ChoicesArray = nullptr;
+    if (EventObject->TryGetArrayField(TEXT("choices"), ChoicesArray) && ChoicesArray->Num() > 0)
+    {
+        const TSharedPtr<FJsonObject> ChoiceObject = (*ChoicesArray)[0]->AsObject();
+        const TSharedPtr<FJsonObject>* DeltaObject = nullptr;
+        if (ChoiceObject.IsValid() && ChoiceObject->TryGetObjectField(TEXT("delta"), DeltaObject))
+        {
+            FString Delta;
+            if ((*DeltaObject)->TryGetStringField(TEXT("content"), Delta))
+            {
+                State.Content += Delta;
+            }
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* UsageObject = nullptr;
+    if (EventObject->TryGetObjectField(TEXT("usage"), UsageObject))
+    {
+        (*UsageObject)->TryGetNumberField(TEXT("prompt_tokens"), State.Usage.InputTokens);
+        (*UsageObject)->TryGetNumberField(TEXT("completion_tokens"), State.Usage.OutputTokens);
+        State.Usage.CachedInputTokens = GetOpenAICachedTokens(*UsageObject);
+
+        // DeepSeek reports cache hits at the top level of usage
+        (*UsageObject)->TryGetNumberField(TEXT("prompt_cache_hit_tokens"), State.Usage.CachedInputTokens);
+    }
+}
+
+int32 UN2CResponseParserBase::GetOpenAICachedTokens(const TSharedPtr<FJsonObject>& UsageObject)
+{
+    int32 CachedTokens = 0;
+    const TSharedPtr<FJsonObject>* DetailsObject = nullptr;
+    if (UsageObject.IsValid() && UsageObject->TryGetObjectField(TEXT("prompt_tokens_details"), DetailsObject))
+    {
+        (*DetailsObject)->TryGetNumberField(TEXT("cached_tokens"), CachedTokens);
+    }
+    return CachedTokens;
+}
+
+void UN2CResponseParserBase::FinalizeStreamedContent(FString& Content)
+{
+    // Surrounding whitespace, thinking and code fences are skipped by FindJsonContent when the content is parsed
+}
+
+bool FN2CPartialTranslationParser::Feed(FStringView Text)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CPartialTranslation);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    ConsumedLength += Text.Len();
+
+    bool bChanged = false;
+    for (const TCHAR Char : Text)
+    {
+        if (bInString)
+        {
+            bChanged |= AppendStringChar(Char);
+            continue;
+        }
+
+        switch (Char)
+        {
+            case TEXT('"'):
+                BeginString();
+                break;
+            case TEXT('{'):
+            case TEXT('['):
+                Containers.Add(Char);
+                if (Char == TEXT('[') && (LastKey == TEXT("graphs") || (LastKey == TEXT("g") && Containers.Num() == 2)) && GraphsDepth == INDEX_NONE)
+                {
+                    GraphsDepth = Containers.Num();
+                }
+                else if (Char == TEXT('{') && Containers.Num() == GraphsDepth + 1)
+                {
+                    // A new graph starts
+                    ++GraphIndex;
+                    Code = FN2CGeneratedCode();
+                    bChanged = true;
+                }
+                bExpectKey = Char == TEXT('{');
+                break;
+            case TEXT('}'):
+            case TEXT(']'):
+                if (Containers.Num() > 0)
+                {
+                    Containers.Pop();
+                }
+                bExpectKey = false;
+                break;
+            case TEXT(','):
+                bExpectKey = Containers.Num() > 0 && Containers.Last() == TEXT('{');
+                break;
+            case TEXT(' '):
+            case TEXT('\t'):
+            case TEXT('\r'):
+            case TEXT('\n'):
+                break;
+            default:
+                // ':' and the characters of numbers and literals
+                bExpectKey = false;
+                break;
+        }
+    }
+    return bChanged;
+}
+
+void FN2CPartialTranslationParser::BeginString()
+{
+    bInString = true;
+    bEscape = false;
+    NumUnicodeDigits = INDEX_NONE;
+    bStringIsKey = bExpectKey;
+    bExpectKey = false;
+    TargetField = nullptr;
+
+    if (bStringIsKey)
+    {
+        Key.Reset();
+    }
+    else if (LastKey == TEXT("graphDeclaration"))
+    {
+        TargetField = &Code.GraphDeclaration;
+    }
+    else if (LastKey == TEXT("graphImplementation"))
+    {
+        TargetField = &Code.GraphImplementation;
+    }
+    else if (LastKey == TEXT("implementationNotes"))
+    {
+        TargetField = &Code.ImplementationNotes;
+    }
+    else if (GraphsDepth != INDEX_NONE && Containers.Num() == GraphsDepth + 1 && LastKey.Len() == 1)
+    {
+        // Compact responses keep the code fields in the graph object under one-letter keys
+        switch (LastKey[0])
+        {
+            case TEXT('d'): TargetField = &Code.GraphDeclaration; break;
+            case TEXT('i'): TargetField = &Code.GraphImplementation; break;
+            case TEXT('m'): TargetField = &Code.ImplementationNotes; break;
+            default: break;
+        }
+    }
+
+    if (TargetField)
+    {
+        TargetField->Reset();
+    }
+}
+
+bool FN2CPartialTranslationParser::AppendStringChar(TCHAR Char)
+{
+    FString* const Out = bStringIsKey ? &Key : TargetField;
+    TCHAR Decoded = 0;
+
+    if (NumUnicodeDigits != INDEX_NONE)
+    {
+        UnicodeValue = (UnicodeValue << 4) | FParse::HexDigit(Char);
+        if (++NumUnicodeDigits < 4)
+        {
+            return false;
+        }
+        NumUnicodeDigits = INDEX_NONE;
+        Decoded = static_cast<TCHAR>(UnicodeValue);
+    }
+    else if (bEscape)
+    {
+        bEscape = false;
+        switch (Char)
+        {
+            case TEXT('n'): Decoded = TEXT('\n'); break;
+            case TEXT('t'): Decoded = TEXT('\t'); break;
+            case TEXT('r'): return false;
+            case TEXT('u'): NumUnicodeDigits = 0; UnicodeValue = 0; return false;
+            default: Decoded = Char; break;
+        }
+    }
+    else if (Char == TEXT('\\'))
+    {
+        bEscape = true;
+        return false;
+    }
+    else if (Char == TEXT('"'))
+    {
+        bInString = false;
+        if (bStringIsKey)
+        {
+            LastKey = Key;
+        }
+        return false;
+    }
+    else
+    {
+        Decoded = Char;
+    }
+
+    if (!Out)
+    {
+        return false;
+    }
+    Out->AppendChar(Decoded);
+    return !bStringIsKey;
+}
@@ -0,0 +1,227 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CSyntaxVerifier.h"
+
+#include "Core/N2CSettings.h"
+#include "Models/N2CTranslation.h"
+#include "Utils/N2CLogger.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    /** Reflection macros the generated code uses, which mean nothing to a plain compiler */
+    const TCHAR* CppPreamble = TEXT(
+        "#ifndef UFUNCTION\n#define UFUNCTION(...)\n#endif\n"
+        "#ifndef UPROPERTY\n#define UPROPERTY(...)\n#endif\n"
+        "#ifndef UCLASS\n#define UCLASS(...)\n#endif\n"
+        "#ifndef USTRUCT\n#define USTRUCT(...)\n#endif\n"
+        "#ifndef UENUM\n#define UENUM(...)\n#endif\n"
+        "#ifndef UMETA\n#define UMETA(...)\n#endif\n"
+        "#ifndef GENERATED_BODY\n#define GENERATED_BODY()\n#endif\n");
+
+    /** Output kept per graph, so one broken graph cannot flood the retry prompt */
+    constexpr int32 MaxDiagnosticsLength = 2000;
+
+    /**
+     * Whether a clang diagnostic line is a parse error. The code is compiled outside its class and project,
+     * so errors about names and types it cannot see are expected and ignored
+     */
+    bool IsParseError(const FString& Line)
+    {
+        const int32 ErrorIndex = Line.Find(TEXT("error: "));
+        if (ErrorIndex == INDEX_NONE)
+        {
+            return false;
+        }
+
+        const FString Message = Line.RightChop(ErrorIndex + 7);
+        static const TCHAR* ParseErrorPrefixes[] = {
+            TEXT("expected"), TEXT("unterminated"), TEXT("extraneous"), TEXT("missing terminating"),
+            TEXT("unmatched"), TEXT("invalid preprocessing"), TEXT("stray")
+        };
+        for (const TCHAR* Prefix : ParseErrorPrefixes)
+        {
+            if (Message.StartsWith(Prefix))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+FN2CSyntaxVerifier& FN2CSyntaxVerifier::Get()
+{
+    static FN2CSyntaxVerifier Instance;
+    return Instance;
+}
+
+bool FN2CSyntaxVerifier::IsEnabledFor(EN2CCodeLanguage Language)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    return Settings && Settings->bVerifyGeneratedSyntax
+        && (Language == EN2CCodeLanguage::Cpp || Language == EN2CCodeLanguage::Python);
+}
+
+void FN2CSyntaxVerifier::Verify(const FN2CTranslationResponse& Response, EN2CCodeLanguage Language, TFunction<void(bool, const FString&)>&& OnComplete)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bIncludeEngine = Settings && Settings->SyntaxCheckIncludeDirectories.Num() > 0;
+
+    FJob Job;
+    Job.Language = Language;
+    Job.OnComplete = MoveTemp(OnComplete);
+    for (const FN2CGraphTranslation& Graph : Response.Graphs)
+    {
+        const FN2CGeneratedCode& Code = Graph.Code;
+        if (Code.GraphImplementation.TrimStartAndEnd().IsEmpty() && Code.GraphDeclaration.TrimStartAndEnd().IsEmpty())
+        {
+            continue;
+        }
+
+        // Declarations are usually class members, so they are checked inside a class of their own
+        const FString Source = Language == EN2CCodeLanguage::Cpp
+            ? FString::Printf(TEXT("%s%s\nstruct FN2CSyntaxCheck\n{\n%s\n};\n\n%s\n"),
+                bIncludeEngine ? TEXT("#include \"CoreMinimal.h\"\n") : TEXT(""), CppPreamble, *Code.GraphDeclaration, *Code.GraphImplementation)
+            : Code.GraphImplementation;
+        Job.Sources.Emplace(Graph.GraphName, Source);
+    }
+
+    if (Job.Sources.Num() == 0)
+    {
+        Job.OnComplete(true, FString());
+        return;
+    }
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        Queue.Add(MoveTemp(Job));
+    }
+    StartJobs();
+}
+
+void FN2CSyntaxVerifier::StartJobs()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const int32 MaxRunning = Settings ? FMath::Max(Settings->MaxConcurrentSyntaxChecks, 1) : 1;
+
+    FScopeLock ScopeLock(&Lock);
+    while (Queue.Num() > 0 && RunningJobs < MaxRunning)
+    {
+        ++RunningJobs;
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Job = MoveTemp(Queue[0])]() mutable
+        {
+            FString Diagnostics = RunJob(Job);
+            {
+                FScopeLock JobLock(&Lock);
+                --RunningJobs;
+            }
+            StartJobs();
+
+            AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(Job.OnComplete), Diagnostics = MoveTemp(Diagnostics)]()
+            {
+                OnComplete(Diagnostics.IsEmpty(), Diagnostics);
+            });
+        });
+        Queue.RemoveAt(0);
+    }
+}
+
+FString FN2CSyntaxVerifier::RunJob(const FJob& Job)
+{
+    FString Diagnostics;
+    for (const TPair<FString, FString>& Source : Job.Sources)
+    {
+        FString GraphDiagnostics;
+        if (!CheckSource(Job.Language, Source.Value, GraphDiagnostics))
+        {
+            Diagnostics += FString::Printf(TEXT("### %s\n%s\n"), *Source.Key, *GraphDiagnostics.Left(MaxDiagnosticsLength));
+        }
+    }
+    return Diagnostics;
+}
+
+bool FN2CSyntaxVerifier::CheckSource(EN2CCodeLanguage Language, const FString& Source, FString& OutDiagnostics)
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings)
+    {
+        return true;
+    }
+
+    const bool bIsCpp = Language == EN2CCodeLanguage::Cpp;
+    const FString Directory = FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("SyntaxChecks");
+    const FString FilePath = FPaths::ConvertRelativePathToFull(
+        Directory / FGuid::NewGuid().ToString(EGuidFormats::Digits) + (bIsCpp ? TEXT(".cpp") : TEXT(".py")));
+    if (!FFileHelper::SaveStringToFile(Source, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to write syntax check file: %s"), *FilePath), TEXT("SyntaxVerifier"));
+        return true;
+    }
+
+    FString Executable;
+    FString Params;
+    if (bIsCpp)
+    {
+        Executable = Settings->ClangExecutable.IsEmpty() ? TEXT("clang++") : Settings->ClangExecutable;
+        Params = TEXT("-fsyntax-only -x c++ -std=c++20 -ferror-limit=0 -fno-color-diagnostics -w");
+        for (const FDirectoryPath& IncludeDirectory : Settings->SyntaxCheckIncludeDirectories)
+        {
+            Params += FString::Printf(TEXT(" -I\"%s\""), *IncludeDirectory.Path);
+        }
+        Params += FString::Printf(TEXT(" \"%s\""), *FilePath);
+    }
+    else
+    {
+        Executable = Settings->PythonExecutable.IsEmpty() ? TEXT("python") : Settings->PythonExecutable;
+        Params = FString::Printf(TEXT("-m py_compile \"%s\""), *FilePath);
+    }
+
+    int32 ReturnCode = 0;
+    FString StdOut;
+    FString StdErr;
+    const bool bLaunched = FPlatformProcess::ExecProcess(*Executable, *Params, &ReturnCode, &StdOut, &StdErr);
+    IFileManager::Get().Delete(*FilePath, false, false, true);
+
+    if (!bLaunched)
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (!MissingCompilers.Contains(Executable))
+        {
+            MissingCompilers.Add(Executable);
+            FN2CLogger::Get().LogWarning(
+                FString::Printf(TEXT("Could not run %s, generated code is not syntax checked"), *Executable), TEXT("SyntaxVerifier"));
+        }
+        return true;
+    }
+    if (ReturnCode == 0)
+    {
+        return true;
+    }
+
+    // The temporary path means nothing to the model
+    const FString Output = (StdErr + StdOut).Replace(*FilePath, TEXT("graph"));
+    if (!bIsCpp)
+    {
+        OutDiagnostics = Output.TrimStartAndEnd();
+        return false;
+    }
+
+    TArray<FString> Lines;
+    Output.ParseIntoArrayLines(Lines);
+    for (const FString& Line : Lines)
+    {
+        if (IsParseError(Line))
+        {
+            OutDiagnostics += Line + TEXT("\n");
+        }
+    }
+    return OutDiagnostics.IsEmpty();
+}
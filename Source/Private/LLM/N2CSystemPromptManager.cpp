@@ -3,20 +3,195 @@
 #include "LLM/N2CSystemPromptManager.h"
 
 #include "Core/N2CSettings.h"
+#include "LLM/N2CPromptFileCache.h"
+#include "LLM/N2CReferenceIndex.h"
 #include "Utils/N2CLogger.h"
+#include "Algo/AnyOf.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    /** Prompt used when no CodeGen prompt file could be loaded */
+    const TCHAR* FallbackCodeGenPrompt = TEXT("You are an expert developer specializing in Unreal Engine Blueprint to code conversion.");
+
+    /** A reference source file formatted for the prompt, with the symbols it declares */
+    struct FReferenceFile
+    {
+        FString Formatted;
+
+        /** Types and functions the file declares, types also without their Unreal prefix */
+        TSet<FString> Symbols;
+    };
+
+    bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    /** Add a symbol, and for Unreal type names (AActor, UObject, FVector...) the name Blueprints know it by */
+    void AddSymbol(const FString& Symbol, TSet<FString>& OutSymbols)
+    {
+        OutSymbols.Add(Symbol);
+        if (Symbol.Len() > 2 && FCString::Strchr(TEXT("AUFEIST"), Symbol[0]) && FChar::IsUpper(Symbol[1]))
+        {
+            OutSymbols.Add(Symbol.RightChop(1));
+        }
+    }
+
+    /** Collect the names of the types and functions a source file declares */
+    void IndexSymbols(const FString& Content, TSet<FString>& OutSymbols)
+    {
+        static const TSet<FString> NonFunctionWords = {
+            TEXT("if"), TEXT("for"), TEXT("while"), TEXT("switch"), TEXT("return"), TEXT("sizeof"), TEXT("catch"),
+            TEXT("decltype"), TEXT("alignof"), TEXT("static_assert"), TEXT("static_cast"), TEXT("const_cast"),
+            TEXT("reinterpret_cast"), TEXT("dynamic_cast"), TEXT("TEXT"), TEXT("operator")
+        };
+
+        bool bExpectTypeName = false;
+        int32 Index = 0;
+        while (Index < Content.Len())
+        {
+            if (!IsIdentifierChar(Content[Index]) || FChar::IsDigit(Content[Index]))
+            {
+                // Braces, bases and the like end a type declaration without a name
+                if (!FChar::IsWhitespace(Content[Index]))
+                {
+                    bExpectTypeName = false;
+                }
+                ++Index;
+                continue;
+            }
+
+            const int32 Start = Index;
+            while (Index < Content.Len() && IsIdentifierChar(Content[Index]))
+            {
+                ++Index;
+            }
+            const FString Word = Content.Mid(Start, Index - Start);
+
+            int32 Next = Index;
+            while (Next < Content.Len() && FChar::IsWhitespace(Content[Next]))
+            {
+                ++Next;
+            }
+            const TCHAR NextChar = Next < Content.Len() ? Content[Next] : TEXT('\0');
+
+            if (Word == TEXT("class") || Word == TEXT("struct") || Word == TEXT("enum"))
+            {
+                bExpectTypeName = true;
+            }
+            else if (bExpectTypeName && !Word.EndsWith(TEXT("_API")))
+            {
+                // Forward declarations say nothing about what the file is for
+                if (NextChar != TEXT(';'))
+                {
+                    AddSymbol(Word, OutSymbols);
+                }
+                bExpectTypeName = false;
+            }
+            else if (NextChar == TEXT('(') && !NonFunctionWords.Contains(Word) && Word != Word.ToUpper())
+            {
+                // Declarations and definitions, skipping keywords and ALL_CAPS macros
+                OutSymbols.Add(Word);
+            }
+        }
+    }
+
+    /** Collect the member parent, member name and pin sub type values of an N2C JSON graph, in either dialect */
+    void CollectGraphSymbols(const FString& Json, TSet<FString>& OutSymbols)
+    {
+        static const TCHAR* Keys[] = {
+            TEXT("\"member_parent\""), TEXT("\"member_name\""), TEXT("\"sub_type\""),
+            TEXT("\"mp\""), TEXT("\"mn\""), TEXT("\"st\"")
+        };
+
+        for (const TCHAR* Key : Keys)
+        {
+            const int32 KeyLen = FCString::Strlen(Key);
+            int32 Index = 0;
+            while ((Index = Json.Find(Key, ESearchCase::CaseSensitive, ESearchDir::FromStart, Index)) != INDEX_NONE)
+            {
+                Index += KeyLen;
+                while (Index < Json.Len() && (FChar::IsWhitespace(Json[Index]) || Json[Index] == TEXT(':')))
+                {
+                    ++Index;
+                }
+                if (Index >= Json.Len() || Json[Index] != TEXT('"'))
+                {
+                    continue;
+                }
+
+                const int32 Start = ++Index;
+                while (Index < Json.Len() && Json[Index] != TEXT('"'))
+                {
+                    ++Index;
+                }
+                if (Index > Start)
+                {
+                    const FString Value = Json.Mid(Start, Index - Start);
+                    OutSymbols.Add(Value);
+
+                    // Blueprint-exposed wrappers of native functions
+                    if (Value.StartsWith(TEXT("K2_")))
+                    {
+                        OutSymbols.Add(Value.RightChop(3));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Prompts and reference files shared by every prompt manager. Each service used to load every
+     * language's prompt into its own manager up front; now a prompt file is read the first time a
+     * request needs it and held once for the whole module.
+     */
+    struct FPromptStore
+    {
+        FCriticalSection Lock;
+
+        /** Base directory for prompt files, resolved on first use */
+        FString PromptsDirectory;
+        bool bResolvedDirectory = false;
+
+        /** Prompts by key. A key whose file is missing maps to an empty prompt so it is only looked up once */
+        TMap<FString, FString> Prompts;
+
+        /** Prompt file cache generation the prompts were loaded at */
+        uint32 Generation = 0;
+
+        /** Indexed reference files, the paths they were loaded from and their cache generation */
+        TArray<FReferenceFile> ReferenceFiles;
+        TArray<FString> ReferenceFilePaths;
+        uint32 ReferenceGeneration = MAX_uint32;
+        bool bReferenceFilesComplete = true;
+    };
+
+    FPromptStore& GetPromptStore()
+    {
+        static FPromptStore Store;
+        return Store;
+    }
+}
 
 void UN2CSystemPromptManager::Initialize(const FN2CLLMConfig& Config)
 {
     bSupportsSystemPrompts = Config.bUseSystemPrompts;
-    LoadPrompts();
 }
 
 FString UN2CSystemPromptManager::GetSystemPrompt(const FString& PromptKey) const
 {
-    if (const FString* Prompt = LoadedPrompts.Find(PromptKey))
+    FString Prompt;
+    if (FindPrompt(PromptKey, Prompt))
     {
-        return *Prompt;
+        return Prompt;
+    }
+
+    if (PromptKey == TEXT("CodeGen"))
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to load any CodeGen system prompt files from Docs/Prompting. Translation will fail!"), TEXT("SystemPromptManager"));
+        return FallbackCodeGenPrompt;
     }
 
     FN2CLogger::Get().LogWarning(
@@ -26,6 +201,49 @@ FString UN2CSystemPromptManager::GetSystemPrompt(const FString& PromptKey) const
     return FString();
 }
 
+bool UN2CSystemPromptManager::FindPrompt(const FString& PromptKey, FString& OutPrompt) const
+{
+    FPromptStore& Store = GetPromptStore();
+    FString FilePath;
+    {
+        FScopeLock ScopeLock(&Store.Lock);
+
+        // A prompt file edited on disk is picked up by the next request
+        const uint32 Generation = FN2CPromptFileCache::Get().GetGeneration();
+        if (Generation != Store.Generation)
+        {
+            Store.Prompts.Reset();
+            Store.Generation = Generation;
+        }
+
+        if (const FString* Prompt = Store.Prompts.Find(PromptKey))
+        {
+            OutPrompt = *Prompt;
+            return !OutPrompt.IsEmpty();
+        }
+
+        if (!Store.bResolvedDirectory)
+        {
+            Store.bResolvedDirectory = true;
+            Store.PromptsDirectory = FindPromptsDirectory();
+        }
+        if (Store.PromptsDirectory.IsEmpty())
+        {
+            return false;
+        }
+        FilePath = FPaths::Combine(Store.PromptsDirectory, PromptKey + TEXT(".md"));
+    }
+
+    if (!LoadPromptFromFile(FilePath, OutPrompt))
+    {
+        OutPrompt.Reset();
+    }
+
+    FScopeLock ScopeLock(&Store.Lock);
+    Store.Prompts.Add(PromptKey, OutPrompt);
+    return !OutPrompt.IsEmpty();
+}
+
 FString UN2CSystemPromptManager::MergePrompts(const FString& SystemPrompt, const FString& UserMessage) const
 {
     // For LLMs that don't support separate system prompts, prepend it to the user message
@@ -34,51 +252,130 @@ FString UN2CSystemPromptManager::MergePrompts(const FString& SystemPrompt, const
 
 bool UN2CSystemPromptManager::PrependSourceFilesToUserMessage(FString& UserMessage) const
 {
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();                                                                                                                                            
-     if (!Settings || Settings->ReferenceSourceFilePaths.Num() == 0)                                                                                                                                       
-     {                                                                                                                                                                                                     
-         return true; // No files to process is still considered successful                                                                                                                                
-     }                                                                                                                                                                                                     
-                                                                                                                                                                                                           
-     FString ReferenceFiles;                                                                                                                                                                               
-     bool bSuccess = true;                                                                                                                                                                                 
-                                                                                                                                                                                                           
-     for (const FFilePath& FilePath : Settings->ReferenceSourceFilePaths)                                                                                                                                  
-     {                                                                                                                                                                                                     
-         FString Content;                                                                                                                                                                                  
-         if (FFileHelper::LoadFileToString(Content, *FilePath.FilePath))                                                                                                                                   
-         {                                                                                                                                                                                                 
-             if (!ReferenceFiles.IsEmpty())                                                                                                                                                                
-             {                                                                                                                                                                                             
-                 ReferenceFiles += TEXT("\n\n");                                                                                                                                                           
-             }                                                                                                                                                                                             
-             ReferenceFiles += FormatSourceFileContent(FilePath.FilePath, Content);                                                                                                                        
-         }                                                                                                                                                                                                 
-         else                                                                                                                                                                                              
-         {                                                                                                                                                                                                 
-             FN2CLogger::Get().LogWarning(                                                                                                                                                                 
-                 FString::Printf(TEXT("Failed to load reference source file: %s"), *FilePath.FilePath),                                                                                                    
-                 TEXT("SystemPromptManager")                                                                                                                                                               
-             );                                                                                                                                                                                            
-             bSuccess = false;                                                                                                                                                                             
-         }                                                                                                                                                                                                 
-     }                                                                                                                                                                                                     
-                                                                                                                                                                                                           
-     if (!ReferenceFiles.IsEmpty())                                                                                                                                                                        
-     {                                                                                                                                                                                                     
-         UserMessage = FString::Printf(TEXT("<referenceSourceFiles>\n%s\n</referenceSourceFiles>\n\n%s"),                                                                                                  
-             *ReferenceFiles, *UserMessage);                                                                                                                                                               
-     }                                                                                                                                                                                                     
-                                                                                                                                                                                                           
-     return bSuccess;
+    FString ReferenceBlock;
+    const bool bSuccess = BuildReferenceSourceFilesBlock(UserMessage, ReferenceBlock);
+
+    if (!ReferenceBlock.IsEmpty())
+    {
+        UserMessage = FString::Printf(TEXT("%s\n\n%s"), *ReferenceBlock, *UserMessage);
+    }
+
+    return bSuccess;
+}
+
+bool UN2CSystemPromptManager::BuildReferenceSourceFilesBlock(const FString& UserMessage, FString& OutBlock) const
+{
+    OutBlock.Reset();
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!Settings || Settings->ReferenceSourceFilePaths.Num() == 0 || bOmitReferenceFiles)
+    {
+        return true; // No files to process is still considered successful
+    }
+
+    TArray<FString> FilePaths;
+    for (const FFilePath& FilePath : Settings->ReferenceSourceFilePaths)
+    {
+        FilePaths.Add(FilePath.FilePath);
+    }
+
+    // Load and index the files again only when the file list changes or one of them changes on disk
+    FPromptStore& Store = GetPromptStore();
+    const uint32 Generation = FN2CPromptFileCache::Get().GetGeneration();
+    FScopeLock ScopeLock(&Store.Lock);
+    if (Generation != Store.ReferenceGeneration || FilePaths != Store.ReferenceFilePaths)
+    {
+        Store.ReferenceFiles.Reset();
+        Store.bReferenceFilesComplete = true;
+
+        for (const FString& FilePath : FilePaths)
+        {
+            if (const TSharedPtr<const FString> Content = FN2CPromptFileCache::Get().LoadShared(FilePath))
+            {
+                FReferenceFile& File = Store.ReferenceFiles.AddDefaulted_GetRef();
+                IndexSymbols(*Content, File.Symbols);
+                File.Formatted = FormatSourceFileContent(FilePath, *Content);
+            }
+            else
+            {
+                FN2CLogger::Get().LogWarning(
+                    FString::Printf(TEXT("Failed to load reference source file: %s"), *FilePath),
+                    TEXT("SystemPromptManager")
+                );
+                Store.bReferenceFilesComplete = false;
+            }
+        }
+
+        Store.ReferenceFilePaths = MoveTemp(FilePaths);
+        Store.ReferenceGeneration = Generation;
+    }
+
+    // Only files declaring something the graph uses are worth their tokens. Files with nothing indexable
+    // can't be judged and are always sent, as is everything when the message names no symbols
+    TSet<FString> GraphSymbols;
+    if (Settings->bFilterReferenceSourceFiles || Settings->bRetrieveReferenceChunks)
+    {
+        CollectGraphSymbols(UserMessage, GraphSymbols);
+    }
+
+    // With retrieval, the best matching chunks replace whole files once the index is up to date
+    if (Settings->bRetrieveReferenceChunks && GraphSymbols.Num() > 0)
+    {
+        FString Chunks;
+        if (FN2CReferenceIndex::Get().Retrieve(Store.ReferenceFilePaths, Generation, GraphSymbols,
+            Settings->MaxReferenceChunks, Settings->ReferenceChunkTokenBudget, Settings->Provider, Chunks))
+        {
+            if (!Chunks.IsEmpty())
+            {
+                OutBlock = FString::Printf(TEXT("<referenceSourceFiles>\n%s\n</referenceSourceFiles>"), *Chunks);
+            }
+            return Store.bReferenceFilesComplete;
+        }
+
+        FN2CLogger::Get().Log(TEXT("Reference index is not ready, sending reference files"), EN2CLogSeverity::Debug, TEXT("SystemPromptManager"));
+    }
+
+    FString ReferenceFiles;
+    int32 NumIncluded = 0;
+    for (const FReferenceFile& File : Store.ReferenceFiles)
+    {
+        const bool bRelevant = GraphSymbols.Num() == 0 || File.Symbols.Num() == 0
+            || Algo::AnyOf(GraphSymbols, [&File](const FString& Symbol) { return File.Symbols.Contains(Symbol); });
+        if (!bRelevant)
+        {
+            continue;
+        }
+
+        if (!ReferenceFiles.IsEmpty())
+        {
+            ReferenceFiles += TEXT("\n\n");
+        }
+        ReferenceFiles += File.Formatted;
+        ++NumIncluded;
+    }
+
+    if (NumIncluded < Store.ReferenceFiles.Num())
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Including %d of %d reference source files relevant to the graph"), NumIncluded, Store.ReferenceFiles.Num()),
+            EN2CLogSeverity::Debug, TEXT("SystemPromptManager"));
+    }
+
+    if (!ReferenceFiles.IsEmpty())
+    {
+        OutBlock = FString::Printf(TEXT("<referenceSourceFiles>\n%s\n</referenceSourceFiles>"), *ReferenceFiles);
+    }
+
+    return Store.bReferenceFilesComplete;
 }
 
 FString UN2CSystemPromptManager::GetLanguageSpecificPrompt(const FString& BasePromptKey, EN2CCodeLanguage Language) const
 {
     const FString LanguageKey = GetLanguagePromptKey(BasePromptKey, Language);
-    if (const FString* Prompt = LoadedPrompts.Find(LanguageKey))
+    FString Prompt;
+    if (FindPrompt(LanguageKey, Prompt))
     {
-        return *Prompt;
+        return Prompt;
     }
 
     // Fallback to base prompt if language-specific one not found
@@ -111,71 +408,31 @@ FString UN2CSystemPromptManager::GetLanguagePromptKey(const FString& BasePromptK
     }
 }
 
-void UN2CSystemPromptManager::LoadPrompts()
+FString UN2CSystemPromptManager::FindPromptsDirectory()
 {
     // Get plugin base directory using plugin manager
     TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("NodeToCode"));
     if (!Plugin.IsValid())
     {
         FN2CLogger::Get().LogError(TEXT("Could not find NodeToCode plugin! Translation will likely fail!"));
-        return;
+        return FString();
     }
 
-    // Set prompts directory relative to plugin base
-    PromptsDirectory = FPaths::Combine(Plugin->GetContentDir(), TEXT("Prompting"));
+    // Prompts directory relative to plugin base
+    const FString PromptsDirectory = FPaths::Combine(Plugin->GetContentDir(), TEXT("Prompting"));
     
     if (!FPaths::DirectoryExists(PromptsDirectory))
     {
         FN2CLogger::Get().LogError(TEXT("Could not find NodeToCode Docs/Prompting directory! Translation will likely fail!"));
     }
-
-    // Base prompts
-    TArray<FString> BasePromptFiles;
-    BasePromptFiles.Add(TEXT("CodeGen"));
-
-    // Languages to load prompts for
-    TArray<EN2CCodeLanguage> Languages;
-    Languages.Add(EN2CCodeLanguage::Cpp);
-    Languages.Add(EN2CCodeLanguage::Python);
-    Languages.Add(EN2CCodeLanguage::JavaScript);
-    Languages.Add(EN2CCodeLanguage::CSharp);
-    Languages.Add(EN2CCodeLanguage::Swift);
-    Languages.Add(EN2CCodeLanguage::Pseudocode);
-
-    // Load base and language-specific prompts
-    for (const FString& PromptKey : BasePromptFiles)
-    {
-        // Load base prompt
-        FString PromptContent;
-        if (LoadPromptFromFile(GetPromptFilePath(PromptKey), PromptContent))
-        {
-            LoadedPrompts.Add(PromptKey, PromptContent);
-        }
-
-        // Load language-specific prompts
-        for (EN2CCodeLanguage Language : Languages)
-        {
-            const FString LanguageKey = GetLanguagePromptKey(PromptKey, Language);
-            if (LoadPromptFromFile(GetPromptFilePath(LanguageKey), PromptContent))
-            {
-                LoadedPrompts.Add(LanguageKey, PromptContent);
-            }
-        }
-    }
-
-    if (LoadedPrompts.Num() == 0)
-    {
-        FN2CLogger::Get().LogError(TEXT("Failed to load any CodeGen system prompt files from Docs/Prompting. Translation will fail!"), TEXT("SystemPromptManager"));
-        LoadedPrompts.Add(TEXT("CodeGen"), TEXT("You are an expert developer specializing in Unreal Engine Blueprint to code conversion."));
-    }
-    
+    return PromptsDirectory;
 }
 
-bool UN2CSystemPromptManager::LoadPromptFromFile(const FString& FilePath, FString& OutContent)
+bool UN2CSystemPromptManager::LoadPromptFromFile(const FString& FilePath, FString& OutContent) const
 {
     if (FPaths::FileExists(FilePath))
     {
-        if (FFileHelper::LoadFileToString(OutContent, *FilePath))
+        if (FN2CPromptFileCache::Get().LoadFile(FilePath, OutContent))
         {
             // Clean up any Windows line endings
             OutContent.ReplaceInline(TEXT("\r\n"), TEXT("\n"));
@@ -190,11 +447,6 @@ bool UN2CSystemPromptManager::LoadPromptFromFile(const FString& FilePath, FStrin
     return false;
 }
 
-FString UN2CSystemPromptManager::GetPromptFilePath(const FString& PromptKey) const
-{
-    return FPaths::Combine(PromptsDirectory, PromptKey + TEXT(".md"));
-}
-
 FString UN2CSystemPromptManager::LoadReferenceSourceFiles() const
 {
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
@@ -206,14 +458,13 @@ FString UN2CSystemPromptManager::LoadReferenceSourceFiles() const
     FString Result;
     for (const FFilePath& FilePath : Settings->ReferenceSourceFilePaths)
     {
-        FString Content;
-        if (FFileHelper::LoadFileToString(Content, *FilePath.FilePath))
+        if (const TSharedPtr<const FString> Content = FN2CPromptFileCache::Get().LoadShared(FilePath.FilePath))
         {
             if (!Result.IsEmpty())
             {
                 Result += TEXT("\n\n");
             }
-            Result += FormatSourceFileContent(FilePath.FilePath, Content);
+            Result += FormatSourceFileContent(FilePath.FilePath, *Content);
         }
         else
         {
@@ -231,10 +482,14 @@ FString UN2CSystemPromptManager::FormatSourceFileContent(const FString& FilePath
 {
     // Extract filename from path
     FString Filename = FPaths::GetCleanFilename(FilePath);
-    
-    return FString::Printf(
-        TEXT("File: %s\n```\n%s\n```"),
-        *Filename,
-        *Content
-    );
+
+    // Appended into one allocation; Printf would format large generated headers into growing buffers
+    FString Result;
+    Result.Reserve(Filename.Len() + Content.Len() + 16);
+    Result += TEXT("File: ");
+    Result += Filename;
+    Result += TEXT("\n```\n");
+    Result += Content;
+    Result += TEXT("\n```");
+    return Result;
 }
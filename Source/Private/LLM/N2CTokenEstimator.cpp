@@ -0,0 +1,194 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CTokenEstimator.h"
+#include "Core/N2CSettings.h"
+
+namespace
+{
+    /** How a tokenizer family splits each kind of run */
+    struct FTokenizerRatios
+    {
+        /** Letters per token within a single camel-case segment */
+        float LettersPerToken;
+
+        /** Digits per token in a number */
+        float DigitsPerToken;
+
+        /** Punctuation characters per token in a run such as "\":[{\"" */
+        float SymbolsPerToken;
+    };
+
+    const FTokenizerRatios& GetRatios(EN2CTokenizerFamily Family)
+    {
+        static const FTokenizerRatios OpenAIRatios = { 6.0f, 3.0f, 2.0f };
+        static const FTokenizerRatios AnthropicRatios = { 5.0f, 3.0f, 1.6f };
+        static const FTokenizerRatios GeminiRatios = { 6.0f, 1.0f, 2.0f };
+        static const FTokenizerRatios LlamaRatios = { 5.0f, 3.0f, 1.8f };
+
+        switch (Family)
+        {
+            case EN2CTokenizerFamily::Anthropic: return AnthropicRatios;
+            case EN2CTokenizerFamily::Gemini: return GeminiRatios;
+            case EN2CTokenizerFamily::Llama: return LlamaRatios;
+            default: return OpenAIRatios;
+        }
+    }
+
+    /** Response tokens per input token of graph JSON. Each node's JSON carries far more than the code it becomes */
+    constexpr float OutputTokensPerJsonToken = 0.6f;
+
+    /** Response budgets are rounded up to this, so similar graphs send identical request parameters */
+    constexpr int32 OutputBudgetGranularity = 512;
+
+    bool IsAsciiLetter(TCHAR Char)
+    {
+        return (Char >= TEXT('a') && Char <= TEXT('z')) || (Char >= TEXT('A') && Char <= TEXT('Z'));
+    }
+
+    bool IsAsciiDigit(TCHAR Char)
+    {
+        return Char >= TEXT('0') && Char <= TEXT('9');
+    }
+
+    bool IsUpper(TCHAR Char)
+    {
+        return Char >= TEXT('A') && Char <= TEXT('Z');
+    }
+
+    bool IsWhitespace(TCHAR Char)
+    {
+        return Char == TEXT(' ') || Char == TEXT('\t') || Char == TEXT('\n') || Char == TEXT('\r');
+    }
+}
+
+EN2CTokenizerFamily FN2CTokenEstimator::GetFamily(EN2CLLMProvider Provider)
+{
+    switch (Provider)
+    {
+        case EN2CLLMProvider::Anthropic: return EN2CTokenizerFamily::Anthropic;
+        case EN2CLLMProvider::Gemini: return EN2CTokenizerFamily::Gemini;
+        case EN2CLLMProvider::Ollama:
+        case EN2CLLMProvider::LMStudio:
+        case EN2CLLMProvider::OpenAICompatible: return EN2CTokenizerFamily::Llama;
+        default: return EN2CTokenizerFamily::OpenAI;
+    }
+}
+
+int32 FN2CTokenEstimator::EstimateTokens(FStringView Text, EN2CTokenizerFamily Family)
+{
+    const FTokenizerRatios& Ratios = GetRatios(Family);
+
+    float Tokens = 0.0f;
+    const TCHAR* Chars = Text.GetData();
+    const int32 Len = Text.Len();
+
+    int32 Index = 0;
+    while (Index < Len)
+    {
+        const TCHAR Char = Chars[Index];
+        const int32 Start = Index;
+
+        if (IsAsciiLetter(Char))
+        {
+            // Split identifiers like K2_SetActorLocation into segments at lower-to-upper transitions
+            ++Index;
+            while (Index < Len && IsAsciiLetter(Chars[Index]) && !(IsUpper(Chars[Index]) && !IsUpper(Chars[Index - 1])))
+            {
+                ++Index;
+            }
+            Tokens += FMath::CeilToFloat((Index - Start) / Ratios.LettersPerToken);
+        }
+        else if (IsAsciiDigit(Char))
+        {
+            while (Index < Len && IsAsciiDigit(Chars[Index]))
+            {
+                ++Index;
+            }
+            Tokens += FMath::CeilToFloat((Index - Start) / Ratios.DigitsPerToken);
+        }
+        else if (IsWhitespace(Char))
+        {
+            while (Index < Len && IsWhitespace(Chars[Index]))
+            {
+                ++Index;
+            }
+
+            // A single space merges into the next word, longer runs (indentation) cost a token of their own
+            if (Index - Start > 1 || Index == Len || !IsAsciiLetter(Chars[Index]))
+            {
+                Tokens += 1.0f;
+            }
+        }
+        else if (Char < 128)
+        {
+            while (Index < Len && Chars[Index] < 128 && !IsAsciiLetter(Chars[Index]) && !IsAsciiDigit(Chars[Index]) && !IsWhitespace(Chars[Index]))
+            {
+                ++Index;
+            }
+            Tokens += FMath::CeilToFloat((Index - Start) / Ratios.SymbolsPerToken);
+        }
+        else
+        {
+            // Non-ASCII text rarely merges across characters
+            ++Index;
+            Tokens += 1.0f;
+        }
+    }
+
+    return FMath::CeilToInt(Tokens);
+}
+
+int32 FN2CTokenEstimator::GetContextWindow(EN2CLLMProvider Provider, const FString& Model, int32 LocalContextWindow)
+{
+    switch (Provider)
+    {
+        case EN2CLLMProvider::OpenAI:
+            if (Model.StartsWith(TEXT("gpt-4.1")))
+            {
+                return 1047576;
+            }
+            if (Model.StartsWith(TEXT("o1-preview")) || Model.StartsWith(TEXT("o1-mini")) || Model.StartsWith(TEXT("gpt-4o")))
+            {
+                return 128000;
+            }
+            return 200000;
+
+        case EN2CLLMProvider::Anthropic:
+            return 200000;
+
+        case EN2CLLMProvider::Gemini:
+            return Model.StartsWith(TEXT("gemini-1.5-pro")) || Model.StartsWith(TEXT("gemini-2.0-pro")) ? 2097152 : 1048576;
+
+        case EN2CLLMProvider::DeepSeek:
+            return 65536;
+
+        case EN2CLLMProvider::Ollama:
+        case EN2CLLMProvider::LMStudio:
+        case EN2CLLMProvider::OpenAICompatible:
+            return FMath::Max(0, LocalContextWindow);
+
+        default:
+            return 0;
+    }
+}
+
+int32 FN2CTokenEstimator::GetContextWindow(const UN2CSettings& Settings)
+{
+    // LM Studio does not report its loaded context length, so it stays unknown
+    const int32 LocalContextWindow = Settings.Provider == EN2CLLMProvider::Ollama ? Settings.OllamaConfig.GetMaxContextWindow()
+        : Settings.Provider == EN2CLLMProvider::OpenAICompatible ? Settings.OpenAICompatibleContextWindow : 0;
+    return GetContextWindow(Settings.Provider, Settings.GetActiveModel(), LocalContextWindow);
+}
+
+int32 FN2CTokenEstimator::GetInputBudget(int32 ContextWindow)
+{
+    // Small local windows would be used up entirely by a fixed reserve
+    return ContextWindow - FMath::Min(OutputTokenReserve, ContextWindow / 4);
+}
+
+int32 FN2CTokenEstimator::GetOutputBudget(int32 JsonTokens, int32 Ceiling)
+{
+    const int32 Expected = MinOutputTokens + FMath::CeilToInt(JsonTokens * OutputTokensPerJsonToken);
+    const int32 Rounded = FMath::DivideAndRoundUp(Expected, OutputBudgetGranularity) * OutputBudgetGranularity;
+    return FMath::Clamp(Rounded, FMath::Min(MinOutputTokens, Ceiling), Ceiling);
+}
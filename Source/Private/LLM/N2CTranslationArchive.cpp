@@ -0,0 +1,316 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CTranslationArchive.h"
+
+#include "Utils/N2CLogger.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** "N2CA" */
+    constexpr uint32 ArchiveMagic = 0x4143324E;
+
+    /** Bump whenever the archive layout changes */
+    constexpr uint32 ArchiveVersion = 1;
+
+    /** Folders between a translation folder and its deepest files (Root/RelativeDir/Graph/File) */
+    constexpr int32 MaxFolderDepth = 4;
+
+    /** A file in the archive. Stored uncompressed when compressing would not make it smaller */
+    struct FEntry
+    {
+        FString RelativePath;
+        int64 Offset = 0;
+        int32 StoredSize = 0;
+        int32 RawSize = 0;
+    };
+
+    FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+    {
+        return Ar << Entry.RelativePath << Entry.Offset << Entry.StoredSize << Entry.RawSize;
+    }
+
+    struct FTableOfContents
+    {
+        FString ArchivePath;
+        FName Format;
+        int64 Size = 0;
+        FDateTime TimeStamp;
+        TMap<FString, FEntry> Entries;
+    };
+
+    FCriticalSection CacheLock;
+    TMap<FString, TSharedPtr<const FTableOfContents>> CachedTables;
+
+    FName GetCompressionFormat()
+    {
+        return FCompression::IsFormatValid(NAME_Oodle) ? NAME_Oodle : NAME_Zlib;
+    }
+
+    /** Table of contents of the archive at ArchivePath, read again only if the file changed. Null if there is none */
+    TSharedPtr<const FTableOfContents> LoadTableOfContents(const FString& ArchivePath)
+    {
+        const FFileStatData StatData = IFileManager::Get().GetStatData(*ArchivePath);
+        if (!StatData.bIsValid || StatData.bIsDirectory)
+        {
+            return nullptr;
+        }
+
+        {
+            FScopeLock ScopeLock(&CacheLock);
+            const TSharedPtr<const FTableOfContents>* Cached = CachedTables.Find(ArchivePath);
+            if (Cached && (*Cached)->Size == StatData.FileSize && (*Cached)->TimeStamp == StatData.ModificationTime)
+            {
+                return *Cached;
+            }
+        }
+
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*ArchivePath, FILEREAD_Silent));
+        if (!Reader)
+        {
+            return nullptr;
+        }
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        FString FormatName;
+        int64 TableOffset = 0;
+        *Reader << Magic << Version;
+        if (Reader->IsError() || Magic != ArchiveMagic || Version != ArchiveVersion)
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Unsupported translation archive: %s"), *ArchivePath), TEXT("TranslationArchive"));
+            return nullptr;
+        }
+        *Reader << FormatName << TableOffset;
+
+        TArray<FEntry> Entries;
+        Reader->Seek(TableOffset);
+        *Reader << Entries;
+        if (Reader->IsError())
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Truncated translation archive: %s"), *ArchivePath), TEXT("TranslationArchive"));
+            return nullptr;
+        }
+
+        TSharedPtr<FTableOfContents> Table = MakeShared<FTableOfContents>();
+        Table->ArchivePath = ArchivePath;
+        Table->Format = FName(*FormatName);
+        Table->Size = StatData.FileSize;
+        Table->TimeStamp = StatData.ModificationTime;
+        for (FEntry& Entry : Entries)
+        {
+            const FString RelativePath = Entry.RelativePath;
+            Table->Entries.Add(RelativePath, MoveTemp(Entry));
+        }
+
+        FScopeLock ScopeLock(&CacheLock);
+        CachedTables.Add(ArchivePath, Table);
+        return Table;
+    }
+
+    /** Read and decompress one file of an archive, seeking straight to it */
+    bool Extract(const FTableOfContents& Table, const FEntry& Entry, TArray<uint8>& OutBytes)
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Table.ArchivePath, FILEREAD_Silent));
+        if (!Reader)
+        {
+            return false;
+        }
+
+        TArray<uint8> Stored;
+        Stored.SetNumUninitialized(Entry.StoredSize);
+        Reader->Seek(Entry.Offset);
+        Reader->Serialize(Stored.GetData(), Stored.Num());
+        if (Reader->IsError())
+        {
+            return false;
+        }
+
+        if (Entry.StoredSize == Entry.RawSize)
+        {
+            OutBytes = MoveTemp(Stored);
+            return true;
+        }
+
+        OutBytes.SetNumUninitialized(Entry.RawSize);
+        return FCompression::UncompressMemory(Table.Format, OutBytes.GetData(), Entry.RawSize, Stored.GetData(), Entry.StoredSize);
+    }
+
+    /** Compress a file onto the end of Writer and add its entry */
+    void AddEntry(FArchive& Writer, FName Format, const FString& RelativePath, TArray<uint8>& Bytes, TArray<FEntry>& OutEntries)
+    {
+        FEntry& Entry = OutEntries.AddDefaulted_GetRef();
+        Entry.RelativePath = RelativePath;
+        Entry.Offset = Writer.Tell();
+        Entry.RawSize = Bytes.Num();
+
+        int32 CompressedSize = FCompression::CompressMemoryBound(Format, Bytes.Num());
+        TArray<uint8> Compressed;
+        Compressed.SetNumUninitialized(CompressedSize);
+        if (FCompression::CompressMemory(Format, Compressed.GetData(), CompressedSize, Bytes.GetData(), Bytes.Num())
+            && CompressedSize < Bytes.Num())
+        {
+            Entry.StoredSize = CompressedSize;
+            Writer.Serialize(Compressed.GetData(), CompressedSize);
+        }
+        else
+        {
+            Entry.StoredSize = Bytes.Num();
+            Writer.Serialize(Bytes.GetData(), Bytes.Num());
+        }
+    }
+}
+
+bool FN2CTranslationArchive::Pack(const FString& RootPath, int32* OutPackedFiles)
+{
+    if (OutPackedFiles)
+    {
+        *OutPackedFiles = 0;
+    }
+
+    TArray<FString> SubDirectories;
+    IFileManager::Get().FindFiles(SubDirectories, *FPaths::Combine(RootPath, TEXT("*")), false, true);
+    TArray<FString> FilePaths;
+    for (const FString& SubDirectory : SubDirectories)
+    {
+        IFileManager::Get().FindFilesRecursive(FilePaths, *FPaths::Combine(RootPath, SubDirectory), TEXT("*"), true, false, false);
+    }
+    if (FilePaths.Num() == 0)
+    {
+        return true;
+    }
+
+    const FString ArchivePath = FPaths::Combine(RootPath, GetFileName());
+    const TSharedPtr<const FTableOfContents> Existing = LoadTableOfContents(ArchivePath);
+    const FName Format = GetCompressionFormat();
+
+    TArray<uint8> ArchiveBytes;
+    FMemoryWriter Writer(ArchiveBytes, true);
+    uint32 Magic = ArchiveMagic;
+    uint32 Version = ArchiveVersion;
+    FString FormatName = Format.ToString();
+    Writer << Magic << Version << FormatName;
+    const int64 TableOffsetPosition = Writer.Tell();
+    int64 TableOffset = 0;
+    Writer << TableOffset;
+
+    TArray<FEntry> Entries;
+    TSet<FString> Packed;
+    for (const FString& FilePath : FilePaths)
+    {
+        // Leftovers of an interrupted write are not output
+        if (FilePath.EndsWith(TEXT(".tmp")))
+        {
+            continue;
+        }
+
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to read file to archive: %s"), *FilePath), TEXT("TranslationArchive"));
+            return false;
+        }
+
+        const FString RelativePath = FilePath.RightChop(RootPath.Len() + 1);
+        AddEntry(Writer, Format, RelativePath, Bytes, Entries);
+        Packed.Add(RelativePath);
+    }
+
+    // Files packed when the batch ended before, unless they were written again since
+    if (Existing)
+    {
+        for (const TPair<FString, FEntry>& Pair : Existing->Entries)
+        {
+            TArray<uint8> Bytes;
+            if (!Packed.Contains(Pair.Key) && Extract(*Existing, Pair.Value, Bytes))
+            {
+                AddEntry(Writer, Format, Pair.Key, Bytes, Entries);
+            }
+        }
+    }
+
+    TableOffset = Writer.Tell();
+    Writer << Entries;
+    Writer.Seek(TableOffsetPosition);
+    Writer << TableOffset;
+
+    // Replaced through a temporary file like other output, and the loose files only removed once it is in place
+    const FString TempPath = ArchivePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(ArchiveBytes, *TempPath) || !IFileManager::Get().Move(*ArchivePath, *TempPath, true, true))
+    {
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save translation archive: %s"), *ArchivePath), TEXT("TranslationArchive"));
+        return false;
+    }
+
+    for (const FString& SubDirectory : SubDirectories)
+    {
+        IFileManager::Get().DeleteDirectory(*FPaths::Combine(RootPath, SubDirectory), false, true);
+    }
+
+    {
+        FScopeLock ScopeLock(&CacheLock);
+        CachedTables.Remove(ArchivePath);
+    }
+
+    if (OutPackedFiles)
+    {
+        *OutPackedFiles = Entries.Num();
+    }
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Archived %d translation files into %s (%lld bytes)"), Entries.Num(), *ArchivePath, static_cast<long long>(ArchiveBytes.Num())),
+        EN2CLogSeverity::Debug, TEXT("TranslationArchive"));
+    return true;
+}
+
+bool FN2CTranslationArchive::LoadFileToString(FString& OutContent, const FString& FilePath)
+{
+    if (FFileHelper::LoadFileToString(OutContent, *FilePath, FFileHelper::EHashOptions::None, FILEREAD_Silent))
+    {
+        return true;
+    }
+
+    // The translation folder is the first parent holding an archive
+    FString NormalizedPath = FilePath;
+    FPaths::NormalizeFilename(NormalizedPath);
+    FString RootPath = FPaths::GetPath(NormalizedPath);
+    for (int32 Depth = 0; Depth < MaxFolderDepth; ++Depth)
+    {
+        RootPath = FPaths::GetPath(RootPath);
+        if (RootPath.IsEmpty())
+        {
+            break;
+        }
+
+        const TSharedPtr<const FTableOfContents> Table = LoadTableOfContents(FPaths::Combine(RootPath, GetFileName()));
+        if (!Table)
+        {
+            continue;
+        }
+
+        TArray<uint8> Bytes;
+        const FEntry* Entry = Table->Entries.Find(NormalizedPath.RightChop(RootPath.Len() + 1));
+        if (!Entry || !Extract(*Table, *Entry, Bytes))
+        {
+            return false;
+        }
+        FFileHelper::BufferToString(OutContent, Bytes.GetData(), Bytes.Num());
+        return true;
+    }
+    return false;
+}
+
+void FN2CTranslationArchive::GetArchivedFiles(const FString& RootPath, TArray<FString>& OutRelativePaths)
+{
+    FString NormalizedPath = RootPath;
+    FPaths::NormalizeDirectoryName(NormalizedPath);
+    if (const TSharedPtr<const FTableOfContents> Table = LoadTableOfContents(FPaths::Combine(NormalizedPath, GetFileName())))
+    {
+        Table->Entries.GenerateKeyArray(OutRelativePaths);
+    }
+}
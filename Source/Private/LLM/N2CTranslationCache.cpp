@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CTranslationCache.h"
+
+#include "Async/Async.h"
+#include "Core/N2CSettings.h"
+#include "DerivedDataCache.h"
+#include "DerivedDataRequestOwner.h"
+#include "DerivedDataValue.h"
+#include "IO/IoHash.h"
+#include "LLM/N2CPromptFileCache.h"
+#include "Memory/SharedBuffer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Bump to orphan every shared entry when the response format changes */
+    const TCHAR* SharedBucketName = TEXT("NodeToCodeTranslationV1");
+
+    bool IsSharingEnabled()
+    {
+        const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+        return Settings && Settings->bUseTranslationCache && Settings->bShareTranslationCache;
+    }
+
+    UE::DerivedData::FCacheKey MakeSharedKey(const FString& Key)
+    {
+        static const UE::DerivedData::FCacheBucket Bucket(SharedBucketName);
+        const FTCHARToUTF8 Utf8(*Key);
+        return UE::DerivedData::FCacheKey{ Bucket, FIoHash::HashBuffer(Utf8.Get(), Utf8.Length()) };
+    }
+
+    /** Name the DDC reports a request under */
+    UE::FSharedString MakeSharedName(const FString& Key)
+    {
+        return UE::FSharedString(TEXT("NodeToCode/") + Key);
+    }
+}
+
+FN2CTranslationCache& FN2CTranslationCache::Get()
+{
+    static FN2CTranslationCache Instance;
+    return Instance;
+}
+
+FString FN2CTranslationCache::MakeKey(
+    const FString& JsonInput,
+    const FString& SystemPrompt,
+    EN2CCodeLanguage Language,
+    EN2CLLMProvider Provider,
+    const FString& Model) const
+{
+    FSHA1 Hasher;
+
+    auto HashString = [&Hasher](const FString& Value)
+    {
+        const FTCHARToUTF8 Utf8(*Value);
+        Hasher.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+        // Separator so adjacent fields can't run together
+        const uint8 Separator = 0;
+        Hasher.Update(&Separator, 1);
+    };
+
+    HashString(JsonInput);
+    HashString(SystemPrompt);
+    HashString(UEnum::GetValueAsString(Language));
+    HashString(UEnum::GetValueAsString(Provider));
+    HashString(Model);
+
+    // Reference files are prepended to the user message, so they are part of the request too. Their names and
+    // contents, unlike their paths and time stamps, are the same on every machine sharing the cache
+    if (const UN2CSettings* Settings = GetDefault<UN2CSettings>())
+    {
+        for (const FFilePath& FilePath : Settings->ReferenceSourceFilePaths)
+        {
+            const TSharedPtr<const FString> Content = FN2CPromptFileCache::Get().LoadShared(FilePath.FilePath);
+            HashString(FPaths::GetCleanFilename(FilePath.FilePath));
+            HashString(Content.IsValid() ? *Content : FString());
+        }
+    }
+
+    Hasher.Final();
+
+    uint8 Digest[FSHA1::DigestSize];
+    Hasher.GetHash(Digest);
+    return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+bool FN2CTranslationCache::Find(const FString& Key, FString& OutResponse)
+{
+    if (const FString* Cached = MemoryCache.Find(Key))
+    {
+        OutResponse = *Cached;
+        return true;
+    }
+
+    const FString EntryPath = GetEntryPath(Key);
+    if (!FPaths::FileExists(EntryPath))
+    {
+        return false;
+    }
+
+    if (!FFileHelper::LoadFileToString(OutResponse, *EntryPath))
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Failed to read translation cache entry: %s"), *EntryPath),
+            TEXT("TranslationCache"));
+        return false;
+    }
+
+    MemoryCache.Add(Key, OutResponse);
+    return true;
+}
+
+bool FN2CTranslationCache::Contains(const FString& Key) const
+{
+    return MemoryCache.Contains(Key) || FPaths::FileExists(GetEntryPath(Key));
+}
+
+void FN2CTranslationCache::FindShared(const TArray<FString>& Keys, TFunction<void(int32 HitIndex, const FString& Response)> OnComplete)
+{
+    using namespace UE::DerivedData;
+
+    if (Keys.Num() == 0)
+    {
+        OnComplete(INDEX_NONE, FString());
+        return;
+    }
+
+    TArray<FCacheGetValueRequest> Requests;
+    Requests.Reserve(Keys.Num());
+    for (int32 Index = 0; Index < Keys.Num(); ++Index)
+    {
+        FCacheGetValueRequest& Request = Requests.AddDefaulted_GetRef();
+        Request.Name = MakeSharedName(Keys[Index]);
+        Request.Key = MakeSharedKey(Keys[Index]);
+        Request.UserData = Index;
+    }
+
+    // Responses arrive on DDC worker threads, one per key, in any order; the first key in routing order wins
+    struct FLookup
+    {
+        FCriticalSection Lock;
+        int32 Pending = 0;
+        int32 HitIndex = INDEX_NONE;
+        FString Response;
+    };
+    TSharedRef<FLookup> Lookup = MakeShared<FLookup>();
+    Lookup->Pending = Keys.Num();
+
+    FRequestOwner Owner(EPriority::Normal);
+    GetCache().GetValue(Requests, Owner, [this, Lookup, Keys, OnComplete = MoveTemp(OnComplete)](FCacheGetValueResponse&& Response)
+    {
+        const int32 Index = static_cast<int32>(Response.UserData);
+        FString Text;
+        if (Response.Status == EStatus::Ok)
+        {
+            const FSharedBuffer Data = Response.Value.GetData().Decompress();
+            const FUTF8ToTCHAR Converted(static_cast<const ANSICHAR*>(Data.GetData()), static_cast<int32>(Data.GetSize()));
+            Text = FString(Converted.Length(), Converted.Get());
+        }
+
+        FScopeLock ScopeLock(&Lookup->Lock);
+        if (!Text.IsEmpty() && (Lookup->HitIndex == INDEX_NONE || Index < Lookup->HitIndex))
+        {
+            Lookup->HitIndex = Index;
+            Lookup->Response = MoveTemp(Text);
+        }
+        if (--Lookup->Pending > 0)
+        {
+            return;
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [this, Lookup, Keys, OnComplete]()
+        {
+            if (Lookup->HitIndex != INDEX_NONE)
+            {
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Shared translation cache hit: %s"), *Keys[Lookup->HitIndex]),
+                    EN2CLogSeverity::Info, TEXT("TranslationCache"));
+                StoreLocal(Keys[Lookup->HitIndex], Lookup->Response);
+            }
+            OnComplete(Lookup->HitIndex, Lookup->Response);
+        });
+    });
+
+    // The lookup finishes on its own after the owner goes out of scope
+    Owner.KeepAlive();
+}
+
+void FN2CTranslationCache::Store(const FString& Key, const FString& Response)
+{
+    StoreLocal(Key, Response);
+
+    if (IsSharingEnabled())
+    {
+        using namespace UE::DerivedData;
+
+        const FTCHARToUTF8 Utf8(*Response, Response.Len());
+        FCachePutValueRequest Request;
+        Request.Name = MakeSharedName(Key);
+        Request.Key = MakeSharedKey(Key);
+        Request.Value = FValue::Compress(FSharedBuffer::Clone(Utf8.Get(), Utf8.Length()));
+
+        FRequestOwner Owner(EPriority::Low);
+        GetCache().PutValue({ Request }, Owner);
+        Owner.KeepAlive();
+    }
+}
+
+void FN2CTranslationCache::StoreLocal(const FString& Key, const FString& Response)
+{
+    MemoryCache.Add(Key, Response);
+
+    const FString EntryPath = GetEntryPath(Key);
+    if (!FFileHelper::SaveStringToFile(Response, *EntryPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Failed to write translation cache entry: %s"), *EntryPath),
+            TEXT("TranslationCache"));
+        return;
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Stored translation cache entry: %s"), *Key),
+        EN2CLogSeverity::Debug, TEXT("TranslationCache"));
+}
+
+void FN2CTranslationCache::Clear()
+{
+    MemoryCache.Empty();
+
+    const FString CacheDir = GetCacheDirectory();
+    if (FPaths::DirectoryExists(CacheDir))
+    {
+        IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+    }
+
+    FN2CLogger::Get().Log(TEXT("Translation cache cleared"), EN2CLogSeverity::Info, TEXT("TranslationCache"));
+}
+
+FString FN2CTranslationCache::GetCacheDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Cache");
+}
+
+FString FN2CTranslationCache::GetEntryPath(const FString& Key)
+{
+    return GetCacheDirectory() / (Key + TEXT(".json"));
+}
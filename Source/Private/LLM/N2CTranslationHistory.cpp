@@ -0,0 +1,345 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CTranslationHistory.h"
+
+#include "Utils/N2CLogger.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    /** Bumped whenever the saved layout changes, so older indexes are built again from disk */
+    constexpr int32 IndexVersion = 1;
+
+    /** Folder names end in _YYYY-mm-dd-HH.MM.SS (see UN2CLLMModule::GenerateTranslationRootPath) */
+    constexpr int32 TimestampLength = 19;
+
+    /** Split a translation folder name into its Blueprint name and time. False if it is not one */
+    bool ParseFolderName(const FString& FolderName, FString& OutBlueprintName, FDateTime& OutTime)
+    {
+        const int32 Separator = FolderName.Len() - TimestampLength - 1;
+        if (Separator < 1 || FolderName[Separator] != TEXT('_'))
+        {
+            return false;
+        }
+
+        // FDateTime::Parse reads the date with dots rather than dashes
+        FString Timestamp = FolderName.RightChop(Separator + 1);
+        Timestamp[4] = TEXT('.');
+        Timestamp[7] = TEXT('.');
+        if (!FDateTime::Parse(Timestamp, OutTime))
+        {
+            return false;
+        }
+
+        OutBlueprintName = FolderName.Left(Separator);
+        return true;
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FN2CTranslationOutput& Output)
+{
+    return Ar << Output.Language << Output.RelativeDir << Output.FileBaseName;
+}
+
+FArchive& operator<<(FArchive& Ar, FN2CTranslationRecord& Record)
+{
+    return Ar << Record.GraphName << Record.Fingerprint << Record.Provider << Record.Model << Record.Time
+        << Record.InputTokens << Record.OutputTokens << Record.Outputs;
+}
+
+FArchive& operator<<(FArchive& Ar, FN2CTranslationRun& Run)
+{
+    return Ar << Run.RootPath << Run.BlueprintName << Run.Time << Run.bEnded << Run.bIndexedFromDisk << Run.Graphs;
+}
+
+const FN2CTranslationOutput* FN2CTranslationRecord::FindOutput(EN2CCodeLanguage Language) const
+{
+    return Outputs.FindByPredicate([Language](const FN2CTranslationOutput& Output) { return Output.Language == Language; });
+}
+
+FN2CTranslationHistory& FN2CTranslationHistory::Get()
+{
+    static FN2CTranslationHistory Instance;
+    return Instance;
+}
+
+void FN2CTranslationHistory::Open(const FString& InBasePath)
+{
+    if (InBasePath == BasePath)
+    {
+        return;
+    }
+
+    // Runs of the previous base path are kept in its own index
+    Flush();
+    BasePath = InBasePath;
+    Runs.Reset();
+    RunsByBlueprint.Reset();
+
+    TArray<uint8> Bytes;
+    bool bLoaded = false;
+    if (FFileHelper::LoadFileToArray(Bytes, *FPaths::Combine(BasePath, GetIndexFileName()), FILEREAD_Silent))
+    {
+        FMemoryReader Reader(Bytes);
+        int32 Version = 0;
+        Reader << Version;
+        if (Version == IndexVersion)
+        {
+            TArray<FN2CTranslationRun> SavedRuns;
+            Reader << SavedRuns;
+            if (!Reader.IsError())
+            {
+                for (FN2CTranslationRun& Run : SavedRuns)
+                {
+                    const FString RootPath = Run.RootPath;
+                    Runs.Add(RootPath, MoveTemp(Run));
+                }
+                bLoaded = true;
+            }
+        }
+    }
+
+    if (!bLoaded)
+    {
+        Runs.Reset();
+        BuildFromDisk();
+        bDirty = true;
+        Save();
+    }
+
+    for (const TPair<FString, FN2CTranslationRun>& Pair : Runs)
+    {
+        RunsByBlueprint.FindOrAdd(Pair.Value.BlueprintName).Add(Pair.Key);
+    }
+    for (TPair<FString, TArray<FString>>& Pair : RunsByBlueprint)
+    {
+        Pair.Value.Sort([this](const FString& A, const FString& B) { return Runs[A].Time > Runs[B].Time; });
+    }
+
+    FN2CLogger::Get().Log(
+        FString::Printf(TEXT("Translation history %s with %d translation folders"), bLoaded ? TEXT("loaded") : TEXT("built"), Runs.Num()),
+        EN2CLogSeverity::Debug, TEXT("TranslationHistory"));
+}
+
+void FN2CTranslationHistory::BuildFromDisk()
+{
+    TArray<FString> FolderNames;
+    IFileManager::Get().FindFiles(FolderNames, *FPaths::Combine(BasePath, TEXT("*")), false, true);
+    for (const FString& FolderName : FolderNames)
+    {
+        FN2CTranslationRun Run;
+        if (ParseFolderName(FolderName, Run.BlueprintName, Run.Time))
+        {
+            Run.RootPath = FPaths::Combine(BasePath, FolderName);
+            Run.bIndexedFromDisk = true;
+            const FString RootPath = Run.RootPath;
+            Runs.Add(RootPath, MoveTemp(Run));
+        }
+    }
+}
+
+void FN2CTranslationHistory::BeginRun(const FString& BlueprintName, const FString& RootPath)
+{
+    // Each language of a translation saves into the same folder
+    if (Runs.Contains(RootPath))
+    {
+        return;
+    }
+
+    FN2CTranslationRun Run;
+    Run.RootPath = RootPath;
+    Run.BlueprintName = BlueprintName;
+
+    // Ordered by the time in the folder name, like folders indexed from disk
+    FString FolderBlueprintName;
+    if (!ParseFolderName(FPaths::GetCleanFilename(RootPath), FolderBlueprintName, Run.Time))
+    {
+        Run.Time = FDateTime::Now();
+    }
+
+    TArray<FString>& BlueprintRuns = RunsByBlueprint.FindOrAdd(Run.BlueprintName);
+    const int32 Index = BlueprintRuns.IndexOfByPredicate([this, &Run](const FString& Other) { return Runs[Other].Time <= Run.Time; });
+    BlueprintRuns.Insert(RootPath, Index == INDEX_NONE ? BlueprintRuns.Num() : Index);
+    Runs.Add(RootPath, MoveTemp(Run));
+
+    // Saved straight away, so a batch that never ends is still found through its journal
+    bDirty = true;
+    Save();
+}
+
+void FN2CTranslationHistory::EndRun(const FString& RootPath)
+{
+    if (FN2CTranslationRun* Run = FindMutableRun(RootPath))
+    {
+        Run->bEnded = true;
+        bDirty = true;
+        Save();
+    }
+}
+
+void FN2CTranslationHistory::RecordOutput(const FString& RootPath, const FN2CTranslationRecord& Record)
+{
+    FN2CTranslationRun* Run = FindMutableRun(RootPath);
+    if (!Run || Record.GraphName.IsEmpty())
+    {
+        return;
+    }
+
+    FN2CTranslationRecord& Existing = Run->Graphs.FindOrAdd(Record.GraphName);
+    const FString Fingerprint = Existing.Fingerprint;
+    TArray<FN2CTranslationOutput> Outputs = MoveTemp(Existing.Outputs);
+    Existing = Record;
+    Existing.Fingerprint = Record.Fingerprint.IsEmpty() ? Fingerprint : Record.Fingerprint;
+    for (const FN2CTranslationOutput& Output : Record.Outputs)
+    {
+        Outputs.RemoveAll([&Output](const FN2CTranslationOutput& Other) { return Other.Language == Output.Language; });
+        Outputs.Add(Output);
+    }
+    Existing.Outputs = MoveTemp(Outputs);
+    bDirty = true;
+}
+
+void FN2CTranslationHistory::RecordFingerprint(const FString& RootPath, const FString& GraphName, const FString& Fingerprint)
+{
+    FN2CTranslationRun* Run = FindMutableRun(RootPath);
+    if (!Run || GraphName.IsEmpty())
+    {
+        return;
+    }
+
+    if (Fingerprint.IsEmpty())
+    {
+        if (FN2CTranslationRecord* Record = Run->Graphs.Find(GraphName))
+        {
+            Record->Fingerprint.Reset();
+        }
+    }
+    else
+    {
+        FN2CTranslationRecord& Record = Run->Graphs.FindOrAdd(GraphName);
+        Record.GraphName = GraphName;
+        Record.Fingerprint = Fingerprint;
+    }
+    bDirty = true;
+}
+
+void FN2CTranslationHistory::CarryForward(const FString& FromRootPath, const FString& ToRootPath, const TMap<FString, FString>& Fingerprints)
+{
+    const FN2CTranslationRun* From = FindMutableRun(FromRootPath);
+    FN2CTranslationRun* To = FindMutableRun(ToRootPath);
+    if (!To)
+    {
+        return;
+    }
+
+    for (const TPair<FString, FString>& Pair : Fingerprints)
+    {
+        FN2CTranslationRecord Record;
+        if (const FN2CTranslationRecord* Previous = From ? From->Graphs.Find(Pair.Key) : nullptr)
+        {
+            Record = *Previous;
+        }
+        Record.GraphName = Pair.Key;
+        Record.Fingerprint = Pair.Value;
+        To->Graphs.Add(Pair.Key, MoveTemp(Record));
+    }
+
+    // Graphs carried from a folder indexed from disk have no recorded outputs, so the folder is probed like its source
+    if (!From || From->bIndexedFromDisk)
+    {
+        To->bIndexedFromDisk = true;
+    }
+    bDirty = true;
+}
+
+TArray<const FN2CTranslationRun*> FN2CTranslationHistory::GetRuns(const FString& BlueprintName)
+{
+    TArray<const FN2CTranslationRun*> Result;
+    TArray<FString>* BlueprintRuns = RunsByBlueprint.Find(BlueprintName);
+    if (!BlueprintRuns)
+    {
+        return Result;
+    }
+
+    // A single stat per folder, rather than listing the base path
+    for (int32 Index = 0; Index < BlueprintRuns->Num();)
+    {
+        const FString& RootPath = (*BlueprintRuns)[Index];
+        if (!IFileManager::Get().DirectoryExists(*RootPath))
+        {
+            Runs.Remove(RootPath);
+            BlueprintRuns->RemoveAt(Index);
+            bDirty = true;
+            continue;
+        }
+        ++Index;
+    }
+
+    for (const FString& RootPath : *BlueprintRuns)
+    {
+        Result.Add(&Runs[RootPath]);
+    }
+    return Result;
+}
+
+const FN2CTranslationRun* FN2CTranslationHistory::FindRun(const FString& RootPath) const
+{
+    return Runs.Find(RootPath);
+}
+
+FN2CTranslationRun* FN2CTranslationHistory::FindMutableRun(const FString& RootPath)
+{
+    return Runs.Find(RootPath);
+}
+
+const FN2CTranslationRun* FN2CTranslationHistory::GetLatestRun()
+{
+    const FN2CTranslationRun* Latest = nullptr;
+    for (const TPair<FString, TArray<FString>>& Pair : RunsByBlueprint)
+    {
+        const FN2CTranslationRun* Run = Pair.Value.Num() > 0 ? Runs.Find(Pair.Value[0]) : nullptr;
+        if (Run && (!Latest || Run->Time > Latest->Time))
+        {
+            Latest = Run;
+        }
+    }
+    return Latest && IFileManager::Get().DirectoryExists(*Latest->RootPath) ? Latest : nullptr;
+}
+
+void FN2CTranslationHistory::Save()
+{
+    if (!bDirty || BasePath.IsEmpty())
+    {
+        return;
+    }
+    bDirty = false;
+
+    TArray<FN2CTranslationRun> SavedRuns;
+    Runs.GenerateValueArray(SavedRuns);
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    int32 Version = IndexVersion;
+    Writer << Version;
+    Writer << SavedRuns;
+
+    // Chained on the previous save, so an older index never replaces a newer one
+    const FString IndexPath = FPaths::Combine(BasePath, GetIndexFileName());
+    SaveTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bytes = MoveTemp(Bytes), IndexPath]()
+    {
+        if (!FFileHelper::SaveArrayToFile(Bytes, *IndexPath))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save translation history: %s"), *IndexPath), TEXT("TranslationHistory"));
+        }
+    }, UE::Tasks::Prerequisites(SaveTask));
+}
+
+void FN2CTranslationHistory::Flush()
+{
+    Save();
+    SaveTask.Wait();
+}
@@ -0,0 +1,242 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/N2CTranslationOutputWriter.h"
+
+#include "LLM/N2CTranslationArchive.h"
+#include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/CString.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Write Output File"), STAT_N2CWriteOutputFile, STATGROUP_NodeToCode);
+
+namespace
+{
+    /** The bytes FFileHelper::SaveStringToFile writes by default: ANSI if it can be, else UTF-16 with a BOM */
+    void EncodeForSave(const FString& Content, TArray<uint8>& OutBytes)
+    {
+        if (FCString::IsPureAnsi(*Content))
+        {
+            const auto Converted = StringCast<ANSICHAR>(*Content, Content.Len());
+            OutBytes.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+            return;
+        }
+
+        const FTCHARToUTF16 Converted(*Content, Content.Len());
+        OutBytes.Reserve(2 + Converted.Length() * sizeof(UTF16CHAR));
+        OutBytes.Add(0xFF);
+        OutBytes.Add(0xFE);
+        OutBytes.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length() * sizeof(UTF16CHAR));
+    }
+}
+
+FN2CTranslationOutputWriter& FN2CTranslationOutputWriter::Get()
+{
+    static FN2CTranslationOutputWriter Instance;
+    return Instance;
+}
+
+void FN2CTranslationOutputWriter::Write(const FString& FilePath, FString&& Content)
+{
+    Enqueue({ FilePath, MoveTemp(Content), EWriteKind::Replace });
+}
+
+void FN2CTranslationOutputWriter::Append(const FString& FilePath, FString&& Content)
+{
+    Enqueue({ FilePath, MoveTemp(Content), EWriteKind::Append });
+}
+
+void FN2CTranslationOutputWriter::Archive(const FString& RootPath)
+{
+    Enqueue({ RootPath, FString(), EWriteKind::Archive });
+}
+
+bool FN2CTranslationOutputWriter::Flush(FFlushStats* OutStats)
+{
+    // The worker may be relaunched by writes queued from other threads while waiting
+    while (true)
+    {
+        UE::Tasks::FTask Pending;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (!bWorkerRunning)
+            {
+                break;
+            }
+            Pending = Worker;
+        }
+        Pending.Wait();
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    const bool bAllWritten = FailedWrites == 0;
+    FailedWrites = 0;
+    if (OutStats)
+    {
+        *OutStats = Stats;
+    }
+    Stats = FFlushStats();
+
+    // Folders may be deleted between batches, so existence is checked again after a flush
+    CreatedDirectories.Reset();
+    return bAllWritten;
+}
+
+void FN2CTranslationOutputWriter::Enqueue(FPendingWrite&& PendingWrite)
+{
+    FScopeLock ScopeLock(&Lock);
+    Queue.Add(MoveTemp(PendingWrite));
+
+    if (!bWorkerRunning)
+    {
+        bWorkerRunning = true;
+        Worker = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { DrainQueue(); });
+    }
+}
+
+void FN2CTranslationOutputWriter::DrainQueue()
+{
+    while (true)
+    {
+        TArray<FPendingWrite> Batch;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (Queue.Num() == 0)
+            {
+                bWorkerRunning = false;
+                return;
+            }
+            Batch = MoveTemp(Queue);
+            Queue.Reset();
+        }
+
+        int32 Failed = 0;
+        FFlushStats BatchStats;
+        for (const FPendingWrite& PendingWrite : Batch)
+        {
+            switch (WriteFile(PendingWrite))
+            {
+                case EWriteResult::Written:
+                    ++BatchStats.WrittenFiles;
+                    break;
+                case EWriteResult::Unchanged:
+                    ++BatchStats.UnchangedFiles;
+                    break;
+                case EWriteResult::Failed:
+                    ++Failed;
+                    break;
+            }
+        }
+
+        {
+            FScopeLock ScopeLock(&Lock);
+            FailedWrites += Failed;
+            Stats.WrittenFiles += BatchStats.WrittenFiles;
+            Stats.UnchangedFiles += BatchStats.UnchangedFiles;
+        }
+    }
+}
+
+FN2CTranslationOutputWriter::EWriteResult FN2CTranslationOutputWriter::WriteFile(const FPendingWrite& PendingWrite)
+{
+    N2C_SCOPE_CYCLE_COUNTER(STAT_N2CWriteOutputFile);
+    LLM_SCOPE_BYTAG(NodeToCode_LLM);
+
+    if (PendingWrite.Kind == EWriteKind::Archive)
+    {
+        int32 PackedFiles = 0;
+        const bool bPacked = FN2CTranslationArchive::Pack(PendingWrite.FilePath, &PackedFiles);
+
+        // The packed subfolders are gone, so they are created again if written to later
+        const FString FolderPrefix = PendingWrite.FilePath / TEXT("");
+        for (auto It = CreatedDirectories.CreateIterator(); It; ++It)
+        {
+            if (It->StartsWith(FolderPrefix))
+            {
+                It.RemoveCurrent();
+            }
+        }
+        return bPacked ? (PackedFiles > 0 ? EWriteResult::Written : EWriteResult::Unchanged) : EWriteResult::Failed;
+    }
+
+    const FString Directory = FPaths::GetPath(PendingWrite.FilePath);
+    if (!CreatedDirectories.Contains(Directory))
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        if (!PlatformFile.DirectoryExists(*Directory) && !PlatformFile.CreateDirectoryTree(*Directory))
+        {
+            FN2CLogger::Get().LogError(FString::Printf(TEXT("Failed to create directory: %s"), *Directory), TEXT("OutputWriter"));
+            return EWriteResult::Failed;
+        }
+        CreatedDirectories.Add(Directory);
+    }
+
+    if (PendingWrite.Kind == EWriteKind::Append)
+    {
+        if (!FFileHelper::SaveStringToFile(PendingWrite.Content, *PendingWrite.FilePath,
+            FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+        {
+            FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to append to file: %s"), *PendingWrite.FilePath), TEXT("OutputWriter"));
+            return EWriteResult::Failed;
+        }
+        KnownFiles.Remove(PendingWrite.FilePath);
+        return EWriteResult::Written;
+    }
+
+    TArray<uint8> Bytes;
+    EncodeForSave(PendingWrite.Content, Bytes);
+    const uint64 Hash = CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), Bytes.Num());
+    if (IsUnchanged(PendingWrite.FilePath, Bytes, Hash))
+    {
+        N2C_LOG(Debug, TEXT("[OutputWriter] Skipping unchanged file: %s"), *PendingWrite.FilePath);
+        return EWriteResult::Unchanged;
+    }
+
+    // Write beside the target and rename over it, so an interrupted write never leaves a truncated file
+    const FString TempPath = PendingWrite.FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to save file: %s"), *PendingWrite.FilePath), TEXT("OutputWriter"));
+        return EWriteResult::Failed;
+    }
+    if (!IFileManager::Get().Move(*PendingWrite.FilePath, *TempPath, true, true))
+    {
+        IFileManager::Get().Delete(*TempPath);
+        KnownFiles.Remove(PendingWrite.FilePath);
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to replace file: %s"), *PendingWrite.FilePath), TEXT("OutputWriter"));
+        return EWriteResult::Failed;
+    }
+
+    KnownFiles.Add(PendingWrite.FilePath, { Bytes.Num(), Hash, IFileManager::Get().GetTimeStamp(*PendingWrite.FilePath) });
+    return EWriteResult::Written;
+}
+
+bool FN2CTranslationOutputWriter::IsUnchanged(const FString& FilePath, const TArray<uint8>& Bytes, uint64 Hash)
+{
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+    if (!StatData.bIsValid || StatData.bIsDirectory || StatData.FileSize != Bytes.Num())
+    {
+        return false;
+    }
+
+    // A file written or checked earlier whose size and timestamp still match has not been touched since
+    const FKnownFile* KnownFile = KnownFiles.Find(FilePath);
+    if (KnownFile && KnownFile->Size == StatData.FileSize && KnownFile->TimeStamp == StatData.ModificationTime)
+    {
+        return KnownFile->Hash == Hash;
+    }
+
+    TArray<uint8> Existing;
+    if (!FFileHelper::LoadFileToArray(Existing, *FilePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+    const uint64 ExistingHash = CityHash64(reinterpret_cast<const char*>(Existing.GetData()), Existing.Num());
+    KnownFiles.Add(FilePath, { Existing.Num(), ExistingHash, StatData.ModificationTime });
+    return ExistingHash == Hash;
+}
@@ -3,14 +3,21 @@
 #include "LLM/Providers/N2CAnthropicResponseParser.h"
 #include "Utils/N2CLogger.h"
 #include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 
 bool UN2CAnthropicResponseParser::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
     // Parse JSON string
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
@@ -47,13 +54,21 @@ bool UN2CAnthropicResponseParser::ParseLLMResponse(
         UsageObject->TryGetNumberField(TEXT("input_tokens"), InputTokens);
         UsageObject->TryGetNumberField(TEXT("output_tokens"), OutputTokens);
         
+        // input_tokens excludes the cached prefix, so fold cache reads and writes back into the total
+        int32 CacheReadTokens = 0;
+        int32 CacheWriteTokens = 0;
+        UsageObject->TryGetNumberField(TEXT("cache_read_input_tokens"), CacheReadTokens);
+        UsageObject->TryGetNumberField(TEXT("cache_creation_input_tokens"), CacheWriteTokens);
+        InputTokens += CacheReadTokens + CacheWriteTokens;
+        
         OutResponse.Usage.InputTokens = InputTokens;
         OutResponse.Usage.OutputTokens = OutputTokens;
+        OutResponse.Usage.CachedInputTokens = CacheReadTokens;
 
-        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d Output: %d"), InputTokens, OutputTokens), EN2CLogSeverity::Info);
+        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d (Cached: %d) Output: %d"), InputTokens, CacheReadTokens, OutputTokens), EN2CLogSeverity::Info);
     }
 
-    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response Message Content: %s"), *MessageContent), EN2CLogSeverity::Debug);
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response Message Content"), MessageContent);
 
     // Parse the extracted content as our expected JSON format
     return Super::ParseLLMResponse(MessageContent, OutResponse);
@@ -70,7 +85,7 @@ bool UN2CAnthropicResponseParser::ExtractAnthropicMessageContent(
         return false;
     }
 
-    // Find the text content block
+    // Find the text content block, or the tool call the translation was requested as
     for (const auto& ContentValue : *ContentArray)
     {
         const TSharedPtr<FJsonObject> ContentObject = ContentValue->AsObject();
@@ -80,23 +95,76 @@ bool UN2CAnthropicResponseParser::ExtractAnthropicMessageContent(
         }
 
         FString Type;
-        if (!ContentObject->TryGetStringField(TEXT("type"), Type) || Type != TEXT("text"))
+        ContentObject->TryGetStringField(TEXT("type"), Type);
+        const TSharedPtr<FJsonObject>* InputObject = nullptr;
+        if (Type == TEXT("tool_use") && ContentObject->TryGetObjectField(TEXT("input"), InputObject))
+        {
+            OutContent.Reset();
+            const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutContent);
+            return FJsonSerializer::Serialize(InputObject->ToSharedRef(), Writer);
+        }
+        if (Type != TEXT("text"))
         {
             continue;
         }
 
-        // Get content string
-        FString RawContent;
-        if (!ContentObject->TryGetStringField(TEXT("text"), RawContent))
+        // Get content string. Code fences are skipped when the content is parsed
+        if (!ContentObject->TryGetStringField(TEXT("text"), OutContent))
         {
             return false;
         }
-
-        // Process content for JSON markers
-        ProcessJsonContentWithMarkers(RawContent);
-        OutContent = RawContent;
         return true;
     }
 
     return false;
 }
+
+bool UN2CAnthropicResponseParser::IsTruncatedResponse(const FString& Response) const
+{
+    // Reported in message_delta when streamed
+    return HasStringField(Response, TEXT("stop_reason"), TEXT("max_tokens"));
+}
+
+void UN2CAnthropicResponseParser::ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const
+{
+    FString EventType;
+    EventObject->TryGetStringField(TEXT("type"), EventType);
+
+    if (EventType == TEXT("content_block_delta"))
+    {
+        const TSharedPtr<FJsonObject>* DeltaObject = nullptr;
+        FString Delta;
+        // A tool call streams its input as partial JSON
+        if (EventObject->TryGetObjectField(TEXT("delta"), DeltaObject)
+            && ((*DeltaObject)->TryGetStringField(TEXT("text"), Delta) || (*DeltaObject)->TryGetStringField(TEXT("partial_json"), Delta)))
+        {
+            State.Content += Delta;
+        }
+    }
+    else if (EventType == TEXT("message_start"))
+    {
+        // Input tokens are reported up front on the message
+        const TSharedPtr<FJsonObject>* MessageObject = nullptr;
+        const TSharedPtr<FJsonObject>* UsageObject = nullptr;
+        if (EventObject->TryGetObjectField(TEXT("message"), MessageObject) && (*MessageObject)->TryGetObjectField(TEXT("usage"), UsageObject))
+        {
+            int32 CacheReadTokens = 0;
+            int32 CacheWriteTokens = 0;
+            (*UsageObject)->TryGetNumberField(TEXT("input_tokens"), State.Usage.InputTokens);
+            (*UsageObject)->TryGetNumberField(TEXT("output_tokens"), State.Usage.OutputTokens);
+            (*UsageObject)->TryGetNumberField(TEXT("cache_read_input_tokens"), CacheReadTokens);
+            (*UsageObject)->TryGetNumberField(TEXT("cache_creation_input_tokens"), CacheWriteTokens);
+            State.Usage.InputTokens += CacheReadTokens + CacheWriteTokens;
+            State.Usage.CachedInputTokens = CacheReadTokens;
+        }
+    }
+    else if (EventType == TEXT("message_delta"))
+    {
+        // Output token count is cumulative, the last delta holds the final total
+        const TSharedPtr<FJsonObject>* UsageObject = nullptr;
+        if (EventObject->TryGetObjectField(TEXT("usage"), UsageObject))
+        {
+            (*UsageObject)->TryGetNumberField(TEXT("output_tokens"), State.Usage.OutputTokens);
+        }
+    }
+}
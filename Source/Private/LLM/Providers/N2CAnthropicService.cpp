@@ -28,29 +28,37 @@ void UN2CAnthropicService::GetProviderHeaders(TMap<FString, FString>& OutHeaders
     OutHeaders.Add(TEXT("content-type"), TEXT("application/json"));
 }
 
-FString UN2CAnthropicService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+TArray<uint8> UN2CAnthropicService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
 {
     // Log original content (no escaping needed for logging system)
     FN2CLogger::Get().Log(FString::Printf(TEXT("LLM System Message:\n\n%s"), *SystemMessage), EN2CLogSeverity::Debug);
     FN2CLogger::Get().Log(FString::Printf(TEXT("LLM User Message:\n\n%s"), *UserMessage), EN2CLogSeverity::Debug);
 
-    // Create and configure payload builder
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForAnthropic();
+    // Start the next payload on the shared builder
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForAnthropic();
     
     // Set common parameters
-    PayloadBuilder->SetTemperature(0.0f);
-    PayloadBuilder->SetMaxTokens(8192);
+    PayloadBuilder.SetTemperature(0.0f);
+    PayloadBuilder.SetMaxTokens(GetMaxOutputTokens(UserMessage));
     
-    // Try prepending source files to the user message
-    FString FinalUserMessage = UserMessage;
-    PromptManager->PrependSourceFilesToUserMessage(FinalUserMessage);
+    // Mark the system prompt and reference files as cache breakpoints
+    PayloadBuilder.SetPromptCaching(Config.bUsePromptCaching);
+    
+    // Reference source files go ahead of the graph JSON so they form part of the stable prefix
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(UserMessage, ReferenceFiles);
     
     // Add messages
-    PayloadBuilder->AddSystemMessage(SystemMessage);
-    PayloadBuilder->AddUserMessage(FinalUserMessage);
+    PayloadBuilder.AddSystemMessage(SystemMessage);
+    PayloadBuilder.AddUserMessageWithPrefix(ReferenceFiles, UserMessage);
+
+    // Have the translation returned as a tool call that follows the response schema
+    PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
+    
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
 }
@@ -8,9 +8,15 @@ bool UN2CDeepSeekResponseParser::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
     // Parse JSON string
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
@@ -52,10 +58,14 @@ bool UN2CDeepSeekResponseParser::ParseLLMResponse(
         OutResponse.Usage.InputTokens = PromptTokens;
         OutResponse.Usage.OutputTokens = CompletionTokens;
 
-        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d Output: %d"), PromptTokens, CompletionTokens), EN2CLogSeverity::Info);
+        // DeepSeek caches prompt prefixes automatically and reports hits separately
+        UsageObject->TryGetNumberField(TEXT("prompt_cache_hit_tokens"), OutResponse.Usage.CachedInputTokens);
+
+        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d (Cached: %d) Output: %d"),
+            PromptTokens, OutResponse.Usage.CachedInputTokens, CompletionTokens), EN2CLogSeverity::Info);
     }
 
-    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response Message Content: %s"), *MessageContent), EN2CLogSeverity::Debug);
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response Message Content"), MessageContent);
 
     // Parse the extracted content as our expected JSON format
     return Super::ParseLLMResponse(MessageContent, OutResponse);
@@ -29,7 +29,7 @@ void UN2CDeepSeekService::GetProviderHeaders(TMap<FString, FString>& OutHeaders)
     OutHeaders.Add(TEXT("Content-Type"), TEXT("application/json"));
 }
 
-FString UN2CDeepSeekService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+TArray<uint8> UN2CDeepSeekService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
 {
     // Load settings
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
@@ -38,29 +38,32 @@ FString UN2CDeepSeekService::FormatRequestPayload(const FString& UserMessage, co
         FN2CLogger::Get().LogError(TEXT("Failed to load plugin settings"), TEXT("LLMModule"));
     }
 
-    // Create and configure payload builder
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForDeepSeek();
+    // Start the next payload on the shared builder
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForDeepSeek();
     
     // Set common parameters
-    PayloadBuilder->SetTemperature(0.0f);
-    PayloadBuilder->SetMaxTokens(8000);
+    PayloadBuilder.SetTemperature(0.0f);
+    PayloadBuilder.SetMaxTokens(GetMaxOutputTokens(UserMessage));
     
-    // Try prepending source files to the user message
-    FString FinalUserMessage = UserMessage;
-    PromptManager->PrependSourceFilesToUserMessage(FinalUserMessage);
+    // DeepSeek caches identical leading prefixes automatically: system prompt, then reference files, then the graph
+    PayloadBuilder.SetPromptCaching(Config.bUsePromptCaching);
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(UserMessage, ReferenceFiles);
     
     // Add messages
-    PayloadBuilder->AddSystemMessage(SystemMessage);
-    PayloadBuilder->AddUserMessage(FinalUserMessage);
+    PayloadBuilder.AddSystemMessage(SystemMessage);
+    PayloadBuilder.AddUserMessageWithPrefix(ReferenceFiles, UserMessage);
     
     // Add JSON schema for response format if model supports it
     if (Settings && FN2CLLMModelUtils::GetDeepSeekModelValue(Settings->DeepSeekModel) == TEXT("deepseek-chat"))
     {
-        PayloadBuilder->SetJsonResponseFormat(UN2CLLMPayloadBuilder::GetN2CResponseSchema());
+        PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
     }
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
+    
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
 }
@@ -8,9 +8,15 @@ bool UN2CGeminiResponseParser::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
     // Parse JSON string
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
@@ -53,10 +59,14 @@ bool UN2CGeminiResponseParser::ParseLLMResponse(
         OutResponse.Usage.InputTokens = PromptTokens;
         OutResponse.Usage.OutputTokens = CompletionTokens;
 
-        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d Output: %d"), PromptTokens, CompletionTokens), EN2CLogSeverity::Info);
+        // Explicit cached content and implicit caching both report the reused prefix here
+        UsageMetadata->TryGetNumberField(TEXT("cachedContentTokenCount"), OutResponse.Usage.CachedInputTokens);
+
+        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d (Cached: %d) Output: %d"),
+            PromptTokens, OutResponse.Usage.CachedInputTokens, CompletionTokens), EN2CLogSeverity::Info);
     }
 
-    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response Message Content: %s"), *MessageContent), EN2CLogSeverity::Debug);
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response Message Content"), MessageContent);
 
     // Parse the extracted content as our expected JSON format
     return Super::ParseLLMResponse(MessageContent, OutResponse);
@@ -101,15 +111,50 @@ bool UN2CGeminiResponseParser::ExtractGeminiMessageContent(
         return false;
     }
 
-    // Get text content
-    FString RawContent;
-    if (!PartObject->TryGetStringField(TEXT("text"), RawContent))
+    // Get text content. Code fences are skipped when the content is parsed
+    if (!PartObject->TryGetStringField(TEXT("text"), OutContent))
     {
         return false;
     }
-
-    // Process content for JSON markers
-    ProcessJsonContentWithMarkers(RawContent);
-    OutContent = RawContent;
     return true;
 }
+
+bool UN2CGeminiResponseParser::IsTruncatedResponse(const FString& Response) const
+{
+    // Reported on the last candidate chunk when streamed
+    return HasStringField(Response, TEXT("finishReason"), TEXT("MAX_TOKENS"));
+}
+
+void UN2CGeminiResponseParser::ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const
+{
+    const TArray<TSharedPtr<FJsonValue>>* CandidatesArray = nullptr;
+    if (EventObject->TryGetArrayField(TEXT("candidates"), CandidatesArray) && CandidatesArray->Num() > 0)
+    {
+        const TSharedPtr<FJsonObject> CandidateObject = (*CandidatesArray)[0]->AsObject();
+        const TSharedPtr<FJsonObject>* ContentObject = nullptr;
+        const TArray<TSharedPtr<FJsonValue>>* PartsArray = nullptr;
+        if (CandidateObject.IsValid()
+            && CandidateObject->TryGetObjectField(TEXT("content"), ContentObject)
+            && (*ContentObject)->TryGetArrayField(TEXT("parts"), PartsArray))
+        {
+            for (const TSharedPtr<FJsonValue>& PartValue : *PartsArray)
+            {
+                const TSharedPtr<FJsonObject> PartObject = PartValue->AsObject();
+                FString Delta;
+                if (PartObject.IsValid() && PartObject->TryGetStringField(TEXT("text"), Delta))
+                {
+                    State.Content += Delta;
+                }
+            }
+        }
+    }
+
+    // Every chunk carries running totals
+    const TSharedPtr<FJsonObject>* UsageMetadata = nullptr;
+    if (EventObject->TryGetObjectField(TEXT("usageMetadata"), UsageMetadata))
+    {
+        (*UsageMetadata)->TryGetNumberField(TEXT("promptTokenCount"), State.Usage.InputTokens);
+        (*UsageMetadata)->TryGetNumberField(TEXT("candidatesTokenCount"), State.Usage.OutputTokens);
+        (*UsageMetadata)->TryGetNumberField(TEXT("cachedContentTokenCount"), State.Usage.CachedInputTokens);
+    }
+}
@@ -2,7 +2,11 @@
 
 #include "LLM/Providers/N2CGeminiService.h"
 
+#include "LLM/N2CHttpHandlerBase.h"
 #include "LLM/N2CSystemPromptManager.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utils/N2CLogger.h"
 
 UN2CResponseParserBase* UN2CGeminiService::CreateResponseParser()
 {
@@ -16,8 +20,17 @@ void UN2CGeminiService::GetConfiguration(
     bool& OutSupportsSystemPrompts)
 {
     // Build full endpoint (Gemini typically uses "model_name:generateContent")
-    OutEndpoint = FString::Printf(TEXT("%s%s:generateContent?key=%s"),
-                                  *Config.ApiEndpoint, *Config.Model, *Config.ApiKey);
+    if (Config.bStreamResponses)
+    {
+        // Streaming uses a dedicated method, alt=sse selects server-sent events over a JSON array
+        OutEndpoint = FString::Printf(TEXT("%s%s:streamGenerateContent?alt=sse&key=%s"),
+                                      *Config.ApiEndpoint, *Config.Model, *Config.ApiKey);
+    }
+    else
+    {
+        OutEndpoint = FString::Printf(TEXT("%s%s:generateContent?key=%s"),
+                                      *Config.ApiEndpoint, *Config.Model, *Config.ApiKey);
+    }
     OutAuthToken = TEXT("");  // Gemini uses key in URL, not in auth header
     
     // Default to supporting system prompts since all Gemini models currently support system prompts
@@ -29,33 +42,167 @@ void UN2CGeminiService::GetProviderHeaders(TMap<FString, FString>& OutHeaders) c
     OutHeaders.Add(TEXT("Content-Type"), TEXT("application/json"));
 }
 
-FString UN2CGeminiService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+bool UN2CGeminiService::UsesReasoningTokens() const
 {
-    // Create and configure payload builder
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForGemini();
+    // maxOutputTokens of thinking models covers their thoughts too
+    return Config.Model.Contains(TEXT("gemini-2.5")) || Config.Model.Contains(TEXT("thinking"));
+}
+
+TArray<uint8> UN2CGeminiService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+{
+    // Start the next payload on the shared builder
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForGemini();
+    PayloadBuilder.SetMaxTokens(GetMaxOutputTokens(UserMessage));
+
+    // The experimental thinking model predates thinking budgets
+    if (UsesReasoningTokens() && Config.Model != TEXT("gemini-2.0-flash-thinking-exp-01-21"))
+    {
+        PayloadBuilder.SetReasoningEffort(GetReasoningEffort(UserMessage));
+    }
     
-    // Try prepending source files to the user message
-    FString FinalUserMessage = UserMessage;
-    PromptManager->PrependSourceFilesToUserMessage(FinalUserMessage);
+    // Reference source files go ahead of the graph JSON so they form part of the stable prefix
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(UserMessage, ReferenceFiles);
+
+    // The system prompt and reference files live in cached content when one exists for this prefix
+    const bool bUseCachedContent = Config.bUsePromptCaching
+        && !CachedContentName.IsEmpty()
+        && CachedContentKey == MakeCachedContentKey(SystemMessage, ReferenceFiles);
 
     // Gemini 2.5 Pro seems to respond with more reliable structured outputs with a temp of 1.0
     if (Config.Model.Contains("gemini-2.5-pro"))
     {
-        PayloadBuilder->SetTemperature(1.0f); 
+        PayloadBuilder.SetTemperature(1.0f); 
     }
     
     // Add system message and user message
-    PayloadBuilder->AddSystemMessage(SystemMessage);
-    PayloadBuilder->AddUserMessage(FinalUserMessage);
+    if (bUseCachedContent)
+    {
+        PayloadBuilder.SetCachedContent(CachedContentName);
+        PayloadBuilder.AddUserMessage(UserMessage);
+    }
+    else
+    {
+        PayloadBuilder.AddSystemMessage(SystemMessage);
+        PayloadBuilder.AddUserMessageWithPrefix(ReferenceFiles, UserMessage);
+    }
     
     // Add JSON schema for response format if model supports it
     if (Config.Model != TEXT("gemini-2.0-flash-thinking-exp-01-21"))
     {
-        PayloadBuilder->SetJsonResponseFormat(UN2CLLMPayloadBuilder::GetN2CResponseSchema());
+        PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
     }
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
+    
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
+}
+
+void UN2CGeminiService::SendStreamingRequest(
+    const FString& JsonPayload,
+    const FString& SystemMessage,
+    const FOnLLMStreamChunkReceived& OnPartialContent,
+    const FOnLLMResponseReceived& OnComplete,
+    const TSharedPtr<FN2CHttpRequestHandle>& Handle)
+{
+    if (!Config.bUsePromptCaching || !bIsInitialized)
+    {
+        Super::SendStreamingRequest(JsonPayload, SystemMessage, OnPartialContent, OnComplete, Handle);
+        return;
+    }
+
+    TWeakObjectPtr<UN2CGeminiService> WeakThis(this);
+    EnsureCachedContent(JsonPayload, SystemMessage, [WeakThis, JsonPayload, SystemMessage, OnPartialContent, OnComplete, Handle]()
+    {
+        if (UN2CGeminiService* StrongThis = WeakThis.Get())
+        {
+            StrongThis->UN2CBaseLLMService::SendStreamingRequest(JsonPayload, SystemMessage, OnPartialContent, OnComplete, Handle);
+        }
+        else
+        {
+            OnComplete.ExecuteIfBound(TEXT("{\"error\": \"Gemini service was destroyed\"}"));
+        }
+    });
+}
+
+void UN2CGeminiService::EnsureCachedContent(const FString& UserMessage, const FString& SystemMessage, TFunction<void()>&& OnReady)
+{
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(UserMessage, ReferenceFiles);
+    const FString Key = MakeCachedContentKey(SystemMessage, ReferenceFiles);
+
+    // Reuse the current cache while it has comfortably more than a request's worth of lifetime left
+    const double Now = FPlatformTime::Seconds();
+    if ((Key == CachedContentKey && !CachedContentName.IsEmpty() && Now < CachedContentExpiry - 60.0)
+        || Key == RejectedCachedContentKey)
+    {
+        OnReady();
+        return;
+    }
+
+    // Another request is already creating the cache; wait for it instead of creating a duplicate
+    PendingCacheWaiters.Add(MoveTemp(OnReady));
+    if (PendingCacheWaiters.Num() > 1)
+    {
+        return;
+    }
+
+    CachedContentName.Reset();
+
+    FString BaseEndpoint = Config.ApiEndpoint;
+    BaseEndpoint.RemoveFromEnd(TEXT("/"));
+    BaseEndpoint.RemoveFromEnd(TEXT("/models"));
+    const FString Endpoint = FString::Printf(TEXT("%s/cachedContents?key=%s"), *BaseEndpoint, *Config.ApiKey);
+
+    const FString Payload = FN2CLLMPayloadBuilder::BuildGeminiCachedContentPayload(
+        Config.Model, SystemMessage, ReferenceFiles, CachedContentTtlSeconds);
+
+    TWeakObjectPtr<UN2CGeminiService> WeakThis(this);
+    HttpHandler->PostLLMRequest(Endpoint, TEXT(""), Payload, FOnLLMResponseReceived::CreateLambda(
+        [WeakThis, Key](const FString& Response)
+        {
+            UN2CGeminiService* StrongThis = WeakThis.Get();
+            if (!StrongThis)
+            {
+                return;
+            }
+
+            TSharedPtr<FJsonObject> JsonObject;
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(Response);
+            FString Name;
+            if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid()
+                && JsonObject->TryGetStringField(TEXT("name"), Name) && !Name.IsEmpty())
+            {
+                StrongThis->CachedContentName = Name;
+                StrongThis->CachedContentKey = Key;
+                StrongThis->CachedContentExpiry = FPlatformTime::Seconds() + CachedContentTtlSeconds;
+
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Created Gemini cached content: %s"), *Name),
+                    EN2CLogSeverity::Info, TEXT("GeminiService"));
+            }
+            else
+            {
+                // Typically the prefix is below the model's minimum cacheable size; implicit caching still applies
+                StrongThis->RejectedCachedContentKey = Key;
+                FN2CLogger::Get().LogWarning(
+                    FString::Printf(TEXT("Gemini cached content was not created, sending full prompts: %s"), *Response),
+                    TEXT("GeminiService"));
+            }
+
+            TArray<TFunction<void()>> Waiters = MoveTemp(StrongThis->PendingCacheWaiters);
+            StrongThis->PendingCacheWaiters.Reset();
+            for (TFunction<void()>& Waiter : Waiters)
+            {
+                Waiter();
+            }
+        }));
+}
+
+FString UN2CGeminiService::MakeCachedContentKey(const FString& SystemMessage, const FString& ReferenceFiles) const
+{
+    return FMD5::HashAnsiString(*(Config.Model + TEXT("|") + SystemMessage + TEXT("|") + ReferenceFiles));
 }
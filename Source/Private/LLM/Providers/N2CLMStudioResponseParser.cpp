@@ -8,9 +8,15 @@ bool UN2CLMStudioResponseParser::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
     // Parse JSON string
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
@@ -99,11 +105,7 @@ bool UN2CLMStudioResponseParser::ParseLLMResponse(
         );
     }
 
-    FN2CLogger::Get().Log(
-        FString::Printf(TEXT("LM Studio Response Message Content: %s"), *MessageContent), 
-        EN2CLogSeverity::Debug,
-        TEXT("LMStudioResponseParser")
-    );
+    FN2CLogger::Get().LogPayload(TEXT("LM Studio Response Message Content"), MessageContent, EN2CLogSeverity::Debug, TEXT("LMStudioResponseParser"));
 
     // Parse the extracted content as our expected JSON format
     // The base class will handle parsing the structured N2C JSON response
@@ -3,9 +3,21 @@
 #include "LLM/Providers/N2CLMStudioService.h"
 
 #include "Core/N2CSettings.h"
+#include "LLM/N2CLocalEndpointPool.h"
 #include "LLM/N2CSystemPromptManager.h"
 #include "Utils/N2CLogger.h"
 
+namespace
+{
+    /** Server base URL without a trailing slash or the chat completions path */
+    FString GetBaseUrl(FString Url)
+    {
+        Url.RemoveFromEnd(TEXT("/"));
+        Url.RemoveFromEnd(TEXT("/v1/chat/completions"));
+        return Url;
+    }
+}
+
 bool UN2CLMStudioService::Initialize(const FN2CLLMConfig& InConfig)
 {
     // Create a copy of the input config
@@ -49,6 +61,21 @@ bool UN2CLMStudioService::Initialize(const FN2CLLMConfig& InConfig)
             LMStudioEndpoint = GetDefaultEndpoint();
             UpdatedConfig.ApiEndpoint = LMStudioEndpoint;
         }
+
+        // Balance requests across the main endpoint and any additional servers
+        TArray<FN2CPooledEndpoint> Endpoints;
+        const FString MainUrl = GetBaseUrl(LMStudioEndpoint);
+        Endpoints.Add({ MainUrl + TEXT("/v1/chat/completions"), MainUrl + TEXT("/v1/models"),
+            Settings->GetProviderRequestLimits(EN2CLLMProvider::LMStudio).MaxConcurrentRequests });
+        for (const FN2CLocalEndpoint& Endpoint : Settings->LMStudioAdditionalEndpoints)
+        {
+            if (!Endpoint.Url.IsEmpty())
+            {
+                const FString BaseUrl = GetBaseUrl(Endpoint.Url);
+                Endpoints.Add({ BaseUrl + TEXT("/v1/chat/completions"), BaseUrl + TEXT("/v1/models"), Endpoint.MaxConcurrentRequests });
+            }
+        }
+        FN2CLocalEndpointPool::Get().SetEndpoints(EN2CLLMProvider::LMStudio, Endpoints);
     }
     
     // Call base class initialization with the updated config
@@ -84,12 +111,11 @@ void UN2CLMStudioService::GetProviderHeaders(TMap<FString, FString>& OutHeaders)
     }
 }
 
-FString UN2CLMStudioService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+TArray<uint8> UN2CLMStudioService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
 {
-    // Create and configure payload builder for LM Studio
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForLMStudio();
+    // Start the next payload on the shared builder for LM Studio
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForLMStudio();
     
     // Try prepending source files to user message
     FString FinalUserMessage = UserMessage;
@@ -111,14 +137,17 @@ FString UN2CLMStudioService::FormatRequestPayload(const FString& UserMessage, co
     // Add messages - LM Studio supports system prompts
     if (!SystemMessage.IsEmpty())
     {
-        PayloadBuilder->AddSystemMessage(SystemMessage);
+        PayloadBuilder.AddSystemMessage(SystemMessage);
     }
-    PayloadBuilder->AddUserMessage(FinalUserMessage);
+    PayloadBuilder.AddUserMessage(FinalUserMessage);
     
     // IMPORTANT: Use structured output for reliable JSON parsing
     // This ensures LM Studio returns properly formatted JSON responses
-    PayloadBuilder->SetStructuredOutput(UN2CLLMPayloadBuilder::GetN2CResponseSchema());
+    PayloadBuilder.SetStructuredOutput(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
+    
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
 }
\ No newline at end of file
@@ -9,9 +9,15 @@ bool UN2COllamaResponseParser::ParseLLMResponse(
     const FString& InJson,
     FN2CTranslationResponse& OutResponse)
 {
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
     // Parse JSON string
     TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InJson);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
@@ -59,7 +65,7 @@ bool UN2COllamaResponseParser::ParseLLMResponse(
         FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d Output: %d"), PromptTokens, CompletionTokens), EN2CLogSeverity::Info);
     }
     
-    FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Response Message Content: %s"), *MessageContent), EN2CLogSeverity::Debug);
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response Message Content"), MessageContent);
 
     // Parse the extracted content as our expected JSON format
     return Super::ParseLLMResponse(MessageContent, OutResponse);
@@ -81,29 +87,31 @@ bool UN2COllamaResponseParser::ExtractOllamaMessageContent(
     {
         return false;
     }
-    
-    // Process thinking tags if present
-    if (OutContent.StartsWith(TEXT("<think>")))
-    {
-        // Remove thinking tags and their content
-        while (true)
-        {
-            int32 ThinkStart = OutContent.Find(TEXT("<think>"));
-            if (ThinkStart == INDEX_NONE) break;
 
-            int32 ThinkEnd = OutContent.Find(TEXT("</think>"));
-            if (ThinkEnd == INDEX_NONE) break;
+    // Thinking, whitespace and code fences are skipped when the content is parsed
+    return true;
+}
 
-            // Remove the thinking section including tags
-            OutContent.RemoveAt(ThinkStart, (ThinkEnd + 8) - ThinkStart);
-        }
+bool UN2COllamaResponseParser::IsTruncatedResponse(const FString& Response) const
+{
+    // Reported on the final done object when streamed
+    return HasStringField(Response, TEXT("done_reason"), TEXT("length"));
+}
+
+void UN2COllamaResponseParser::ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const
+{
+    const TSharedPtr<FJsonObject>* MessageObject = nullptr;
+    FString Delta;
+    if (EventObject->TryGetObjectField(TEXT("message"), MessageObject) && (*MessageObject)->TryGetStringField(TEXT("content"), Delta))
+    {
+        State.Content += Delta;
+    }
+
+    // Token counts are only present on the final chunk
+    bool bDone = false;
+    if (EventObject->TryGetBoolField(TEXT("done"), bDone) && bDone)
+    {
+        EventObject->TryGetNumberField(TEXT("prompt_eval_count"), State.Usage.InputTokens);
+        EventObject->TryGetNumberField(TEXT("eval_count"), State.Usage.OutputTokens);
     }
-    
-    // Trim any extra whitespace that might have been left
-    OutContent = OutContent.TrimStartAndEnd();
-    
-    // Process JSON markers
-    ProcessJsonContentWithMarkers(OutContent);
-    
-    return true;
 }
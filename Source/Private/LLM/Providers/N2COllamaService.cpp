@@ -3,8 +3,45 @@
 #include "LLM/Providers/N2COllamaService.h"
 
 #include "Core/N2CSettings.h"
+#include "LLM/N2CLocalEndpointPool.h"
 #include "LLM/N2CSystemPromptManager.h"
+#include "LLM/N2CTokenEstimator.h"
 #include "Utils/N2CLogger.h"
+#include "Dom/JsonObject.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** Seconds a preload may take, enough for a large model to load from disk */
+    constexpr float PreloadTimeout = 300.0f;
+
+    /** Seconds between preloads of a model kept loaded indefinitely, in case the server restarted */
+    constexpr double IndefinitePreloadInterval = 600.0;
+
+    /** When each server last had each model preloaded, shared by every service since services are recreated on initialization */
+    TMap<FString, double>& GetLastPreloadTimes()
+    {
+        static TMap<FString, double> LastPreloadTimes;
+        return LastPreloadTimes;
+    }
+
+    /** Context window each model was last sent with, which is what the server has loaded */
+    TMap<FString, int32>& GetLoadedContextWindows()
+    {
+        static TMap<FString, int32> LoadedContextWindows;
+        return LoadedContextWindows;
+    }
+
+    /** Server base URL without a trailing slash or the chat path */
+    FString GetBaseUrl(FString Url)
+    {
+        Url.RemoveFromEnd(TEXT("/"));
+        Url.RemoveFromEnd(TEXT("/api/chat"));
+        return Url;
+    }
+}
 
 bool UN2COllamaService::Initialize(const FN2CLLMConfig& InConfig)
 {
@@ -45,6 +82,23 @@ bool UN2COllamaService::Initialize(const FN2CLLMConfig& InConfig)
                 TEXT("OllamaService")
             );
         }
+
+        // Balance requests across the main endpoint and any additional servers
+        TArray<FN2CPooledEndpoint> Endpoints;
+        const FString MainUrl = GetBaseUrl(UpdatedConfig.ApiEndpoint.IsEmpty() ? GetDefaultEndpoint() : UpdatedConfig.ApiEndpoint);
+        Endpoints.Add({ MainUrl + TEXT("/api/chat"), MainUrl + TEXT("/api/tags"),
+            Settings->GetProviderRequestLimits(EN2CLLMProvider::Ollama).MaxConcurrentRequests });
+        ServerUrls = { MainUrl };
+        for (const FN2CLocalEndpoint& Endpoint : OllamaConfig.AdditionalEndpoints)
+        {
+            if (!Endpoint.Url.IsEmpty())
+            {
+                const FString BaseUrl = GetBaseUrl(Endpoint.Url);
+                Endpoints.Add({ BaseUrl + TEXT("/api/chat"), BaseUrl + TEXT("/api/tags"), Endpoint.MaxConcurrentRequests });
+                ServerUrls.AddUnique(BaseUrl);
+            }
+        }
+        FN2CLocalEndpointPool::Get().SetEndpoints(EN2CLLMProvider::Ollama, Endpoints);
     }
     
     // Call base class initialization with the updated config
@@ -75,13 +129,109 @@ void UN2COllamaService::GetProviderHeaders(TMap<FString, FString>& OutHeaders) c
     OutHeaders.Add(TEXT("Content-Type"), TEXT("application/json"));
 }
 
-FString UN2COllamaService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+void UN2COllamaService::WarmUpConnection() const
+{
+    // A keep-alive of 0 unloads the model after every request, so there is nothing to keep warm
+    if (!OllamaConfig.bPreloadModel || OllamaConfig.KeepAlive == 0 || Config.Model.IsEmpty())
+    {
+        return;
+    }
+
+    // Preload again well before the keep-alive runs out
+    const double PreloadInterval = OllamaConfig.KeepAlive > 0 ? FMath::Max(30.0, OllamaConfig.KeepAlive * 0.5) : IndefinitePreloadInterval;
+    const double Now = FPlatformTime::Seconds();
+
+    // Ollama reloads a model whose context size changes, so the preload asks for the one requests use
+    TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+    Body->SetStringField(TEXT("model"), Config.Model);
+    Body->SetNumberField(TEXT("keep_alive"), OllamaConfig.KeepAlive);
+    TSharedRef<FJsonObject> Options = MakeShared<FJsonObject>();
+    const int32* LoadedContextWindow = GetLoadedContextWindows().Find(Config.Model);
+    Options->SetNumberField(TEXT("num_ctx"), LoadedContextWindow ? *LoadedContextWindow : OllamaConfig.NumCtx);
+    Body->SetObjectField(TEXT("options"), Options);
+
+    FString Content;
+    FJsonSerializer::Serialize(Body, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Content));
+
+    const TArray<FString> Urls = ServerUrls.Num() > 0
+        ? ServerUrls
+        : TArray<FString>{ GetBaseUrl(Config.ApiEndpoint.IsEmpty() ? GetDefaultEndpoint() : Config.ApiEndpoint) };
+    for (const FString& BaseUrl : Urls)
+    {
+        const FString Key = BaseUrl + TEXT("|") + Config.Model;
+        double& LastPreloadTime = GetLastPreloadTimes().FindOrAdd(Key, -PreloadInterval);
+        if (Now - LastPreloadTime < PreloadInterval)
+        {
+            continue;
+        }
+        LastPreloadTime = Now;
+
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+        Request->SetURL(BaseUrl + TEXT("/api/generate"));
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        Request->SetContentAsString(Content);
+        Request->SetTimeout(PreloadTimeout);
+        Request->OnProcessRequestComplete().BindLambda(
+            [Key, BaseUrl, Model = Config.Model, StartTime = Now](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+            {
+                const bool bLoaded = bConnectedSuccessfully && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode());
+                if (!bLoaded)
+                {
+                    // Let the next warm-up try again
+                    GetLastPreloadTimes().Remove(Key);
+                }
+                FN2CLogger::Get().Log(
+                    FString::Printf(TEXT("Preloading %s on %s %s after %.1f s"), *Model, *BaseUrl,
+                        bLoaded ? TEXT("finished") : TEXT("failed"), FPlatformTime::Seconds() - StartTime),
+                    bLoaded ? EN2CLogSeverity::Debug : EN2CLogSeverity::Warning, TEXT("OllamaService"));
+            });
+        Request->ProcessRequest();
+    }
+}
+
+int32 UN2COllamaService::GetRequestContextWindow(const FString& UserMessage, const FString& SystemMessage) const
+{
+    if (!OllamaConfig.bAutoSizeContext)
+    {
+        return OllamaConfig.NumCtx;
+    }
+
+    const int32 UserTokens = FN2CTokenEstimator::EstimateTokens(UserMessage, EN2CLLMProvider::Ollama);
+    const int32 OutputTokens = OllamaConfig.NumPredict > 0
+        ? FN2CTokenEstimator::GetOutputBudget(UserTokens, OllamaConfig.NumPredict)
+        : FN2CTokenEstimator::GetOutputBudget(UserTokens);
+    const int32 RequiredTokens = FN2CTokenEstimator::EstimateTokens(SystemMessage, EN2CLLMProvider::Ollama) + UserTokens + OutputTokens;
+
+    // Whole doublings of the smallest window, so a batch uses only a few sizes
+    const int32 MaxContextWindow = OllamaConfig.GetMaxContextWindow();
+    int32 ContextWindow = OllamaConfig.NumCtx;
+    while (ContextWindow < RequiredTokens && ContextWindow < MaxContextWindow)
+    {
+        ContextWindow *= 2;
+    }
+    ContextWindow = FMath::Min(ContextWindow, MaxContextWindow);
+
+    if (RequiredTokens > ContextWindow)
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Request needs ~%d tokens, more than the %d token Max Context Window; Ollama will truncate it"),
+                RequiredTokens, ContextWindow),
+            TEXT("OllamaService"));
+    }
+
+    // Each size change reloads the model, so stay in the loaded size while it fits and is at most one doubling larger
+    int32& LoadedContextWindow = GetLoadedContextWindows().FindOrAdd(Config.Model, ContextWindow);
+    if (LoadedContextWindow >= RequiredTokens && LoadedContextWindow <= ContextWindow * 2 && LoadedContextWindow <= MaxContextWindow)
+    {
+        return LoadedContextWindow;
+    }
+    LoadedContextWindow = ContextWindow;
+    return ContextWindow;
+}
+
+TArray<uint8> UN2COllamaService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
 {
-    // Create and configure payload builder
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForOllama(OllamaConfig);
-    
     // Try prepending source files to user message
     FString FinalUserMessage = UserMessage;
     PromptManager->PrependSourceFilesToUserMessage(FinalUserMessage);
@@ -99,23 +249,34 @@ FString UN2COllamaService::FormatRequestPayload(const FString& UserMessage, cons
     }
     
     const bool bSupportsSystemPrompts = OllamaConfig.bUseSystemPrompts;
+
+    // Start the next payload on the shared builder, with a context window sized to the messages
+    FN2COllamaConfig RequestConfig = OllamaConfig;
+    RequestConfig.NumCtx = GetRequestContextWindow(FinalUserMessage, SystemMessage);
+
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForOllama(RequestConfig);
+    PayloadBuilder.SetReasoningEffort(GetReasoningEffort(UserMessage));
     
     // Add messages
     if (bSupportsSystemPrompts && !SystemMessage.IsEmpty())
     {
-        PayloadBuilder->AddSystemMessage(SystemMessage);
-        PayloadBuilder->AddUserMessage(FinalUserMessage);
+        PayloadBuilder.AddSystemMessage(SystemMessage);
+        PayloadBuilder.AddUserMessage(FinalUserMessage);
     }
     else
     {
         // Merge system and user prompts if model doesn't support system prompts
         FString MergedContent = PromptManager->MergePrompts(SystemMessage, FinalUserMessage);
-        PayloadBuilder->AddUserMessage(MergedContent);
+        PayloadBuilder.AddUserMessage(MergedContent);
     }
     
     // Add JSON schema for response format
-    PayloadBuilder->SetJsonResponseFormat(UN2CLLMPayloadBuilder::GetN2CResponseSchema());
+    PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
+    
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
 }
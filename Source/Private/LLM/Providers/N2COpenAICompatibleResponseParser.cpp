@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/Providers/N2COpenAICompatibleResponseParser.h"
+#include "Utils/N2CLogger.h"
+#include "Serialization/JsonSerializer.h"
+
+bool UN2COpenAICompatibleResponseParser::ParseLLMResponse(
+    const FString& InJson,
+    FN2CTranslationResponse& OutResponse)
+{
+    // Streamed bodies are a sequence of events rather than a single response object
+    if (IsStreamedResponse(InJson))
+    {
+        return ParseStreamedResponse(InJson, OutResponse);
+    }
+
+    // Parse JSON string
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::CreateFromView(InJson);
+
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        FN2CLogger::Get().LogError(
+            FString::Printf(TEXT("Failed to parse OpenAI-compatible response JSON: %s"), *InJson),
+            TEXT("OpenAICompatibleResponseParser")
+        );
+        return false;
+    }
+
+    // Errors follow the OpenAI format, apart from TGI's, which are a plain string
+    FString ErrorMessage;
+    if (JsonObject->HasField(TEXT("error")))
+    {
+        if (JsonObject->TryGetStringField(TEXT("error"), ErrorMessage)
+            || HandleCommonErrorResponse(JsonObject, TEXT("error"), ErrorMessage))
+        {
+            FN2CLogger::Get().LogError(ErrorMessage, TEXT("OpenAICompatibleResponseParser"));
+        }
+        return false;
+    }
+
+    // Extract message content from OpenAI format
+    FString MessageContent;
+    if (!ExtractStandardMessageContent(JsonObject, TEXT("choices"), TEXT("message"), TEXT("content"), MessageContent))
+    {
+        FN2CLogger::Get().LogError(TEXT("Failed to extract message content from OpenAI-compatible response"), TEXT("OpenAICompatibleResponseParser"));
+        return false;
+    }
+
+    // Not every server reports usage
+    const TSharedPtr<FJsonObject>* UsageObject = nullptr;
+    if (JsonObject->TryGetObjectField(TEXT("usage"), UsageObject))
+    {
+        (*UsageObject)->TryGetNumberField(TEXT("prompt_tokens"), OutResponse.Usage.InputTokens);
+        (*UsageObject)->TryGetNumberField(TEXT("completion_tokens"), OutResponse.Usage.OutputTokens);
+        OutResponse.Usage.CachedInputTokens = GetOpenAICachedTokens(*UsageObject);
+
+        FN2CLogger::Get().Log(FString::Printf(TEXT("LLM Token Usage - Input: %d (Cached: %d) Output: %d"),
+            OutResponse.Usage.InputTokens, OutResponse.Usage.CachedInputTokens, OutResponse.Usage.OutputTokens),
+            EN2CLogSeverity::Info, TEXT("OpenAICompatibleResponseParser"));
+    }
+
+    FN2CLogger::Get().LogPayload(TEXT("LLM Response Message Content"), MessageContent);
+
+    // Parse the extracted content as our expected JSON format
+    return Super::ParseLLMResponse(MessageContent, OutResponse);
+}
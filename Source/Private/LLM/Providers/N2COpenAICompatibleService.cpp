@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "LLM/Providers/N2COpenAICompatibleService.h"
+
+#include "Core/N2CSettings.h"
+#include "LLM/N2CLocalEndpointPool.h"
+#include "LLM/N2CSystemPromptManager.h"
+#include "Utils/N2CLogger.h"
+
+namespace
+{
+    /** Server base URL without a trailing slash, /v1 or the chat completions path */
+    FString GetBaseUrl(FString Url)
+    {
+        Url.RemoveFromEnd(TEXT("/"));
+        Url.RemoveFromEnd(TEXT("/chat/completions"));
+        Url.RemoveFromEnd(TEXT("/v1"));
+        return Url;
+    }
+}
+
+bool UN2COpenAICompatibleService::Initialize(const FN2CLLMConfig& InConfig)
+{
+    FN2CLLMConfig UpdatedConfig = InConfig;
+
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (Settings)
+    {
+        const FString MainUrl = Settings->OpenAICompatibleEndpoint.IsEmpty()
+            ? GetBaseUrl(GetDefaultEndpoint()) : GetBaseUrl(Settings->OpenAICompatibleEndpoint);
+        UpdatedConfig.ApiEndpoint = MainUrl + TEXT("/v1/chat/completions");
+        UpdatedConfig.bStreamResponses = InConfig.bStreamResponses && Settings->bOpenAICompatibleStreamResponses;
+
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Using OpenAI-compatible endpoint: %s"), *UpdatedConfig.ApiEndpoint),
+            EN2CLogSeverity::Info,
+            TEXT("OpenAICompatibleService")
+        );
+
+        // Balance requests across the main endpoint and any additional servers. vLLM, TGI and SGLang
+        // all answer /health without an API key
+        TArray<FN2CPooledEndpoint> Endpoints;
+        Endpoints.Add({ UpdatedConfig.ApiEndpoint, MainUrl + TEXT("/health"),
+            Settings->GetProviderRequestLimits(EN2CLLMProvider::OpenAICompatible).MaxConcurrentRequests });
+        for (const FN2CLocalEndpoint& Endpoint : Settings->OpenAICompatibleAdditionalEndpoints)
+        {
+            if (!Endpoint.Url.IsEmpty())
+            {
+                const FString BaseUrl = GetBaseUrl(Endpoint.Url);
+                Endpoints.Add({ BaseUrl + TEXT("/v1/chat/completions"), BaseUrl + TEXT("/health"), Endpoint.MaxConcurrentRequests });
+            }
+        }
+        FN2CLocalEndpointPool::Get().SetEndpoints(EN2CLLMProvider::OpenAICompatible, Endpoints);
+    }
+    else
+    {
+        UpdatedConfig.ApiEndpoint = GetDefaultEndpoint();
+    }
+
+    return Super::Initialize(UpdatedConfig);
+}
+
+UN2CResponseParserBase* UN2COpenAICompatibleService::CreateResponseParser()
+{
+    UN2COpenAICompatibleResponseParser* Parser = NewObject<UN2COpenAICompatibleResponseParser>(this);
+    return Parser;
+}
+
+void UN2COpenAICompatibleService::GetConfiguration(
+    FString& OutEndpoint,
+    FString& OutAuthToken,
+    bool& OutSupportsSystemPrompts)
+{
+    OutEndpoint = Config.ApiEndpoint;
+    OutAuthToken = Config.ApiKey;
+
+    // Chat templates of the served models take a system message
+    OutSupportsSystemPrompts = true;
+}
+
+void UN2COpenAICompatibleService::GetProviderHeaders(TMap<FString, FString>& OutHeaders) const
+{
+    OutHeaders.Add(TEXT("Content-Type"), TEXT("application/json"));
+
+    // Only servers started with an API key check it
+    if (!Config.ApiKey.IsEmpty())
+    {
+        OutHeaders.Add(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *Config.ApiKey));
+    }
+}
+
+TArray<uint8> UN2COpenAICompatibleService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+{
+    // Start the next payload on the shared builder
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForOpenAICompatible();
+
+    // Set common parameters
+    PayloadBuilder.SetTemperature(0.0f);
+    PayloadBuilder.SetMaxTokens(GetMaxOutputTokens(UserMessage));
+
+    // The server's prefix cache only matches tokens identical from the start, so with caching on every
+    // reference file is sent to every request rather than only those the graph uses
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(Config.bUsePromptCaching ? FString() : UserMessage, ReferenceFiles);
+
+    // System prompt, then reference files, then the graph JSON: everything but the graph is shared
+    PayloadBuilder.AddSystemMessage(SystemMessage);
+    PayloadBuilder.AddUserMessageWithPrefix(ReferenceFiles, UserMessage);
+
+    // Constrain decoding to the response schema
+    PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
+
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
+
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
+}
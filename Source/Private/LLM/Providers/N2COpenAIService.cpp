@@ -4,6 +4,7 @@
 
 #include "LLM/N2CLLMModels.h"
 #include "LLM/N2CSystemPromptManager.h"
+#include "Misc/SecureHash.h"
 
 UN2CResponseParserBase* UN2COpenAIService::CreateResponseParser()
 {
@@ -46,7 +47,13 @@ void UN2COpenAIService::GetProviderHeaders(TMap<FString, FString>& OutHeaders) c
     }
 }
 
-FString UN2COpenAIService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
+bool UN2COpenAIService::UsesReasoningTokens() const
+{
+    // max_completion_tokens of the o-series covers their hidden reasoning too
+    return Config.Model.StartsWith(TEXT("o1")) || Config.Model.StartsWith(TEXT("o3")) || Config.Model.StartsWith(TEXT("o4"));
+}
+
+TArray<uint8> UN2COpenAIService::FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const
 {
     // Check if model supports system prompts
     bool bSupportsSystemPrompts = false;
@@ -60,42 +67,56 @@ FString UN2COpenAIService::FormatRequestPayload(const FString& UserMessage, cons
         }
     }
 
-    // Create and configure payload builder
-    UN2CLLMPayloadBuilder* PayloadBuilder = NewObject<UN2CLLMPayloadBuilder>();
-    PayloadBuilder->Initialize(Config.Model);
-    PayloadBuilder->ConfigureForOpenAI();
+    // Start the next payload on the shared builder
+    PayloadBuilder.Initialize(Config.Model);
+    PayloadBuilder.ConfigureForOpenAI();
     
     // Set common parameters
     // Note: Temperature is not supported for o1/o3 models, but the payload builder will handle this
-    PayloadBuilder->SetTemperature(0.0f);
-    PayloadBuilder->SetMaxTokens(8192);
+    PayloadBuilder.SetTemperature(0.0f);
+    PayloadBuilder.SetMaxTokens(GetMaxOutputTokens(UserMessage));
+    if (UsesReasoningTokens() && !Config.Model.StartsWith(TEXT("o1-preview")) && !Config.Model.StartsWith(TEXT("o1-mini")))
+    {
+        PayloadBuilder.SetReasoningEffort(GetReasoningEffort(UserMessage));
+    }
     
     // Add JSON response format for models that support it
     // The payload builder will handle the differences between model types
     if (Config.Model != TEXT("o1-preview-2024-09-12") && Config.Model != TEXT("o1-mini-2024-09-12"))
     {
-        PayloadBuilder->SetJsonResponseFormat(UN2CLLMPayloadBuilder::GetN2CResponseSchema());
+        PayloadBuilder.SetJsonResponseFormat(FN2CLLMPayloadBuilder::GetN2CResponseSchema());
     }
     
-    // Determine final content based on system prompt support
-    FString FinalContent = UserMessage;
+    // Reference source files go ahead of the graph JSON so they form part of the stable prefix
+    FString ReferenceFiles;
+    PromptManager->BuildReferenceSourceFilesBlock(UserMessage, ReferenceFiles);
     
-    // Try prepending source files to the user message
-    PromptManager->PrependSourceFilesToUserMessage(FinalContent);
+    // OpenAI caches identical leading prefixes automatically; the cache key keeps a batch on the same cache
+    PayloadBuilder.SetPromptCaching(Config.bUsePromptCaching);
+    PayloadBuilder.SetPromptCacheKey(
+        FString::Printf(TEXT("n2c-%s"), *FMD5::HashAnsiString(*(Config.Model + SystemMessage + ReferenceFiles))));
     
     // Add messages
     if (bSupportsSystemPrompts)
     {
-        PayloadBuilder->AddSystemMessage(SystemMessage);
-        PayloadBuilder->AddUserMessage(FinalContent);
+        PayloadBuilder.AddSystemMessage(SystemMessage);
+        PayloadBuilder.AddUserMessageWithPrefix(ReferenceFiles, UserMessage);
     }
     else
     {
         // Merge system and user prompts if model doesn't support system prompts
+        FString FinalContent = UserMessage;
+        if (!ReferenceFiles.IsEmpty())
+        {
+            FinalContent = FString::Printf(TEXT("%s\n\n%s"), *ReferenceFiles, *UserMessage);
+        }
         FString MergedContent = PromptManager->MergePrompts(SystemMessage, FinalContent);
-        PayloadBuilder->AddUserMessage(MergedContent);
+        PayloadBuilder.AddUserMessage(MergedContent);
     }
     
-    // Build and return the payload
-    return PayloadBuilder->Build();
+    // Ask for incremental output when streaming is enabled
+    PayloadBuilder.SetStreaming(Config.bStreamResponses);
+    
+    // Build and return the UTF-8 payload bytes
+    return PayloadBuilder.BuildUtf8();
 }
@@ -3,20 +3,212 @@
 #include "Models/N2CBlueprint.h"
 #include "Utils/Validators/N2CBlueprintValidator.h"
 
+bool FN2CGraph::AppendExecutionChain(FString& Out, int32 ChainIndex) const
+{
+    const TConstArrayView<int32> Chain = Flows.GetExecutionChain(ChainIndex);
+    for (const int32 NodeIndex : Chain)
+    {
+        if (!Nodes.IsValidIndex(NodeIndex))
+        {
+            return false;
+        }
+    }
+
+    for (int32 Link = 0; Link < Chain.Num(); ++Link)
+    {
+        if (Link > 0)
+        {
+            Out.Append(TEXT("->"));
+        }
+        Out.Append(Nodes[Chain[Link]].ID);
+    }
+    return true;
+}
+
+bool FN2CGraph::AppendPinReference(FString& Out, int32 NodeIndex, int32 PinIndex) const
+{
+    const FN2CPinDefinition* Pin = Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex].GetPin(PinIndex) : nullptr;
+    if (!Pin)
+    {
+        return false;
+    }
+
+    Out.Append(Nodes[NodeIndex].ID);
+    Out.AppendChar(TEXT('.'));
+    Out.Append(Pin->ID);
+    return true;
+}
+
+void FN2CGraph::RecordReferencedNames()
+{
+    auto AddName = [this](const FString& Name)
+    {
+        if (!Name.IsEmpty())
+        {
+            ReferencedNames.Add(Name);
+        }
+    };
+
+    // Variable and component nodes name their member, and struct, enum and object pins their type
+    for (const FN2CNodeDefinition& Node : Nodes)
+    {
+        AddName(Node.MemberName);
+        for (const FN2CPinDefinition& Pin : Node.InputPins)
+        {
+            AddName(Pin.SubType);
+        }
+        for (const FN2CPinDefinition& Pin : Node.OutputPins)
+        {
+            AddName(Pin.SubType);
+        }
+    }
+
+    for (const FN2CVariable& Var : LocalVariables)
+    {
+        AddName(Var.TypeName);
+        AddName(Var.KeyTypeName);
+    }
+}
+
+float FN2CGraphComplexity::GetScore() const
+{
+    return NumNodes
+        + 2.0f * NumFlowControlNodes
+        + 0.5f * NumCallNodes
+        + 3.0f * NumLatentNodes
+        + NumMacroInstances * (1.0f + MacroDepth)
+        + FMath::Max(MaxBranching - 1, 0)
+        + 0.25f * (NumExecLinks + NumDataFlows);
+}
+
+void FN2CGraph::RecordComplexity()
+{
+    const int32 MacroDepth = Complexity.MacroDepth;
+    Complexity = FN2CGraphComplexity();
+    Complexity.MacroDepth = MacroDepth;
+    Complexity.NumNodes = Nodes.Num();
+    Complexity.NumDataFlows = Flows.Data.Num();
+
+    for (const FN2CNodeDefinition& Node : Nodes)
+    {
+        switch (Node.NodeType)
+        {
+        case EN2CNodeType::Branch:
+        case EN2CNodeType::Select:
+        case EN2CNodeType::Sequence:
+        case EN2CNodeType::ForLoop:
+        case EN2CNodeType::ForEachLoop:
+        case EN2CNodeType::ForEachElementInEnum:
+        case EN2CNodeType::WhileLoop:
+        case EN2CNodeType::Gate:
+        case EN2CNodeType::MultiGate:
+        case EN2CNodeType::DoOnce:
+        case EN2CNodeType::DoOnceMultiInput:
+        case EN2CNodeType::Switch:
+        case EN2CNodeType::SwitchInt:
+        case EN2CNodeType::SwitchString:
+        case EN2CNodeType::SwitchEnum:
+        case EN2CNodeType::SwitchName:
+            Complexity.NumFlowControlNodes++;
+            break;
+        case EN2CNodeType::CallFunction:
+        case EN2CNodeType::CallArrayFunction:
+        case EN2CNodeType::CallDataTableFunction:
+        case EN2CNodeType::CallDelegate:
+        case EN2CNodeType::CallFunctionOnMember:
+        case EN2CNodeType::CallMaterialParameterCollection:
+        case EN2CNodeType::CallParentFunction:
+            Complexity.NumCallNodes++;
+            break;
+        case EN2CNodeType::MacroInstance:
+            Complexity.NumMacroInstances++;
+            break;
+        default:
+            break;
+        }
+
+        if (Node.bLatent || Node.NodeType == EN2CNodeType::AsyncAction || Node.NodeType == EN2CNodeType::BaseAsyncTask
+            || Node.NodeType == EN2CNodeType::Timeline)
+        {
+            Complexity.NumLatentNodes++;
+        }
+    }
+
+    // Chains may share links, so each node's successors are counted once
+    TArray<TSet<int32>> Successors;
+    Successors.SetNum(Nodes.Num());
+    for (int32 ChainIndex = 0; ChainIndex < Flows.NumExecutionChains(); ++ChainIndex)
+    {
+        const TConstArrayView<int32> Chain = Flows.GetExecutionChain(ChainIndex);
+        for (int32 Step = 1; Step < Chain.Num(); ++Step)
+        {
+            if (Nodes.IsValidIndex(Chain[Step - 1]) && Nodes.IsValidIndex(Chain[Step]))
+            {
+                Successors[Chain[Step - 1]].Add(Chain[Step]);
+            }
+        }
+    }
+    for (const TSet<int32>& NodeSuccessors : Successors)
+    {
+        Complexity.NumExecLinks += NodeSuccessors.Num();
+        Complexity.MaxBranching = FMath::Max(Complexity.MaxBranching, NodeSuccessors.Num());
+    }
+}
+
 bool FN2CGraph::IsValid() const
 {
-    // Use the validator to check the graph
-    FN2CBlueprintValidator Validator;
     FString ErrorMessage;
-    return Validator.ValidateGraph(*this, ErrorMessage);
+    return Validate(ErrorMessage);
+}
+
+bool FN2CGraph::Validate(FString& OutError, FN2CBlueprintValidator* Validator) const
+{
+    if (ValidatedGeneration != Generation)
+    {
+        // Use the validator to check the graph
+        FN2CBlueprintValidator LocalValidator;
+        ValidationError.Reset();
+        bValidatedResult = (Validator ? *Validator : LocalValidator).ValidateGraph(*this, ValidationError);
+        ValidatedGeneration = Generation;
+    }
+
+    OutError = ValidationError;
+    return bValidatedResult;
 }
 
 bool FN2CBlueprint::IsValid() const
 {
-    // Use the validator to check the blueprint
-    FN2CBlueprintValidator Validator;
     FString ErrorMessage;
-    return Validator.Validate(*this, ErrorMessage);
+    return Validate(ErrorMessage);
+}
+
+bool FN2CBlueprint::Validate(FString& OutError) const
+{
+    if (ValidatedGeneration != Generation)
+    {
+        // Use the validator to check the blueprint
+        FN2CBlueprintValidator Validator;
+        ValidationError.Reset();
+        bValidatedResult = Validator.Validate(*this, ValidationError);
+        ValidatedGeneration = Generation;
+    }
+
+    OutError = ValidationError;
+    return bValidatedResult;
+}
+
+bool FN2CBlueprint::IsGraphValid(int32 GraphIndex) const
+{
+    return Graphs.IsValidIndex(GraphIndex) && Graphs[GraphIndex].IsValid();
+}
+
+void FN2CBlueprint::MarkModified()
+{
+    ++Generation;
+    for (FN2CGraph& Graph : Graphs)
+    {
+        Graph.MarkModified();
+    }
 }
 
 bool FN2CStruct::IsValid() const
@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Models/N2CCompactGraph.h"
+
+namespace
+{
+    uint32 HashView(FStringView Value)
+    {
+        return FCrc::MemCrc32(Value.GetData(), Value.Len() * sizeof(TCHAR));
+    }
+}
+
+FN2CStringArena::FN2CStringArena()
+{
+    Reset();
+}
+
+int32 FN2CStringArena::Intern(FStringView Value)
+{
+    if (Value.IsEmpty())
+    {
+        return 0;
+    }
+
+    const uint32 Hash = HashView(Value);
+    for (TMultiMap<uint32, int32>::TConstKeyIterator It = Lookup.CreateConstKeyIterator(Hash); It; ++It)
+    {
+        if (Get(It.Value()).Equals(Value, ESearchCase::CaseSensitive))
+        {
+            return It.Value();
+        }
+    }
+
+    FEntry Entry;
+    Entry.Offset = Chars.Num();
+    Entry.Len = Value.Len();
+    Chars.Append(Value.GetData(), Value.Len());
+
+    const int32 Index = Entries.Add(Entry);
+    Lookup.Add(Hash, Index);
+    return Index;
+}
+
+SIZE_T FN2CStringArena::GetAllocatedSize() const
+{
+    return Chars.GetAllocatedSize() + Entries.GetAllocatedSize() + Lookup.GetAllocatedSize();
+}
+
+void FN2CStringArena::Reset()
+{
+    Chars.Reset();
+    Entries.Reset();
+    Lookup.Reset();
+
+    // Index 0 is the empty string
+    Entries.AddDefaulted();
+}
+
+void FN2CCompactGraph::Build(const FN2CGraph& Graph, FN2CStringArena& Arena)
+{
+    Name = Arena.Intern(Graph.Name);
+    GraphType = Graph.GraphType;
+
+    const int32 NodeCount = Graph.Nodes.Num();
+    int32 PinCount = 0;
+    for (const FN2CNodeDefinition& Node : Graph.Nodes)
+    {
+        PinCount += Node.InputPins.Num() + Node.OutputPins.Num();
+    }
+
+    NodeIDs.Reset(NodeCount);
+    NodeTypes.Reset(NodeCount);
+    NodeNames.Reset(NodeCount);
+    NodeMemberParents.Reset(NodeCount);
+    NodeMemberNames.Reset(NodeCount);
+    NodeComments.Reset(NodeCount);
+    NodeFlags.Reset(NodeCount);
+    NodeFirstPin.Reset(NodeCount);
+    NodeInputPinCounts.Reset(NodeCount);
+    NodeOutputPinCounts.Reset(NodeCount);
+
+    PinIDs.Reset(PinCount);
+    PinNames.Reset(PinCount);
+    PinTypes.Reset(PinCount);
+    PinSubTypes.Reset(PinCount);
+    PinDefaultValues.Reset(PinCount);
+    PinFlags.Reset(PinCount);
+
+    auto AddPin = [this, &Arena](const FN2CPinDefinition& Pin)
+    {
+        PinIDs.Add(Arena.Intern(Pin.ID));
+        PinNames.Add(Arena.Intern(Pin.Name));
+        PinTypes.Add(Pin.Type);
+        PinSubTypes.Add(Arena.Intern(Pin.SubType));
+        PinDefaultValues.Add(Arena.Intern(Pin.DefaultValue));
+        PinFlags.Add(static_cast<uint8>(
+            (Pin.bConnected ? PinConnected : 0) |
+            (Pin.bIsReference ? PinReference : 0) |
+            (Pin.bIsConst ? PinConst : 0) |
+            (Pin.bIsArray ? PinArray : 0) |
+            (Pin.bIsMap ? PinMap : 0) |
+            (Pin.bIsSet ? PinSet : 0)));
+    };
+
+    for (const FN2CNodeDefinition& Node : Graph.Nodes)
+    {
+        NodeIDs.Add(Arena.Intern(Node.ID));
+        NodeTypes.Add(Node.NodeType);
+        NodeNames.Add(Arena.Intern(Node.Name));
+        NodeMemberParents.Add(Arena.Intern(Node.GetCleanMemberParent()));
+        NodeMemberNames.Add(Arena.Intern(Node.MemberName));
+        NodeComments.Add(Arena.Intern(Node.Comment));
+        NodeFlags.Add(static_cast<uint8>((Node.bPure ? NodePure : 0) | (Node.bLatent ? NodeLatent : 0)));
+        NodeFirstPin.Add(PinIDs.Num());
+        NodeInputPinCounts.Add(static_cast<uint16>(FMath::Min(Node.InputPins.Num(), static_cast<int32>(MAX_uint16))));
+        NodeOutputPinCounts.Add(static_cast<uint16>(FMath::Min(Node.OutputPins.Num(), static_cast<int32>(MAX_uint16))));
+
+        for (int32 Index = 0; Index < NodeInputPinCounts.Last(); ++Index)
+        {
+            AddPin(Node.InputPins[Index]);
+        }
+        for (int32 Index = 0; Index < NodeOutputPinCounts.Last(); ++Index)
+        {
+            AddPin(Node.OutputPins[Index]);
+        }
+    }
+
+    Flows = Graph.Flows;
+}
+
+SIZE_T FN2CCompactGraph::GetAllocatedSize() const
+{
+    return NodeIDs.GetAllocatedSize() + NodeTypes.GetAllocatedSize() + NodeNames.GetAllocatedSize()
+        + NodeMemberParents.GetAllocatedSize() + NodeMemberNames.GetAllocatedSize() + NodeComments.GetAllocatedSize()
+        + NodeFlags.GetAllocatedSize() + NodeFirstPin.GetAllocatedSize()
+        + NodeInputPinCounts.GetAllocatedSize() + NodeOutputPinCounts.GetAllocatedSize()
+        + PinIDs.GetAllocatedSize() + PinNames.GetAllocatedSize() + PinTypes.GetAllocatedSize()
+        + PinSubTypes.GetAllocatedSize() + PinDefaultValues.GetAllocatedSize() + PinFlags.GetAllocatedSize()
+        + Flows.ExecutionNodes.GetAllocatedSize() + Flows.ExecutionChainStarts.GetAllocatedSize() + Flows.Data.GetAllocatedSize();
+}
@@ -0,0 +1,204 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Models/N2CGraphDelta.h"
+
+namespace
+{
+    /** What a node is, as opposed to how it is configured */
+    FString GetNodeIdentity(const FN2CNodeDefinition& Node)
+    {
+        return FString::Printf(TEXT("%d|%s|%s|%s"), static_cast<int32>(Node.NodeType), *Node.Name, *Node.MemberParent, *Node.MemberName);
+    }
+
+    bool PinsEqual(const FN2CPinDefinition& A, const FN2CPinDefinition& B)
+    {
+        return A.Name == B.Name && A.Type == B.Type && A.SubType == B.SubType && A.DefaultValue == B.DefaultValue
+            && A.bConnected == B.bConnected && A.bIsReference == B.bIsReference && A.bIsConst == B.bIsConst
+            && A.bIsArray == B.bIsArray && A.bIsMap == B.bIsMap && A.bIsSet == B.bIsSet;
+    }
+
+    bool PinArraysEqual(const TArray<FN2CPinDefinition>& A, const TArray<FN2CPinDefinition>& B)
+    {
+        if (A.Num() != B.Num())
+        {
+            return false;
+        }
+        for (int32 PinIndex = 0; PinIndex < A.Num(); ++PinIndex)
+        {
+            if (!PinsEqual(A[PinIndex], B[PinIndex]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Whether a matched node is configured the same in both versions */
+    bool NodesEqual(const FN2CNodeDefinition& A, const FN2CNodeDefinition& B)
+    {
+        return A.Comment == B.Comment && A.bPure == B.bPure && A.bLatent == B.bLatent
+            && PinArraysEqual(A.InputPins, B.InputPins) && PinArraysEqual(A.OutputPins, B.OutputPins);
+    }
+
+    /** Each exec link once, in chain order, though chains may share links */
+    void CollectExecLinks(const FN2CGraph& Graph, TArray<FN2CGraphDelta::FExecLink>& OutLinks)
+    {
+        TSet<FN2CGraphDelta::FExecLink> Seen;
+        for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
+        {
+            const TConstArrayView<int32> Chain = Graph.Flows.GetExecutionChain(ChainIndex);
+            for (int32 Step = 1; Step < Chain.Num(); ++Step)
+            {
+                if (!Graph.Nodes.IsValidIndex(Chain[Step - 1]) || !Graph.Nodes.IsValidIndex(Chain[Step]))
+                {
+                    continue;
+                }
+
+                const FN2CGraphDelta::FExecLink Link = { Chain[Step - 1], Chain[Step] };
+                bool bAlreadySeen = false;
+                Seen.Add(Link, &bAlreadySeen);
+                if (!bAlreadySeen)
+                {
+                    OutLinks.Add(Link);
+                }
+            }
+        }
+    }
+
+    uint32 HashDataFlow(const FN2CDataFlow& Flow)
+    {
+        return HashCombine(HashCombine(::GetTypeHash(Flow.SourceNode), ::GetTypeHash(Flow.SourcePin)),
+            HashCombine(::GetTypeHash(Flow.TargetNode), ::GetTypeHash(Flow.TargetPin)));
+    }
+
+    bool DataFlowsEqual(const FN2CDataFlow& A, const FN2CDataFlow& B)
+    {
+        return A.SourceNode == B.SourceNode && A.SourcePin == B.SourcePin && A.TargetNode == B.TargetNode && A.TargetPin == B.TargetPin;
+    }
+
+    bool ContainsDataFlow(const TMultiMap<uint32, int32>& Lookup, const TArray<FN2CDataFlow>& Flows, const FN2CDataFlow& Flow)
+    {
+        for (TMultiMap<uint32, int32>::TConstKeyIterator It = Lookup.CreateConstKeyIterator(HashDataFlow(Flow)); It; ++It)
+        {
+            if (DataFlowsEqual(Flows[It.Value()], Flow))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+FN2CGraphDelta FN2CGraphDelta::Compute(const FN2CGraph& Previous, const FN2CGraph& Current)
+{
+    FN2CGraphDelta Delta;
+    Delta.NumNodes = FMath::Max(Previous.Nodes.Num(), Current.Nodes.Num());
+
+    // Unmatched previous nodes by identity, in graph order
+    TMap<FString, TArray<int32>> Candidates;
+    for (int32 NodeIndex = 0; NodeIndex < Previous.Nodes.Num(); ++NodeIndex)
+    {
+        Candidates.FindOrAdd(GetNodeIdentity(Previous.Nodes[NodeIndex])).Add(NodeIndex);
+    }
+
+    Delta.PreviousToCurrent.Init(INDEX_NONE, Previous.Nodes.Num());
+    for (int32 NodeIndex = 0; NodeIndex < Current.Nodes.Num(); ++NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Current.Nodes[NodeIndex];
+        TArray<int32>* Matches = Candidates.Find(GetNodeIdentity(Node));
+        if (!Matches || Matches->Num() == 0)
+        {
+            Delta.AddedNodes.Add(NodeIndex);
+            continue;
+        }
+
+        // Nodes extracted before any insertion keep their IDs, so prefer one that did
+        int32 MatchSlot = Matches->IndexOfByPredicate([&Previous, &Node](int32 PreviousIndex) { return Previous.Nodes[PreviousIndex].ID == Node.ID; });
+        if (MatchSlot == INDEX_NONE)
+        {
+            MatchSlot = 0;
+        }
+        const int32 PreviousIndex = (*Matches)[MatchSlot];
+        Matches->RemoveAt(MatchSlot);
+
+        Delta.PreviousToCurrent[PreviousIndex] = NodeIndex;
+        if (!NodesEqual(Previous.Nodes[PreviousIndex], Node))
+        {
+            Delta.ChangedNodes.Add(NodeIndex);
+        }
+    }
+
+    for (int32 NodeIndex = 0; NodeIndex < Previous.Nodes.Num(); ++NodeIndex)
+    {
+        if (Delta.PreviousToCurrent[NodeIndex] == INDEX_NONE)
+        {
+            Delta.RemovedNodes.Add(NodeIndex);
+        }
+    }
+
+    // Exec links, compared in current indices
+    TArray<FExecLink> PreviousLinks;
+    TArray<FExecLink> CurrentLinks;
+    CollectExecLinks(Previous, PreviousLinks);
+    CollectExecLinks(Current, CurrentLinks);
+    const TSet<FExecLink> CurrentLinkSet(CurrentLinks);
+
+    TSet<FExecLink> MappedPreviousLinks;
+    for (const FExecLink& Link : PreviousLinks)
+    {
+        const FExecLink Mapped = { Delta.PreviousToCurrent[Link.From], Delta.PreviousToCurrent[Link.To] };
+        if (Mapped.From == INDEX_NONE || Mapped.To == INDEX_NONE || !CurrentLinkSet.Contains(Mapped))
+        {
+            Delta.RemovedExecLinks.Add(Link);
+        }
+        else
+        {
+            MappedPreviousLinks.Add(Mapped);
+        }
+    }
+    for (const FExecLink& Link : CurrentLinks)
+    {
+        if (!MappedPreviousLinks.Contains(Link))
+        {
+            Delta.AddedExecLinks.Add(Link);
+        }
+    }
+
+    // Data flows, compared the same way
+    TMultiMap<uint32, int32> CurrentFlowLookup;
+    for (int32 FlowIndex = 0; FlowIndex < Current.Flows.Data.Num(); ++FlowIndex)
+    {
+        CurrentFlowLookup.Add(HashDataFlow(Current.Flows.Data[FlowIndex]), FlowIndex);
+    }
+
+    TArray<FN2CDataFlow> MappedPreviousFlows;
+    TMultiMap<uint32, int32> MappedFlowLookup;
+    for (const FN2CDataFlow& Flow : Previous.Flows.Data)
+    {
+        if (!Previous.Nodes.IsValidIndex(Flow.SourceNode) || !Previous.Nodes.IsValidIndex(Flow.TargetNode))
+        {
+            continue;
+        }
+
+        const FN2CDataFlow Mapped(Delta.PreviousToCurrent[Flow.SourceNode], Flow.SourcePin, Delta.PreviousToCurrent[Flow.TargetNode], Flow.TargetPin);
+        if (Mapped.SourceNode == INDEX_NONE || Mapped.TargetNode == INDEX_NONE
+            || !ContainsDataFlow(CurrentFlowLookup, Current.Flows.Data, Mapped))
+        {
+            Delta.RemovedDataFlows.Add(Flow);
+        }
+        else
+        {
+            MappedFlowLookup.Add(HashDataFlow(Mapped), MappedPreviousFlows.Add(Mapped));
+        }
+    }
+    for (const FN2CDataFlow& Flow : Current.Flows.Data)
+    {
+        if (Current.Nodes.IsValidIndex(Flow.SourceNode) && Current.Nodes.IsValidIndex(Flow.TargetNode)
+            && !ContainsDataFlow(MappedFlowLookup, MappedPreviousFlows, Flow))
+        {
+            Delta.AddedDataFlows.Add(Flow);
+        }
+    }
+
+    return Delta;
+}
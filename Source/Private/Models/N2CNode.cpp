@@ -9,3 +9,22 @@ bool FN2CNodeDefinition::IsValid() const
     FString ErrorMessage;
     return Validator.Validate(*this, ErrorMessage);
 }
+
+int32 FN2CNodeDefinition::FindPinIndex(FStringView PinID) const
+{
+    for (int32 Index = 0; Index < InputPins.Num(); ++Index)
+    {
+        if (PinID == InputPins[Index].ID)
+        {
+            return Index;
+        }
+    }
+    for (int32 Index = 0; Index < OutputPins.Num(); ++Index)
+    {
+        if (PinID == OutputPins[Index].ID)
+        {
+            return InputPins.Num() + Index;
+        }
+    }
+    return INDEX_NONE;
+}
@@ -8,11 +8,14 @@
 #include "Models/N2CLogging.h"
 #include "Core/N2CEditorIntegration.h"
 #include "Core/N2CSettings.h"
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "LLM/N2CPromptFileCache.h"
+#include "LLM/N2CReferenceIndex.h"
+#include "LLM/N2CTranslationHistory.h"
 #include "Code Editor/Models/N2CCodeEditorStyle.h"
-#include "Code Editor/Syntax/N2CSyntaxDefinitionFactory.h"
 #include "Code Editor/Widgets/N2CCodeEditorWidgetFactory.h"
-#include "Editor/EditorPerformanceSettings.h"
 #include "Models/N2CStyle.h"
+#include "Utils/N2CTelemetry.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #if WITH_EDITOR
@@ -31,30 +34,20 @@ void FNodeToCodeModule::StartupModule()
     // Configure HTTP timeout settings for LLM operations
     ConfigureHttpTimeouts();
     
-    // Force disable "Use Less CPU when in Background" setting to prevent HTTP request issues when the editor is not focused
-    if (GEditor)
-    {
-        UEditorPerformanceSettings* PerfSettings = GetMutableDefault<UEditorPerformanceSettings>();
-        if (PerfSettings)
-        {
-            PerfSettings->bThrottleCPUWhenNotForeground = false;
-            PerfSettings->SaveConfig();
-            FN2CLogger::Get().Log(TEXT("Disabled 'Use Less CPU when in Background' setting"), EN2CLogSeverity::Info);
-        }
-    }
+    // "Use Less CPU when in Background" is only turned off while requests are in flight, by FN2CLLMRequestScheduler
 
-    // Load user secrets
-    UN2CUserSecrets* UserSecrets = NewObject<UN2CUserSecrets>();
-    UserSecrets->LoadSecrets();
-    
     // Apply configured log severity from settings
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
     if (Settings)
     {
         FN2CLogger::Get().SetMinSeverity(Settings->MinSeverity);
+        FN2CLogger::Get().EnableArchive(Settings->bArchiveEvictedLogs);
         FN2CLogger::Get().Log(TEXT("Applied log severity from settings"), EN2CLogSeverity::Debug);
     }
 
+    // Start exporting telemetry if enabled
+    FN2CTelemetry::Get().ApplySettings();
+
     
     // Initialize style system
     N2CStyle::Initialize();
@@ -71,23 +64,8 @@ void FNodeToCodeModule::StartupModule()
     // Register widget factory
     FN2CCodeEditorWidgetFactory::Register();
     FN2CLogger::Get().Log(TEXT("Widget factory registered"), EN2CLogSeverity::Debug);
-    
-    // Verify syntax factory is working
-    auto CPPSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::Cpp);
-    auto PythonSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::Python);
-    auto JSSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::JavaScript);
-    auto CSharpSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::CSharp);
-    auto SwiftSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::Swift);
-    auto PseudocodeSyntax = FN2CSyntaxDefinitionFactory::Get().CreateDefinition(EN2CCodeLanguage::Pseudocode);
-
-    if (!CPPSyntax || !PythonSyntax || !JSSyntax || !CSharpSyntax || !SwiftSyntax || !PseudocodeSyntax)
-    {
-        FN2CLogger::Get().LogError(TEXT("Failed to initialize syntax definitions"), TEXT("NodeToCode"));
-    }
-    else 
-    {
-        FN2CLogger::Get().Log(TEXT("Syntax definitions initialized successfully"), EN2CLogSeverity::Debug);
-    }
+
+    // Syntax definitions are built on demand by FN2CSyntaxDefinitionFactory when an editor first needs them
 }
 
 void FNodeToCodeModule::ShutdownModule()
@@ -96,9 +74,30 @@ void FNodeToCodeModule::ShutdownModule()
     UToolMenus::UnRegisterStartupCallback(this);
     UToolMenus::UnregisterOwner(this);
 
+    // Write API key edits that are still waiting to be saved
+    if (const UN2CSettings* Settings = GetDefault<UN2CSettings>())
+    {
+        Settings->FlushUserSecrets();
+    }
+
     // Shutdown editor integration
     FN2CEditorIntegration::Get().Shutdown();
 
+    // Stop watching prompt and reference file directories
+    FN2CPromptFileCache::Get().Shutdown();
+
+    // Give the user's background CPU setting back if requests are still in flight
+    FN2CLLMRequestScheduler::Get().RestoreBackgroundThrottling();
+
+    // Let a reference index build finish saving
+    FN2CReferenceIndex::Get().Shutdown();
+
+    // Write translation history recorded since the last run began or ended
+    FN2CTranslationHistory::Get().Flush();
+
+    // Export the last telemetry interval
+    FN2CTelemetry::Get().Shutdown();
+
     // Unregister widget factory
     FN2CCodeEditorWidgetFactory::Unregister();
 
@@ -115,6 +114,7 @@ void FNodeToCodeModule::ShutdownModule()
     }
 
     FN2CLogger::Get().Log(TEXT("NodeToCode plugin shutting down"), EN2CLogSeverity::Info);
+    FN2CLogger::Get().Flush();
 }
 
 void FNodeToCodeModule::ConfigureHttpTimeouts()
@@ -0,0 +1,161 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Utils/N2CJsonEscape.h"
+
+namespace
+{
+    bool NeedsEscape(const TCHAR Char)
+    {
+        return Char < TEXT(' ') || Char == TEXT('\"') || Char == TEXT('\\');
+    }
+
+    /** Write the escape sequence for Char into Buffer and return its length */
+    int32 GetEscapeSequence(const TCHAR Char, ANSICHAR (&Buffer)[8])
+    {
+        ANSICHAR Short = 0;
+        switch (Char)
+        {
+        case TEXT('\"'): Short = '\"'; break;
+        case TEXT('\\'): Short = '\\'; break;
+        case TEXT('\n'): Short = 'n'; break;
+        case TEXT('\t'): Short = 't'; break;
+        case TEXT('\b'): Short = 'b'; break;
+        case TEXT('\f'): Short = 'f'; break;
+        case TEXT('\r'): Short = 'r'; break;
+        default: break;
+        }
+
+        Buffer[0] = '\\';
+        if (Short != 0)
+        {
+            Buffer[1] = Short;
+            return 2;
+        }
+
+        static const ANSICHAR HexDigits[] = "0123456789abcdef";
+        const uint32 Code = static_cast<uint32>(Char);
+        Buffer[1] = 'u';
+        Buffer[2] = HexDigits[(Code >> 12) & 0xF];
+        Buffer[3] = HexDigits[(Code >> 8) & 0xF];
+        Buffer[4] = HexDigits[(Code >> 4) & 0xF];
+        Buffer[5] = HexDigits[Code & 0xF];
+        return 6;
+    }
+
+    /** Nonzero if any 16-bit lane of Word is zero */
+    constexpr uint64 HasZeroLane(const uint64 Word)
+    {
+        return (Word - 0x0001000100010001ull) & ~Word & 0x8000800080008000ull;
+    }
+}
+
+int32 FN2CJsonEscape::FindCleanRun(const TCHAR* Chars, int32 Num, bool bAsciiOnly)
+{
+    int32 Index = 0;
+
+    if constexpr (sizeof(TCHAR) == sizeof(uint16))
+    {
+        // Four characters per word; a flagged word is rescanned one character at a time below
+        constexpr uint64 Lanes = 0x0001000100010001ull;
+        const uint64 HighMask = bAsciiOnly ? Lanes * 0xFF80 : 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            uint64 Word;
+            FMemory::Memcpy(&Word, Chars + Index, sizeof(Word));
+
+            const uint64 Control = (Word - Lanes * 0x20) & ~Word & (Lanes * 0x8000);
+            const uint64 Flags = Control | HasZeroLane(Word ^ (Lanes * '\"')) | HasZeroLane(Word ^ (Lanes * '\\')) | (Word & HighMask);
+            if (Flags != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    for (; Index < Num; ++Index)
+    {
+        if (NeedsEscape(Chars[Index]) || (bAsciiOnly && Chars[Index] >= 0x80))
+        {
+            break;
+        }
+    }
+    return Index;
+}
+
+void FN2CJsonEscape::AppendQuoted(FString& Out, FStringView Value)
+{
+    const TCHAR* Chars = Value.GetData();
+    const int32 Num = Value.Len();
+
+    Out.AppendChar(TEXT('"'));
+    int32 Index = 0;
+    while (Index < Num)
+    {
+        const int32 Run = FindCleanRun(Chars + Index, Num - Index, false);
+        Out.Append(Chars + Index, Run);
+        Index += Run;
+
+        if (Index < Num)
+        {
+            ANSICHAR Escape[8];
+            const int32 EscapeLen = GetEscapeSequence(Chars[Index++], Escape);
+            for (int32 EscapeIndex = 0; EscapeIndex < EscapeLen; ++EscapeIndex)
+            {
+                Out.AppendChar(static_cast<TCHAR>(Escape[EscapeIndex]));
+            }
+        }
+    }
+    Out.AppendChar(TEXT('"'));
+}
+
+void FN2CJsonEscape::AppendQuotedUtf8(TArray<uint8>& Out, FStringView Value)
+{
+    Out.Add('"');
+    AppendEscapedUtf8(Out, Value);
+    Out.Add('"');
+}
+
+void FN2CJsonEscape::AppendEscapedUtf8(TArray<uint8>& Out, FStringView Value)
+{
+    const TCHAR* Chars = Value.GetData();
+    const int32 Num = Value.Len();
+
+    int32 Index = 0;
+    while (Index < Num)
+    {
+        // Clean ASCII narrows byte for byte
+        const int32 Run = FindCleanRun(Chars + Index, Num - Index, true);
+        if (Run > 0)
+        {
+            const int32 Start = Out.AddUninitialized(Run);
+            uint8* Dest = Out.GetData() + Start;
+            for (int32 RunIndex = 0; RunIndex < Run; ++RunIndex)
+            {
+                Dest[RunIndex] = static_cast<uint8>(Chars[Index + RunIndex]);
+            }
+            Index += Run;
+        }
+        if (Index >= Num)
+        {
+            break;
+        }
+
+        if (NeedsEscape(Chars[Index]))
+        {
+            ANSICHAR Escape[8];
+            const int32 EscapeLen = GetEscapeSequence(Chars[Index++], Escape);
+            Out.Append(reinterpret_cast<const uint8*>(Escape), EscapeLen);
+            continue;
+        }
+
+        // Convert the whole non-ASCII run at once, so surrogate pairs stay together
+        int32 WideEnd = Index + 1;
+        while (WideEnd < Num && Chars[WideEnd] >= 0x80)
+        {
+            ++WideEnd;
+        }
+        const FTCHARToUTF8 Converted(Chars + Index, WideEnd - Index);
+        Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+        Index = WideEnd;
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Utils/N2CLogFileWriter.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
+
+FN2CLogFileWriter::~FN2CLogFileWriter()
+{
+    // Static destruction may come after the task system is gone, so a running drain isn't waited for
+    if (!bWriting.load())
+    {
+        File.Reset();
+    }
+    else
+    {
+        File.Release();
+    }
+}
+
+void FN2CLogFileWriter::Write(FString&& Line)
+{
+    Queue.Enqueue(MoveTemp(Line));
+
+    bool bExpected = false;
+    if (bWriting.compare_exchange_strong(bExpected, true))
+    {
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { DrainQueue(); });
+    }
+}
+
+void FN2CLogFileWriter::Flush()
+{
+    Acquire();
+    WriteQueued();
+    if (File.IsValid())
+    {
+        File->Flush();
+    }
+    bWriting.store(false);
+}
+
+void FN2CLogFileWriter::SetFilePath(const FString& Path)
+{
+    Acquire();
+    WriteQueued();
+    if (Path != FilePath)
+    {
+        File.Reset();
+        FilePath = Path;
+    }
+    bWriting.store(false);
+}
+
+void FN2CLogFileWriter::Close()
+{
+    Acquire();
+    WriteQueued();
+    File.Reset();
+    bWriting.store(false);
+}
+
+void FN2CLogFileWriter::Acquire()
+{
+    bool bExpected = false;
+    while (!bWriting.compare_exchange_weak(bExpected, true))
+    {
+        bExpected = false;
+        FPlatformProcess::Yield();
+    }
+}
+
+void FN2CLogFileWriter::DrainQueue()
+{
+    while (true)
+    {
+        WriteQueued();
+        if (File.IsValid())
+        {
+            File->Flush();
+        }
+        bWriting.store(false);
+
+        // A line queued after the last dequeue saw the role taken and left it to this drain
+        bool bExpected = false;
+        if (Queue.IsEmpty() || !bWriting.compare_exchange_strong(bExpected, true))
+        {
+            return;
+        }
+    }
+}
+
+void FN2CLogFileWriter::WriteQueued()
+{
+    if (Queue.IsEmpty())
+    {
+        return;
+    }
+
+    FString Block;
+    FString Line;
+    while (Queue.Dequeue(Line))
+    {
+        Block += Line;
+        Block += LINE_TERMINATOR;
+    }
+
+    if (EnsureFileOpen())
+    {
+        const FTCHARToUTF8 Utf8(*Block, Block.Len());
+        File->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+    }
+}
+
+bool FN2CLogFileWriter::EnsureFileOpen()
+{
+    if (File.IsValid())
+    {
+        return true;
+    }
+    if (FilePath.IsEmpty())
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    File.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+    return File.IsValid();
+}
@@ -1,6 +1,8 @@
 // Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
 
 #include "Utils/N2CLogger.h"
+#include "Utils/N2CStats.h"
+#include "LLM/N2CTranslationOutputWriter.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFilemanager.h"
@@ -13,19 +15,31 @@ FN2CLogger& FN2CLogger::Get()
 }
 
 FN2CLogger::FN2CLogger()
-    : MinSeverity(EN2CLogSeverity::Info)
+    : bArchiveEnabled(false)
+    , MinSeverity(EN2CLogSeverity::Info)
     , bFileLoggingEnabled(false)
     , LogFilePath(FPaths::ProjectSavedDir() / TEXT("NodeToCode.log"))
 {
+    FileWriter.SetFilePath(LogFilePath);
+    ArchiveWriter.SetFilePath(FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("NodeToCodeArchive.log"));
+
+    // Fewer of the frequent low-severity entries are worth keeping
+    Rings[static_cast<int32>(EN2CLogSeverity::Debug)].Capacity = 256;
+    Rings[static_cast<int32>(EN2CLogSeverity::Info)].Capacity = 512;
+    Rings[static_cast<int32>(EN2CLogSeverity::Warning)].Capacity = 1024;
+    Rings[static_cast<int32>(EN2CLogSeverity::Error)].Capacity = 1024;
+    Rings[static_cast<int32>(EN2CLogSeverity::Fatal)].Capacity = 256;
 }
 
 void FN2CLogger::Log(const FString& Message, EN2CLogSeverity Severity, const FString& Context)
 {
-    if (Severity < MinSeverity)
+    if (!IsEnabled(Severity))
     {
         return;
     }
 
+    LLM_SCOPE_BYTAG(NodeToCode_Logger);
+
     // Create error record
     FN2CError Error;
     Error.Message = Message;
@@ -33,16 +47,30 @@ void FN2CLogger::Log(const FString& Message, EN2CLogSeverity Severity, const FSt
     Error.Context = Context;
     Error.Timestamp = FDateTime::Now();
 
-    // Add to collection
-    LoggedErrors.Add(Error);
-
     // Format for output
     FString FormattedMessage = FormatError(Error);
 
     // Write to log file if enabled
-    if (bFileLoggingEnabled)
+    WriteToFile(FormattedMessage);
+
+    // Keep a bounded copy; the full message went to the file and output log
+    if (Error.Message.Len() > MaxRetainedMessageLength)
+    {
+        Error.Message.LeftInline(MaxRetainedMessageLength);
+        Error.Message += TEXT("...");
+    }
+
+    FThreadBuffer& Buffer = GetThreadBuffer();
+    bool bMerge = false;
+    {
+        FScopeLock BufferLock(&Buffer.Lock);
+        Buffer.Entries.Add({ MoveTemp(Error), NextSequence.fetch_add(1) });
+        bMerge = Buffer.Entries.Num() >= ThreadBufferMergeCount;
+    }
+    if (bMerge)
     {
-        WriteToFile(FormattedMessage);
+        FScopeLock Lock(&LogLock);
+        MergeThreadBuffers();
     }
 
     // Output to console window
@@ -66,6 +94,12 @@ void FN2CLogger::Log(const FString& Message, EN2CLogSeverity Severity, const FSt
             break;
     }
 
+    // A fatal log ends the process, so whatever is queued for the file goes out first
+    if (Severity == EN2CLogSeverity::Fatal)
+    {
+        Flush();
+    }
+
     // Output to NodeToCode log
     switch (Severity)
     {
@@ -97,27 +131,194 @@ void FN2CLogger::LogWarning(const FString& Message, const FString& Context)
     Log(Message, EN2CLogSeverity::Warning, Context);
 }
 
-TArray<FN2CError> FN2CLogger::GetErrors() const
+void FN2CLogger::LogPayload(const FString& Label, const FString& Payload, EN2CLogSeverity Severity, const FString& Context)
+{
+    if (!IsEnabled(Severity))
+    {
+        return;
+    }
+
+    if (Payload.Len() <= MaxInlinePayloadLength)
+    {
+        Log(FString::Printf(TEXT("%s:\n%s"), *Label, *Payload), Severity, Context);
+        return;
+    }
+
+    // Numbered so payloads logged within the same millisecond don't overwrite each other
+    static std::atomic<uint32> PayloadCounter{ 0 };
+    const FString FileName = FString::Printf(TEXT("%s_%s_%u.txt"),
+        *FPaths::MakeValidFileName(Label, TEXT('_')),
+        *FDateTime::Now().ToString(TEXT("%Y-%m-%d-%H.%M.%S.%s")),
+        PayloadCounter.fetch_add(1));
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Payloads") / FileName;
+    FN2CTranslationOutputWriter::Get().Write(FilePath, CopyTemp(Payload));
+
+    Log(FString::Printf(TEXT("%s (%d characters, written to %s):\n%s..."),
+        *Label, Payload.Len(), *FilePath, *Payload.Left(MaxInlinePayloadLength)), Severity, Context);
+}
+
+TArray<FN2CError> FN2CLogger::GetErrors()
 {
-    return LoggedErrors;
+    FScopeLock Lock(&LogLock);
+    MergeThreadBuffers();
+
+    TArray<const FRetainedEntry*> Entries;
+    for (const FEntryRing& Ring : Rings)
+    {
+        Entries.Append(GetOrderedEntries(Ring));
+    }
+    Entries.Sort([](const FRetainedEntry& A, const FRetainedEntry& B) { return A.Sequence < B.Sequence; });
+
+    TArray<FN2CError> Errors;
+    Errors.Reserve(Entries.Num());
+    for (const FRetainedEntry* Entry : Entries)
+    {
+        Errors.Add(Entry->Error);
+    }
+    return Errors;
 }
 
-TArray<FN2CError> FN2CLogger::GetErrorsBySeverity(EN2CLogSeverity Severity) const
+TArray<FN2CError> FN2CLogger::GetErrorsBySeverity(EN2CLogSeverity Severity)
 {
+    FScopeLock Lock(&LogLock);
+    MergeThreadBuffers();
     TArray<FN2CError> FilteredErrors;
-    for (const FN2CError& Error : LoggedErrors)
+    for (const FRetainedEntry* Entry : GetOrderedEntries(Rings[static_cast<int32>(Severity)]))
     {
-        if (Error.Severity == Severity)
-        {
-            FilteredErrors.Add(Error);
-        }
+        FilteredErrors.Add(Entry->Error);
     }
     return FilteredErrors;
 }
 
 void FN2CLogger::ClearErrors()
 {
-    LoggedErrors.Empty();
+    FScopeLock Lock(&LogLock);
+    for (const TSharedRef<FThreadBuffer, ESPMode::ThreadSafe>& Buffer : ThreadBuffers)
+    {
+        FScopeLock BufferLock(&Buffer->Lock);
+        Buffer->Entries.Empty();
+    }
+    for (FEntryRing& Ring : Rings)
+    {
+        Ring.Entries.Empty();
+        Ring.Head = 0;
+    }
+}
+
+void FN2CLogger::SetRetention(EN2CLogSeverity Severity, int32 MaxEntries)
+{
+    FScopeLock Lock(&LogLock);
+    MergeThreadBuffers();
+
+    FEntryRing& Ring = Rings[static_cast<int32>(Severity)];
+    MaxEntries = FMath::Max(MaxEntries, 1);
+    if (MaxEntries == Ring.Capacity)
+    {
+        return;
+    }
+
+    // Unroll the ring oldest first, then drop what no longer fits
+    TArray<FRetainedEntry> Entries;
+    Entries.Reserve(Ring.Entries.Num());
+    for (int32 Offset = 0; Offset < Ring.Entries.Num(); ++Offset)
+    {
+        Entries.Add(MoveTemp(Ring.Entries[(Ring.Head + Offset) % Ring.Entries.Num()]));
+    }
+
+    const int32 NumDropped = FMath::Max(Entries.Num() - MaxEntries, 0);
+    for (int32 Index = 0; Index < NumDropped; ++Index)
+    {
+        ArchiveEntry(Entries[Index].Error);
+    }
+    Entries.RemoveAt(0, NumDropped);
+
+    Ring.Entries = MoveTemp(Entries);
+    Ring.Head = 0;
+    Ring.Capacity = MaxEntries;
+}
+
+void FN2CLogger::EnableArchive(bool bEnable)
+{
+    bArchiveEnabled = bEnable;
+}
+
+void FN2CLogger::SetArchiveFilePath(const FString& Path)
+{
+    ArchiveWriter.SetFilePath(Path);
+}
+
+void FN2CLogger::Flush()
+{
+    FileWriter.Flush();
+    ArchiveWriter.Flush();
+}
+
+TArray<const FN2CLogger::FRetainedEntry*> FN2CLogger::GetOrderedEntries(const FEntryRing& Ring)
+{
+    TArray<const FRetainedEntry*> Entries;
+    Entries.Reserve(Ring.Entries.Num());
+    for (int32 Offset = 0; Offset < Ring.Entries.Num(); ++Offset)
+    {
+        Entries.Add(&Ring.Entries[(Ring.Head + Offset) % Ring.Entries.Num()]);
+    }
+    return Entries;
+}
+
+void FN2CLogger::RetainEntry(FRetainedEntry&& Entry)
+{
+    FEntryRing& Ring = Rings[static_cast<int32>(Entry.Error.Severity)];
+
+    if (Ring.Entries.Num() < Ring.Capacity)
+    {
+        Ring.Entries.Add(MoveTemp(Entry));
+        return;
+    }
+
+    // Full: overwrite the oldest entry and move the head past it
+    ArchiveEntry(Ring.Entries[Ring.Head].Error);
+    Ring.Entries[Ring.Head] = MoveTemp(Entry);
+    Ring.Head = (Ring.Head + 1) % Ring.Entries.Num();
+}
+
+FN2CLogger::FThreadBuffer& FN2CLogger::GetThreadBuffer()
+{
+    // The logger is a singleton, so one buffer pointer per thread is enough
+    static thread_local FThreadBuffer* ThreadBuffer = nullptr;
+    if (!ThreadBuffer)
+    {
+        TSharedRef<FThreadBuffer, ESPMode::ThreadSafe> NewBuffer = MakeShared<FThreadBuffer, ESPMode::ThreadSafe>();
+        ThreadBuffer = &NewBuffer.Get();
+
+        FScopeLock Lock(&LogLock);
+        ThreadBuffers.Add(MoveTemp(NewBuffer));
+    }
+    return *ThreadBuffer;
+}
+
+void FN2CLogger::MergeThreadBuffers()
+{
+    TArray<FRetainedEntry> Entries;
+    for (const TSharedRef<FThreadBuffer, ESPMode::ThreadSafe>& Buffer : ThreadBuffers)
+    {
+        FScopeLock BufferLock(&Buffer->Lock);
+        Entries.Append(MoveTemp(Buffer->Entries));
+        Buffer->Entries.Reset();
+    }
+
+    // Each buffer is in order already, but entries of different threads interleave
+    Entries.Sort([](const FRetainedEntry& A, const FRetainedEntry& B) { return A.Sequence < B.Sequence; });
+    for (FRetainedEntry& Entry : Entries)
+    {
+        RetainEntry(MoveTemp(Entry));
+    }
+}
+
+void FN2CLogger::ArchiveEntry(const FN2CError& Error)
+{
+    if (bArchiveEnabled)
+    {
+        ArchiveWriter.Write(FormatError(Error));
+    }
 }
 
 void FN2CLogger::SetMinSeverity(EN2CLogSeverity Severity)
@@ -131,11 +332,16 @@ void FN2CLogger::SetMinSeverity(EN2CLogSeverity Severity)
 void FN2CLogger::EnableFileLogging(bool bEnable)
 {
     bFileLoggingEnabled = bEnable;
+    if (!bEnable)
+    {
+        FileWriter.Close();
+    }
 }
 
 void FN2CLogger::SetLogFilePath(const FString& Path)
 {
     LogFilePath = Path;
+    FileWriter.SetFilePath(Path);
 }
 
 void FN2CLogger::WriteToFile(const FString& Message)
@@ -145,22 +351,7 @@ void FN2CLogger::WriteToFile(const FString& Message)
         return;
     }
 
-    // Ensure directory exists
-    FString Directory = FPaths::GetPath(LogFilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
-    {
-        PlatformFile.CreateDirectoryTree(*Directory);
-    }
-
-    // Append to file
-    FFileHelper::SaveStringToFile(
-        Message + LINE_TERMINATOR,
-        *LogFilePath,
-        FFileHelper::EEncodingOptions::AutoDetect,
-        &IFileManager::Get(),
-        FILEWRITE_Append
-    );
+    FileWriter.Write(CopyTemp(Message));
 }
 
 FString FN2CLogger::FormatError(const FN2CError& Error) const
@@ -122,11 +122,15 @@ FN2CNodeTypeRegistry& FN2CNodeTypeRegistry::Get()
 FN2CNodeTypeRegistry::FN2CNodeTypeRegistry()
 {
     InitializeDefaultMappings();
+
+    // Hot reload and live coding can replace node classes, so drop resolved types afterwards
+    FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FN2CNodeTypeRegistry::HandleReloadComplete);
 }
 
 void FN2CNodeTypeRegistry::RegisterNodeType(const FName& ClassName, EN2CNodeType NodeType)
 {
     ClassNameMappings.Add(ClassName, NodeType);
+    InvalidateResolvedTypes();
 }
 
 void FN2CNodeTypeRegistry::RegisterNodeClass(const UClass* Class, EN2CNodeType NodeType)
@@ -134,50 +138,96 @@ void FN2CNodeTypeRegistry::RegisterNodeClass(const UClass* Class, EN2CNodeType N
     if (Class)
     {
         ClassMappings.Add(Class, NodeType);
+        InvalidateResolvedTypes();
     }
 }
 
+void FN2CNodeTypeRegistry::InvalidateResolvedTypes()
+{
+    FWriteScopeLock WriteLock(ResolvedTypesLock);
+    ResolvedTypes.Empty();
+}
+
+void FN2CNodeTypeRegistry::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+    InvalidateResolvedTypes();
+}
+
 EN2CNodeType FN2CNodeTypeRegistry::GetNodeType(const UK2Node* Node)
 {
     if (!Node)
     {
         return EN2CNodeType::CallFunction; // Default
     }
-    
+
+    // The type only depends on the node class, except for variable nodes which inspect the node itself
+    const UClass* NodeClass = Node->GetClass();
+    FResolvedNodeType Resolved;
+    bool bFound = false;
+    {
+        FReadScopeLock ReadLock(ResolvedTypesLock);
+        if (const FResolvedNodeType* Cached = ResolvedTypes.Find(NodeClass))
+        {
+            Resolved = *Cached;
+            bFound = true;
+        }
+    }
+
+    if (!bFound)
+    {
+        Resolved = ResolveNodeClass(Node);
+        FWriteScopeLock WriteLock(ResolvedTypesLock);
+        ResolvedTypes.Add(NodeClass, Resolved);
+    }
+
+    if (Resolved.bVariableNode)
+    {
+        return DetermineVariableNodeType(Cast<UK2Node_Variable>(Node));
+    }
+    return Resolved.Type;
+}
+
+FN2CNodeTypeRegistry::FResolvedNodeType FN2CNodeTypeRegistry::ResolveNodeClass(const UK2Node* Node)
+{
+    FResolvedNodeType Resolved;
+    const UClass* NodeClass = Node->GetClass();
+    const FName ClassName = FName(*GetBaseNodeType(NodeClass->GetName()));
+
     // Try setting make struct type first since MakeStruct is considered a variable
     // before being considered MakeStruct
-    if (const UK2Node_MakeStruct* MakeStructNode = Cast<UK2Node_MakeStruct>(Node))
+    if (Node->IsA<UK2Node_MakeStruct>())
     {
-        FName ClassName = FName(*GetBaseNodeType(Node->GetClass()->GetName()));
-        if (ClassNameMappings.Contains(ClassName))
+        if (const EN2CNodeType* NameType = ClassNameMappings.Find(ClassName))
         {
-            return ClassNameMappings[ClassName];
+            Resolved.Type = *NameType;
+            return Resolved;
         }
     }
 
     // Try setting variable type first
-    if (const UK2Node_Variable* VarNode = Cast<UK2Node_Variable>(Node))
+    if (Node->IsA<UK2Node_Variable>())
     {
-        return DetermineVariableNodeType(VarNode);
+        Resolved.bVariableNode = true;
+        return Resolved;
     }
     
     // Try direct class mapping
-    if (ClassMappings.Contains(Node->GetClass()))
+    if (const EN2CNodeType* ClassType = ClassMappings.Find(NodeClass))
     {
-        return ClassMappings[Node->GetClass()];
+        Resolved.Type = *ClassType;
+        return Resolved;
     }
     
     // Try class name mapping
-    FName ClassName = FName(*GetBaseNodeType(Node->GetClass()->GetName()));
-    if (ClassNameMappings.Contains(ClassName))
+    if (const EN2CNodeType* NameType = ClassNameMappings.Find(ClassName))
     {
-        return ClassNameMappings[ClassName];
+        Resolved.Type = *NameType;
+        return Resolved;
     }
     
     // Fall back to inheritance-based mapping
-    EN2CNodeType OutType = EN2CNodeType::CallFunction;
-    MapFromInheritance(Node, OutType);
-    return OutType;
+    MapFromInheritance(Node, Resolved.Type);
+    return Resolved;
 }
 
 FString FN2CNodeTypeRegistry::GetBaseNodeType(const FString& ClassName)
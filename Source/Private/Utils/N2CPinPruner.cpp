@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Utils/N2CPinPruner.h"
+
+#include "Core/N2CSettings.h"
+#include "Models/N2CBlueprint.h"
+#include "Utils/N2CLogger.h"
+#include "Utils/Validators/N2CBlueprintValidator.h"
+
+namespace
+{
+    bool ShouldPrune(const FN2CPinDefinition& Pin, const FN2CNodeDefinition& Node, const FN2CPinPruner::FOptions& Options)
+    {
+        if (Pin.bConnected)
+        {
+            return false;
+        }
+
+        if (Pin.Type == EN2CPinType::Exec)
+        {
+            return Options.bUnconnectedExec;
+        }
+
+        if (Pin.Type == EN2CPinType::Self)
+        {
+            return Options.bImplicitSelf;
+        }
+
+        // Parameters and return values are part of a function's signature, whatever they hold
+        if (Node.NodeType == EN2CNodeType::FunctionEntry || Node.NodeType == EN2CNodeType::FunctionResult)
+        {
+            return false;
+        }
+
+        if (Pin.bAdvancedView && (Pin.bDefaultValueUnchanged || Pin.DefaultValue.IsEmpty()))
+        {
+            return Options.bAdvancedView;
+        }
+
+        return Options.bDefaultValues && Pin.bDefaultValueUnchanged;
+    }
+}
+
+FN2CPinPruner::FOptions FN2CPinPruner::FOptions::FromSettings()
+{
+    FOptions Options;
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    Options.bEnabled = Settings && Settings->bPruneUnusedPins;
+    Options.bDefaultValues = Settings && Settings->bPruneDefaultValuePins;
+    return Options;
+}
+
+int32 FN2CPinPruner::Prune(FN2CBlueprint& Blueprint, const FOptions& Options)
+{
+    if (!Options.bEnabled)
+    {
+        return 0;
+    }
+
+    int32 Pruned = 0;
+    for (FN2CGraph& Graph : Blueprint.Graphs)
+    {
+        Pruned += PruneGraph(Graph, Options);
+    }
+
+    if (Pruned > 0)
+    {
+        FN2CLogger::Get().Log(
+            FString::Printf(TEXT("Pruned %d pins from %s"), Pruned, *Blueprint.Metadata.Name),
+            EN2CLogSeverity::Debug, TEXT("PinPruner"));
+    }
+    return Pruned;
+}
+
+int32 FN2CPinPruner::PruneGraph(FN2CGraph& Graph, const FOptions& Options)
+{
+    // Pins a data flow refers to stay, whatever their flags say
+    TArray<TBitArray<>> Referenced;
+    Referenced.SetNum(Graph.Nodes.Num());
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+    {
+        Referenced[NodeIndex].Init(false, Graph.Nodes[NodeIndex].NumPins());
+    }
+    for (const FN2CDataFlow& Flow : Graph.Flows.Data)
+    {
+        if (Referenced.IsValidIndex(Flow.SourceNode) && Referenced[Flow.SourceNode].IsValidIndex(Flow.SourcePin))
+        {
+            Referenced[Flow.SourceNode][Flow.SourcePin] = true;
+        }
+        if (Referenced.IsValidIndex(Flow.TargetNode) && Referenced[Flow.TargetNode].IsValidIndex(Flow.TargetPin))
+        {
+            Referenced[Flow.TargetNode][Flow.TargetPin] = true;
+        }
+    }
+
+    // New index of each pin as GetPin counts them, or INDEX_NONE once pruned
+    TArray<TArray<int32>> Remap;
+    Remap.SetNum(Graph.Nodes.Num());
+    int32 Pruned = 0;
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+    {
+        const FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+        TArray<int32>& NodeRemap = Remap[NodeIndex];
+        NodeRemap.Reserve(Node.NumPins());
+
+        int32 Kept = 0;
+        for (int32 PinIndex = 0; PinIndex < Node.NumPins(); ++PinIndex)
+        {
+            const bool bPrune = !Referenced[NodeIndex][PinIndex] && ShouldPrune(*Node.GetPin(PinIndex), Node, Options);
+            NodeRemap.Add(bPrune ? INDEX_NONE : Kept++);
+            Pruned += bPrune ? 1 : 0;
+        }
+    }
+
+    if (Pruned == 0)
+    {
+        return 0;
+    }
+
+    // Kept whole in case the pruned graph fails validation
+    const FN2CGraph Original = Graph;
+
+    for (int32 NodeIndex = 0; NodeIndex < Graph.Nodes.Num(); ++NodeIndex)
+    {
+        FN2CNodeDefinition& Node = Graph.Nodes[NodeIndex];
+        const TArray<int32>& NodeRemap = Remap[NodeIndex];
+        const int32 NumInputs = Node.InputPins.Num();
+
+        int32 PinIndex = 0;
+        Node.InputPins.RemoveAll([&NodeRemap, &PinIndex](const FN2CPinDefinition&) { return NodeRemap[PinIndex++] == INDEX_NONE; });
+        PinIndex = NumInputs;
+        Node.OutputPins.RemoveAll([&NodeRemap, &PinIndex](const FN2CPinDefinition&) { return NodeRemap[PinIndex++] == INDEX_NONE; });
+    }
+
+    for (FN2CDataFlow& Flow : Graph.Flows.Data)
+    {
+        if (Remap.IsValidIndex(Flow.SourceNode) && Remap[Flow.SourceNode].IsValidIndex(Flow.SourcePin))
+        {
+            Flow.SourcePin = Remap[Flow.SourceNode][Flow.SourcePin];
+        }
+        if (Remap.IsValidIndex(Flow.TargetNode) && Remap[Flow.TargetNode].IsValidIndex(Flow.TargetPin))
+        {
+            Flow.TargetPin = Remap[Flow.TargetNode][Flow.TargetPin];
+        }
+    }
+
+    FString Error;
+    if (!FN2CBlueprintValidator().ValidateFlowReferences(Graph, Error))
+    {
+        FN2CLogger::Get().LogWarning(
+            FString::Printf(TEXT("Kept every pin of graph %s: pruning left invalid flows (%s)"), *Graph.Name, *Error),
+            TEXT("PinPruner"));
+        Graph = Original;
+        return 0;
+    }
+    return Pruned;
+}
@@ -2,47 +2,76 @@
 
 #include "Utils/N2CPinTypeCompatibility.h"
 
-bool FN2CPinTypeCompatibility::AreTypesCompatible(EN2CPinType Type1, EN2CPinType Type2)
+namespace
 {
-    // Special handling for wildcards
-    if (Type1 == EN2CPinType::Wildcard || Type2 == EN2CPinType::Wildcard)
+    /** Wildcard is the last pin type */
+    constexpr int32 NumPinTypes = static_cast<int32>(EN2CPinType::Wildcard) + 1;
+    static_assert(NumPinTypes <= 64, "Pin type masks are 64 bits wide");
+
+    /** Bit of a type in a row of the matrix, or none for a value outside the enum */
+    constexpr uint64 TypeBit(EN2CPinType Type)
     {
-        return true;
+        return static_cast<int32>(Type) < NumPinTypes ? uint64(1) << static_cast<uint32>(Type) : 0;
     }
 
-    // Handle soft references to regular references
-    if ((Type1 == EN2CPinType::SoftObject && Type2 == EN2CPinType::Object) ||
-        (Type1 == EN2CPinType::SoftClass && Type2 == EN2CPinType::Class) ||
-        (Type2 == EN2CPinType::SoftObject && Type1 == EN2CPinType::Object) ||
-        (Type2 == EN2CPinType::SoftClass && Type1 == EN2CPinType::Class))
+    /** Types whose pins are compatible only if their containers or subtypes also match */
+    constexpr uint64 ContainerTypes = TypeBit(EN2CPinType::Array) | TypeBit(EN2CPinType::Set) | TypeBit(EN2CPinType::Map);
+    constexpr uint64 ObjectTypes = TypeBit(EN2CPinType::Object) | TypeBit(EN2CPinType::Class)
+        | TypeBit(EN2CPinType::Interface) | TypeBit(EN2CPinType::Struct);
+
+    /** One row per pin type, with a bit set for every type it connects to */
+    struct FCompatibilityMatrix
     {
-        return true;
-    }
+        uint64 Rows[NumPinTypes] = {};
 
-    // Handle numeric type compatibility
-    if ((Type1 == EN2CPinType::Integer && Type2 == EN2CPinType::Float) ||
-        (Type1 == EN2CPinType::Float && Type2 == EN2CPinType::Integer) ||
-        (Type1 == EN2CPinType::Integer && Type2 == EN2CPinType::Integer64) ||
-        (Type1 == EN2CPinType::Integer64 && Type2 == EN2CPinType::Integer) ||
-        (Type1 == EN2CPinType::Float && Type2 == EN2CPinType::Double) ||
-        (Type1 == EN2CPinType::Double && Type2 == EN2CPinType::Float) ||
-        (Type1 == EN2CPinType::Real && (Type2 == EN2CPinType::Float || Type2 == EN2CPinType::Double)) ||
-        (Type2 == EN2CPinType::Real && (Type1 == EN2CPinType::Float || Type1 == EN2CPinType::Double)))
+        constexpr void Allow(EN2CPinType Type1, EN2CPinType Type2)
+        {
+            Rows[static_cast<int32>(Type1)] |= TypeBit(Type2);
+            Rows[static_cast<int32>(Type2)] |= TypeBit(Type1);
+        }
+    };
+
+    constexpr FCompatibilityMatrix BuildCompatibilityMatrix()
     {
-        return true;
+        FCompatibilityMatrix Matrix;
+
+        for (int32 Index = 0; Index < NumPinTypes; ++Index)
+        {
+            const EN2CPinType Type = static_cast<EN2CPinType>(Index);
+            Matrix.Allow(Type, Type);
+
+            // Wildcards connect to anything
+            Matrix.Allow(Type, EN2CPinType::Wildcard);
+        }
+
+        // Soft references to regular references
+        Matrix.Allow(EN2CPinType::SoftObject, EN2CPinType::Object);
+        Matrix.Allow(EN2CPinType::SoftClass, EN2CPinType::Class);
+
+        // Numeric conversions
+        Matrix.Allow(EN2CPinType::Integer, EN2CPinType::Float);
+        Matrix.Allow(EN2CPinType::Integer, EN2CPinType::Integer64);
+        Matrix.Allow(EN2CPinType::Float, EN2CPinType::Double);
+        Matrix.Allow(EN2CPinType::Real, EN2CPinType::Float);
+        Matrix.Allow(EN2CPinType::Real, EN2CPinType::Double);
+
+        // Vector conversions
+        Matrix.Allow(EN2CPinType::Vector, EN2CPinType::Vector4D);
+        Matrix.Allow(EN2CPinType::Vector2D, EN2CPinType::Vector);
+
+        return Matrix;
     }
 
-    // Handle vector type compatibility
-    if ((Type1 == EN2CPinType::Vector && Type2 == EN2CPinType::Vector4D) ||
-        (Type1 == EN2CPinType::Vector2D && Type2 == EN2CPinType::Vector) ||
-        (Type2 == EN2CPinType::Vector && Type1 == EN2CPinType::Vector4D) ||
-        (Type2 == EN2CPinType::Vector2D && Type1 == EN2CPinType::Vector))
+    constexpr FCompatibilityMatrix CompatibilityMatrix = BuildCompatibilityMatrix();
+}
+
+bool FN2CPinTypeCompatibility::AreTypesCompatible(EN2CPinType Type1, EN2CPinType Type2)
+{
+    if (TypeBit(Type1) == 0 || TypeBit(Type2) == 0)
     {
-        return true;
+        return Type1 == Type2;
     }
-
-    // Regular type comparison
-    return Type1 == Type2;
+    return (CompatibilityMatrix.Rows[static_cast<int32>(Type1)] & TypeBit(Type2)) != 0;
 }
 
 bool FN2CPinTypeCompatibility::ArePinsCompatible(const FN2CPinDefinition& Pin1, const FN2CPinDefinition& Pin2)
@@ -53,18 +82,16 @@ bool FN2CPinTypeCompatibility::ArePinsCompatible(const FN2CPinDefinition& Pin1,
         return false;
     }
 
+    const uint64 Types = TypeBit(Pin1.Type) | TypeBit(Pin2.Type);
+
     // For container types, check subtypes match
-    if ((Pin1.Type == EN2CPinType::Array || Pin1.Type == EN2CPinType::Set || Pin1.Type == EN2CPinType::Map) ||
-        (Pin2.Type == EN2CPinType::Array || Pin2.Type == EN2CPinType::Set || Pin2.Type == EN2CPinType::Map))
+    if (Types & ContainerTypes)
     {
         return AreContainerTypesCompatible(Pin1, Pin2);
     }
 
     // For object/class/interface/struct types, check subtypes match
-    if ((Pin1.Type == EN2CPinType::Object || Pin1.Type == EN2CPinType::Class || 
-         Pin1.Type == EN2CPinType::Interface || Pin1.Type == EN2CPinType::Struct) ||
-        (Pin2.Type == EN2CPinType::Object || Pin2.Type == EN2CPinType::Class || 
-         Pin2.Type == EN2CPinType::Interface || Pin2.Type == EN2CPinType::Struct))
+    if (Types & ObjectTypes)
     {
         return AreObjectTypesCompatible(Pin1, Pin2);
     }
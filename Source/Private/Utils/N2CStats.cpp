@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Utils/N2CStats.h"
+
+LLM_DEFINE_TAG(NodeToCode);
+LLM_DEFINE_TAG(NodeToCode_Translator);
+LLM_DEFINE_TAG(NodeToCode_Serializer);
+LLM_DEFINE_TAG(NodeToCode_LLM);
+LLM_DEFINE_TAG(NodeToCode_Logger);
+LLM_DEFINE_TAG(NodeToCode_CodeEditor);
+
+void FN2CPeakMemory::Reset()
+{
+    StartBytes = FPlatformMemory::GetStats().UsedPhysical;
+    PeakBytes = StartBytes;
+}
+
+void FN2CPeakMemory::Sample()
+{
+    PeakBytes = FMath::Max<uint64>(PeakBytes, FPlatformMemory::GetStats().UsedPhysical);
+}
+
+FString FN2CPeakMemory::ToString() const
+{
+    constexpr double BytesPerMB = 1024.0 * 1024.0;
+    return FString::Printf(TEXT("Peak memory: %.0f MB (%.0f MB at start, %.0f MB process high-water mark)"),
+        PeakBytes / BytesPerMB, StartBytes / BytesPerMB, FPlatformMemory::GetStats().PeakUsedPhysical / BytesPerMB);
+}
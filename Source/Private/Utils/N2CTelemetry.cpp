@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#include "Utils/N2CTelemetry.h"
+
+#include "Core/N2CSettings.h"
+#include "Utils/N2CLogger.h"
+#include "HttpModule.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+    /** Stat names carry this prefix, which says nothing in the export */
+    const ANSICHAR* StatPrefix = "STAT_N2C";
+
+    FString GetStageName(const ANSICHAR* Name)
+    {
+        const int32 PrefixLength = FCStringAnsi::Strlen(StatPrefix);
+        return FCStringAnsi::Strncmp(Name, StatPrefix, PrefixLength) == 0 ? FString(Name + PrefixLength) : FString(Name);
+    }
+
+    FString GetTelemetryFilePath(const UN2CSettings& Settings)
+    {
+        return Settings.TelemetryFilePath.IsEmpty()
+            ? FPaths::ProjectSavedDir() / TEXT("NodeToCode") / TEXT("Telemetry") / FString(FPlatformProcess::ComputerName()) + TEXT(".jsonl")
+            : Settings.TelemetryFilePath;
+    }
+}
+
+const double FN2CTelemetryStage::BucketBoundsMs[NumBuckets - 1] = { 0.1, 0.5, 1.0, 5.0, 10.0, 50.0, 100.0, 500.0, 1000.0, 5000.0, 30000.0 };
+
+std::atomic<bool> FN2CTelemetry::bEnabled{false};
+
+void FN2CTelemetryStage::Record(double Seconds)
+{
+    const double Milliseconds = Seconds * 1000.0;
+    int32 Bucket = 0;
+    while (Bucket < NumBuckets - 1 && Milliseconds > BucketBoundsMs[Bucket])
+    {
+        ++Bucket;
+    }
+
+    const uint64 Microseconds = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1000000.0);
+    Count.fetch_add(1, std::memory_order_relaxed);
+    TotalMicroseconds.fetch_add(Microseconds, std::memory_order_relaxed);
+    Buckets[Bucket].fetch_add(1, std::memory_order_relaxed);
+
+    uint64 Max = MaxMicroseconds.load(std::memory_order_relaxed);
+    while (Microseconds > Max && !MaxMicroseconds.compare_exchange_weak(Max, Microseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+FN2CTelemetry& FN2CTelemetry::Get()
+{
+    static FN2CTelemetry Instance;
+    return Instance;
+}
+
+FN2CTelemetryStage& FN2CTelemetry::RegisterStage(const ANSICHAR* Name)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    // A stat timed at several places shares one stage
+    for (const TUniquePtr<FN2CTelemetryStage>& Stage : Stages)
+    {
+        if (FCStringAnsi::Strcmp(Stage->GetName(), Name) == 0)
+        {
+            return *Stage;
+        }
+    }
+    return *Stages.Add_GetRef(MakeUnique<FN2CTelemetryStage>(Name));
+}
+
+void FN2CTelemetry::RecordSeconds(const ANSICHAR* StageName, double Seconds)
+{
+    if (IsEnabled() && Seconds >= 0.0)
+    {
+        RegisterStage(StageName).Record(Seconds);
+    }
+}
+
+void FN2CTelemetry::Increment(const TCHAR* Counter, int64 Amount)
+{
+    if (IsEnabled())
+    {
+        FScopeLock ScopeLock(&Lock);
+        Counters.FindOrAdd(Counter) += Amount;
+    }
+}
+
+void FN2CTelemetry::SampleGauge(const TCHAR* Gauge, int64 Value)
+{
+    if (IsEnabled())
+    {
+        FScopeLock ScopeLock(&Lock);
+        FGauge& Sampled = Gauges.FindOrAdd(Gauge);
+        Sampled.Last = Value;
+        Sampled.Max = FMath::Max(Sampled.Max, Value);
+    }
+}
+
+void FN2CTelemetry::ApplySettings()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const bool bEnable = Settings && Settings->bExportTelemetry;
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    if (!bEnable)
+    {
+        Flush();
+        bEnabled = false;
+        return;
+    }
+
+    if (!bEnabled)
+    {
+        IntervalStart = FDateTime::UtcNow();
+        bEnabled = true;
+    }
+
+    // The commandlets pump the core ticker too, so build machines export while a batch runs
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateLambda([](float DeltaTime)
+        {
+            FN2CTelemetry::Get().Flush();
+            return true;
+        }),
+        FMath::Max(Settings->TelemetryIntervalSeconds, 5.0f));
+}
+
+void FN2CTelemetry::Flush()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    if (!IsEnabled() || !Settings)
+    {
+        return;
+    }
+
+    const FString Line = TakeIntervalLine();
+    const FString FilePath = GetTelemetryFilePath(*Settings);
+    if (!FFileHelper::SaveStringToFile(Line + TEXT("\n"), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+        &IFileManager::Get(), FILEWRITE_Append))
+    {
+        FN2CLogger::Get().LogWarning(FString::Printf(TEXT("Failed to write telemetry to: %s"), *FilePath), TEXT("Telemetry"));
+    }
+
+    if (!Settings->TelemetryEndpoint.IsEmpty())
+    {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+        Request->SetURL(Settings->TelemetryEndpoint);
+        Request->SetVerb(TEXT("POST"));
+        Request->SetHeader(TEXT("Content-Type"), TEXT("application/x-ndjson"));
+        Request->SetContentAsString(Line);
+        Request->OnProcessRequestComplete().BindLambda([](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+        {
+            if (!bSucceeded || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+            {
+                FN2CLogger::Get().LogWarning(TEXT("Failed to post telemetry to the telemetry endpoint"), TEXT("Telemetry"));
+            }
+        });
+        Request->ProcessRequest();
+    }
+}
+
+void FN2CTelemetry::Shutdown()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    Flush();
+    bEnabled = false;
+}
+
+FString FN2CTelemetry::TakeIntervalLine()
+{
+    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
+    const FDateTime Now = FDateTime::UtcNow();
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("NodeToCode"));
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+    FString Line;
+    TSharedRef<FCondensedJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("time"), Now.ToIso8601());
+    Writer->WriteValue(TEXT("interval_seconds"), (Now - IntervalStart).GetTotalSeconds());
+    Writer->WriteValue(TEXT("machine"), FString(FPlatformProcess::ComputerName()));
+    Writer->WriteValue(TEXT("plugin_version"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+    Writer->WriteValue(TEXT("engine_version"), FEngineVersion::Current().ToString());
+    if (Settings)
+    {
+        Writer->WriteValue(TEXT("provider"), UEnum::GetValueAsString(Settings->Provider));
+        Writer->WriteValue(TEXT("model"), Settings->GetActiveModel());
+    }
+
+    Writer->WriteArrayStart(TEXT("bucket_bounds_ms"));
+    for (const double Bound : FN2CTelemetryStage::BucketBoundsMs)
+    {
+        Writer->WriteValue(Bound);
+    }
+    Writer->WriteArrayEnd();
+
+    FScopeLock ScopeLock(&Lock);
+
+    // Stages that did not run this interval are left out
+    Writer->WriteObjectStart(TEXT("stages"));
+    for (const TUniquePtr<FN2CTelemetryStage>& Stage : Stages)
+    {
+        const uint64 Count = Stage->Count.exchange(0, std::memory_order_relaxed);
+        const uint64 TotalMicroseconds = Stage->TotalMicroseconds.exchange(0, std::memory_order_relaxed);
+        const uint64 MaxMicroseconds = Stage->MaxMicroseconds.exchange(0, std::memory_order_relaxed);
+        uint64 Buckets[FN2CTelemetryStage::NumBuckets];
+        for (int32 Bucket = 0; Bucket < FN2CTelemetryStage::NumBuckets; ++Bucket)
+        {
+            Buckets[Bucket] = Stage->Buckets[Bucket].exchange(0, std::memory_order_relaxed);
+        }
+        if (Count == 0)
+        {
+            continue;
+        }
+
+        Writer->WriteObjectStart(GetStageName(Stage->GetName()));
+        Writer->WriteValue(TEXT("count"), static_cast<int64>(Count));
+        Writer->WriteValue(TEXT("total_ms"), TotalMicroseconds / 1000.0);
+        Writer->WriteValue(TEXT("max_ms"), MaxMicroseconds / 1000.0);
+        Writer->WriteArrayStart(TEXT("buckets"));
+        for (const uint64 BucketCount : Buckets)
+        {
+            Writer->WriteValue(static_cast<int64>(BucketCount));
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteObjectEnd();
+
+    Writer->WriteObjectStart(TEXT("counters"));
+    for (const TPair<FString, int64>& Counter : Counters)
+    {
+        Writer->WriteValue(Counter.Key, Counter.Value);
+    }
+    Writer->WriteObjectEnd();
+
+    // Translations answered from the cache among all those asked for
+    const int64 CacheHits = Counters.FindRef(TEXT("CacheHits"));
+    const int64 Requests = Counters.FindRef(TEXT("Requests"));
+    if (CacheHits + Requests > 0)
+    {
+        Writer->WriteValue(TEXT("cache_hit_rate"), static_cast<double>(CacheHits) / (CacheHits + Requests));
+    }
+
+    Writer->WriteObjectStart(TEXT("gauges"));
+    for (const TPair<FString, FGauge>& Gauge : Gauges)
+    {
+        Writer->WriteObjectStart(Gauge.Key);
+        Writer->WriteValue(TEXT("last"), Gauge.Value.Last);
+        Writer->WriteValue(TEXT("max"), Gauge.Value.Max);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteObjectEnd();
+
+    Writer->WriteObjectStart(TEXT("memory_mb"));
+    Writer->WriteValue(TEXT("used"), MemoryStats.UsedPhysical / BytesPerMB);
+    Writer->WriteValue(TEXT("process_peak"), MemoryStats.PeakUsedPhysical / BytesPerMB);
+    Writer->WriteObjectEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    Counters.Reset();
+    Gauges.Reset();
+    IntervalStart = Now;
+    return Line;
+}
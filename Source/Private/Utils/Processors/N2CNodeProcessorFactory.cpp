@@ -23,6 +23,7 @@ FN2CNodeProcessorFactory& FN2CNodeProcessorFactory::Get()
 }
 
 FN2CNodeProcessorFactory::FN2CNodeProcessorFactory()
+    : ProcessorTable(InPlace, nullptr)
 {
     InitializeDefaultProcessors();
 }
@@ -31,6 +32,7 @@ void FN2CNodeProcessorFactory::RegisterProcessor(EN2CNodeType NodeType, TSharedP
 {
     if (Processor.IsValid())
     {
+        ProcessorTable[static_cast<uint8>(NodeType)] = Processor.Get();
         Processors.Add(NodeType, Processor);
     }
 }
@@ -94,10 +94,10 @@ bool FN2CBlueprintValidator::ValidateGraphs(const FN2CBlueprint& Blueprint, FStr
         return false;
     }
 
-    // Validate each graph
+    // Validate each graph, reusing the verdicts of graphs already validated on their own
     for (const FN2CGraph& Graph : Blueprint.Graphs)
     {
-        if (!ValidateGraph(Graph, OutError))
+        if (!Graph.Validate(OutError, this))
         {
             OutError = FString::Printf(TEXT("Invalid graph: %s - %s"), *Graph.Name, *OutError);
             FN2CLogger::Get().LogError(OutError);
@@ -142,8 +142,8 @@ bool FN2CBlueprintValidator::ValidateGraph(const FN2CGraph& Graph, FString& OutE
         return false;
     }
 
-    // Build set of node IDs for validation
-    TSet<FString> NodeIds;
+    // Collect the node IDs as views into the graph, reusing the set of the previous graph
+    NodeIds.Reset();
     for (const FN2CNodeDefinition& Node : Graph.Nodes)
     {
         FString NodeError;
@@ -155,22 +155,27 @@ bool FN2CBlueprintValidator::ValidateGraph(const FN2CGraph& Graph, FString& OutE
         }
 
         // Check for duplicate node IDs
-        if (NodeIds.Contains(Node.ID))
+        bool bAlreadyInSet = false;
+        NodeIds.Add(FStringView(Node.ID), &bAlreadyInSet);
+        if (bAlreadyInSet)
         {
             OutError = FString::Printf(TEXT("Duplicate node ID %s in graph %s"), *Node.ID, *Graph.Name);
             FN2CLogger::Get().LogError(OutError);
             return false;
         }
-        NodeIds.Add(Node.ID);
     }
 
     // Log all node IDs for debugging
-    FString NodeIdList = TEXT("Valid Node IDs in graph ") + Graph.Name + TEXT(": ");
-    for (const FString& Id : NodeIds)
+    if (FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Debug))
     {
-        NodeIdList += Id + TEXT(", ");
+        FString NodeIdList = TEXT("Valid Node IDs in graph ") + Graph.Name + TEXT(": ");
+        for (const FStringView Id : NodeIds)
+        {
+            NodeIdList.Append(Id);
+            NodeIdList += TEXT(", ");
+        }
+        FN2CLogger::Get().Log(NodeIdList, EN2CLogSeverity::Debug);
     }
-    FN2CLogger::Get().Log(NodeIdList, EN2CLogSeverity::Debug);
 
     // Validate flow references
     if (!ValidateFlowReferences(Graph, OutError))
@@ -178,54 +183,34 @@ bool FN2CBlueprintValidator::ValidateGraph(const FN2CGraph& Graph, FString& OutE
         return false;
     }
 
-    FN2CLogger::Get().Log(FString::Printf(TEXT("Graph %s validation successful: %d nodes, %d execution flows, %d data flows"), 
-        *Graph.Name, Graph.Nodes.Num(), Graph.Flows.Execution.Num(), Graph.Flows.Data.Num()), EN2CLogSeverity::Debug);
+    N2C_LOG(Debug, TEXT("Graph %s validation successful: %d nodes, %d execution flows, %d data flows"),
+        *Graph.Name, Graph.Nodes.Num(), Graph.Flows.NumExecutionChains(), Graph.Flows.Data.Num());
 
     return true;
 }
 
 bool FN2CBlueprintValidator::ValidateFlowReferences(const FN2CGraph& Graph, FString& OutError)
 {
-    // Build lookup maps for validation
-    TSet<FString> NodeIds;
-    TMap<FString, TSet<FString>> NodePinIds;
-
-    for (const FN2CNodeDefinition& Node : Graph.Nodes)
-    {
-        NodeIds.Add(Node.ID);
-        
-        // Track all pin IDs for this node
-        TSet<FString>& PinIds = NodePinIds.Add(Node.ID);
-        for (const FN2CPinDefinition& Pin : Node.InputPins)
-        {
-            PinIds.Add(Pin.ID);
-        }
-        for (const FN2CPinDefinition& Pin : Node.OutputPins)
-        {
-            PinIds.Add(Pin.ID);
-        }
-    }
-
     // Validate execution flows
-    for (const FString& ExecFlow : Graph.Flows.Execution)
+    for (int32 ChainIndex = 0; ChainIndex < Graph.Flows.NumExecutionChains(); ++ChainIndex)
     {
-        TArray<FString> FlowNodes;
-        ExecFlow.ParseIntoArray(FlowNodes, TEXT("->"));
-        
+        const TConstArrayView<int32> Chain = Graph.Flows.GetExecutionChain(ChainIndex);
+
         // Each flow must have at least 2 nodes
-        if (FlowNodes.Num() < 2)
+        if (Chain.Num() < 2)
         {
-            OutError = FString::Printf(TEXT("Invalid execution flow %s (needs at least 2 nodes) in graph %s"), *ExecFlow, *Graph.Name);
+            OutError = FString::Printf(TEXT("Invalid execution flow %d (needs at least 2 nodes) in graph %s"), ChainIndex, *Graph.Name);
             FN2CLogger::Get().LogError(OutError);
             return false;
         }
 
         // Verify all referenced nodes exist
-        for (const FString& NodeId : FlowNodes)
+        for (const int32 NodeIndex : Chain)
         {
-            if (!NodeIds.Contains(NodeId))
+            if (!Graph.Nodes.IsValidIndex(NodeIndex))
             {
-                OutError = FString::Printf(TEXT("Execution flow %s references non-existent node %s in graph %s"), *ExecFlow, *NodeId, *Graph.Name);
+                OutError = FString::Printf(TEXT("Execution flow %d references non-existent node index %d in graph %s"),
+                    ChainIndex, NodeIndex, *Graph.Name);
                 FN2CLogger::Get().LogError(OutError);
                 return false;
             }
@@ -233,24 +218,20 @@ bool FN2CBlueprintValidator::ValidateFlowReferences(const FN2CGraph& Graph, FStr
     }
 
     // Check data flows
-    for (const auto& DataFlow : Graph.Flows.Data)
+    for (const FN2CDataFlow& DataFlow : Graph.Flows.Data)
     {
-        // Validate source pin format (N#.P#)
-        TArray<FString> SourceParts;
-        DataFlow.Key.ParseIntoArray(SourceParts, TEXT("."));
-        if (SourceParts.Num() != 2 || !NodeIds.Contains(SourceParts[0]))
+        // Validate the source pin
+        if (!Graph.Nodes.IsValidIndex(DataFlow.SourceNode) || !Graph.Nodes[DataFlow.SourceNode].GetPin(DataFlow.SourcePin))
         {
-            OutError = FString::Printf(TEXT("Invalid source pin format %s in graph %s"), *DataFlow.Key, *Graph.Name);
+            OutError = FString::Printf(TEXT("Invalid source pin %d.%d in graph %s"), DataFlow.SourceNode, DataFlow.SourcePin, *Graph.Name);
             FN2CLogger::Get().LogError(OutError);
             return false;
         }
 
-        // Validate target pin format (N#.P#)
-        TArray<FString> TargetParts;
-        DataFlow.Value.ParseIntoArray(TargetParts, TEXT("."));
-        if (TargetParts.Num() != 2 || !NodeIds.Contains(TargetParts[0]))
+        // Validate the target pin
+        if (!Graph.Nodes.IsValidIndex(DataFlow.TargetNode) || !Graph.Nodes[DataFlow.TargetNode].GetPin(DataFlow.TargetPin))
         {
-            OutError = FString::Printf(TEXT("Invalid target pin format %s in graph %s"), *DataFlow.Value, *Graph.Name);
+            OutError = FString::Printf(TEXT("Invalid target pin %d.%d in graph %s"), DataFlow.TargetNode, DataFlow.TargetPin, *Graph.Name);
             FN2CLogger::Get().LogError(OutError);
             return false;
         }
@@ -3,6 +3,7 @@
 #include "N2CCodeEditorStyle.h"
 
 #include "N2CCodeLanguage.h"
+#include "Code Editor/Syntax/N2CRichTextSyntaxHighlighter.h"
 #include "Core/N2CSettings.h"
 #include "Styling/SlateStyleRegistry.h"
 #include "Styling/SlateTypes.h"
@@ -12,6 +13,7 @@
 #define LOCTEXT_NAMESPACE "N2CCodeEditorStyle"
 
 TSharedPtr<FSlateStyleSet> FN2CCodeEditorStyle::StyleSet = nullptr;
+TSet<FString> FN2CCodeEditorStyle::BuiltStyleGroups;
 
 #define DEFAULT_FONT(...) FCoreStyle::GetDefaultFontStyle(__VA_ARGS__)
 
@@ -44,256 +46,66 @@ void FN2CCodeEditorStyle::Initialize()
         StyleSet->Set("N2CCodeEditor.TextEditor.Border", new FSlateColorBrush(FLinearColor(0.1f, 0.1f, 0.1f)));
     }
 
-    // Initialize language-specific styles
-    InitializeLanguageStyles();
+    // Language and theme styles are registered on first use by EnsureLanguageStyles
 
     FSlateStyleRegistry::RegisterSlateStyle(*StyleSet.Get());
 }
 
-void FN2CCodeEditorStyle::InitializeLanguageStyles()
+void FN2CCodeEditorStyle::EnsureLanguageStyles(const FName& LanguageId, const FName& ThemeName)
 {
-    InitializeCPPStyles();
-    InitializePythonStyles();
-    InitializeJavaScriptStyles();
-    InitializeCSharpStyles();
-    InitializeSwiftStyles();
-    InitializePseudocodeStyles();
-}
+    check(IsInGameThread());
 
-void FN2CCodeEditorStyle::InitializeCPPStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("CPP"));
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->CPPThemes.Themes)
+    const FString GroupKey = FString::Printf(TEXT("%s.%s"), *LanguageId.ToString(), *ThemeName.ToString());
+    if (BuiltStyleGroups.Contains(GroupKey))
     {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
-
-        // Set text styles for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Operators)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Keywords)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Strings)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Numbers)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Comments)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Preprocessor)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Parentheses)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.CurlyBraces)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CPP.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.SquareBrackets)));
-    }
-}
-
-void FN2CCodeEditorStyle::InitializePythonStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("Python"));
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->PythonThemes.Themes)
-    {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
-
-        // Set text styles for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Operators)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Keywords)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Strings)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Numbers)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Comments)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Preprocessor)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Parentheses)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.CurlyBraces)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Python.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.SquareBrackets)));
+        return;
     }
-}
+    BuiltStyleGroups.Add(GroupKey);
 
-void FN2CCodeEditorStyle::InitializeJavaScriptStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("JavaScript"));
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->JavaScriptThemes.Themes)
+    // Map the style id back to its language so the theme colors can be looked up
+    EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+    for (const EN2CCodeLanguage Candidate : { EN2CCodeLanguage::Cpp, EN2CCodeLanguage::Python,
+        EN2CCodeLanguage::JavaScript, EN2CCodeLanguage::CSharp, EN2CCodeLanguage::Swift, EN2CCodeLanguage::Pseudocode })
     {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
-
-        // Set text styles for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Operators)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Keywords)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Strings)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Numbers)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Comments)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Preprocessor)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Parentheses)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.CurlyBraces)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.JavaScript.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.SquareBrackets)));
+        if (LanguageId == FName(*GetLanguageString(Candidate)))
+        {
+            Language = Candidate;
+            break;
+        }
     }
-}
 
-void FN2CCodeEditorStyle::InitializeCSharpStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("CSharp"));
     const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->CSharpThemes.Themes)
+    const FN2CCodeEditorColors* FoundColors = Settings ? Settings->GetThemeColors(Language, ThemeName) : nullptr;
+    if (!FoundColors)
     {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
-
-        // Set text styles for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Operators)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Keywords)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Strings)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Numbers)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Comments)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Preprocessor)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Parentheses)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.CurlyBraces)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.CSharp.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.SquareBrackets)));
+        return;
     }
-}
+    const FN2CCodeEditorColors& Colors = *FoundColors;
 
-void FN2CCodeEditorStyle::InitializeSwiftStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("Swift"));
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->SwiftThemes.Themes)
-    {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
+    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(LanguageId);
+    const FString Prefix = FString::Printf(TEXT("N2CCodeEditor.%s"), *GroupKey);
 
-        // Set text styles for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Operators)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Keywords)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Strings)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Numbers)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Comments)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Preprocessor)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.Parentheses)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.CurlyBraces)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Swift.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.SquareBrackets)));
-    }
-}
+    // Set background color for this theme
+    StyleSet->Set(*(Prefix + TEXT(".Background")), new FSlateColorBrush(FLinearColor(Colors.Background)));
 
-void FN2CCodeEditorStyle::InitializePseudocodeStyles()
-{
-    const FTextBlockStyle BaseStyle = CreateDefaultTextStyle(TEXT("Pseudocode"));
-    const UN2CSettings* Settings = GetDefault<UN2CSettings>();
-    
-    // Initialize styles for each theme
-    for (const auto& ThemePair : Settings->PseudocodeThemes.Themes)
+    // Pseudocode renders every token in the normal text color
+    const bool bPlain = Language == EN2CCodeLanguage::Pseudocode;
+    const auto SetTextStyle = [&](const TCHAR* StyleId, const FLinearColor& Color)
     {
-        const FName& ThemeName = ThemePair.Key;
-        const FN2CCodeEditorColors& Colors = ThemePair.Value;
-        
-        // Set background color for this theme
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Background"), *ThemeName.ToString()), 
-            new FSlateColorBrush(FLinearColor(Colors.Background)));
-
-        // For Pseudocode, we only need the Normal style since we want all text to be the same color
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Normal"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-            
-        // Set all other styles to match Normal for consistency
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Operator"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Keyword"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.String"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Number"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Comment"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Preprocessor"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.Parentheses"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.CurlyBraces"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-        StyleSet->Set(*FString::Printf(TEXT("N2CCodeEditor.Pseudocode.%s.SquareBrackets"), *ThemeName.ToString()), 
-            FTextBlockStyle(BaseStyle).SetColorAndOpacity(FLinearColor(Colors.NormalText)));
-    }
+        StyleSet->Set(*FString::Printf(TEXT("%s.%s"), *Prefix, StyleId),
+            FTextBlockStyle(BaseStyle).SetColorAndOpacity(bPlain ? FLinearColor(Colors.NormalText) : Color));
+    };
+
+    SetTextStyle(TEXT("Normal"), Colors.NormalText);
+    SetTextStyle(TEXT("Operator"), Colors.Operators);
+    SetTextStyle(TEXT("Keyword"), Colors.Keywords);
+    SetTextStyle(TEXT("String"), Colors.Strings);
+    SetTextStyle(TEXT("Number"), Colors.Numbers);
+    SetTextStyle(TEXT("Comment"), Colors.Comments);
+    SetTextStyle(TEXT("Preprocessor"), Colors.Preprocessor);
+    SetTextStyle(TEXT("Parentheses"), Colors.Parentheses);
+    SetTextStyle(TEXT("CurlyBraces"), Colors.CurlyBraces);
+    SetTextStyle(TEXT("SquareBrackets"), Colors.SquareBrackets);
 }
 
 FTextBlockStyle FN2CCodeEditorStyle::CreateDefaultTextStyle(const FName& TypeName)
@@ -316,6 +128,8 @@ void FN2CCodeEditorStyle::Shutdown()
         // Ensure no references remain before unregistering
         FSlateStyleRegistry::UnRegisterSlateStyle(*StyleSet.Get());
         StyleSet.Reset();
+        BuiltStyleGroups.Reset();
+        FN2CRichTextSyntaxHighlighter::ResetSharedStyles();
     }
 }
 
@@ -334,6 +148,8 @@ const FName& FN2CCodeEditorStyle::GetStyleSetName()
 const FTextBlockStyle& FN2CCodeEditorStyle::GetLanguageStyle(const FName& LanguageId, const FName& ThemeName, const FName& StyleId)
 {
     check(StyleSet.IsValid());
+    EnsureLanguageStyles(LanguageId, ThemeName);
+
     const FName FullStyleId = FName(*FString::Printf(TEXT("N2CCodeEditor.%s.%s.%s"), 
         *LanguageId.ToString(), *ThemeName.ToString(), *StyleId.ToString()));
     
@@ -344,6 +160,7 @@ const FTextBlockStyle& FN2CCodeEditorStyle::GetLanguageStyle(const FName& Langua
         const FName DefaultStyleId = FName(*FString::Printf(TEXT("N2CCodeEditor.%s.Unreal Engine.%s"), 
             *LanguageId.ToString(), *StyleId.ToString()));
             
+        EnsureLanguageStyles(LanguageId, TEXT("Unreal Engine"));
         if (!StyleSet->HasWidgetStyle<FTextBlockStyle>(DefaultStyleId))
         {
             return StyleSet->GetWidgetStyle<FTextBlockStyle>("N2CCodeEditor.TextEditor.NormalText");
@@ -354,6 +171,15 @@ const FTextBlockStyle& FN2CCodeEditorStyle::GetLanguageStyle(const FName& Langua
     return StyleSet->GetWidgetStyle<FTextBlockStyle>(FullStyleId);
 }
 
+const FSlateBrush* FN2CCodeEditorStyle::GetLanguageBackground(const FName& LanguageId, const FName& ThemeName)
+{
+    check(StyleSet.IsValid());
+    EnsureLanguageStyles(LanguageId, ThemeName);
+
+    return StyleSet->GetBrush(*FString::Printf(TEXT("N2CCodeEditor.%s.%s.Background"),
+        *LanguageId.ToString(), *ThemeName.ToString()));
+}
+
 FString FN2CCodeEditorStyle::GetLanguageString(EN2CCodeLanguage Language)
 {
     switch (Language)
@@ -17,17 +17,15 @@ public:
 
     // Get style set for a specific language
     static const FTextBlockStyle& GetLanguageStyle(const FName& LanguageId, const FName& ThemeName, const FName& StyleId);
+    static const FSlateBrush* GetLanguageBackground(const FName& LanguageId, const FName& ThemeName);
     static FString GetLanguageString(EN2CCodeLanguage Language);
 
 private:
-    static void InitializeLanguageStyles();
-    static void InitializeCPPStyles();
-    static void InitializePythonStyles();
-    static void InitializeJavaScriptStyles();
-    static void InitializeCSharpStyles();
-    static void InitializeSwiftStyles();
-    static void InitializePseudocodeStyles();
+    /** Registers the text styles and background for one language/theme pair the first time it is requested */
+    static void EnsureLanguageStyles(const FName& LanguageId, const FName& ThemeName);
 
     static TSharedPtr<FSlateStyleSet> StyleSet;
+    /** "Language.Theme" groups already registered in StyleSet */
+    static TSet<FString> BuiltStyleGroups;
     static FTextBlockStyle CreateDefaultTextStyle(const FName& TypeName);
 };
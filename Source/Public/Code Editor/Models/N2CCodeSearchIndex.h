@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * @class FN2CCodeSearchIndex
+ * @brief Case-insensitive substring search over many documents, through an index of the trigrams of each line
+ *
+ * SetDocuments starts building the index on a background task and returns at once. Until it is built Find
+ * scans every line, and after that it only checks the lines holding all of the query's trigrams. A query
+ * that extends the previous one, as while typing, only checks the lines the previous one matched. Game
+ * thread only, apart from the build.
+ */
+class NODETOCODE_API FN2CCodeSearchIndex
+{
+public:
+    /** A line holding the query */
+    struct FHit
+    {
+        int32 Document = 0;
+
+        /** 0-based line in the document */
+        int32 Line = 0;
+
+        /** Where the first occurrence in the line starts */
+        int32 Column = 0;
+    };
+
+    /** Search these documents from now on; they are shared with the build, so must not change */
+    void SetDocuments(const TSharedRef<const TArray<FString>>& InDocuments);
+
+    /** Lines holding Query, by document and line, at most MaxHits of them. Empty for an empty query */
+    void Find(const FString& Query, int32 MaxHits, TArray<FHit>& OutHits);
+
+    /** Text of a line of a document, without its line break */
+    FStringView GetLine(int32 Document, int32 Line) const;
+
+    /** Whether Find uses the index yet */
+    bool IsBuilt();
+
+private:
+    struct FLine
+    {
+        int32 Document = 0;
+        int32 Line = 0;
+        int32 Start = 0;
+        int32 Len = 0;
+    };
+
+    /** A built index, never changed once finished */
+    struct FIndexState
+    {
+        TArray<FLine> Lines;
+
+        /** Index in Lines of the first line of each document */
+        TArray<int32> FirstLines;
+
+        /** Sorted indices into Lines of the lines holding each trigram */
+        TMap<uint64, TArray<int32>> Postings;
+    };
+
+    /** Split the documents into lines, and index their trigrams if bIndex. Runs on the background task */
+    static TSharedPtr<const FIndexState> Build(const TArray<FString>& Documents, bool bIndex);
+
+    /** Pack three lowercased characters into one key */
+    static uint64 MakeTrigram(TCHAR A, TCHAR B, TCHAR C);
+
+    /** Take the finished build, if there is one */
+    void CollectBuild();
+
+    /** Lines of Candidates, or of every line if null, that hold Query. Query is lowercased */
+    void FilterLines(const FString& Query, const TArray<int32>* Candidates, TArray<int32>& OutLines, TArray<int32>& OutColumns) const;
+
+    TSharedPtr<const TArray<FString>> Documents;
+
+    /** Lines of the documents, without the trigrams, for scanning until the index is built */
+    TSharedPtr<const FIndexState> Lines;
+
+    TSharedPtr<const FIndexState> State;
+    UE::Tasks::TTask<TSharedPtr<const FIndexState>> BuildTask;
+
+    /** The previous query and every line it matched, with the column of each */
+    FString LastQuery;
+    TArray<int32> LastLines;
+    TArray<int32> LastColumns;
+};
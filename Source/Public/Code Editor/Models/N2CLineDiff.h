@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** How a run of lines differs between the old and new text */
+enum class EN2CDiffOp : uint8
+{
+    Equal,
+    Delete,
+    Insert
+};
+
+/** Consecutive lines with the same op. Deleted lines index the old text, inserted ones the new text */
+struct FN2CDiffRun
+{
+    EN2CDiffOp Op = EN2CDiffOp::Equal;
+    int32 OldStart = 0;
+    int32 NewStart = 0;
+    int32 Count = 0;
+};
+
+/**
+ * @class FN2CLineDiff
+ * @brief Line diff of two texts with Myers' algorithm in linear space
+ *
+ * Lines are interned to integer ids first, so the search compares ints instead of strings. Common
+ * leading and trailing lines are stripped before each search for the middle snake, which keeps the
+ * usual case of a few edits in a large file close to linear.
+ */
+class FN2CLineDiff
+{
+public:
+    /** Runs that turn OldText into NewText, in order */
+    static TArray<FN2CDiffRun> Diff(const FString& OldText, const FString& NewText);
+
+private:
+    /** Diff the ranges [OldBegin, OldEnd) and [NewBegin, NewEnd) of the id sequences */
+    static void DiffRange(const TArray<int32>& Old, int32 OldBegin, int32 OldEnd,
+        const TArray<int32>& New, int32 NewBegin, int32 NewEnd, TArray<FN2CDiffRun>& OutRuns);
+
+    /** Append a run, merging it into the last one when they continue each other */
+    static void AddRun(TArray<FN2CDiffRun>& OutRuns, EN2CDiffOp Op, int32 OldStart, int32 NewStart, int32 Count);
+};
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Code Editor/Models/N2CCodeSearchIndex.h"
+#include "Models/N2CTranslation.h"
+#include "N2CTranslationBrowser.generated.h"
+
+class UN2CCodeEditorWidget;
+
+/**
+ * @struct FN2CTranslationGraphInfo
+ * @brief What the result browser lists for one translated graph, without its code
+ */
+USTRUCT(BlueprintType)
+struct FN2CTranslationGraphInfo
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    FString GraphName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    FString GraphType;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    FString GraphClass;
+
+    /** Characters of the declaration */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 DeclarationLength = 0;
+
+    /** Characters of the implementation */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 ImplementationLength = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 ImplementationLines = 0;
+};
+
+/**
+ * @struct FN2CCodeSearchMatch
+ * @brief A line of a translated graph's code that holds the searched text
+ */
+USTRUCT(BlueprintType)
+struct FN2CCodeSearchMatch
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 GraphIndex = INDEX_NONE;
+
+    /** In the implementation, or else the declaration */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    bool bImplementation = false;
+
+    /** 0-based line and column where the match starts */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 Line = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 Column = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    int32 Length = 0;
+
+    /** The line, trimmed and shortened for listing */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Translation Browser")
+    FString LineText;
+};
+
+/**
+ * @class UN2CTranslationBrowser
+ * @brief Index of the graphs of a translation result, with their code shown on demand
+ *
+ * The UI lists GetGraphs and calls ShowGraph when one is selected. Only then is the graph's code put in
+ * the code editors, each graph as its own document, so the editors keep the layouts of the most recently
+ * shown graphs and drop the rest. ShowGraphDiff shows the changes from the previous translation instead.
+ * FindInGraphs searches the code of every graph, through an index built in the background when the
+ * result is set, and ShowMatch opens a match at its line.
+ */
+UCLASS(BlueprintType)
+class NODETOCODE_API UN2CTranslationBrowser : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Index a translation result, replacing the previous one */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Translation Browser")
+    void SetResponse(const FN2CTranslationResponse& Response);
+
+    /** The indexed graphs, in response order */
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Translation Browser")
+    const TArray<FN2CTranslationGraphInfo>& GetGraphs() const { return Graphs; }
+
+    /** Get the code of one graph */
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Translation Browser")
+    bool GetGraphCode(int32 GraphIndex, FN2CGeneratedCode& OutCode) const;
+
+    /** Show a graph's declaration and implementation in the given editors. Either editor may be null */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Translation Browser")
+    bool ShowGraph(int32 GraphIndex, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor);
+
+    /**
+     * Show how a graph's code changed since the previous translation of BlueprintName saved it, side by side
+     * in the given editors. False if the graph has no earlier saved output
+     */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Translation Browser")
+    bool ShowGraphDiff(int32 GraphIndex, const FString& BlueprintName, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor);
+
+    /**
+     * Find Query, ignoring case, in the declarations and implementations of every graph, by graph and line.
+     * Meant to be called on each edit of a search box: a query extending the last one only checks its matches
+     */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Translation Browser")
+    TArray<FN2CCodeSearchMatch> FindInGraphs(const FString& Query, int32 MaxMatches = 500);
+
+    /** Show a match's graph in the given editors, with the match selected in the editor holding it */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Translation Browser")
+    bool ShowMatch(const FN2CCodeSearchMatch& Match, UN2CCodeEditorWidget* DeclarationEditor, UN2CCodeEditorWidget* ImplementationEditor);
+
+private:
+    TArray<FN2CTranslationGraphInfo> Graphs;
+
+    /** Code of each graph in Graphs */
+    TArray<FN2CGeneratedCode> Code;
+
+    /** Over the declaration and implementation of each graph, in turn */
+    FN2CCodeSearchIndex SearchIndex;
+
+    /** Distinguishes the document keys of one response from the next */
+    int32 ResponseId = 0;
+};
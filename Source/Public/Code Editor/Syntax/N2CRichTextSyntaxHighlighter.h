@@ -3,7 +3,10 @@
 #pragma once
 
 #include "N2CSyntaxDefinition.h"
+#include "N2CSyntaxTokenizer.h"
 #include "Framework/Text/SyntaxHighlighterTextLayoutMarshaller.h"
+#include "Framework/Text/TextLayout.h"
+#include "Tasks/Task.h"
 #include "Code Editor/Models/N2CCodeEditorStyle.h"
 
 
@@ -11,6 +14,13 @@ class FTextLayout;
 
 /**
  * Handles syntax highlighting for different programming languages
+ *
+ * The runs of each line are cached with the lexer state the line starts and ends in. When the text
+ * changes, only the edited lines are lexed again, followed by the lines after them until one starts in
+ * the same state as before; the rest reuse their cached runs.
+ *
+ * When that is more than AsyncLexLineThreshold lines, the text is shown plain and lexed on a worker
+ * into the cache. Once done, the marshaller is made dirty and the layout picks up the highlighted lines.
  */
 class FN2CRichTextSyntaxHighlighter : public FSyntaxHighlighterTextLayoutMarshaller
 {
@@ -45,16 +55,134 @@ public:
 
     static TSharedRef<FN2CRichTextSyntaxHighlighter> Create(EN2CCodeLanguage Language, const FName& ThemeName, const FTextBlockStyle& BaseStyle = FTextBlockStyle());
 
+    /**
+     * Resolved styles for a language, theme and font, shared by every highlighter using them so that
+     * recreating a highlighter or opening another editor doesn't look the styles up again
+     */
+    static TSharedRef<const FSyntaxTextStyle> GetSharedStyle(const FName& LanguageId, const FName& ThemeName, const FSlateFontInfo& Font);
+
+    /** Drop the shared styles, for when the style set they were resolved from goes away */
+    static void ResetSharedStyles();
+
+    /**
+     * Highlight with another language, theme or font in place. The text widget using this marshaller
+     * keeps its layout and only refreshes its runs
+     */
+    void SetLanguage(EN2CCodeLanguage Language, const FName& ThemeName, const FTextBlockStyle& BaseStyle);
+
+    /** Styles used to display the text */
+    const FSyntaxTextStyle& GetSyntaxTextStyle() const { return *SyntaxTextStyle; }
+
+    /** Hold text for a viewer that lays out one line at a time. Nothing is lexed until a line is asked for */
+    void SetViewerText(const FString& SourceString);
+
+    int32 GetNumViewerLines() const { return ViewerLineRanges.Num(); }
+
+    FString GetViewerLineText(int32 LineIndex) const;
+
+    /** Lex the viewer text up to and including LastLineIndex, if it isn't already */
+    void LexViewerLines(int32 LastLineIndex);
+
+    /** Add one highlighted line of the viewer text to a layout */
+    void AddViewerLineToLayout(int32 LineIndex, FTextLayout& TargetTextLayout);
+
+    /**
+     * Whether a fold region of the viewer text starts at an already lexed line: one that leaves a curly brace
+     * open or, for indented languages, is followed by more indented lines
+     */
+    bool CanFoldViewerLine(int32 LineIndex) const;
+
+    /**
+     * Last line hidden by folding the region starting at LineIndex, lexing on until the region closes.
+     * INDEX_NONE if no region starts there
+     */
+    int32 FindViewerFoldEnd(int32 LineIndex);
+
+    /** Drop the text and runs kept for lexed viewer lines a fold hides. A line is lexed again if it is shown */
+    void ReleaseViewerLines(int32 FirstLineIndex, int32 LastLineIndex);
+
     virtual ~FN2CRichTextSyntaxHighlighter();
 
+    virtual void SetText(const FString& SourceString, FTextLayout& TargetTextLayout) override;
+
 protected:
     virtual void ParseTokens(const FString& SourceString, FTextLayout& TargetTextLayout, TArray<ISyntaxTokenizer::FTokenizedLine> TokenizedLines) override;
 
-    FN2CRichTextSyntaxHighlighter(TSharedPtr<ISyntaxTokenizer> InTokenizer, const FSyntaxTextStyle& InSyntaxTextStyle, TSharedPtr<FN2CSyntaxDefinition> InSyntaxDef);
+    FN2CRichTextSyntaxHighlighter(TSharedRef<FN2CSyntaxTokenizer> InTokenizer, TSharedRef<const FSyntaxTextStyle> InSyntaxTextStyle, TSharedPtr<const FN2CSyntaxDefinition> InSyntaxDef);
 
 private:
+    enum class EParseState : uint8
+    {
+        None,
+        LookingForString,
+        LookingForChar,
+        LookingForLineComment,
+        LookingForBlockComment,
+        LookingForPreprocessor
+    };
+
+    enum class ERunStyle : uint8
+    {
+        Normal,
+        WhiteSpace,
+        String,
+        Comment,
+        Parentheses,
+        CurlyBraces,
+        SquareBrackets,
+        Keyword,
+        Operator,
+        Number,
+        Preprocessor
+    };
+
+    /** A styled range of a line, relative to the line start */
+    struct FRunSpan
+    {
+        FTextRange Range;
+        ERunStyle Style;
+    };
+
+    /** Lexed form of one line of the text */
+    struct FLine
+    {
+        FString Text;
+        EParseState StartState = EParseState::None;
+        EParseState EndState = EParseState::None;
+        TArray<FRunSpan> Spans;
+
+        /** Curly brace nesting at the start of the line, the lowest it gets within it, and at its end (viewer text only) */
+        int32 BraceDepth = 0;
+        int32 MinBraceDepth = 0;
+        int32 EndBraceDepth = 0;
+
+        /** Text and spans were dropped by ReleaseViewerLines; the states and depths still hold */
+        bool bReleased = false;
+    };
+
+    /** Style the tokens of one line, starting in StartState */
+    void LexLine(const FString& SourceString, const ISyntaxTokenizer::FTokenizedLine& TokenizedLine, EParseState StartState, FLine& OutLine) const;
+
+    /** Lex one line of the viewer text into Line, tracking its curly brace depth from the line above */
+    void LexViewerLine(int32 LineIndex, FLine& OutLine) const;
+
+    /** Whether the viewer text folds by indentation rather than curly braces */
+    bool FoldsByIndentation() const;
+
+    /** Indentation width of a viewer line, or INDEX_NONE if it is blank */
+    int32 GetViewerLineIndent(int32 LineIndex) const;
+
+    /** Add the cached lines to the layout as runs */
+    void AddLinesToLayout(FTextLayout& TargetTextLayout) const;
+
+    /** Add the text to the layout unhighlighted and lex all of it on a worker */
+    void StartAsyncLex(const FString& SourceString, const TArray<FTextRange>& LineRanges, FTextLayout& TargetTextLayout);
+
+    /** Fresh model string and runs for a cached line */
+    FTextLayout::FNewLineData MakeLineData(const FLine& Line) const;
+
     /** Check if a string represents a numeric value */
-    bool IsNumeric(const FString& Text) const
+    bool IsNumeric(FStringView Text) const
     {
         // Handle hexadecimal numbers
         if (Text.StartsWith(TEXT("0x")) || Text.StartsWith(TEXT("0X")))
@@ -72,7 +200,7 @@ private:
         }
 
         // Handle float suffixes
-        FString NumericPart = Text;
+        FStringView NumericPart = Text;
         if (Text.EndsWith(TEXT("f")) || Text.EndsWith(TEXT("F")))
         {
             NumericPart = Text.LeftChop(1);
@@ -110,12 +238,36 @@ private:
         return bHasDigits; // Must have at least one digit
     }
 
-    /** Styles used to display the text */
-    FSyntaxTextStyle SyntaxTextStyle;
+    /** Tokenizer of the language, shared with other highlighters and also held by the base class */
+    TSharedRef<FN2CSyntaxTokenizer> SyntaxTokenizer;
 
-    /** The syntax definition for the current language */
-    TSharedPtr<FN2CSyntaxDefinition> SyntaxDefinition;
+    /** Styles used to display the text, shared with other highlighters */
+    TSharedRef<const FSyntaxTextStyle> SyntaxTextStyle;
+
+    /** The shared syntax definition for the current language */
+    TSharedPtr<const FN2CSyntaxDefinition> SyntaxDefinition;
 
     /** String representing tabs */
     FString TabString;
+
+    /** Lines of the text last set, in order. For viewer text, only the lines lexed so far */
+    TArray<FLine> Lines;
+
+    /** Lines to re-lex above which lexing moves off the Slate thread */
+    static constexpr int32 AsyncLexLineThreshold = 2000;
+
+    /** Shared with worker results so they can tell whether they are still wanted */
+    struct FAsyncLexState
+    {
+        FN2CRichTextSyntaxHighlighter* Owner = nullptr;
+        uint32 Generation = 0;
+    };
+    TSharedRef<FAsyncLexState, ESPMode::ThreadSafe> AsyncLexState;
+
+    /** Worker lexing the last text too large to lex in place */
+    UE::Tasks::FTask AsyncLexTask;
+
+    /** Text set with SetViewerText and its line ranges */
+    FString ViewerSource;
+    TArray<FTextRange> ViewerLineRanges;
 };
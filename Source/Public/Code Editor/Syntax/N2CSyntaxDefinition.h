@@ -5,6 +5,17 @@
 #include "CoreMinimal.h"
 #include "Code Editor/Models/N2CCodeLanguage.h"
 
+/** How the highlighter styles a token that is not part of a string or comment */
+enum class EN2CSyntaxTokenKind : uint8
+{
+    None,
+    Parenthesis,
+    CurlyBrace,
+    SquareBracket,
+    Keyword,
+    Operator
+};
+
 /**
  * Base class for language-specific syntax definitions
  */
@@ -37,7 +48,18 @@ public:
     /** Get the language this definition is for */
     virtual EN2CCodeLanguage GetLanguage() const = 0;
 
+    /** Kind of a token with a single hash lookup. Matching ignores case, as comparing FStrings does */
+    EN2CSyntaxTokenKind Classify(FStringView Token) const
+    {
+        const EN2CSyntaxTokenKind* Kind = TokenKinds.FindByHash(FTokenKeyFuncs::GetKeyHash(Token), Token);
+        return Kind ? *Kind : EN2CSyntaxTokenKind::None;
+    }
+
 protected:
+    /** Index the token lists for Classify. Called by each definition once its lists are filled */
+    void BuildTokenLookup();
+
+
     TArray<FString> Keywords;
     TArray<FString> Operators;
     TArray<TCHAR> StringDelimiters;
@@ -48,4 +70,14 @@ protected:
     FString LineCommentDelimiter;
     FString BlockCommentStart;
     FString BlockCommentEnd;
+
+private:
+    /** Lets the lookup table be probed with a view into the source text instead of a copied FString */
+    struct FTokenKeyFuncs : TDefaultMapKeyFuncs<FString, EN2CSyntaxTokenKind, false>
+    {
+        static bool Matches(FStringView A, FStringView B) { return A.Equals(B, ESearchCase::IgnoreCase); }
+        static uint32 GetKeyHash(FStringView Key) { return FCrc::Strihash_DEPRECATED(Key.Len(), Key.GetData()); }
+    };
+
+    TMap<FString, EN2CSyntaxTokenKind, FDefaultSetAllocator, FTokenKeyFuncs> TokenKinds;
 };
@@ -6,16 +6,31 @@
 #include "Code Editor/Models/N2CCodeLanguage.h"
 
 class FN2CSyntaxDefinition;
+class FN2CSyntaxTokenizer;
 
+/**
+ * Hands out the syntax definition and tokenizer of each language. Both are built the first time a
+ * language is asked for and shared by every highlighter after that, so making a highlighter copies no
+ * keyword or operator tables. Only used on the game thread
+ */
 class FN2CSyntaxDefinitionFactory
 {
 public:
     /** Get the singleton instance */
     static FN2CSyntaxDefinitionFactory& Get();
 
-    /** Create a syntax definition for the specified language */
-    TSharedPtr<FN2CSyntaxDefinition> CreateDefinition(EN2CCodeLanguage Language);
+    /** Get the shared syntax definition for the specified language */
+    TSharedPtr<const FN2CSyntaxDefinition> GetDefinition(EN2CCodeLanguage Language);
+
+    /** Get the shared tokenizer built from the language's definition */
+    TSharedPtr<FN2CSyntaxTokenizer> GetTokenizer(EN2CCodeLanguage Language);
 
 private:
     FN2CSyntaxDefinitionFactory() = default;
+
+    /** Create a new syntax definition for the specified language */
+    static TSharedPtr<FN2CSyntaxDefinition> CreateDefinition(EN2CCodeLanguage Language);
+
+    TMap<EN2CCodeLanguage, TSharedPtr<const FN2CSyntaxDefinition>> Definitions;
+    TMap<EN2CCodeLanguage, TSharedPtr<FN2CSyntaxTokenizer>> Tokenizers;
 };
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Text/ISyntaxTokenizer.h"
+
+class FN2CSyntaxDefinition;
+
+/**
+ * @class FN2CSyntaxTokenizer
+ * @brief Splits code into highlighter tokens in one pass per line
+ *
+ * The operators, brackets, comment and string delimiters of a syntax definition are compiled into a
+ * trie, so each position needs one walk to find its longest symbol instead of a comparison per rule.
+ * Identifiers, numbers and whitespace runs come out as single literal tokens for the highlighter to
+ * classify, and a backslash with the character after it is kept together so escaped quotes stay inside
+ * their string. It holds no state besides the trie, so one tokenizer per language is shared by all
+ * highlighters and their lexing workers (see FN2CSyntaxDefinitionFactory::GetTokenizer).
+ */
+class FN2CSyntaxTokenizer : public ISyntaxTokenizer
+{
+public:
+    static TSharedRef<FN2CSyntaxTokenizer> Create(const FN2CSyntaxDefinition& SyntaxDefinition);
+
+    virtual void Process(TArray<FTokenizedLine>& OutTokenizedLines, const FString& Input) override;
+
+    /** Tokenize the single line of Input at LineRange */
+    void TokenizeLine(const FString& Input, const FTextRange& LineRange, FTokenizedLine& OutLine) const;
+
+private:
+    explicit FN2CSyntaxTokenizer(const FN2CSyntaxDefinition& SyntaxDefinition);
+
+    /** Symbols only use ASCII, so a trie node indexes its children directly by character */
+    static constexpr int32 NumSymbolChars = 128;
+
+    struct FTrieNode
+    {
+        FTrieNode() { Children.Init(INDEX_NONE, NumSymbolChars); }
+
+        TArray<int32, TFixedAllocator<NumSymbolChars>> Children;
+        bool bIsSymbol = false;
+    };
+
+    void AddSymbol(const FString& Symbol);
+
+    /** Length of the longest symbol starting at Text, or 0 if none does */
+    int32 MatchSymbol(const TCHAR* Text, int32 MaxLen) const;
+
+    TArray<FTrieNode> Nodes;
+};
@@ -27,6 +27,41 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Code Editor")
     void SetText(const FText& NewText);
 
+    /** Show the text of a document; the layouts of recently shown documents are kept for switching back */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor")
+    void SetDocument(FName DocumentKey, const FText& NewText);
+
+    /** Show NewText side by side with its changes from OldText, read-only, until the text is set again */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor|Diff")
+    void ShowDiff(const FText& OldText, const FText& NewText);
+
+    /** Get the current code without copying it into a new text */
+    UFUNCTION(BlueprintPure, Category = "Code Editor")
+    FString GetCode() const { return GetCodeRef(); }
+
+    /** The current code, valid until the text next changes */
+    const FString& GetCodeRef() const;
+
+    /** Set the code; it is copied once, into a text shared by the widget and the editor */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor")
+    void SetCode(const FString& NewCode);
+
+    /** SetDocument for code held as a string */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor")
+    void SetDocumentCode(FName DocumentKey, const FString& NewCode);
+
+    /** ShowDiff for code held as strings */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor|Diff")
+    void ShowCodeDiff(const FString& OldCode, const FString& NewCode);
+
+    /** Go back from the diff to the text shown before it */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor|Diff")
+    void ClearDiff();
+
+    /** Scroll the diff to its next change. False if there is none */
+    UFUNCTION(BlueprintCallable, Category = "Code Editor|Diff")
+    bool ScrollToNextChange();
+
     /** Change the programming language */
     UFUNCTION(BlueprintCallable, Category = "Code Editor")
     void SetLanguage(EN2CCodeLanguage NewLanguage);
@@ -135,6 +170,16 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Code Editor|Appearance", meta=(ClampMin="8", ClampMax="72"))
     int32 FontSize;
 
+    /** Texts with more lines than this open in a read-only viewer that only lays out the visible lines */
+    UPROPERTY(EditAnywhere, Category = "Code Editor", meta=(ClampMin="0", DisplayName="Viewer Line Threshold",
+        ToolTip="Texts with more lines than this open in a fast read-only viewer instead of the editor. 0 always uses the editor"))
+    int32 ViewerLineThreshold;
+
+    /** Documents shown with SetDocument that keep their layout */
+    UPROPERTY(EditAnywhere, Category = "Code Editor", meta=(ClampMin="1", DisplayName="Max Cached Documents",
+        ToolTip="How many documents set with Set Document keep their laid out text, so switching back to them is instant"))
+    int32 MaxCachedDocuments;
+
     /** Whether to enable word wrap */
     bool bWordWrap;
 
@@ -146,5 +191,5 @@ private:
     TSharedPtr<class SN2CCodeEditor> CodeEditorWidget;
 
     /** Callback for text changes from slate widget */
-    void HandleTextChanged(const FText& NewText);
+    void HandleTextChanged();
 };
@@ -6,7 +6,10 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Code Editor/Models/N2CCodeLanguage.h"
 
+class SBox;
 class SMultiLineEditableText;
+class SN2CCodeViewer;
+class SN2CDiffViewer;
 class FN2CRichTextSyntaxHighlighter;
 
 /**
@@ -19,6 +22,7 @@ public:
         : _Text()
         , _Language(EN2CCodeLanguage::Cpp)
         , _ThemeName(TEXT("Unreal Engine"))
+        , _ViewerLineThreshold(5000)
     {}
         /** Initial text content */
         SLATE_ATTRIBUTE(FText, Text)
@@ -28,16 +32,35 @@ public:
 
         /** Theme name for syntax highlighting */
         SLATE_ARGUMENT(FName, ThemeName)
+
+        /** Texts with more lines than this are shown in a read-only viewer. 0 always uses the editor */
+        SLATE_ARGUMENT(int32, ViewerLineThreshold)
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
 
-    /** Get the current text content */
+    /** Get the current text content, sharing the shown text's string */
     FText GetText() const;
 
+    /** The current text content, without copying it or laying it out again */
+    const FString& GetString() const;
+
     /** Set new text content */
     void SetText(const FText& NewText);
 
+    /** Set new text content, moved into the editor's text */
+    void SetString(FString NewText);
+
+    /**
+     * Show the text of a document, such as one graph of a translation. The laid out text of the most
+     * recently shown documents is kept, so switching back to one doesn't lay it out again
+     */
+    void SetDocument(FName DocumentKey, const FText& NewText);
+    void SetDocumentString(FName DocumentKey, FString NewText);
+
+    /** Set how many documents keep their layout. Older ones are dropped */
+    void SetMaxCachedDocuments(int32 NewMax);
+
     /** Change the programming language */
     void SetLanguage(EN2CCodeLanguage NewLanguage);
 
@@ -77,6 +100,25 @@ public:
     /** Set the current theme */
     void SetTheme(const FName& NewTheme);
 
+    /** Set the line count above which texts are shown in the read-only viewer. 0 always uses the editor */
+    void SetViewerLineThreshold(int32 NewThreshold);
+
+    /** Whether the current text is shown in the read-only viewer */
+    bool IsInViewerMode() const { return bViewerMode; }
+
+    /** Show NewText side by side with how it differs from OldText, read-only, until the text is set again */
+    void SetDiff(const FText& OldText, const FText& NewText);
+    void SetDiff(const FString& OldText, const FString& NewText);
+
+    /** Go back from the diff to the text shown before it */
+    void ClearDiff();
+
+    /** Whether a diff is shown */
+    bool IsInDiffMode() const { return bDiffMode; }
+
+    /** Scroll the diff to its next change. False if there is none */
+    bool ScrollToNextChange();
+
 private:
     /** Horizontal scrollbar widget */
     TSharedPtr<SScrollBar> HorizontalScrollBar;
@@ -87,6 +129,52 @@ private:
     /** The actual editable text widget */
     TSharedPtr<SMultiLineEditableText> EditableText;
 
+    /** Virtualized read-only view used instead of the editable text for very large texts */
+    TSharedPtr<SN2CCodeViewer> Viewer;
+
+    /** Whether the viewer is showing the text */
+    bool bViewerMode = false;
+
+    /** Side-by-side view of a diff, shown over the editor and viewer */
+    TSharedPtr<SN2CDiffViewer> DiffViewer;
+
+    /** Whether the diff viewer is showing */
+    bool bDiffMode = false;
+
+    /** Line count above which texts go to the viewer */
+    int32 ViewerLineThreshold = 5000;
+
+    /** Holds whichever editable text is shown */
+    TSharedPtr<SBox> EditorBox;
+
+    /** A document's own text widget and highlighter, kept while it is recently used */
+    struct FDocument
+    {
+        FName Key;
+        TSharedRef<SMultiLineEditableText> EditableText;
+        TSharedRef<FN2CRichTextSyntaxHighlighter> Highlighter;
+
+        /** Text of the widget, as last set or edited */
+        FText Text;
+    };
+
+    /**
+     * Text of the editable text, as last set or reported by its change events. Reading the editable text itself
+     * would write its whole layout back out into a new string, so it is never read
+     */
+    FText ShownText;
+
+    /** Show a text in the editable text or viewer, unless it is already shown */
+    void ShowText(const FText& NewText);
+
+    /** Show a document's text in its own editable text */
+    void ShowDocument(FName DocumentKey, const FText& NewText);
+
+    /** Documents with a layout, least recently shown first */
+    TArray<FDocument> Documents;
+
+    int32 MaxCachedDocuments = 8;
+
     /** Current syntax highlighter */
     TSharedPtr<FN2CRichTextSyntaxHighlighter> SyntaxHighlighter;
 
@@ -108,17 +196,37 @@ private:
     /** Create a new syntax highlighter for the specified language */
     void CreateSyntaxHighlighter(EN2CCodeLanguage Language);
 
-    /** Delegate for text changes */
-    DECLARE_DELEGATE_OneParam(FOnTextChanged, const FText&);
+    /** Text style the highlighter styles are built on */
+    FTextBlockStyle MakeBaseStyle() const;
 
-    /** Set the callback for text changes */
-    void SetOnTextChanged(const FOnTextChanged& InHandler) { OnTextChangedHandler = InHandler; }
+    /** Create an editable text for the current language and theme using Highlighter */
+    TSharedRef<SMultiLineEditableText> MakeEditableText(const FText& InText, const TSharedRef<FN2CRichTextSyntaxHighlighter>& Highlighter);
+
+    /** Switch the existing highlighter to the current language and theme */
+    void UpdateSyntaxHighlighter();
+
+    /** Give the viewers new highlighters. They lex their lines lazily, so they can't share the editor's */
+    void UpdateViewerHighlighters(const FTextBlockStyle& BaseStyle);
+
+    /** Background brush of the current language and theme */
+    const FSlateBrush* FindBackgroundBrush() const;
+
+    /** Brush the border shows, kept up to date by UpdateSyntaxHighlighter */
+    const FSlateBrush* BackgroundBrush = nullptr;
+
+    /** Put the editable text and the viewers in one slot, showing whichever holds the text */
+    TSharedRef<SWidget> MakeTextArea(const TSharedRef<SWidget>& EditorWidget);
+
+    /** Whether a text is long enough to go to the viewer */
+    bool ShouldUseViewer(const FString& InText) const;
 
-private:
     /** Handler for text changes */
-    FOnTextChanged OnTextChangedHandler;
+    FSimpleDelegate OnTextChangedHandler;
 
 public:
+    /** Call InHandler after each edit. It carries no text, so edits don't copy the document; read it with GetString */
+    void SetOnTextChanged(const FSimpleDelegate& InHandler) { OnTextChangedHandler = InHandler; }
+
     /** Internal callback for text changes */
     void OnTextChanged(const FText& NewText);
 
@@ -0,0 +1,105 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FN2CRichTextSyntaxHighlighter;
+class FSlateTextLayout;
+
+/** One highlighted line of a highlighter's viewer text, laid out once when created */
+class SN2CCodeViewerLine : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SN2CCodeViewerLine)
+        : _LineIndex(0)
+    {}
+        SLATE_ARGUMENT(int32, LineIndex)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<FN2CRichTextSyntaxHighlighter>& Highlighter);
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    TSharedPtr<FSlateTextLayout> TextLayout;
+};
+
+/**
+ * Read-only code view for very large texts
+ *
+ * Only the lines scrolled into view get a text layout and runs. Lines are highlighted the first time
+ * they are shown, lexing a few lines ahead so that scrolling on doesn't stall.
+ *
+ * Lines that open a curly brace block, or an indented one in Python and pseudocode, can be folded from
+ * the gutter. The region's end is found by lexing on only when it is folded. Folded lines have no rows,
+ * so they are never laid out, and their lexed runs are dropped until they are shown again.
+ */
+class SN2CCodeViewer : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SN2CCodeViewer)
+    {}
+        /** Scrollbar to scroll the lines with */
+        SLATE_ARGUMENT(TSharedPtr<SScrollBar>, VScrollBar)
+
+        /** Scrollbar to scroll long lines with */
+        SLATE_ARGUMENT(TSharedPtr<SScrollBar>, HScrollBar)
+    SLATE_END_ARGS()
+
+    /** Lines lexed beyond the last one shown */
+    static constexpr int32 OverscanLines = 32;
+
+    void Construct(const FArguments& InArgs);
+
+    /** Set the text to view */
+    void SetText(const FString& NewText);
+
+    /** Get the text being viewed */
+    const FString& GetText() const { return Text; }
+
+    /** Highlight with a different language, theme or font */
+    void SetHighlighter(const TSharedRef<FN2CRichTextSyntaxHighlighter>& InHighlighter);
+
+    /** Scroll a line into view, unfolding the regions hiding it */
+    void ScrollToLine(int32 LineIndex);
+
+    /** Fold or unfold the region starting at a line. False if no region starts there */
+    bool ToggleFold(int32 LineIndex);
+
+    /** Unfold every region */
+    void UnfoldAll();
+
+private:
+    TSharedRef<ITableRow> GenerateLineRow(TSharedPtr<int32> LineIndex, const TSharedRef<STableViewBase>& OwnerTable);
+
+    /** Hand the text to the highlighter and recreate the shown rows */
+    void RefreshLines();
+
+    /** List the lines outside folded regions as rows */
+    void RefreshVisibleLines();
+
+    /** Text being viewed */
+    FString Text;
+
+    /** Highlighter that lays out the lines, one at a time */
+    TSharedPtr<FN2CRichTextSyntaxHighlighter> Highlighter;
+
+    /** One item per line, holding its index */
+    TArray<TSharedPtr<int32>> AllLineItems;
+
+    /** Items of the lines outside folded regions, as listed */
+    TArray<TSharedPtr<int32>> LineItems;
+
+    /** Last line hidden by each folded region, by the line it starts on */
+    TMap<int32, int32> FoldedRegions;
+
+    TSharedPtr<SListView<TSharedPtr<int32>>> ListView;
+};
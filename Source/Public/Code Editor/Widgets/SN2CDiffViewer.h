@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Brushes/SlateColorBrush.h"
+#include "Code Editor/Models/N2CLineDiff.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FN2CRichTextSyntaxHighlighter;
+
+/**
+ * Read-only side-by-side diff of two texts
+ *
+ * Removed lines show on the left and added ones on the right, with changed lines paired up. Like
+ * SN2CCodeViewer, only rows in view are laid out and each side is highlighted as its lines are shown.
+ */
+class SN2CDiffViewer : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SN2CDiffViewer)
+    {}
+        /** Scrollbar to scroll the rows with */
+        SLATE_ARGUMENT(TSharedPtr<SScrollBar>, VScrollBar)
+
+        /** Scrollbar to scroll long lines with */
+        SLATE_ARGUMENT(TSharedPtr<SScrollBar>, HScrollBar)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Diff NewText against OldText */
+    void SetTexts(const FString& InOldText, const FString& InNewText);
+
+    /** The text diffed against */
+    const FString& GetOldText() const { return OldText; }
+
+    /** The text shown as the new version */
+    const FString& GetNewText() const { return NewText; }
+
+    /** Highlight with a different language, theme or font. Each side needs its own highlighter */
+    void SetHighlighters(const TSharedRef<FN2CRichTextSyntaxHighlighter>& InOldHighlighter, const TSharedRef<FN2CRichTextSyntaxHighlighter>& InNewHighlighter);
+
+    /** Scroll the next change below the top of the view to the top, wrapping around. False if there are no changes */
+    bool ScrollToNextChange();
+
+private:
+    /** A row of the diff, holding a line of either or both texts */
+    struct FDiffRow
+    {
+        int32 OldLine = INDEX_NONE;
+        int32 NewLine = INDEX_NONE;
+        bool bChanged = false;
+    };
+
+    TSharedRef<ITableRow> GenerateRow(TSharedPtr<FDiffRow> Row, const TSharedRef<STableViewBase>& OwnerTable);
+
+    /** One side of a row */
+    TSharedRef<SWidget> MakeSide(int32 LineIndex, bool bChanged, const FLinearColor& ChangedColor, const TSharedPtr<FN2CRichTextSyntaxHighlighter>& Highlighter) const;
+
+    /** Diff the texts again and recreate the shown rows */
+    void RefreshRows();
+
+    FString OldText;
+    FString NewText;
+
+    TSharedPtr<FN2CRichTextSyntaxHighlighter> OldHighlighter;
+    TSharedPtr<FN2CRichTextSyntaxHighlighter> NewHighlighter;
+
+    TArray<TSharedPtr<FDiffRow>> Rows;
+
+    TSharedPtr<SListView<TSharedPtr<FDiffRow>>> ListView;
+
+    /** Tinted per row to mark removed and added lines */
+    FSlateColorBrush RowBrush = FSlateColorBrush(FLinearColor::White);
+};
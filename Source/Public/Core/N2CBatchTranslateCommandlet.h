@@ -0,0 +1,269 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Commandlets/Commandlet.h"
+#include "LLM/N2CProviderBatchJob.h"
+#include "Models/N2CTranslation.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Utils/N2CStats.h"
+#include "N2CBatchTranslateCommandlet.generated.h"
+
+class FJsonObject;
+class FJsonValue;
+class UBlueprint;
+struct FN2CBlueprint;
+struct FN2CTranslationSession;
+enum class EN2CJsonDialect : uint8;
+enum class EN2CTokenizerFamily : uint8;
+
+/**
+ * @class UN2CBatchTranslateCommandlet
+ * @brief Headless project-wide Blueprint translation
+ *
+ * Finds Blueprints through the Asset Registry and runs them through a pipeline of overlapping stages:
+ * async package loading, game-thread extraction with FN2CNodeTranslator, background validation and
+ * serialization, and finally one request per graph through the LLM module, whose scheduler applies the
+ * provider limits and whose response handling writes the output with SaveTranslationToDisk. Each stage
+ * has a bounded number of Blueprints in flight so memory stays flat on large sweeps. Requests are sent
+ * for one Blueprint at a time so each gets its own batch output folder. If the previous run stopped part way
+ * through a Blueprint, the graphs its batch journal records as finished are carried forward instead of sent again. With -BatchApi every request of the run
+ * is instead submitted at once through the provider's batch API, which costs about half as much.
+ *
+ * Graphs with the same shape (FN2CNodeTranslator::ComputeStructuralHash), such as copy-pasted functions, are
+ * translated once per run: every other copy is saved with the first copy's translation under its own graph
+ * name, so the code still names the class the first copy was translated in.
+ *
+ * Macros of user macro libraries are translated once, with their library, instead of being inlined into every
+ * Blueprint that instantiates them: extraction leaves their graphs out, requests name them in "shared_macros" so call
+ * sites call a helper of the same name, and a library the run would not otherwise translate is added to it.
+ *
+ * With -Export the run sends nothing and instead streams the N2C JSON of every Blueprint, one condensed object
+ * per line (NDJSON), to a file or named pipe. Blueprints are serialized and written in parallel as they finish,
+ * in no fixed order, and each line is flushed as it is written, so consumers can read the export incrementally
+ * while memory stays bounded by the -MaxPrepared Blueprints in flight.
+ *
+ * With -DryRun the run sends nothing and plans the translation instead: for each Blueprint and in total, the
+ * graphs, the requests left once identical shapes and translation cache hits are taken out, their estimated
+ * input and output tokens, the cost at the provider's configured prices and the wall time at its concurrency
+ * and rate limits (see FN2CLatencyModel). The plan is logged and written to a JSON report. A dry run loads more
+ * packages at once by default, since nothing waits on requests.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=N2CBatchTranslate [-Paths=/Game/A+/Game/B] [-ParentClass=Actor+/Script/Engine.Pawn]
+ *                        [-DryRun [-Report=Path.json]] [-BatchApi] [-NoDedupe] [-InlineMacros] [-Timeout=600] [-MaxLoads=4] [-MaxPrepared=4]
+ *                        [-Export[=Path.ndjson]] [-Compact]
+ *
+ *   -Paths        Content paths to search recursively (default /Game)
+ *   -ParentClass  Only translate Blueprints deriving from one of these classes (name or object path)
+ *   -DryRun       Extract and serialize only, and estimate the translation's tokens, cost and time without sending requests
+ *   -Report       Where -DryRun writes its plan (default Saved/NodeToCode/Plans/Plan-<time>.json)
+ *   -BatchApi     Submit the requests as Anthropic or OpenAI batch jobs and wait for their results (up to 24 hours)
+ *   -NoDedupe     Send every graph, even when an identical one is translated in the same run (always the case with -BatchApi)
+ *   -InlineMacros Translate macro library graphs inline with each Blueprint using them (always the case with -Export)
+ *   -Timeout      Seconds to wait for the responses of a single Blueprint (default 600, not used with -BatchApi),
+ *                 not counting time spent outside the provider's background time window
+ *   -MaxLoads     Packages loading or loaded but not yet extracted (default 4, 16 with -DryRun)
+ *   -MaxPrepared  Blueprints serializing or serialized but not yet sent (default 4, 8 with -DryRun)
+ *   -Export       Write the N2C JSON of each Blueprint as NDJSON instead of translating
+ *                 (default Saved/NodeToCode/Export/Blueprints-<time>.ndjson)
+ *   -Compact      Export in the compact JSON dialect instead of the standard one
+ */
+UCLASS()
+class UN2CBatchTranslateCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UN2CBatchTranslateCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Translation totals across the run */
+    struct FRunStats
+    {
+        int32 Blueprints = 0;
+        int32 FailedBlueprints = 0;
+        int32 Graphs = 0;
+        int32 FailedGraphs = 0;
+        int32 ReusedGraphs = 0;
+
+        /** Macro libraries added to the run because its Blueprints instantiate their macros */
+        int32 MacroLibraries = 0;
+    };
+
+    /** Estimates of a dry run, for one Blueprint or the whole run */
+    struct FPlanStats
+    {
+        int32 Graphs = 0;
+
+        /** Requests that would be sent, after the graphs below */
+        int32 Requests = 0;
+
+        /** Graphs the translation cache already holds */
+        int32 CachedGraphs = 0;
+
+        /** Graphs repeating the shape of one translated earlier in the run */
+        int32 DuplicateGraphs = 0;
+
+        int64 InputTokens = 0;
+        int64 OutputTokens = 0;
+        double Cost = 0.0;
+        double WallSeconds = 0.0;
+
+        void Add(const FPlanStats& Other);
+        TSharedRef<FJsonObject> ToJson() const;
+    };
+
+    /** One graph request of a prepared Blueprint */
+    struct FGraphRequest
+    {
+        FString GraphName;
+        FString Json;
+        FString Fingerprint;
+
+        /** Shape of the graph, shared by its copies */
+        FString StructuralHash;
+
+        /** Estimated tokens of Json for the provider */
+        int32 JsonTokens = 0;
+
+        /** FN2CGraphComplexity::GetScore of the graph */
+        float ComplexityScore = 0.0f;
+    };
+
+    /** Output of the serialization stage */
+    struct FPreparedBlueprint
+    {
+        FString BlueprintName;
+
+        /** Extracted Blueprint, kept until its batch output folder has been started */
+        TSharedPtr<const FN2CBlueprint> Blueprint;
+
+        TArray<FGraphRequest> Requests;
+        bool bValid = false;
+    };
+
+    /** Blueprint whose requests are currently in flight */
+    struct FActiveBatch
+    {
+        TSharedPtr<FPreparedBlueprint> Blueprint;
+        TSharedPtr<int32> Remaining;
+        TSharedPtr<int32> Failed;
+        double StartTime = 0.0;
+    };
+
+    /** Collect Blueprint assets under the given paths */
+    static void FindBlueprints(const TArray<FString>& Paths, TArray<FAssetData>& OutAssets);
+
+    /** Validate and serialize an extracted Blueprint into per-graph requests (safe off the game thread) */
+    static void PrepareBlueprint(const FN2CBlueprint& Blueprint, const TSet<FString>& SharedMacroNames, EN2CJsonDialect Dialect,
+        EN2CTokenizerFamily TokenizerFamily, FPreparedBlueprint& OutPrepared);
+
+    /** Add the macro libraries the last extraction left out to the run, unless they are already part of it */
+    void ScheduleMacroLibraries(const TArray<TWeakObjectPtr<UBlueprint>>& MacroLibraries);
+
+    /** Pipeline stages, called from the pump loop in Main */
+    void StartLoads();
+    void ExtractLoaded();
+    void SendPrepared();
+    void FinishActiveBatch(bool bTimedOut);
+
+    /**
+     * Take out of a Blueprint's requests those whose shape was translated earlier in the run, saving them with
+     * that translation, and those repeating the shape of an earlier request of the Blueprint, which wait for it
+     */
+    void TakeDuplicateShapes(FPreparedBlueprint& Prepared, const FN2CTranslationSession& Session, TMap<FString, TArray<FGraphRequest>>& OutWaitingCopies);
+
+    /** Save a translation as that of a graph of the same shape in the current batch. False if it could not be saved */
+    bool SaveShapeCopy(const FN2CGraphTranslation& Translation, const FGraphRequest& Request, const FN2CTranslationSession& Session);
+
+    /** Add a prepared Blueprint's estimates to the dry run's plan */
+    void PlanBlueprint(const FPreparedBlueprint& Prepared);
+
+    /** Log the dry run's totals and write its report. False if the report could not be written */
+    bool WritePlanReport() const;
+
+    /** Queue a prepared Blueprint's requests for the provider batch job */
+    void QueueBatchItems(const FPreparedBlueprint& Prepared);
+
+    /** Submit the queued requests once every Blueprint has been prepared */
+    void SubmitBatchItems();
+
+    /** Validate an extracted Blueprint and append its JSON line to the export (safe off the game thread). False if it failed */
+    bool ExportBlueprint(const FN2CBlueprint& Blueprint, EN2CJsonDialect Dialect);
+
+    /** Pump HTTP, tickers, async loading and game thread tasks once */
+    static void Tick(double& LastTime);
+
+    /** Parsed options */
+    TArray<UClass*> ParentClasses;
+    bool bDryRun = false;
+    bool bBatchApi = false;
+    bool bDedupeShapes = true;
+    bool bShareMacros = true;
+    double TimeoutSeconds = 600.0;
+    int32 MaxLoads = 4;
+    int32 MaxPrepared = 4;
+
+    /** NDJSON export target, open for the run when exporting. Written by the serialization workers under ExportLock */
+    TUniquePtr<FArchive> ExportArchive;
+    FCriticalSection ExportLock;
+    bool bCompactExport = false;
+    int32 ExportedBlueprints = 0;
+
+    /** Assets not yet requested for loading, in order */
+    TArray<FAssetData> PendingAssets;
+    int32 NextAsset = 0;
+
+    /** Packages of the Blueprints the run translates or has still to load */
+    TSet<FName> ScheduledPackages;
+
+    /** Macro libraries the run's Blueprints instantiate macros of, translated whatever the class filter */
+    TSet<FName> MacroLibraryPackages;
+
+    /** Packages requested but not yet loaded */
+    int32 LoadsInFlight = 0;
+
+    /** Loaded Blueprints waiting for extraction, kept alive until extracted */
+    TArray<TStrongObjectPtr<UBlueprint>> LoadedBlueprints;
+
+    /** Blueprints handed to the serialization stage and not yet finished */
+    int32 PreparesInFlight = 0;
+
+    /** Serialized Blueprints waiting to be sent */
+    TArray<TSharedPtr<FPreparedBlueprint>> PreparedBlueprints;
+
+    FActiveBatch ActiveBatch;
+
+    /** Requests collected for the provider batch job */
+    TArray<FN2CBatchJobItem> BatchItems;
+
+    /** Whether the provider batch job has been submitted and has not ended */
+    bool bBatchJobInFlight = false;
+
+    /** Translation of each graph shape translated so far, by structural hash */
+    TMap<FString, FN2CGraphTranslation> ShapeTranslations;
+
+    /** Blueprints extracted since the last garbage collection */
+    int32 ExtractedSinceCollection = 0;
+
+    FRunStats Stats;
+
+    /** Dry run totals, the report entry of each Blueprint planned, and where the report goes */
+    FPlanStats PlanTotals;
+    TArray<TSharedPtr<FJsonValue>> PlannedBlueprints;
+    FString PlanReportPath;
+
+    /** Shapes the dry run's requests translate, by structural hash */
+    TSet<FString> PlannedShapes;
+
+    /** Estimated tokens of the system prompt each request of the dry run carries */
+    int32 PlanSystemPromptTokens = 0;
+
+    /** Memory used over the run, sampled on every pass */
+    FN2CPeakMemory PeakMemory;
+};
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Views/STreeView.h"
+
+class SSearchBox;
+struct FN2CBlueprint;
+
+/**
+ * Tree of a Blueprint's extracted data: graphs, their nodes, pins and flows, and its structs, enums,
+ * variables and components
+ *
+ * Meant for dumps far too large to read as JSON. Items only hold indices into the Blueprint and are created
+ * when their parent is first expanded, and the tree view only lays out the rows in view, so opening a graph
+ * of tens of thousands of nodes costs a small item per node and no widgets beyond the visible ones. Search
+ * walks the data itself and lists the matches, each expandable like the item it matched.
+ */
+class SN2CBlueprintInspector : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SN2CBlueprintInspector)
+    {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    /** Register the tab spawner */
+    static void RegisterTabSpawner();
+
+    /** Unregister the tab spawner */
+    static void UnregisterTabSpawner();
+
+    /** Open the inspector tab, or bring it to front, showing Blueprint */
+    static void Inspect(const TSharedRef<const FN2CBlueprint>& Blueprint, const FString& Title);
+
+    /** Show a Blueprint, collapsing the tree and clearing the search */
+    void SetBlueprint(const TSharedPtr<const FN2CBlueprint>& InBlueprint, const FString& InTitle);
+
+    /** Get the tab identifier */
+    static const FName TabId;
+
+private:
+    enum class EItemKind : uint8
+    {
+        Graphs,
+        Graph,
+        Nodes,
+        Node,
+        Pin,
+        Flows,
+        ExecutionChain,
+        DataFlow,
+        LocalVariables,
+        Structs,
+        Struct,
+        StructMember,
+        Enums,
+        Enum,
+        EnumValue,
+        Variables,
+        Variable,
+        Components,
+        Component,
+        ComponentProperty,
+        Placeholder
+    };
+
+    /**
+     * A row of the tree. Index is the element of its kind, e.g. the node or struct, and SubIndex the one within
+     * it, e.g. the pin over inputs then outputs. A variable with a graph is one of its local variables
+     */
+    struct FItem
+    {
+        EItemKind Kind = EItemKind::Placeholder;
+        int32 GraphIndex = INDEX_NONE;
+        int32 Index = INDEX_NONE;
+        int32 SubIndex = INDEX_NONE;
+
+        /** Search matches show where they are */
+        bool bShowPath = false;
+
+        bool bChildrenBuilt = false;
+        TArray<TSharedPtr<FItem>> Children;
+    };
+
+    using FItemPtr = TSharedPtr<FItem>;
+
+    static TSharedRef<SDockTab> SpawnTab(const FSpawnTabArgs& Args);
+
+    static FItemPtr MakeItem(EItemKind Kind, int32 GraphIndex = INDEX_NONE, int32 Index = INDEX_NONE, int32 SubIndex = INDEX_NONE);
+
+    TSharedRef<ITableRow> GenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+    /** Children of an expanded item, built the first time; an unexpanded one only reports whether it has any */
+    void GetChildren(FItemPtr Item, TArray<FItemPtr>& OutChildren);
+
+    /** Number of children an item has, without creating them */
+    int32 GetNumChildren(const FItem& Item) const;
+
+    void BuildChildren(FItem& Item) const;
+
+    /** Name column and value column of an item */
+    FString GetItemLabel(const FItem& Item) const;
+    FString GetItemValue(const FItem& Item) const;
+
+    /** List the items matching the search text, or the top level sections without one */
+    void RefreshRoots();
+
+    void OnSearchTextChanged(const FText& InText);
+
+    /** Pick a JSON dump or binary snapshot and show it once loaded */
+    FReply OnOpenClicked();
+
+    /** The inspector in the open tab */
+    static TWeakPtr<SN2CBlueprintInspector> ActiveInspector;
+
+    TSharedPtr<const FN2CBlueprint> Blueprint;
+    FString Title;
+    FString SearchText;
+
+    /** Whether the search found more matches than are listed */
+    bool bSearchTruncated = false;
+
+    TArray<FItemPtr> Roots;
+    TSharedPtr<STreeView<FItemPtr>> TreeView;
+    TSharedPtr<SSearchBox> SearchBox;
+
+    /** Shared child reported for unexpanded items so they get an expander without building their children */
+    FItemPtr PlaceholderItem;
+};
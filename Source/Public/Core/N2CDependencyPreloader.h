@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+
+/**
+ * @class FN2CDependencyPreloader
+ * @brief Streams in the Blueprint packages a deep translation will follow calls into, before extraction starts
+ *
+ * With a translation depth above zero, extraction follows called functions and parent classes into other
+ * Blueprints, and any of them not yet loaded would be loaded synchronously in the middle of it. The pre-pass
+ * walks the Asset Registry's package dependencies to the translation depth, hard and soft, keeps the user
+ * Blueprint packages that are not loaded yet, and loads them all with LoadPackageAsync at once. Reads the
+ * registry only, so no package is touched until it is streamed. Game thread only.
+ */
+class FN2CDependencyPreloader
+{
+public:
+    /**
+     * Load the unloaded user Blueprints Blueprint depends on, to Depth levels, then call OnLoaded on the game thread.
+     * Calls OnLoaded at once when there is nothing to load. Failed loads are logged and do not hold it back
+     */
+    static void Preload(const UBlueprint* Blueprint, int32 Depth, TFunction<void()> OnLoaded);
+
+    /** Unloaded user Blueprint packages that Blueprint depends on, to Depth levels, nearest first */
+    static void FindUnloadedDependencies(const UBlueprint* Blueprint, int32 Depth, TArray<FName>& OutPackages);
+};
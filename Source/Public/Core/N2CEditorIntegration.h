@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "BlueprintEditorModule.h"
 #include "BlueprintEditor.h"
+#include "Containers/Ticker.h"
 #include "Code Editor/Models/N2CCodeLanguage.h"
 #include "Utils/N2CLogger.h"
 #include "LLM/IN2CLLMService.h"
+#include "Models/N2CBlueprint.h"
+
+class SNotificationItem;
+class UToolMenu;
 
 /**
  * @class FN2CEditorIntegration
@@ -33,6 +38,12 @@ public:
     /** Get the default theme for a language */
     FName GetDefaultTheme(EN2CCodeLanguage Language) const;
 
+    /** Cancel the running translation: a batch still being prepared is not sent, and queued and in-flight requests are aborted */
+    void CancelTranslation();
+
+    /** Whether a translation is being prepared, queued or in flight */
+    bool IsTranslationInProgress() const;
+
 private:
     /** Constructor */
     FN2CEditorIntegration() = default;
@@ -45,22 +56,122 @@ public:
     void RegisterBlueprintEditorCallback();
 
 private:
-    /** Map of Blueprint Editor instances to their command lists */
-    TMap<TWeakPtr<FBlueprintEditor>, TSharedPtr<FUICommandList>> EditorCommandLists;
+    /** Add the Node to Code combo button to the Blueprint Editor toolbar menu, once for all editors */
+    void RegisterToolbarMenu();
 
-    /** Register toolbar for a specific Blueprint Editor */
-    void RegisterToolbarForEditor(TSharedPtr<FBlueprintEditor> InEditor);
+    /** Fill the combo button's menu with actions bound to the editor in the menu's context */
+    void FillToolbarMenu(UToolMenu* InMenu);
 
     /** Execute collect nodes for a specific editor */
     void ExecuteCollectNodesForEditor(TWeakPtr<FBlueprintEditor> InEditor);
 
     /** Execute copy blueprint JSON to clipboard for a specific editor */
     void ExecuteCopyJsonForEditor(TWeakPtr<FBlueprintEditor> InEditor);
+
+    /** Show the focused graph's extracted data in the Blueprint inspector */
+    void ExecuteInspectBlueprintForEditor(TWeakPtr<FBlueprintEditor> InEditor);
     
     /** Execute translate entire blueprint (all graphs) for a specific editor */
     void ExecuteTranslateEntireBlueprintForEditor(TWeakPtr<FBlueprintEditor> InEditor);
-    
-    /** Handle asset editor opened callback */
-    void HandleAssetEditorOpened(UObject* Asset, IAssetEditorInstance* EditorInstance);
+
+    /** Extract a Blueprint, in slices if it is huge, and translate it */
+    void ExtractAndTranslateBlueprint(UBlueprint* OwnerBP, bool bIncludeVariables);
+
+    /** Extract the next slice of a Blueprint too large to extract at once, and translate it once it is extracted */
+    bool TickSlicedExtraction(float DeltaTime);
+
+    /** Prepare the requests of an extracted Blueprint on a worker and send them */
+    void TranslateExtractedBlueprint(const FString& BlueprintName, const TSharedRef<FN2CBlueprint>& FullBlueprint);
+
+    /** Requests prepared off the game thread for Translate Entire Blueprint */
+    struct FBatchTranslationPlan;
+
+    /** Settings snapshot used to build a plan on a worker */
+    struct FBatchTranslationOptions;
+
+    /** Progress of a plan's requests once dispatched */
+    struct FBatchDispatch;
+
+    /**
+     * Validate, fingerprint, serialize and pack a Blueprint's graphs. With PreviousBlueprint, graphs that changed a
+     * little since it are sent as deltas against the code saved in OutPlan.PreviousRootPath. Reads only the
+     * Blueprints and saved files, safe on a worker
+     */
+    static bool BuildBatchTranslationPlan(
+        const FN2CBlueprint& FullBlueprint,
+        const TMap<FString, FString>* PreviousFingerprints,
+        const FN2CBlueprint* PreviousBlueprint,
+        const FBatchTranslationOptions& Options,
+        FBatchTranslationPlan& OutPlan);
+
+    /**
+     * Make each request wait on the requests translating the Blueprint's functions and macros it calls, and collect
+     * the saved declarations of callees that are unchanged. Requests caught in call cycles do not wait
+     */
+    static void LinkRequestsByCalls(const FN2CBlueprint& FullBlueprint, FBatchTranslationPlan& OutPlan);
+
+    /**
+     * Carry forward unchanged graphs and send the prepared requests, callees first. With StreamedDispatch, the
+     * requests were already sent through it as they were built, and this only completes the batch. Game thread only
+     */
+    void DispatchBatchTranslation(const TSharedRef<FBatchTranslationPlan>& Plan, const TSharedPtr<FBatchDispatch>& StreamedDispatch = nullptr);
+
+    /** Send a request whose callees are done, with their declarations */
+    void SendBatchRequest(const TSharedRef<FBatchDispatch>& Dispatch, int32 RequestIndex);
+
+    /** Record a request's graphs, release the requests waiting on it and end the batch after the last one */
+    void HandleBatchResponse(const TSharedRef<FBatchDispatch>& Dispatch, int32 RequestIndex, const FN2CTranslationResponse& TranslationResponse, bool bSuccess);
+
+    /** Log the summary of a batch whose requests have all been answered, and end it */
+    void FinishBatchDispatch(const TSharedRef<FBatchDispatch>& Dispatch);
+
+    /** Batch whose requests are being sent, so cancelling stops the ones still waiting */
+    TWeakPtr<FBatchDispatch> ActiveBatchDispatch;
+
+    /** Set while a translation is being validated and serialized on a worker */
+    bool bPreparingTranslation = false;
+
+    /** Set when the translation being prepared was cancelled, so it is dropped instead of dispatched */
+    bool bCancelPreparedTranslation = false;
+
+    /** Blueprint being extracted in slices, with the notification showing its progress */
+    FString SlicedBlueprintName;
+    TSharedPtr<SNotificationItem> SlicedExtractionNotification;
+    FTSTicker::FDelegateHandle SlicedExtractionTickerHandle;
+
+    /** Set while Copy JSON serializes on a worker */
+    bool bCopyingJson = false;
+
+    /** Pretty JSON of the last Blueprint copied or translated, with the fingerprint of the FN2CBlueprint it came from */
+    FString CachedPrettyJsonFingerprint;
+    FString CachedPrettyJson;
+
+    /** Guards the cached pretty JSON, which workers read and fill */
+    FCriticalSection PrettyJsonCacheLock;
+
+    /** Pretty-printed JSON for Blueprint, served from the cache when the Blueprint is unchanged. Safe on a worker */
+    FString GetPrettyJson(const FN2CBlueprint& Blueprint);
+
+    /** Note an edit to a graph, so it is pre-translated once editing pauses */
+    void HandleObjectModified(UObject* Object);
+
+    /** Pre-translate the edited graph once it has been idle long enough and is still focused */
+    bool TickSpeculativeTranslation(float DeltaTime);
+
+    /** Collect and serialize a graph, and queue its speculative translation */
+    void StartSpeculativeTranslation(UEdGraph* Graph);
+
+    /** Graph edited since it was last pre-translated, with the time of the last edit */
+    TWeakObjectPtr<UEdGraph> SpeculativeGraph;
+    double LastGraphEditTime = 0.0;
+
+    /** Set while a speculative translation is serialized on a worker */
+    bool bPreparingSpeculation = false;
+
+    /** JSON whose speculative translation was last shown, so translating it again sends the full request */
+    FString LastSpeculativeJsonShown;
+
+    FDelegateHandle ObjectModifiedHandle;
+    FTSTicker::FDelegateHandle SpeculativeTickerHandle;
 
 };
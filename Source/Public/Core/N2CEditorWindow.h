@@ -6,6 +6,8 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Docking/SDockTab.h"
 
+struct FN2CMetricsDashboard;
+
 class SN2CEditorWindow : public SCompoundWidget
 {
 public:
@@ -33,4 +35,15 @@ public:
 private:
     /** The currently active tab */
     static TWeakPtr<SDockTab> ActiveTab;
+
+    /** Panel showing queue depth, latency, throughput, cache hits and cost while translations run */
+    TSharedRef<SWidget> BuildMetricsPanel();
+
+    /** Refresh the metrics text about once a second, rather than summarizing the requests every frame */
+    EActiveTimerReturnType RefreshMetrics(double InCurrentTime, float InDeltaTime);
+
+    /** Metrics as a fixed-width table, one row per provider and model */
+    static FText FormatMetrics(const FN2CMetricsDashboard& Dashboard);
+
+    FText MetricsText;
 };
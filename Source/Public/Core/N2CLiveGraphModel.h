@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Models/N2CBlueprint.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FEdGraphEditAction;
+
+/**
+ * @class FN2CLiveGraphModel
+ * @brief Translation models of the graphs being worked on, kept up to date from editor change notifications
+ *
+ * A graph's model is the Blueprint structure FN2CNodeTranslator builds from its nodes, together with the
+ * collapsed graphs and functions it pulled in. Once a graph has been translated, copied or pre-translated,
+ * its model is kept, and the graph and its sources are watched through their graph-changed handlers and the
+ * engine's modify and property-change notifications. A change marks only the models it touches, and they are
+ * rebuilt once the editor has been idle for a moment, so the next translation serializes a ready model
+ * instead of walking the graph's nodes. Edits to user structs and enums, and undo or redo, mark every model.
+ * Without Maintain Live Graph Models, every request builds a fresh model. Game thread only.
+ */
+class FN2CLiveGraphModel
+{
+public:
+    /** Get the singleton instance */
+    static FN2CLiveGraphModel& Get();
+
+    /** Model of Graph, up to date with its nodes. Null if it has no translatable nodes or failed to translate */
+    TSharedPtr<const FN2CBlueprint> GetModel(UEdGraph* Graph);
+
+    /** Drop every model and stop watching their graphs */
+    void Reset();
+
+private:
+    /** Constructor - binds the change notifications */
+    FN2CLiveGraphModel();
+
+    struct FGraphModel
+    {
+        /** Null until built, and again when the graph has nothing to translate */
+        TSharedPtr<const FN2CBlueprint> Blueprint;
+
+        /** Other graphs the model was built from, whose changes also mark it */
+        TArray<TWeakObjectPtr<UEdGraph>> Sources;
+
+        /** Blueprint owning the graph, whose variable and class changes mark it */
+        TWeakObjectPtr<UBlueprint> Owner;
+
+        bool bDirty = true;
+    };
+
+    /** Whether models are kept between requests */
+    static bool IsEnabled();
+
+    /** Build Graph's model from its nodes into Model, watching every graph it was built from */
+    void BuildModel(UEdGraph* Graph, FGraphModel& Model);
+
+    /** Subscribe to Graph's graph-changed notifications, once */
+    void WatchGraph(UEdGraph* Graph);
+
+    void MarkGraphDirty(const UEdGraph* Graph);
+    void MarkBlueprintDirty(const UBlueprint* Blueprint);
+    void MarkAllDirty();
+
+    void HandleGraphChanged(const FEdGraphEditAction& Action);
+    void HandleObjectModified(UObject* Object);
+    void HandleObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+    void HandleUndoRedo();
+
+    /** Rebuild a marked model once the editor has been idle, and drop those of deleted graphs */
+    bool Tick(float DeltaTime);
+
+    /** Models by the graph they translate */
+    TMap<TWeakObjectPtr<UEdGraph>, FGraphModel> Models;
+
+    /** Graph-changed subscriptions of the graphs watched, models' own and their sources */
+    TMap<TWeakObjectPtr<UEdGraph>, FDelegateHandle> WatchedGraphs;
+
+    /** When the last change that marked a model arrived */
+    double LastChangeTime = 0.0;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "Models/N2CBlueprint.h"
+#include "Models/N2CTranslation.h"
+
+/**
+ * @class FN2CLocalTranslator
+ * @brief Translates trivial function graphs to code directly, without an LLM
+ *
+ * Covers function graphs of a few nodes whose exec flow is one chain, optionally guarded by branches with a
+ * single connected output, made of variable gets and sets, calls on self or on a function library, and
+ * math operators, over plain value types. Anything else, including pins whose C++ type cannot be told from
+ * the graph, is declined and left to the LLM. Only reads the graph, so it is safe off the game thread.
+ */
+class NODETOCODE_API FN2CLocalTranslator
+{
+public:
+    /** Whether graphs can be translated locally to Language */
+    static bool SupportsLanguage(EN2CCodeLanguage Language);
+
+    /** Translate Graph if it has at most MaxNodes nodes and only what the translator covers. False leaves OutTranslation untouched */
+    static bool TryTranslate(
+        const FN2CGraph& Graph,
+        const FN2CMetadata& Metadata,
+        EN2CCodeLanguage Language,
+        int32 MaxNodes,
+        FN2CGraphTranslation& OutTranslation);
+};
@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "LLM/N2CLLMTypes.h"
+#include "N2CModelBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+/**
+ * @class UN2CModelBenchmarkCommandlet
+ * @brief Compares providers and models on the same graphs, for picking the one to translate with
+ *
+ * The corpus is an N2C JSON export, such as the batch commandlet's -Export writes with one Blueprint per line,
+ * a folder of N2C JSON files, or the graphs of the given Blueprints, serialized once. For each configuration in
+ * turn the whole corpus is queued at once, so the scheduler sends it as fast as the provider's concurrency and rate limits allow, and the run's
+ * latency percentiles, output tokens per second, parse success rate, tokens and cost at the configured prices
+ * are written to one JSON report, with a comparison table in the log. Translations are saved per configuration
+ * beside the report, so their quality can be compared as well. The translation cache, routing and speculative
+ * translation are off for the run.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=N2CModelBenchmark -Configs=Anthropic:Claude4_Sonnet+OpenAI:GPT_o4_mini
+ *                        (-Corpus=Path/To/Json | -Assets=/Game/BP_A.BP_A+/Game/BP_B.BP_B) [-Repeat=1] [-Timeout=600]
+ *                        [-Output=Path.json]
+ *
+ *   -Configs  Provider:Model pairs joined by +. Models are the model enum names or ids, or the model name for
+ *             Ollama, LM Studio and OpenAI-compatible servers; a provider alone uses the model it is set to
+ *   -Corpus   N2C JSON export (.ndjson, one request per line) or folder of .json and .ndjson files
+ *   -Assets   Object paths of Blueprints whose graphs make up the corpus, if no -Corpus is given
+ *   -Repeat   Times the corpus is sent per configuration (default 1)
+ *   -Timeout  Seconds to wait for one configuration's requests (default 600)
+ *   -Output   Report path (default Saved/NodeToCode/Benchmarks/Models-<time>.json)
+ */
+UCLASS()
+class UN2CModelBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UN2CModelBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** A provider and the model to use with it */
+    struct FModelConfig
+    {
+        EN2CLLMProvider Provider = EN2CLLMProvider::Anthropic;
+
+        /** As given, or empty for the model the provider is set to */
+        FString ModelName;
+    };
+
+    /** Parse a Provider:Model pair. Returns false if either is unknown */
+    static bool ParseConfig(const FString& Spec, FModelConfig& OutConfig);
+
+    /** Point Settings at a configuration's provider and model, or only check the model if null. False if it is unknown */
+    static bool ApplyConfig(const FModelConfig& ModelConfig, class UN2CSettings* Settings);
+
+    /** Read the corpus export or folder, or serialize the graphs of the Blueprints */
+    bool LoadCorpus(const FString& CorpusPath, const TArray<FString>& AssetPaths);
+
+    /** Send the corpus with the current settings and wait for it; returns the configuration's report */
+    TSharedPtr<FJsonObject> RunConfig(const FString& Name, const FString& OutputRoot);
+
+    /** Pump HTTP, tickers and game thread tasks once */
+    static void Tick(double& LastTime);
+
+    /** Request name and N2C JSON of each request of the corpus */
+    TArray<TPair<FString, FString>> Corpus;
+
+    int32 Repeat = 1;
+    double TimeoutSeconds = 600.0;
+};
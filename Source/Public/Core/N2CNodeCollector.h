@@ -7,6 +7,19 @@
 #include "BlueprintEditor.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
+#include "K2Node.h"
+
+/** A node and its translatable pins, gathered from the graph in one pass */
+struct FN2CCollectedNode
+{
+    UK2Node* Node = nullptr;
+
+    /** Visible input and output pins, in the node's pin order */
+    TArray<UEdGraphPin*, TInlineAllocator<16>> Pins;
+
+    /** The exec outputs among Pins */
+    TArray<UEdGraphPin*, TInlineAllocator<4>> ExecOutputs;
+};
 
 /**
  * @class FN2CNodeCollector
@@ -22,12 +35,12 @@ public:
     static FN2CNodeCollector& Get();
 
     /**
-     * @brief Collects nodes from a specific graph
+     * @brief Collects nodes and their translatable pins from a specific graph
      * @param Graph The graph to collect from
      * @param[out] OutNodes Array to store collected nodes
      * @return True if collection succeeded
      */
-    bool CollectNodesFromGraph(UEdGraph* Graph, TArray<UK2Node*>& OutNodes);
+    bool CollectNodesFromGraph(UEdGraph* Graph, TArray<FN2CCollectedNode>& OutNodes);
 
     /**
      * @brief Collects detailed pin information from a node
@@ -43,7 +56,7 @@ private:
     FN2CNodeCollector() = default;
 
     /** Validates a pin is properly configured */
-    bool ValidatePin(UEdGraphPin* Pin) const;
+    static bool ValidatePin(UEdGraphPin* Pin);
 
     /** Gets additional pin metadata for K2 nodes */
     void GetK2PinMetadata(UK2Node* K2Node, UEdGraphPin* Pin);
@@ -5,9 +5,12 @@
 #include "CoreMinimal.h"
 #include "Models/N2CBlueprint.h"
 #include "EdGraph/EdGraphNode.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
 #include "Utils/Validators/N2CBlueprintValidator.h"
 #include "Utils/Processors/N2CNodeProcessor.h"
 #include "Utils/Processors/N2CNodeProcessorFactory.h"
+#include "Core/N2CNodeCollector.h"
 
 /**
  * @class FN2CNodeTranslator
@@ -24,37 +27,109 @@ public:
 
     /**
      * @brief Generate N2CStruct from collected nodes
-     * @param CollectedNodes Array of nodes from the Blueprint Editor
+     * @param CollectedNodes Nodes and their pins collected from the Blueprint Editor
      * @return True if translation succeeded
      */
-    bool GenerateN2CStruct(const TArray<UK2Node*>& CollectedNodes);
+    bool GenerateN2CStruct(const TArray<FN2CCollectedNode>& CollectedNodes);
 
     /** Generate N2CBlueprint from entire Blueprint (all graphs, optional variables) */
     bool GenerateFromBlueprint(class UBlueprint* InBlueprint, bool bIncludeVariables = true);
 
+    /**
+     * @brief Start extracting an entire Blueprint a slice at a time, for Blueprints too large to extract in one frame
+     * @return False if another sliced extraction is running or there is no Blueprint
+     *
+     * The slices keep their state apart from the translator's, so other translations may run between them. A graph
+     * modified while it is extracted, or after, is extracted again. Ends with the same result as GenerateFromBlueprint
+     */
+    bool BeginSlicedExtraction(class UBlueprint* InBlueprint, bool bIncludeVariables = true);
+
+    /**
+     * @brief Extract nodes of the sliced extraction until BudgetSeconds have passed, at least one
+     * @param bOutSucceeded Once finished, whether GetN2CBlueprint holds the Blueprint, as GenerateFromBlueprint returns
+     * @return True once the extraction finished
+     */
+    bool StepSlicedExtraction(double BudgetSeconds, bool& bOutSucceeded);
+
+    /** Fraction of the sliced extraction done, by nodes */
+    float GetSlicedExtractionProgress() const;
+
+    bool IsSlicedExtractionRunning() const { return Sliced.IsValid(); }
+
+    /** Drop the sliced extraction, leaving GetN2CBlueprint as it was */
+    void CancelSlicedExtraction();
+
     /**
      * @brief Get the generated Blueprint structure
      * @return The translated Blueprint structure
      */
     const FN2CBlueprint& GetN2CBlueprint() const { return N2CBlueprint; }
 
-private:
-    /** Constructor */
-    FN2CNodeTranslator() = default;
+    /** Move the generated Blueprint out, leaving the translator empty until the next translation, for callers that keep their own */
+    FN2CBlueprint TakeN2CBlueprint();
 
-    /** The Blueprint structure being built */
-    FN2CBlueprint N2CBlueprint;
+    /** Graphs the last translation pulled in besides the collected one, such as collapsed graphs and called functions */
+    TArray<UEdGraph*> GetNestedGraphs() const { return QueuedGraphs.Array(); }
+
+    /**
+     * Leave the macro graphs of user macro libraries out of the translation, so a batch translates each once with its
+     * library instead of inlining it into every Blueprint that instantiates it. Call sites keep the macro's name
+     */
+    void SetShareMacroGraphs(bool bShare) { bShareMacroGraphs = bShare; }
 
-    /** Current graph being processed */
-    FN2CGraph* CurrentGraph;
+    /** Macro libraries whose macros the last translation instantiated but left out, while sharing macro graphs */
+    const TArray<TWeakObjectPtr<UBlueprint>>& GetSharedMacroLibraries() const { return SharedMacroLibraries; }
 
-    /** Maps node GUIDs to simplified IDs */
-    TMap<FGuid, FString> NodeIDMap;
+    /** Names of the macro graphs left out, as macro instance nodes give them in MemberName */
+    const TSet<FString>& GetSharedMacroNames() const { return SharedMacroNames; }
 
-    /** Maps pin GUIDs to simplified IDs */
-    TMap<FGuid, FString> PinIDMap;
+    /**
+     * @brief Fingerprint a graph together with the shared Blueprint context it is translated with
+     * @param ContextJson Output of FN2CSerializer::SharedContextToJson for the owning Blueprint
+     * @param GraphJson Output of FN2CSerializer::GraphToJson for the graph
+     * @return Hex SHA1 of both, stable across sessions. Does not touch translator state, so it is safe off the game thread
+     */
+    static FString ComputeGraphFingerprint(const FString& ContextJson, const FString& GraphJson);
+
+    /**
+     * @brief Hash a graph's shape, ignoring its name and the IDs and order its nodes were collected in
+     * @param Graph Graph to hash
+     * @return Hex SHA1 that copies of a graph share, even across Blueprints. Safe off the game thread
+     *
+     * Nodes are labelled by their type, members, comment and pins (types, subtypes, defaults and flags), and the
+     * labels are refined with those of each node's exec and data neighbours until they stop splitting. The graph is
+     * then written out in label order with its flows renumbered to match, and that text is hashed. Two graphs only
+     * share a hash when they write identically, so a match is never a false one; a graph with symmetric parts may
+     * occasionally miss a match it should have had.
+     */
+    static FString ComputeStructuralHash(const FN2CGraph& Graph);
+
+    /**
+     * @brief Split a graph along exec-flow boundaries into parts that each fit a token budget
+     * @param Graph Graph to split
+     * @param MaxPartTokens Budget for one part, as counted by MeasureTokens
+     * @param MeasureTokens Token count of the request a part would be sent as
+     * @param OutParts Parts sharing the graph's name and type, with pure nodes copied next to each consumer.
+     *        A single part means the graph could not be split any further
+     *
+     * Every event or other exec entry starts a region; regions over budget are split again at their first
+     * branching node (Sequence, Branch, ...) into one region per outgoing exec path. Regions are then packed
+     * in graph order. Does not touch translator state, so it is safe off the game thread
+     */
+    static void PartitionGraph(
+        const FN2CGraph& Graph,
+        int32 MaxPartTokens,
+        TFunctionRef<int32(const FN2CGraph&)> MeasureTokens,
+        TArray<FN2CGraph>& OutParts);
 
-    /** Tracking sets to prevent duplicate processing */
+private:
+    /** Constructor - binds type cache invalidation */
+    FN2CNodeTranslator();
+
+    /** The Blueprint structure being built */
+    FN2CBlueprint N2CBlueprint;
+
+    /** Tracking sets to prevent duplicate processing. Only updated while merging graph contexts, on the calling thread */
     TSet<FString> ProcessedStructPaths;
     TSet<FString> ProcessedEnumPaths;
 
@@ -70,17 +145,252 @@ private:
         {}
     };
 
+    /**
+     * State owned by the translation of a single graph. Nothing here is shared between graphs,
+     * so independent graphs can be processed concurrently and merged afterwards in a fixed order.
+     */
+    struct FGraphTranslationContext
+    {
+        /** The graph being built */
+        FN2CGraph Graph;
+
+        /** Maps node GUIDs to 1-based node numbers, rendered as "N<number>" */
+        TMap<FGuid, int32> NodeIDMap;
+
+        /** Maps pin GUIDs to 1-based pin numbers within the owning node, rendered as "P<number>" */
+        TMap<FGuid, int32> PinIDMap;
+
+        /** Index each processed node has in Graph.Nodes, by node GUID */
+        TMap<FGuid, int32> NodeIndexMap;
+
+        /** Index of each processed pin among its node's pins, inputs first, by pin GUID */
+        TMap<FGuid, int32> PinIndexMap;
+
+        /** Exec links by node GUID, in discovery order. Their targets may not be processed yet, so they are resolved after the graph's nodes */
+        TArray<TPair<FGuid, FGuid>> PendingExecLinks;
+
+        /** Index into Graph.Flows.Data of the flow from each source (node index, pin index) */
+        TMap<TPair<int32, int32>, int32> DataFlowBySource;
+
+        /** Processing depth of this graph */
+        int32 Depth = 0;
+
+        /** Blueprint structs and enums referenced by this graph, keyed by object path, in discovery order */
+        TArray<TPair<FString, FN2CStruct>> Structs;
+        TArray<TPair<FString, FN2CEnum>> Enums;
+
+        /** Paths already processed within this graph */
+        TSet<FString> ProcessedStructPaths;
+        TSet<FString> ProcessedEnumPaths;
+
+        /** Structs whose members are being reflected by enclosing calls */
+        TArray<FString> StructStack;
+
+        /** Nested graphs found while processing this graph, and the same graphs as a set for dedupe */
+        TArray<FGraphProcessInfo> DiscoveredGraphs;
+        TSet<UEdGraph*> DiscoveredGraphSet;
+
+        /** Shared macro graphs this graph instantiates, and their macro libraries */
+        TSet<FString> SharedMacroNames;
+        TSet<UBlueprint*> MacroLibraries;
+
+        /** Knot pin to the non-knot pin its reroute chain ends at */
+        TMap<UEdGraphPin*, UEdGraphPin*> KnotResolution;
+    };
+
+    /** Whole-Blueprint extraction resumed by StepSlicedExtraction */
+    struct FSlicedExtraction
+    {
+        TStrongObjectPtr<UBlueprint> Blueprint;
+        bool bIncludeVariables = true;
+
+        /** Top-level graphs, with the context each is extracted into and whether it had nodes */
+        TArray<TWeakObjectPtr<UEdGraph>> Graphs;
+        TArray<FGraphTranslationContext> Contexts;
+        TArray<bool> GraphHasNodes;
+
+        /** Indices of the graphs to extract, in order, with graphs modified after their extraction added again */
+        TArray<int32> Order;
+        int32 Cursor = 0;
+
+        /** Nodes of the graph being extracted, collected when it starts, and the next one. INDEX_NONE before it starts */
+        TArray<FN2CCollectedNode> CollectedNodes;
+        int32 NodeIndex = INDEX_NONE;
+
+        /** Set when the graph being extracted is modified, so it starts over */
+        bool bGraphModified = false;
+
+        /** Nodes of the graphs in Order, and those of the ones finished */
+        int32 TotalNodes = 0;
+        int32 FinishedNodes = 0;
+    };
+
+    TUniquePtr<FSlicedExtraction> Sliced;
+
+    /** Note modifications of the graphs the sliced extraction reads, from HandleObjectModified */
+    void HandleSlicedObjectModified(UObject* Object);
+
+    /** Reset for a whole-Blueprint translation and fill in its metadata */
+    void BeginBlueprint(UBlueprint* InBlueprint);
+
+    /** Top-level graphs of a Blueprint: event, functions, macros */
+    static void GetTopLevelGraphs(UBlueprint* InBlueprint, TArray<UEdGraph*>& OutGraphs);
+
+    /** Merge the extracted top-level graphs in order and add the class-level parts of the Blueprint */
+    bool FinishBlueprint(UBlueprint* InBlueprint, bool bIncludeVariables, TArray<FGraphTranslationContext>& GraphContexts, const TArray<bool>& GraphHasNodes);
+
     /** Queue of graphs to process with their parent depths */
     TArray<FGraphProcessInfo> AdditionalGraphsToProcess;
 
-    /** Current processing depth */
-    int32 CurrentDepth = 0;
-    
+    /** Names of graphs already added to N2CBlueprint */
+    TSet<FString> ProcessedGraphNames;
+
+    /** Every graph ever added to AdditionalGraphsToProcess */
+    TSet<UEdGraph*> QueuedGraphs;
+
+    /** Whether macro library graphs are left to be translated with their library */
+    bool bShareMacroGraphs = false;
+
+    /** Macro libraries left out of the last translation, in merge order */
+    TArray<TWeakObjectPtr<UBlueprint>> SharedMacroLibraries;
+    TSet<FString> SharedMacroNames;
+
+    /** Cached "is user content" verdict per owning package, shared by concurrently processed graphs */
+    TMap<const UPackage*, bool> UserContentPackages;
+    FRWLock UserContentLock;
+
+    /** Function graphs by name per Blueprint, indexed on first lookup and kept for one translation */
+    TMap<const UBlueprint*, TMap<FName, UEdGraph*>> FunctionGraphIndex;
+    FRWLock FunctionGraphLock;
+
+    /** Struct reflected by an earlier translation, with the nested types its members pulled in */
+    struct FCachedStruct
+    {
+        TWeakObjectPtr<UScriptStruct> Source;
+        FN2CStruct Definition;
+        TArray<TPair<FString, FN2CStruct>> NestedStructs;
+        TArray<TPair<FString, FN2CEnum>> NestedEnums;
+    };
+
+    /**
+     * Enum reflected by an earlier translation, with the signature of its entries. Kept for enums in packages
+     * with unsaved edits too: adding, removing or renaming an entry changes the signature, and other edits
+     * drop the type cache
+     */
+    struct FCachedEnum
+    {
+        TWeakObjectPtr<UEnum> Source;
+        uint32 Signature = 0;
+        FN2CEnum Definition;
+    };
+
+    /** A struct member as described from its property once, with the struct and enum types it names */
+    struct FStructMemberDescriptor
+    {
+        FN2CStructMember Member;
+        TArray<TWeakObjectPtr<UScriptStruct>, TInlineAllocator<2>> NestedStructs;
+        TArray<TWeakObjectPtr<UEnum>, TInlineAllocator<2>> NestedEnums;
+    };
+
+    /**
+     * Members of a struct, described on first use. Kept for structs in packages with unsaved edits too, since
+     * recompiling a user-defined struct recreates its properties and so changes the first one
+     */
+    struct FStructDescriptor
+    {
+        TWeakObjectPtr<UScriptStruct> Source;
+        const FField* FirstProperty = nullptr;
+        TArray<FStructMemberDescriptor> Members;
+    };
+
+    /** Long-lived struct and enum definitions keyed by object path, shared across Blueprints and graphs */
+    TMap<FString, FCachedStruct> StructCache;
+    TMap<FString, FCachedEnum> EnumCache;
+
+    /** Member descriptors by struct path, from which struct definitions are assembled without touching reflection */
+    TMap<FString, TSharedPtr<const FStructDescriptor>> StructDescriptors;
+    FRWLock TypeCacheLock;
+
+    /** Node definition built by an earlier translation, with the signature of the node it was built from */
+    struct FCachedNode
+    {
+        TWeakObjectPtr<UK2Node> Source;
+        uint32 Signature = 0;
+        FN2CNodeDefinition Definition;
+    };
+
+    /** Long-lived node definitions keyed by node GUID, dropped when the node or its Blueprint is modified */
+    TMap<FGuid, FCachedNode> NodeCache;
+    FRWLock NodeCacheLock;
+
+    /** Hash of an enum's entry names and values, which changes when entries are added, removed or renamed */
+    static uint32 ComputeEnumSignature(const UEnum* Enum);
+
+    /** Hash of what a node's definition is built from: its class, comment and collected pins with their types, defaults and links */
+    static uint32 ComputeNodeSignature(const FN2CCollectedNode& Collected);
+
+    /** Copy the cached definition of an unchanged node into OutNodeDef, keeping its ID. False if there is none */
+    bool FindCachedNode(const FN2CCollectedNode& Collected, uint32 Signature, FN2CNodeDefinition& OutNodeDef);
+
+    /** Cache a node's freshly built definition */
+    void StoreCachedNode(const FN2CCollectedNode& Collected, uint32 Signature, const FN2CNodeDefinition& NodeDef);
+
+    /** A component property worth diffing, with its N2C name and type already filled in */
+    struct FComponentProperty
+    {
+        FProperty* Property = nullptr;
+        FN2CVariable Variable;
+    };
+
+    /**
+     * Diffable properties of native component classes, shared across Blueprints. Blueprint component classes
+     * change when compiled, so theirs are rebuilt per translation. Game thread only
+     */
+    TMap<TWeakObjectPtr<const UClass>, TArray<FComponentProperty>> NativeComponentProperties;
+
+    /** Filter a component class's properties to the ones that can hold Blueprint-edited defaults */
+    void BuildComponentProperties(const UClass* ComponentClass, TArray<FComponentProperty>& OutProperties) const;
+
+    /** Drop all cached struct and enum definitions */
+    void InvalidateTypeCache();
+
+    /** Type cache invalidation hooks */
+    void HandleObjectModified(UObject* Object);
+    void HandleObjectPropertyChanged(UObject* Object, struct FPropertyChangedEvent& PropertyChangedEvent);
+    void HandleReloadComplete(EReloadCompleteReason Reason);
+
+    /** Add nested types to a graph context, skipping ones it already has */
+    static void MergeNestedTypes(
+        const TArray<TPair<FString, FN2CStruct>>& NestedStructs,
+        const TArray<TPair<FString, FN2CEnum>>& NestedEnums,
+        FGraphTranslationContext& Context);
+
+    /** Clear the graph queue, dedupe indices, package verdicts and function graph index before a new translation */
+    void ResetGraphIndices();
+
+    /** Whether an object lives in a user content directory (cached per package) */
+    bool IsUserContent(const UObject* Object);
+
+    /** Find a Blueprint's function graph by name (indexed per Blueprint) */
+    UEdGraph* FindFunctionGraph(const UBlueprint* Blueprint, FName FunctionName);
+
     /** Fallback method for processing node properties when no processor is available */
     void FallbackProcessNodeProperties(UK2Node* Node, FN2CNodeDefinition& OutNodeDef);
 
+    /** Name the context's graph and collect its local variables and nodes, which the caller then processes */
+    void BeginGraph(UEdGraph* Graph, EN2CGraphType GraphType, FGraphTranslationContext& Context, TArray<FN2CCollectedNode>& OutCollectedNodes);
+
+    /** Resolve the flows of a graph whose nodes were processed. True if it has nodes */
+    bool FinishGraph(FGraphTranslationContext& Context);
+
     /** Process a single graph */
-    bool ProcessGraph(UEdGraph* Graph, EN2CGraphType GraphType);
+    bool ProcessGraph(UEdGraph* Graph, EN2CGraphType GraphType, FGraphTranslationContext& Context);
+
+    /** Move a processed graph context into N2CBlueprint, deduplicating types and queued graphs */
+    void MergeGraphContext(FGraphTranslationContext& Context, bool bAddGraph);
+
+    /** Set each graph's FN2CGraphComplexity::MacroDepth from the macro graphs of N2CBlueprint it instantiates */
+    void RecordMacroDepths();
 
     /** Validate all flow references after processing */
     bool ValidateFlowReferences(FN2CGraph& Graph);
@@ -89,16 +399,19 @@ private:
     EN2CGraphType DetermineGraphType(UEdGraph* Graph) const;
 
     /** Add a graph to be processed */
-    void AddGraphToProcess(UEdGraph* Graph);
+    void AddGraphToProcess(UEdGraph* Graph, FGraphTranslationContext& Context);
 
-    /** Generate a simplified node ID */
-    FString GenerateNodeID();
+    /** Map a node GUID to its node number, assigning the next number on first use */
+    static int32 FindOrAddNodeNumber(const FGuid& NodeGuid, FGraphTranslationContext& Context);
 
-    /** Generate a simplified pin ID scoped to the containing node */
-    FString GeneratePinID(int32 PinCount);
+    /** Append the simplified node ID ("N<number>") to a string */
+    static void AppendNodeID(FString& Out, int32 NodeNumber);
 
-    /** Convert a UK2Node to FN2CNodeDefinition */
-    bool ProcessNode(UK2Node* Node, FN2CNodeDefinition& OutNodeDef);
+    /** Append the simplified pin ID ("P<number>") to a string */
+    static void AppendPinID(FString& Out, int32 PinNumber);
+
+    /** Convert a collected UK2Node to FN2CNodeDefinition */
+    bool ProcessNode(const FN2CCollectedNode& Collected, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
 
     /** Determine node type */
     void DetermineNodeType(UK2Node* Node, EN2CNodeType& OutType);
@@ -110,34 +423,61 @@ private:
     EN2CPinType DeterminePinType(const UEdGraphPin* Pin) const;
 
     /** Follow pin connections through knot nodes to find the first non-knot target */
-    UEdGraphPin* TraceConnectionThroughKnots(UEdGraphPin* StartPin) const;
+    UEdGraphPin* TraceConnectionThroughKnots(UEdGraphPin* StartPin, FGraphTranslationContext& Context) const;
+
+    /** Walk a knot chain from EntryPin and record the result for every knot pin on the way (nullptr for dead ends and loops) */
+    static UEdGraphPin* ResolveKnotChain(UEdGraphPin* EntryPin, TMap<UEdGraphPin*, UEdGraphPin*>& Resolution);
+
+    /** Pre-pass resolving every knot chain in a graph into Context.KnotResolution */
+    static void BuildKnotResolution(UEdGraph* Graph, FGraphTranslationContext& Context);
 
     /** Initialize basic node processing and validation */
-    bool InitializeNodeProcessing(UK2Node* Node, FN2CNodeDefinition& OutNodeDef);
+    bool InitializeNodeProcessing(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
 
     /** Process node type and core properties */
-    void ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDefinition& OutNodeDef);
+    void ProcessNodeTypeAndProperties(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
 
-    /** Process all pins on the node */
-    void ProcessNodePins(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, TArray<UEdGraphPin*>& OutExecInputs, TArray<UEdGraphPin*>& OutExecOutputs);
+    /** Queue the struct and enum types and the nested graphs the node references */
+    void ProcessNodeReferences(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
+
+    /** Map the collected pins' IDs and indices, numbered as ProcessNodePins numbers them */
+    static void MapNodePins(const FN2CCollectedNode& Collected, FGraphTranslationContext& Context);
+
+    /** Process the collected pins of the node */
+    void ProcessNodePins(const FN2CCollectedNode& Collected, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
+
+    /** Turn the exec links found while processing a graph's nodes into its execution flows */
+    static void ResolveExecutionFlows(FGraphTranslationContext& Context);
+
+    /** Reserve a graph context's node, pin and flow containers for the nodes collected from its graph */
+    static void ReserveGraphContext(const TArray<FN2CCollectedNode>& CollectedNodes, FGraphTranslationContext& Context);
 
     /** Process execution and data flows for the node */
-    void ProcessNodeFlows(UK2Node* Node, const TArray<UEdGraphPin*>& ExecInputs, const TArray<UEdGraphPin*>& ExecOutputs);
+    void ProcessNodeFlows(const FN2CCollectedNode& Collected, FGraphTranslationContext& Context);
 
     /** Check if a struct is Blueprint-defined */
-    bool IsBlueprintStruct(UScriptStruct* Struct) const;
+    bool IsBlueprintStruct(UScriptStruct* Struct);
 
     /** Check if an enum is Blueprint-defined */
-    bool IsBlueprintEnum(UEnum* Enum) const;
+    bool IsBlueprintEnum(UEnum* Enum);
 
     /** Process a Blueprint struct into FN2CStruct */
-    FN2CStruct ProcessBlueprintStruct(UScriptStruct* Struct);
+    FN2CStruct ProcessBlueprintStruct(UScriptStruct* Struct, FGraphTranslationContext& Context);
 
     /** Process a Blueprint enum into FN2CEnum */
-    FN2CEnum ProcessBlueprintEnum(UEnum* Enum);
+    FN2CEnum ProcessBlueprintEnum(UEnum* Enum, FGraphTranslationContext& Context);
+
+    /** Assemble a struct definition from its member descriptors, bypassing the type cache */
+    FN2CStruct ReflectBlueprintStruct(UScriptStruct* Struct, FGraphTranslationContext& Context);
+
+    /** Reflect the values of an enum, bypassing the type cache */
+    FN2CEnum ReflectBlueprintEnum(UEnum* Enum) const;
+
+    /** Describe a struct member from its property: cleaned name, type, container and the types it refers to */
+    FStructMemberDescriptor DescribeStructMember(FProperty* Property) const;
 
-    /** Process a struct member */
-    FN2CStructMember ProcessStructMember(FProperty* Property);
+    /** Member descriptors of a struct, built on first use and after it is recompiled */
+    TSharedRef<const FStructDescriptor> GetStructDescriptor(UScriptStruct* Struct, const FString& StructPath);
 
     /** Convert FProperty type to N2C struct member type */
     EN2CStructMemberType ConvertPropertyToStructMemberType(FProperty* Property) const;
@@ -146,7 +486,7 @@ private:
     FString CleanPropertyName(const FString& RawName) const;
 
     /** Process any struct or enum types used in a node */
-    void ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition& OutNodeDef);
+    void ProcessRelatedTypes(UK2Node* Node, FN2CNodeDefinition& OutNodeDef, FGraphTranslationContext& Context);
 
     /** Remove SKEL_ prefix and _C suffix from class names */
     FString GetCleanClassName(const FString& InName);
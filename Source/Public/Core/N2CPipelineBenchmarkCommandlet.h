@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "N2CPipelineBenchmarkCommandlet.generated.h"
+
+class UBlueprint;
+class FJsonObject;
+
+/**
+ * @class UN2CPipelineBenchmarkCommandlet
+ * @brief End-to-end timing of the translation pipeline on real Blueprints
+ *
+ * Runs each Blueprint through collect, translate, validate, serialize, request (payload build, HTTP and
+ * parse) and save, and writes the median wall time and process memory change of every stage, with the
+ * peak memory of the run, as JSON. Requests are served by the HTTP replay recordings unless -Record is
+ * given, so runs cost nothing and can be compared between plugin versions; record once with -Record first.
+ * The translation cache is bypassed for the run. Stages are tagged NodeToCode/Benchmark/<Stage> for -llm captures.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=N2CPipelineBenchmark -Assets=/Game/BP_A.BP_A+/Game/BP_B.BP_B
+ *                        [-Iterations=3] [-Record] [-Timeout=120] [-Output=Path.json]
+ *
+ *   -Assets      Object paths of the Blueprints to benchmark
+ *   -Iterations  Runs of the pipeline per Blueprint, the median is reported (default 3)
+ *   -Record      Send requests to the provider and record them for later replays
+ *   -Timeout     Seconds to wait for one request (default 120)
+ *   -Output      Report path (default Saved/NodeToCode/Benchmarks/Pipeline-<time>.json)
+ */
+UCLASS()
+class UN2CPipelineBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UN2CPipelineBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Wall time and process memory change of every run of one stage */
+    struct FStageSamples
+    {
+        TArray<double> Seconds;
+        TArray<double> MemoryDeltaBytes;
+    };
+
+    /** Benchmark one Blueprint, returning its report, or null if it could not be translated */
+    TSharedPtr<FJsonObject> RunBlueprint(UBlueprint* Blueprint);
+
+    /** Send JSON through the LLM module and wait for the translation. Returns false on failure or timeout */
+    bool RunRequest(const FString& Json) const;
+
+    /** Time Stage into Samples; returns what Stage returned */
+    static bool TimeStage(FStageSamples& Samples, TFunctionRef<bool()> Stage);
+
+    /** Stage report: median, min and max milliseconds and median memory delta */
+    static TSharedPtr<FJsonObject> SummarizeStage(const FStageSamples& Samples);
+
+    /** Pump HTTP, tickers and game thread tasks once */
+    static void Tick(double& LastTime);
+
+    int32 Iterations = 3;
+    double TimeoutSeconds = 120.0;
+};
@@ -4,10 +4,83 @@
 
 #include "CoreMinimal.h"
 #include "Models/N2CBlueprint.h"
+#include "Models/N2CCompactGraph.h"
+#include "Models/N2CGraphDelta.h"
+#include "Models/N2CTranslation.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+/**
+ * @enum EN2CJsonDialect
+ * @brief Key set used when writing N2C JSON
+ *
+ * Standard is the format saved to disk and read back by FromJson. Compact is LLM input only: short keys,
+ * empty arrays left out and node types written as indices into a per-graph "nt" table.
+ */
+enum class EN2CJsonDialect : uint8
+{
+    Standard,
+    Compact
+};
+
+/**
+ * @enum EN2CJsonSections
+ * @brief Optional Blueprint sections written after the graphs
+ */
+enum class EN2CJsonSections : uint8
+{
+    None       = 0,
+    Structs    = 1 << 0,
+    Enums      = 1 << 1,
+    Variables  = 1 << 2,
+    Components = 1 << 3,
+    All        = Structs | Enums | Variables | Components
+};
+ENUM_CLASS_FLAGS(EN2CJsonSections);
+
+/**
+ * @struct FN2CJsonOptions
+ * @brief Per-call output options for FN2CSerializer::ToJson
+ *
+ * Passed by value into each call so serializations on different threads never share formatting state.
+ */
+struct FN2CJsonOptions
+{
+    /** Indented output with line breaks, otherwise condensed */
+    bool bPrettyPrint = true;
+
+    /** Initial indent level of pretty output */
+    int32 IndentLevel = 1;
+
+    /** Key set and schema version to write */
+    EN2CJsonDialect Dialect = EN2CJsonDialect::Standard;
+
+    /** Sections written besides the version, metadata and graphs */
+    EN2CJsonSections Sections = EN2CJsonSections::All;
+};
+
+/**
+ * @struct FN2CBatchJsonContext
+ * @brief Shared Blueprint sections pre-rendered once so per-graph requests in a batch can be spliced around them
+ */
+struct FN2CBatchJsonContext
+{
+    /** Opening of the Blueprint object up to and including metadata (no closing brace) */
+    FString Head;
+
+    /** Remaining shared sections after the graphs array, including the closing brace */
+    FString Tail;
+
+    /** Dialect the sections were written in, reused for the graphs spliced between them */
+    EN2CJsonDialect Dialect = EN2CJsonDialect::Standard;
+
+    bool IsValid() const { return !Head.IsEmpty() && !Tail.IsEmpty(); }
+};
+
 /**
  * @class FN2CSerializer
  * @brief Handles serialization of N2CStruct data to JSON format
@@ -18,38 +91,138 @@
 class FN2CSerializer
 {
 public:
-    /** Convert an FN2CBlueprint to JSON string */
-    static FString ToJson(const FN2CBlueprint& Blueprint);
+    /** Convert an FN2CBlueprint to JSON string. Reads no shared state, so it is safe on any thread */
+    static FString ToJson(const FN2CBlueprint& Blueprint, const FN2CJsonOptions& Options = FN2CJsonOptions());
+
+    /** Convert an FN2CBlueprint to condensed JSON without validating, for hot paths that already validated */
+    static FString ToCondensedJson(const FN2CBlueprint& Blueprint, EN2CJsonDialect Dialect = EN2CJsonDialect::Standard);
+
+    /** Convert a single graph to condensed JSON (the same "graphs" entry ToJson would emit) */
+    static FString GraphToJson(const FN2CGraph& Graph, EN2CJsonDialect Dialect = EN2CJsonDialect::Standard);
+
+    /** Convert a compact graph to condensed JSON, written straight from its columns (same output as GraphToJson on the source graph) */
+    static FString CompactGraphToJson(const FN2CCompactGraph& Graph, const FN2CStringArena& Strings, EN2CJsonDialect Dialect = EN2CJsonDialect::Standard);
+
+    /**
+     * Convert everything except the graphs (version, metadata, structs, enums, variables, components) to condensed JSON.
+     * With ReferencedNames (see FN2CGraph::ReferencedNames), only those entries and the types they use are written
+     */
+    static FString SharedContextToJson(
+        const FN2CBlueprint& Blueprint,
+        EN2CJsonDialect Dialect = EN2CJsonDialect::Standard,
+        const TSet<FString>* ReferencedNames = nullptr);
+
+    /** Render the shared sections of a Blueprint once for a batch of single-graph requests, pruned like SharedContextToJson */
+    static bool BuildBatchContext(
+        const FN2CBlueprint& Blueprint,
+        FN2CBatchJsonContext& OutContext,
+        EN2CJsonDialect Dialect = EN2CJsonDialect::Standard,
+        const TSet<FString>* ReferencedNames = nullptr);
+
+    /** Condensed JSON for a Blueprint holding only the given graph, identical to ToJson on such a copy */
+    static FString ToJsonForGraph(const FN2CBatchJsonContext& Context, const FN2CGraph& Graph);
+
+    /** Condensed JSON for a Blueprint holding several already-serialized graphs (see GraphToJson) */
+    static FString ToJsonForGraphs(const FN2CBatchJsonContext& Context, const TArray<FString>& GraphJsons);
+
+    /**
+     * Condensed JSON asking for a graph's previous code to be patched: the delta's added and changed nodes with
+     * the current nodes they link to, its removed nodes with the nodes they linked to, and the added and removed
+     * flows among them. Always the standard dialect, versioned FN2CVersion::DeltaValue. Removed nodes are given
+     * "R" IDs so they never collide with the current graph's
+     */
+    static FString GraphDeltaToJson(
+        const FN2CMetadata& Metadata,
+        const FN2CGraph& Previous,
+        const FN2CGraph& Current,
+        const FN2CGraphDelta& Delta,
+        const FN2CGeneratedCode& PreviousCode);
+
+    /**
+     * Json with a "callee_declarations" object mapping each graph it calls to the declaration generated for it, so
+     * calls are written against the real signatures. Json must be a condensed object as written above
+     */
+    static FString WithCalleeDeclarations(const FString& Json, const TArray<TPair<FString, FString>>& Declarations);
+
+    /** Json with a "shared_macros" array naming the macros it instantiates that are translated with their macro library */
+    static FString WithSharedMacros(const FString& Json, const TArray<FString>& MacroNames);
 
     /** Convert JSON string back to FN2CBlueprint */
     static bool FromJson(const FString& JsonString, FN2CBlueprint& OutBlueprint);
 
-    /** Configure JSON output formatting */
-    static void SetPrettyPrint(bool bEnabled);
-    static void SetIndentLevel(int32 Level);
-
 private:
-    /** Internal JSON conversion helpers */
-    static TSharedPtr<FJsonObject> BlueprintToJsonObject(const FN2CBlueprint& Blueprint);
-    static TSharedPtr<FJsonObject> GraphToJsonObject(const FN2CGraph& Graph);
-    static TSharedPtr<FJsonObject> NodeToJsonObject(const FN2CNodeDefinition& Node);
-    static TSharedPtr<FJsonObject> PinToJsonObject(const FN2CPinDefinition& Pin);
-    static TSharedPtr<FJsonObject> FlowsToJsonObject(const FN2CFlows& Flows);
-    static TSharedPtr<FJsonObject> StructToJsonObject(const FN2CStruct& Struct);
-    static TSharedPtr<FJsonObject> EnumToJsonObject(const FN2CEnum& Enum);
-    static TSharedPtr<FJsonObject> VariableToJsonObject(const FN2CVariable& Var);
-
-    /** JSON parsing helpers */
-    static bool ParseBlueprintFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CBlueprint& OutBlueprint);
-    static bool ParseGraphFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CGraph& OutGraph);
-    static bool ParseNodeFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CNodeDefinition& OutNode);
-    static bool ParsePinFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CPinDefinition& OutPin);
-    static bool ParseFlowsFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CFlows& OutFlows);
-    static bool ParseStructFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CStruct& OutStruct);
-    static bool ParseEnumFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CEnum& OutEnum);
-    static bool ParseVariableFromJson(const TSharedPtr<FJsonObject>& JsonObject, FN2CVariable& OutVar);
-
-    /** Formatting configuration */
-    static bool bPrettyPrint;
-    static int32 IndentLevel;
+    using FCondensedWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+    using FPrettyWriter = TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>;
+
+    /** Field names of one dialect */
+    struct FKeys;
+
+    /** Key table for a dialect */
+    static const FKeys& GetKeys(EN2CJsonDialect Dialect);
+
+    /** ReferencedNames plus the types of the referenced variables and components, and of the members of referenced structs */
+    static TSet<FString> ExpandReferencedNames(const FN2CBlueprint& Blueprint, const TSet<FString>& ReferencedNames);
+
+    /** Start a named array, or skip it when the compact dialect leaves empty arrays out. Returns true if started */
+    template <class WriterType> static bool WriteArrayStart(WriterType& Writer, const FKeys& Keys, const TCHAR* Key, int32 Num);
+
+    /** Streaming JSON writers, emitting straight from the N2C structures into any TJsonWriter */
+    template <class WriterType> static void WriteBlueprint(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint, EN2CJsonSections Sections);
+    template <class WriterType> static void WriteHeaderFields(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint);
+    template <class WriterType> static void WriteSharedFields(WriterType& Writer, const FKeys& Keys, const FN2CBlueprint& Blueprint, EN2CJsonSections Sections, const TSet<FString>* ReferencedNames = nullptr);
+    template <class WriterType> static void WriteGraph(WriterType& Writer, const FKeys& Keys, const FN2CGraph& Graph);
+    template <class WriterType> static void WriteNode(WriterType& Writer, const FKeys& Keys, const FN2CNodeDefinition& Node, int32 NodeTypeIndex);
+    template <class WriterType> static void WritePin(WriterType& Writer, const FKeys& Keys, const FN2CPinDefinition& Pin);
+    template <class WriterType> static void WriteFlows(WriterType& Writer, const FKeys& Keys, const FN2CGraph& Graph);
+    template <class WriterType> static void WriteStruct(WriterType& Writer, const FKeys& Keys, const FN2CStruct& Struct);
+    template <class WriterType> static void WriteEnum(WriterType& Writer, const FKeys& Keys, const FN2CEnum& Enum);
+    template <class WriterType> static void WriteVariable(WriterType& Writer, const FKeys& Keys, const FN2CVariable& Var);
+
+    /** Append a quoted, escaped JSON string */
+    static void AppendJsonString(FString& Out, FStringView Value);
+
+    /** Run a write callback against a condensed writer and return the output */
+    static FString WriteCondensed(TFunctionRef<void(FCondensedWriter&)> Write, int32 ReserveLength = 1024);
+
+    /** Approximate output length, used to reserve the output buffer */
+    static int32 EstimateGraphJsonLength(const FN2CGraph& Graph);
+    static int32 EstimateJsonLength(const FN2CBlueprint& Blueprint, bool bPrettyPrint = false);
+
+    using FTokenReader = TJsonReader<TCHAR>;
+
+    /** Flows as written in JSON, before their node and pin IDs are resolved to indices */
+    struct FSerializedFlows
+    {
+        TArray<FString> Execution;
+        TArray<TPair<FString, FString>> Data;
+    };
+
+    /** Resolve flows to the nodes of a read graph, dropping any that refer to a missing node or pin */
+    static void ResolveFlows(const FSerializedFlows& Flows, FN2CGraph& OutGraph);
+
+    /** Streaming JSON readers. Each is called after its object's start token and consumes it up to the matching end */
+    static bool ReadBlueprint(FTokenReader& Reader, FN2CBlueprint& OutBlueprint);
+    static bool ReadMetadata(FTokenReader& Reader, FN2CMetadata& OutMetadata);
+    static bool ReadGraph(FTokenReader& Reader, FN2CGraph& OutGraph);
+    static bool ReadNode(FTokenReader& Reader, FN2CNodeDefinition& OutNode);
+    static bool ReadPin(FTokenReader& Reader, FN2CPinDefinition& OutPin);
+    static bool ReadFlows(FTokenReader& Reader, FSerializedFlows& OutFlows);
+    static bool ReadStruct(FTokenReader& Reader, FN2CStruct& OutStruct);
+    static bool ReadStructMember(FTokenReader& Reader, FN2CStructMember& OutMember);
+    static bool ReadEnum(FTokenReader& Reader, FN2CEnum& OutEnum);
+    static bool ReadVariable(FTokenReader& Reader, FN2CVariable& OutVar);
+    static bool ReadComponent(FTokenReader& Reader, FN2CComponentOverride& OutComponent);
+
+    /** Read the next token, treating the end of input like a parse error */
+    static bool ReadToken(FTokenReader& Reader, EJsonNotation& OutNotation);
+
+    /** Skip the value started by Notation (objects and arrays up to their end) */
+    static bool SkipValue(FTokenReader& Reader, EJsonNotation Notation);
+
+    /** Read an array of objects, calling ReadElement after each object start. Invalid elements are counted and skipped */
+    template <typename ElementReaderType>
+    static bool ReadObjectArray(FTokenReader& Reader, int32& OutInvalidCount, ElementReaderType&& ReadElement);
+
+    /** Look up an enum value by name, logging an error for unknown names */
+    static bool ParseEnumName(const TCHAR* FieldName, const UEnum* Enum, const FString& NameString, int64& OutValue);
 };
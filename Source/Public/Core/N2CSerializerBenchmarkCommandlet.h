@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "N2CSerializerBenchmarkCommandlet.generated.h"
+
+struct FN2CBlueprint;
+
+/**
+ * @class UN2CSerializerBenchmarkCommandlet
+ * @brief Throughput baseline for serialization, parsing and validation of N2C data
+ *
+ * Generates synthetic Blueprints of the requested sizes, with graphs of event, call, variable and
+ * math nodes wired through exec chains and data links, then times ToJson (pretty and condensed),
+ * FromJson, IsValid and the binary snapshot round trip. Each operation reports the median time per
+ * node, the change in process memory across the run and the output size.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=N2CSerializerBenchmark [-Nodes=100+1000+10000+50000] [-Iterations=5] [-Seed=1]
+ *
+ *   -Nodes       Node counts to benchmark, one synthetic Blueprint each (default 100+1000+10000+50000)
+ *   -Iterations  Timed runs per operation, the median is reported (default 5)
+ *   -Seed        Random seed for the generated graphs (default 1)
+ */
+UCLASS()
+class UN2CSerializerBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UN2CSerializerBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Build a Blueprint with NodeCount nodes spread over graphs of at most NodesPerGraph */
+    static void GenerateBlueprint(int32 NodeCount, int32 Seed, FN2CBlueprint& OutBlueprint);
+
+    /** Time Operation Iterations times and log the median alongside the memory delta and output size */
+    static void RunOperation(const TCHAR* Label, int32 NodeCount, int32 Iterations, TFunctionRef<int64()> Operation);
+};
@@ -9,6 +9,7 @@
 #include "LLM/N2CLLMModels.h"
 #include "LLM/N2CLLMTypes.h"
 #include "LLM/N2COllamaConfig.h"
+#include "LLM/N2CTokenEstimator.h"
 #include "Models/N2CLogging.h"
 #include "Styling/SlateColor.h"
 #include "N2CSettings.generated.h"
@@ -439,12 +440,50 @@ public:
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | LM Studio",
         meta=(DisplayName="Server Endpoint"))
     FString LMStudioEndpoint = "http://localhost:1234";
+
+    /** Further LM Studio servers to balance requests across together with the main endpoint */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | LM Studio",
+        meta=(DisplayName="Additional Endpoints",
+              ToolTip="Further LM Studio servers serving the same model. Requests go to the healthy server with the fewest outstanding requests. The main endpoint handles as many requests at once as the LM Studio request limits allow."))
+    TArray<FN2CLocalEndpoint> LMStudioAdditionalEndpoints;
     
     /** LM Studio Prepended Model Command - Text to prepend to user messages (e.g., '/no_think' to disable thinking for reasoning models, or other model-specific commands). This text will appear at the start of each user message. */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | LM Studio",
         meta=(DisplayName="Prepended Model Command", 
               ToolTip="Text to prepend to user messages (e.g., '/no_think' to disable thinking for reasoning models, or other model-specific commands). This text will appear on first line of each user message."))
     FString LMStudioPrependedModelCommand = "";
+
+    /** Model served by the OpenAI-compatible server, as it names it in /v1/models */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta=(DisplayName="Model Name"))
+    FString OpenAICompatibleModel = "Qwen/Qwen2.5-Coder-32B-Instruct";
+
+    /** Base URL of a vLLM, TGI, SGLang or other server implementing the OpenAI chat completions API */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta=(DisplayName="Server Endpoint",
+              ToolTip="Base URL of the server, with or without /v1. How many requests are sent at once is set by the OpenAI-Compatible request limits; servers with continuous batching handle dozens in parallel"))
+    FString OpenAICompatibleEndpoint = "http://localhost:8000";
+
+    /** Further servers to balance requests across together with the main endpoint */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta=(DisplayName="Additional Endpoints",
+              ToolTip="Further servers serving the same model. Requests go to the healthy server with the fewest outstanding requests"))
+    TArray<FN2CLocalEndpoint> OpenAICompatibleAdditionalEndpoints;
+
+    /** Context length the model is served with, such as vLLM's --max-model-len, or 0 if unknown */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta=(DisplayName="Context Window", ClampMin="0"))
+    int32 OpenAICompatibleContextWindow = 32768;
+
+    /** Stream responses from the server; only takes effect while Stream Responses is on as well */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta=(DisplayName="Stream Responses"))
+    bool bOpenAICompatibleStreamResponses = true;
+
+    /** API key of the server - Stored separately in user secrets */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code | LLM Services | OpenAI-Compatible",
+        meta = (DisplayName = "API Key"))
+    FString OpenAICompatible_API_Key_UI;
     
     /** OpenAI Model Pricing */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Pricing | OpenAI", DisplayName = "OpenAI Model Pricing")
@@ -462,16 +501,360 @@ public:
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Pricing | DeepSeek")
     TMap<EN2CDeepSeekModel, FN2CDeepSeekPricing> DeepSeekModelPricing;
     
+    /** Per-provider concurrency and rate limits used when several translation requests are queued (e.g. Translate Entire Blueprint) */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Provider Request Limits"))
+    TMap<EN2CLLMProvider, FN2CProviderRequestLimits> ProviderRequestLimits;
+
+    /** Spread requests across the selected provider and the Routing Providers, weighted by observed latency, cost and load, and fail over when one errors */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Routing",
+        meta = (DisplayName = "Route Across Providers"))
+    bool bRouteAcrossProviders = false;
+
+    /** Providers requests may be routed to besides the selected one. Each uses its own API key, model and endpoint settings */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Routing",
+        meta = (DisplayName = "Routing Providers", EditCondition = "bRouteAcrossProviders"))
+    TArray<EN2CLLMProvider> RoutingProviders;
+
+    /** Send the largest quarter of a batch's requests to the routing provider expected to answer soonest, so they do not finish the batch last */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Routing",
+        meta = (DisplayName = "Largest Requests To Fastest Provider", EditCondition = "bRouteAcrossProviders"))
+    bool bRouteLargestToFastestProvider = true;
+
+    /** Send a tiny request to each provider requests may go to every so often while Node to Code is in use, so routing and concurrency follow their current health */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Routing",
+        meta = (DisplayName = "Probe Provider Health"))
+    bool bProbeProviderHealth = false;
+
+    /** Seconds between health probes of each provider */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Routing",
+        meta = (DisplayName = "Health Probe Interval (Seconds)", ClampMin = "30.0", UIMin = "30.0", UIMax = "3600.0", EditCondition = "bProbeProviderHealth"))
+    float ProviderProbeIntervalSeconds = 300.0f;
+
+    /** Send a duplicate of a request that has produced no response bytes after most recent requests had completed; the first good response wins */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Hedge Slow Requests"))
+    bool bHedgeSlowRequests = false;
+
+    /** Percentile of recent request latency after which a silent request is hedged */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Hedge Latency Percentile", ClampMin = "50.0", ClampMax = "99.9", UIMin = "50.0", UIMax = "99.9", EditCondition = "bHedgeSlowRequests"))
+    float HedgeLatencyPercentile = 95.0f;
+
+    /** Seconds any request may take before it is abandoned, retries included, on top of the allowance for its size. 0 disables deadlines */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Request Deadline Base (Seconds)", ClampMin = "0.0", UIMin = "0.0"))
+    float RequestDeadlineBaseSeconds = 120.0f;
+
+    /** Seconds added to a request's deadline per thousand estimated input tokens, since larger graphs take longer to translate */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Request Deadline Per 1K Tokens (Seconds)", ClampMin = "0.0", UIMin = "0.0"))
+    float RequestDeadlineSecondsPerThousandTokens = 20.0f;
+
+    /** Size each request's response token limit to its graph instead of always asking for the maximum, and resend once with the maximum if a response is cut off */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Budget Response Tokens Per Graph",
+               ToolTip="Cloud providers reserve rate limit capacity for the full max tokens of every request, so small graphs asking for 8192 tokens cap how many can run at once. Reasoning models always get the maximum, since their limit includes thinking tokens"))
+    bool bBudgetResponseTokens = true;
+
+    /** How much reasoning models think before answering: o-series reasoning_effort, Gemini thinking budget, Ollama think */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Request Scheduling",
+        meta = (DisplayName = "Reasoning Effort",
+               ToolTip="Reasoning models spend most of their time thinking before they answer. Auto asks for little on small graphs and more on large ones. Models without a control, such as DeepSeek Reasoner, are unaffected"))
+    EN2CReasoningEffort ReasoningEffort = EN2CReasoningEffort::Auto;
+
+    /** Stream responses from the provider so partial code can be shown while a translation is generated */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services",
+        meta = (DisplayName = "Stream Responses"))
+    bool bStreamResponses = false;
+
+    /** Mark the system prompt and reference source files as a cacheable prefix so repeated requests are billed at the provider's cached-input rate */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services",
+        meta = (DisplayName = "Use Provider Prompt Caching"))
+    bool bUsePromptCaching = true;
+
+    /** Record responses by request body hash, or serve requests from those recordings without calling the provider, to benchmark offline */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Replay Mode"))
+    EN2CHttpReplayMode ReplayMode = EN2CHttpReplayMode::Off;
+
+    /** Folder recordings are written to and replayed from. Empty uses Saved/NodeToCode/Replay */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Replay Directory", EditCondition = "ReplayMode != EN2CHttpReplayMode::Off"))
+    FDirectoryPath ReplayDirectory;
+
+    /** Seconds a replayed response takes, plus up to the jitter */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Replay Latency (Seconds)", ClampMin = "0.0", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    float ReplayLatencySeconds = 0.5f;
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Replay Latency Jitter (Seconds)", ClampMin = "0.0", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    float ReplayLatencyJitterSeconds = 0.25f;
+
+    /** Share of replayed requests answered with HTTP 429 */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Injected Rate Limit Rate", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    float ReplayRateLimitRate = 0.0f;
+
+    /** Share of replayed requests that fail as if they timed out */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Injected Timeout Rate", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    float ReplayTimeoutRate = 0.0f;
+
+    /** Share of replayed responses cut off halfway */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Injected Truncation Rate", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    float ReplayTruncationRate = 0.0f;
+
+    /** Seed of the injected latency and faults, so a replay run can be reproduced */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | LLM Services | Replay",
+        meta = (DisplayName = "Replay Seed", EditCondition = "ReplayMode == EN2CHttpReplayMode::Replay"))
+    int32 ReplaySeed = 0;
+
+    /** Get the request limits for a provider, falling back to defaults if none are configured */
+    FN2CProviderRequestLimits GetProviderRequestLimits(EN2CLLMProvider InProvider) const;
+    
     /** Target programming language for translation */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation", 
         meta=(DisplayName="Target Language"))
     EN2CCodeLanguage TargetLanguage = EN2CCodeLanguage::Cpp;
 
+    /**
+     * More languages to translate the focused graph to alongside the target language. The graph is extracted
+     * and serialized once, one request per language goes out concurrently, and each language's output is
+     * saved in a subfolder of the translation named after it
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Additional Target Languages"))
+    TArray<EN2CCodeLanguage> AdditionalTargetLanguages;
+
+    /** The target language followed by the distinct additional ones */
+    TArray<EN2CCodeLanguage> GetTargetLanguages() const;
+
+    /**
+     * Translate the focused graph in the background once the Blueprint editor has been idle after an edit,
+     * with a fast or local model. The result is kept in the translation cache, and Translate Focused Graph
+     * shows it at once; translating the same graph again then sends the full-quality request
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Pre-Translate Focused Graph"))
+    bool bSpeculativeTranslation = false;
+
+    /**
+     * Send each translation to the speculative model first and show its draft while the selected model works.
+     * The selected model is given the draft to correct, so the final translation keeps its quality
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Preview Drafts"))
+    bool bDraftThenRefine = false;
+
+    /** Have the selected model refine each draft. When off, the draft is the final translation */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Refine Drafts", EditCondition="bDraftThenRefine"))
+    bool bRefineDrafts = true;
+
+    /** Provider background translations and drafts are sent to, such as a local Ollama model */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Speculative Provider", EditCondition="bSpeculativeTranslation || bDraftThenRefine"))
+    EN2CLLMProvider SpeculativeProvider = EN2CLLMProvider::Ollama;
+
+    /** Model of the speculative provider, or empty for the model that provider is set to use */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Speculative Model", EditCondition="bSpeculativeTranslation || bDraftThenRefine"))
+    FString SpeculativeModel;
+
+    /** Seconds without edits to the focused graph before it is translated in the background */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Speculative Translation",
+        meta=(DisplayName="Idle Seconds", EditCondition="bSpeculativeTranslation", ClampMin="0.5"))
+    float SpeculativeIdleSeconds = 3.0f;
+
+    /** Model background translations and drafts are sent to */
+    FString GetSpeculativeModel() const { return SpeculativeModel.IsEmpty() ? GetModel(SpeculativeProvider) : SpeculativeModel; }
+
     /** Maximum depth for nested graph translation (0 = No nested translation). This setting can greatly impact costs and context window utilization, so be mindful! */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
         meta=(DisplayName="Max Translation Depth", ClampMin="0", ClampMax="5", UIMin="0", UIMax="5"))
     int32 TranslationDepth = 0;
 
+    /** Translate Entire Blueprint extracts its top-level graphs on all cores. Off by default because custom node processors must then be thread safe */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Parallel Graph Extraction"))
+    bool bParallelGraphTranslation = false;
+
+    /**
+     * Translate Entire Blueprint extracts Blueprints with at least this many nodes a few nodes per frame, within the
+     * budget below, so the editor stays responsive while huge level Blueprints are extracted (0 = always at once)
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Time-Sliced Extraction Node Threshold", ClampMin="0", UIMin="0", UIMax="20000"))
+    int32 SlicedExtractionNodeThreshold = 2000;
+
+    /** Milliseconds of each frame spent extracting a Blueprint in slices */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Time-Sliced Extraction Budget (ms)", ClampMin="1.0", ClampMax="100.0", EditCondition="SlicedExtractionNodeThreshold > 0"))
+    float SlicedExtractionBudgetMs = 8.0f;
+
+    /** Reuse stored translations when a graph, prompt, language and model are unchanged since a previous run */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Use Translation Cache"))
+    bool bUseTranslationCache = true;
+
+    /**
+     * Also store translations in the project's Derived Data Cache and look them up there on a local miss, so a shared or
+     * cloud DDC serves everyone on the team the translations any of them paid for
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Share Translation Cache Through DDC", EditCondition="bUseTranslationCache"))
+    bool bShareTranslationCache = false;
+
+    /** Translate Entire Blueprint packs small graphs into shared requests up to this estimated input size in tokens (0 = one request per graph) */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Max Packed Request Tokens", ClampMin="0", UIMin="0", UIMax="32000"))
+    int32 MaxPackedRequestTokens = 4000;
+
+    /** Translate Entire Blueprint only sends graphs that changed since the last successful run and reuses the previous output for the rest */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Only Translate Changed Graphs"))
+    bool bOnlyTranslateChangedGraphs = true;
+
+    /** Show translations of the focused graph without saving them, until Save Translation Preview is used */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Preview Graph Translations",
+              ToolTip="Translations of a single graph to one language are kept in memory only. Save Translation Preview writes the latest one to a translation folder"))
+    bool bPreviewTranslations = false;
+
+    /**
+     * Translate Entire Blueprint sends each request only the variables, components, structs and enums its graphs
+     * reference, rather than the whole Blueprint's. Turn off to give every request the full context
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Only Send Referenced Context"))
+    bool bPruneGraphContext = true;
+
+    /**
+     * Translate Entire Blueprint sends a graph that changed only a little as its changes plus the code it was last
+     * translated to, and asks for that code to be patched. Needs Only Translate Changed Graphs
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Translate Small Changes as Edits"))
+    bool bUseDeltaTranslation = false;
+
+    /** Largest share of a graph's nodes that may be added, changed or removed for it to be sent as edits; larger changes get a full translation */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Max Edited Node Share", ClampMin="0.0", ClampMax="1.0", UIMin="0.0", UIMax="1.0", EditCondition="bUseDeltaTranslation"))
+    float MaxDeltaTranslationFraction = 0.3f;
+
+    /**
+     * Translate Entire Blueprint translates the functions and macros a graph calls before the graph itself, and
+     * sends it their generated declarations so its calls match them. Graphs that call nothing still go out at once
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Translate Called Graphs First"))
+    bool bOrderGraphsByCalls = true;
+
+    /**
+     * Translate Entire Blueprint writes function graphs of a few variable, function-call and branch nodes straight
+     * to C++ or pseudocode instead of sending them to the LLM. Graphs it cannot write exactly still go to the LLM
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Translate Trivial Graphs Locally"))
+    bool bTranslateTrivialGraphsLocally = true;
+
+    /** Most nodes, entry and result included, a function graph may have to be translated locally */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Max Locally Translated Nodes", ClampMin="2", ClampMax="32", UIMin="2", UIMax="32", EditCondition="bTranslateTrivialGraphsLocally"))
+    int32 MaxLocalTranslationNodes = 8;
+
+    /**
+     * Check the syntax of each C++ and Python translation with clang -fsyntax-only or py_compile, in the background,
+     * and send a translation that fails back to the LLM with the errors. Only parse errors count, since the code is
+     * checked outside its class and project
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Verify Generated Syntax"))
+    bool bVerifyGeneratedSyntax = false;
+
+    /** clang executable C++ is checked with, a full path or one on the PATH */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Clang Executable", EditCondition="bVerifyGeneratedSyntax"))
+    FString ClangExecutable = TEXT("clang++");
+
+    /** Python executable Python is checked with, a full path or one on the PATH */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Python Executable", EditCondition="bVerifyGeneratedSyntax"))
+    FString PythonExecutable = TEXT("python");
+
+    /**
+     * Include folders for the C++ check, e.g. the engine's Runtime/Core/Public. When set, checked code includes
+     * CoreMinimal.h, so engine types parse as they would in the project, at the cost of a slower check
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Include Directories", EditCondition="bVerifyGeneratedSyntax"))
+    TArray<FDirectoryPath> SyntaxCheckIncludeDirectories;
+
+    /** Most translations checked at the same time, each as its own compiler processes */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Max Concurrent Checks", ClampMin="1", ClampMax="16", UIMin="1", UIMax="16", EditCondition="bVerifyGeneratedSyntax"))
+    int32 MaxConcurrentSyntaxChecks = 4;
+
+    /** Times a translation that fails its check is sent again with the errors before it is kept as it is */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation | Syntax Verification",
+        meta=(DisplayName="Max Syntax Retries", ClampMin="0", ClampMax="3", UIMin="0", UIMax="3", EditCondition="bVerifyGeneratedSyntax"))
+    int32 MaxSyntaxRetries = 1;
+
+    /**
+     * Keep the translation model of each graph translated, copied or pre-translated, and rebuild it from editor
+     * change notifications while the editor is idle, so translating an unchanged graph skips walking its nodes
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Maintain Live Graph Models"))
+    bool bMaintainLiveGraphModels = false;
+
+    /**
+     * Translate Entire Blueprint also merges the translated graphs of each Blueprint into one class header and
+     * implementation, in a Consolidated folder beside the per-graph files, so the code compiles as a few files
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Write Consolidated Class Files"))
+    bool bWriteConsolidatedClassOutput = false;
+
+    /** Split the consolidated implementation into unity files of this many graphs each (0 = one implementation file) */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Graphs per Unity File", ClampMin="0", UIMin="0", UIMax="64", EditCondition="bWriteConsolidatedClassOutput"))
+    int32 ConsolidatedUnityGraphCount = 0;
+
+    /** Pack each finished batch's graph and class folders into one compressed archive, extracted from as graphs are viewed */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Archive Batch Output",
+              ToolTip="Batch folders keep their journal, manifest and Blueprint files loose; the graph files are packed into N2C_Output.n2ca when the batch ends"))
+    bool bArchiveBatchOutput = false;
+
+    /** Send Blueprints to the LLM in a shorter JSON dialect (short keys, no empty arrays, indexed node types). Saved JSON is unaffected */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Compact LLM Input JSON"))
+    bool bUseCompactJson = false;
+
+    /** Ask for responses with short keys and without the declaration of a patched graph when it is unchanged, to cut output tokens */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Compact LLM Responses"))
+    bool bUseCompactResponses = false;
+
+    /** Ask the LLM to leave out implementation notes, which are often the longest part of a response after the code */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Skip Implementation Notes"))
+    bool bSkipImplementationNotes = false;
+
+    /** Leave out pins that add nothing to a translation: unconnected exec pins, implicit self targets and collapsed advanced pins */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Prune Unused Pins"))
+    bool bPruneUnusedPins = false;
+
+    /** Also leave out unconnected inputs that still hold the default their node gave them */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta=(DisplayName="Prune Default Value Pins", EditCondition="bPruneUnusedPins"))
+    bool bPruneDefaultValuePins = false;
+
     /** Include Blueprint variables in serialization output */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
         meta=(DisplayName="Include Variables"))
@@ -480,12 +863,52 @@ public:
     /** Minimum severity level for logging */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging")
     EN2CLogSeverity MinSeverity = EN2CLogSeverity::Info;
+
+    /** Append log entries that no longer fit in memory to Saved/NodeToCode/NodeToCodeArchive.log instead of dropping them */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging",
+        meta=(DisplayName="Archive Old Log Entries"))
+    bool bArchiveEvictedLogs = false;
+
+    /** Periodically export stage latencies, throughput, cache hit rate, queue depth and memory as JSON lines, for fleet monitoring */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging | Telemetry",
+        meta=(DisplayName="Export Telemetry"))
+    bool bExportTelemetry = false;
+
+    /** Seconds covered by each exported telemetry line */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging | Telemetry",
+        meta=(DisplayName="Telemetry Interval", EditCondition="bExportTelemetry", ClampMin="5", UIMin="5", Units="s"))
+    float TelemetryIntervalSeconds = 60.0f;
+
+    /** File the telemetry lines are appended to. Empty uses Saved/NodeToCode/Telemetry/<Machine>.jsonl */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging | Telemetry",
+        meta=(DisplayName="Telemetry File", EditCondition="bExportTelemetry"))
+    FString TelemetryFilePath;
+
+    /** URL each telemetry line is also posted to as application/x-ndjson, e.g. a log collector. Empty posts nothing */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Logging | Telemetry",
+        meta=(DisplayName="Telemetry Endpoint", EditCondition="bExportTelemetry"))
+    FString TelemetryEndpoint;
     
     /** Get the API key for the selected provider */
-    FString GetActiveApiKey() const;
+    FString GetActiveApiKey() const { return GetApiKey(Provider); }
 
     /** Get the model for the selected provider */
-    FString GetActiveModel() const;
+    FString GetActiveModel() const { return GetModel(Provider); }
+
+    /** Get the API key configured for a provider */
+    FString GetApiKey(EN2CLLMProvider InProvider) const;
+
+    /** Write API key edits still waiting for the deferred save */
+    void FlushUserSecrets() const;
+
+    /** Get the model configured for a provider */
+    FString GetModel(EN2CLLMProvider InProvider) const;
+
+    /** Input cost per 1M tokens of the model configured for a provider */
+    float GetInputCost(EN2CLLMProvider InProvider) const;
+
+    /** Output cost per 1M tokens of the model configured for a provider */
+    float GetOutputCost(EN2CLLMProvider InProvider) const;
 
     /** Get the minimum severity level for logging */
     EN2CLogSeverity GetMinLogSeverity() const { return MinSeverity; }
@@ -533,86 +956,14 @@ public:
 
     /** Get the current model's input cost */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Services | Pricing")
-    float GetCurrentInputCost() const
-    {
-        switch (Provider)
-        {
-            case EN2CLLMProvider::OpenAI:
-                if (const FN2COpenAIPricing* Pricing = OpenAIModelPricing.Find(OpenAI_Model))
-                {
-                    return Pricing->InputCost;
-                }
-                return FN2CLLMModelUtils::GetOpenAIPricing(OpenAI_Model).InputCost;
-            case EN2CLLMProvider::Anthropic:
-                if (const FN2CAnthropicPricing* Pricing = AnthropicModelPricing.Find(AnthropicModel))
-                {
-                    return Pricing->InputCost;
-                }
-                return FN2CLLMModelUtils::GetAnthropicPricing(AnthropicModel).InputCost;
-            case EN2CLLMProvider::DeepSeek:
-                if (const FN2CDeepSeekPricing* Pricing = DeepSeekModelPricing.Find(DeepSeekModel))
-                {
-                    return Pricing->InputCost;
-                }
-                return FN2CLLMModelUtils::GetDeepSeekPricing(DeepSeekModel).InputCost;
-            case EN2CLLMProvider::Ollama:
-            case EN2CLLMProvider::LMStudio:
-                return 0.0f; // Local models are free
-            default:
-                return 0.0f;
-        }
-    }
+    float GetCurrentInputCost() const { return GetInputCost(Provider); }
 
     /** Get the current model's output cost */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Services | Pricing")
-    float GetCurrentOutputCost() const
-    {
-        switch (Provider)
-        {
-            case EN2CLLMProvider::OpenAI:
-                if (const FN2COpenAIPricing* Pricing = OpenAIModelPricing.Find(OpenAI_Model))
-                {
-                    return Pricing->OutputCost;
-                }
-                return FN2CLLMModelUtils::GetOpenAIPricing(OpenAI_Model).OutputCost;
-            case EN2CLLMProvider::Anthropic:
-                if (const FN2CAnthropicPricing* Pricing = AnthropicModelPricing.Find(AnthropicModel))
-                {
-                    return Pricing->OutputCost;
-                }
-                return FN2CLLMModelUtils::GetAnthropicPricing(AnthropicModel).OutputCost;
-            case EN2CLLMProvider::DeepSeek:
-                if (const FN2CDeepSeekPricing* Pricing = DeepSeekModelPricing.Find(DeepSeekModel))
-                {
-                    return Pricing->OutputCost;
-                }
-                return FN2CLLMModelUtils::GetDeepSeekPricing(DeepSeekModel).OutputCost;
-            case EN2CLLMProvider::Ollama:
-            case EN2CLLMProvider::LMStudio:
-                return 0.0f; // Local models are free
-            default:
-                return 0.0f;
-        }
-    }
+    float GetCurrentOutputCost() const { return GetOutputCost(Provider); }
 
     /** Calculate and store token estimate for reference files */
-    int32 GetReferenceFilesTokenEstimate() const
-    {
-        int32 TotalTokens = 0;
-        for (const FFilePath& Path : ReferenceSourceFilePaths)
-        {
-            if (FPaths::FileExists(Path.FilePath))
-            {
-                FString Content;
-                if (FFileHelper::LoadFileToString(Content, *Path.FilePath))
-                {
-                    // Estimate tokens by dividing character count by 4
-                    TotalTokens += FMath::CeilToInt(Content.Len() / 4.0f);
-                }
-            }
-        }
-        return TotalTokens;
-    }
+    int32 GetReferenceFilesTokenEstimate() const;
 
 
     /** Estimated token count from reference files */
@@ -626,6 +977,28 @@ public:
                FilePathFilter = "C++ Files (*.h;*.cpp)|*.h;*.cpp",
                ToolTip="Source files to include as context in LLM prompts"))
     TArray<FFilePath> ReferenceSourceFilePaths;
+
+    /** Only send the reference files that declare something the graph uses */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta = (DisplayName = "Filter Reference Files By Graph",
+               ToolTip="Include only reference source files declaring a class, struct, enum or function the graph references (member parents, member names and pin sub types). Files with nothing to index are always included. Cuts input tokens for large reference sets, but the reference block then differs between graphs and is cached less often"))
+    bool bFilterReferenceSourceFiles = true;
+
+    /** Send the parts of the reference files that best match the graph instead of whole files */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta = (DisplayName = "Retrieve Reference Chunks",
+               ToolTip="Split reference source files into chunks per type and function, kept in an index under Saved/NodeToCode that is updated in the background as files change, and send only the chunks best matching the graph's member names and types. Suits large reference sets. Whole files are sent until the index is ready"))
+    bool bRetrieveReferenceChunks = false;
+
+    /** Most reference chunks sent per graph */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta = (DisplayName = "Max Reference Chunks", EditCondition = "bRetrieveReferenceChunks", ClampMin = "1", UIMin = "1", UIMax = "50"))
+    int32 MaxReferenceChunks = 12;
+
+    /** Estimated tokens the reference chunks sent per graph may use */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
+        meta = (DisplayName = "Reference Chunk Token Budget", EditCondition = "bRetrieveReferenceChunks", ClampMin = "256", UIMin = "256", UIMax = "32000"))
+    int32 ReferenceChunkTokenBudget = 4000;
     
     /** Custom output directory for translations */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Node to Code | Code Generation",
@@ -650,9 +1023,13 @@ public:
     static void CopyToClipboard(const FString& Text);
 
 private:
+    /** The user secrets, created on first use and reloaded if the secrets file changed */
+    UN2CUserSecrets* GetUserSecrets() const;
 
     /** Keep track of the last edited property */
     FProperty* LastEditedProperty;
 
     void InitializePricing();
+
+    void InitializeRequestLimits();
 };
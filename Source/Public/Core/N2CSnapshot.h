@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/N2CBlueprint.h"
+
+/**
+ * @class FN2CSnapshot
+ * @brief Versioned binary snapshot of an FN2CBlueprint
+ *
+ * Written next to the Blueprint JSON so later sessions can reload translated Blueprints without
+ * parsing JSON. Files start with a magic number and format version; loading maps the file into
+ * memory where the platform supports it and reads the structures straight from the mapping.
+ */
+class FN2CSnapshot
+{
+public:
+    /** File extension of snapshot files, including the dot */
+    static const TCHAR* GetFileExtension() { return TEXT(".n2cs"); }
+
+    /** Serialize a Blueprint into a byte buffer */
+    static void SaveToMemory(const FN2CBlueprint& Blueprint, TArray<uint8>& OutBytes);
+
+    /** Read a Blueprint from a buffer written by SaveToMemory. Fails on unknown versions or truncated data */
+    static bool LoadFromMemory(TConstArrayView<uint8> Bytes, FN2CBlueprint& OutBlueprint);
+
+    /** Write a snapshot file */
+    static bool SaveToFile(const FN2CBlueprint& Blueprint, const FString& FilePath);
+
+    /** Read a snapshot file, memory-mapped when possible */
+    static bool LoadFromFile(const FString& FilePath, FN2CBlueprint& OutBlueprint);
+
+private:
+    /** Bidirectional serialization of every snapshot structure */
+    static void Serialize(FArchive& Ar, FN2CBlueprint& Blueprint);
+    static void Serialize(FArchive& Ar, FN2CGraph& Graph);
+    static void Serialize(FArchive& Ar, FN2CNodeDefinition& Node);
+    static void Serialize(FArchive& Ar, FN2CPinDefinition& Pin);
+    static void Serialize(FArchive& Ar, FN2CFlows& Flows);
+    static void Serialize(FArchive& Ar, FN2CDataFlow& Flow);
+    static void Serialize(FArchive& Ar, FN2CStruct& Struct);
+    static void Serialize(FArchive& Ar, FN2CStructMember& Member);
+    static void Serialize(FArchive& Ar, FN2CEnum& Enum);
+    static void Serialize(FArchive& Ar, FN2CEnumValue& Value);
+    static void Serialize(FArchive& Ar, FN2CVariable& Var);
+    static void Serialize(FArchive& Ar, FN2CComponentOverride& Component);
+
+    /** Serialize an array element by element, rejecting counts larger than the remaining input when loading */
+    template <typename ElementType>
+    static void SerializeArray(FArchive& Ar, TArray<ElementType>& Array);
+
+    /** Serialize an enum as its underlying byte */
+    template <typename EnumType>
+    static void SerializeEnum(FArchive& Ar, EnumType& Value);
+};
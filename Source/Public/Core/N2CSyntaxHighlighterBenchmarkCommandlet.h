@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "N2CSyntaxHighlighterBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+/**
+ * @class UN2CSyntaxHighlighterBenchmarkCommandlet
+ * @brief Throughput regression check for the code editor's syntax highlighting
+ *
+ * Generates source files of the requested line counts in each language, with comments, strings, numbers,
+ * keywords and brackets, and times the language's shared tokenizer, the highlighter lexing every line
+ * (tokenize and classify) and building the layout runs of every line. Each stage reports its median time
+ * and the change in process memory, written as JSON. Given a baseline report from an earlier run, the
+ * commandlet fails if any stage got slower or used more memory than the tolerance allows.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=N2CSyntaxHighlighterBenchmark [-Lines=1000+10000+50000]
+ *                        [-Iterations=5] [-Baseline=Path.json] [-Tolerance=20] [-Output=Path.json]
+ *
+ *   -Lines       Line counts to benchmark, one generated file per language each (default 1000+10000+50000)
+ *   -Iterations  Timed runs per stage, the median is reported (default 5)
+ *   -Baseline    Earlier report to compare against; regressions past the tolerance fail the run
+ *   -Tolerance   Percentage a stage may regress by before failing (default 20)
+ *   -Output      Report path (default Saved/NodeToCode/Benchmarks/SyntaxHighlighter-<time>.json)
+ */
+UCLASS()
+class UN2CSyntaxHighlighterBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UN2CSyntaxHighlighterBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    /** Median time and process memory change of one stage */
+    struct FStageResult
+    {
+        double MedianSeconds = 0.0;
+        double MemoryDeltaBytes = 0.0;
+    };
+
+    /** Build LineCount lines of typical code in Language */
+    static FString GenerateSource(EN2CCodeLanguage Language, int32 LineCount);
+
+    /** Benchmark every stage on one generated file, returning its report */
+    TSharedPtr<FJsonObject> RunLanguage(EN2CCodeLanguage Language, int32 LineCount) const;
+
+    /** Time Stage Iterations times, with Setup run untimed before each */
+    FStageResult TimeStage(TFunctionRef<void()> Setup, TFunctionRef<void()> Stage) const;
+
+    /** Log every stage of Report that regressed past the tolerance against Baseline; returns how many did */
+    int32 CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline) const;
+
+    int32 Iterations = 5;
+    double TolerancePercent = 20.0;
+};
@@ -18,6 +18,9 @@ public:
     TSharedPtr<FUICommandInfo> CollectNodesCommand;
     TSharedPtr<FUICommandInfo> CopyJsonCommand;
     TSharedPtr<FUICommandInfo> TranslateEntireBlueprintCommand;
+    TSharedPtr<FUICommandInfo> CancelTranslationCommand;
+    TSharedPtr<FUICommandInfo> SavePreviewCommand;
+    TSharedPtr<FUICommandInfo> InspectBlueprintCommand;
 
     // Command names and labels
     static const FName CommandName_Open;
@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPath.h"
+#include "Utils/N2CStats.h"
+#include "N2CTranslationJob.generated.h"
+
+class FN2CCancellationToken;
+class UBlueprint;
+struct FN2CBlueprint;
+
+/** Lifecycle of a translation job */
+UENUM(BlueprintType)
+enum class EN2CTranslationJobState : uint8
+{
+    Pending,
+    Running,
+
+    /** Every graph of every Blueprint was translated */
+    Succeeded,
+
+    /** Finished, but some Blueprints or graphs could not be translated */
+    Failed,
+
+    Cancelled
+};
+
+/**
+ * @struct FN2CTranslationJobOptions
+ * @brief How a translation job extracts and schedules its Blueprints
+ */
+USTRUCT(BlueprintType)
+struct FN2CTranslationJobOptions
+{
+    GENERATED_BODY()
+
+    /** Include the Blueprints' variables and components in what is translated */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code | Automation")
+    bool bIncludeVariables = true;
+
+    /** Blueprints loading or waiting on their responses at once; their graph requests share the provider limits with every other job */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code | Automation", meta = (ClampMin = "1", ClampMax = "32"))
+    int32 MaxConcurrentBlueprints = 4;
+};
+
+class UN2CTranslationJob;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnN2CJobGraphTranslated, UN2CTranslationJob*, Job, const FString&, BlueprintPath, const FString&, GraphName, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnN2CJobProgress, UN2CTranslationJob*, Job, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnN2CJobFinished, UN2CTranslationJob*, Job, EN2CTranslationJobState, State);
+
+/**
+ * @class UN2CTranslationJob
+ * @brief Handle to an asynchronous translation of a list of Blueprint assets, for editor scripts and pipelines
+ *
+ * StartTranslationJob returns at once and the job runs on the editor's ticks: packages load asynchronously,
+ * Blueprints are extracted on the game thread, serialized per graph on a worker and sent as one request per
+ * graph through the LLM module, so its scheduler applies the provider limits across every job running at
+ * the same time. Each Blueprint is saved in a translation folder of its own, as an editor translation would
+ * be. Jobs are kept alive until they finish and are cancelled on their own; CancelTranslations cancels them
+ * too. Game thread only.
+ *
+ * Python:
+ *   job = unreal.N2CTranslationJob.start_translation_job(["/Game/BP_Door"], unreal.N2CTranslationJobOptions())
+ *   job.on_graph_translated.add_callable(lambda job, path, graph, ok: print(path, graph, ok))
+ */
+UCLASS(BlueprintType)
+class NODETOCODE_API UN2CTranslationJob : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /** Start translating the Blueprints at AssetPaths (object or package paths). Null if none was given */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Automation")
+    static UN2CTranslationJob* StartTranslationJob(const TArray<FString>& AssetPaths, const FN2CTranslationJobOptions& Options);
+
+    /** Cancel the requests of the job, queued or in flight, and stop loading its remaining Blueprints */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | Automation")
+    void Cancel();
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    EN2CTranslationJobState GetState() const { return State; }
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    bool IsDone() const { return State == EN2CTranslationJobState::Succeeded || State == EN2CTranslationJobState::Failed || State == EN2CTranslationJobState::Cancelled; }
+
+    /** Fraction of the Blueprints finished, counting those in flight by their finished graphs */
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    float GetProgress() const;
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    int32 GetTotalBlueprints() const { return Assets.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    int32 GetFailedBlueprints() const { return FailedBlueprints; }
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    int32 GetTranslatedGraphs() const { return TranslatedGraphs; }
+
+    UFUNCTION(BlueprintPure, Category = "Node to Code | Automation")
+    int32 GetFailedGraphs() const { return FailedGraphs; }
+
+    /** Each graph as its response is saved, or fails */
+    UPROPERTY(BlueprintAssignable, Category = "Node to Code | Automation")
+    FOnN2CJobGraphTranslated OnGraphTranslated;
+
+    /** Whenever GetProgress changes */
+    UPROPERTY(BlueprintAssignable, Category = "Node to Code | Automation")
+    FOnN2CJobProgress OnProgress;
+
+    /** Once, when the last Blueprint finished or the job was cancelled */
+    UPROPERTY(BlueprintAssignable, Category = "Node to Code | Automation")
+    FOnN2CJobFinished OnFinished;
+
+private:
+    /** A Blueprint whose graph requests are in flight */
+    struct FActiveBlueprint
+    {
+        int32 Graphs = 0;
+        int32 Finished = 0;
+    };
+
+    /** Load Blueprints while fewer than MaxConcurrentBlueprints are in flight */
+    void StartLoads();
+
+    /** Extract a loaded Blueprint and serialize its graphs on a worker */
+    void ExtractBlueprint(int32 AssetIndex, UBlueprint* Blueprint);
+
+    /** Send the graph requests of an extracted Blueprint */
+    void SendGraphs(int32 AssetIndex, const TSharedRef<const FN2CBlueprint>& Extracted, const TArray<TPair<FString, FString>>& GraphJsons);
+
+    /** A graph response arrived */
+    void OnGraphComplete(int32 AssetIndex, const FString& GraphName, bool bSuccess);
+
+    /** A Blueprint left the pipeline, translated or not */
+    void FinishBlueprint(int32 AssetIndex, bool bFailed);
+
+    /** Finish the job once nothing is in flight */
+    void FinishIfDone();
+
+    TArray<FSoftObjectPath> Assets;
+    FN2CTranslationJobOptions Options;
+    EN2CTranslationJobState State = EN2CTranslationJobState::Pending;
+
+    /** Cancels the job's requests only */
+    TSharedPtr<FN2CCancellationToken> Token;
+
+    /** Keyed by asset index */
+    TMap<int32, FActiveBlueprint> ActiveBlueprints;
+
+    int32 NextAsset = 0;
+
+    /** Blueprints loading, extracting or serializing */
+    int32 BlueprintsPreparing = 0;
+
+    int32 FinishedBlueprints = 0;
+    int32 FailedBlueprints = 0;
+    int32 TranslatedGraphs = 0;
+    int32 FailedGraphs = 0;
+
+    /** Memory used over the job, sampled as each graph completes */
+    FN2CPeakMemory PeakMemory;
+};
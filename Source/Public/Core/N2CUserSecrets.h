@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "IDirectoryWatcher.h"
 #include "N2CUserSecrets.generated.h"
 
 /**
@@ -10,7 +12,8 @@
  * @brief Stores sensitive configuration data like API keys
  * 
  * Uses a custom JSON storage system instead of Unreal's config system
- * to ensure consistent behavior across engine versions.
+ * to ensure consistent behavior across engine versions. The file is read once and kept in memory;
+ * it is only read again after it changes on disk, and edits are written back after a short delay.
  */
 
 UCLASS()
@@ -25,6 +28,20 @@ public:
     
     /** Save API keys to storage */
     void SaveSecrets();
+
+    /** Read the file again if it changed on disk since it was last read; otherwise doesn't touch disk */
+    void EnsureLoaded();
+
+    /** Save shortly, so several key edits in a row are written once */
+    void SaveSecretsDeferred();
+
+    /** Write a deferred save now if one is pending */
+    void FlushPendingSave();
+
+    /** Seconds a deferred save waits for further edits */
+    static constexpr float SaveDelaySeconds = 1.0f;
+
+    virtual void BeginDestroy() override;
     
     /** Get the path to the secrets file */
     static FString GetSecretsFilePath();
@@ -44,8 +61,34 @@ public:
     /** DeepSeek API Key */
     UPROPERTY(EditAnywhere, Category = "Node to Code | API Keys")
     FString DeepSeek_API_Key;
+
+    /** API key of the self-hosted OpenAI-compatible server, if it was started with one */
+    UPROPERTY(EditAnywhere, Category = "Node to Code | API Keys")
+    FString OpenAICompatible_API_Key;
     
 private:
     /** Ensure the secrets directory exists */
     static void EnsureSecretsDirectoryExists();
+
+    /** Watch the secrets directory so external edits to the file are picked up (game thread) */
+    void WatchSecretsDirectory();
+
+    /** Flag the file for reloading if it was changed by something other than SaveSecrets */
+    void OnSecretsDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+    /** Whether the file has been read (or found missing) */
+    bool bLoaded = false;
+
+    /** Whether the file changed on disk since it was read */
+    bool bFileChanged = false;
+
+    /** Timestamp of the file as last read or written here */
+    FDateTime KnownFileTimestamp;
+
+    /** Watched secrets directory and its watcher handle */
+    FString WatchedDirectory;
+    FDelegateHandle WatcherHandle;
+
+    /** Pending deferred save */
+    FTSTicker::FDelegateHandle SaveTickerHandle;
 };
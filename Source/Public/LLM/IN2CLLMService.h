@@ -8,6 +8,8 @@
 #include "LLM/N2CResponseParserBase.h"
 #include "IN2CLLMService.generated.h"
 
+struct FN2CHttpRequestHandle;
+
 /**
  * @class UN2CLLMService
  * @brief Interface for LLM service providers
@@ -37,6 +39,20 @@ public:
         const FOnLLMResponseReceived& OnComplete
     ) = 0;
 
+    /**
+     * Send a request and report the model's accumulated output while it streams.
+     * OnPartialContent receives the full content decoded so far, OnComplete the raw response body.
+     * When streaming is disabled in the config this behaves like SendRequest.
+     * Handle, if given, is given the deadline to send under and allows cancelling the request.
+     */
+    virtual void SendStreamingRequest(
+        const FString& JsonPayload,
+        const FString& SystemMessage,
+        const FOnLLMStreamChunkReceived& OnPartialContent,
+        const FOnLLMResponseReceived& OnComplete,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle = nullptr
+    ) = 0;
+
     /** Get service-specific configuration */
     virtual void GetConfiguration(
         FString& OutEndpoint,
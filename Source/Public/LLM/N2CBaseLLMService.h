@@ -11,6 +11,7 @@
 class UN2CHttpHandlerBase;
 class UN2CResponseParserBase;
 class UN2CSystemPromptManager;
+struct FN2CProviderProbe;
 
 /**
  * @class UN2CBaseLLMService
@@ -26,6 +27,10 @@ public:
     virtual bool Initialize(const FN2CLLMConfig& InConfig) override;
     virtual void SendRequest(const FString& JsonPayload, const FString& SystemMessage, 
                            const FOnLLMResponseReceived& OnComplete) override;
+    virtual void SendStreamingRequest(const FString& JsonPayload, const FString& SystemMessage,
+                           const FOnLLMStreamChunkReceived& OnPartialContent,
+                           const FOnLLMResponseReceived& OnComplete,
+                           const TSharedPtr<FN2CHttpRequestHandle>& Handle = nullptr) override;
     virtual bool IsInitialized() const override { return bIsInitialized; }
     virtual UN2CResponseParserBase* GetResponseParser() const override { return ResponseParser; }
     
@@ -35,12 +40,50 @@ public:
     virtual EN2CLLMProvider GetProviderType() const override { return EN2CLLMProvider::Anthropic; }
     virtual void GetProviderHeaders(TMap<FString, FString>& OutHeaders) const override { }
 
+    /** Open a connection to the provider's endpoint ahead of the first request. Local providers may load their model instead */
+    virtual void WarmUpConnection() const;
+
+    /**
+     * Send a one-line request with a response limit of a few tokens and no reference files, outside the scheduler,
+     * and report its time to first byte and throughput. Rate limit headers on the response feed adaptive concurrency
+     */
+    void SendProbe(TFunction<void(const FN2CProviderProbe&)>&& OnComplete);
+
+    /** Request body for a message as a provider batch API expects it: the usual payload, never streamed */
+    FString BuildBatchRequestBody(const FString& UserMessage, const FString& SystemMessage) const;
+
 protected:
     // Common functionality for derived classes
     virtual void InitializeComponents();
+
+    /**
+     * Send a formatted request and, if it has produced no response bytes once HedgeDelay seconds have passed,
+     * a duplicate of it. The first good response is passed on and the other request is cancelled.
+     * Cancelling Handle cancels both
+     */
+    void SendHedgedRequest(
+        const FString& Endpoint,
+        const FString& AuthToken,
+        TArray<uint8>&& Payload,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        double HedgeDelay,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle);
     
+    /** Response token limit for a graph's JSON: sized to the graph when budgeting is enabled, otherwise the ceiling */
+    int32 GetMaxOutputTokens(const FString& UserMessage) const;
+
+    /** Largest response token limit the provider's models accept */
+    virtual int32 GetOutputTokenCeiling() const;
+
+    /** Whether the configured model spends its response token limit on reasoning as well as on the answer */
+    virtual bool UsesReasoningTokens() const { return false; }
+
+    /** Reasoning effort from settings for a graph's JSON, with Auto resolved by the graph's size */
+    EN2CReasoningEffort GetReasoningEffort(const FString& UserMessage) const;
+
     // Virtual methods for provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const { return TEXT("{}"); }
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const { return { '{', '}' }; }
     virtual UN2CResponseParserBase* CreateResponseParser() { return nullptr; }
     virtual FString GetDefaultEndpoint() const { return TEXT(""); }
 
@@ -57,4 +100,10 @@ protected:
     UN2CSystemPromptManager* PromptManager;
     
     bool bIsInitialized;
+
+    /** Response token limit forced on payloads formatted while it is set, or 0 to budget normally */
+    mutable int32 OutputTokensOverride = 0;
+
+    /** Reused by every FormatRequestPayload, so its buffers and serialized response format carry over */
+    mutable FN2CLLMPayloadBuilder PayloadBuilder;
 };
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "Models/N2CTranslation.h"
+
+/**
+ * @class FN2CClassOutput
+ * @brief Merges the graphs a batch translated into one class header and implementation
+ *
+ * The per-graph files stay the source of truth; the merged files are written beside them in a Consolidated
+ * folder when the batch ends. Enums and structs come first, then the ClassItSelf skeleton with the other
+ * graphs' declarations added inside its class body, then every graph's implementation, each under a banner
+ * naming its graph, in a fixed order so unchanged graphs give unchanged files. C++ implementations can be
+ * split into unity files of a few graphs each. A layout file lists where each merged graph's files are, so
+ * graphs carried forward unchanged from an earlier batch are merged again from their folders.
+ */
+class FN2CClassOutput
+{
+public:
+    FN2CClassOutput() = default;
+
+    /** Extension is that of the language's implementation files, such as .cpp */
+    FN2CClassOutput(EN2CCodeLanguage InLanguage, const FString& InExtension);
+
+    /** Folder under the translation root the merged files are written to */
+    static const TCHAR* GetFolderName();
+
+    /** Record a graph whose files were saved under the root in Directory/FileBaseName; a later translation of the same graph replaces it */
+    void AddGraph(const FN2CGraphTranslation& Graph, const FString& Directory, const FString& FileBaseName);
+
+    /** Queue the merged files for RootPath, once every per-graph file is on disk. FallbackClassName names them when no graph has a class */
+    void Write(const FString& RootPath, const FString& FallbackClassName, int32 UnityGraphCount) const;
+
+private:
+    struct FEntry
+    {
+        FN2CGraphTranslation Graph;
+
+        /** Folder of the graph's files, relative to the translation root */
+        FString Directory;
+
+        FString FileBaseName;
+    };
+
+    /** Entries listed by an earlier batch's layout file that this batch did not translate, loaded from their folders */
+    void LoadCarriedForward(const FString& RootPath, TArray<FEntry>& InOutEntries) const;
+
+    /** The merged header: types, then the class skeleton holding the other declarations */
+    static FString BuildHeader(const TArray<const FEntry*>& Entries);
+
+    /** Banner naming a graph above its code, as a comment of the language */
+    FString MakeBanner(const FN2CGraphTranslation& Graph) const;
+
+    EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+    FString Extension = TEXT(".cpp");
+
+    TArray<FEntry> Entries;
+};
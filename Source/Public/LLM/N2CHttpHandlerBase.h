@@ -8,6 +8,71 @@
 #include "Interfaces/IHttpRequest.h"
 #include "N2CHttpHandlerBase.generated.h"
 
+struct FN2CRateLimitState;
+enum class EN2CReplayFault : uint8;
+
+/**
+ * @struct FN2CHttpRequestHandle
+ * @brief Follows one LLM request across its HTTP retries so it can be watched and cancelled
+ */
+struct NODETOCODE_API FN2CHttpRequestHandle
+{
+    /** HTTP request currently carrying the LLM request */
+    FHttpRequestPtr Request;
+
+    /** Set once any response bytes have arrived */
+    bool bReceivedBytes = false;
+
+    /** Set by Cancel; a cancelled request never reports completion */
+    bool bCancelled = false;
+
+    /** Time (FPlatformTime::Seconds) after which the request and its retries give up, or 0 for none */
+    double Deadline = 0.0;
+
+    /** Seconds the service spent building the request body */
+    double PayloadSeconds = 0.0;
+
+    /** When the latest attempt was sent, finished uploading and received its first byte (FPlatformTime::Seconds), 0 until then */
+    double SentTime = 0.0;
+    double UploadedTime = 0.0;
+    double FirstByteTime = 0.0;
+
+    /** Handles cancelled together with this one, such as the requests of a hedged pair */
+    TArray<TSharedRef<FN2CHttpRequestHandle>> Linked;
+
+    /** Run by Cancel in place of the completion the request will no longer report */
+    FSimpleDelegate OnCancelled;
+
+    /** Cancel the in-flight HTTP request and any pending retry */
+    void Cancel();
+};
+
+/**
+ * @class FN2CCancellationToken
+ * @brief Cancels every request started under it, queued or in flight
+ *
+ * One token covers a generation of translation requests; cancelling it aborts their HTTP requests
+ * and lets queued ones drain from the scheduler without being sent. Game thread only.
+ */
+class NODETOCODE_API FN2CCancellationToken
+{
+public:
+    /** Whether Cancel has been called */
+    bool IsCancelled() const { return bCancelled; }
+
+    /** Cancel every tracked request. Requests tracked afterwards are cancelled as they are tracked */
+    void Cancel();
+
+    /** Cancel Handle along with this token */
+    void Track(const TSharedRef<FN2CHttpRequestHandle>& Handle);
+
+private:
+    bool bCancelled = false;
+
+    /** Requests started under the token; finished ones expire on their own */
+    TArray<TWeakPtr<FN2CHttpRequestHandle>> Handles;
+};
+
 /**
  * @class UN2CHttpHandlerBase
  * @brief Base class for handling HTTP communication with LLM providers
@@ -18,8 +83,8 @@ class NODETOCODE_API UN2CHttpHandlerBase : public UObject
     GENERATED_BODY()
 
 public:
-    /** Delegate for translation responses */
-    FOnTranslationResponseReceived OnTranslationResponseReceived;
+    /** Delegate for translation responses, which the handler only broadcasts for failed requests */
+    FOnTranslationResultReady OnTranslationResultReady;
 
     /** Configuration for request timeouts */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration")
@@ -40,11 +105,40 @@ public:
         const FOnLLMResponseReceived& OnComplete
     );
 
+    /** Request method that also reports complete lines of the response body as they arrive */
+    virtual void PostLLMStreamingRequest(
+        const FString& Endpoint,
+        const FString& AuthToken,
+        const FString& Payload,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete
+    );
+
+    /**
+     * Streaming request taking an already UTF-8 encoded body, which is moved into the request without copying.
+     * Handle, if given, tracks the request across retries and allows cancelling it
+     */
+    virtual void PostLLMStreamingRequest(
+        const FString& Endpoint,
+        const FString& AuthToken,
+        TArray<uint8>&& Payload,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle = nullptr
+    );
+
+    /**
+     * Open a connection to an endpoint's host ahead of the first request with a HEAD whose response is ignored,
+     * so DNS, TCP and TLS setup happen while the request is still being prepared. The HTTP module keeps the
+     * connection alive for the requests that follow. Hosts warmed up within the last minute are skipped
+     */
+    void WarmUpConnection(const FString& Endpoint) const;
+
 protected:
     /** Validate request parameters */
     virtual bool ValidateRequest(
         const FString& Endpoint,
-        const FString& Payload
+        const TArray<uint8>& Payload
     ) const;
 
     /** Handle request completion */
@@ -55,6 +149,64 @@ protected:
         FOnLLMResponseReceived OnComplete
     );
 
+    /** Bind completion and progress handlers to a prepared request and send it. Attempt counts earlier retries */
+    void SendRequest(
+        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        int32 Attempt,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle
+    );
+
+    /**
+     * Resend a request that hit a rate limit, overload or connection failure through the request scheduler,
+     * using the provider's retry limits. ResponseCode is ignored when the connection failed, and RetryDelayHint
+     * is the provider's requested wait in seconds or negative for none.
+     * Returns false if the failure is final and should be reported
+     */
+    bool TryScheduleRetry(
+        FHttpRequestPtr Request,
+        bool bConnectionFailed,
+        int32 ResponseCode,
+        double RetryDelayHint,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        int32 Attempt,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle
+    );
+
+    /** Answer a prepared request from the replay recordings after the simulated latency, instead of sending it */
+    void ReplayRequest(
+        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        int32 Attempt,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle
+    );
+
+    /** Report a replayed request's response or injected fault, going through the usual retries */
+    void CompleteReplayedRequest(
+        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request,
+        EN2CReplayFault Fault,
+        const FOnLLMStreamChunkReceived& OnChunk,
+        const FOnLLMResponseReceived& OnComplete,
+        int32 Attempt,
+        const TSharedPtr<FN2CHttpRequestHandle>& Handle
+    );
+
+    /** Remaining requests and tokens reported by the provider's rate limit headers */
+    static FN2CRateLimitState GetRateLimitsFromHeaders(const FHttpResponsePtr& Response);
+
+    /** Wait requested by Retry-After or rate limit reset headers in seconds, or a negative value if none */
+    static double GetRetryDelayFromHeaders(const FHttpResponsePtr& Response);
+
+    /** Forward newly received, newline-terminated response bytes to the chunk delegate */
+    static void ForwardReceivedLines(
+        FHttpRequestPtr Request,
+        const TSharedRef<int32>& ConsumedBytes,
+        const FOnLLMStreamChunkReceived& OnChunk
+    );
+
     /** Current configuration */
     FN2CLLMConfig Config;
 };
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+/** Fault a replayed request is answered with */
+enum class EN2CReplayFault : uint8
+{
+    None,
+    RateLimited,
+    TimedOut,
+    Truncated
+};
+
+/**
+ * @class FN2CHttpReplay
+ * @brief Records provider responses by request body and replays them without a network round trip
+ *
+ * In Record mode every successful response is saved next to its request, named by the SHA-1 of the
+ * request body as sent. In Replay mode requests are answered from those recordings after a simulated
+ * latency, with rate limits, timeouts and truncated bodies injected at the configured rates. Latency
+ * and faults come from a stream seeded in the settings, so the same run replays the same way.
+ * Game thread only.
+ */
+class FN2CHttpReplay
+{
+public:
+    static FN2CHttpReplay& Get();
+
+    bool IsRecording() const;
+    bool IsReplaying() const;
+
+    /** Save the response to a request body */
+    void Record(const TArray<uint8>& RequestBody, const FString& Response);
+
+    /** Recorded response to a request body. Returns false if the request was never recorded */
+    bool Find(const TArray<uint8>& RequestBody, FString& OutResponse);
+
+    /** Seconds the next replayed response takes */
+    float NextLatency();
+
+    /** Fault the next replayed request is answered with */
+    EN2CReplayFault NextFault();
+
+    /** Forget loaded recordings and restart the random stream from the seed */
+    void Reset();
+
+    /** Folder recordings are written to and replayed from */
+    static FString GetReplayDirectory();
+
+private:
+    FN2CHttpReplay() = default;
+
+    static FString HashRequestBody(const TArray<uint8>& RequestBody);
+
+    /** Restart the stream when the seed setting changes */
+    void SyncSeed();
+
+    /** Recordings already loaded or written this session */
+    TMap<FString, FString> Responses;
+
+    FRandomStream Random;
+    int32 Seed = 0;
+    bool bSeeded = false;
+};
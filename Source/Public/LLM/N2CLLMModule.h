@@ -3,13 +3,82 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
 #include "Code Editor/Models/N2CCodeLanguage.h"
+#include "LLM/N2CClassOutput.h"
 #include "LLM/N2CLLMTypes.h"
 #include "LLM/N2CHttpHandlerBase.h"
+#include "LLM/N2CLLMRequestScheduler.h"
+#include "LLM/N2CProviderBatchJob.h"
+#include "LLM/N2CRequestMetrics.h"
 #include "LLM/N2CResponseParserBase.h"
 #include "Models/N2CBlueprint.h"
+#include "Tasks/Task.h"
 #include "N2CLLMModule.generated.h"
 
+class FJsonObject;
+
+/** Delegate for one language's translation of a request sent in several languages */
+DECLARE_DELEGATE_ThreeParams(FOnLLMLanguageTranslationComplete, EN2CCodeLanguage /* Language */, const FN2CTranslationResponse& /* Response */, bool /* bSuccess */);
+
+/**
+ * State of one translation, created when it is sent and carried with its requests until the responses are saved,
+ * so translations running side by side never read each other's Blueprint or batch folder
+ */
+struct FN2CTranslationSession
+{
+    /** Blueprint the translation was made from, saved beside it. Not needed within a batch, which saved it once */
+    TSharedPtr<const FN2CBlueprint> Blueprint;
+
+    /** Root folder of the batch the translation belongs to, or empty to save a translation folder of its own */
+    FString BatchRootPath;
+
+    /** Scheduler class the translation's requests are queued in */
+    EN2CRequestPriority Priority = EN2CRequestPriority::Interactive;
+
+    /** Keep a translation outside a batch in memory and only save it on PersistPreviewTranslation */
+    bool bPreview = false;
+};
+
+/** Outcome of a translation requested through a future, shared by its continuations */
+struct FN2CTranslationResult
+{
+    TSharedPtr<const FN2CTranslationResponse> Response;
+    bool bSuccess = false;
+};
+
+/** Language a request is translated to, and where its output goes when it is one of several */
+struct FN2CTranslationTarget
+{
+    EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+
+    /** Translation the request belongs to; requests sent without one get a session when they are sent */
+    TSharedPtr<const FN2CTranslationSession> Session;
+
+    /** Folder the language's files are saved in, or empty to save a translation folder of its own */
+    FString OutputPath;
+
+    /** Whether the translation is broadcast to the translation delegates once saved */
+    bool bBroadcast = true;
+
+    /** Expected seconds the request takes, which orders it in the scheduler's queue (0 = unknown) */
+    double EstimatedSeconds = 0.0;
+
+    /** Route the request to the provider expected to answer soonest rather than by weight, for the largest requests */
+    bool bPreferFastestProvider = false;
+
+    /** Cancels the request besides CancelTranslations, for callers that cancel their own requests (e.g. automation jobs) */
+    TSharedPtr<FN2CCancellationToken> Token;
+
+    /** Declarations by graph name that a compact response may leave out because the request already holds them */
+    TSharedPtr<const TMap<FString, FString>> KnownDeclarations;
+
+    /** Times the request was sent again because its translation failed the syntax check */
+    int32 VerificationAttempts = 0;
+};
+
 /**
  * @class UN2CLLMModule
  * @brief Main module for managing LLM integration and translation requests
@@ -27,15 +96,167 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module", meta = (DisplayName = "Get N2C LLM Module"))
     static UN2CLLMModule* GetBP() { return Get(); }
 
-    /** Initialize module */
-    bool Initialize();
+    /** Initialize module. Without bWarmUpConnections nothing is sent, as when only planning a translation */
+    bool Initialize(bool bWarmUpConnections = true);
 
-    /** Process N2C JSON through LLM */
+    /**
+     * Process N2C JSON through LLM. OnComplete receives the response parsed once by the module.
+     * EstimatedJsonTokens is the caller's FN2CTokenEstimator count for JsonInput, or INDEX_NONE to estimate here.
+     * Requests estimated to overflow the model's context window fail before upload. EstimatedSeconds places the
+     * request in the scheduler's queue, longest first (see FN2CLatencyModel). bPreferFastestProvider routes it to
+     * the routing provider expected to answer soonest
+     */
     void ProcessN2CJson(
         const FString& JsonInput,
-        const FOnLLMResponseReceived& OnComplete
+        const FOnLLMTranslationComplete& OnComplete,
+        int32 EstimatedJsonTokens = INDEX_NONE,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr,
+        double EstimatedSeconds = 0.0,
+        bool bPreferFastestProvider = false
+    );
+
+    /**
+     * Translate the same N2C JSON to several languages at once. One request per language goes through the
+     * scheduler with that language's prompt, and each translation is saved in a subfolder, named after its
+     * language, of one translation folder holding the Blueprint files. Only the first language's translation
+     * is broadcast to the translation delegates. OnLanguageComplete runs once per language
+     */
+    void ProcessN2CJsonForLanguages(
+        const FString& JsonInput,
+        const TArray<EN2CCodeLanguage>& Languages,
+        const FOnLLMLanguageTranslationComplete& OnLanguageComplete,
+        int32 EstimatedJsonTokens = INDEX_NONE,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr
+    );
+
+    /**
+     * Translate N2C JSON before it is asked for, with the speculative provider and model, keeping the response
+     * in the translation cache only. Nothing is saved or broadcast, and JSON already cached or in flight is skipped
+     */
+    void PreTranslateN2CJson(const FString& JsonInput);
+
+    /**
+     * Save, broadcast and pass to OnComplete the cached speculative translation of N2C JSON, in the target
+     * language. Returns false without calling anything if none is cached
+     */
+    bool DeliverSpeculativeTranslation(
+        const FString& JsonInput,
+        const FOnLLMTranslationComplete& OnComplete,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr);
+
+    /**
+     * Translate one graph that was split into several requests (see FN2CNodeTranslator::PartitionGraph).
+     * The parts are sent in parallel and their translations stitched into one response, which is saved,
+     * broadcast and passed to OnComplete once every part has come back. Fails if any part fails.
+     * Each part is queued with EstimatedSeconds and routed with bPreferFastestProvider, the graph's stitched
+     * response waiting on the slowest of them
+     */
+    void ProcessN2CJsonParts(
+        const TArray<FString>& PartJsons,
+        const TArray<int32>& PartEstimatedTokens,
+        const FOnLLMTranslationComplete& OnComplete,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr,
+        double EstimatedSeconds = 0.0,
+        bool bPreferFastestProvider = false
+    );
+
+    /**
+     * ProcessN2CJson returning a future instead of taking a delegate. The future is set on the game thread
+     * once the translation is parsed, saved and broadcast, so continuations can chain further stages with Next
+     */
+    TFuture<FN2CTranslationResult> TranslateN2CJson(
+        const FString& JsonInput,
+        int32 EstimatedJsonTokens = INDEX_NONE,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr,
+        double EstimatedSeconds = 0.0,
+        bool bPreferFastestProvider = false
     );
 
+    /** ProcessN2CJsonParts returning a future of the stitched translation, set like TranslateN2CJson's */
+    TFuture<FN2CTranslationResult> TranslateN2CJsonParts(
+        const TArray<FString>& PartJsons,
+        const TArray<int32>& PartEstimatedTokens,
+        const TSharedPtr<const FN2CTranslationSession>& Session = nullptr,
+        double EstimatedSeconds = 0.0,
+        bool bPreferFastestProvider = false
+    );
+
+    /**
+     * Run a stage of a request, such as preparing its payload, on a task worker while earlier requests upload
+     * and parse. The result is moved into the future, which is set on the game thread so its continuation can
+     * hand it straight to TranslateN2CJson
+     */
+    template <typename ResultType>
+    static TFuture<ResultType> LaunchStage(TUniqueFunction<ResultType()>&& Stage)
+    {
+        TSharedRef<TPromise<ResultType>> Promise = MakeShared<TPromise<ResultType>>();
+        TFuture<ResultType> Future = Promise->GetFuture();
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [Promise, Stage = MoveTemp(Stage)]() mutable
+        {
+            AsyncTask(ENamedThreads::GameThread, [Promise, Result = Stage()]() mutable
+            {
+                Promise->SetValue(MoveTemp(Result));
+            });
+        });
+        return Future;
+    }
+
+    /**
+     * Translate a large set of requests through the active provider's batch API (Anthropic Message Batches,
+     * OpenAI Batch API), at about half the cost of individual requests but with results taking up to a day.
+     * Once the provider jobs end, each result is parsed, saved and passed to its item's OnComplete in item
+     * order, with consecutive items sharing a batch name saved in one batch output folder, then OnJobsEnded
+     * runs. Meant for offline runs, as it opens batch output folders of its own. Returns false without
+     * calling anything if the active provider has no batch API
+     */
+    bool SubmitBatchJob(TArray<FN2CBatchJobItem>&& Items, const FSimpleDelegate& OnJobsEnded);
+
+    /**
+     * Cancel every translation request that is queued or in flight, including provider batch jobs.
+     * Their callbacks report failure, and requests made afterwards are unaffected
+     */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    void CancelTranslations();
+
+    /** Whether any translation request is queued or in flight */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module")
+    bool HasPendingTranslations() const;
+
+    /**
+     * Open connections to the active and routed providers, and load local models, so the first request of a
+     * translation does not wait for DNS and TLS setup or a model load. Called on initialization, when the Node to
+     * Code window opens and periodically while translations are queued or in flight
+     */
+    void WarmUpConnections() const;
+
+    /** Queue wait, serialize, upload, first byte and total times, tokens and cost of recent requests, oldest first */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    TArray<FN2CRequestMetrics> GetRequestMetrics() const { return RequestMetrics.GetMetrics(); }
+
+    /** Queue depth, in-flight requests, cache hits and per provider and model metrics of the current batch and the session */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    FN2CMetricsDashboard GetMetricsDashboard() const;
+
+    /** Forget the recorded request metrics */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    void ClearRequestMetrics() { RequestMetrics.Reset(); }
+
+    /**
+     * Write the recorded request metrics to a file, as CSV if its extension is .csv and otherwise as JSON
+     * with p50/p95 latency, throughput and cost per provider and model. Returns false if it can't be written
+     */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    bool ExportRequestMetrics(const FString& FilePath) const;
+
+    /** Estimated tokens of the system prompt sent with every request, with the compact legend if bCompactInput */
+    int32 EstimateSystemPromptTokens(bool bCompactInput) const;
+
+    /**
+     * Whether the local translation cache holds a response to N2C JSON from one of the routing candidates,
+     * in the target language, so translating it would send nothing. Reads no entry
+     */
+    bool HasCachedTranslation(const FString& JsonInput) const;
+
     /** Get the current configuration */
     UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
     const FN2CLLMConfig& GetConfig() const { return Config; }
@@ -48,14 +269,48 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
     TScriptInterface<IN2CLLMService> GetActiveService() const { return ActiveService; }
 
-    /** Delegate for notifying when translation response is received */
+    /** Delegate for notifying when translation response is received. Each listener copies the whole response */
     UPROPERTY(BlueprintAssignable, Category = "Node to Code | LLM Module")
     FOnTranslationResponseReceived OnTranslationResponseReceived;
 
+    /** Native delegate for the same responses, shared by every listener */
+    FOnTranslationResultReady OnTranslationResultReady;
+
+    /** Delegate for a finished translation; read its graphs with the GetLatestTranslation accessors */
+    UPROPERTY(BlueprintAssignable, Category = "Node to Code | LLM Module")
+    FOnTranslationFinished OnTranslationFinished;
+
+    /** The latest successful translation, held once for every listener */
+    TSharedPtr<const FN2CTranslationResponse> GetLatestTranslation() const { return LatestTranslation; }
+
+    /** Number of graphs in the latest successful translation */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module")
+    int32 GetLatestTranslationGraphCount() const { return LatestTranslation.IsValid() ? LatestTranslation->Graphs.Num() : 0; }
+
+    /** Copy one graph of the latest successful translation. Returns false if GraphIndex is out of range */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    bool GetLatestTranslationGraph(int32 GraphIndex, FN2CGraphTranslation& OutGraph) const;
+
+    /** Whether a preview translation is shown but not yet saved */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module")
+    bool HasPreviewTranslation() const { return PreviewTranslation.IsValid(); }
+
+    /** Save the unsaved preview translation into a translation folder of its own. Returns false if there is none or it failed */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    bool PersistPreviewTranslation();
+
+    /** Token usage of the latest successful translation */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module")
+    FN2CTranslationUsage GetLatestTranslationUsage() const { return LatestTranslation.IsValid() ? LatestTranslation->Usage : FN2CTranslationUsage(); }
+
     /** Delegate for notifying when translation request is sent */
     UPROPERTY(BlueprintAssignable, Category = "Node to Code | LLM Module")
     FOnTranslationRequestSent OnTranslationRequestSent;
 
+    /** Delegate for partial generated code while a streamed translation is in progress */
+    UPROPERTY(BlueprintAssignable, Category = "Node to Code | LLM Module")
+    FOnTranslationStreamProgress OnTranslationStreamProgress;
+
     /** Get the current system status */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node to Code | LLM Module")
     EN2CSystemStatus GetSystemStatus() const { return CurrentStatus; }
@@ -68,16 +323,106 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
     void OpenTranslationFolder(bool& Success);
 
-    /** Save translation files to disk */
-    bool SaveTranslationToDisk(const FN2CTranslationResponse& Response, const FN2CBlueprint& Blueprint);
+    /**
+     * Start a translation of Blueprint, within the current batch if one has begun. Pass the session with the
+     * translation's requests so their responses are saved with this Blueprint and batch, whatever else translates since
+     */
+    TSharedRef<FN2CTranslationSession> CreateSession(const TSharedPtr<const FN2CBlueprint>& Blueprint) const;
 
-    /** Begin a batch translation (e.g. Translate Entire Blueprint) - all translations in this batch will share the same root directory */
-    void BeginBatchTranslation(const FString& BlueprintName);
+    /**
+     * Start a Blueprint's translation in a folder of its own, outside the current batch, with its Blueprint files written once.
+     * Requests sent with the session all save their graphs into that folder
+     */
+    TSharedRef<FN2CTranslationSession> CreateFolderSession(const TSharedRef<const FN2CBlueprint>& Blueprint);
 
-    /** End a batch translation - clears the batch root path */
+    /**
+     * Queue a request whose response is saved with Session but not broadcast to the translation delegates, and which is
+     * cancelled by Token as well as by CancelTranslations. For scripted translations such as UN2CTranslationJob
+     */
+    void ProcessN2CJsonQuietly(
+        const FString& JsonInput,
+        const TSharedRef<const FN2CTranslationSession>& Session,
+        const TSharedRef<FN2CCancellationToken>& Token,
+        const FOnLLMTranslationComplete& OnComplete,
+        int32 EstimatedJsonTokens = INDEX_NONE);
+
+    /** Save translation files to disk, in the session's batch folder or a translation folder of its own */
+    bool SaveTranslationToDisk(const FN2CTranslationResponse& Response, const FN2CTranslationSession& Session);
+
+    /**
+     * Begin a batch translation (e.g. Translate Entire Blueprint) - all translations in this batch will share the same root directory.
+     * The batch keeps an append-only journal there so an interrupted run can be resumed (see FindInterruptedBatch).
+     * The Blueprint JSON and snapshot are written once here when Blueprint is given, and never per response
+     */
+    void BeginBatchTranslation(const FString& BlueprintName, const FN2CBlueprint* Blueprint = nullptr);
+
+    /** End a batch translation - writes the graph fingerprint manifest and clears the batch root path */
     void EndBatchTranslation();
 
+    /** Find the most recent batch output for a Blueprint that recorded graph fingerprints */
+    bool FindPreviousBatchFingerprints(const FString& BlueprintName, TMap<FString, FString>& OutFingerprints, FString& OutPreviousRootPath) const;
+
+    /** Copy unchanged graph outputs from a previous batch into the current batch and keep their fingerprints */
+    void CarryForwardUnchangedGraphs(const FString& PreviousRootPath, const TMap<FString, FString>& UnchangedFingerprints);
+
+    /**
+     * Find the latest batch output for a Blueprint if that batch was interrupted before it ended,
+     * with the fingerprints of the graphs it completed. Their output can be carried forward so only
+     * the unfinished graphs are sent again
+     */
+    bool FindInterruptedBatch(const FString& BlueprintName, TMap<FString, FString>& OutCompletedFingerprints, FString& OutRootPath) const;
+
+    /**
+     * Load a graph's code as saved by the most recent earlier translation of a Blueprint, for diffing the
+     * current result against. The latest and current batch outputs are skipped. False if none saved the graph
+     */
+    UFUNCTION(BlueprintCallable, Category = "Node to Code | LLM Module")
+    bool LoadPreviousGraphCode(const FString& BlueprintName, const FN2CGraphTranslation& Graph, FN2CGeneratedCode& OutCode) const;
+
+    /**
+     * Load a graph's code as saved in a batch output folder, for patching by a delta request. Only reads files,
+     * so it is safe off the game thread. False if the folder has no code for the graph
+     */
+    static bool LoadBatchGraphCode(const FString& RootPath, const FString& GraphName, FN2CGeneratedCode& OutCode);
+
+    /** Load the Blueprint snapshot a batch output folder was started with. Safe off the game thread */
+    static bool LoadBatchSnapshot(const FString& RootPath, FN2CBlueprint& OutBlueprint);
+
+    /**
+     * Save and broadcast graphs translated without a request (see FN2CLocalTranslator) like a response in the
+     * target language set in the settings, within Session's batch
+     */
+    void DeliverLocalTranslation(const FN2CTranslationResponse& TranslationResponse, const TSharedPtr<const FN2CTranslationSession>& Session);
+
+    /** Latency model of the active provider and model, from the requests sent to it this session */
+    FN2CLatencyModel GetLatencyModel() const;
+
+    /** Record the fingerprint of a graph translated successfully in the current batch */
+    void RecordGraphFingerprint(const FString& GraphName, const FString& Fingerprint);
+
+    /** Journal a graph of the current batch as queued for translation */
+    void RecordGraphQueued(const FString& GraphName, const FString& Fingerprint);
+
+    /** Journal a graph of the current batch whose translation failed */
+    void RecordGraphFailed(const FString& GraphName);
+
 private:
+    /** Append an entry to the current batch's journal */
+    void AppendJournalEntry(const TSharedRef<FJsonObject>& Entry) const;
+
+    /** Read a batch journal: the graphs it completed and whether the batch ended. False if there is none */
+    static bool LoadBatchJournal(const FString& RootPath, TMap<FString, FString>& OutCompletedFingerprints, bool& bOutEnded);
+
+    /** Fingerprints a translation folder recorded in its manifest, or journaled before it was interrupted */
+    static bool LoadFolderFingerprints(const FString& FolderPath, TMap<FString, FString>& OutFingerprints);
+
+    /** Index of the translation folders under the current base path */
+    class FN2CTranslationHistory& GetTranslationHistory() const;
+
+    /** Index the graphs of a response saved in a translation folder, or in the language folder RelativeDir within it */
+    void RecordSavedGraphs(const FN2CTranslationResponse& Response, const FString& BlueprintName, const FString& RootPath,
+        const FString& RelativeDir, EN2CCodeLanguage Language, bool bBatch) const;
+
     /** Generate file paths for translation */
     FString GenerateTranslationRootPath(const FString& BlueprintName) const;
 
@@ -85,16 +430,31 @@ private:
     FString GetTranslationBasePath() const;
     
     /** Get the appropriate file extension for the target language */
-    FString GetFileExtensionForLanguage(EN2CCodeLanguage Language) const;
+    static FString GetFileExtensionForLanguage(EN2CCodeLanguage Language);
     
     /** Create directory if it doesn't exist */
     bool EnsureDirectoryExists(const FString& DirectoryPath) const;
 
-    /** Save graph files with batch-specific features (sanitized names, ClassItSelf special handling) */
+    /** Path of the Blueprint snapshot in a translation folder */
+    static FString GetSnapshotPath(const FString& RootPath);
+
+    /** Load a graph's code from the first of its possible file names found in a translation folder */
+    static bool LoadGraphCodeFromFolder(const FString& FolderPath, const TArray<FString>& FileBaseNames, const FString& Extension, FN2CGeneratedCode& OutCode);
+
+    /** Save the Blueprint JSON (pretty and minified) and binary snapshot into a translation folder */
+    bool SaveBlueprintFiles(const FN2CBlueprint& Blueprint, const FString& RootPath) const;
+
+    /** Save graph files with batch-specific features (sanitized names, ClassItSelf special handling), recording them for the consolidated class files */
     void SaveGraphFilesWithBatchFeatures(
         const FN2CTranslationResponse& Response,
         const FString& RootPath,
-        EN2CCodeLanguage TargetLanguage) const;
+        EN2CCodeLanguage TargetLanguage);
+
+    /** Save a translation into the folder of its target language */
+    bool SaveLanguageTranslation(const FN2CTranslationResponse& Response, const FN2CTranslationTarget& Target, const FN2CTranslationSession& Session);
+
+    /** Session for a request sent without one: the current batch, or a copy of the translator's Blueprint outside a batch */
+    TSharedRef<FN2CTranslationSession> CreateDefaultSession() const;
 
     /** Save graph files using original simple logic (for single translations) */
     void SaveGraphFilesOriginal(
@@ -102,6 +462,135 @@ private:
         const FString& RootPath,
         EN2CCodeLanguage TargetLanguage) const;
     
+    /** Target of requests in the target language set in the settings */
+    static FN2CTranslationTarget GetDefaultTarget();
+
+    /** Shared implementation of ProcessN2CJson. Parts of a split graph are not delivered until they are stitched */
+    void SendN2CJson(
+        const FString& JsonInput,
+        const FN2CTranslationTarget& Target,
+        const FOnLLMTranslationComplete& OnComplete,
+        int32 EstimatedJsonTokens,
+        bool bDeliverResponse);
+
+    /** Budget check and dispatch of a request that missed the translation cache */
+    void SendUncachedN2CJson(
+        const FString& JsonInput,
+        const FString& SystemPrompt,
+        const FN2CTranslationTarget& Target,
+        const FOnLLMTranslationComplete& OnComplete,
+        int32 EstimatedJsonTokens,
+        bool bDeliverResponse);
+
+    /** Token a request is cancelled with: the target's own, tracked for CancelTranslations, or the module's */
+    TSharedRef<FN2CCancellationToken> GetRequestToken(const FN2CTranslationTarget& Target);
+
+    /**
+     * System prompt for a language, with the compact legend if bCompactInput, the patching instructions if bDeltaInput
+     * the rules for calling already translated graphs if bCalleeDeclarations, and those for calling macros translated
+     * with their library if bSharedMacros
+     */
+    FString BuildSystemPrompt(bool bCompactInput, EN2CCodeLanguage Language, bool bDeltaInput = false, bool bCalleeDeclarations = false, bool bSharedMacros = false) const;
+
+    /** System prompt for a request, telling compact and delta input apart by their version markers and spotting callee declarations and shared macros */
+    FString BuildSystemPromptForInput(const FString& JsonInput, EN2CCodeLanguage Language) const;
+
+    /** Previous declaration of the graph a delta request patches, which a compact response leaves out when unchanged */
+    static TSharedPtr<const TMap<FString, FString>> FindKnownDeclarations(const FString& JsonInput);
+
+    /**
+     * Queue a request on the provider the router picks among those not yet tried,
+     * failing over to the next provider if the response does not parse
+     */
+    void DispatchN2CJson(
+        const FString& JsonInput,
+        const FString& SystemPrompt,
+        const FN2CTranslationTarget& Target,
+        const FOnLLMTranslationComplete& OnComplete,
+        bool bDeliverResponse,
+        const TSet<EN2CLLMProvider>& TriedProviders,
+        const TSharedRef<FN2CCancellationToken>& Token,
+        double DeadlineSeconds,
+        const FString& Draft = FString());
+
+    /**
+     * Queue a request on the speculative provider and preview its draft, then dispatch the request to the
+     * selected model with the draft to refine, or finish with the draft when drafts are not refined
+     */
+    void DispatchDraftN2CJson(
+        const FString& JsonInput,
+        const FString& SystemPrompt,
+        const FN2CTranslationTarget& Target,
+        const FOnLLMTranslationComplete& OnComplete,
+        bool bDeliverResponse,
+        const TSharedRef<FN2CCancellationToken>& Token,
+        double DeadlineSeconds);
+
+    /** Draft translation as appended to the request that refines it */
+    static FString FormatDraftForRefinement(const FN2CTranslationResponse& Draft);
+
+    /** Translation that failed its syntax check and the errors, as appended to the request sent again */
+    static FString FormatDiagnosticsForRetry(const FN2CTranslationResponse& Translation, const FString& Diagnostics);
+
+    /** Record the metrics of a request that left the queue at StartTime and has finished */
+    void RecordRequestMetrics(
+        EN2CLLMProvider Provider,
+        const FDateTime& QueuedAt,
+        double QueueWaitSeconds,
+        double StartTime,
+        const FN2CHttpRequestHandle& Handle,
+        const FN2CTranslationResponse& TranslationResponse,
+        bool bParsed);
+
+    /** Seconds a request of EstimatedInputTokens may take before it is abandoned, or 0 for no deadline */
+    double GetRequestDeadlineSeconds(int32 EstimatedInputTokens) const;
+
+    /**
+     * Parse a raw LLM response from a provider and, if bDeliverResponse, save it to disk and broadcast the result.
+     * Failures are always broadcast. Returns true if the response parsed
+     */
+    bool HandleLLMResponse(const FString& Response, EN2CLLMProvider Provider, const FN2CTranslationTarget& Target, FN2CTranslationResponse& TranslationResponse, bool bDeliverResponse = true);
+
+    /** Parse a raw response with the parser of the provider that produced it, without reporting the result */
+    bool ParseLLMResponse(const FString& Response, EN2CLLMProvider Provider, FN2CTranslationResponse& TranslationResponse);
+
+    /** Log and parse a raw response with Parser. Safe on any thread, since parsers hold no state */
+    static bool ParseWithParser(UN2CResponseParserBase* Parser, const FString& Response, FN2CTranslationResponse& TranslationResponse);
+
+    /** A raw response and what it parsed into */
+    struct FParsedResponse
+    {
+        FString Response;
+        FN2CTranslationResponse TranslationResponse;
+        bool bParsed = false;
+    };
+
+    /**
+     * Parse raw responses of a provider on task workers, then call OnParsed on the game thread with them in
+     * the same order. Empty responses count as failed without being parsed
+     */
+    void ParseLLMResponsesAsync(TArray<FString>&& Responses, EN2CLLMProvider Provider, TUniqueFunction<void(TArray<FParsedResponse>&&)>&& OnParsed);
+
+    /** Update status and deliver or broadcast the outcome of a parsed response */
+    void FinishLLMResponse(const FN2CTranslationResponse& TranslationResponse, const FN2CTranslationTarget& Target, bool bParsed, bool bDeliverResponse);
+
+    /** Keep a successful response as the latest translation and broadcast it to every delegate */
+    void BroadcastTranslationResult(const TSharedRef<const FN2CTranslationResponse>& Response, bool bSuccess);
+
+    /** Save a parsed translation to disk and broadcast it if the target is */
+    void DeliverTranslation(const FN2CTranslationResponse& TranslationResponse, const FN2CTranslationTarget& Target);
+
+    /** Parse the results of a provider batch submission off the game thread, then save and report them in item order */
+    void FinishBatchJob(
+        const TArray<FN2CBatchJobItem>& Items,
+        const TArray<FString>& ResponseBodies,
+        const TArray<FString>& CacheKeys,
+        EN2CLLMProvider Provider,
+        const FSimpleDelegate& OnJobsEnded);
+
+    /** Merge the translations of a split graph's parts into one translation per graph name */
+    static void StitchPartTranslations(const TArray<FN2CTranslationResponse>& Parts, FN2CTranslationResponse& OutResponse);
+
     /** Initialize components */
     bool InitializeComponents();
 
@@ -111,6 +600,30 @@ private:
     /** Create appropriate service for provider */
     bool CreateServiceForProvider(EN2CLLMProvider Provider);
 
+    /** Create and initialize a service for a provider with its own configuration */
+    TScriptInterface<IN2CLLMService> CreateService(EN2CLLMProvider Provider, const FN2CLLMConfig& ServiceConfig);
+
+    /** Apply a configuration in place to Existing if it is a service for Provider, otherwise create one */
+    TScriptInterface<IN2CLLMService> ReconfigureOrCreateService(UObject* Existing, EN2CLLMProvider Provider, const FN2CLLMConfig& ServiceConfig);
+
+    /** Create services for the routing providers configured in settings */
+    void CreateRoutedServices();
+
+    /** Providers a request may be routed to, the active one first */
+    TArray<EN2CLLMProvider> GetRoutingCandidates() const;
+
+    /** Service for the active provider or one of the routed providers */
+    TScriptInterface<IN2CLLMService> GetServiceForProvider(EN2CLLMProvider Provider) const;
+
+    /** Model a provider's requests are sent to */
+    FString GetModelForProvider(EN2CLLMProvider Provider) const;
+
+    /** Service speculative translations are sent to, created on first use */
+    TScriptInterface<IN2CLLMService> GetSpeculativeService();
+
+    /** Cache key and system prompt of the speculative translation of N2C JSON */
+    FString MakeSpeculativeCacheKey(const FString& JsonInput, FString& OutSystemPrompt) const;
+
     /** Current configuration */
     UPROPERTY()
     FN2CLLMConfig Config;
@@ -130,6 +643,17 @@ private:
     /** Active LLM service */
     TScriptInterface<class IN2CLLMService> ActiveService;
 
+    /**
+     * Every service that has been the active one, by provider. Switching provider or model reconfigures the pooled
+     * service in place, so its connections and caches stay warm
+     */
+    UPROPERTY()
+    TMap<EN2CLLMProvider, UObject*> ServicePool;
+
+    /** Services for the other providers requests are routed to, keyed by provider */
+    UPROPERTY()
+    TMap<EN2CLLMProvider, UObject*> RoutedServices;
+
     /** Current system status */
     UPROPERTY()
     EN2CSystemStatus CurrentStatus;
@@ -137,9 +661,86 @@ private:
     /** Path to the latest translation */
     UPROPERTY()
     FString LatestTranslationPath;
+
+    /** Latest successfully delivered translation */
+    TSharedPtr<const FN2CTranslationResponse> LatestTranslation;
+
+    /** Latest preview translation and the session it was made in, until it is persisted or replaced by the next */
+    TSharedPtr<const FN2CTranslationResponse> PreviewTranslation;
+    TSharedPtr<const FN2CTranslationSession> PreviewSession;
     
-    /** Cached root path for the current translation batch (e.g. one Translate Entire Blueprint run) */
+    /** Cached root path for the current translation batch (e.g. one Translate Entire Blueprint run), copied into its sessions */
     FString CurrentBatchRootPath;
+
+    /** Fingerprints of graphs whose output is present in the current batch */
+    TMap<FString, FString> CurrentBatchFingerprints;
+
+    /** Graphs saved in the current batch, by output folder, merged into class files when it ends */
+    TMap<FString, FN2CClassOutput> CurrentBatchClassOutputs;
+
+    /** Name of the current batch's Blueprint, naming its class files when no graph names a class */
+    FString CurrentBatchBlueprintName;
+
+    /** Timings, tokens and cost of recent requests */
+    FN2CRequestMetricsCollector RequestMetrics;
+
+    /** RequestMetrics.GetTotalRecorded() when the current batch began; its requests are exported with it */
+    int64 CurrentBatchFirstMetric = 0;
+
+    /** RequestMetrics.GetCacheHits() when the current batch began */
+    int32 CurrentBatchFirstCacheHit = 0;
+
+    /** Token the current requests were started under; replaced when they are cancelled */
+    TSharedPtr<FN2CCancellationToken> CancellationToken;
+
+    /** Tokens of requests sent with their own token, also cancelled by CancelTranslations */
+    TArray<TWeakPtr<FN2CCancellationToken>> RequestTokens;
+
+    /** Service for the speculative provider and model, unless they are the active ones */
+    UPROPERTY()
+    UObject* SpeculativeService = nullptr;
+
+    /** Whether the settings changed since SpeculativeService was configured */
+    bool bSpeculativeServiceStale = false;
+
+    /** Cache keys of speculative translations queued or in flight */
+    TSet<FString> PendingSpeculativeKeys;
+
+    /** A caller waiting on an identical request that was already queued or in flight */
+    struct FCoalescedRequest
+    {
+        FString JsonInput;
+        FString SystemPrompt;
+        FN2CTranslationTarget Target;
+        FOnLLMTranslationComplete OnComplete;
+        int32 EstimatedJsonTokens = INDEX_NONE;
+        bool bDeliverResponse = true;
+        TSharedPtr<FN2CCancellationToken> Token;
+    };
+
+    /** Requests queued or in flight by the key of their payload, with the callers that joined them */
+    TMap<FString, TArray<FCoalescedRequest>> InFlightRequests;
+
+    /** Provider batch jobs waiting for their results */
+    TArray<TSharedPtr<FN2CProviderBatchJob>> BatchJobs;
+
+    /** Keep connections and local models warm until no translation is pending */
+    void StartWarmUpHeartbeat();
+
+    /** Ticker repeating WarmUpConnections while translations are pending */
+    FTSTicker::FDelegateHandle WarmUpHeartbeatHandle;
+
+    /** Probe provider health every ProviderProbeIntervalSeconds until Node to Code has been idle for a while */
+    void StartProbeHeartbeat();
+
+    /** Send a health probe to each routing candidate that has no requests queued or in flight */
+    void ProbeProviders();
+
+    /** Ticker repeating ProbeProviders */
+    FTSTicker::FDelegateHandle ProbeHeartbeatHandle;
+
+    /** When a translation was last asked for (FPlatformTime::Seconds) */
+    double LastActivityTime = 0.0;
     
     /** Initialization state */
     bool bIsInitialized;
@@ -6,36 +6,59 @@
 #include "Dom/JsonObject.h"
 #include "N2CLLMTypes.h"
 #include "N2COllamaConfig.h"
-#include "N2CLLMPayloadBuilder.generated.h"
 
 /**
- * @class UN2CLLMPayloadBuilder
- * @brief Utility class for building JSON payloads for LLM requests
+ * @class FN2CLLMPayloadBuilder
+ * @brief Builds the JSON request bodies sent to LLM providers
+ *
+ * Settings are kept as plain values and messages as the strings given, and the body is written straight
+ * into UTF-8 in the provider's shape, with no JSON object tree. The parts that only change with the provider
+ * and model, such as the response format built from the schema, are serialized once and reused while they
+ * stay the same. Each service keeps one builder and reuses it for every request: Initialize starts the next
+ * payload. Game thread only.
  */
-UCLASS()
-class NODETOCODE_API UN2CLLMPayloadBuilder : public UObject
+class NODETOCODE_API FN2CLLMPayloadBuilder
 {
-    GENERATED_BODY()
-
 public:
-    /** Initialize with model name */
+    /** Start a new payload for the model, dropping the settings and messages of the last one */
     void Initialize(const FString& ModelName);
-    
+
     /** Set the model name */
     void SetModel(const FString& ModelName);
-    
+
     /** Common configuration */
     void SetTemperature(float Value);
     void SetMaxTokens(int32 Value);
-    
+
     /** Message building */
     void AddSystemMessage(const FString& Content);
     void AddUserMessage(const FString& Content);
-    
+
+    /** Add a user message whose stable prefix (e.g. reference source files) is identical across requests */
+    void AddUserMessageWithPrefix(const FString& StablePrefix, const FString& Content);
+
+    /** Prompt caching */
+    void SetPromptCaching(bool bEnabled);
+    void SetPromptCacheKey(const FString& Key);
+    void SetCachedContent(const FString& CachedContentName);
+
+    /** Build a Gemini cachedContents create request holding the system prompt and stable prefix */
+    static FString BuildGeminiCachedContentPayload(
+        const FString& Model,
+        const FString& SystemMessage,
+        const FString& StablePrefix,
+        int32 TtlSeconds);
+
     /** Response format */
     void SetJsonResponseFormat(const TSharedPtr<FJsonObject>& Schema);
     void SetStructuredOutput(const TSharedPtr<FJsonObject>& Schema) { SetJsonResponseFormat(Schema); }
-    
+
+    /** Request a streamed response (Gemini selects streaming by endpoint instead) */
+    void SetStreaming(bool bEnabled);
+
+    /** Bound the model's hidden reasoning: reasoning_effort for OpenAI, a thinking budget for Gemini, think for Ollama */
+    void SetReasoningEffort(EN2CReasoningEffort Effort);
+
     /** Provider-specific extensions */
     void ConfigureForOpenAI();
     void ConfigureForAnthropic();
@@ -43,23 +66,80 @@ public:
     void ConfigureForDeepSeek();
     void ConfigureForOllama(const struct FN2COllamaConfig& OllamaConfig);
     void ConfigureForLMStudio();
-    
+    void ConfigureForOpenAICompatible();
+
     /** Generate final payload */
     FString Build();
-    
-    /** Get the JSON schema for N2C translation responses */
+
+    /** Generate final payload as condensed UTF-8 bytes, ready to be moved into an HTTP request body */
+    TArray<uint8> BuildUtf8();
+
+    /** Get the JSON schema for N2C translation responses in the shape the settings ask for, parsed once and shared by every request */
     static TSharedPtr<FJsonObject> GetN2CResponseSchema();
 
+    /** Get the response schema with short keys if bCompact, and with the implementation notes field if bNotes */
+    static TSharedPtr<FJsonObject> GetN2CResponseSchema(bool bCompact, bool bNotes);
+
 private:
-    /** Root JSON object */
-    TSharedPtr<FJsonObject> RootObject;
-    
-    /** Messages array for providers that use it */
-    TArray<TSharedPtr<FJsonValue>> MessagesArray;
-    
+    /** Parse one variant of the response schema */
+    static TSharedPtr<FJsonObject> BuildN2CResponseSchema(bool bCompact, bool bNotes);
+
+    struct FMessage
+    {
+        bool bSystem = false;
+
+        /** Stable leading part of a user message, empty if it has none */
+        FString Prefix;
+
+        FString Content;
+    };
+
+    /** Condensed UTF-8 JSON writer that places the commas */
+    class FWriter;
+
+    /** Whether the model is one of OpenAI's reasoning models, which reject temperature and max_tokens */
+    bool IsOpenAIReasoningModel() const;
+
+    /** Write the provider's system prompt and messages */
+    void WriteMessages(FWriter& Writer) const;
+
+    /** Write Gemini's generationConfig, which holds its sampling, token limit, thinking and response format */
+    void WriteGeminiGenerationConfig(FWriter& Writer);
+
+    /** Response format fields, serialized again only when the provider, model or schema changed */
+    const TArray<uint8>& GetResponseFormatFields();
+
     /** Current provider type */
-    EN2CLLMProvider ProviderType;
-    
+    EN2CLLMProvider ProviderType = EN2CLLMProvider::OpenAI;
+
     /** Model name */
     FString ModelName;
+
+    TOptional<float> Temperature;
+    TOptional<int32> MaxTokens;
+    TOptional<EN2CReasoningEffort> ReasoningEffort;
+    TOptional<bool> bStream;
+    FString PromptCacheKey;
+    FString CachedContentName;
+
+    /** Whether stable prompt sections should be marked cacheable */
+    bool bPromptCaching = false;
+
+    /** Ollama's options besides num_predict, in order, and how long it keeps the model loaded */
+    TArray<TPair<const ANSICHAR*, double>> OllamaOptions;
+    TOptional<int32> OllamaKeepAlive;
+
+    /** In the order they were added */
+    TArray<FMessage> Messages;
+
+    TSharedPtr<FJsonObject> ResponseSchema;
+
+    /** Serialized response format fields, and what they were serialized for */
+    TArray<uint8> ResponseFormatBytes;
+    TSharedPtr<FJsonObject> ResponseFormatSchema;
+    EN2CLLMProvider ResponseFormatProvider = EN2CLLMProvider::OpenAI;
+    FString ResponseFormatModel;
+
+    /** Size of the last payload, so the next one is usually written without growing its buffer */
+    int32 LastPayloadSize = 0;
 };
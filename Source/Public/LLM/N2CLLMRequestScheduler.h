@@ -0,0 +1,234 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "LLM/N2CLLMTypes.h"
+
+/**
+ * Work item run by the scheduler once a slot is available.
+ * The request must invoke OnFinished exactly once when its HTTP round trip completes (success or failure).
+ */
+using FN2CScheduledRequest = TFunction<void(const FSimpleDelegate& OnFinished)>;
+
+class FN2CCancellationToken;
+struct FN2CMetricsSummary;
+
+/** Scheduling class of a request. A provider's queue runs every queued request of a class before any of the next */
+enum class EN2CRequestPriority : uint8
+{
+    /** Asked for by the user and waited on, such as translating the open graph */
+    Interactive,
+
+    /** Part of a larger translation, such as a whole Blueprint, a job or a commandlet run */
+    Batch,
+
+    /** Translated ahead of being asked for, and only cached */
+    Speculative
+};
+
+/** Rate limit headroom reported by a provider's response headers. Negative values are unknown */
+struct FN2CRateLimitState
+{
+    int64 RequestsLimit = -1;
+    int64 RequestsRemaining = -1;
+    int64 TokensLimit = -1;
+    int64 TokensRemaining = -1;
+
+    /** Whether any limit was reported */
+    bool IsKnown() const { return (RequestsLimit > 0 && RequestsRemaining >= 0) || (TokensLimit > 0 && TokensRemaining >= 0); }
+
+    /** Smallest remaining fraction across the reported limits, 1 if none were reported */
+    double GetHeadroom() const;
+};
+
+/**
+ * @struct FN2CLatencyModel
+ * @brief Expected duration of a translation request, from its graphs' complexity and the provider's observed speed
+ *
+ * A request waits for its first byte, which grows with its input, then streams output roughly in proportion
+ * to the FN2CGraphComplexity score of its graphs. Defaults stand in until a provider has answered requests.
+ */
+struct FN2CLatencyModel
+{
+    /** Seconds until the first response byte of a request of typical size */
+    double FirstByteSeconds = 2.0;
+
+    double OutputTokensPerSecond = 40.0;
+
+    /** Output tokens a translation takes per point of FN2CGraphComplexity::GetScore */
+    static constexpr double OutputTokensPerComplexity = 40.0;
+
+    /** Input tokens a provider reads per second on top of FirstByteSeconds */
+    static constexpr double InputTokensPerSecond = 5000.0;
+
+    /** Model with a provider and model's observed time to first byte and throughput, where known */
+    static FN2CLatencyModel FromSummary(const FN2CMetricsSummary& Summary);
+
+    /** Expected seconds for a request of InputTokens translating graphs of ComplexityScore in total */
+    double EstimateSeconds(int32 InputTokens, float ComplexityScore) const;
+};
+
+/**
+ * @class FN2CLLMRequestScheduler
+ * @brief Queues LLM requests per provider and dispatches them under concurrency and rate limits
+ *
+ * Each provider has its own queue, in-flight counter and token bucket. The queue runs interactive requests before
+ * batch ones and batch before speculative, so a request the user waits on goes ahead of every queued background one.
+ * Within a class it runs the longest expected request first, which shortens a batch by not leaving its largest
+ * graphs until last, and is FIFO otherwise. Background requests never take the provider's last
+ * ReservedInteractiveRequests slots, nor its last rate limit token, so an interactive request is sent at once
+ * however many are queued behind a big job; requests already in flight are never interrupted. A provider with a
+ * background time window holds its batch and speculative requests outside the window and sends them once it
+ * opens; a batch interrupted meanwhile resumes from its batch journal as usual. Limits are read
+ * from UN2CSettings::ProviderRequestLimits on every dispatch so edits apply to the next request.
+ * With adaptive concurrency, the in-flight limit follows the provider's rate limit headers AIMD-style.
+ * Local providers with an endpoint pool are limited by the pool's healthy capacity instead.
+ * While any request is queued or in flight the editor's "Use Less CPU when in Background" is turned off,
+ * so responses keep being read when the editor is not focused, and is put back once none remain.
+ */
+class FN2CLLMRequestScheduler
+{
+public:
+    /** Get the singleton instance */
+    static FN2CLLMRequestScheduler& Get();
+
+    /**
+     * Queue a request for a provider and dispatch it as soon as limits allow. It goes ahead of queued requests
+     * of a lower priority, and of those of its own priority expected to take less than EstimatedSeconds
+     * (see FN2CLatencyModel); unestimated requests go last among their priority.
+     * If Token is cancelled while the request waits, it is run straight away without taking a slot or rate
+     * limit token, so it can report the cancellation
+     */
+    void EnqueueRequest(
+        EN2CLLMProvider Provider,
+        FN2CScheduledRequest&& Request,
+        const TSharedPtr<FN2CCancellationToken>& Token = nullptr,
+        double EstimatedSeconds = 0.0,
+        EN2CRequestPriority Priority = EN2CRequestPriority::Interactive);
+
+    /**
+     * Resend an in-flight request after DelaySeconds. The request keeps its slot, and nothing else is
+     * dispatched to the provider until it has been resent, so a rate limit backs off the whole queue
+     */
+    void ScheduleRetry(EN2CLLMProvider Provider, float DelaySeconds, TFunction<void()>&& Resend);
+
+    /**
+     * Feed the rate limit headroom from a response back into adaptive concurrency.
+     * bThrottled marks a 429 or overload response, which always halves concurrency
+     */
+    void ReportRateLimits(EN2CLLMProvider Provider, const FN2CRateLimitState& RateLimits, bool bThrottled);
+
+    /** Latest rate limit headroom reported by a provider */
+    FN2CRateLimitState GetRateLimits(EN2CLLMProvider Provider) const;
+
+    /** Seconds until a provider's background time window opens, 0 if it is open or the provider has none */
+    double GetSecondsUntilBackgroundWindow(EN2CLLMProvider Provider) const;
+
+    /** Current in-flight limit for a provider, after adaptive adjustments or the capacity of its endpoint pool */
+    int32 GetConcurrencyLimit(EN2CLLMProvider Provider) const;
+
+    /** Dispatch queued requests again after a provider's capacity grew outside the scheduler */
+    void NotifyCapacityChanged(EN2CLLMProvider Provider);
+
+    /** Run the queued requests of every provider whose token has been cancelled, so they report it */
+    void DrainCancelledRequests();
+
+    /** Drop all queued (not yet dispatched) requests for a provider */
+    void ClearQueue(EN2CLLMProvider Provider);
+
+    /** Number of requests waiting for a slot */
+    int32 GetQueuedCount(EN2CLLMProvider Provider) const;
+
+    /** Number of requests currently in flight */
+    int32 GetActiveCount(EN2CLLMProvider Provider) const;
+
+    /** Whether any request is queued or in flight for any provider */
+    bool HasPendingRequests() const;
+
+    /** Put back the editor's background CPU throttling if pending requests turned it off */
+    void RestoreBackgroundThrottling();
+
+private:
+    /** Private constructor for singleton */
+    FN2CLLMRequestScheduler() = default;
+
+    /** A request waiting for a slot */
+    struct FQueuedRequest
+    {
+        FN2CScheduledRequest Request;
+
+        /** Token the request was queued under, if any */
+        TSharedPtr<FN2CCancellationToken> Token;
+
+        /** Expected duration the queue is ordered by, 0 if unknown */
+        double EstimatedSeconds = 0.0;
+
+        EN2CRequestPriority Priority = EN2CRequestPriority::Interactive;
+    };
+
+    /** Scheduling state for a single provider */
+    struct FProviderState
+    {
+        /** Requests waiting to be dispatched, by priority, then longest expected first and oldest first among equals */
+        TArray<FQueuedRequest> Queue;
+
+        /** Requests dispatched but not yet finished */
+        int32 ActiveRequests = 0;
+
+        /** Of ActiveRequests, those that are not interactive */
+        int32 ActiveBackgroundRequests = 0;
+
+        /** Tokens currently available in the bucket */
+        double Tokens = -1.0;
+
+        /** Time of the last bucket refill */
+        double LastRefillTime = 0.0;
+
+        /** Pending ticker used to resume dispatch once a token becomes available */
+        FTSTicker::FDelegateHandle RetryHandle;
+
+        /** Dispatch is held back until this time while a retry waits out its backoff */
+        double PausedUntil = 0.0;
+
+        /** Adaptive in-flight limit; fractional so it grows by one per round of successful responses */
+        double ConcurrencyLimit = -1.0;
+
+        /** Latest headroom reported by the provider */
+        FN2CRateLimitState RateLimits;
+
+        /** Whether background requests are held until the provider's time window opens */
+        bool bHeldForWindow = false;
+    };
+
+    /** Dispatch as many queued requests as the provider's limits allow */
+    void TryDispatch(EN2CLLMProvider Provider);
+
+    /** Run every queued request whose token was cancelled, outside the provider's limits */
+    void DrainCancelled(EN2CLLMProvider Provider);
+
+    /** Dispatch again after DelaySeconds, unless a wake-up is already pending */
+    void WakeUpIn(EN2CLLMProvider Provider, FProviderState& State, float DelaySeconds);
+
+    /** Called when a dispatched request finishes */
+    void OnRequestFinished(EN2CLLMProvider Provider, bool bBackground);
+
+    /** Turn background throttling off when requests become pending, and back on when none are */
+    void UpdateBackgroundThrottling();
+
+    /** In-flight limit for a provider's state under its configured limits */
+    static int32 GetConcurrencyLimit(FProviderState& State, const FN2CProviderRequestLimits& Limits);
+
+    /** Seconds until the background time window of a provider's limits opens, 0 if it is open or disabled */
+    static double GetSecondsUntilWindow(const FN2CProviderRequestLimits& Limits);
+
+    /** Top up the token bucket based on elapsed time */
+    static void RefillTokens(FProviderState& State, const FN2CProviderRequestLimits& Limits);
+
+    /** Per-provider scheduling state */
+    TMap<EN2CLLMProvider, FProviderState> ProviderStates;
+
+    /** Whether background throttling was on and is turned off for the pending requests */
+    bool bThrottlingOverridden = false;
+};
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLM/N2CLLMTypes.h"
+
+/** Outcome of a synthetic health probe: a tiny request sent to a provider outside any translation */
+struct FN2CProviderProbe
+{
+    bool bSucceeded = false;
+
+    /** Seconds from sending the probe to its first response byte */
+    double FirstByteSeconds = 0.0;
+
+    /** Output tokens per second after the first byte, or 0 if the response was not streamed */
+    double OutputTokensPerSecond = 0.0;
+};
+
+/**
+ * @class FN2CLLMRouter
+ * @brief Picks which configured provider serves the next translation request
+ *
+ * Each candidate is weighted by its observed latency, the cost of its configured model and the
+ * requests already queued or in flight for it, and one is drawn at random by weight so a batch
+ * spreads across every backend. Providers whose last requests failed or whose rate limit is
+ * exhausted sit out a cooldown, which is how a batch fails over. Synthetic probes sent while NodeToCode
+ * is in use keep this current between translations: a failed probe cools the provider down like a failed
+ * request, probes slower than the provider's usual time to first byte stretch its expected latency, and
+ * probe throughput stands in for the latency of providers no translation has measured yet. Game thread only.
+ */
+class FN2CLLMRouter
+{
+public:
+    /** Get the singleton instance */
+    static FN2CLLMRouter& Get();
+
+    /**
+     * Choose a provider among Candidates, skipping any in Excluded. bPreferFastest takes the one expected to answer
+     * soonest, given its latency and load, instead of drawing by weight; meant for the largest requests of a batch.
+     * Falls back to a cooling-down provider only if every other candidate is excluded. Returns false if none remain
+     */
+    bool SelectProvider(
+        const TArray<EN2CLLMProvider>& Candidates,
+        const TSet<EN2CLLMProvider>& Excluded,
+        EN2CLLMProvider& OutProvider,
+        bool bPreferFastest = false) const;
+
+    /** Record a request that completed and parsed */
+    void ReportSuccess(EN2CLLMProvider Provider, double LatencySeconds);
+
+    /** Record a failed request; repeated failures lengthen the provider's cooldown */
+    void ReportFailure(EN2CLLMProvider Provider);
+
+    /** Record a health probe */
+    void ReportProbe(EN2CLLMProvider Provider, const FN2CProviderProbe& Probe);
+
+private:
+    /** Private constructor for singleton */
+    FN2CLLMRouter() = default;
+
+    /** Observed behaviour of a single provider */
+    struct FProviderStats
+    {
+        /** Moving average of successful request latency, or negative until the first success */
+        double AverageLatency = -1.0;
+
+        int32 ConsecutiveFailures = 0;
+
+        /** Time until which the provider is only used as a last resort */
+        double CooldownUntil = 0.0;
+
+        /** Moving averages of probe time to first byte, recent and long-term, and of probe throughput; negative until known */
+        double ProbeFirstByte = -1.0;
+        double BaselineProbeFirstByte = -1.0;
+        double ProbeTokensPerSecond = -1.0;
+
+        /** Moving average of the share of probes that failed */
+        double ProbeErrorRate = 0.0;
+    };
+
+    /** Whether a provider is cooling down after errors or has exhausted its rate limit */
+    bool IsCoolingDown(EN2CLLMProvider Provider) const;
+
+    /** Seconds until a new request to the provider is expected to complete, counting those ahead of it */
+    double GetExpectedWait(EN2CLLMProvider Provider, double DefaultLatency) const;
+
+    /** Relative share of requests a provider should receive */
+    double GetWeight(EN2CLLMProvider Provider, double DefaultLatency) const;
+
+    TMap<EN2CLLMProvider, FProviderStats> Stats;
+};
@@ -8,12 +8,27 @@
 /** Delegate for receiving LLM responses */
 DECLARE_DELEGATE_OneParam(FOnLLMResponseReceived, const FString& /* Response */);
 
-/** Delegate for receiving parsed translation responses */
+/** Delegate for a completed translation request, carrying the parsed response (including token usage) */
+DECLARE_DELEGATE_TwoParams(FOnLLMTranslationComplete, const FN2CTranslationResponse& /* Response */, bool /* bSuccess */);
+
+/** Delegate for receiving raw chunks of a streamed LLM response as they arrive */
+DECLARE_DELEGATE_OneParam(FOnLLMStreamChunkReceived, const FString& /* Chunk */);
+
+/** Delegate for receiving parsed translation responses. Each Blueprint listener receives its own copy */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTranslationResponseReceived, const FN2CTranslationResponse&, Response, bool, bSuccess);
 
+/** Native delegate for parsed translation responses, shared by every listener rather than copied */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTranslationResultReady, const TSharedRef<const FN2CTranslationResponse>& /* Response */, bool /* bSuccess */);
+
+/** Delegate for a finished translation, whose graphs are read through the LLM module's latest translation accessors */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTranslationFinished, bool, bSuccess);
+
 /** Delegate for when a translation request is sent */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnTranslationRequestSent);
 
+/** Delegate for partial generated code while a streamed translation is in progress */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTranslationStreamProgress, const FString&, PartialCode);
+
 /** Available LLM providers */
 UENUM(BlueprintType)
 enum class EN2CLLMProvider : uint8
@@ -23,7 +38,8 @@ enum class EN2CLLMProvider : uint8
     Gemini      UMETA(DisplayName = "Gemini"),
     Ollama      UMETA(DisplayName = "Ollama"),
     DeepSeek    UMETA(DisplayName = "DeepSeek"),
-    LMStudio    UMETA(DisplayName = "LM Studio")
+    LMStudio    UMETA(DisplayName = "LM Studio"),
+    OpenAICompatible UMETA(DisplayName = "OpenAI-Compatible (vLLM, TGI, SGLang)")
 };
 
 /** Status of the Node to Code system */
@@ -36,6 +52,28 @@ enum class EN2CSystemStatus : uint8
     Initializing UMETA(DisplayName = "Initializing")
 };
 
+/** How much hidden reasoning a reasoning model is asked to do before it answers */
+UENUM(BlueprintType)
+enum class EN2CReasoningEffort : uint8
+{
+    /** Picked per request from the size of its graph */
+    Auto        UMETA(DisplayName = "Auto"),
+    /** No reasoning where the model allows it, otherwise the least it accepts */
+    Off         UMETA(DisplayName = "Off"),
+    Low         UMETA(DisplayName = "Low"),
+    Medium      UMETA(DisplayName = "Medium"),
+    High        UMETA(DisplayName = "High")
+};
+
+/** Whether provider requests are sent, recorded for later replay, or replayed from recordings */
+UENUM(BlueprintType)
+enum class EN2CHttpReplayMode : uint8
+{
+    Off         UMETA(DisplayName = "Off"),
+    Record      UMETA(DisplayName = "Record"),
+    Replay      UMETA(DisplayName = "Replay")
+};
+
 /**
  * @struct FN2CLLMConfig
  * @brief Configuration settings for LLM integration
@@ -62,4 +100,127 @@ struct FN2CLLMConfig
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration")
     FString Model;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration")
+    bool bStreamResponses = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration")
+    bool bUsePromptCaching = true;
+};
+
+/**
+ * @struct FN2CLocalEndpoint
+ * @brief An extra server for a local provider, balanced with the main endpoint
+ */
+USTRUCT(BlueprintType)
+struct FN2CLocalEndpoint
+{
+    GENERATED_BODY()
+
+    /** Base URL of the server, e.g. http://gpu-box-2:11434 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Endpoint"))
+    FString Url;
+
+    /** Requests this server handles at once, usually the number of parallel slots it is started with */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Max Concurrent Requests", ClampMin = "1", UIMin = "1", UIMax = "16"))
+    int32 MaxConcurrentRequests = 1;
+};
+
+/**
+ * @struct FN2CProviderRequestLimits
+ * @brief Concurrency and rate limits applied by the request scheduler to a single provider
+ */
+USTRUCT(BlueprintType)
+struct FN2CProviderRequestLimits
+{
+    GENERATED_BODY()
+
+    /** Maximum number of requests in flight at once for this provider */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Max Concurrent Requests", ClampMin = "1", UIMin = "1", UIMax = "32"))
+    int32 MaxConcurrentRequests = 4;
+
+    /** Sustained request rate allowed by the token bucket (0 = unlimited) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Requests Per Minute", ClampMin = "0", UIMin = "0"))
+    float RequestsPerMinute = 50.0f;
+
+    /** Number of requests that may be sent back-to-back before the rate limit applies */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Burst Size", ClampMin = "1", UIMin = "1"))
+    int32 BurstSize = 4;
+
+    /**
+     * Adjust concurrency from the rate limit headers the provider returns: one more slot per round of
+     * responses with headroom left, half as many once a limit runs low or a request is throttled.
+     * Max Concurrent Requests is the starting point
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Adaptive Concurrency"))
+    bool bAdaptiveConcurrency = true;
+
+    /** Ceiling for adaptive concurrency */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Max Adaptive Concurrent Requests", ClampMin = "1", UIMin = "1", UIMax = "64", EditCondition = "bAdaptiveConcurrency"))
+    int32 MaxAdaptiveConcurrentRequests = 16;
+
+    /**
+     * Slots of the in-flight limit that batch and speculative requests leave free for interactive ones, so a
+     * graph translated while a big job runs is sent at once. Background work always gets at least one slot
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Reserved Interactive Requests", ClampMin = "0", UIMin = "0", UIMax = "8"))
+    int32 ReservedInteractiveRequests = 1;
+
+    /**
+     * Hold batch and speculative requests until the time of day is within the window below, such as a provider's
+     * off-peak discount hours or the hours a local GPU box is otherwise idle. Interactive requests are sent at any time
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Background Time Window"))
+    bool bUseBackgroundWindow = false;
+
+    /** Hour the background window opens, fractions for minutes (16.5 is 16:30). A window may span midnight */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Window Start Hour", ClampMin = "0", ClampMax = "24", UIMin = "0", UIMax = "24", EditCondition = "bUseBackgroundWindow"))
+    float BackgroundWindowStartHour = 0.0f;
+
+    /** Hour the background window closes. Requests in flight by then finish, and the rest wait for the next window */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Window End Hour", ClampMin = "0", ClampMax = "24", UIMin = "0", UIMax = "24", EditCondition = "bUseBackgroundWindow"))
+    float BackgroundWindowEndHour = 8.0f;
+
+    /** Read the window's hours in UTC, as providers publish discount hours, rather than local time */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Window In UTC", EditCondition = "bUseBackgroundWindow"))
+    bool bBackgroundWindowInUtc = false;
+
+    /** Times a request is resent after a rate limit, overload or connection failure before the error is reported */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Max Retries", ClampMin = "0", UIMin = "0", UIMax = "10"))
+    int32 MaxRetries = 3;
+
+    /** Backoff before the first retry when the provider does not say how long to wait; doubled on each retry */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Initial Retry Delay (Seconds)", ClampMin = "0.1", UIMin = "0.1"))
+    float InitialRetryDelaySeconds = 2.0f;
+
+    /** Upper bound for the exponential backoff. Retry-After sent by the provider is honored even when longer */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Max Retry Delay (Seconds)", ClampMin = "0.1", UIMin = "0.1"))
+    float MaxRetryDelaySeconds = 60.0f;
+
+    /**
+     * Gzip request bodies larger than 64 KB and send them with Content-Encoding: gzip. Only enable this for
+     * endpoints that accept compressed bodies, such as self-hosted OpenAI-compatible gateways
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM Integration",
+        meta = (DisplayName = "Compress Request Bodies"))
+    bool bCompressRequestBody = false;
+
+    FN2CProviderRequestLimits() {}
+    FN2CProviderRequestLimits(int32 InMaxConcurrent, float InRequestsPerMinute, int32 InBurstSize)
+        : MaxConcurrentRequests(InMaxConcurrent), RequestsPerMinute(InRequestsPerMinute), BurstSize(InBurstSize) {}
 };
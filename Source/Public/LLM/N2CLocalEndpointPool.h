@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "LLM/N2CLLMTypes.h"
+
+/** A server in a local provider's pool */
+struct FN2CPooledEndpoint
+{
+    /** Full URL requests are posted to */
+    FString RequestUrl;
+
+    /** URL probed with a GET to tell whether the server is up */
+    FString HealthUrl;
+
+    /** Requests the server handles at once */
+    int32 MaxConcurrentRequests = 1;
+};
+
+/**
+ * @class FN2CLocalEndpointPool
+ * @brief Balances a local provider's requests across several servers
+ *
+ * Each request goes to the healthy server with the fewest outstanding requests relative to its
+ * concurrency limit. A server whose request fails is taken out of rotation and probed on its health
+ * URL until it answers again. The scheduler sizes the provider's concurrency to the pool's healthy
+ * capacity, so a batch fans out over every server. Providers with a single endpoint are not pooled.
+ * Game thread only.
+ */
+class FN2CLocalEndpointPool
+{
+public:
+    /** Get the singleton instance */
+    static FN2CLocalEndpointPool& Get();
+
+    /** Replace a provider's servers, keeping the load and health of ones that remain. New servers are probed */
+    void SetEndpoints(EN2CLLMProvider Provider, const TArray<FN2CPooledEndpoint>& Endpoints);
+
+    /**
+     * Reserve a slot on the least loaded healthy server. Returns false if the provider is not pooled.
+     * Every successful acquire must be matched by a ReleaseEndpoint
+     */
+    bool AcquireEndpoint(EN2CLLMProvider Provider, FString& OutRequestUrl);
+
+    /** Free a slot taken by AcquireEndpoint. A failed request takes the server out of rotation */
+    void ReleaseEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl, bool bSucceeded);
+
+    /** Requests the provider's healthy servers can handle at once, or 0 if the provider is not pooled */
+    int32 GetCapacity(EN2CLLMProvider Provider) const;
+
+private:
+    /** Private constructor for singleton */
+    FN2CLocalEndpointPool() = default;
+
+    /** Load and health of a single server */
+    struct FEndpointState
+    {
+        FN2CPooledEndpoint Endpoint;
+
+        /** Requests sent to the server and not yet finished */
+        int32 Outstanding = 0;
+
+        /** Servers are assumed up until a request or probe fails */
+        bool bHealthy = true;
+
+        /** Whether a health probe is in flight */
+        bool bProbing = false;
+    };
+
+    /** Send a health probe to a server */
+    void ProbeEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl);
+
+    /** Probe every unhealthy server while any remain */
+    bool TickHealthChecks(float DeltaTime);
+
+    /** Start the health check ticker if it is not running */
+    void StartHealthChecks();
+
+    FEndpointState* FindEndpoint(EN2CLLMProvider Provider, const FString& RequestUrl);
+
+    /** Servers of each pooled provider */
+    TMap<EN2CLLMProvider, TArray<FEndpointState>> Pools;
+
+    /** Ticker probing unhealthy servers */
+    FTSTicker::FDelegateHandle HealthCheckHandle;
+};
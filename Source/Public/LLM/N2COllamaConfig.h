@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "LLM/N2CLLMTypes.h"
 #include "N2COllamaConfig.generated.h"
 
 /**
@@ -20,6 +21,12 @@ struct FN2COllamaConfig
 			  ToolTip="The base endpoint to use for the Ollama API. Defaults to http:localhost:11434"))
 	FString OllamaEndpoint = "http://localhost:11434";
 
+    /** Further Ollama servers to balance requests across together with the main endpoint */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General",
+        meta=(DisplayName="Additional Endpoints",
+              ToolTip="Further Ollama servers serving the same model. Requests go to the healthy server with the fewest outstanding requests. The main endpoint handles as many requests at once as the Ollama request limits allow."))
+    TArray<FN2CLocalEndpoint> AdditionalEndpoints;
+
     /** Whether to use system prompts with Ollama models */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General",
         meta=(DisplayName="Use System Prompts", 
@@ -39,6 +46,12 @@ struct FN2COllamaConfig
               ClampMin="-1"))
     int32 KeepAlive = 3600;
 
+    /** Load the model ahead of translations */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "General",
+        meta=(DisplayName="Preload Model",
+              ToolTip="Load the model on every server when the Node to Code window opens or a translation starts, and keep it loaded while translations run, so the first request does not wait for the model to load. Has no effect with a Keep Alive Duration of 0."))
+    bool bPreloadModel = true;
+
     /** Temperature for creative variation */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Generation",
         meta=(DisplayName="Temperature", 
@@ -84,10 +97,26 @@ struct FN2COllamaConfig
     /** Context window size */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Context",
         meta=(DisplayName="Context Window", 
-              ToolTip="Size of the context window in tokens. For Resursive Translation and/or larger blueprint graphs, you'll definitely want this to be 16k-32k+. The higher you can do, the better.",
+              ToolTip="Size of the context window in tokens. For Resursive Translation and/or larger blueprint graphs, you'll definitely want this to be 16k-32k+. The higher you can do, the better. With Auto-Size Context Window, the smallest window a request is given.",
               ClampMin="8192"))
     int32 NumCtx = 8192;
 
+    /** Size the context window to each request */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Context",
+        meta=(DisplayName="Auto-Size Context Window",
+              ToolTip="Give each request a context window sized to its estimated prompt and response, doubling from Context Window up to Max Context Window. Small graphs then allocate a smaller KV cache and prefill faster. Ollama reloads the model when the size changes, so a request stays in the size already loaded while it fits and is not far larger than needed."))
+    bool bAutoSizeContext = true;
+
+    /** Largest context window an auto-sized request is given */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Context",
+        meta=(DisplayName="Max Context Window",
+              ToolTip="Largest context window in tokens a request is given when auto-sizing. Graphs that would not fit are split into several requests.",
+              ClampMin="8192", EditCondition="bAutoSizeContext"))
+    int32 MaxNumCtx = 32768;
+
+    /** Largest context window a request may be given */
+    int32 GetMaxContextWindow() const { return bAutoSizeContext ? FMath::Max(NumCtx, MaxNumCtx) : NumCtx; }
+
     /** Mirostat algorithm version */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Advanced",
         meta=(DisplayName="Mirostat Mode", 
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "IDirectoryWatcher.h"
+
+/**
+ * @class FN2CPromptFileCache
+ * @brief In-memory cache of prompt and reference source files
+ *
+ * Every request used to read the system prompt and all reference source files from disk again.
+ * Files are now read once and kept in memory. The directory of each cached file is watched, and a
+ * file is dropped from the cache as soon as it changes on disk. The generation number advances on
+ * every invalidation, so callers that cache text formatted from these files know when to rebuild it.
+ */
+class FN2CPromptFileCache
+{
+public:
+    /** Get the singleton instance */
+    static FN2CPromptFileCache& Get();
+
+    /** Contents of a file, read from disk only the first time or after it changed. Returns false if it can't be read */
+    bool LoadFile(const FString& FilePath, FString& OutContent);
+
+    /** As LoadFile, sharing the cached text instead of copying it. Null if the file can't be read */
+    TSharedPtr<const FString> LoadShared(const FString& FilePath);
+
+    /**
+     * Read a text file through a memory mapping, decoding UTF-8 straight from the mapped view into the string
+     * instead of from a copy of the file's bytes. The mapping is released before returning, so the file can still
+     * be rewritten. UTF-16 files, and platforms that can't map files, are read by FFileHelper instead
+     */
+    static bool ReadFile(const FString& FilePath, FString& OutContent);
+
+    /** Changes each time cached content is invalidated */
+    uint32 GetGeneration() const;
+
+    /** Drop every cached file */
+    void Invalidate();
+
+    /** Stop watching directories and drop every cached file */
+    void Shutdown();
+
+private:
+    /** Private constructor for singleton */
+    FN2CPromptFileCache() = default;
+
+    /** Watch the directory of a file that was just cached (game thread) */
+    void WatchDirectory(const FString& Directory);
+
+    /** Drop the cached files that changed */
+    void OnDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+    /** Guards the cached files, the watched directories and the generation */
+    mutable FCriticalSection Lock;
+
+    /** File contents by full path, shared with callers so large reference files are not copied per request */
+    TMap<FString, TSharedRef<const FString>> Files;
+
+    /** Watcher handles by watched directory */
+    TMap<FString, FDelegateHandle> WatchedDirectories;
+
+    uint32 Generation = 0;
+};
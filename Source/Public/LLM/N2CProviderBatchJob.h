@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+#include "LLM/N2CLLMTypes.h"
+
+/** One translation request of a provider batch job (see UN2CLLMModule::SubmitBatchJob) */
+struct FN2CBatchJobItem
+{
+    /** Serialized N2C JSON to translate */
+    FString JsonInput;
+
+    /** Name of the batch output folder the translation is saved in, or empty to save it as a single translation */
+    FString BatchName;
+
+    /** Called with the parsed translation once the job has ended */
+    FOnLLMTranslationComplete OnComplete;
+};
+
+/**
+ * @class FN2CProviderBatchJob
+ * @brief A set of requests submitted through a provider's asynchronous batch API
+ *
+ * Anthropic Message Batches and the OpenAI Batch API run large request sets at about half the price
+ * of individual requests, with results promised within 24 hours. The job submits the request bodies
+ * (uploading them as a JSONL file for OpenAI), polls the batch status until it ends, downloads the
+ * results file and hands back each request's response body in the shape the provider's response
+ * parser reads. The owner must keep the job alive until it calls back. Game thread only.
+ */
+class FN2CProviderBatchJob : public TSharedFromThis<FN2CProviderBatchJob>
+{
+public:
+    /** Response body of each request by index, or an empty string for requests that failed */
+    using FOnJobEnded = TFunction<void(const TArray<FString>& ResponseBodies)>;
+
+    /** Whether a provider has a batch API */
+    static bool SupportsProvider(EN2CLLMProvider Provider);
+
+    /** Most requests a single job of the provider may hold */
+    static int32 GetMaxRequests(EN2CLLMProvider Provider);
+
+    /** Largest total request body size in characters a single job of the provider may hold */
+    static int64 GetMaxPayloadSize(EN2CLLMProvider Provider);
+
+    /**
+     * @param InEndpoint The provider's chat endpoint as configured for the service
+     * @param InHeaders Authentication and version headers of the provider's service
+     */
+    FN2CProviderBatchJob(EN2CLLMProvider InProvider, const FString& InEndpoint, const TMap<FString, FString>& InHeaders);
+    ~FN2CProviderBatchJob();
+
+    /** Submit the serialized request bodies. OnEnded is called once, even if submission fails */
+    void Start(TArray<FString>&& RequestBodies, FOnJobEnded&& OnEnded);
+
+    /** Ask the provider to stop the job and fail every request straight away */
+    void Cancel();
+
+    EN2CLLMProvider GetProvider() const { return Provider; }
+
+    /** Number of requests in the job */
+    int32 Num() const { return NumRequests; }
+
+private:
+    /** Upload the JSONL request file for an OpenAI batch */
+    void UploadInputFile(const FString& Jsonl);
+
+    /** Create the provider batch from the request lines or the uploaded file */
+    void CreateBatch(const FString& Body);
+
+    /** Request the batch status, and the results once it has ended */
+    void PollStatus();
+    bool TickPoll(float DeltaTime);
+
+    /** Download and split the results file */
+    void DownloadResults(const FString& Url);
+    void ParseResults(const FString& Jsonl);
+
+    /** Ask the provider to stop the batch */
+    void SendCancel() const;
+
+    /** End the job, failing every request without a result */
+    void Finish();
+
+    /** Log the reason and end the job */
+    void Fail(const FString& Reason);
+
+    /** Create a request carrying the provider's headers */
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateRequest(const FString& Verb, const FString& Url) const;
+
+    /** Base URL of the provider's batch endpoints, e.g. https://api.openai.com/v1 */
+    FString GetApiBaseUrl() const;
+
+    /** URL of the batch itself once created */
+    FString GetBatchUrl() const;
+
+    static FString MakeCustomId(int32 Index);
+
+    EN2CLLMProvider Provider;
+    FString Endpoint;
+    TMap<FString, FString> Headers;
+
+    int32 NumRequests = 0;
+    FOnJobEnded OnJobEnded;
+
+    /** Provider's id of the batch, once created */
+    FString BatchId;
+
+    /** Response body of each request, filled in from the results file */
+    TArray<FString> Results;
+
+    /** Ticker waiting for the next status poll */
+    FTSTicker::FDelegateHandle PollHandle;
+
+    /** Status polls that have failed in a row */
+    int32 PollFailures = 0;
+
+    bool bCancelled = false;
+    bool bFinished = false;
+};
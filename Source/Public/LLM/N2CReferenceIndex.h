@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+#include "LLM/N2CLLMTypes.h"
+
+/**
+ * @class FN2CReferenceIndex
+ * @brief BM25 index over reference source files split into chunks per type and function
+ *
+ * Files are split at their top-level declarations, and class bodies too long to send whole are split again
+ * between members. Each chunk is indexed by its identifiers, with Unreal type prefixes stripped and camel-case
+ * words added as extra terms. The index is built on a background task and saved under Saved/NodeToCode, and
+ * only files whose size or time stamp changed are chunked again. Until it matches the current reference files
+ * the caller sends whole files instead.
+ */
+class FN2CReferenceIndex
+{
+public:
+    /** Get the singleton instance */
+    static FN2CReferenceIndex& Get();
+
+    /**
+     * Format the best chunks for the graph symbols, within MaxChunks and TokenBudget, by file and in source order.
+     * Returns false, and starts bringing the index up to date, if it was not built for FilePaths at Generation
+     */
+    bool Retrieve(
+        const TArray<FString>& FilePaths,
+        uint32 Generation,
+        const TSet<FString>& Symbols,
+        int32 MaxChunks,
+        int32 TokenBudget,
+        EN2CLLMProvider Provider,
+        FString& OutBlock);
+
+    /** Start bringing the index up to date for FilePaths in the background, unless a build is already running */
+    void Update(const TArray<FString>& FilePaths, uint32 Generation);
+
+    /** Wait for a running build */
+    void Shutdown();
+
+private:
+    /** Private constructor for singleton */
+    FN2CReferenceIndex() = default;
+
+    struct FChunk
+    {
+        /** 1-based first and last line in the file */
+        int32 StartLine = 0;
+        int32 EndLine = 0;
+        FString Text;
+
+        /** Distinct terms and how often each occurs */
+        TArray<FString> Terms;
+        TArray<int32> Counts;
+
+        /** Total number of terms */
+        int32 Length = 0;
+    };
+
+    struct FIndexedFile
+    {
+        FString Path;
+        int64 Size = 0;
+        FDateTime TimeStamp;
+        TArray<FChunk> Chunks;
+    };
+
+    struct FPosting
+    {
+        int32 Chunk = 0;
+        int32 Count = 0;
+    };
+
+    /** A built index, never changed once published */
+    struct FIndexState
+    {
+        TArray<FString> FilePaths;
+        uint32 Generation = 0;
+        TArray<FIndexedFile> Files;
+
+        /** File and chunk index of every chunk, in file order */
+        TArray<TPair<int32, int32>> Chunks;
+        TMap<FString, TArray<FPosting>> Postings;
+        double AverageLength = 0.0;
+    };
+
+    friend FArchive& operator<<(FArchive& Ar, FChunk& Chunk);
+    friend FArchive& operator<<(FArchive& Ar, FIndexedFile& File);
+
+    /** Chunk and index the files in FilePaths, reusing the unchanged files of Previous. Runs on the background task */
+    static TSharedRef<const FIndexState> Build(const TArray<FString>& FilePaths, uint32 Generation, const TArray<FIndexedFile>& Previous, bool& bOutChanged);
+
+    /** Split a source file into chunks with their terms */
+    static void ChunkFile(const FString& Content, TArray<FChunk>& OutChunks);
+
+    /** Files saved by an earlier session, keyed by path */
+    static void LoadSavedFiles(TArray<FIndexedFile>& OutFiles);
+    static void SaveFiles(const TArray<FIndexedFile>& Files);
+
+    /** Where the index is saved */
+    static FString GetIndexPath();
+
+    /** Guards the published state and the build task */
+    FCriticalSection Lock;
+
+    TSharedPtr<const FIndexState> State;
+    UE::Tasks::FTask BuildTask;
+
+    /** Whether the saved index was read yet */
+    bool bLoadedSaved = false;
+};
@@ -0,0 +1,190 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLM/N2CLLMTypes.h"
+#include "N2CRequestMetrics.generated.h"
+
+/**
+ * @struct FN2CRequestMetrics
+ * @brief Timings, token usage and cost of one request sent to a provider. Times that are unknown are -1
+ */
+USTRUCT(BlueprintType)
+struct FN2CRequestMetrics
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    EN2CLLMProvider Provider = EN2CLLMProvider::Anthropic;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    FString Model;
+
+    /** When the request was queued, UTC */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    FDateTime QueuedAt;
+
+    /** Seconds spent queued behind the provider's concurrency and rate limits */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float QueueWaitSeconds = -1.0f;
+
+    /** Seconds spent building the request body */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float SerializeSeconds = -1.0f;
+
+    /** Seconds from sending the request until its body was uploaded */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float UploadSeconds = -1.0f;
+
+    /** Seconds from sending the request until the first response byte */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float TimeToFirstByteSeconds = -1.0f;
+
+    /** Seconds from leaving the queue until the response was parsed, retries included */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float TotalSeconds = -1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 InputTokens = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 OutputTokens = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 CachedInputTokens = 0;
+
+    /** Cost in USD at the configured prices of the model */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float Cost = 0.0f;
+
+    /** Whether the response parsed into a translation */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    bool bSucceeded = false;
+};
+
+/**
+ * @struct FN2CMetricsSummary
+ * @brief Latency, throughput, tokens and cost of the requests sent to one provider and model
+ */
+USTRUCT(BlueprintType)
+struct FN2CMetricsSummary
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    EN2CLLMProvider Provider = EN2CLLMProvider::Anthropic;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    FString Model;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 Requests = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 Failures = 0;
+
+    /** Total seconds of successful requests; -1 if none are known */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float P50TotalSeconds = -1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float P95TotalSeconds = -1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float P50TimeToFirstByteSeconds = -1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float P95TimeToFirstByteSeconds = -1.0f;
+
+    /** Output tokens per second of streaming the answer, after its first byte */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float OutputTokensPerSecond = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int64 InputTokens = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int64 CachedInputTokens = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int64 OutputTokens = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    float Cost = 0.0f;
+};
+
+/**
+ * @struct FN2CMetricsDashboard
+ * @brief Live queue state and the request metrics of the current batch and the session
+ */
+USTRUCT(BlueprintType)
+struct FN2CMetricsDashboard
+{
+    GENERATED_BODY()
+
+    /** Requests waiting for a provider slot */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 QueuedRequests = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 InFlightRequests = 0;
+
+    /** Translations served from the translation cache instead of a request */
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 BatchCacheHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    int32 SessionCacheHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    TArray<FN2CMetricsSummary> Batch;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Node to Code | Request Metrics")
+    TArray<FN2CMetricsSummary> Session;
+};
+
+/**
+ * @class FN2CRequestMetricsCollector
+ * @brief Keeps the metrics of recent requests and writes them out for comparison
+ *
+ * Only the newest MaxRecords requests are kept. Exports are CSV with one row per request, or JSON with
+ * the requests and a summary per provider and model: p50/p95 latency, time to first byte, output
+ * tokens per second and total cost.
+ */
+class FN2CRequestMetricsCollector
+{
+public:
+    static constexpr int32 MaxRecords = 2000;
+
+    /** Add the metrics of a finished request */
+    void Record(FN2CRequestMetrics&& Metrics);
+
+    /** Metrics of the kept requests, oldest first */
+    const TArray<FN2CRequestMetrics>& GetMetrics() const { return Records; }
+
+    /** Requests recorded since the collector was created, including ones no longer kept */
+    int64 GetTotalRecorded() const { return TotalRecorded; }
+
+    /** The kept requests recorded after GetTotalRecorded returned FirstRecorded */
+    TArray<FN2CRequestMetrics> GetMetricsSince(int64 FirstRecorded) const;
+
+    /** Count a translation served from the translation cache */
+    void RecordCacheHit() { ++CacheHits; }
+
+    /** Translations served from the cache since the collector was created */
+    int32 GetCacheHits() const { return CacheHits; }
+
+    void Reset();
+
+    /** Summary per provider and model, in the order each was first used */
+    static TArray<FN2CMetricsSummary> Summarize(TConstArrayView<FN2CRequestMetrics> Metrics);
+
+    static FString ToCsv(TConstArrayView<FN2CRequestMetrics> Metrics);
+    static FString ToJson(TConstArrayView<FN2CRequestMetrics> Metrics);
+
+private:
+    TArray<FN2CRequestMetrics> Records;
+    int64 TotalRecorded = 0;
+    int32 CacheHits = 0;
+};
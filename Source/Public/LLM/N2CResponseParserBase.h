@@ -7,6 +7,85 @@
 #include "Dom/JsonObject.h"
 #include "N2CResponseParserBase.generated.h"
 
+/**
+ * @struct FN2CLLMStreamState
+ * @brief Incremental decoding state for a single streamed (SSE or NDJSON) response
+ */
+struct FN2CLLMStreamState
+{
+    /** Trailing text of an event line that has not been terminated yet */
+    FString PendingLine;
+
+    /** Message content accumulated from all decoded events */
+    FString Content;
+
+    /** Token usage reported by the stream */
+    FN2CTranslationUsage Usage = FN2CTranslationUsage();
+
+    /** Error reported by the stream, if any */
+    FString ErrorMessage;
+};
+
+/**
+ * @class FN2CPartialTranslationParser
+ * @brief Incremental, tolerant reader of translation JSON that is still streaming in
+ *
+ * Fed each piece of message content once, it tracks just enough structure (nesting, keys and string
+ * escapes) to decode the code fields of the graph currently being written, so a long response costs
+ * O(n) overall instead of re-reading everything received on every chunk. The field being written is
+ * exposed before its closing quote arrives. It does not validate; the complete response is still
+ * parsed normally once it has arrived.
+ */
+class NODETOCODE_API FN2CPartialTranslationParser
+{
+public:
+    /** Decode newly received content. Returns true when a code field of the current graph changed */
+    bool Feed(FStringView Text);
+
+    /** Characters of content decoded so far, so callers holding the whole content can feed just the rest */
+    int32 GetConsumedLength() const { return ConsumedLength; }
+
+    /** Code of the graph currently being written: finished fields and the one still arriving */
+    const FN2CGeneratedCode& GetCode() const { return Code; }
+
+    /** Index in the graphs array of the graph currently being written, or INDEX_NONE before the first */
+    int32 GetGraphIndex() const { return GraphIndex; }
+
+private:
+    /** Start decoding the string that begins after an opening quote */
+    void BeginString();
+
+    /** Decode one character of the open string */
+    bool AppendStringChar(TCHAR Char);
+
+    /** Code field the open string value is written into, if any */
+    FString* TargetField = nullptr;
+
+    /** Open objects and arrays, '{' or '[' */
+    TArray<TCHAR, TInlineAllocator<16>> Containers;
+
+    /** Depth of the graphs array once opened, each object directly inside it is a graph */
+    int32 GraphsDepth = INDEX_NONE;
+
+    /** Nothing but whitespace seen since the last '{' or ',' of an object, so the next string is a key */
+    bool bExpectKey = false;
+
+    bool bInString = false;
+    bool bStringIsKey = false;
+    bool bEscape = false;
+
+    /** Code unit of a unicode escape, whose hex digits may arrive split across chunks */
+    uint32 UnicodeValue = 0;
+    int32 NumUnicodeDigits = INDEX_NONE;
+
+    FString Key;
+    FString LastKey;
+
+    FN2CGeneratedCode Code;
+    int32 GraphIndex = INDEX_NONE;
+    int32 ConsumedLength = 0;
+};
+
 /**
  * @class UN2CResponseParserBase
  * @brief Base class for parsing LLM responses into translation structs
@@ -42,25 +121,58 @@ public:
         const FString& ContentFieldName,
         FString& OutContent);
 
+    /** Whether a response body is a stream of events (SSE or NDJSON) rather than a single JSON document */
+    virtual bool IsStreamedResponse(const FString& Body) const;
+
+    /** Whether a response, streamed or not, stopped because it reached the request's token limit */
+    virtual bool IsTruncatedResponse(const FString& Response) const;
+
+    /** Decode newly received stream text, appending message content and usage to the state */
+    void ConsumeStreamChunk(FN2CLLMStreamState& State, const FString& Chunk) const;
+
+    /** Parse a complete streamed response body into translation structs */
+    bool ParseStreamedResponse(const FString& StreamBody, FN2CTranslationResponse& OutResponse);
+
+    /** Locate the translation JSON in message content, skipping whitespace, <think> blocks, ```json fences and prose around them, without copying */
+    static FStringView FindJsonContent(FStringView Content);
+
+    /**
+     * Repair the slips models make without structured output: prose or fences around the object, trailing
+     * commas and raw control characters in strings. Returns false if there was nothing to repair
+     */
+    static bool RepairJson(FStringView Json, FString& OutRepaired);
+
 protected:
+    /** Parse translation JSON (the graphs object) into translation structs */
+    bool ParseTranslationJson(FStringView Json, FN2CTranslationResponse& OutResponse);
+
+    /** Decode one stream event. The default handles OpenAI-compatible chat completion chunks */
+    virtual void ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const;
+
+    /** Clean up accumulated streamed content before it is parsed */
+    virtual void FinalizeStreamedContent(FString& Content);
+
+    /** Whether a JSON body or event stream holds "Field": "Value" outside of any string value */
+    static bool HasStringField(FStringView Body, FStringView Field, FStringView Value);
+
+    /** Read usage.prompt_tokens_details.cached_tokens from an OpenAI-compatible usage object */
+    static int32 GetOpenAICachedTokens(const TSharedPtr<FJsonObject>& UsageObject);
+
     /** Remove newlines from string */
     FString RemoveNewlines(const FString& Input) const;
 
     /** Validate response format */
     bool ValidateResponseFormat(const TSharedPtr<FJsonObject>& JsonObject) const;
 
-    /** Extract graph data from JSON */
+    /** Extract graph data from JSON, in the standard shape or the compact one with short keys and no code object */
     void ExtractGraphData(
         const TSharedPtr<FJsonObject>& GraphObject,
         FN2CGraphTranslation& OutGraph
     );
 
-    /** Extract code data from JSON */
+    /** Extract code data from a code object, or from a compact graph object, leaving skipped sections empty */
     void ExtractCodeData(
         const TSharedPtr<FJsonObject>& CodeObject,
         FN2CGeneratedCode& OutCode
     );
-    
-    /** Process JSON content with code block markers */
-    bool ProcessJsonContentWithMarkers(FString& Content);
 };
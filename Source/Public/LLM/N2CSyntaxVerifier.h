@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "HAL/CriticalSection.h"
+
+struct FN2CTranslationResponse;
+
+/**
+ * @class FN2CSyntaxVerifier
+ * @brief Checks the syntax of translated code with an external compiler, in the background
+ *
+ * Each graph's C++ goes through clang -fsyntax-only and its Python through py_compile, as separate processes
+ * run on worker tasks, at most MaxConcurrentSyntaxChecks at a time; further translations wait their turn. The
+ * graph code is compiled outside its class, so only parse errors count against it; unknown names and other
+ * semantic errors are expected. A compiler that cannot be started passes every check, with a warning once.
+ * Languages without a checker always pass.
+ */
+class FN2CSyntaxVerifier
+{
+public:
+    /** Get the singleton instance */
+    static FN2CSyntaxVerifier& Get();
+
+    /** Whether syntax verification is enabled and has a checker for Language */
+    static bool IsEnabledFor(EN2CCodeLanguage Language);
+
+    /**
+     * Check every graph of a translation. OnComplete runs on the game thread with whether all of them passed
+     * and, if not, the diagnostics of those that failed, headed by their graph names
+     */
+    void Verify(const FN2CTranslationResponse& Response, EN2CCodeLanguage Language, TFunction<void(bool, const FString&)>&& OnComplete);
+
+private:
+    /** Private constructor for singleton */
+    FN2CSyntaxVerifier() = default;
+
+    /** A translation waiting for, or going through, its checks */
+    struct FJob
+    {
+        EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+
+        /** Graph names and the source checked for each */
+        TArray<TPair<FString, FString>> Sources;
+
+        TFunction<void(bool, const FString&)> OnComplete;
+    };
+
+    /** Start queued jobs while fewer than the allowed number run */
+    void StartJobs();
+
+    /** Check every source of a job (worker task). Returns the diagnostics of those that failed */
+    FString RunJob(const FJob& Job);
+
+    /** Compile one source with the language's checker (worker task). Returns false with its diagnostics on a parse error */
+    bool CheckSource(EN2CCodeLanguage Language, const FString& Source, FString& OutDiagnostics);
+
+    /** Guards the queue, the running count and the missing compiler warnings */
+    FCriticalSection Lock;
+
+    TArray<FJob> Queue;
+    int32 RunningJobs = 0;
+
+    /** Compilers that could not be started, warned about once */
+    TSet<FString> MissingCompilers;
+};
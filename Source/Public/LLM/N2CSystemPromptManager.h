@@ -35,18 +35,24 @@ public:
     /** Prepend reference source files to user message */                                                                                                                                                 
     bool PrependSourceFilesToUserMessage(FString& UserMessage) const; 
 
+    /** Build the <referenceSourceFiles> block for a user message on its own so it can be sent as a cacheable prefix */
+    bool BuildReferenceSourceFilesBlock(const FString& UserMessage, FString& OutBlock) const;
+
     /** Initialize with configuration */
     void Initialize(const FN2CLLMConfig& Config);
 
+    /** Leave reference source files out of the messages formatted while set, as for provider probes */
+    bool bOmitReferenceFiles = false;
+
 private:
-    /** Load prompts from configuration */
-    void LoadPrompts();
+    /** Look up a prompt in the module-wide store, loading its file on first use. Returns false if there is none */
+    bool FindPrompt(const FString& PromptKey, FString& OutPrompt) const;
 
-    /** Load prompt from file */
-    bool LoadPromptFromFile(const FString& FilePath, FString& OutContent);
+    /** Locate the plugin's prompt directory */
+    static FString FindPromptsDirectory();
 
-    /** Get prompt file path */
-    FString GetPromptFilePath(const FString& PromptKey) const;
+    /** Load prompt from file */
+    bool LoadPromptFromFile(const FString& FilePath, FString& OutContent) const;
 
     /** Load and format reference source files */
     FString LoadReferenceSourceFiles() const;
@@ -56,10 +62,4 @@ private:
 
     /** Get language-specific prompt key */
     FString GetLanguagePromptKey(const FString& BasePromptKey, EN2CCodeLanguage Language) const;
-
-    /** Map of loaded prompts */
-    TMap<FString, FString> LoadedPrompts;
-
-    /** Base directory for prompt files */
-    FString PromptsDirectory;
 };
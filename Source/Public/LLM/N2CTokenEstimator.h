@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLM/N2CLLMTypes.h"
+
+class UN2CSettings;
+
+/**
+ * @enum EN2CTokenizerFamily
+ * @brief Tokenizer behaviour shared by a group of models, used to pick estimation ratios
+ */
+enum class EN2CTokenizerFamily : uint8
+{
+    /** Byte-level BPE with large vocabularies (OpenAI, DeepSeek) */
+    OpenAI,
+    Anthropic,
+    /** SentencePiece, single-digit number tokens */
+    Gemini,
+    /** Llama-style BPE used by most local models */
+    Llama
+};
+
+/**
+ * @class FN2CTokenEstimator
+ * @brief Approximate input token counts without a provider round trip
+ *
+ * Walks the text once and prices each run the way BPE tokenizers tend to split it: words by
+ * camel-case segment and length, digits in groups, punctuation in short runs, and whitespace folded
+ * into the following word. Per-family ratios keep estimates within a few percent on N2C JSON,
+ * which is enough to pack requests and catch context overflows before upload. Stateless and safe on
+ * any thread.
+ */
+class FN2CTokenEstimator
+{
+public:
+    /** Tokens reserved for the response when checking a request against the context window */
+    static constexpr int32 OutputTokenReserve = 8192;
+
+    /** Smallest response budget a request is given, enough for the JSON wrapper and notes of a tiny graph */
+    static constexpr int32 MinOutputTokens = 1024;
+
+    /** Tokenizer family of a provider */
+    static EN2CTokenizerFamily GetFamily(EN2CLLMProvider Provider);
+
+    /** Estimated token count of text for a tokenizer family */
+    static int32 EstimateTokens(FStringView Text, EN2CTokenizerFamily Family);
+    static int32 EstimateTokens(FStringView Text, EN2CLLMProvider Provider) { return EstimateTokens(Text, GetFamily(Provider)); }
+
+    /** Context window in tokens of a provider's model, or 0 when unknown */
+    static int32 GetContextWindow(EN2CLLMProvider Provider, const FString& Model, int32 LocalContextWindow = 0);
+
+    /** Context window of the provider and model currently selected in settings, or 0 when unknown */
+    static int32 GetContextWindow(const UN2CSettings& Settings);
+
+    /** Input tokens a request may use under a context window, after the output reserve */
+    static int32 GetInputBudget(int32 ContextWindow);
+
+    /** Response tokens a graph whose JSON is estimated at JsonTokens is expected to need, with headroom, up to Ceiling */
+    static int32 GetOutputBudget(int32 JsonTokens, int32 Ceiling = OutputTokenReserve);
+};
@@ -0,0 +1,35 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @class FN2CTranslationArchive
+ * @brief Single compressed file holding the graph and class folders of a batch translation folder
+ *
+ * A batch with archiving on saves loose files as usual, so an interrupted batch still resumes from them,
+ * and has its subfolders packed into N2C_Output.n2ca once it ends. Each file is compressed on its own with
+ * Oodle, or zlib where Oodle is not available, behind a table of contents at the end of the archive, so a
+ * graph is found by its path in the folder and only its own bytes are read and decompressed when it is
+ * viewed. The top-level batch files (journal, manifest, snapshot, metrics) stay loose. Tables of contents
+ * are cached per archive while its timestamp is unchanged; safe from any thread.
+ */
+class FN2CTranslationArchive
+{
+public:
+    /** Name of the archive in a translation folder */
+    static const TCHAR* GetFileName() { return TEXT("N2C_Output.n2ca"); }
+
+    /**
+     * Pack the files in the subfolders of a translation folder into its archive, merged with any archive already
+     * there, and delete the subfolders once it is saved. Returns false if the archive could not be written
+     */
+    static bool Pack(const FString& RootPath, int32* OutPackedFiles = nullptr);
+
+    /** Read a file from disk, or from the archive of the translation folder it belongs in */
+    static bool LoadFileToString(FString& OutContent, const FString& FilePath);
+
+    /** Paths, relative to a translation folder, of the files in its archive */
+    static void GetArchivedFiles(const FString& RootPath, TArray<FString>& OutRelativePaths);
+};
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "LLM/N2CLLMTypes.h"
+
+/**
+ * @class FN2CTranslationCache
+ * @brief Persistent content-addressed cache of LLM translation responses
+ *
+ * Entries are keyed on a hash of the serialized graph JSON together with everything else that
+ * shapes the request (system prompt, target language, provider, model and reference files).
+ * Each entry stores the provider response that produced a successfully parsed translation, so a
+ * hit can be replayed through the normal response path without an HTTP round trip.
+ *
+ * With bShareTranslationCache, entries are also put in the Derived Data Cache and looked up there after a
+ * local miss, so shared and cloud DDC nodes serve one user's translations to the rest of the team. Keys
+ * hash the reference files by name and content rather than by path and time stamp so they match across
+ * machines.
+ */
+class FN2CTranslationCache
+{
+public:
+    /** Get the singleton instance */
+    static FN2CTranslationCache& Get();
+
+    /** Build the cache key for a translation request */
+    FString MakeKey(
+        const FString& JsonInput,
+        const FString& SystemPrompt,
+        EN2CCodeLanguage Language,
+        EN2CLLMProvider Provider,
+        const FString& Model) const;
+
+    /** Look up a cached response. Returns true and fills OutResponse on a hit */
+    bool Find(const FString& Key, FString& OutResponse);
+
+    /** Whether a response is cached locally for a key, without reading it */
+    bool Contains(const FString& Key) const;
+
+    /**
+     * Look up keys in the Derived Data Cache, asynchronously. OnComplete is called on the game thread with the index
+     * of the first key that hit, or INDEX_NONE, and the response, which is then also cached locally
+     */
+    void FindShared(const TArray<FString>& Keys, TFunction<void(int32 HitIndex, const FString& Response)> OnComplete);
+
+    /** Store a response for a key, in memory, on disk and, when shared, in the Derived Data Cache */
+    void Store(const FString& Key, const FString& Response);
+
+    /** Remove all cached entries from memory and disk. Shared entries stay in the Derived Data Cache */
+    void Clear();
+
+    /** Directory where cache entries are written */
+    static FString GetCacheDirectory();
+
+private:
+    /** Private constructor for singleton */
+    FN2CTranslationCache() = default;
+
+    /** File path for a cache key */
+    static FString GetEntryPath(const FString& Key);
+
+    /** Store a response in memory and on disk only */
+    void StoreLocal(const FString& Key, const FString& Response);
+
+    /** Entries already loaded or written this session */
+    TMap<FString, FString> MemoryCache;
+};
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Code Editor/Models/N2CCodeLanguage.h"
+#include "LLM/N2CLLMTypes.h"
+#include "Tasks/Task.h"
+
+/** Where one language's files of a translated graph were saved */
+struct FN2CTranslationOutput
+{
+    EN2CCodeLanguage Language = EN2CCodeLanguage::Cpp;
+
+    /** Folder under the translation folder holding the graph's folder, empty for the translation folder itself */
+    FString RelativeDir;
+
+    /** Name of the graph's folder and files */
+    FString FileBaseName;
+};
+
+/** A graph saved in a translation folder */
+struct FN2CTranslationRecord
+{
+    FString GraphName;
+
+    /** Fingerprint of the graph as translated, empty until a batch records it as completed */
+    FString Fingerprint;
+
+    EN2CLLMProvider Provider = EN2CLLMProvider::Anthropic;
+    FString Model;
+    FDateTime Time;
+
+    /** Usage of the response the graph came in, which may have held other graphs too */
+    int32 InputTokens = 0;
+    int32 OutputTokens = 0;
+
+    TArray<FN2CTranslationOutput> Outputs;
+
+    /** Output in Language, or null if the graph was not saved in it */
+    const FN2CTranslationOutput* FindOutput(EN2CCodeLanguage Language) const;
+};
+
+/** A translation folder: a batch, or a single translation */
+struct FN2CTranslationRun
+{
+    FString RootPath;
+    FString BlueprintName;
+    FDateTime Time;
+
+    /** Whether the batch ended, rather than being interrupted. Single translations end when saved */
+    bool bEnded = false;
+
+    /**
+     * Whether the run was found on disk when the index was built rather than recorded as it was saved. Its graphs,
+     * fingerprints and whether it ended are then unknown, and are read from the folder's manifest, journal and files
+     */
+    bool bIndexedFromDisk = false;
+
+    /** Graphs by name */
+    TMap<FString, FN2CTranslationRecord> Graphs;
+};
+
+/**
+ * @class FN2CTranslationHistory
+ * @brief Index of the translation folders under the translation base path, by Blueprint and graph
+ *
+ * Updated as translations are saved, so finding a Blueprint's latest batch, the fingerprints it recorded
+ * or the folder holding a graph's previous code is a lookup rather than a scan of the dated folders and a
+ * read of their manifests. The index is saved as a binary table beside the folders whenever a run begins
+ * or ends; a batch interrupted in between still has its journal. Without an index, as on first use or after
+ * a version change, the folders on disk are indexed by name once. Folders deleted since are dropped as
+ * they are looked up. Game thread only, apart from the save.
+ */
+class NODETOCODE_API FN2CTranslationHistory
+{
+public:
+    /** Get the singleton instance */
+    static FN2CTranslationHistory& Get();
+
+    /** Index the folders under BasePath from now on, loading or building its index if it is not the current one */
+    void Open(const FString& BasePath);
+
+    /** Add a translation folder, unless it is indexed already */
+    void BeginRun(const FString& BlueprintName, const FString& RootPath);
+
+    /** Mark a batch as ended */
+    void EndRun(const FString& RootPath);
+
+    /** Add a graph's saved output to a run, keeping the fingerprint and other outputs already recorded for it */
+    void RecordOutput(const FString& RootPath, const FN2CTranslationRecord& Record);
+
+    /** Record a graph of a run as completed with Fingerprint, or as failed if Fingerprint is empty */
+    void RecordFingerprint(const FString& RootPath, const FString& GraphName, const FString& Fingerprint);
+
+    /** Copy the records of graphs carried forward from one run to another */
+    void CarryForward(const FString& FromRootPath, const FString& ToRootPath, const TMap<FString, FString>& Fingerprints);
+
+    /** Runs of a Blueprint, newest first, valid until the history next changes. Runs whose folder no longer exists are dropped */
+    TArray<const FN2CTranslationRun*> GetRuns(const FString& BlueprintName);
+
+    /** Run indexed for a folder, or null */
+    const FN2CTranslationRun* FindRun(const FString& RootPath) const;
+
+    /** Most recent run of any Blueprint, or null */
+    const FN2CTranslationRun* GetLatestRun();
+
+    /** Write the index if it changed, and wait for any save in flight */
+    void Flush();
+
+    /** Name of the index file in the translation base path */
+    static const TCHAR* GetIndexFileName() { return TEXT("N2C_TranslationIndex.bin"); }
+
+private:
+    /** Private constructor for singleton */
+    FN2CTranslationHistory() = default;
+
+    /** Index the dated folders under BasePath by name, as runs whose contents are read from disk */
+    void BuildFromDisk();
+
+    /** Write the index in the background if it changed; saves are chained so they land in order */
+    void Save();
+
+    /** Run for a folder, or null */
+    FN2CTranslationRun* FindMutableRun(const FString& RootPath);
+
+    FString BasePath;
+
+    /** Runs by folder, and the folders of each Blueprint's runs by name, newest first */
+    TMap<FString, FN2CTranslationRun> Runs;
+    TMap<FString, TArray<FString>> RunsByBlueprint;
+
+    /** Whether the index changed since it was last saved */
+    bool bDirty = false;
+
+    /** Last save started */
+    UE::Tasks::FTask SaveTask;
+};
@@ -0,0 +1,116 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+
+/**
+ * @class FN2CTranslationOutputWriter
+ * @brief Write-behind queue for translation output files
+ *
+ * Responses save their code, notes and JSON files by queueing them here rather than writing on the
+ * game thread, where a slow or network drive would stall the editor. A single background task
+ * writes the queue in order, creating each directory once and replacing files through a temporary
+ * file and a rename so a reader never sees a half-written file. Appends (the batch journal) keep
+ * their place in the queue, so a journal entry never lands before the files it describes.
+ * A file that already holds the same content is left untouched, timestamp included, so re-translating
+ * unchanged graphs does not trigger IDE reindexing, rebuilds or source control scans.
+ * Archiving a batch folder is queued the same way, so it packs every file written before it.
+ * Flush blocks until everything queued so far is on disk.
+ */
+class FN2CTranslationOutputWriter
+{
+public:
+    /** Get the singleton instance */
+    static FN2CTranslationOutputWriter& Get();
+
+    /** Queue a file to be written, replacing any existing file */
+    void Write(const FString& FilePath, FString&& Content);
+
+    /** Queue text to be appended to a file as UTF-8 */
+    void Append(const FString& FilePath, FString&& Content);
+
+    /** Queue the packing of a batch folder's subfolders into its archive (see FN2CTranslationArchive) */
+    void Archive(const FString& RootPath);
+
+    /** What the writes since the last flush did to the disk */
+    struct FFlushStats
+    {
+        /** Files created, replaced, appended to or archived */
+        int32 WrittenFiles = 0;
+
+        /** Files left as they were because they already held the content */
+        int32 UnchangedFiles = 0;
+    };
+
+    /** Wait for every queued write to finish. Returns false if any write failed since the last flush */
+    bool Flush(FFlushStats* OutStats = nullptr);
+
+private:
+    /** Private constructor for singleton */
+    FN2CTranslationOutputWriter() = default;
+
+    enum class EWriteKind : uint8
+    {
+        Replace,
+        Append,
+        Archive
+    };
+
+    struct FPendingWrite
+    {
+        /** File to write, or the folder to archive */
+        FString FilePath;
+        FString Content;
+        EWriteKind Kind = EWriteKind::Replace;
+    };
+
+    void Enqueue(FPendingWrite&& PendingWrite);
+
+    /** Write queued files until the queue is empty (background task) */
+    void DrainQueue();
+
+    enum class EWriteResult : uint8
+    {
+        Written,
+        Unchanged,
+        Failed
+    };
+
+    /** Write a single file, creating its directory if needed (background task) */
+    EWriteResult WriteFile(const FPendingWrite& PendingWrite);
+
+    /** Whether the file at FilePath already holds Bytes, going by size and content hash (background task) */
+    bool IsUnchanged(const FString& FilePath, const TArray<uint8>& Bytes, uint64 Hash);
+
+    /** Guards the queue, the worker state and the failure count */
+    FCriticalSection Lock;
+
+    TArray<FPendingWrite> Queue;
+
+    /** Task draining the queue, valid while bWorkerRunning */
+    UE::Tasks::FTask Worker;
+    bool bWorkerRunning = false;
+
+    /** Writes that failed since the last flush */
+    int32 FailedWrites = 0;
+
+    /** Counts of the writes completed since the last flush */
+    FFlushStats Stats;
+
+    /** Size, content hash and timestamp of files written or checked, so an unchanged file is not read again */
+    struct FKnownFile
+    {
+        int64 Size = 0;
+        uint64 Hash = 0;
+        FDateTime TimeStamp;
+    };
+
+    /** Touched only by the worker; an entry is trusted only while the file's size and timestamp still match */
+    TMap<FString, FKnownFile> KnownFiles;
+
+    /** Directories known to exist, touched only by the worker and reset on flush */
+    TSet<FString> CreatedDirectories;
+};
@@ -21,9 +21,15 @@ public:
         const FString& InJson,
         FN2CTranslationResponse& OutResponse) override;
 
+    /** Whether the response stopped with stop_reason max_tokens */
+    virtual bool IsTruncatedResponse(const FString& Response) const override;
+
 protected:
     /** Extract message content from Anthropic's unique response format */
     bool ExtractAnthropicMessageContent(
         const TSharedPtr<FJsonObject>& JsonObject,
         FString& OutContent);
+
+    /** Decode Anthropic message stream events (content_block_delta, message_start, message_delta) */
+    virtual void ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const override;
 };
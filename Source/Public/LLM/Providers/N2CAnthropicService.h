@@ -27,7 +27,7 @@ public:
 
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
     virtual FString GetDefaultEndpoint() const override { return TEXT("https://api.anthropic.com/v1/messages"); }
 
@@ -27,7 +27,9 @@ public:
 
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
+    virtual int32 GetOutputTokenCeiling() const override { return 8000; }
+    virtual bool UsesReasoningTokens() const override { return Config.Model == TEXT("deepseek-reasoner"); }
     virtual FString GetDefaultEndpoint() const override { return TEXT("https://api.deepseek.com/chat/completions"); }
 };
@@ -21,9 +21,15 @@ public:
         const FString& InJson,
         FN2CTranslationResponse& OutResponse) override;
 
+    /** Whether the response stopped with finishReason MAX_TOKENS */
+    virtual bool IsTruncatedResponse(const FString& Response) const override;
+
 protected:
     /** Extract message content from Gemini's unique response format */
     bool ExtractGeminiMessageContent(
         const TSharedPtr<FJsonObject>& JsonObject,
         FString& OutContent);
+
+    /** Decode a streamed GenerateContentResponse chunk */
+    virtual void ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const override;
 };
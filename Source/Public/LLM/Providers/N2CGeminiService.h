@@ -24,10 +24,40 @@ public:
     virtual void GetConfiguration(FString& OutEndpoint, FString& OutAuthToken, bool& OutSupportsSystemPrompts) override;
     virtual EN2CLLMProvider GetProviderType() const override { return EN2CLLMProvider::Gemini; }
     virtual void GetProviderHeaders(TMap<FString, FString>& OutHeaders) const override;
+    virtual void SendStreamingRequest(const FString& JsonPayload, const FString& SystemMessage,
+                           const FOnLLMStreamChunkReceived& OnPartialContent,
+                           const FOnLLMResponseReceived& OnComplete,
+                           const TSharedPtr<FN2CHttpRequestHandle>& Handle = nullptr) override;
 
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
+    virtual bool UsesReasoningTokens() const override;
     virtual FString GetDefaultEndpoint() const override { return TEXT("https://generativelanguage.googleapis.com/v1beta/models/"); }
+
+private:
+    /** Create cached content for the system prompt and the user message's reference files if needed, then run OnReady */
+    void EnsureCachedContent(const FString& UserMessage, const FString& SystemMessage, TFunction<void()>&& OnReady);
+
+    /** Identify the stable prefix a cached content entry was created for */
+    FString MakeCachedContentKey(const FString& SystemMessage, const FString& ReferenceFiles) const;
+
+    /** Lifetime requested for cached content */
+    static constexpr int32 CachedContentTtlSeconds = 600;
+
+    /** Name of the cachedContents resource for the current prefix, empty if none */
+    FString CachedContentName;
+
+    /** Prefix key the cached content was created for */
+    FString CachedContentKey;
+
+    /** Prefix key whose cache creation was rejected (e.g. below the minimum size), so it is not retried */
+    FString RejectedCachedContentKey;
+
+    /** Time after which the cached content must be recreated */
+    double CachedContentExpiry = 0.0;
+
+    /** Requests waiting on an in-flight cache creation */
+    TArray<TFunction<void()>> PendingCacheWaiters;
 };
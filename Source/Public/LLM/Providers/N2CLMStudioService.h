@@ -33,7 +33,7 @@ public:
 
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
     virtual FString GetDefaultEndpoint() const override { return TEXT("http://localhost:1234/v1/chat/completions"); }
 
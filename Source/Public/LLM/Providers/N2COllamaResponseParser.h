@@ -21,9 +21,15 @@ public:
         const FString& InJson,
         FN2CTranslationResponse& OutResponse) override;
 
+    /** Whether the response stopped with done_reason length */
+    virtual bool IsTruncatedResponse(const FString& Response) const override;
+
 protected:
     /** Extract message content from Ollama's unique response format */
     bool ExtractOllamaMessageContent(
         const TSharedPtr<FJsonObject>& JsonObject,
         FString& OutContent);
+
+    /** Decode an Ollama NDJSON chat chunk */
+    virtual void ProcessStreamEvent(const TSharedPtr<FJsonObject>& EventObject, FN2CLLMStreamState& State) const override;
 };
@@ -29,13 +29,25 @@ public:
     virtual EN2CLLMProvider GetProviderType() const override { return EN2CLLMProvider::Ollama; }
     virtual void GetProviderHeaders(TMap<FString, FString>& OutHeaders) const override;
 
+    /**
+     * Load the model on every server with a generate that has no prompt, so it produces no tokens but applies
+     * KeepAlive and the context size requests use. Servers preloaded within half the keep-alive are skipped
+     */
+    virtual void WarmUpConnection() const override;
+
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
     virtual FString GetDefaultEndpoint() const override { return TEXT("http://localhost:11434/api/chat"); }
 
 private:
+    /** Context window for a request, doubled from NumCtx until the prompt and expected response fit */
+    int32 GetRequestContextWindow(const FString& UserMessage, const FString& SystemMessage) const;
+
     /** Ollama configuration settings */
     FN2COllamaConfig OllamaConfig;
+
+    /** Base URL of every server requests are balanced across */
+    TArray<FString> ServerUrls;
 };
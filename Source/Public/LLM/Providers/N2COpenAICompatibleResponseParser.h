@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLM/N2CResponseParserBase.h"
+#include "N2COpenAICompatibleResponseParser.generated.h"
+
+/**
+ * @class UN2COpenAICompatibleResponseParser
+ * @brief Parser for chat completion responses from OpenAI-compatible servers
+ *
+ * vLLM and SGLang report how many prompt tokens came from their prefix cache in
+ * usage.prompt_tokens_details.cached_tokens, which is recorded as cached input tokens.
+ */
+UCLASS()
+class NODETOCODE_API UN2COpenAICompatibleResponseParser : public UN2CResponseParserBase
+{
+    GENERATED_BODY()
+
+public:
+    /** Parse an OpenAI-compatible JSON response */
+    virtual bool ParseLLMResponse(
+        const FString& InJson,
+        FN2CTranslationResponse& OutResponse) override;
+};
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LLM/N2CBaseLLMService.h"
+#include "N2COpenAICompatibleResponseParser.h"
+#include "N2COpenAICompatibleService.generated.h"
+
+// Forward declarations
+class UN2CSystemPromptManager;
+
+/**
+ * @class UN2COpenAICompatibleService
+ * @brief Integration with self-hosted servers implementing the OpenAI chat completions API, such as vLLM, TGI and SGLang
+ *
+ * These servers batch requests continuously, so they are sent many at once, and reuse the KV cache of a
+ * prefix they have already seen. The system prompt and the reference source files lead every payload,
+ * unchanged from one request to the next, so only the graph JSON after them has to be processed.
+ */
+UCLASS()
+class NODETOCODE_API UN2COpenAICompatibleService : public UN2CBaseLLMService
+{
+    GENERATED_BODY()
+
+public:
+    // Override Initialize to resolve the server endpoints and streaming setting
+    virtual bool Initialize(const FN2CLLMConfig& InConfig) override;
+
+    // Provider-specific implementations
+    virtual void GetConfiguration(FString& OutEndpoint, FString& OutAuthToken, bool& OutSupportsSystemPrompts) override;
+    virtual EN2CLLMProvider GetProviderType() const override { return EN2CLLMProvider::OpenAICompatible; }
+    virtual void GetProviderHeaders(TMap<FString, FString>& OutHeaders) const override;
+
+protected:
+    // Provider-specific implementations
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual UN2CResponseParserBase* CreateResponseParser() override;
+    virtual FString GetDefaultEndpoint() const override { return TEXT("http://localhost:8000/v1/chat/completions"); }
+};
@@ -27,8 +27,9 @@ public:
 
 protected:
     // Provider-specific implementations
-    virtual FString FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
+    virtual TArray<uint8> FormatRequestPayload(const FString& UserMessage, const FString& SystemMessage) const override;
     virtual UN2CResponseParserBase* CreateResponseParser() override;
+    virtual bool UsesReasoningTokens() const override;
     virtual FString GetDefaultEndpoint() const override { return TEXT("https://api.openai.com/v1/chat/completions"); }
 
 private:
@@ -26,6 +26,12 @@ struct FN2CVersion
     FString Value;
 
     FN2CVersion() : Value(TEXT("1.0.0")) {}
+
+    /** Version written by the compact LLM input dialect, which cannot be read back as N2C JSON */
+    static const TCHAR* CompactValue() { return TEXT("1.1.0-compact"); }
+
+    /** Version written by delta requests, which carry a graph's changes and its previous code instead of the graph */
+    static const TCHAR* DeltaValue() { return TEXT("1.0.0-delta"); }
 };
 
 /**
@@ -72,26 +78,96 @@ struct FN2CMetadata
     FN2CMetadata() : Name(TEXT("")), BlueprintType(EN2CBlueprintType::Normal), BlueprintClass(TEXT("")) {}
 };
 
+/**
+ * @struct FN2CDataFlow
+ * @brief One data connection, from an output pin to the input pin it feeds
+ *
+ * Nodes are indices into the graph's Nodes and pins are indices into the node's pins, inputs first
+ * (see FN2CNodeDefinition::GetPin). The serializer writes them as "N1.P4" references.
+ */
+USTRUCT(BlueprintType)
+struct FN2CDataFlow
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    int32 SourceNode = INDEX_NONE;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    int32 SourcePin = INDEX_NONE;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    int32 TargetNode = INDEX_NONE;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    int32 TargetPin = INDEX_NONE;
+
+    FN2CDataFlow()
+    {
+    }
+
+    FN2CDataFlow(int32 InSourceNode, int32 InSourcePin, int32 InTargetNode, int32 InTargetPin)
+        : SourceNode(InSourceNode)
+        , SourcePin(InSourcePin)
+        , TargetNode(InTargetNode)
+        , TargetPin(InTargetPin)
+    {
+    }
+};
+
 /**
  * @struct FN2CFlows 
  * @brief Contains all execution and data flow connections between nodes
+ *
+ * Flows refer to nodes and pins by index so graph algorithms can walk them directly; the
+ * "N1->N2->N3" and "N1.P4" string forms only exist in serialized JSON.
  */
 USTRUCT(BlueprintType)
 struct FN2CFlows
 {
     GENERATED_BODY()
 
-    /** Execution array. Each entry is a chain like "N1->N2->N3" */
+    /** Node indices of every execution chain, one chain after another. Each node runs before the next one of its chain */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    TArray<int32> ExecutionNodes;
+
+    /** Where each chain begins in ExecutionNodes */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
-    TArray<FString> Execution;
+    TArray<int32> ExecutionChainStarts;
 
-    /** Data connections: a mapping from "N1.P4" to "N2.P3" */
+    /** Data connections, at most one per source pin like the JSON object they are written as */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
-    TMap<FString, FString> Data;
+    TArray<FN2CDataFlow> Data;
 
     FN2CFlows()
     {
     }
+
+    /** Number of execution chains */
+    int32 NumExecutionChains() const { return ExecutionChainStarts.Num(); }
+
+    /** Node indices of one execution chain, in execution order */
+    TConstArrayView<int32> GetExecutionChain(int32 ChainIndex) const
+    {
+        const int32 Start = ExecutionChainStarts[ChainIndex];
+        const int32 End = ChainIndex + 1 < ExecutionChainStarts.Num() ? ExecutionChainStarts[ChainIndex + 1] : ExecutionNodes.Num();
+        return TConstArrayView<int32>(ExecutionNodes.GetData() + Start, End - Start);
+    }
+
+    /** Append an execution chain of node indices */
+    void AddExecutionChain(TConstArrayView<int32> Nodes)
+    {
+        ExecutionChainStarts.Add(ExecutionNodes.Num());
+        ExecutionNodes.Append(Nodes.GetData(), Nodes.Num());
+    }
+
+    /** Remove all flows */
+    void Reset()
+    {
+        ExecutionNodes.Reset();
+        ExecutionChainStarts.Reset();
+        Data.Reset();
+    }
 };
 
 /**
@@ -386,6 +462,41 @@ enum class EN2CGraphType : uint8
     Enum           UMETA(DisplayName = "Enum")
 };
 
+/**
+ * @struct FN2CGraphComplexity
+ * @brief How hard a graph is to translate, measured by FN2CNodeTranslator during extraction
+ *
+ * Cheap enough to compute for every graph, and used to estimate how long its translation takes so the
+ * scheduler can start the longest requests first.
+ */
+struct NODETOCODE_API FN2CGraphComplexity
+{
+    int32 NumNodes = 0;
+
+    /** Branches, switches, selects, sequences, loops and gates */
+    int32 NumFlowControlNodes = 0;
+
+    /** Function, delegate and parent calls */
+    int32 NumCallNodes = 0;
+
+    /** Latent calls, async actions and timelines, whose continuations must be written out */
+    int32 NumLatentNodes = 0;
+
+    int32 NumMacroInstances = 0;
+
+    /** Deepest nesting of macros under the graph, a macro not in the Blueprint counting as one level */
+    int32 MacroDepth = 0;
+
+    /** Most exec links leaving a single node */
+    int32 MaxBranching = 0;
+
+    int32 NumExecLinks = 0;
+    int32 NumDataFlows = 0;
+
+    /** Relative translation effort: one point per node, more for control flow, latent nodes and nested macros */
+    float GetScore() const;
+};
+
 /**
  * @struct FN2CGraph
  * @brief Represents a single graph within the Blueprint
@@ -415,13 +526,50 @@ struct FN2CGraph
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
     TArray<FN2CVariable> LocalVariables;
 
+    /**
+     * Names of the Blueprint variables, components, structs and enums the graph references, recorded by
+     * FN2CNodeTranslator so a request for the graph can carry only that context. Not serialized
+     */
+    TSet<FString> ReferencedNames;
+
+    /** Recorded by FN2CNodeTranslator (see RecordComplexity). Not serialized */
+    FN2CGraphComplexity Complexity;
+
     FN2CGraph()
         : GraphType(EN2CGraphType::EventGraph)
     {
     }
 
-    /** Validates the graph structure */
+    /** Add the member names and pin subtypes of the graph's nodes, and its local variable types, to ReferencedNames */
+    void RecordReferencedNames();
+
+    /** Measure Complexity from the graph's nodes and flows. MacroDepth needs the other graphs and is left as is */
+    void RecordComplexity();
+
+    /** Append a chain as "N1->N2->N3". False, appending nothing, if it refers to a node the graph doesn't have */
+    bool AppendExecutionChain(FString& Out, int32 ChainIndex) const;
+
+    /** Append a data flow end as "N1.P4". False, appending nothing, if the node or pin doesn't exist */
+    bool AppendPinReference(FString& Out, int32 NodeIndex, int32 PinIndex) const;
+
+    /** Validates the graph structure, reusing the last verdict if the graph hasn't been marked modified since */
     bool IsValid() const;
+
+    /** Validates the graph structure like IsValid, returning why it is invalid. Validator's scratch sets are reused if given */
+    bool Validate(FString& OutError, class FN2CBlueprintValidator* Validator = nullptr) const;
+
+    /** Call after changing the graph in place so the next validation runs again */
+    void MarkModified() { ++Generation; }
+
+private:
+    /** Bumped by MarkModified */
+    uint32 Generation = 1;
+
+    /** Generation the cached verdict was computed at; 0 if it never was */
+    mutable uint32 ValidatedGeneration = 0;
+
+    mutable bool bValidatedResult = false;
+    mutable FString ValidationError;
 };
 
 /**
@@ -466,6 +614,31 @@ struct FN2CBlueprint
         // Version is automatically initialized to "1.0.0" by FN2CVersion constructor
     }
 
-    /** Validates the Blueprint structure and its enums */
+    /**
+     * Validates the Blueprint structure and its enums. The verdict is cached, so calling this again
+     * before the Blueprint is marked modified costs nothing
+     */
     bool IsValid() const;
+
+    /** Validates the Blueprint like IsValid, returning why it is invalid */
+    bool Validate(FString& OutError) const;
+
+    /** Validates only one of the graphs, caching the verdict on the graph */
+    bool IsGraphValid(int32 GraphIndex) const;
+
+    /**
+     * Call after changing the Blueprint or any of its graphs in place so the next validation runs again.
+     * Assigning a new Blueprint, or parsing or loading one, resets the cached verdicts already
+     */
+    void MarkModified();
+
+private:
+    /** Bumped by MarkModified */
+    uint32 Generation = 1;
+
+    /** Generation the cached verdict was computed at; 0 if it never was */
+    mutable uint32 ValidatedGeneration = 0;
+
+    mutable bool bValidatedResult = false;
+    mutable FString ValidationError;
 };
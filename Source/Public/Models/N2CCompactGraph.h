@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/N2CBlueprint.h"
+
+/**
+ * @class FN2CStringArena
+ * @brief Append-only buffer of interned strings addressed by index
+ *
+ * Every distinct string is stored once in a single character buffer. Index 0 is always the
+ * empty string. Views returned by Get stay valid until the next Intern call.
+ */
+class NODETOCODE_API FN2CStringArena
+{
+public:
+    FN2CStringArena();
+
+    /** Store a string (or find its existing copy) and return its index */
+    int32 Intern(FStringView Value);
+
+    /** View of an interned string */
+    FStringView Get(int32 Index) const
+    {
+        const FEntry& Entry = Entries[Index];
+        return FStringView(Chars.GetData() + Entry.Offset, Entry.Len);
+    }
+
+    /** Number of distinct strings stored */
+    int32 Num() const { return Entries.Num(); }
+
+    /** Bytes held by the arena */
+    SIZE_T GetAllocatedSize() const;
+
+    /** Remove all strings except the empty string */
+    void Reset();
+
+private:
+    /** Location of a string inside Chars */
+    struct FEntry
+    {
+        int32 Offset = 0;
+        int32 Len = 0;
+    };
+
+    /** Character storage shared by all strings (not null-terminated) */
+    TArray<TCHAR> Chars;
+
+    /** String locations, by index */
+    TArray<FEntry> Entries;
+
+    /** Content hash to string index, for interning */
+    TMultiMap<uint32, int32> Lookup;
+};
+
+/**
+ * @struct FN2CCompactGraph
+ * @brief Transient structure-of-arrays form of an FN2CGraph
+ *
+ * Built for batch exports where many graphs are held at once. All strings live in a shared
+ * FN2CStringArena and are referenced by index, nodes and pins are stored column by column, and
+ * each node's pins are a contiguous range of the pin columns (inputs first, then outputs).
+ * The serializer writes the same "graphs" entry from this form as from the FN2CGraph it came from.
+ */
+struct NODETOCODE_API FN2CCompactGraph
+{
+    /** Pin flag bits stored in PinFlags */
+    enum EPinFlags : uint8
+    {
+        PinConnected = 1 << 0,
+        PinReference = 1 << 1,
+        PinConst     = 1 << 2,
+        PinArray     = 1 << 3,
+        PinMap       = 1 << 4,
+        PinSet       = 1 << 5
+    };
+
+    /** Node flag bits stored in NodeFlags */
+    enum ENodeFlags : uint8
+    {
+        NodePure   = 1 << 0,
+        NodeLatent = 1 << 1
+    };
+
+    /** Graph name (arena index) and type */
+    int32 Name = 0;
+    EN2CGraphType GraphType = EN2CGraphType::EventGraph;
+
+    /** Node columns */
+    TArray<int32> NodeIDs;
+    TArray<EN2CNodeType> NodeTypes;
+    TArray<int32> NodeNames;
+    TArray<int32> NodeMemberParents;
+    TArray<int32> NodeMemberNames;
+    TArray<int32> NodeComments;
+    TArray<uint8> NodeFlags;
+    TArray<int32> NodeFirstPin;
+    TArray<uint16> NodeInputPinCounts;
+    TArray<uint16> NodeOutputPinCounts;
+
+    /** Pin columns */
+    TArray<int32> PinIDs;
+    TArray<int32> PinNames;
+    TArray<EN2CPinType> PinTypes;
+    TArray<int32> PinSubTypes;
+    TArray<int32> PinDefaultValues;
+    TArray<uint8> PinFlags;
+
+    /** Execution and data flows, by node index and pin index within the node like FN2CGraph's */
+    FN2CFlows Flows;
+
+    /** Fill this graph from an FN2CGraph, interning its strings into Arena */
+    void Build(const FN2CGraph& Graph, FN2CStringArena& Arena);
+
+    int32 NumNodes() const { return NodeIDs.Num(); }
+
+    /** Bytes held by the columns (excluding the arena) */
+    SIZE_T GetAllocatedSize() const;
+};
@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/N2CBlueprint.h"
+
+/**
+ * @struct FN2CGraphDelta
+ * @brief What changed between two versions of a graph
+ *
+ * Node IDs are reassigned on every extraction, so nodes are matched by what they are: type, name, member
+ * parent and member name, preferring a node that kept its ID among several candidates. Matched nodes whose
+ * pins, comment or flags differ are changed; the rest are added or removed. Flows are compared per link
+ * after mapping the previous graph's node indices onto the current graph's.
+ */
+struct NODETOCODE_API FN2CGraphDelta
+{
+    /** One exec step, from a node to the node that runs after it */
+    struct FExecLink
+    {
+        int32 From = INDEX_NONE;
+        int32 To = INDEX_NONE;
+
+        bool operator==(const FExecLink& Other) const { return From == Other.From && To == Other.To; }
+        friend uint32 GetTypeHash(const FExecLink& Link) { return HashCombine(::GetTypeHash(Link.From), ::GetTypeHash(Link.To)); }
+    };
+
+    /** Indices into the current graph's nodes */
+    TArray<int32> AddedNodes;
+    TArray<int32> ChangedNodes;
+
+    /** Indices into the previous graph's nodes */
+    TArray<int32> RemovedNodes;
+
+    /** Links and flows only the current graph has, by current node index */
+    TArray<FExecLink> AddedExecLinks;
+    TArray<FN2CDataFlow> AddedDataFlows;
+
+    /** Links and flows only the previous graph had, by previous node index */
+    TArray<FExecLink> RemovedExecLinks;
+    TArray<FN2CDataFlow> RemovedDataFlows;
+
+    /** Current node index of each previous node, or INDEX_NONE if it was removed */
+    TArray<int32> PreviousToCurrent;
+
+    /** Number of nodes in the larger of the two graphs */
+    int32 NumNodes = 0;
+
+    /** Diff two versions of a graph */
+    static FN2CGraphDelta Compute(const FN2CGraph& Previous, const FN2CGraph& Current);
+
+    /** True if the graphs have the same nodes and flows */
+    bool IsEmpty() const
+    {
+        return AddedNodes.Num() == 0 && ChangedNodes.Num() == 0 && RemovedNodes.Num() == 0
+            && AddedExecLinks.Num() == 0 && AddedDataFlows.Num() == 0 && RemovedExecLinks.Num() == 0 && RemovedDataFlows.Num() == 0;
+    }
+
+    /** Share of the graph's nodes that were added, changed or removed */
+    float GetChangedFraction() const
+    {
+        return NumNodes > 0 ? static_cast<float>(AddedNodes.Num() + ChangedNodes.Num() + RemovedNodes.Num()) / NumNodes : 0.0f;
+    }
+};
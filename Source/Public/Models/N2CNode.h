@@ -247,6 +247,22 @@ struct FN2CNodeDefinition
     {
     }
 
+    /** Number of pins, inputs and outputs together */
+    int32 NumPins() const { return InputPins.Num() + OutputPins.Num(); }
+
+    /** Pin by its index over the input pins followed by the output pins, or null if out of range */
+    const FN2CPinDefinition* GetPin(int32 PinIndex) const
+    {
+        if (InputPins.IsValidIndex(PinIndex))
+        {
+            return &InputPins[PinIndex];
+        }
+        return OutputPins.IsValidIndex(PinIndex - InputPins.Num()) ? &OutputPins[PinIndex - InputPins.Num()] : nullptr;
+    }
+
+    /** Index of the pin with this ID as GetPin counts them, or INDEX_NONE */
+    int32 FindPinIndex(FStringView PinID) const;
+
     /** Validates the node definition and its enums */
     bool IsValid() const;
 };
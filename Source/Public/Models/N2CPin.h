@@ -120,6 +120,12 @@ struct FN2CPinDefinition
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
     bool bIsSet = false;
 
+    /** Whether the pin is in the node's collapsed advanced section. Read by FN2CPinPruner, never serialized */
+    bool bAdvancedView = false;
+
+    /** Whether an input pin still holds the default the node gave it rather than one the user set. Read by FN2CPinPruner, never serialized */
+    bool bDefaultValueUnchanged = false;
+
     FN2CPinDefinition()
         : ID(TEXT(""))
         , Name(TEXT(""))
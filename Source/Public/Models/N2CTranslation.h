@@ -21,6 +21,10 @@ struct FN2CTranslationUsage
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
     int32 InputTokens;
+
+    /** Portion of InputTokens served from the provider's prompt cache */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Node to Code")
+    int32 CachedInputTokens = 0;
     
 };
 /**
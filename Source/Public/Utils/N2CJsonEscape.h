@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @struct FN2CJsonEscape
+ * @brief JSON string escaping that skips clean text a machine word at a time
+ *
+ * Reference files, previous code and comments are long and rarely need escaping, so runs with no quote,
+ * backslash or control character are found four UTF-16 units per 64-bit word and appended in bulk.
+ * Escapes match the engine JSON writer.
+ */
+struct NODETOCODE_API FN2CJsonEscape
+{
+    /** Append Value to Out as a quoted, escaped JSON string */
+    static void AppendQuoted(FString& Out, FStringView Value);
+
+    /** Append Value to Out as a quoted, escaped JSON string in UTF-8 */
+    static void AppendQuotedUtf8(TArray<uint8>& Out, FStringView Value);
+
+    /** Append Value to Out escaped for a JSON string in UTF-8, without quotes, so a string can be written in parts */
+    static void AppendEscapedUtf8(TArray<uint8>& Out, FStringView Value);
+
+    /** Number of characters at the start of Chars that need no escaping, and are ASCII if bAsciiOnly */
+    static int32 FindCleanRun(const TCHAR* Chars, int32 Num, bool bAsciiOnly);
+};
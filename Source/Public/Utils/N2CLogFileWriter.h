@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+/**
+ * @class FN2CLogFileWriter
+ * @brief Write-behind appender for the plugin's log file
+ *
+ * Threads logging a line push it onto a lock-free queue and go on. A background task drains the queue,
+ * writing everything queued so far as one UTF-8 block through a file handle that stays open between
+ * batches, so logging costs no file open or close per message. Flush writes what is queued on the
+ * calling thread before returning, for fatal errors and shutdown.
+ */
+class FN2CLogFileWriter
+{
+public:
+    FN2CLogFileWriter() = default;
+    ~FN2CLogFileWriter();
+
+    /** Queue a line to be appended to the log file */
+    void Write(FString&& Line);
+
+    /** Write every queued line and flush the file before returning */
+    void Flush();
+
+    /** Flush and switch to another file. The new one is opened with the next write */
+    void SetFilePath(const FString& Path);
+
+    /** Flush and close the file */
+    void Close();
+
+private:
+    /** Take the writer role, waiting for a running drain to end. Only one thread writes at a time */
+    void Acquire();
+
+    /** Write queued lines until the queue is empty (background task) */
+    void DrainQueue();
+
+    /** Write the queued lines in one block. The caller holds the writer role */
+    void WriteQueued();
+
+    /** Open the file for appending if it isn't open. The caller holds the writer role */
+    bool EnsureFileOpen();
+
+    TQueue<FString, EQueueMode::Mpsc> Queue;
+
+    /** Set while a thread holds the writer role */
+    std::atomic<bool> bWriting{ false };
+
+    /** Open log file, touched only by the writer */
+    TUniquePtr<FArchive> File;
+
+    /** Path of the log file, touched only by the writer */
+    FString FilePath;
+};
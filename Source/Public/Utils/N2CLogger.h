@@ -9,10 +9,29 @@
 
 #include "CoreMinimal.h"
 #include "Models/N2CLogging.h"
+#include "Utils/N2CLogFileWriter.h"
+#include <atomic>
+
+/**
+ * Log a Printf-formatted message, formatting it only if the severity is logged:
+ * N2C_LOG(Debug, TEXT("Node %s has %d pins"), *Name, Num);
+ */
+#define N2C_LOG(Severity, Format, ...) \
+    do \
+    { \
+        if (FN2CLogger::Get().IsEnabled(EN2CLogSeverity::Severity)) \
+        { \
+            FN2CLogger::Get().Log(FString::Printf(Format, ##__VA_ARGS__), EN2CLogSeverity::Severity); \
+        } \
+    } while (false)
 
 /**
  * @class FN2CLogger
  * @brief Central logging system for Node to Code operations
+ *
+ * Safe to use from any thread. A logged entry goes into a buffer of the logging thread's own, and the
+ * buffers are merged into the retained ring buffers in logging order every few entries or when the
+ * entries are read, so worker threads logging at once don't serialize on one lock.
  */
 class FN2CLogger
 {
@@ -33,18 +52,52 @@ public:
     void LogWarning(const FString& Message,
                    const FString& Context = TEXT(""));
 
-    /** Get all logged errors */
-    TArray<FN2CError> GetErrors() const;
+    /**
+     * Log a large payload, such as request JSON or an LLM response, without copying it when Severity
+     * isn't logged. Payloads too long to be worth keeping inline are written to a file of their own
+     * under Saved/NodeToCode/Payloads, and the log gets their path and a short preview
+     */
+    void LogPayload(const FString& Label,
+                    const FString& Payload,
+                    EN2CLogSeverity Severity = EN2CLogSeverity::Debug,
+                    const FString& Context = TEXT(""));
+
+    /** Characters of a payload logged inline. Longer ones go to a file */
+    static constexpr int32 MaxInlinePayloadLength = 1024;
 
-    /** Get errors of specific severity */
-    TArray<FN2CError> GetErrorsBySeverity(EN2CLogSeverity Severity) const;
+    /** Get the retained log entries, oldest first */
+    TArray<FN2CError> GetErrors();
 
-    /** Clear all logged errors */
+    /** Get the retained entries of a specific severity, oldest first */
+    TArray<FN2CError> GetErrorsBySeverity(EN2CLogSeverity Severity);
+
+    /** Clear all retained entries */
     void ClearErrors();
 
+    /**
+     * Set how many entries of a severity are kept in memory. Each severity has its own ring buffer, so
+     * chatty Info and Debug logs can't push out errors; the oldest entry goes once its buffer is full
+     */
+    void SetRetention(EN2CLogSeverity Severity, int32 MaxEntries);
+
+    /** Append entries pushed out of the ring buffers to an archive file instead of dropping them */
+    void EnableArchive(bool bEnable);
+
+    /** Set the archive file path */
+    void SetArchiveFilePath(const FString& Path);
+
+    /** Write queued log file lines and archived entries to disk before returning */
+    void Flush();
+
+    /** Characters of a message kept in memory. Longer ones, like LLM response dumps, are cut */
+    static constexpr int32 MaxRetainedMessageLength = 2048;
+
     /** Set minimum severity level for logging */
     void SetMinSeverity(EN2CLogSeverity Severity);
 
+    /** Whether messages of this severity are currently logged (to skip building expensive messages) */
+    bool IsEnabled(EN2CLogSeverity Severity) const { return Severity >= MinSeverity.load(std::memory_order_relaxed); }
+
     /** Enable/disable file logging */
     void EnableFileLogging(bool bEnable);
 
@@ -82,20 +135,82 @@ private:
     /** Private constructor for singleton */
     FN2CLogger();
 
-    /** Write to log file if enabled */
+    /** Queue a line for the log file if enabled */
     void WriteToFile(const FString& Message);
 
     /** Format error for output */
     FString FormatError(const FN2CError& Error) const;
 
-    /** Collection of logged errors */
-    TArray<FN2CError> LoggedErrors;
+    /** A retained entry, numbered so the ring buffers can be merged back into logging order */
+    struct FRetainedEntry
+    {
+        FN2CError Error;
+        uint64 Sequence = 0;
+    };
+
+    /** Fixed-capacity buffer of the newest entries of one severity */
+    struct FEntryRing
+    {
+        TArray<FRetainedEntry> Entries;
+
+        /** Index of the oldest entry once the buffer is full */
+        int32 Head = 0;
+
+        int32 Capacity = 0;
+    };
+
+    /** Entries of the ring, oldest first */
+    static TArray<const FRetainedEntry*> GetOrderedEntries(const FEntryRing& Ring);
+
+    /** Keep an entry, pushing out the oldest of its severity if the ring is full. LogLock must be held */
+    void RetainEntry(FRetainedEntry&& Entry);
+
+    /** Entries a thread logged that aren't in the rings yet. Each thread appends to its own */
+    struct FThreadBuffer
+    {
+        /** Only contended while the buffers are merged */
+        FCriticalSection Lock;
+        TArray<FRetainedEntry> Entries;
+    };
+
+    /** The calling thread's buffer, registered on its first log */
+    FThreadBuffer& GetThreadBuffer();
+
+    /** Move every thread's buffered entries into the rings in logging order. LogLock must be held */
+    void MergeThreadBuffers();
+
+    /** Entries a thread buffers before it merges them into the rings */
+    static constexpr int32 ThreadBufferMergeCount = 64;
+
+    /** Queue an entry pushed out of a ring for the archive */
+    void ArchiveEntry(const FN2CError& Error);
+
+    /** One ring per severity */
+    FEntryRing Rings[static_cast<int32>(EN2CLogSeverity::Fatal) + 1];
+
+    /** Number given to the next logged entry */
+    std::atomic<uint64> NextSequence{ 0 };
+
+    /** Buffers of every thread that has logged, kept until shutdown */
+    TArray<TSharedRef<FThreadBuffer, ESPMode::ThreadSafe>> ThreadBuffers;
+
+    /** Guards the rings and the buffer list. Logging threads only take it to merge their buffers */
+    FCriticalSection LogLock;
+
+    /** Whether entries pushed out of the rings are archived */
+    std::atomic<bool> bArchiveEnabled;
+
+    /** Appends entries pushed out of the rings to the archive file */
+    FN2CLogFileWriter ArchiveWriter;
+
+    /** Appends lines to the log file off the logging thread */
+    FN2CLogFileWriter FileWriter;
 
     /** Minimum severity level for logging */
-    EN2CLogSeverity MinSeverity;
+    std::atomic<EN2CLogSeverity> MinSeverity;
 
     /** Whether file logging is enabled */
-    bool bFileLoggingEnabled;
+    std::atomic<bool> bFileLoggingEnabled;
 
     /** Path for log file */
     FString LogFilePath;
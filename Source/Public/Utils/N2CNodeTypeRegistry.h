@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Models/N2CNode.h"
 #include "K2Node.h"
+#include "UObject/UObjectGlobals.h"
 
 #include "K2Node_ActorBoundEvent.h"
 #include "K2Node_AddComponent.h"
@@ -139,6 +140,9 @@ public:
     
     /** Determine variable node type */
     EN2CNodeType DetermineVariableNodeType(const UK2Node_Variable* Node);
+
+    /** Forget the per-class resolution cache (mappings changed or classes were reloaded) */
+    void InvalidateResolvedTypes();
     
 private:
     /** Constructor - initializes default mappings */
@@ -149,6 +153,27 @@ private:
     
     /** Mappings from class pointers to node types */
     TMap<const UClass*, EN2CNodeType> ClassMappings;
+
+    /** Result of resolving a node class through the mappings */
+    struct FResolvedNodeType
+    {
+        EN2CNodeType Type = EN2CNodeType::CallFunction;
+
+        /** Variable nodes are resolved per node by DetermineVariableNodeType */
+        bool bVariableNode = false;
+    };
+
+    /** Resolved type per node class, filled on first lookup */
+    TMap<const UClass*, FResolvedNodeType> ResolvedTypes;
+
+    /** Guards ResolvedTypes, graphs may be translated on several threads */
+    FRWLock ResolvedTypesLock;
+
+    /** Resolve a node's class through the mappings without consulting the cache */
+    FResolvedNodeType ResolveNodeClass(const UK2Node* Node);
+
+    /** Hot reload / live coding callback */
+    void HandleReloadComplete(EReloadCompleteReason Reason);
     
     /** Initialize default mappings */
     void InitializeDefaultMappings();
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FN2CBlueprint;
+struct FN2CGraph;
+
+/**
+ * @class FN2CPinPruner
+ * @brief Drops pins that tell the LLM nothing, between extraction and serialization
+ *
+ * Only unconnected pins are dropped: exec pins that lead nowhere, implicit self targets, collapsed advanced
+ * pins and, if enabled, inputs still holding the default their node gave them. Pins a data flow refers to
+ * are always kept and the flows' pin indices are remapped, so flow references stay valid. Pin IDs are not
+ * renumbered; the pins that remain keep the IDs the rest of the output uses for them.
+ */
+class NODETOCODE_API FN2CPinPruner
+{
+public:
+    struct FOptions
+    {
+        /** Exec pins with no connection */
+        bool bUnconnectedExec = true;
+
+        /** Unconnected self pins, which target the Blueprint itself */
+        bool bImplicitSelf = true;
+
+        /** Unconnected pins in a node's collapsed advanced section that hold their default value */
+        bool bAdvancedView = true;
+
+        /** Unconnected inputs that hold the default their node gave them */
+        bool bDefaultValues = false;
+
+        /** Whether anything is pruned at all */
+        bool bEnabled = false;
+
+        /** Options as set in the plugin settings */
+        static FOptions FromSettings();
+    };
+
+    /** Prune every graph of a Blueprint. Returns how many pins were dropped */
+    static int32 Prune(FN2CBlueprint& Blueprint, const FOptions& Options);
+
+    /** Prune one graph. Returns how many pins were dropped */
+    static int32 PruneGraph(FN2CGraph& Graph, const FOptions& Options);
+};
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
+#include "Utils/N2CTelemetry.h"
+
+/** Stats of the translation pipeline, shown with "stat NodeToCode" */
+DECLARE_STATS_GROUP(TEXT("NodeToCode"), STATGROUP_NodeToCode, STATCAT_Advanced);
+
+/**
+ * Time the rest of the scope under a cycle stat, an Unreal Insights CPU event and a telemetry stage of the same name.
+ * The stat is declared with DECLARE_CYCLE_STAT(..., STATGROUP_NodeToCode) in the file using it.
+ */
+#define N2C_SCOPE_CYCLE_COUNTER(Stat) \
+    SCOPE_CYCLE_COUNTER(Stat); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+    N2C_TELEMETRY_SCOPE(#Stat)
+
+/**
+ * Low-Level Memory tracker tags, shown under NodeToCode in "stat LLM" and Unreal Insights.
+ * Scope allocations with LLM_SCOPE_BYTAG(NodeToCode_Serializer) and so on.
+ */
+LLM_DECLARE_TAG_API(NodeToCode, NODETOCODE_API);
+LLM_DECLARE_TAG_API(NodeToCode_Translator, NODETOCODE_API);
+LLM_DECLARE_TAG_API(NodeToCode_Serializer, NODETOCODE_API);
+LLM_DECLARE_TAG_API(NodeToCode_LLM, NODETOCODE_API);
+LLM_DECLARE_TAG_API(NodeToCode_Logger, NODETOCODE_API);
+LLM_DECLARE_TAG_API(NodeToCode_CodeEditor, NODETOCODE_API);
+
+/**
+ * Highest physical memory the process used while a batch ran, sampled at points the batch chooses, such as
+ * each completed request. The operating system's high-water mark for the whole process is reported beside it
+ */
+struct NODETOCODE_API FN2CPeakMemory
+{
+    /** Start over from the memory used now */
+    void Reset();
+
+    /** Note the memory used now */
+    void Sample();
+
+    /** Line for a batch summary, in MB */
+    FString ToString() const;
+
+    uint64 StartBytes = 0;
+    uint64 PeakBytes = 0;
+};
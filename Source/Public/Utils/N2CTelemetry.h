@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Nick McClure (Protospatial). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Latency histogram of one pipeline stage. Recorded by any thread without locks, and emptied by each
+ * telemetry export
+ */
+class NODETOCODE_API FN2CTelemetryStage
+{
+public:
+    static constexpr int32 NumBuckets = 12;
+
+    /** Upper bounds of all but the last bucket, in milliseconds */
+    static const double BucketBoundsMs[NumBuckets - 1];
+
+    explicit FN2CTelemetryStage(const ANSICHAR* InName) : Name(InName) {}
+
+    /** Count one run of the stage */
+    void Record(double Seconds);
+
+    const ANSICHAR* GetName() const { return Name; }
+
+private:
+    friend class FN2CTelemetry;
+
+    const ANSICHAR* Name;
+    std::atomic<uint64> Count{0};
+    std::atomic<uint64> TotalMicroseconds{0};
+    std::atomic<uint64> MaxMicroseconds{0};
+    std::atomic<uint64> Buckets[NumBuckets] = {};
+};
+
+/**
+ * @class FN2CTelemetry
+ * @brief Periodic export of pipeline performance, for watching many workstations and build machines
+ *
+ * Every N2C_SCOPE_CYCLE_COUNTER scope (translator, collector, serializer, payload building, HTTP, parsers,
+ * output writer) also records into a latency histogram of its stat, and the LLM module adds the queue wait,
+ * upload, first byte and total time of each request. Counters, such as requests and cache hits, and gauges,
+ * such as queue depth, sit beside them. Every TelemetryIntervalSeconds the interval's data is written as one
+ * line of compact JSON, tagged with the machine, plugin, engine, provider and model, to the telemetry
+ * file and posted to the telemetry endpoint if one is set, then starts over. Scopes cost one relaxed load
+ * while telemetry is off.
+ */
+class NODETOCODE_API FN2CTelemetry
+{
+public:
+    /** Get the singleton instance */
+    static FN2CTelemetry& Get();
+
+    static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+    /** Stage of a name, created the first time. Stages are never freed, so callers may keep the reference */
+    FN2CTelemetryStage& RegisterStage(const ANSICHAR* Name);
+
+    /** Count a duration measured outside a scope, such as a request's queue wait */
+    void RecordSeconds(const ANSICHAR* StageName, double Seconds);
+
+    /** Add to a counter of the current interval */
+    void Increment(const TCHAR* Counter, int64 Amount = 1);
+
+    /** Note the current value of a gauge; the last and highest values of the interval are exported */
+    void SampleGauge(const TCHAR* Gauge, int64 Value);
+
+    /** Start or stop the periodic export to match the settings */
+    void ApplySettings();
+
+    /** Export the current interval now, if telemetry is on */
+    void Flush();
+
+    /** Export what is left and stop */
+    void Shutdown();
+
+private:
+    /** Private constructor for singleton */
+    FN2CTelemetry() = default;
+
+    /** The current interval as a JSON line, emptying it */
+    FString TakeIntervalLine();
+
+    struct FGauge
+    {
+        int64 Last = 0;
+        int64 Max = 0;
+    };
+
+    /** Guards the stage list, the counters and the gauges; stage histograms are atomic */
+    FCriticalSection Lock;
+
+    TArray<TUniquePtr<FN2CTelemetryStage>> Stages;
+    TMap<FString, int64> Counters;
+    TMap<FString, FGauge> Gauges;
+
+    /** When the current interval began */
+    FDateTime IntervalStart = FDateTime::UtcNow();
+
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    static std::atomic<bool> bEnabled;
+};
+
+/** Times the rest of the scope into a telemetry stage */
+struct FN2CTelemetryScope
+{
+    explicit FN2CTelemetryScope(FN2CTelemetryStage& InStage)
+        : Stage(FN2CTelemetry::IsEnabled() ? &InStage : nullptr)
+        , StartCycles(Stage ? FPlatformTime::Cycles64() : 0)
+    {
+    }
+
+    ~FN2CTelemetryScope()
+    {
+        if (Stage)
+        {
+            Stage->Record(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles));
+        }
+    }
+
+    FN2CTelemetryStage* Stage;
+    uint64 StartCycles;
+};
+
+/** Stage named Name, looked up once per use of the macro */
+#define N2C_TELEMETRY_STAGE(Name) \
+    ([]() -> FN2CTelemetryStage& { static FN2CTelemetryStage& Stage = FN2CTelemetry::Get().RegisterStage(Name); return Stage; }())
+
+/** Time the rest of the scope into the telemetry stage Name */
+#define N2C_TELEMETRY_SCOPE(Name) \
+    const FN2CTelemetryScope ANONYMOUS_VARIABLE(N2CTelemetryScope_)(N2C_TELEMETRY_STAGE(Name))
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
 #include "Models/N2CNode.h"
 #include "Utils/Processors/N2CNodeProcessor.h"
 
@@ -34,13 +35,29 @@ public:
      * @return The processor, or nullptr if none is registered
      */
     TSharedPtr<IN2CNodeProcessor> GetProcessor(EN2CNodeType NodeType);
+
+    /**
+     * Find the processor for a node type without touching reference counts
+     * 
+     * @param NodeType The node type to get a processor for
+     * @return The processor (falling back to the CallFunction processor), or nullptr if none is registered.
+     *         Owned by the factory and valid until the node type is registered again
+     */
+    IN2CNodeProcessor* FindProcessor(EN2CNodeType NodeType) const
+    {
+        IN2CNodeProcessor* Processor = ProcessorTable[static_cast<uint8>(NodeType)];
+        return Processor ? Processor : ProcessorTable[static_cast<uint8>(EN2CNodeType::CallFunction)];
+    }
     
 private:
     /** Constructor - initializes default processors */
     FN2CNodeProcessorFactory();
     
-    /** Map of node types to processors */
+    /** Map of node types to processors, owns the processors */
     TMap<EN2CNodeType, TSharedPtr<IN2CNodeProcessor>> Processors;
+
+    /** Dispatch table indexed by node type, mirrors Processors */
+    TStaticArray<IN2CNodeProcessor*, 256> ProcessorTable;
     
     /** Initialize default processors */
     void InitializeDefaultProcessors();
@@ -20,7 +20,7 @@ public:
     /** Validate a single graph */
     bool ValidateGraph(const FN2CGraph& Graph, FString& OutError);
     
-    /** Validate flow references in a graph */
+    /** Validate that the flows of a graph refer to nodes and pins it has */
     bool ValidateFlowReferences(const FN2CGraph& Graph, FString& OutError);
     
     /** Validate a struct definition */
@@ -41,6 +41,9 @@ private:
     
     /** Validate all enums in the blueprint */
     bool ValidateEnums(const FN2CBlueprint& Blueprint, FString& OutError);
+
+    /** IDs of the graph being validated, viewing its nodes. Kept between graphs to reuse the allocation */
+    TSet<FStringView> NodeIds;
     
     /** Node validator instance */
     FN2CNodeValidator NodeValidator;